@@ -33,6 +33,7 @@ OF SUCH DAMAGE.
 */
 
 #include "gd32c231c_eval.h"
+#include <string.h>
 
 /* private variables */
 static const uint32_t GPIO_PORT[LEDn]           = {LED1_GPIO_PORT, LED2_GPIO_PORT, LED3_GPIO_PORT, LED4_GPIO_PORT};
@@ -61,6 +62,16 @@ static const uint8_t KEY_PIN_SOURCE[KEYn]       = {WAKEUP_KEY_EXTI_PIN_SOURCE, U
 
 static const IRQn_Type KEY_IRQn[KEYn]           = {WAKEUP_KEY_EXTI_IRQn, USER_KEY_EXTI_IRQn};
 
+/* COM ring buffer, written by the application and read by the DMA */
+static uint8_t com_tx_buffer[EVAL_COM_TX_BUFFER_SIZE];
+static __IO uint32_t com_tx_head = 0U;          /* bytes written, free running */
+static __IO uint32_t com_tx_tail = 0U;          /* bytes sent, free running */
+static __IO uint32_t com_tx_dma_number = 0U;    /* bytes of the on-going DMA transfer, 0 if idle */
+static __IO uint32_t com_tx_overflow = 0U;
+static uint32_t com_tx_periph = 0U;             /* COM sent by DMA, 0 if not enabled */
+
+static void com_tx_dma_start(void);
+
 /*!
     \brief      configure led GPIO
     \param[in]  lednum: specify the led to be configured
@@ -216,10 +227,200 @@ void gd_eval_com_init(uint32_t com)
     usart_enable(com);
 }
 
+/*!
+    \brief      send the COM output through a ring buffer drained by DMA, printf then
+                returns once the text is copied to the ring buffer
+    \param[in]  com: COM port
+      \arg        EVAL_COM
+    \param[out] none
+    \retval     none
+*/
+void gd_eval_com_tx_dma_init(uint32_t com)
+{
+    dma_parameter_struct dma_init_struct;
+
+    /* enable DMA clock */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    /* the memory address and the number are set for each contiguous part of the ring */
+    dma_deinit(EVAL_COM_TX_DMA_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = DMA_REQUEST_USART0_TX;
+    dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)com_tx_buffer;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number       = 0U;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&USART_TDATA(com);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_LOW;
+    dma_init(EVAL_COM_TX_DMA_CHANNEL, &dma_init_struct);
+
+    /* configure DMA mode */
+    dma_circulation_disable(EVAL_COM_TX_DMA_CHANNEL);
+    dma_memory_to_memory_disable(EVAL_COM_TX_DMA_CHANNEL);
+    dmamux_synchronization_disable(EVAL_COM_TX_DMA_MUXCH);
+
+    /* enable DMA transfer complete interrupt */
+    dma_interrupt_enable(EVAL_COM_TX_DMA_CHANNEL, DMA_INT_FTF);
+    nvic_irq_enable(EVAL_COM_TX_DMA_IRQn, 3);
+
+    usart_dma_transmit_config(com, USART_TRANSMIT_DMA_ENABLE);
+    com_tx_periph = com;
+}
+
+/*!
+    \brief      copy data to the COM ring buffer, only one context may write, the
+                writer waits for room only if the ring buffer is full, in an interrupt
+                or with the interrupts disabled the bytes which don't fit are dropped
+                and counted
+    \param[in]  data: data to send
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     number of bytes copied to the ring buffer
+*/
+uint32_t gd_eval_com_tx_write(const uint8_t *data, uint32_t number)
+{
+    uint32_t head, space, index, count;
+    uint32_t done = 0U;
+    uint32_t primask = __get_PRIMASK();
+    /* the DMA interrupt can only make room in thread mode with the interrupts enabled */
+    uint8_t wait = (0U == __get_IPSR()) && (0U == (primask & 1U));
+
+    while(done < number) {
+        head = com_tx_head;
+        space = EVAL_COM_TX_BUFFER_SIZE - (head - com_tx_tail);
+        if(0U == space) {
+            if(0U == wait) {
+                com_tx_overflow += number - done;
+                break;
+            }
+            continue;
+        }
+        if(space > (number - done)) {
+            space = number - done;
+        }
+
+        /* copy up to the end of the ring, then from its start */
+        index = head & (EVAL_COM_TX_BUFFER_SIZE - 1U);
+        count = EVAL_COM_TX_BUFFER_SIZE - index;
+        if(count > space) {
+            count = space;
+        }
+        memcpy(&com_tx_buffer[index], data + done, count);
+        memcpy(com_tx_buffer, data + done + count, space - count);
+        com_tx_head = head + space;
+        done += space;
+
+        /* the DMA interrupt starts the next transfer itself while the DMA runs */
+        __disable_irq();
+        if(0U == com_tx_dma_number) {
+            com_tx_dma_start();
+        }
+        __set_PRIMASK(primask);
+    }
+
+    return done;
+}
+
+/*!
+    \brief      wait for the COM ring buffer to be sent
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gd_eval_com_tx_flush(void)
+{
+    if(0U == com_tx_periph) {
+        return;
+    }
+    while(com_tx_head != com_tx_tail) {
+    }
+    while(RESET == usart_flag_get(com_tx_periph, USART_FLAG_TC)) {
+    }
+}
+
+/*!
+    \brief      return the number of bytes dropped because the COM ring buffer was full
+    \param[in]  none
+    \param[out] none
+    \retval     number of dropped bytes
+*/
+uint32_t gd_eval_com_tx_overflow_get(void)
+{
+    return com_tx_overflow;
+}
+
+/*!
+    \brief      COM DMA interrupt service, call it from the DMA channel IRQ handler
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gd_eval_com_tx_dma_irq_handler(void)
+{
+    if(RESET != dma_interrupt_flag_get(EVAL_COM_TX_DMA_CHANNEL, DMA_INT_FLAG_FTF)) {
+        dma_interrupt_flag_clear(EVAL_COM_TX_DMA_CHANNEL, DMA_INT_FLAG_FTF);
+        com_tx_tail += com_tx_dma_number;
+        com_tx_dma_start();
+    }
+}
+
+/*!
+    \brief      send the next contiguous part of the COM ring buffer by DMA
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void com_tx_dma_start(void)
+{
+    uint32_t tail = com_tx_tail;
+    uint32_t index = tail & (EVAL_COM_TX_BUFFER_SIZE - 1U);
+    uint32_t number = com_tx_head - tail;
+
+    /* stop at the end of the ring, the rest is sent by the next transfer */
+    if(number > (EVAL_COM_TX_BUFFER_SIZE - index)) {
+        number = EVAL_COM_TX_BUFFER_SIZE - index;
+    }
+    com_tx_dma_number = number;
+    if(0U == number) {
+        return;
+    }
+
+    dma_channel_disable(EVAL_COM_TX_DMA_CHANNEL);
+    dma_memory_address_config(EVAL_COM_TX_DMA_CHANNEL, (uint32_t)(uintptr_t)&com_tx_buffer[index]);
+    dma_transfer_number_config(EVAL_COM_TX_DMA_CHANNEL, number);
+    dma_channel_enable(EVAL_COM_TX_DMA_CHANNEL);
+}
+
+/* write a block of the C library output, used by _write() of syscalls.c in every GCC build */
+int __io_write(char *ptr, int len)
+{
+    int index;
+
+    if(0U != com_tx_periph) {
+        gd_eval_com_tx_write((const uint8_t *)ptr, (uint32_t)len);
+        return len;
+    }
+    for(index = 0; index < len; index++) {
+        usart_data_transmit(EVAL_COM, (uint8_t)*ptr++);
+        while(RESET == usart_flag_get(EVAL_COM, USART_FLAG_TBE));
+    }
+    return len;
+}
+
 #ifdef GD_ECLIPSE_GCC
 /* retarget the C library printf function to the USART, in Eclipse GCC environment */
 int __io_putchar(int ch)
 {
+    uint8_t data = (uint8_t)ch;
+
+    if(0U != com_tx_periph) {
+        gd_eval_com_tx_write(&data, 1U);
+        return ch;
+    }
     usart_data_transmit(EVAL_COM, (uint8_t) ch );
     while(RESET == usart_flag_get(EVAL_COM, USART_FLAG_TBE));
     return ch;
@@ -113,6 +113,12 @@ typedef enum {
 #define EVAL_COM_GPIO_CLK                RCU_GPIOA
 #define EVAL_COM_AF                      GPIO_AF_1
 
+/* stdout ring buffer drained to EVAL_COM by DMA, a power of two */
+#define EVAL_COM_TX_BUFFER_SIZE          256U
+#define EVAL_COM_TX_DMA_CHANNEL          DMA_CH2
+#define EVAL_COM_TX_DMA_MUXCH            DMAMUX_MUXCH2
+#define EVAL_COM_TX_DMA_IRQn             DMA_Channel2_IRQn
+
 /* function declarations */
 /* configure led GPIO */
 void gd_eval_led_init(led_typedef_enum lednum);
@@ -128,6 +134,16 @@ void gd_eval_key_init(key_typedef_enum keynum, keymode_typedef_enum keymode);
 uint8_t gd_eval_key_state_get(key_typedef_enum keynum);
 /* configure COM port */
 void gd_eval_com_init(uint32_t com);
+/* send the COM output through a ring buffer drained by DMA */
+void gd_eval_com_tx_dma_init(uint32_t com);
+/* copy data to the COM ring buffer */
+uint32_t gd_eval_com_tx_write(const uint8_t *data, uint32_t number);
+/* wait for the COM ring buffer to be sent */
+void gd_eval_com_tx_flush(void);
+/* return the number of bytes dropped because the COM ring buffer was full */
+uint32_t gd_eval_com_tx_overflow_get(void);
+/* COM DMA interrupt service */
+void gd_eval_com_tx_dma_irq_handler(void);
 
 #ifdef __cplusplus
 }
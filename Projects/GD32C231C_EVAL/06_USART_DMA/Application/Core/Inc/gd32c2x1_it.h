@@ -50,5 +50,11 @@ void PendSV_Handler(void);
 void DMA_Channel0_IRQHandler(void);
 /* this function handles DMA_Channel1 exception */
 void DMA_Channel1_IRQHandler(void);
+/* this function handles DMA_Channel2 exception */
+void DMA_Channel2_IRQHandler(void);
+/* this function handles USART0 exception */
+void USART0_IRQHandler(void);
+/* this function handles TIMER13 exception */
+void TIMER13_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
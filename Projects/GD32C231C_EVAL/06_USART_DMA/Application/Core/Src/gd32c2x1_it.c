@@ -33,6 +33,10 @@ OF SUCH DAMAGE.
 */
 
 #include "gd32c2x1_it.h"
+#include "usart_dma_rx.h"
+#include "time_base.h"
+#include "profile.h"
+#include "gd32c231c_eval.h"
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -105,10 +109,13 @@ void PendSV_Handler(void)
 */
 void DMA_Channel0_IRQHandler(void)
 {
+    PROFILE_BEGIN(PROFILE_DMA_CH0_IRQ);
+
     if(RESET != dma_interrupt_flag_get(DMA_CH0, DMA_INT_FLAG_FTF)) {
         dma_interrupt_flag_clear(DMA_CH0, DMA_INT_FLAG_G);
         g_transfer_complete = SET;
     }
+    PROFILE_END(PROFILE_DMA_CH0_IRQ);
 }
 
 /*!
@@ -119,8 +126,49 @@ void DMA_Channel0_IRQHandler(void)
 */
 void DMA_Channel1_IRQHandler(void)
 {
-    if(RESET != dma_interrupt_flag_get(DMA_CH1, DMA_INT_FLAG_FTF)) {
-        dma_interrupt_flag_clear(DMA_CH1, DMA_INT_FLAG_G);
-        g_transfer_complete = SET;
-    }
+    PROFILE_BEGIN(PROFILE_DMA_CH1_IRQ);
+
+    usart_dma_rx_dma_irq_handler();
+    PROFILE_END(PROFILE_DMA_CH1_IRQ);
+}
+
+/*!
+    \brief      this function handles DMA_Channel2_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel2_IRQHandler(void)
+{
+    PROFILE_BEGIN(PROFILE_DMA_CH2_IRQ);
+
+    gd_eval_com_tx_dma_irq_handler();
+    PROFILE_END(PROFILE_DMA_CH2_IRQ);
+}
+
+/*!
+    \brief      this function handles USART0 exception
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void USART0_IRQHandler(void)
+{
+    PROFILE_BEGIN(PROFILE_USART0_IRQ);
+
+    usart_dma_rx_irq_handler();
+    PROFILE_END(PROFILE_USART0_IRQ);
+}
+
+/*!
+    \brief      this function handles TIMER13 interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void TIMER13_IRQHandler(void)
+{
+    /* the counter restarted from 0 at the update, it holds the interrupt latency */
+    PROFILE_RECORD(PROFILE_TIMER13_LATENCY, TIMER_CNT(TIME_BASE_TIMER) & 0xFFFFU);
+    time_base_irq_handler();
 }
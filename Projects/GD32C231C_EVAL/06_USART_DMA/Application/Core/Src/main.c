@@ -36,17 +36,34 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include <stdio.h>
 #include "gd32c231c_eval.h"
+#include "frame_link.h"
+#include "crc_service.h"
+#include "update_agent.h"
+#include "time_base.h"
+#include "profile.h"
 
-#define USART0_RDATA_ADDRESS      (&USART_RDATA(USART0))
 #define USART0_TDATA_ADDRESS      (&USART_TDATA(USART0))
 #define ARRAYNUM(arr_nanme)       (uint32_t)(sizeof(arr_nanme) / sizeof(*(arr_nanme)))
+/* the whole internal flash is checked at boot */
+#define FLASH_IMAGE_SIZE          0x10000U
 
 __IO FlagStatus g_transfer_complete = RESET;
-uint8_t rxbuffer[10];
-uint8_t txbuffer[] = "\n\rUSART DMA interrupt receive and transmit example, please input 10 bytes:\n\r";
+uint8_t txbuffer[] = "\n\rUSART DMA interrupt receive and transmit example, please send COBS frames:\n\r";
+
+/* reply to a request with an echo and a status frame, sent in one batch */
+#define FRAME_STATUS              0x80U
+/* request of the profiling statistics, answered by the same byte and count, min, avg and max of each probe */
+#define FRAME_PROFILE             0x81U
 
 void com_usart_init(void);
 void nvic_config(void);
+void frame_handle(const uint8_t *payload, uint32_t number);
+#ifdef PROFILE_ENABLE
+void frame_profile_reply(void);
+#endif /* PROFILE_ENABLE */
+#ifdef CRC_BENCHMARK
+void crc_benchmark(const crc_service_config_struct *config, const char *name);
+#endif /* CRC_BENCHMARK */
 
 /*!
     \brief      main function
@@ -57,13 +74,31 @@ void nvic_config(void);
 int main(void)
 {
     dma_parameter_struct dma_init_struct;
+    crc_service_context_struct crc_context;
+    uint32_t start;
     /* enable DMA clock */
     rcu_periph_clock_enable(RCU_DMA);
     rcu_periph_clock_enable(RCU_DMAMUX);
+    /* start the microsecond time base */
+    time_base_init();
     /* initialize the com */
     com_usart_init();
     /*configure DMA interrupt*/
     nvic_config();
+    /* calculate the CRC-32 of the flash, the DMA feeds the CRC unit */
+    crc_service_init();
+    start = time_now_us32();
+    crc_service_start(&crc_context, &crc_service_crc32);
+    crc_service_update_dma(&crc_context, (const void *)FLASH_BASE, FLASH_IMAGE_SIZE);
+    printf("\n\rflash CRC-32: 0x%08x in %u us\n\r", (unsigned int)crc_service_finish(&crc_context),
+           (unsigned int)time_elapsed_us(start));
+#ifdef CRC_BENCHMARK
+    /* the same flash image by the CPU, the DMA and the software paths */
+    crc_benchmark(&crc_service_crc32, "CRC-32");
+    crc_benchmark(&crc_service_crc32_mpeg2, "CRC-32/MPEG-2");
+#endif /* CRC_BENCHMARK */
+    /* receive the frames into the circular DMA buffer of channel 1 */
+    frame_link_init(frame_handle);
 
     /* initialize DMA channel 0 */
     dma_deinit(DMA_CH0);
@@ -92,45 +127,21 @@ int main(void)
     /* enable DMA channel 0 */
     dma_channel_enable(DMA_CH0);
 
-    /* initialize DMA channel 1 */
-    dma_deinit(DMA_CH1);
-    dma_struct_para_init(&dma_init_struct);
-    dma_init_struct.request      = DMA_REQUEST_USART0_RX;
-    dma_init_struct.direction    = DMA_PERIPHERAL_TO_MEMORY;
-    dma_init_struct.memory_addr  = (uint32_t)rxbuffer;
-    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
-    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
-    dma_init_struct.number       = ARRAYNUM(rxbuffer);
-    dma_init_struct.periph_addr  = (uint32_t)USART0_RDATA_ADDRESS;
-    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
-    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
-    dma_init_struct.priority     = DMA_PRIORITY_ULTRA_HIGH;
-    dma_init(DMA_CH1, &dma_init_struct);
-
-    /* configure DMA mode */
-    dma_circulation_disable(DMA_CH1);
-    dma_memory_to_memory_disable(DMA_CH1);
-    /* disable the DMAMUX_MUXCH1 synchronization mode */
-    dmamux_synchronization_disable(DMAMUX_MUXCH1);
-    /* USART DMA enable for reception */
-    usart_dma_receive_config(USART0, USART_RECEIVE_DMA_ENABLE);
-    /* enable DMA channel 1 transfer complete interrupt */
-    dma_interrupt_enable(DMA_CH1, DMA_INT_FTF);
-    /* enable DMA channel 1 */
-    dma_channel_enable(DMA_CH1);
-
     /* waiting for the transfer to complete*/
+    PROFILE_BEGIN(PROFILE_MAIN_TX_WAIT);
     while(RESET == g_transfer_complete) {
     }
+    PROFILE_END(PROFILE_MAIN_TX_WAIT);
 
-    g_transfer_complete = RESET;
+    /* the replies are sent through the COM ring buffer by DMA channel 2 */
+    gd_eval_com_tx_dma_init(USART0);
 
-    /* waiting for the transfer to complete*/
-    while(RESET == g_transfer_complete) {
-    }
-
-    printf("\n\r%s\n\r", rxbuffer);
     while(1) {
+        PROFILE_BEGIN(PROFILE_MAIN_LOOP);
+
+        update_agent_poll();
+        frame_link_tx_flush();
+        PROFILE_END(PROFILE_MAIN_LOOP);
     }
 }
 
@@ -180,5 +191,121 @@ void com_usart_init(void)
 void nvic_config(void)
 {
     nvic_irq_enable(DMA_Channel0_IRQn, 0);
-    nvic_irq_enable(DMA_Channel1_IRQn, 0);
 }
+
+/*!
+    \brief      answer a received frame, called in the receive interrupt
+    \param[in]  payload: pointer to the payload of the frame
+    \param[in]  number: number of bytes of the payload
+    \param[out] none
+    \retval     none
+*/
+void frame_handle(const uint8_t *payload, uint32_t number)
+{
+    uint8_t status[9];
+    uint32_t frames = frame_link_rx_frame_get();
+    uint32_t errors = frame_link_rx_error_get();
+
+    /* the firmware update frames are processed in the main loop */
+    if((0U != number) && UPDATE_AGENT_COMMAND(payload[0])) {
+        update_agent_receive(payload, number);
+        return;
+    }
+
+#ifdef PROFILE_ENABLE
+    if((1U == number) && (FRAME_PROFILE == payload[0])) {
+        frame_profile_reply();
+        return;
+    }
+#endif /* PROFILE_ENABLE */
+
+    status[0] = FRAME_STATUS;
+    status[1] = (uint8_t)frames;
+    status[2] = (uint8_t)(frames >> 8);
+    status[3] = (uint8_t)(frames >> 16);
+    status[4] = (uint8_t)(frames >> 24);
+    status[5] = (uint8_t)errors;
+    status[6] = (uint8_t)(errors >> 8);
+    status[7] = (uint8_t)(errors >> 16);
+    status[8] = (uint8_t)(errors >> 24);
+
+    /* the frames wait in the batch until the main loop flushes it */
+    frame_link_tx_put(payload, number);
+    frame_link_tx_put(status, sizeof(status));
+}
+
+#ifdef CRC_BENCHMARK
+/*!
+    \brief      print the CRC of the flash image and the time taken by each path of crc_service
+    \param[in]  config: CRC algorithm
+    \param[in]  name: name of the algorithm
+    \param[out] none
+    \retval     none
+*/
+void crc_benchmark(const crc_service_config_struct *config, const char *name)
+{
+    /* the table is only linked into the benchmark build */
+    static uint32_t table[CRC_SERVICE_TABLE_SIZE];
+    crc_service_context_struct context;
+    uint32_t crc[4], time[4];
+    uint32_t start;
+    uint8_t i;
+
+    for(i = 0U; i < 4U; i++) {
+        start = time_now_us32();
+        crc_service_start(&context, config);
+        if(0U == i) {
+            crc_service_update(&context, (const void *)FLASH_BASE, FLASH_IMAGE_SIZE);
+        } else if(1U == i) {
+            crc_service_update_dma(&context, (const void *)FLASH_BASE, FLASH_IMAGE_SIZE);
+        } else if(2U == i) {
+            crc_service_table_build(config, table);
+            crc_service_table_update(&context, table, (const void *)FLASH_BASE, FLASH_IMAGE_SIZE);
+        } else {
+            crc_service_software_update(&context, (const void *)FLASH_BASE, FLASH_IMAGE_SIZE);
+        }
+        crc[i] = crc_service_finish(&context);
+        time[i] = time_elapsed_us(start);
+    }
+
+    printf("%s of %u bytes: CPU %u us, DMA %u us, table %u us, bitwise %u us, 0x%08x %s\n\r", name,
+           (unsigned int)FLASH_IMAGE_SIZE, (unsigned int)time[0], (unsigned int)time[1], (unsigned int)time[2],
+           (unsigned int)time[3], (unsigned int)crc[0],
+           ((crc[0] == crc[1]) && (crc[0] == crc[2]) && (crc[0] == crc[3])) ? "match" : "MISMATCH");
+}
+#endif /* CRC_BENCHMARK */
+
+#ifdef PROFILE_ENABLE
+/*!
+    \brief      answer FRAME_PROFILE with the statistics of every probe
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void frame_profile_reply(void)
+{
+    uint8_t reply[1U + (PROFILE_PROBE_NUM * 16U)];
+    profile_entry_struct entry;
+    uint32_t value[4];
+    uint32_t n = 0U;
+    uint8_t i, j;
+
+    reply[n++] = FRAME_PROFILE;
+    for(i = 0U; i < (uint8_t)PROFILE_PROBE_NUM; i++) {
+        profile_get((profile_probe_enum)i, &entry);
+        value[0] = entry.count;
+        value[1] = entry.min;
+        value[2] = profile_average(&entry);
+        value[3] = entry.max;
+        /* least significant byte first, as the other frames */
+        for(j = 0U; j < 4U; j++) {
+            reply[n++] = (uint8_t)value[j];
+            reply[n++] = (uint8_t)(value[j] >> 8);
+            reply[n++] = (uint8_t)(value[j] >> 16);
+            reply[n++] = (uint8_t)(value[j] >> 24);
+        }
+    }
+
+    frame_link_tx_put(reply, n);
+}
+#endif /* PROFILE_ENABLE */
@@ -42,7 +42,10 @@
 #define __IRC32K            (IRC32K_VALUE)            /* internal 32 KHz RC oscillator frequency */
 #define __SYS_OSC_CLK       (__IRC48M)                /* main oscillator frequency */
 
+/* the image linked for a bootloader slot defines the offset of the slot */
+#ifndef VECT_TAB_OFFSET
 #define VECT_TAB_OFFSET  (uint32_t)0x00000000U        /* vector table base offset */
+#endif /* VECT_TAB_OFFSET */
 
 /* select a system clock by uncommenting the following line */
 #define __SYSTEM_CLOCK_IRC48M                (__IRC48M)
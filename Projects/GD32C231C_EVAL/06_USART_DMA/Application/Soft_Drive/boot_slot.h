@@ -0,0 +1,63 @@
+/*!
+    \file  boot_slot.h
+    \brief the flash layout of the dual slot bootloader
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef BOOT_SLOT_H
+#define BOOT_SLOT_H
+
+#include "gd32c2x1.h"
+
+/* the bootloader, then two application slots, each one ended by its descriptor row */
+#define BOOT_LOADER_ADDRESS             0x08000000U
+#define BOOT_LOADER_SIZE                0x00002000U
+#define BOOT_SLOT_SIZE                  0x00007000U
+#define BOOT_SLOT_A_ADDRESS             (BOOT_LOADER_ADDRESS + BOOT_LOADER_SIZE)
+#define BOOT_SLOT_B_ADDRESS             (BOOT_SLOT_A_ADDRESS + BOOT_SLOT_SIZE)
+#define BOOT_SLOT_NUM                   2U
+
+/* the descriptor takes the last fast program row of the slot */
+#define BOOT_SLOT_DESCRIPTOR_SIZE       0x00000040U
+#define BOOT_SLOT_IMAGE_SIZE            (BOOT_SLOT_SIZE - BOOT_SLOT_DESCRIPTOR_SIZE)
+#define BOOT_SLOT_DESCRIPTOR(slot)      ((const boot_slot_descriptor_struct *)(uintptr_t)((slot) + BOOT_SLOT_IMAGE_SIZE))
+#define BOOT_SLOT_MAGIC                 0x544F4C53U
+
+/* descriptor written after the image is verified */
+typedef struct {
+    uint32_t magic;                     /*!< BOOT_SLOT_MAGIC */
+    uint32_t size;                      /*!< size of the image in bytes */
+    uint32_t crc;                       /*!< CRC-32 of the image */
+    uint32_t sequence;                  /*!< the valid slot of the highest sequence is started */
+} boot_slot_descriptor_struct;
+
+#endif /* BOOT_SLOT_H */
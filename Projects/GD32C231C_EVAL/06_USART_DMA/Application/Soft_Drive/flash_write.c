@@ -0,0 +1,247 @@
+/*!
+    \file  flash_write.c
+    \brief internal flash write service, merges the writes into fast program rows
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "flash_write.h"
+#include <string.h>
+
+#define FLASH_WRITE_DOUBLEWORD_NUM      DOUBLEWORD_CNT_IN_ROW
+#define FLASH_WRITE_ERROR_FLAGS         (FMC_FLAG_OBERR | FMC_FLAG_RPERR | FMC_FLAG_FSTPERR | FMC_FLAG_PGSERR | \
+                                         FMC_FLAG_PGMERR | FMC_FLAG_PGAERR | FMC_FLAG_WPERR | FMC_FLAG_PGERR | \
+                                         FMC_FLAG_OPRERR | FMC_FLAG_ENDF)
+
+/* the row being merged, word aligned for fmc_fast_program() */
+static uint32_t row_buffer[FLASH_WRITE_ROW_SIZE / 4U];
+/* written bytes of each doubleword of the row */
+static uint8_t row_filled[FLASH_WRITE_DOUBLEWORD_NUM];
+static uint32_t row_address;
+static FlagStatus row_pending = RESET;
+/* pages erased by the session */
+static uint32_t page_erased[(MAIN_FLASH_PAGE_TOTAL_NUM + 31U) / 32U];
+
+static fmc_state_enum flash_write_row_program(uint32_t address, const uint32_t *data, const uint8_t *filled);
+static fmc_state_enum flash_write_page_prepare(uint32_t address);
+static FlagStatus flash_write_blank_check(uint32_t address, uint32_t number);
+
+/*!
+    \brief      start a write session, each page is erased the first time the session writes into it
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void flash_write_init(void)
+{
+    memset(page_erased, 0, sizeof(page_erased));
+    row_pending = RESET;
+}
+
+/*!
+    \brief      write data of any address and length, the full rows are fast programmed and
+                a partial row is kept in RAM until it is completed or flushed
+    \param[in]  address: flash address
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     state of FMC, FMC_READY if the data is written or kept in RAM
+*/
+fmc_state_enum flash_write(uint32_t address, const void *data, uint32_t number)
+{
+    const uint8_t *byte = (const uint8_t *)data;
+    fmc_state_enum state = FMC_READY;
+    uint32_t row, offset, count, i;
+
+    if((address < MAIN_FLASH_BASE_ADDRESS) || (address > (MAIN_FLASH_BASE_ADDRESS + MAIN_FLASH_SIZE)) ||
+            (number > (MAIN_FLASH_BASE_ADDRESS + MAIN_FLASH_SIZE - address))) {
+        return FMC_UNDEFINEDERR;
+    }
+
+    while((0U != number) && (FMC_READY == state)) {
+        row = address & ~(FLASH_WRITE_ROW_SIZE - 1U);
+        offset = address - row;
+        count = FLASH_WRITE_ROW_SIZE - offset;
+        if(count > number) {
+            count = number;
+        }
+
+        /* the write leaves the pending row */
+        if((SET == row_pending) && (row != row_address)) {
+            state = flash_write_flush();
+            if(FMC_READY != state) {
+                break;
+            }
+        }
+
+        if((RESET == row_pending) && (FLASH_WRITE_ROW_SIZE == count) && (0U == ((uint32_t)(uintptr_t)byte & 3U))) {
+            /* a whole aligned row is programmed straight from the caller buffer */
+            state = flash_write_row_program(row, (const uint32_t *)byte, NULL);
+        } else {
+            if(RESET == row_pending) {
+                memset(row_buffer, 0xFF, sizeof(row_buffer));
+                memset(row_filled, 0, sizeof(row_filled));
+                row_address = row;
+                row_pending = SET;
+            }
+            memcpy((uint8_t *)row_buffer + offset, byte, count);
+            for(i = offset; i < (offset + count); i++) {
+                row_filled[i >> 3] |= (uint8_t)(1U << (i & 7U));
+            }
+
+            /* program the row as soon as all its bytes are written */
+            for(i = 0U; i < FLASH_WRITE_DOUBLEWORD_NUM; i++) {
+                if(0xFFU != row_filled[i]) {
+                    break;
+                }
+            }
+            if(FLASH_WRITE_DOUBLEWORD_NUM == i) {
+                row_pending = RESET;
+                state = flash_write_row_program(row_address, row_buffer, NULL);
+            }
+        }
+
+        address += count;
+        byte += count;
+        number -= count;
+    }
+
+    return state;
+}
+
+/*!
+    \brief      program the partial row kept in RAM, its unwritten bytes stay erased but
+                can't be programmed later if they share a doubleword with written bytes
+    \param[in]  none
+    \param[out] none
+    \retval     state of FMC
+*/
+fmc_state_enum flash_write_flush(void)
+{
+    if(RESET == row_pending) {
+        return FMC_READY;
+    }
+    row_pending = RESET;
+
+    return flash_write_row_program(row_address, row_buffer, row_filled);
+}
+
+/*!
+    \brief      program a row, by fast program if it is whole and blank, else by doublewords
+    \param[in]  address: row address
+    \param[in]  data: row data, word aligned
+    \param[in]  filled: written bytes of each doubleword, NULL if the whole row is written
+    \param[out] none
+    \retval     state of FMC
+*/
+static fmc_state_enum flash_write_row_program(uint32_t address, const uint32_t *data, const uint8_t *filled)
+{
+    fmc_state_enum state;
+    uint32_t primask;
+    uint32_t dw_address;
+    uint64_t dw_data;
+    uint8_t i;
+
+    fmc_unlock();
+    fmc_flag_clear(FLASH_WRITE_ERROR_FLAGS);
+
+    state = flash_write_page_prepare(address);
+
+    if((FMC_READY == state) && (NULL == filled) && (SET == flash_write_blank_check(address, FLASH_WRITE_ROW_SIZE))) {
+        /* the row words must be written back to back, no interrupt may delay them */
+        primask = __get_PRIMASK();
+        __disable_irq();
+        state = fmc_fast_program(address, (uint32_t)(uintptr_t)data);
+        __set_PRIMASK(primask);
+    } else {
+        /* the edges of a write, or a row already partly programmed */
+        for(i = 0U; (i < FLASH_WRITE_DOUBLEWORD_NUM) && (FMC_READY == state); i++) {
+            if((NULL != filled) && (0U == filled[i])) {
+                continue;
+            }
+            dw_address = address + (8U * i);
+            dw_data = ((uint64_t)data[2U * i + 1U] << 32) | data[2U * i];
+            if(SET == flash_write_blank_check(dw_address, 8U)) {
+                state = fmc_doubleword_program(dw_address, dw_data);
+            } else if((REG32(dw_address) != data[2U * i]) || (REG32(dw_address + 4U) != data[2U * i + 1U])) {
+                /* a doubleword can be programmed only once after its erase */
+                state = FMC_PGERR;
+            }
+        }
+    }
+
+    fmc_lock();
+
+    return state;
+}
+
+/*!
+    \brief      erase the page of an address if the session has not erased it yet
+    \param[in]  address: flash address
+    \param[out] none
+    \retval     state of FMC
+*/
+static fmc_state_enum flash_write_page_prepare(uint32_t address)
+{
+    fmc_state_enum state = FMC_READY;
+    uint32_t page = (address - MAIN_FLASH_BASE_ADDRESS) / MAIN_FLASH_PAGE_SIZE;
+
+    if(0U == (page_erased[page >> 5] & (1UL << (page & 31U)))) {
+        if(RESET == flash_write_blank_check(page * MAIN_FLASH_PAGE_SIZE + MAIN_FLASH_BASE_ADDRESS, MAIN_FLASH_PAGE_SIZE)) {
+            state = fmc_page_erase(page);
+        }
+        if(FMC_READY == state) {
+            page_erased[page >> 5] |= 1UL << (page & 31U);
+        }
+    }
+
+    return state;
+}
+
+/*!
+    \brief      check that a flash area is erased
+    \param[in]  address: flash address, word aligned
+    \param[in]  number: number of bytes, a multiple of 4
+    \param[out] none
+    \retval     SET if all the words are 0xFFFFFFFF
+*/
+static FlagStatus flash_write_blank_check(uint32_t address, uint32_t number)
+{
+    uint32_t end = address + number;
+
+    for(; address < end; address += 4U) {
+        if(0xFFFFFFFFU != REG32(address)) {
+            return RESET;
+        }
+    }
+
+    return SET;
+}
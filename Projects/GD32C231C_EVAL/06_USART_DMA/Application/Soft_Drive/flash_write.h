@@ -0,0 +1,51 @@
+/*!
+    \file  flash_write.h
+    \brief the header file of the internal flash write service
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef FLASH_WRITE_H
+#define FLASH_WRITE_H
+
+#include "gd32c2x1.h"
+
+/* size of a fast program row */
+#define FLASH_WRITE_ROW_SIZE            (DOUBLEWORD_CNT_IN_ROW * 8U)
+
+/* start a write session, each page is erased the first time the session writes into it */
+void flash_write_init(void);
+/* write data of any address and length, a partial row is kept in RAM until it is completed */
+fmc_state_enum flash_write(uint32_t address, const void *data, uint32_t number);
+/* program the partial row kept in RAM */
+fmc_state_enum flash_write_flush(void);
+
+#endif /* FLASH_WRITE_H */
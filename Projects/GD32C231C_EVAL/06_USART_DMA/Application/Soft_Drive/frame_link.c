@@ -0,0 +1,284 @@
+/*!
+    \file  frame_link.c
+    \brief COBS framing with CRC trailer on the USART DMA drivers
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "frame_link.h"
+#include "usart_dma_rx.h"
+#include "crc_service.h"
+#include "gd32c231c_eval.h"
+#include <stddef.h>
+
+/* receive decoder */
+static uint8_t rx_frame[FRAME_LINK_PAYLOAD_SIZE + FRAME_LINK_CRC_SIZE];
+static uint32_t rx_length;
+static uint8_t rx_code;
+static uint8_t rx_remaining;
+static FlagStatus rx_error;
+static uint32_t rx_frames;
+static uint32_t rx_errors;
+static frame_link_callback rx_callback = NULL;
+
+/* transmit batches, one is filled while the other is copied to the COM ring buffer */
+static uint8_t tx_batch[2][FRAME_LINK_TX_BATCH_SIZE];
+static uint32_t tx_length[2];
+static uint8_t tx_fill;
+
+static void frame_link_receive(const uint8_t *data, uint32_t number, FlagStatus frame_end);
+static void frame_link_frame_end(void);
+static uint32_t frame_link_encode(uint8_t *frame, const uint8_t *payload, uint32_t number, uint32_t crc);
+
+/*!
+    \brief      initialize the framing on USART0, the COM transmit DMA must be initialized
+    \param[in]  callback: function receiving the payload of the good frames
+    \param[out] none
+    \retval     none
+*/
+void frame_link_init(frame_link_callback callback)
+{
+    /* the trailer is a CRC-32/MPEG-2, calculated by the CRC unit */
+    crc_service_init();
+
+    rx_length = 0U;
+    rx_code = 0xFFU;
+    rx_remaining = 0U;
+    rx_error = RESET;
+    rx_frames = 0U;
+    rx_errors = 0U;
+    rx_callback = callback;
+
+    tx_length[0] = 0U;
+    tx_length[1] = 0U;
+    tx_fill = 0U;
+
+    usart_dma_rx_init(USART0, frame_link_receive);
+}
+
+/*!
+    \brief      encode a frame into the transmit batch, it is sent by frame_link_tx_flush()
+    \param[in]  payload: data of the frame
+    \param[in]  number: number of bytes, up to FRAME_LINK_PAYLOAD_SIZE
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the payload is too long or the batch is full
+*/
+ErrStatus frame_link_tx_put(const uint8_t *payload, uint32_t number)
+{
+    ErrStatus status = ERROR;
+    uint32_t primask;
+    uint32_t crc;
+
+    if(number > FRAME_LINK_PAYLOAD_SIZE) {
+        return ERROR;
+    }
+
+    /* the interrupts and the thread mode may both add frames */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if((tx_length[tx_fill] + FRAME_LINK_ENCODED_SIZE(number)) <= FRAME_LINK_TX_BATCH_SIZE) {
+        crc = crc_service_calculate(&crc_service_crc32_mpeg2, payload, number);
+        tx_length[tx_fill] += frame_link_encode(&tx_batch[tx_fill][tx_length[tx_fill]], payload, number, crc);
+        status = SUCCESS;
+    }
+    __set_PRIMASK(primask);
+
+    return status;
+}
+
+/*!
+    \brief      send the frames of the transmit batch, in thread mode the call waits for
+                room in the COM ring buffer
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void frame_link_tx_flush(void)
+{
+    uint32_t primask;
+    uint8_t batch;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    batch = tx_fill;
+    tx_fill ^= 1U;
+    tx_length[tx_fill] = 0U;
+    __set_PRIMASK(primask);
+
+    if(0U != tx_length[batch]) {
+        gd_eval_com_tx_write(tx_batch[batch], tx_length[batch]);
+    }
+}
+
+/*!
+    \brief      get the number of received frames
+    \param[in]  none
+    \param[out] none
+    \retval     number of frames passed to the callback
+*/
+uint32_t frame_link_rx_frame_get(void)
+{
+    return rx_frames;
+}
+
+/*!
+    \brief      get the number of dropped frames, bad encoding, length or CRC
+    \param[in]  none
+    \param[out] none
+    \retval     number of dropped frames
+*/
+uint32_t frame_link_rx_error_get(void)
+{
+    return rx_errors;
+}
+
+/*!
+    \brief      decode the received bytes straight from the DMA buffer
+    \param[in]  data: pointer to the received bytes
+    \param[in]  number: number of the received bytes
+    \param[in]  frame_end: unused, the frames end at the delimiter
+    \param[out] none
+    \retval     none
+*/
+static void frame_link_receive(const uint8_t *data, uint32_t number, FlagStatus frame_end)
+{
+    uint32_t i;
+    uint8_t byte;
+
+    (void)frame_end;
+
+    for(i = 0U; i < number; i++) {
+        byte = data[i];
+        if(FRAME_LINK_DELIMITER == byte) {
+            frame_link_frame_end();
+        } else if(SET == rx_error) {
+            /* skip to the next delimiter */
+        } else if(0U == rx_remaining) {
+            /* a code byte, the previous group ends with a zero unless it was a full group */
+            if(0xFFU != rx_code) {
+                if(rx_length >= sizeof(rx_frame)) {
+                    rx_error = SET;
+                } else {
+                    rx_frame[rx_length++] = 0x00U;
+                }
+            }
+            rx_code = byte;
+            rx_remaining = byte - 1U;
+        } else {
+            if(rx_length >= sizeof(rx_frame)) {
+                rx_error = SET;
+            } else {
+                rx_frame[rx_length++] = byte;
+            }
+            rx_remaining--;
+        }
+    }
+}
+
+/*!
+    \brief      check the decoded frame at the delimiter and pass its payload on
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void frame_link_frame_end(void)
+{
+    uint32_t number;
+    uint32_t crc;
+
+    if((RESET == rx_error) && (0U == rx_remaining) && (0U == rx_length) && (0xFFU == rx_code)) {
+        /* back to back delimiters, nothing was received */
+    } else if((SET == rx_error) || (0U != rx_remaining) || (rx_length < FRAME_LINK_CRC_SIZE)) {
+        rx_errors++;
+    } else {
+        number = rx_length - FRAME_LINK_CRC_SIZE;
+        crc = (uint32_t)rx_frame[number] | ((uint32_t)rx_frame[number + 1U] << 8) |
+              ((uint32_t)rx_frame[number + 2U] << 16) | ((uint32_t)rx_frame[number + 3U] << 24);
+        if(crc != crc_service_calculate(&crc_service_crc32_mpeg2, rx_frame, number)) {
+            rx_errors++;
+        } else {
+            rx_frames++;
+            if(NULL != rx_callback) {
+                rx_callback(rx_frame, number);
+            }
+        }
+    }
+
+    rx_length = 0U;
+    rx_code = 0xFFU;
+    rx_remaining = 0U;
+    rx_error = RESET;
+}
+
+/*!
+    \brief      COBS encode a payload and its CRC trailer, followed by the delimiter
+    \param[in]  payload: data of the frame
+    \param[in]  number: number of bytes
+    \param[in]  crc: CRC of the payload
+    \param[out] frame: encoded frame, FRAME_LINK_ENCODED_SIZE(number) bytes at most
+    \retval     number of encoded bytes
+*/
+static uint32_t frame_link_encode(uint8_t *frame, const uint8_t *payload, uint32_t number, uint32_t crc)
+{
+    uint32_t code_index = 0U;
+    uint32_t index = 1U;
+    uint32_t i;
+    uint8_t code = 1U;
+    uint8_t byte;
+
+    for(i = 0U; i < (number + FRAME_LINK_CRC_SIZE); i++) {
+        if(i < number) {
+            byte = payload[i];
+        } else {
+            byte = (uint8_t)(crc >> (8U * (i - number)));
+        }
+
+        if(0x00U == byte) {
+            /* close the group, the code byte replaces the zero */
+            frame[code_index] = code;
+            code_index = index++;
+            code = 1U;
+        } else {
+            frame[index++] = byte;
+            code++;
+            if(0xFFU == code) {
+                /* a full group of 254 bytes has no implied zero */
+                frame[code_index] = code;
+                code_index = index++;
+                code = 1U;
+            }
+        }
+    }
+    frame[code_index] = code;
+    frame[index++] = FRAME_LINK_DELIMITER;
+
+    return index;
+}
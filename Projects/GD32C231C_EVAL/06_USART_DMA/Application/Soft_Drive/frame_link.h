@@ -0,0 +1,67 @@
+/*!
+    \file  frame_link.h
+    \brief the header file of the COBS framing with CRC trailer
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef FRAME_LINK_H
+#define FRAME_LINK_H
+
+#include "gd32c2x1.h"
+
+/* largest payload of a frame */
+#define FRAME_LINK_PAYLOAD_SIZE         128U
+/* size of each of the two transmit batch buffers */
+#define FRAME_LINK_TX_BATCH_SIZE        256U
+
+/* frame delimiter, the COBS encoding removes it from the frame body */
+#define FRAME_LINK_DELIMITER            0x00U
+/* size of the CRC-32 trailer, sent least significant byte first */
+#define FRAME_LINK_CRC_SIZE             4U
+/* encoded size of a payload, including the trailer and the delimiter */
+#define FRAME_LINK_ENCODED_SIZE(n)      ((n) + FRAME_LINK_CRC_SIZE + (((n) + FRAME_LINK_CRC_SIZE) / 254U) + 2U)
+
+/* frame callback, called in the receive interrupt, payload is valid until the callback returns */
+typedef void (*frame_link_callback)(const uint8_t *payload, uint32_t number);
+
+/* initialize the framing on USART0, the COM transmit DMA must be initialized */
+void frame_link_init(frame_link_callback callback);
+/* encode a frame into the transmit batch */
+ErrStatus frame_link_tx_put(const uint8_t *payload, uint32_t number);
+/* send the frames of the transmit batch */
+void frame_link_tx_flush(void);
+/* get the number of received frames */
+uint32_t frame_link_rx_frame_get(void);
+/* get the number of dropped frames, bad encoding, length or CRC */
+uint32_t frame_link_rx_error_get(void);
+
+#endif /* FRAME_LINK_H */
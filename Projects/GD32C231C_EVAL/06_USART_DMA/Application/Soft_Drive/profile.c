@@ -0,0 +1,213 @@
+/*!
+    \file  profile.c
+    \brief execution time statistics of the profiling probes
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "profile.h"
+
+#ifdef PROFILE_ENABLE
+#include <stdio.h>
+
+profile_entry_struct profile_table[PROFILE_PROBE_NUM];
+
+/* names of the probes in the order of profile_probe_enum */
+static const char *const profile_name[PROFILE_PROBE_NUM] = {
+    "USART0_IRQ",
+    "DMA_CH0_IRQ",
+    "DMA_CH1_IRQ",
+    "DMA_CH2_IRQ",
+    "TIMER13_LATENCY",
+    "MAIN_TX_WAIT",
+    "MAIN_LOOP"
+};
+
+static uint32_t profile_irq_save(void);
+static void profile_irq_restore(uint32_t primask);
+
+/*!
+    \brief      clear the statistics
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void profile_reset(void)
+{
+    uint32_t primask = profile_irq_save();
+    uint8_t i;
+
+    for(i = 0U; i < (uint8_t)PROFILE_PROBE_NUM; i++) {
+        profile_table[i].count = 0U;
+        profile_table[i].min = 0U;
+        profile_table[i].max = 0U;
+        profile_table[i].total = 0U;
+    }
+    profile_irq_restore(primask);
+}
+
+/*!
+    \brief      add a sample to the statistics of a probe, safe to call from interrupts
+    \param[in]  probe: the probe
+      \arg        PROFILE_x: a probe of profile_probe_enum
+    \param[in]  us: the sample in microseconds
+    \param[out] none
+    \retval     none
+*/
+void profile_record(profile_probe_enum probe, uint32_t us)
+{
+    profile_entry_struct *entry;
+    uint32_t primask;
+
+    if(PROFILE_PROBE_NUM <= probe) {
+        return;
+    }
+
+    entry = &profile_table[probe];
+    primask = profile_irq_save();
+    if((0U == entry->count) || (us < entry->min)) {
+        entry->min = us;
+    }
+    if(us > entry->max) {
+        entry->max = us;
+    }
+    entry->total += us;
+    entry->count++;
+    profile_irq_restore(primask);
+}
+
+/*!
+    \brief      get a consistent copy of the statistics of a probe
+    \param[in]  probe: the probe
+      \arg        PROFILE_x: a probe of profile_probe_enum
+    \param[out] entry: the statistics, all 0 for an unknown probe
+    \retval     none
+*/
+void profile_get(profile_probe_enum probe, profile_entry_struct *entry)
+{
+    uint32_t primask;
+
+    if(PROFILE_PROBE_NUM <= probe) {
+        entry->count = 0U;
+        entry->min = 0U;
+        entry->max = 0U;
+        entry->total = 0U;
+        return;
+    }
+
+    primask = profile_irq_save();
+    *entry = profile_table[probe];
+    profile_irq_restore(primask);
+}
+
+/*!
+    \brief      get the average of the statistics
+    \param[in]  entry: the statistics
+    \param[out] none
+    \retval     the rounded average in microseconds, 0 without samples
+*/
+uint32_t profile_average(const profile_entry_struct *entry)
+{
+    if(0U == entry->count) {
+        return 0U;
+    }
+
+    return (uint32_t)((entry->total + (entry->count / 2U)) / entry->count);
+}
+
+/*!
+    \brief      get the name of a probe
+    \param[in]  probe: the probe
+      \arg        PROFILE_x: a probe of profile_probe_enum
+    \param[out] none
+    \retval     name of the probe, "?" for an unknown probe
+*/
+const char *profile_name_get(profile_probe_enum probe)
+{
+    if(PROFILE_PROBE_NUM <= probe) {
+        return "?";
+    }
+
+    return profile_name[probe];
+}
+
+/*!
+    \brief      print the statistics by printf(), one line per probe
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void profile_dump(void)
+{
+    profile_entry_struct entry;
+    uint8_t i;
+
+    printf("%-16s %10s %10s %10s %10s\n\r", "probe", "count", "min us", "avg us", "max us");
+    for(i = 0U; i < (uint8_t)PROFILE_PROBE_NUM; i++) {
+        profile_get((profile_probe_enum)i, &entry);
+        printf("%-16s %10u %10u %10u %10u\n\r", profile_name[i], (unsigned int)entry.count,
+               (unsigned int)entry.min, (unsigned int)profile_average(&entry), (unsigned int)entry.max);
+    }
+}
+
+/*!
+    \brief      disable the interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     the previous PRIMASK
+*/
+static uint32_t profile_irq_save(void)
+{
+#ifdef PROFILE_HOST
+    return 0U;
+#else
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+#endif /* PROFILE_HOST */
+}
+
+/*!
+    \brief      restore the interrupts
+    \param[in]  primask: PRIMASK of profile_irq_save()
+    \param[out] none
+    \retval     none
+*/
+static void profile_irq_restore(uint32_t primask)
+{
+#ifdef PROFILE_HOST
+    (void)primask;
+#else
+    __set_PRIMASK(primask);
+#endif /* PROFILE_HOST */
+}
+#endif /* PROFILE_ENABLE */
@@ -0,0 +1,98 @@
+/*!
+    \file  profile.h
+    \brief the header file of the profiling probes
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+/* define PROFILE_HOST to build the statistics on a host, the test then provides time_now_us32() */
+#ifdef PROFILE_HOST
+#include <stdint.h>
+uint32_t time_now_us32(void);
+#else
+#include "gd32c2x1.h"
+#include "time_base.h"
+#endif
+
+/* the probes, keep profile_name[] of profile.c in the same order */
+typedef enum {
+    PROFILE_USART0_IRQ = 0,         /*!< USART0_IRQHandler() */
+    PROFILE_DMA_CH0_IRQ,            /*!< DMA_Channel0_IRQHandler() */
+    PROFILE_DMA_CH1_IRQ,            /*!< DMA_Channel1_IRQHandler() */
+    PROFILE_DMA_CH2_IRQ,            /*!< DMA_Channel2_IRQHandler() */
+    PROFILE_TIMER13_LATENCY,        /*!< from the TIMER13 update to TIMER13_IRQHandler() */
+    PROFILE_MAIN_TX_WAIT,           /*!< main() blocked until the start-up string is sent */
+    PROFILE_MAIN_LOOP,              /*!< one pass of the main loop */
+    PROFILE_PROBE_NUM
+} profile_probe_enum;
+
+/* statistics of a probe in microseconds */
+typedef struct {
+    uint32_t count;                 /*!< number of samples */
+    uint32_t min;                   /*!< shortest sample */
+    uint32_t max;                   /*!< longest sample */
+    uint64_t total;                 /*!< sum of the samples */
+} profile_entry_struct;
+
+/* define PROFILE_ENABLE to build the probes, without it they generate no code */
+#ifdef PROFILE_ENABLE
+/* the statistics, read them by the debugger from this symbol */
+extern profile_entry_struct profile_table[PROFILE_PROBE_NUM];
+
+/* start timing a probe, at the start of a block */
+#define PROFILE_BEGIN(probe)        uint32_t profile_start_##probe = time_now_us32()
+/* end timing a probe, in the block of its PROFILE_BEGIN() */
+#define PROFILE_END(probe)          profile_record((probe), time_now_us32() - profile_start_##probe)
+/* add a sample measured another way */
+#define PROFILE_RECORD(probe, us)   profile_record((probe), (us))
+
+/* clear the statistics */
+void profile_reset(void);
+/* add a sample to the statistics of a probe, safe to call from interrupts */
+void profile_record(profile_probe_enum probe, uint32_t us);
+/* get a consistent copy of the statistics of a probe */
+void profile_get(profile_probe_enum probe, profile_entry_struct *entry);
+/* get the average of the statistics */
+uint32_t profile_average(const profile_entry_struct *entry);
+/* get the name of a probe */
+const char *profile_name_get(profile_probe_enum probe);
+/* print the statistics by printf() */
+void profile_dump(void);
+#else
+#define PROFILE_BEGIN(probe)
+#define PROFILE_END(probe)
+#define PROFILE_RECORD(probe, us)
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H */
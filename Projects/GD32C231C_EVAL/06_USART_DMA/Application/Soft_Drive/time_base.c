@@ -0,0 +1,241 @@
+/*!
+    \file  time_base.c
+    \brief 64-bit microsecond time base from a free-running 16-bit TIMER
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "time_base.h"
+
+#ifdef TIME_BASE_HOST
+/* the host test models the counter and the update flag of the TIMER */
+extern uint32_t time_base_host_counter(void);
+extern uint32_t time_base_host_update(void);
+extern void time_base_host_update_clear(void);
+#define TIME_BASE_COUNTER()         time_base_host_counter()
+#define TIME_BASE_UPDATE()          time_base_host_update()
+#define TIME_BASE_UPDATE_CLEAR()    time_base_host_update_clear()
+#else
+#define TIME_BASE_COUNTER()         TIMER_CNT(TIME_BASE_TIMER)
+#define TIME_BASE_UPDATE()          (TIMER_INTF(TIME_BASE_TIMER) & TIMER_INTF_UPIF)
+#define TIME_BASE_UPDATE_CLEAR()    (TIMER_INTF(TIME_BASE_TIMER) = ~(uint32_t)TIMER_INTF_UPIF)
+#endif /* TIME_BASE_HOST */
+
+/* number of TIMER overflows, the high bits of the time, read and written with the interrupts disabled */
+static volatile uint64_t time_base_overflow = 0U;
+
+static uint64_t time_base_read(uint32_t *counter);
+static uint32_t time_base_irq_save(void);
+static void time_base_irq_restore(uint32_t primask);
+
+#ifndef TIME_BASE_HOST
+/*!
+    \brief      start the time base, the TIMER counts at 1MHz from 0 to 0xFFFF
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void time_base_init(void)
+{
+    timer_parameter_struct timer_initpara;
+
+    rcu_periph_clock_enable(TIME_BASE_TIMER_CLK);
+
+    timer_deinit(TIME_BASE_TIMER);
+    timer_struct_para_init(&timer_initpara);
+    /* the TIMER clock is the system clock */
+    timer_initpara.prescaler         = (uint16_t)(SystemCoreClock / 1000000U - 1U);
+    timer_initpara.alignedmode       = TIMER_COUNTER_EDGE;
+    timer_initpara.counterdirection  = TIMER_COUNTER_UP;
+    timer_initpara.period            = 0xFFFFU;
+    timer_initpara.clockdivision     = TIMER_CKDIV_DIV1;
+    timer_init(TIME_BASE_TIMER, &timer_initpara);
+
+    time_base_overflow = 0U;
+    timer_interrupt_flag_clear(TIME_BASE_TIMER, TIMER_INT_FLAG_UP);
+    timer_interrupt_enable(TIME_BASE_TIMER, TIMER_INT_UP);
+    /* the readers handle an overflow whose interrupt is not served yet, it may wait up to 32ms */
+    nvic_irq_enable(TIME_BASE_TIMER_IRQn, 0U);
+    timer_enable(TIME_BASE_TIMER);
+}
+#endif /* TIME_BASE_HOST */
+
+/*!
+    \brief      count a TIMER overflow, call it from the TIMER interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void time_base_irq_handler(void)
+{
+    uint32_t primask;
+
+    /* a reader in a higher priority interrupt sees the flag or the count, never neither */
+    primask = time_base_irq_save();
+    if(0U != TIME_BASE_UPDATE()) {
+        TIME_BASE_UPDATE_CLEAR();
+        time_base_overflow++;
+    }
+    time_base_irq_restore(primask);
+}
+
+/*!
+    \brief      get the microseconds since time_base_init(), safe to call from interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     time in microseconds, it doesn't wrap
+*/
+uint64_t time_now_us(void)
+{
+    uint32_t counter;
+    uint64_t overflow = time_base_read(&counter);
+
+    return ((uint64_t)overflow << 16) | counter;
+}
+
+/*!
+    \brief      get the low 32 bits of time_now_us(), safe to call from interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     time in microseconds, wraps after 71 minutes
+*/
+uint32_t time_now_us32(void)
+{
+    uint32_t counter;
+    uint32_t overflow = (uint32_t)time_base_read(&counter);
+
+    return (overflow << 16) | counter;
+}
+
+/*!
+    \brief      get the microseconds since a time_now_us32() value, right across the wrap
+    \param[in]  start: time_now_us32() at the start of the interval
+    \param[out] none
+    \retval     length of the interval, shorter than 71 minutes
+*/
+uint32_t time_elapsed_us(uint32_t start)
+{
+    return time_now_us32() - start;
+}
+
+/*!
+    \brief      wait a time in microseconds
+    \param[in]  count: count in microseconds
+    \param[out] none
+    \retval     none
+*/
+void delay_us(uint32_t count)
+{
+    uint32_t start = time_now_us32();
+
+    while(time_elapsed_us(start) < count) {
+    }
+}
+
+/*!
+    \brief      get the time of a deadline in microseconds from now
+    \param[in]  timeout: microseconds from now
+    \param[out] none
+    \retval     deadline for time_deadline_reached()
+*/
+uint64_t time_deadline_get(uint32_t timeout)
+{
+    return time_now_us() + timeout;
+}
+
+/*!
+    \brief      check whether a deadline of time_deadline_get() is reached
+    \param[in]  deadline: time in microseconds
+    \param[out] none
+    \retval     SET if the deadline is reached, RESET otherwise
+*/
+FlagStatus time_deadline_reached(uint64_t deadline)
+{
+    return (time_now_us() >= deadline) ? SET : RESET;
+}
+
+/*!
+    \brief      read the TIMER and the overflows consistently
+    \param[in]  none
+    \param[out] counter: TIMER counter
+    \retval     number of overflows
+*/
+static uint64_t time_base_read(uint32_t *counter)
+{
+    uint64_t overflow;
+    uint32_t primask, value;
+
+    primask = time_base_irq_save();
+    overflow = time_base_overflow;
+    value = TIME_BASE_COUNTER() & 0xFFFFU;
+    /* an overflow not served yet by the interrupt, which is masked here or has a lower priority;
+       a low counter shows it happened before the counter read, a high one that it happened after */
+    if((0U != TIME_BASE_UPDATE()) && (0x8000U > value)) {
+        overflow++;
+    }
+    time_base_irq_restore(primask);
+
+    *counter = value;
+    return overflow;
+}
+
+/*!
+    \brief      disable the interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     the previous PRIMASK
+*/
+static uint32_t time_base_irq_save(void)
+{
+#ifdef TIME_BASE_HOST
+    return 0U;
+#else
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+#endif /* TIME_BASE_HOST */
+}
+
+/*!
+    \brief      restore the interrupts
+    \param[in]  primask: PRIMASK of time_base_irq_save()
+    \param[out] none
+    \retval     none
+*/
+static void time_base_irq_restore(uint32_t primask)
+{
+#ifdef TIME_BASE_HOST
+    (void)primask;
+#else
+    __set_PRIMASK(primask);
+#endif /* TIME_BASE_HOST */
+}
@@ -0,0 +1,69 @@
+/*!
+    \file  time_base.h
+    \brief the header file of the microsecond time base
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef TIME_BASE_H
+#define TIME_BASE_H
+
+/* define TIME_BASE_HOST to build the overflow extension on a host, the test then models the TIMER */
+#ifdef TIME_BASE_HOST
+#include <stdint.h>
+typedef enum {RESET = 0, SET = !RESET} FlagStatus;
+#else
+#include "gd32c2x1.h"
+#endif
+
+/* free-running TIMER counting microseconds, its update interrupt extends the count */
+#define TIME_BASE_TIMER             TIMER13
+#define TIME_BASE_TIMER_CLK         RCU_TIMER13
+#define TIME_BASE_TIMER_IRQn        TIMER13_IRQn
+
+/* start the time base */
+void time_base_init(void);
+/* count a TIMER overflow, called by the TIMER interrupt */
+void time_base_irq_handler(void);
+/* get the microseconds since time_base_init(), safe to call from interrupts */
+uint64_t time_now_us(void);
+/* get the low 32 bits of time_now_us(), cheaper, wraps after 71 minutes */
+uint32_t time_now_us32(void);
+/* get the microseconds since a time_now_us32() value */
+uint32_t time_elapsed_us(uint32_t start);
+/* wait a time in microseconds */
+void delay_us(uint32_t count);
+/* get the time of a deadline in microseconds from now */
+uint64_t time_deadline_get(uint32_t timeout);
+/* check whether a deadline of time_deadline_get() is reached */
+FlagStatus time_deadline_reached(uint64_t deadline);
+
+#endif /* TIME_BASE_H */
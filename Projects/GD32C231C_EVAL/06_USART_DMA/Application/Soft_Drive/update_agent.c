@@ -0,0 +1,304 @@
+/*!
+    \file  update_agent.c
+    \brief firmware update agent, writes the image received in frames into the inactive slot
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "update_agent.h"
+#include "boot_slot.h"
+#include "crc_service.h"
+#include "flash_write.h"
+#include "frame_link.h"
+#include "gd32c231c_eval.h"
+#include <string.h>
+
+/* the image is read back by blocks, the interrupts are masked during each block */
+#define UPDATE_AGENT_VERIFY_BLOCK       0x400U
+
+/* frame passed by the receive interrupt, free when its length is 0 */
+static uint8_t agent_frame[FRAME_LINK_PAYLOAD_SIZE];
+static __IO uint32_t agent_frame_length = 0U;
+
+static uint32_t agent_slot;
+static uint32_t agent_size;
+static uint32_t agent_crc;
+static uint32_t agent_offset;
+static FlagStatus agent_started = RESET;
+static FlagStatus agent_reset = RESET;
+static crc_service_context_struct agent_context;
+
+static uint8_t update_agent_start(const uint8_t *payload, uint32_t number);
+static uint8_t update_agent_data(const uint8_t *payload, uint32_t number);
+static uint8_t update_agent_end(void);
+static uint32_t update_agent_target_slot(void);
+static uint32_t update_agent_value_get(const uint8_t *data);
+static void update_agent_reply(uint8_t command, uint8_t status, uint32_t value);
+
+/*!
+    \brief      pass a frame to the agent, called in the receive interrupt
+    \param[in]  payload: payload of the frame, the command first
+    \param[in]  number: number of bytes of the payload
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the previous frame is not processed yet
+*/
+ErrStatus update_agent_receive(const uint8_t *payload, uint32_t number)
+{
+    /* the host waits for the reply of each frame, so one frame is enough */
+    if((0U != agent_frame_length) || (0U == number) || (number > sizeof(agent_frame))) {
+        return ERROR;
+    }
+    memcpy(agent_frame, payload, number);
+    agent_frame_length = number;
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      process the received frame, the flash is erased and programmed here
+                and not in the receive interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void update_agent_poll(void)
+{
+    uint8_t command;
+    uint8_t status;
+    uint32_t value = 0U;
+
+    /* the new image is started by the bootloader once the last reply is sent */
+    if(SET == agent_reset) {
+        frame_link_tx_flush();
+        gd_eval_com_tx_flush();
+        nvic_system_reset();
+    }
+
+    if(0U == agent_frame_length) {
+        return;
+    }
+
+    command = agent_frame[0];
+    switch(command) {
+    case UPDATE_AGENT_QUERY:
+        value = update_agent_target_slot();
+        status = (0U != value) ? UPDATE_AGENT_OK : UPDATE_AGENT_ERROR_SLOT;
+        break;
+    case UPDATE_AGENT_START:
+        status = update_agent_start(agent_frame, agent_frame_length);
+        break;
+    case UPDATE_AGENT_DATA:
+        status = update_agent_data(agent_frame, agent_frame_length);
+        value = agent_offset;
+        break;
+    case UPDATE_AGENT_END:
+        status = update_agent_end();
+        value = agent_crc;
+        break;
+    default:
+        status = UPDATE_AGENT_ERROR_STATE;
+        break;
+    }
+    update_agent_reply(command, status, value);
+
+    agent_frame_length = 0U;
+}
+
+/*!
+    \brief      start an update of the inactive slot
+    \param[in]  payload: command, size(4), CRC-32(4)
+    \param[in]  number: number of bytes of the payload
+    \param[out] none
+    \retval     status of the reply
+*/
+static uint8_t update_agent_start(const uint8_t *payload, uint32_t number)
+{
+    agent_started = RESET;
+
+    agent_slot = update_agent_target_slot();
+    if(0U == agent_slot) {
+        return UPDATE_AGENT_ERROR_SLOT;
+    }
+    if(9U != number) {
+        return UPDATE_AGENT_ERROR_STATE;
+    }
+    agent_size = update_agent_value_get(&payload[1]);
+    agent_crc = update_agent_value_get(&payload[5]);
+    if((0U == agent_size) || (agent_size > BOOT_SLOT_IMAGE_SIZE)) {
+        return UPDATE_AGENT_ERROR_SIZE;
+    }
+
+    /* the descriptor of the slot is rewritten last, until then the slot can't be started */
+    flash_write_init();
+    crc_service_start(&agent_context, &crc_service_crc32);
+    agent_offset = 0U;
+    agent_started = SET;
+
+    return UPDATE_AGENT_OK;
+}
+
+/*!
+    \brief      write a chunk of the image into the slot
+    \param[in]  payload: command, offset(4), data
+    \param[in]  number: number of bytes of the payload
+    \param[out] none
+    \retval     status of the reply
+*/
+static uint8_t update_agent_data(const uint8_t *payload, uint32_t number)
+{
+    uint32_t length;
+
+    if((RESET == agent_started) || (number < 5U)) {
+        return UPDATE_AGENT_ERROR_STATE;
+    }
+    /* a repeated or lost chunk, the reply gives the offset to resume from */
+    if(update_agent_value_get(&payload[1]) != agent_offset) {
+        return UPDATE_AGENT_ERROR_OFFSET;
+    }
+    length = number - 5U;
+    if(length > (agent_size - agent_offset)) {
+        return UPDATE_AGENT_ERROR_SIZE;
+    }
+
+    if(FMC_READY != flash_write(agent_slot + agent_offset, &payload[5], length)) {
+        agent_started = RESET;
+        return UPDATE_AGENT_ERROR_FLASH;
+    }
+    crc_service_update(&agent_context, &payload[5], length);
+    agent_offset += length;
+
+    return UPDATE_AGENT_OK;
+}
+
+/*!
+    \brief      verify the image and write the descriptor of the slot
+    \param[in]  none
+    \param[out] none
+    \retval     status of the reply
+*/
+static uint8_t update_agent_end(void)
+{
+    const boot_slot_descriptor_struct *active;
+    boot_slot_descriptor_struct descriptor;
+    crc_service_context_struct context;
+    uint32_t offset, length;
+
+    if((RESET == agent_started) || (agent_offset != agent_size)) {
+        return UPDATE_AGENT_ERROR_STATE;
+    }
+    agent_started = RESET;
+
+    if(FMC_READY != flash_write_flush()) {
+        return UPDATE_AGENT_ERROR_FLASH;
+    }
+
+    /* the CRC of the received chunks, then the CRC of the programmed flash */
+    if(crc_service_finish(&agent_context) != agent_crc) {
+        return UPDATE_AGENT_ERROR_CRC;
+    }
+    crc_service_start(&context, &crc_service_crc32);
+    for(offset = 0U; offset < agent_size; offset += length) {
+        length = agent_size - offset;
+        if(length > UPDATE_AGENT_VERIFY_BLOCK) {
+            length = UPDATE_AGENT_VERIFY_BLOCK;
+        }
+        crc_service_update(&context, (const void *)(uintptr_t)(agent_slot + offset), length);
+    }
+    if(crc_service_finish(&context) != agent_crc) {
+        return UPDATE_AGENT_ERROR_CRC;
+    }
+
+    /* the new slot gets the next sequence number, so the bootloader prefers it */
+    active = BOOT_SLOT_DESCRIPTOR((BOOT_SLOT_A_ADDRESS == agent_slot) ? BOOT_SLOT_B_ADDRESS : BOOT_SLOT_A_ADDRESS);
+    descriptor.magic = BOOT_SLOT_MAGIC;
+    descriptor.size = agent_size;
+    descriptor.crc = agent_crc;
+    descriptor.sequence = ((BOOT_SLOT_MAGIC == active->magic) ? active->sequence : 0U) + 1U;
+    if((FMC_READY != flash_write(agent_slot + BOOT_SLOT_IMAGE_SIZE, &descriptor, sizeof(descriptor))) ||
+            (FMC_READY != flash_write_flush()) ||
+            (0 != memcmp(BOOT_SLOT_DESCRIPTOR(agent_slot), &descriptor, sizeof(descriptor)))) {
+        return UPDATE_AGENT_ERROR_FLASH;
+    }
+
+    agent_reset = SET;
+
+    return UPDATE_AGENT_OK;
+}
+
+/*!
+    \brief      get the slot to update, the one the application doesn't run from
+    \param[in]  none
+    \param[out] none
+    \retval     address of the slot, 0 if the application was not started by the bootloader
+*/
+static uint32_t update_agent_target_slot(void)
+{
+    if(BOOT_SLOT_A_ADDRESS == SCB->VTOR) {
+        return BOOT_SLOT_B_ADDRESS;
+    } else if(BOOT_SLOT_B_ADDRESS == SCB->VTOR) {
+        return BOOT_SLOT_A_ADDRESS;
+    } else {
+        return 0U;
+    }
+}
+
+/*!
+    \brief      read a 32-bit value sent least significant byte first
+    \param[in]  data: pointer to the value
+    \param[out] none
+    \retval     value
+*/
+static uint32_t update_agent_value_get(const uint8_t *data)
+{
+    return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+/*!
+    \brief      send the reply of a command
+    \param[in]  command: command of the frame
+    \param[in]  status: UPDATE_AGENT_OK or an UPDATE_AGENT_ERROR_ status
+    \param[in]  value: value of the reply
+    \param[out] none
+    \retval     none
+*/
+static void update_agent_reply(uint8_t command, uint8_t status, uint32_t value)
+{
+    uint8_t reply[7];
+
+    reply[0] = UPDATE_AGENT_REPLY;
+    reply[1] = command;
+    reply[2] = status;
+    reply[3] = (uint8_t)value;
+    reply[4] = (uint8_t)(value >> 8);
+    reply[5] = (uint8_t)(value >> 16);
+    reply[6] = (uint8_t)(value >> 24);
+    frame_link_tx_put(reply, sizeof(reply));
+}
@@ -0,0 +1,63 @@
+/*!
+    \file  update_agent.h
+    \brief the header file of the firmware update agent
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef UPDATE_AGENT_H
+#define UPDATE_AGENT_H
+
+#include "gd32c2x1.h"
+
+/* commands, the first byte of the frame payload, the values are least significant byte first */
+#define UPDATE_AGENT_QUERY              0x10U   /*!< reply value: address of the slot to update */
+#define UPDATE_AGENT_START              0x11U   /*!< size(4), CRC-32(4) of the image */
+#define UPDATE_AGENT_DATA               0x12U   /*!< offset(4), data, reply value: next offset */
+#define UPDATE_AGENT_END                0x13U   /*!< reply value: CRC-32 of the image, then reset */
+#define UPDATE_AGENT_REPLY              0x1FU   /*!< command(1), status(1), value(4) */
+#define UPDATE_AGENT_COMMAND(c)         (0x10U == ((c) & 0xF0U))
+
+/* status of the replies */
+#define UPDATE_AGENT_OK                 0x00U   /*!< done */
+#define UPDATE_AGENT_ERROR_STATE        0x01U   /*!< command out of sequence */
+#define UPDATE_AGENT_ERROR_SIZE         0x02U   /*!< the image doesn't fit the slot */
+#define UPDATE_AGENT_ERROR_OFFSET       0x03U   /*!< data not at the next offset, which is the value */
+#define UPDATE_AGENT_ERROR_FLASH        0x04U   /*!< erase or program error */
+#define UPDATE_AGENT_ERROR_CRC          0x05U   /*!< the image doesn't match its CRC-32 */
+#define UPDATE_AGENT_ERROR_SLOT         0x06U   /*!< the application was not started by the bootloader */
+
+/* pass a frame to the agent, called in the receive interrupt */
+ErrStatus update_agent_receive(const uint8_t *payload, uint32_t number);
+/* process the received frame, called in the main loop */
+void update_agent_poll(void);
+
+#endif /* UPDATE_AGENT_H */
@@ -0,0 +1,232 @@
+/*!
+    \file  usart_dma_rx.c
+    \brief USART circular DMA receive of variable length frames
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "usart_dma_rx.h"
+#include <stddef.h>
+
+static uint8_t rx_buffer[USART_DMA_RX_BUFFER_SIZE];
+static uint32_t rx_periph;
+static uint32_t rx_last;
+static uint32_t rx_overrun;
+static usart_dma_rx_callback rx_callback = NULL;
+
+static void usart_dma_rx_deliver(FlagStatus frame_end);
+
+/*!
+    \brief      start the circular DMA receive of a configured and enabled USART
+    \param[in]  usart_periph: USARTx(x=0,1,2)
+    \param[in]  callback: function receiving the data in place
+    \param[out] none
+    \retval     none
+*/
+void usart_dma_rx_init(uint32_t usart_periph, usart_dma_rx_callback callback)
+{
+    dma_parameter_struct dma_init_struct;
+    IRQn_Type usart_irq;
+
+    rx_periph = usart_periph;
+    rx_callback = callback;
+    rx_last = 0U;
+    rx_overrun = 0U;
+
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    dma_deinit(USART_DMA_RX_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    if(USART0 == usart_periph) {
+        dma_init_struct.request = DMA_REQUEST_USART0_RX;
+        usart_irq = USART0_IRQn;
+    } else if(USART1 == usart_periph) {
+        dma_init_struct.request = DMA_REQUEST_USART1_RX;
+        usart_irq = USART1_IRQn;
+    } else {
+        dma_init_struct.request = DMA_REQUEST_USART2_RX;
+        usart_irq = USART2_IRQn;
+    }
+    dma_init_struct.direction    = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)rx_buffer;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number       = USART_DMA_RX_BUFFER_SIZE;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&USART_RDATA(usart_periph);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_ULTRA_HIGH;
+    dma_init(USART_DMA_RX_CHANNEL, &dma_init_struct);
+
+    /* the buffer is never stopped, the write position wraps around */
+    dma_circulation_enable(USART_DMA_RX_CHANNEL);
+    dma_memory_to_memory_disable(USART_DMA_RX_CHANNEL);
+    dmamux_synchronization_disable(USART_DMA_RX_MUXCH);
+    dma_interrupt_flag_clear(USART_DMA_RX_CHANNEL, DMA_INT_FLAG_G);
+    dma_interrupt_enable(USART_DMA_RX_CHANNEL, DMA_INT_HTF | DMA_INT_FTF);
+    dma_channel_enable(USART_DMA_RX_CHANNEL);
+
+    /* the frame end is the receiver timeout on USART0 and the idle line on the others */
+    usart_disable(usart_periph);
+    if(USART0 == usart_periph) {
+        usart_receiver_timeout_threshold_config(usart_periph, USART_DMA_RX_TIMEOUT);
+        usart_receiver_timeout_enable(usart_periph);
+    }
+    usart_dma_receive_config(usart_periph, USART_RECEIVE_DMA_ENABLE);
+    usart_enable(usart_periph);
+
+    usart_flag_clear(usart_periph, USART_FLAG_ORERR);
+    if(USART0 == usart_periph) {
+        usart_interrupt_flag_clear(usart_periph, USART_INT_FLAG_RT);
+        usart_interrupt_enable(usart_periph, USART_INT_RT);
+    } else {
+        usart_interrupt_flag_clear(usart_periph, USART_INT_FLAG_IDLE);
+        usart_interrupt_enable(usart_periph, USART_INT_IDLE);
+    }
+    usart_interrupt_enable(usart_periph, USART_INT_ERR);
+
+    /* the same priority on both interrupts keeps the delivery in order */
+    nvic_irq_enable(USART_DMA_RX_DMA_IRQn, 1U);
+    nvic_irq_enable(usart_irq, 1U);
+}
+
+/*!
+    \brief      stop the receive
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void usart_dma_rx_deinit(void)
+{
+    usart_interrupt_disable(rx_periph, USART_INT_RT);
+    usart_interrupt_disable(rx_periph, USART_INT_IDLE);
+    usart_interrupt_disable(rx_periph, USART_INT_ERR);
+    usart_dma_receive_config(rx_periph, USART_RECEIVE_DMA_DISABLE);
+    dma_channel_disable(USART_DMA_RX_CHANNEL);
+    dma_interrupt_disable(USART_DMA_RX_CHANNEL, DMA_INT_HTF | DMA_INT_FTF);
+    rx_callback = NULL;
+}
+
+/*!
+    \brief      get the number of bytes lost by overrun
+    \param[in]  none
+    \param[out] none
+    \retval     number of overrun errors since the init
+*/
+uint32_t usart_dma_rx_overrun_get(void)
+{
+    return rx_overrun;
+}
+
+/*!
+    \brief      handle the receiver timeout, idle line and error interrupt of the USART
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void usart_dma_rx_irq_handler(void)
+{
+    if(RESET != usart_interrupt_flag_get(rx_periph, USART_INT_FLAG_ERR_ORERR)) {
+        usart_interrupt_flag_clear(rx_periph, USART_INT_FLAG_ERR_ORERR);
+        rx_overrun++;
+    }
+    if(RESET != usart_interrupt_flag_get(rx_periph, USART_INT_FLAG_ERR_NERR)) {
+        usart_interrupt_flag_clear(rx_periph, USART_INT_FLAG_ERR_NERR);
+    }
+    if(RESET != usart_interrupt_flag_get(rx_periph, USART_INT_FLAG_ERR_FERR)) {
+        usart_interrupt_flag_clear(rx_periph, USART_INT_FLAG_ERR_FERR);
+    }
+    if(RESET != usart_interrupt_flag_get(rx_periph, USART_INT_FLAG_RT)) {
+        usart_interrupt_flag_clear(rx_periph, USART_INT_FLAG_RT);
+        usart_dma_rx_deliver(SET);
+    }
+    if(RESET != usart_interrupt_flag_get(rx_periph, USART_INT_FLAG_IDLE)) {
+        usart_interrupt_flag_clear(rx_periph, USART_INT_FLAG_IDLE);
+        usart_dma_rx_deliver(SET);
+    }
+}
+
+/*!
+    \brief      handle the half and full transfer interrupt of the DMA channel
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void usart_dma_rx_dma_irq_handler(void)
+{
+    if(RESET != dma_interrupt_flag_get(USART_DMA_RX_CHANNEL, DMA_INT_FLAG_HTF)) {
+        dma_interrupt_flag_clear(USART_DMA_RX_CHANNEL, DMA_INT_FLAG_HTF);
+        usart_dma_rx_deliver(RESET);
+    }
+    if(RESET != dma_interrupt_flag_get(USART_DMA_RX_CHANNEL, DMA_INT_FLAG_FTF)) {
+        dma_interrupt_flag_clear(USART_DMA_RX_CHANNEL, DMA_INT_FLAG_FTF);
+        usart_dma_rx_deliver(RESET);
+    }
+}
+
+/*!
+    \brief      pass the bytes written by the DMA since the last call to the callback
+    \param[in]  frame_end: SET if the line went idle after the bytes
+    \param[out] none
+    \retval     none
+*/
+static void usart_dma_rx_deliver(FlagStatus frame_end)
+{
+    uint32_t position;
+
+    /* the write position of the DMA, the counter reloads to the full size at the wrap */
+    position = USART_DMA_RX_BUFFER_SIZE - dma_transfer_number_get(USART_DMA_RX_CHANNEL);
+    if(USART_DMA_RX_BUFFER_SIZE == position) {
+        position = 0U;
+    }
+
+    if(NULL == rx_callback) {
+        rx_last = position;
+        return;
+    }
+
+    if(position > rx_last) {
+        rx_callback(&rx_buffer[rx_last], position - rx_last, frame_end);
+    } else if(position < rx_last) {
+        /* the bytes wrap around the end of the buffer, deliver both parts in place */
+        if(0U == position) {
+            rx_callback(&rx_buffer[rx_last], USART_DMA_RX_BUFFER_SIZE - rx_last, frame_end);
+        } else {
+            rx_callback(&rx_buffer[rx_last], USART_DMA_RX_BUFFER_SIZE - rx_last, RESET);
+            rx_callback(&rx_buffer[0], position, frame_end);
+        }
+    } else if(SET == frame_end) {
+        /* the frame ended at a half buffer boundary, its bytes are already delivered */
+        rx_callback(&rx_buffer[position], 0U, SET);
+    }
+    rx_last = position;
+}
@@ -0,0 +1,67 @@
+/*!
+    \file  usart_dma_rx.h
+    \brief the header file of USART circular DMA receive
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef USART_DMA_RX_H
+#define USART_DMA_RX_H
+
+#include "gd32c2x1.h"
+
+/* size of the circular receive buffer, the DMA interrupts at each half */
+#define USART_DMA_RX_BUFFER_SIZE        128U
+
+/* DMA channel of the receiver */
+#define USART_DMA_RX_CHANNEL            DMA_CH1
+#define USART_DMA_RX_MUXCH              DMAMUX_MUXCH1
+#define USART_DMA_RX_DMA_IRQn           DMA_Channel1_IRQn
+
+/* silence ending a frame, in bit times (USART0 receiver timeout, the other USARTs use the idle line) */
+#define USART_DMA_RX_TIMEOUT            20U
+
+/* receive callback, data points into the DMA buffer and is valid until the callback returns,
+   a frame is delivered in one or more pieces, frame_end is SET on its last piece, which may be empty */
+typedef void (*usart_dma_rx_callback)(const uint8_t *data, uint32_t number, FlagStatus frame_end);
+
+/* start the circular DMA receive of a configured and enabled USART */
+void usart_dma_rx_init(uint32_t usart_periph, usart_dma_rx_callback callback);
+/* stop the receive */
+void usart_dma_rx_deinit(void);
+/* get the number of bytes lost by overrun */
+uint32_t usart_dma_rx_overrun_get(void);
+/* handle the receiver timeout, idle line and error interrupt of the USART */
+void usart_dma_rx_irq_handler(void);
+/* handle the half and full transfer interrupt of the DMA channel */
+void usart_dma_rx_dma_irq_handler(void);
+
+#endif /* USART_DMA_RX_H */
@@ -0,0 +1,101 @@
+/*!
+    \file    frame_bench.c
+    \brief   round trip benchmark of the frame_link example of 06_USART_DMA
+
+    \version 2025-06-03, V1.0.0, host tools for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "frame_host.h"
+
+/* each frame is sent again after 100 ms without its echo, 3 times at most */
+#define BENCH_TIMEOUT_MS        100
+#define BENCH_RETRIES           3U
+
+/*!
+    \brief      send frames of a given size to the board and wait for each echo
+    \param[in]  argc: number of arguments
+    \param[in]  argv: device [frames [payload size [baud rate]]]
+    \param[out] none
+    \retval     0 if every frame was echoed
+*/
+int main(int argc, char *argv[])
+{
+    frame_host_link_struct link;
+    uint8_t request[FRAME_HOST_PAYLOAD_SIZE];
+    uint8_t reply[FRAME_HOST_PAYLOAD_SIZE];
+    uint32_t frames = 1000U, size = 64U, baudrate = 115200U;
+    uint32_t i, j, echoed = 0U;
+    struct timespec start, end;
+    double seconds;
+
+    if(argc < 2) {
+        printf("usage: %s device [frames [payload size [baud rate]]]\n", argv[0]);
+        return 2;
+    }
+    if(argc > 2) {
+        frames = (uint32_t)strtoul(argv[2], NULL, 0);
+    }
+    if(argc > 3) {
+        size = (uint32_t)strtoul(argv[3], NULL, 0);
+    }
+    if(argc > 4) {
+        baudrate = (uint32_t)strtoul(argv[4], NULL, 0);
+    }
+    if((size > FRAME_HOST_PAYLOAD_SIZE) || (0 != frame_host_open(&link, argv[1], baudrate))) {
+        printf("%s: cannot open %s at %u baud with %u byte frames\n", argv[0], argv[1],
+               (unsigned int)baudrate, (unsigned int)size);
+        return 2;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0U; i < frames; i++) {
+        /* the first byte stays below the commands of the update agent and the status frames */
+        request[0] = (uint8_t)(i & 0x0FU);
+        for(j = 1U; j < size; j++) {
+            request[j] = (uint8_t)(i + j);
+        }
+        if((int)size == frame_host_request(&link, request, size, reply, sizeof(reply),
+                                           frame_host_ack_echo, BENCH_TIMEOUT_MS, BENCH_RETRIES)) {
+            echoed++;
+        }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    seconds = (double)(end.tv_sec - start.tv_sec) + ((double)(end.tv_nsec - start.tv_nsec) / 1e9);
+
+    printf("%u of %u frames echoed, %u retransmits, %u bad frames received\n", (unsigned int)echoed,
+           (unsigned int)frames, (unsigned int)link.retransmits, (unsigned int)link.decoder.errors);
+    printf("%.1f frames/s, %.0f payload bytes/s each way\n", echoed / seconds, (echoed * size) / seconds);
+    frame_host_close(&link);
+
+    return (echoed == frames) ? 0 : 1;
+}
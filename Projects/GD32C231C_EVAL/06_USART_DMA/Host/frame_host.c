@@ -0,0 +1,407 @@
+/*!
+    \file    frame_host.c
+    \brief   host side of the frame_link protocol of 06_USART_DMA, for POSIX serial ports
+
+    \version 2025-06-03, V1.0.0, host tools for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "frame_host.h"
+#include "crc_service.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+/*!
+    \brief      encode a payload and its CRC trailer, COBS, followed by the delimiter
+    \param[in]  payload: data of the frame
+    \param[in]  number: number of bytes
+    \param[out] frame: encoded frame, FRAME_HOST_ENCODED_SIZE(number) bytes at most
+    \retval     number of encoded bytes
+*/
+uint32_t frame_host_encode(uint8_t *frame, const uint8_t *payload, uint32_t number)
+{
+    uint32_t crc = crc_service_calculate(&crc_service_crc32_mpeg2, payload, number);
+    uint32_t code_index = 0U;
+    uint32_t index = 1U;
+    uint32_t i;
+    uint8_t code = 1U;
+    uint8_t byte;
+
+    for(i = 0U; i < (number + FRAME_HOST_CRC_SIZE); i++) {
+        byte = (i < number) ? payload[i] : (uint8_t)(crc >> (8U * (i - number)));
+        if(0x00U == byte) {
+            frame[code_index] = code;
+            code_index = index++;
+            code = 1U;
+        } else {
+            frame[index++] = byte;
+            code++;
+            if(0xFFU == code) {
+                frame[code_index] = code;
+                code_index = index++;
+                code = 1U;
+            }
+        }
+    }
+    frame[code_index] = code;
+    frame[index++] = FRAME_HOST_DELIMITER;
+
+    return index;
+}
+
+/*!
+    \brief      reset a decoder
+    \param[in]  decoder: decoder state
+    \param[out] none
+    \retval     none
+*/
+void frame_host_decoder_init(frame_host_decoder_struct *decoder)
+{
+    memset(decoder, 0, sizeof(*decoder));
+    decoder->code = 0xFFU;
+}
+
+/*!
+    \brief      check the decoded frame at the delimiter
+    \param[in]  decoder: decoder state
+    \param[out] none
+    \retval     payload size of a good frame, -1 otherwise
+*/
+static int frame_host_frame_end(frame_host_decoder_struct *decoder)
+{
+    uint32_t number;
+    uint32_t crc;
+    int result = -1;
+
+    if((0U == decoder->error) && (0U == decoder->remaining) && (0U == decoder->length) && (0xFFU == decoder->code)) {
+        /* back to back delimiters */
+    } else if((0U != decoder->error) || (0U != decoder->remaining) || (decoder->length < FRAME_HOST_CRC_SIZE)) {
+        decoder->errors++;
+    } else {
+        number = decoder->length - FRAME_HOST_CRC_SIZE;
+        crc = (uint32_t)decoder->frame[number] | ((uint32_t)decoder->frame[number + 1U] << 8) |
+              ((uint32_t)decoder->frame[number + 2U] << 16) | ((uint32_t)decoder->frame[number + 3U] << 24);
+        if(crc != crc_service_calculate(&crc_service_crc32_mpeg2, decoder->frame, number)) {
+            decoder->errors++;
+        } else {
+            decoder->frames++;
+            result = (int)number;
+        }
+    }
+
+    decoder->length = 0U;
+    decoder->code = 0xFFU;
+    decoder->remaining = 0U;
+    decoder->error = 0U;
+
+    return result;
+}
+
+/*!
+    \brief      decode a byte, the payload of a good frame is at the start of decoder->frame
+    \param[in]  decoder: decoder state
+    \param[in]  byte: received byte
+    \param[out] none
+    \retval     payload size when the byte ends a good frame, -1 otherwise
+*/
+int frame_host_decode(frame_host_decoder_struct *decoder, uint8_t byte)
+{
+    if(FRAME_HOST_DELIMITER == byte) {
+        return frame_host_frame_end(decoder);
+    }
+    if(0U != decoder->error) {
+        /* skip to the next delimiter */
+    } else if(0U == decoder->remaining) {
+        if(0xFFU != decoder->code) {
+            if(decoder->length >= sizeof(decoder->frame)) {
+                decoder->error = 1U;
+            } else {
+                decoder->frame[decoder->length++] = 0x00U;
+            }
+        }
+        decoder->code = byte;
+        decoder->remaining = byte - 1U;
+    } else {
+        if(decoder->length >= sizeof(decoder->frame)) {
+            decoder->error = 1U;
+        } else {
+            decoder->frame[decoder->length++] = byte;
+        }
+        decoder->remaining--;
+    }
+
+    return -1;
+}
+
+/*!
+    \brief      get the termios speed of a baud rate
+    \param[in]  baudrate: bits per second
+    \param[out] none
+    \retval     speed, B0 if not supported
+*/
+static speed_t frame_host_speed(uint32_t baudrate)
+{
+    switch(baudrate) {
+    case 9600U:
+        return B9600;
+    case 19200U:
+        return B19200;
+    case 38400U:
+        return B38400;
+    case 57600U:
+        return B57600;
+    case 115200U:
+        return B115200;
+    case 230400U:
+        return B230400;
+    case 460800U:
+        return B460800;
+    case 921600U:
+        return B921600;
+    default:
+        return B0;
+    }
+}
+
+/*!
+    \brief      open a serial port in raw mode, 8 data bits, no parity, 1 stop bit
+    \param[in]  link: link state
+    \param[in]  device: path of the serial port
+    \param[in]  baudrate: bits per second
+    \param[out] none
+    \retval     0 or -1
+*/
+int frame_host_open(frame_host_link_struct *link, const char *device, uint32_t baudrate)
+{
+    struct termios tio;
+    speed_t speed = frame_host_speed(baudrate);
+
+    memset(link, 0, sizeof(*link));
+    frame_host_decoder_init(&link->decoder);
+    link->fd = -1;
+    if(B0 == speed) {
+        return -1;
+    }
+
+    link->fd = open(device, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    if(link->fd < 0) {
+        return -1;
+    }
+    if(0 != tcgetattr(link->fd, &tio)) {
+        frame_host_close(link);
+        return -1;
+    }
+    cfmakeraw(&tio);
+    tio.c_cflag |= CLOCAL | CREAD;
+    tio.c_cflag &= ~(CSTOPB | CRTSCTS);
+    tio.c_cc[VMIN] = 1U;
+    tio.c_cc[VTIME] = 0U;
+    cfsetispeed(&tio, speed);
+    cfsetospeed(&tio, speed);
+    if(0 != tcsetattr(link->fd, TCSANOW, &tio)) {
+        frame_host_close(link);
+        return -1;
+    }
+    tcflush(link->fd, TCIOFLUSH);
+
+    return 0;
+}
+
+/*!
+    \brief      close the serial port
+    \param[in]  link: link state
+    \param[out] none
+    \retval     none
+*/
+void frame_host_close(frame_host_link_struct *link)
+{
+    if(link->fd >= 0) {
+        close(link->fd);
+        link->fd = -1;
+    }
+}
+
+/*!
+    \brief      send a frame
+    \param[in]  link: link state
+    \param[in]  payload: data of the frame
+    \param[in]  number: number of bytes, up to FRAME_HOST_PAYLOAD_SIZE
+    \param[out] none
+    \retval     0 or -1
+*/
+int frame_host_send(frame_host_link_struct *link, const uint8_t *payload, uint32_t number)
+{
+    uint8_t frame[FRAME_HOST_ENCODED_SIZE(FRAME_HOST_PAYLOAD_SIZE)];
+    uint32_t length, done = 0U;
+    ssize_t written;
+
+    if(number > FRAME_HOST_PAYLOAD_SIZE) {
+        return -1;
+    }
+    length = frame_host_encode(frame, payload, number);
+    while(done < length) {
+        written = write(link->fd, &frame[done], length - done);
+        if(written < 0) {
+            if(EINTR == errno) {
+                continue;
+            }
+            return -1;
+        }
+        done += (uint32_t)written;
+    }
+
+    return 0;
+}
+
+/*!
+    \brief      get the time of the monotonic clock
+    \param[in]  none
+    \param[out] none
+    \retval     time in milliseconds
+*/
+static int64_t frame_host_now_ms(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((int64_t)now.tv_sec * 1000) + (now.tv_nsec / 1000000);
+}
+
+/*!
+    \brief      wait for the next good frame, the bad frames are skipped
+    \param[in]  link: link state
+    \param[in]  size: size of payload
+    \param[in]  timeout_ms: longest wait
+    \param[out] payload: payload of the frame, cut to size bytes
+    \retval     payload size or -1 after the timeout
+*/
+int frame_host_receive(frame_host_link_struct *link, uint8_t *payload, uint32_t size, int timeout_ms)
+{
+    int64_t deadline = frame_host_now_ms() + timeout_ms;
+    struct pollfd pfd;
+    ssize_t count;
+    int number;
+    int wait;
+
+    while(1) {
+        /* decode the bytes already read first */
+        while(link->input_index < link->input_length) {
+            number = frame_host_decode(&link->decoder, link->input[link->input_index++]);
+            if(number >= 0) {
+                memcpy(payload, link->decoder.frame, ((uint32_t)number < size) ? (uint32_t)number : size);
+                return number;
+            }
+        }
+
+        wait = (int)(deadline - frame_host_now_ms());
+        if(wait <= 0) {
+            return -1;
+        }
+        pfd.fd = link->fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, wait) <= 0) {
+            continue;
+        }
+        count = read(link->fd, link->input, sizeof(link->input));
+        if(count <= 0) {
+            if((count < 0) && (EINTR != errno) && (EAGAIN != errno)) {
+                return -1;
+            }
+            continue;
+        }
+        link->input_length = (uint32_t)count;
+        link->input_index = 0U;
+    }
+}
+
+/*!
+    \brief      send a request until a frame acknowledges it, the other frames are skipped
+    \param[in]  link: link state
+    \param[in]  request: payload of the request
+    \param[in]  number: number of bytes of the request
+    \param[in]  size: size of reply
+    \param[in]  ack: acknowledge test, NULL takes the first good frame
+    \param[in]  timeout_ms: wait for the acknowledge of each attempt
+    \param[in]  retries: number of times the request is sent again
+    \param[out] reply: payload of the acknowledge, cut to size bytes
+    \retval     payload size of the acknowledge or -1
+*/
+int frame_host_request(frame_host_link_struct *link, const uint8_t *request, uint32_t number,
+                       uint8_t *reply, uint32_t size, frame_host_ack ack, int timeout_ms, uint32_t retries)
+{
+    uint8_t frame[FRAME_HOST_PAYLOAD_SIZE];
+    uint32_t attempt;
+    int64_t deadline;
+    int length;
+    int wait;
+
+    for(attempt = 0U; attempt <= retries; attempt++) {
+        if(0U != attempt) {
+            link->retransmits++;
+        }
+        if(0 != frame_host_send(link, request, number)) {
+            return -1;
+        }
+        deadline = frame_host_now_ms() + timeout_ms;
+        while((wait = (int)(deadline - frame_host_now_ms())) > 0) {
+            length = frame_host_receive(link, frame, sizeof(frame), wait);
+            if(length < 0) {
+                break;
+            }
+            if((NULL == ack) || (0 != ack(request, number, frame, (uint32_t)length))) {
+                memcpy(reply, frame, ((uint32_t)length < size) ? (uint32_t)length : size);
+                return length;
+            }
+        }
+    }
+    link->failures++;
+
+    return -1;
+}
+
+/*!
+    \brief      acknowledge of the example: the board echoes each frame
+    \param[in]  request: payload of the request
+    \param[in]  request_number: number of bytes of the request
+    \param[in]  reply: payload of a received frame
+    \param[in]  reply_number: number of bytes of the frame
+    \param[out] none
+    \retval     1 if the frame is the echo of the request, 0 otherwise
+*/
+int frame_host_ack_echo(const uint8_t *request, uint32_t request_number,
+                        const uint8_t *reply, uint32_t reply_number)
+{
+    return (request_number == reply_number) && (0 == memcmp(request, reply, request_number));
+}
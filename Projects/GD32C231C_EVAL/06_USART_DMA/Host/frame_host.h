@@ -0,0 +1,94 @@
+/*!
+    \file    frame_host.h
+    \brief   host side of the frame_link protocol of 06_USART_DMA, for POSIX serial ports
+
+    \version 2025-06-03, V1.0.0, host tools for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef FRAME_HOST_H
+#define FRAME_HOST_H
+
+#include <stdint.h>
+
+/* the frame format of frame_link.h: payload, CRC-32/MPEG-2 least significant byte first, COBS, 0x00 */
+#define FRAME_HOST_PAYLOAD_SIZE         128U
+#define FRAME_HOST_DELIMITER            0x00U
+#define FRAME_HOST_CRC_SIZE             4U
+#define FRAME_HOST_ENCODED_SIZE(n)      ((n) + FRAME_HOST_CRC_SIZE + (((n) + FRAME_HOST_CRC_SIZE) / 254U) + 2U)
+
+/* incremental decoder, fed byte by byte */
+typedef struct {
+    uint8_t frame[FRAME_HOST_PAYLOAD_SIZE + FRAME_HOST_CRC_SIZE];
+    uint32_t length;
+    uint8_t code;
+    uint8_t remaining;
+    uint8_t error;
+    uint32_t frames;                    /* good frames */
+    uint32_t errors;                    /* frames dropped for their encoding, length or CRC */
+} frame_host_decoder_struct;
+
+/* serial link to the board */
+typedef struct {
+    int fd;
+    frame_host_decoder_struct decoder;
+    uint8_t input[256];                 /* bytes read from the port and not decoded yet */
+    uint32_t input_length;
+    uint32_t input_index;
+    uint32_t retransmits;               /* requests sent again by frame_host_request() */
+    uint32_t failures;                  /* requests without an acknowledge after every retry */
+} frame_host_link_struct;
+
+/* tell whether reply acknowledges request */
+typedef int (*frame_host_ack)(const uint8_t *request, uint32_t request_number,
+                              const uint8_t *reply, uint32_t reply_number);
+
+/* encode a payload into frame, FRAME_HOST_ENCODED_SIZE(number) bytes at most, return the frame size */
+uint32_t frame_host_encode(uint8_t *frame, const uint8_t *payload, uint32_t number);
+/* reset a decoder */
+void frame_host_decoder_init(frame_host_decoder_struct *decoder);
+/* decode a byte, return the payload size when it ends a good frame, -1 otherwise */
+int frame_host_decode(frame_host_decoder_struct *decoder, uint8_t byte);
+
+/* open a serial port in raw mode, return 0 or -1 */
+int frame_host_open(frame_host_link_struct *link, const char *device, uint32_t baudrate);
+/* close the serial port */
+void frame_host_close(frame_host_link_struct *link);
+/* send a frame, return 0 or -1 */
+int frame_host_send(frame_host_link_struct *link, const uint8_t *payload, uint32_t number);
+/* wait for the next good frame, return its payload size or -1 after timeout_ms */
+int frame_host_receive(frame_host_link_struct *link, uint8_t *payload, uint32_t size, int timeout_ms);
+/* send a request until a frame acknowledges it, return the reply size or -1 */
+int frame_host_request(frame_host_link_struct *link, const uint8_t *request, uint32_t number,
+                       uint8_t *reply, uint32_t size, frame_host_ack ack, int timeout_ms, uint32_t retries);
+/* acknowledge of the example: the board echoes each frame */
+int frame_host_ack_echo(const uint8_t *request, uint32_t request_number,
+                        const uint8_t *reply, uint32_t reply_number);
+
+#endif /* FRAME_HOST_H */
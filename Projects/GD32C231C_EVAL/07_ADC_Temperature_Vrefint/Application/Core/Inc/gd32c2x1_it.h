@@ -48,5 +48,11 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 /* this function handles SysTick exception */
 void SysTick_Handler(void);
+/* this function handles DMA_Channel0_IRQHandler interrupt */
+void DMA_Channel0_IRQHandler(void);
+/* this function handles DMA_Channel2_IRQHandler interrupt */
+void DMA_Channel2_IRQHandler(void);
+/* this function handles ADC_IRQHandler interrupt */
+void ADC_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
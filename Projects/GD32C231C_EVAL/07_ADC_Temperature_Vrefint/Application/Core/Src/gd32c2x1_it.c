@@ -33,7 +33,10 @@ OF SUCH DAMAGE.
 */
 
 #include "gd32c2x1_it.h"
+#include "gd32c231c_eval.h"
 #include "systick.h"
+#include "adc_scan.h"
+#include "adc_monitor.h"
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -106,3 +109,36 @@ void SysTick_Handler(void)
 {
     delay_decrement();
 }
+
+/*!
+    \brief      this function handles DMA_Channel0_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel0_IRQHandler(void)
+{
+    adc_scan_dma_irq_handler();
+}
+
+/*!
+    \brief      this function handles DMA_Channel2_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel2_IRQHandler(void)
+{
+    gd_eval_com_tx_dma_irq_handler();
+}
+
+/*!
+    \brief      this function handles ADC_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void ADC_IRQHandler(void)
+{
+    adc_monitor_irq_handler();
+}
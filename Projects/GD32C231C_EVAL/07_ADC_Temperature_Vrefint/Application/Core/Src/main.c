@@ -36,17 +36,40 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include <stdio.h>
 #include "gd32c231c_eval.h"
+#include "adc_scan.h"
+#include "adc_monitor.h"
+#include "adc_convert.h"
 
+#define COUNTOF(a)              (sizeof(a) / sizeof(*(a)))
+
+/* means of the last half buffer, temperature then VREFINT */
 __IO uint16_t adc_value[2];
-float temperature;
-float vref_value;
+__IO uint32_t adc_block_count = 0U;
+/* millidegrees Celsius and millivolts */
+int32_t temperature;
+uint32_t vref_value;
+uint32_t vdda_value;
+/* signals whose state changed since the last print */
+__IO uint8_t monitor_event = 0U;
+
+/* the sensor voltage falls as the temperature rises, so the window is [60 degrees, 0 degrees] and LOW means too hot,
+   VREFINT is about 1.2V, it leaves its window when VDDA moves by 3 percent */
+static const adc_monitor_signal_struct monitor_signal[] = {
+    {"temperature", ADC_CHANNEL_13, {ADC_CONVERT_TEMPERATURE_RAW(60), ADC_CONVERT_TEMPERATURE_RAW(0), 6U}},
+    {"vrefint",     ADC_CHANNEL_14, {1444U, 1534U, 8U}}
+};
+static const char *const monitor_state_name[] = {"normal", "low", "high"};
 
 /* configure RCU peripheral */
 void rcu_config(void);
 /* configure ADC peripheral */
 void adc_config(void);
-/* ADC channel sample */
-void adc_channel_sample(void);
+/* ADC half buffer callback */
+static void adc_block_handle(const uint16_t *data, uint32_t frame_number);
+/* last conversion of a monitored channel */
+static uint16_t adc_monitor_value(uint8_t channel);
+/* monitor state change callback */
+static void adc_monitor_event(uint8_t signal, adc_monitor_state_enum state, uint16_t value);
 
 /*!
     \brief      main function
@@ -56,6 +79,9 @@ void adc_channel_sample(void);
 */
 int main(void)
 {
+    char text[ADC_CONVERT_FORMAT_SIZE];
+    uint8_t event, i;
+
     /* configure systick */
     systick_config();
 
@@ -66,22 +92,42 @@ int main(void)
 
     /* USART configuration */
     gd_eval_com_init(EVAL_COM);
+    /* printf returns once the text is in the COM ring buffer */
+    gd_eval_com_tx_dma_init(EVAL_COM);
     printf("\r /**** ADC Demo ****/\r\n");
 
+    /* the scans run in the background, TIMER2 triggers them and the DMA stores them */
+    adc_scan_start();
+
     while(1){
-        /* ADC software trigger enable */
-        adc_channel_sample();
         /* delay a time in milliseconds */
         delay_ms(1000);
 
-        /* value convert */
-        temperature = (0.924 - ((float)(adc_value[0])*3.3f / 4095)) * 1000 / 2.52f + 25;
-        vref_value = (adc_value[1] * 3.3f / 4095);
+        /* the analog watchdogs report the out of range signals, nothing compares the values here */
+        __disable_irq();
+        event = monitor_event;
+        monitor_event = 0U;
+        __enable_irq();
+        for(i = 0U; i < COUNTOF(monitor_signal); i++) {
+            if(0U != (event & (1U << i))) {
+                printf("\r\n %s is %s", adc_monitor_name_get(i), monitor_state_name[adc_monitor_state_get(i)]);
+            }
+        }
+
+        /* value convert, VDDA is measured by VREFINT and corrects the temperature */
+        vdda_value = adc_convert_vdda_mv(adc_value[1]);
+        temperature = adc_convert_temperature_mdeg(adc_value[0], vdda_value);
+        vref_value = adc_convert_millivolt(adc_value[1], ADC_CONVERT_VDDA_MV);
 
         /* value print */
         printf("\r\n *******************");
-        printf("\r\n the temperature data is %2.0f degrees Celsius", temperature);
-        printf("\r\n the reference voltage data is %5.3fV", vref_value);
+        adc_convert_format(text, temperature, 0U);
+        printf("\r\n the temperature data is %s degrees Celsius", text);
+        adc_convert_format(text, (int32_t)vref_value, 3U);
+        printf("\r\n the reference voltage data is %sV", text);
+        adc_convert_format(text, (int32_t)vdda_value, 3U);
+        printf("\r\n the VDDA computed from it is %sV", text);
+        printf("\r\n %u scans, %u overruns", (unsigned int)(adc_block_count * ADC_SCAN_FRAME_NUM), (unsigned int)adc_scan_overrun_get());
         printf("\r\n ******************* \r\n");
     }
 }
@@ -96,8 +142,8 @@ void rcu_config(void)
 {
     /* enable ADC clock */
     rcu_periph_clock_enable(RCU_ADC);
-    /* config ADC clock */
-    rcu_adc_clock_config(RCU_ADCSRC_CKSYS, RCU_ADCCK_DIV256);
+    /* config ADC clock, CK_SYS / 4 leaves room for the oversampled scans at ADC_SCAN_RATE_HZ */
+    rcu_adc_clock_config(RCU_ADCSRC_CKSYS, RCU_ADCCK_DIV4);
 }
 
 /*!
@@ -108,51 +154,57 @@ void rcu_config(void)
 */
 void adc_config(void)
 {
-    /* ADC continuous function enable */
-    adc_special_function_config(ADC_CONTINUOUS_MODE, DISABLE);
-    /* ADC scan function enable */
-    adc_special_function_config(ADC_SCAN_MODE, ENABLE);
-    /* ADC data alignment config */
-    adc_data_alignment_config(ADC_DATAALIGN_RIGHT);
-    /* ADC channel length config */
-    adc_channel_length_config(ADC_INSERTED_CHANNEL, 2);
-
-    /* ADC inserted channel config */
-    adc_inserted_channel_config(0U, ADC_CHANNEL_13, ADC_SAMPLETIME_160POINT5);
-    adc_inserted_channel_config(1U, ADC_CHANNEL_14, ADC_SAMPLETIME_160POINT5);
-
-    /* ADC trigger config */
-    adc_external_trigger_source_config(ADC_INSERTED_CHANNEL, ADC_EXTTRIG_INSERTED_NONE); 
-    adc_external_trigger_config(ADC_INSERTED_CHANNEL, ENABLE);
+    /* channel13(temperature sensor) and channel14(VREFINT) */
+    static const uint8_t channel[ADC_SCAN_CHANNEL_NUM] = {ADC_CHANNEL_13, ADC_CHANNEL_14};
 
     /* ADC temperature and Vrefint enable */
     adc_internal_channel_config(ADC_CHANNEL_INTERNAL_TEMPSENSOR, ENABLE);
     adc_internal_channel_config(ADC_CHANNEL_INTERNAL_VREFINT, ENABLE);
 
-    /* enable ADC interface */
-    adc_enable();
+    /* routine sequence triggered by TIMER2, oversampled and stored by DMA */
+    adc_scan_init(channel, adc_block_handle);
     delay_ms(1U);
+
+    /* analog watchdog 0 and 1 watch the scanned channels */
+    adc_monitor_init(monitor_signal, (uint8_t)COUNTOF(monitor_signal), adc_monitor_value, adc_monitor_event);
 }
 
 /*!
-    \brief      ADC channel sample
-    \param[in]  none
+    \brief      ADC half buffer callback, called by the DMA interrupt
+    \param[in]  data: frames of the half buffer
+    \param[in]  frame_number: number of frames
     \param[out] none
     \retval     none
 */
-void adc_channel_sample(void)
+static void adc_block_handle(const uint16_t *data, uint32_t frame_number)
 {
-    /* ADC software trigger enable */
-    adc_software_trigger_enable(ADC_INSERTED_CHANNEL);
-
-    /* wait for the end of conversion flag */
-    while( (adc_flag_get(ADC_FLAG_EOIC) == RESET) || (adc_flag_get(ADC_FLAG_EOC) == RESET) );
+    adc_value[0] = adc_scan_mean(data, frame_number, 0U);
+    adc_value[1] = adc_scan_mean(data, frame_number, 1U);
+    adc_block_count++;
+}
 
-    /* read ADC inserted data register:IDATA0��IDATA1 */
-    adc_value[0]=adc_inserted_data_read(ADC_INSERTED_CHANNEL_0);
-    adc_value[1]=adc_inserted_data_read(ADC_INSERTED_CHANNEL_1);
+/*!
+    \brief      last conversion of a monitored channel, called by the ADC interrupt
+    \param[in]  channel: ADC_CHANNEL_13 or ADC_CHANNEL_14
+    \param[out] none
+    \retval     value of the channel
+*/
+static uint16_t adc_monitor_value(uint8_t channel)
+{
+    return adc_scan_latest_get((ADC_CHANNEL_13 == channel) ? 0U : 1U);
+}
 
-    /* clear the end of conversion flag */
-    adc_flag_clear(ADC_FLAG_EOIC);
-    adc_flag_clear(ADC_FLAG_EOC);
+/*!
+    \brief      monitor state change callback, called by the ADC interrupt
+    \param[in]  signal: signal index
+    \param[in]  state: new state of the signal
+    \param[in]  value: value which changed the state
+    \param[out] none
+    \retval     none
+*/
+static void adc_monitor_event(uint8_t signal, adc_monitor_state_enum state, uint16_t value)
+{
+    (void)state;
+    (void)value;
+    monitor_event |= (uint8_t)(1U << signal);
 }
@@ -0,0 +1,135 @@
+/*!
+    \file  adc_convert.c
+    \brief fixed-point ADC conversions, no floating point is used
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "adc_convert.h"
+
+/* VDDA up to 5V keeps raw * vdda_mv * 200 below 2^32 */
+#define ADC_CONVERT_VDDA_MAX_MV         5000U
+
+/*!
+    \brief      get VDDA in millivolts from a conversion of VREFINT
+    \param[in]  vrefint_raw: ADC value of VREFINT
+    \param[out] none
+    \retval     VDDA in millivolts, ADC_CONVERT_VDDA_MV if vrefint_raw is 0
+*/
+uint32_t adc_convert_vdda_mv(uint16_t vrefint_raw)
+{
+    uint32_t vdda_mv;
+
+    if(0U == vrefint_raw) {
+        return ADC_CONVERT_VDDA_MV;
+    }
+    /* VREFINT = VDDA * raw / 4095 */
+    vdda_mv = ((ADC_CONVERT_VREFINT_MV * ADC_CONVERT_FULL_SCALE) + (vrefint_raw / 2U)) / vrefint_raw;
+
+    return (vdda_mv > ADC_CONVERT_VDDA_MAX_MV) ? ADC_CONVERT_VDDA_MAX_MV : vdda_mv;
+}
+
+/*!
+    \brief      convert an ADC value to millivolts
+    \param[in]  raw: ADC value, 0..4095
+    \param[in]  vdda_mv: VDDA in millivolts, up to 5000
+    \param[out] none
+    \retval     voltage in millivolts, rounded
+*/
+uint32_t adc_convert_millivolt(uint16_t raw, uint32_t vdda_mv)
+{
+    return ((raw * vdda_mv) + (ADC_CONVERT_FULL_SCALE / 2U)) / ADC_CONVERT_FULL_SCALE;
+}
+
+/*!
+    \brief      convert a temperature sensor value to millidegrees Celsius
+    \param[in]  raw: ADC value of the temperature sensor, 0..4095
+    \param[in]  vdda_mv: VDDA in millivolts, up to 5000
+    \param[out] none
+    \retval     temperature in millidegrees Celsius, rounded
+*/
+int32_t adc_convert_temperature_mdeg(uint16_t raw, uint32_t vdda_mv)
+{
+    uint32_t voltage_uv;
+    int32_t delta;
+
+    /* raw * vdda_mv * 1000 / 4095 with 1000 / 4095 reduced to 200 / 819 */
+    voltage_uv = ((raw * vdda_mv * 200U) + 409U) / 819U;
+
+    /* (V25 - V) / 2.52mV per degree, in millidegrees (V25 - V) * 1000 / 2520 = (V25 - V) * 25 / 63 */
+    delta = (int32_t)(ADC_CONVERT_TEMP_V25_UV - (int32_t)voltage_uv) * 25;
+    delta = (delta >= 0) ? ((delta + 31) / 63) : ((delta - 31) / 63);
+
+    return 25000 + delta;
+}
+
+/*!
+    \brief      format a value in thousandths with 0 to 3 decimals, rounded half away from zero
+    \param[in]  buffer: ADC_CONVERT_FORMAT_SIZE bytes at least
+    \param[in]  milli: value in thousandths
+    \param[in]  decimals: number of decimals, 0..3
+    \param[out] buffer: null terminated text
+    \retval     length of the text
+*/
+uint8_t adc_convert_format(char *buffer, int32_t milli, uint8_t decimals)
+{
+    static const uint16_t power[4] = {1U, 10U, 100U, 1000U};
+    char digit[10];
+    uint32_t value, scale;
+    uint8_t length = 0U, count = 0U;
+
+    if(decimals > 3U) {
+        decimals = 3U;
+    }
+    scale = power[3U - decimals];
+    value = (milli < 0) ? (0U - (uint32_t)milli) : (uint32_t)milli;
+    value = (value / scale) + (((value % scale) >= ((scale + 1U) / 2U)) && (scale > 1U) ? 1U : 0U);
+
+    if((milli < 0) && (0U != value)) {
+        buffer[length++] = '-';
+    }
+
+    /* digits from the lowest one, at least one digit before the point */
+    do {
+        digit[count++] = (char)('0' + (value % 10U));
+        value /= 10U;
+    } while((0U != value) || (count <= decimals));
+
+    while(0U != count) {
+        if(count == decimals) {
+            buffer[length++] = '.';
+        }
+        buffer[length++] = digit[--count];
+    }
+    buffer[length] = '\0';
+
+    return length;
+}
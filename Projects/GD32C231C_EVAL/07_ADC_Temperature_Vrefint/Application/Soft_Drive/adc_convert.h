@@ -0,0 +1,69 @@
+/*!
+    \file  adc_convert.h
+    \brief the header file of the fixed-point ADC conversions
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef ADC_CONVERT_H
+#define ADC_CONVERT_H
+
+#include "gd32c2x1.h"
+
+#define ADC_CONVERT_FULL_SCALE          4095U
+/* nominal VDDA, used when VREFINT is not measured */
+#define ADC_CONVERT_VDDA_MV             3300U
+/* typical VREFINT, the device has no factory calibration of it */
+#ifndef ADC_CONVERT_VREFINT_MV
+#define ADC_CONVERT_VREFINT_MV          1200U
+#endif
+/* temperature sensor voltage at 25 degrees and its slope, it falls as the temperature rises */
+#define ADC_CONVERT_TEMP_V25_UV         924000L
+#define ADC_CONVERT_TEMP_SLOPE_UV       2520L
+
+/* ADC value of the temperature sensor at t degrees Celsius with the nominal VDDA, for constant thresholds,
+   the voltages are multiples of 20uV so only the last division truncates */
+#define ADC_CONVERT_TEMPERATURE_RAW(t)  ((uint16_t)((((ADC_CONVERT_TEMP_V25_UV - (((t) - 25L) * ADC_CONVERT_TEMP_SLOPE_UV)) / 20L) * \
+                                         (long)ADC_CONVERT_FULL_SCALE) / ((long)ADC_CONVERT_VDDA_MV * 50L)))
+
+/* size of a buffer for adc_convert_format() */
+#define ADC_CONVERT_FORMAT_SIZE         13U
+
+/* get VDDA in millivolts from a conversion of VREFINT */
+uint32_t adc_convert_vdda_mv(uint16_t vrefint_raw);
+/* convert an ADC value to millivolts */
+uint32_t adc_convert_millivolt(uint16_t raw, uint32_t vdda_mv);
+/* convert a temperature sensor value to millidegrees Celsius */
+int32_t adc_convert_temperature_mdeg(uint16_t raw, uint32_t vdda_mv);
+/* format a value in thousandths with 0 to 3 decimals */
+uint8_t adc_convert_format(char *buffer, int32_t milli, uint8_t decimals);
+
+#endif /* ADC_CONVERT_H */
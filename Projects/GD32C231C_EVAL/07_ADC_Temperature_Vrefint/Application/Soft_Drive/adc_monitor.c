@@ -0,0 +1,265 @@
+/*!
+    \file  adc_monitor.c
+    \brief ADC signal monitor on the analog watchdogs with hysteresis
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "adc_monitor.h"
+#include <stddef.h>
+
+/*
+    a watchdog interrupts when a conversion of its channel is outside [low threshold, high threshold],
+    so the window of each state is the range which keeps the state:
+
+    NORMAL  [low, high]
+    LOW     [0, low + hysteresis]
+    HIGH    [high - hysteresis, ADC_MONITOR_VALUE_MAX]
+
+    the CPU only runs when a signal leaves the window of its state
+*/
+
+static adc_monitor_signal_struct monitor_signal[ADC_MONITOR_SIGNAL_NUM];
+static adc_monitor_state_enum monitor_state[ADC_MONITOR_SIGNAL_NUM];
+static uint8_t monitor_signal_number = 0U;
+static adc_monitor_value_get monitor_value_get = NULL;
+static adc_monitor_callback monitor_callback = NULL;
+
+static const uint32_t monitor_int[ADC_MONITOR_SIGNAL_NUM] = {ADC_INT_WD0E, ADC_INT_WD1E, ADC_INT_WD2E};
+static const uint32_t monitor_int_flag[ADC_MONITOR_SIGNAL_NUM] = {ADC_INT_FLAG_WD0E, ADC_INT_FLAG_WD1E, ADC_INT_FLAG_WD2E};
+
+static void adc_monitor_window_program(uint8_t signal);
+
+/*!
+    \brief      assign the signals to the watchdogs and enable their interrupts
+    \param[in]  signal: signals, signal n is watched by the analog watchdog n
+    \param[in]  signal_number: number of signals, 1..ADC_MONITOR_SIGNAL_NUM
+    \param[in]  value_get: gets the last conversion of a channel
+    \param[in]  callback: called on each state change
+    \param[out] none
+    \retval     ErrStatus: ERROR if a parameter is wrong, SUCCESS otherwise
+*/
+ErrStatus adc_monitor_init(const adc_monitor_signal_struct *signal, uint8_t signal_number,
+                           adc_monitor_value_get value_get, adc_monitor_callback callback)
+{
+    uint8_t i;
+
+    if((0U == signal_number) || (signal_number > ADC_MONITOR_SIGNAL_NUM) || (NULL == value_get)) {
+        return ERROR;
+    }
+    for(i = 0U; i < signal_number; i++) {
+        if((signal[i].channel > ADC_CHANNEL_15) || (signal[i].limit.low > signal[i].limit.high) ||
+                (signal[i].limit.high > ADC_MONITOR_VALUE_MAX)) {
+            return ERROR;
+        }
+    }
+
+    monitor_signal_number = signal_number;
+    monitor_value_get = value_get;
+    monitor_callback = callback;
+
+    for(i = 0U; i < signal_number; i++) {
+        monitor_signal[i] = signal[i];
+        monitor_state[i] = ADC_MONITOR_NORMAL;
+        adc_monitor_window_program(i);
+        switch(i) {
+        case 0U:
+            adc_watchdog0_single_channel_enable(signal[i].channel);
+            break;
+        case 1U:
+            adc_watchdog1_channel_config(1UL << signal[i].channel, ENABLE);
+            break;
+        default:
+            adc_watchdog2_channel_config(1UL << signal[i].channel, ENABLE);
+            break;
+        }
+        adc_interrupt_flag_clear(monitor_int_flag[i]);
+        adc_interrupt_enable(monitor_int[i]);
+    }
+    nvic_irq_enable(ADC_IRQn, 1U);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      change the limits of a signal, its window is reprogrammed for its current state
+    \param[in]  signal: signal index
+    \param[in]  limit: new limits
+    \param[out] none
+    \retval     ErrStatus: ERROR if a parameter is wrong, SUCCESS otherwise
+*/
+ErrStatus adc_monitor_limit_set(uint8_t signal, const adc_monitor_limit_struct *limit)
+{
+    if((signal >= monitor_signal_number) || (limit->low > limit->high) || (limit->high > ADC_MONITOR_VALUE_MAX)) {
+        return ERROR;
+    }
+
+    /* the ADC interrupt reprograms the windows too */
+    nvic_irq_disable(ADC_IRQn);
+    monitor_signal[signal].limit = *limit;
+    adc_monitor_window_program(signal);
+    nvic_irq_enable(ADC_IRQn, 1U);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      get the state of a signal
+    \param[in]  signal: signal index
+    \param[out] none
+    \retval     state of the signal
+*/
+adc_monitor_state_enum adc_monitor_state_get(uint8_t signal)
+{
+    return (signal < monitor_signal_number) ? monitor_state[signal] : ADC_MONITOR_NORMAL;
+}
+
+/*!
+    \brief      get the name of a signal
+    \param[in]  signal: signal index
+    \param[out] none
+    \retval     name of the signal, NULL if there is no such signal
+*/
+const char *adc_monitor_name_get(uint8_t signal)
+{
+    return (signal < monitor_signal_number) ? monitor_signal[signal].name : NULL;
+}
+
+/*!
+    \brief      get the state of a signal after a conversion
+    \param[in]  limit: limits of the signal
+    \param[in]  state: state before the conversion
+    \param[in]  value: converted value
+    \param[out] none
+    \retval     state after the conversion
+*/
+adc_monitor_state_enum adc_monitor_state_next(const adc_monitor_limit_struct *limit, adc_monitor_state_enum state, uint16_t value)
+{
+    uint16_t low, high;
+
+    adc_monitor_window_get(limit, state, &low, &high);
+    if((value >= low) && (value <= high)) {
+        return state;
+    }
+
+    /* the signal left the window of its state */
+    if(value > limit->high) {
+        return ADC_MONITOR_HIGH;
+    } else if(value < limit->low) {
+        return ADC_MONITOR_LOW;
+    } else {
+        return ADC_MONITOR_NORMAL;
+    }
+}
+
+/*!
+    \brief      get the watchdog window which keeps a state
+    \param[in]  limit: limits of the signal
+    \param[in]  state: state of the signal
+    \param[out] low: low threshold
+    \param[out] high: high threshold
+    \retval     none
+*/
+void adc_monitor_window_get(const adc_monitor_limit_struct *limit, adc_monitor_state_enum state, uint16_t *low, uint16_t *high)
+{
+    uint32_t threshold;
+
+    switch(state) {
+    case ADC_MONITOR_LOW:
+        threshold = (uint32_t)limit->low + limit->hysteresis;
+        *low = 0U;
+        *high = (uint16_t)((threshold > ADC_MONITOR_VALUE_MAX) ? ADC_MONITOR_VALUE_MAX : threshold);
+        break;
+    case ADC_MONITOR_HIGH:
+        *low = (limit->high > limit->hysteresis) ? (uint16_t)(limit->high - limit->hysteresis) : 0U;
+        *high = ADC_MONITOR_VALUE_MAX;
+        break;
+    default:
+        *low = limit->low;
+        *high = limit->high;
+        break;
+    }
+}
+
+/*!
+    \brief      handle the analog watchdog interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void adc_monitor_irq_handler(void)
+{
+    adc_monitor_state_enum state;
+    uint16_t value;
+    uint8_t i;
+
+    for(i = 0U; i < monitor_signal_number; i++) {
+        if(RESET == adc_interrupt_flag_get(monitor_int_flag[i])) {
+            continue;
+        }
+
+        /* the window is moved before the flag is cleared, a conversion outside the new window sets it again */
+        value = monitor_value_get(monitor_signal[i].channel);
+        state = adc_monitor_state_next(&monitor_signal[i].limit, monitor_state[i], value);
+        if(state != monitor_state[i]) {
+            monitor_state[i] = state;
+            adc_monitor_window_program(i);
+            if(NULL != monitor_callback) {
+                monitor_callback(i, state, value);
+            }
+        }
+        adc_interrupt_flag_clear(monitor_int_flag[i]);
+    }
+}
+
+/*!
+    \brief      program the watchdog window of the state of a signal
+    \param[in]  signal: signal index
+    \param[out] none
+    \retval     none
+*/
+static void adc_monitor_window_program(uint8_t signal)
+{
+    uint16_t low, high;
+
+    adc_monitor_window_get(&monitor_signal[signal].limit, monitor_state[signal], &low, &high);
+    switch(signal) {
+    case 0U:
+        adc_watchdog0_threshold_config(low, high);
+        break;
+    case 1U:
+        adc_watchdog1_threshold_config(low, high);
+        break;
+    default:
+        adc_watchdog2_threshold_config(low, high);
+        break;
+    }
+}
@@ -0,0 +1,87 @@
+/*!
+    \file  adc_monitor.h
+    \brief the header file of the ADC analog watchdog monitor
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef ADC_MONITOR_H
+#define ADC_MONITOR_H
+
+#include "gd32c2x1.h"
+
+/* signal n is watched by the analog watchdog n */
+#define ADC_MONITOR_SIGNAL_NUM          3U
+#define ADC_MONITOR_VALUE_MAX           4095U
+
+/* state of a signal */
+typedef enum {
+    ADC_MONITOR_NORMAL = 0,                         /*!< the signal is inside its limits */
+    ADC_MONITOR_LOW,                                /*!< the signal went below the low limit */
+    ADC_MONITOR_HIGH                                /*!< the signal went above the high limit */
+} adc_monitor_state_enum;
+
+/* limits of a signal, it goes back to normal once it is hysteresis inside the limit it crossed */
+typedef struct {
+    uint16_t low;                                   /*!< low limit, 0..ADC_MONITOR_VALUE_MAX */
+    uint16_t high;                                  /*!< high limit, low..ADC_MONITOR_VALUE_MAX */
+    uint16_t hysteresis;                            /*!< hysteresis of both limits */
+} adc_monitor_limit_struct;
+
+/* signal watched by a watchdog */
+typedef struct {
+    const char *name;                               /*!< name of the signal */
+    uint8_t channel;                                /*!< ADC_CHANNEL_x (x=0..15), converted by the running scan */
+    adc_monitor_limit_struct limit;                 /*!< initial limits */
+} adc_monitor_signal_struct;
+
+/* get the last conversion of a channel, called by the ADC interrupt */
+typedef uint16_t (*adc_monitor_value_get)(uint8_t channel);
+/* state change callback, called by the ADC interrupt */
+typedef void (*adc_monitor_callback)(uint8_t signal, adc_monitor_state_enum state, uint16_t value);
+
+/* assign the signals to the watchdogs and enable their interrupts */
+ErrStatus adc_monitor_init(const adc_monitor_signal_struct *signal, uint8_t signal_number,
+                           adc_monitor_value_get value_get, adc_monitor_callback callback);
+/* change the limits of a signal, its window is reprogrammed for its current state */
+ErrStatus adc_monitor_limit_set(uint8_t signal, const adc_monitor_limit_struct *limit);
+/* get the state of a signal */
+adc_monitor_state_enum adc_monitor_state_get(uint8_t signal);
+/* get the name of a signal */
+const char *adc_monitor_name_get(uint8_t signal);
+/* get the state of a signal after a conversion */
+adc_monitor_state_enum adc_monitor_state_next(const adc_monitor_limit_struct *limit, adc_monitor_state_enum state, uint16_t value);
+/* get the watchdog window which ends a state */
+void adc_monitor_window_get(const adc_monitor_limit_struct *limit, adc_monitor_state_enum state, uint16_t *low, uint16_t *high);
+/* handle the analog watchdog interrupts */
+void adc_monitor_irq_handler(void);
+
+#endif /* ADC_MONITOR_H */
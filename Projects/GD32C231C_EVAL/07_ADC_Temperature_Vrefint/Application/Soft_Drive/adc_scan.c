@@ -0,0 +1,225 @@
+/*!
+    \file  adc_scan.c
+    \brief timer triggered ADC scan with oversampling and a circular DMA double buffer
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "adc_scan.h"
+#include <stddef.h>
+
+#define ADC_SCAN_HALF_SIZE              (ADC_SCAN_FRAME_NUM * ADC_SCAN_CHANNEL_NUM)
+
+/* two halves, the DMA fills one while the callback reads the other */
+static uint16_t scan_buffer[2U * ADC_SCAN_HALF_SIZE];
+static adc_scan_callback scan_callback = NULL;
+static uint32_t scan_overrun = 0U;
+
+/*!
+    \brief      configure the ADC sequence, TIMER2 and the circular DMA, the ADC is enabled but not triggered
+    \param[in]  channel: ADC_SCAN_CHANNEL_NUM channels of the routine sequence, ADC_CHANNEL_x (x=0..16)
+    \param[in]  callback: called from the DMA interrupt for each half buffer
+    \param[out] none
+    \retval     none
+*/
+void adc_scan_init(const uint8_t *channel, adc_scan_callback callback)
+{
+    dma_parameter_struct dma_init_struct;
+    timer_parameter_struct timer_initpara;
+    uint8_t rank;
+
+    scan_callback = callback;
+    scan_overrun = 0U;
+
+    /* the ADC writes the result of each rank to RDATA and requests the DMA through the DMAMUX */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+    dma_deinit(ADC_SCAN_DMA_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = DMA_REQUEST_ADC;
+    dma_init_struct.direction    = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)scan_buffer;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_16BIT;
+    dma_init_struct.number       = 2U * ADC_SCAN_HALF_SIZE;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&ADC_RDATA;
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_16BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_HIGH;
+    dma_init(ADC_SCAN_DMA_CHANNEL, &dma_init_struct);
+
+    dma_circulation_enable(ADC_SCAN_DMA_CHANNEL);
+    dma_memory_to_memory_disable(ADC_SCAN_DMA_CHANNEL);
+    dmamux_synchronization_disable(ADC_SCAN_DMA_MUXCH);
+    dma_interrupt_flag_clear(ADC_SCAN_DMA_CHANNEL, DMA_INT_FLAG_G);
+    dma_interrupt_enable(ADC_SCAN_DMA_CHANNEL, DMA_INT_HTF | DMA_INT_FTF);
+    dma_channel_enable(ADC_SCAN_DMA_CHANNEL);
+    nvic_irq_enable(ADC_SCAN_DMA_IRQn, 1U);
+
+    /* TIMER2 counts at 1MHz, its update event is the trigger output */
+    rcu_periph_clock_enable(RCU_TIMER2);
+    timer_deinit(TIMER2);
+    timer_struct_para_init(&timer_initpara);
+    timer_initpara.prescaler         = (uint16_t)((SystemCoreClock / 1000000U) - 1U);
+    timer_initpara.alignedmode       = TIMER_COUNTER_EDGE;
+    timer_initpara.counterdirection  = TIMER_COUNTER_UP;
+    timer_initpara.period            = (1000000U / ADC_SCAN_RATE_HZ) - 1U;
+    timer_initpara.clockdivision     = TIMER_CKDIV_DIV1;
+    timer_init(TIMER2, &timer_initpara);
+    timer_master_output_trigger_source_select(TIMER2, TIMER_TRI_OUT_SRC_UPDATE);
+
+    /* one trigger converts the whole sequence, the oversampling must be set while the ADC is off */
+    adc_disable();
+    adc_special_function_config(ADC_CONTINUOUS_MODE, DISABLE);
+    adc_special_function_config(ADC_SCAN_MODE, ENABLE);
+    adc_data_alignment_config(ADC_DATAALIGN_RIGHT);
+    adc_channel_length_config(ADC_ROUTINE_CHANNEL, ADC_SCAN_CHANNEL_NUM);
+    for(rank = 0U; rank < ADC_SCAN_CHANNEL_NUM; rank++) {
+        adc_routine_channel_config(rank, channel[rank], ADC_SCAN_SAMPLETIME);
+    }
+    adc_external_trigger_source_config(ADC_ROUTINE_CHANNEL, ADC_EXTTRIG_ROUTINE_T2_TRGO);
+    adc_external_trigger_config(ADC_ROUTINE_CHANNEL, ENABLE);
+    adc_oversample_mode_config(ADC_OVERSAMPLING_ALL_CONVERT, (uint16_t)OVSAMPCTL_OVSS(ADC_SCAN_OVERSAMPLE_BITS),
+                               (uint8_t)OVSAMPCTL_OVSR(ADC_SCAN_OVERSAMPLE_BITS - 1U));
+    adc_oversample_mode_enable();
+    adc_dma_mode_enable();
+    adc_enable();
+}
+
+/*!
+    \brief      start the scans
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void adc_scan_start(void)
+{
+    timer_enable(TIMER2);
+}
+
+/*!
+    \brief      stop the scans, the DMA keeps its position so that the next scan follows the last one
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void adc_scan_stop(void)
+{
+    timer_disable(TIMER2);
+}
+
+/*!
+    \brief      get the number of half buffers the callback was too late for
+    \param[in]  none
+    \param[out] none
+    \retval     number of overruns
+*/
+uint32_t adc_scan_overrun_get(void)
+{
+    return scan_overrun;
+}
+
+/*!
+    \brief      get the last conversion of a rank, read from the DMA buffer behind the DMA position
+    \param[in]  rank: rank in the sequence, 0 to ADC_SCAN_CHANNEL_NUM - 1
+    \param[out] none
+    \retval     last value of the rank
+*/
+uint16_t adc_scan_latest_get(uint8_t rank)
+{
+    uint32_t position = (2U * ADC_SCAN_HALF_SIZE) - dma_transfer_number_get(ADC_SCAN_DMA_CHANNEL);
+
+    /* the word before the position is the last one written, the rank may be in the previous frame */
+    if(0U == position) {
+        position = 2U * ADC_SCAN_HALF_SIZE;
+    }
+    position -= 1U + ((position - 1U + ADC_SCAN_CHANNEL_NUM - rank) % ADC_SCAN_CHANNEL_NUM);
+    if(position >= (2U * ADC_SCAN_HALF_SIZE)) {
+        position += 2U * ADC_SCAN_HALF_SIZE;
+    }
+
+    return scan_buffer[position];
+}
+
+/*!
+    \brief      get the rounded mean of a rank over the frames of a half buffer
+    \param[in]  data: frames given to the callback
+    \param[in]  frame_number: number of frames
+    \param[in]  rank: rank in the sequence, 0 to ADC_SCAN_CHANNEL_NUM - 1
+    \param[out] none
+    \retval     mean of the rank
+*/
+uint16_t adc_scan_mean(const uint16_t *data, uint32_t frame_number, uint8_t rank)
+{
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    if(0U == frame_number) {
+        return 0U;
+    }
+    for(i = 0U; i < frame_number; i++) {
+        sum += data[(i * ADC_SCAN_CHANNEL_NUM) + rank];
+    }
+
+    return (uint16_t)((sum + (frame_number / 2U)) / frame_number);
+}
+
+/*!
+    \brief      handle the half and full transfer interrupt of the DMA channel
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void adc_scan_dma_irq_handler(void)
+{
+    FlagStatus half = dma_interrupt_flag_get(ADC_SCAN_DMA_CHANNEL, DMA_INT_FLAG_HTF);
+    FlagStatus full = dma_interrupt_flag_get(ADC_SCAN_DMA_CHANNEL, DMA_INT_FLAG_FTF);
+    const uint16_t *data;
+    uint32_t position;
+
+    dma_interrupt_flag_clear(ADC_SCAN_DMA_CHANNEL, DMA_INT_FLAG_HTF | DMA_INT_FLAG_FTF);
+    if((RESET != half) && (RESET != full)) {
+        /* both halves ended since the last interrupt, only the half the DMA is not writing is whole */
+        scan_overrun++;
+        position = (2U * ADC_SCAN_HALF_SIZE) - dma_transfer_number_get(ADC_SCAN_DMA_CHANNEL);
+        data = (position < ADC_SCAN_HALF_SIZE) ? &scan_buffer[ADC_SCAN_HALF_SIZE] : &scan_buffer[0];
+    } else if(RESET != half) {
+        data = &scan_buffer[0];
+    } else if(RESET != full) {
+        data = &scan_buffer[ADC_SCAN_HALF_SIZE];
+    } else {
+        return;
+    }
+
+    if(NULL != scan_callback) {
+        scan_callback(data, ADC_SCAN_FRAME_NUM);
+    }
+}
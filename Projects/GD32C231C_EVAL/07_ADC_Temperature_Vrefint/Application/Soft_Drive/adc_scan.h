@@ -0,0 +1,78 @@
+/*!
+    \file  adc_scan.h
+    \brief the header file of the timer triggered ADC scan
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef ADC_SCAN_H
+#define ADC_SCAN_H
+
+#include "gd32c2x1.h"
+
+/* ranks of the routine sequence */
+#define ADC_SCAN_CHANNEL_NUM            2U
+/* scans in each half of the double buffer, the callback runs once per half */
+#define ADC_SCAN_FRAME_NUM              32U
+/* scans per second, TIMER2 update event triggers each scan */
+#define ADC_SCAN_RATE_HZ                1000U
+#define ADC_SCAN_SAMPLETIME             ADC_SAMPLETIME_160POINT5
+
+/* each result is the sum of 2^ADC_SCAN_OVERSAMPLE_BITS conversions shifted right by
+   ADC_SCAN_OVERSAMPLE_BITS, so it keeps the 12-bit range. with the ADC clock at CK_SYS / 4,
+   a scan of the 2 channels takes 2 * 16 * 173 cycles = 461us, below the 1ms scan period */
+#define ADC_SCAN_OVERSAMPLE_BITS        4U
+
+/* DMA channel of the scan */
+#define ADC_SCAN_DMA_CHANNEL            DMA_CH0
+#define ADC_SCAN_DMA_MUXCH              DMAMUX_MUXCH0
+#define ADC_SCAN_DMA_IRQn               DMA_Channel0_IRQn
+
+/* half buffer callback, data[frame * ADC_SCAN_CHANNEL_NUM + rank] holds the scans in the order
+   they were converted, it is valid until the DMA comes back to this half */
+typedef void (*adc_scan_callback)(const uint16_t *data, uint32_t frame_number);
+
+/* configure the ADC sequence, TIMER2 and the circular DMA, the ADC is enabled but not triggered */
+void adc_scan_init(const uint8_t *channel, adc_scan_callback callback);
+/* start the scans */
+void adc_scan_start(void);
+/* stop the scans */
+void adc_scan_stop(void);
+/* get the number of half buffers the callback was too late for */
+uint32_t adc_scan_overrun_get(void);
+/* get the last conversion of a rank */
+uint16_t adc_scan_latest_get(uint8_t rank);
+/* get the rounded mean of a rank over the frames of a half buffer */
+uint16_t adc_scan_mean(const uint16_t *data, uint32_t frame_number, uint8_t rank);
+/* handle the half and full transfer interrupt of the DMA channel */
+void adc_scan_dma_irq_handler(void);
+
+#endif /* ADC_SCAN_H */
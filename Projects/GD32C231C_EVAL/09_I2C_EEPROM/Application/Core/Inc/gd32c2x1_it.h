@@ -48,5 +48,11 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 /* this function handles SysTick exception */
 void SysTick_Handler(void);
+/* this function handles I2C1_EV_IRQHandler interrupt */
+void I2C1_EV_IRQHandler(void);
+/* this function handles I2C1_ER_IRQHandler interrupt */
+void I2C1_ER_IRQHandler(void);
+/* this function handles DMA_Channel2_IRQHandler interrupt */
+void DMA_Channel2_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
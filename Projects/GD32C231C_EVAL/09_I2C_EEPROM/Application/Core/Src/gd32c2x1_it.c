@@ -33,7 +33,10 @@ OF SUCH DAMAGE.
 */
 
 #include "gd32c2x1_it.h"
+#include "gd32c231c_eval.h"
 #include "systick.h"
+#include "at24cxx.h"
+#include "i2c_engine.h"
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -105,4 +108,39 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
     delay_decrement();
+    i2c_engine_tick();
+    eeprom_cache_tick();
+}
+
+/*!
+    \brief      this function handles I2C1_EV_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void I2C1_EV_IRQHandler(void)
+{
+    i2c_engine_ev_irq_handler();
+}
+
+/*!
+    \brief      this function handles I2C1_ER_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void I2C1_ER_IRQHandler(void)
+{
+    i2c_engine_er_irq_handler();
+}
+
+/*!
+    \brief      this function handles DMA_Channel2_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel2_IRQHandler(void)
+{
+    gd_eval_com_tx_dma_irq_handler();
 }
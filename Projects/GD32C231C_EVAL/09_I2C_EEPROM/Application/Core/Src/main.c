@@ -35,7 +35,7 @@ OF SUCH DAMAGE.
 #include <stdio.h>
 #include "gd32c231c_eval.h"
 #include "systick.h"
-#include "i2c.h"
+#include "i2c_engine.h"
 #include "at24cxx.h"
 
 uint8_t count = 0;
@@ -59,6 +59,8 @@ int main(void)
 
     /* configure USART */
     gd_eval_com_init(EVAL_COM);
+    /* printf returns once the text is in the COM ring buffer */
+    gd_eval_com_tx_dma_init(EVAL_COM);
 
     printf("I2C-24C02 configured....\n\r");
 
@@ -67,6 +69,8 @@ int main(void)
 
     /* configure I2C */
     i2c_config();
+    /* the EEPROM transfers run on the interrupt driven I2C engine */
+    i2c_engine_init();
 
     /* initialize EEPROM */
     i2c_eeprom_init();
@@ -85,6 +89,8 @@ int main(void)
             if(count >= 2) {
                 count = 0;
             }
+            /* write the dirty cached pages when the cache is idle */
+            eeprom_cache_poll();
             delay_ms(500);
         }
     }
@@ -33,15 +33,37 @@ OF SUCH DAMAGE.
 */
 
 #include "at24cxx.h"
-#include "i2c.h"
+#include "i2c_engine.h"
 #include <stdio.h>
+#include <string.h>
 
 #define EEPROM_BLOCK0_ADDRESS    0xA0
 #define BUFFER_SIZE              256
-#define MAX_RELOAD_SIZE          255
+
+/* cached EEPROM page, bit n of the masks stands for byte n of the page */
+typedef struct {
+    uint8_t page;                       /* EEPROM's internal address of the page */
+    uint8_t valid;                      /* bytes holding the EEPROM content or a cached write */
+    uint8_t dirty;                      /* bytes to be written to the EEPROM */
+    uint16_t stamp;                     /* last use, the oldest line is replaced */
+    uint8_t data[I2C_PAGE_SIZE];
+} eeprom_cache_line_struct;
 
 uint16_t eeprom_address;
 
+/* SET while the EEPROM may be busy with the write cycle of the last page write */
+static uint8_t eeprom_write_cycle = 0;
+
+static eeprom_cache_line_struct eeprom_cache[EEPROM_CACHE_LINE_NUM];
+static uint16_t eeprom_cache_clock = 0;
+static __IO uint16_t eeprom_cache_timer = 0;
+
+static eeprom_cache_line_struct *eeprom_cache_line_get(uint8_t page);
+static void eeprom_cache_line_flush(eeprom_cache_line_struct *line);
+static void eeprom_cache_update(uint8_t *p_buffer, uint8_t write_address, uint16_t number_of_byte);
+static i2c_transaction_status_enum eeprom_transfer(uint8_t address, uint8_t *p_write, uint16_t write_number,
+                                                   uint8_t *p_read, uint16_t read_number);
+
 /*!
     \brief      I2C read and write functions
     \param[in]  none
@@ -82,6 +104,23 @@ uint8_t i2c_24c02_test(void)
         }
     }
     printf("I2C-AT24C02 test passed!\n\r");
+
+    /* byte writes through the cache are merged into two page writes */
+    printf("\r\nAT24C02 cached writing...\r\n");
+    for(i = 0; i < 2 * I2C_PAGE_SIZE; i++) {
+        i2c_buffer_write[i] = (uint8_t)(0xFF - i);
+        eeprom_cache_write(&i2c_buffer_write[i], EEP_FIRST_PAGE + i, 1);
+    }
+    eeprom_cache_flush();
+    /* read the EEPROM itself and not the cache */
+    eeprom_buffer_read(i2c_buffer_read, EEP_FIRST_PAGE, 2 * I2C_PAGE_SIZE);
+    for(i = 0; i < 2 * I2C_PAGE_SIZE; i++) {
+        if(i2c_buffer_read[i] != i2c_buffer_write[i]) {
+            printf("Err:cached data read and write aren't matching.\n\r");
+            return I2C_FAIL;
+        }
+    }
+    printf("I2C-AT24C02 cache test passed!\n\r");
     return I2C_OK;
 }
 
@@ -108,6 +147,9 @@ void eeprom_buffer_write(uint8_t *p_buffer, uint8_t write_address, uint16_t numb
 {
     uint8_t number_of_page = 0, number_of_single = 0, address = 0, count = 0;
 
+    /* the cached copy of the written bytes is no longer dirty */
+    eeprom_cache_update(p_buffer, write_address, number_of_byte);
+
     address = write_address % I2C_PAGE_SIZE;
     count = I2C_PAGE_SIZE - address;
     number_of_page =  number_of_byte / I2C_PAGE_SIZE;
@@ -117,40 +159,34 @@ void eeprom_buffer_write(uint8_t *p_buffer, uint8_t write_address, uint16_t numb
     if(0 == address) {
         while(number_of_page--) {
             eeprom_page_write(p_buffer, write_address, I2C_PAGE_SIZE);
-            delay_ms(5);
             write_address +=  I2C_PAGE_SIZE;
             p_buffer += I2C_PAGE_SIZE;
         }
         if(0 != number_of_single) {
             eeprom_page_write(p_buffer, write_address, number_of_single);
-            delay_ms(5);
         }
     } else {
         /* if write_address is not I2C_PAGE_SIZE aligned */
         if(number_of_byte < count) {
             eeprom_page_write(p_buffer, write_address, number_of_byte);
-            delay_ms(5);
         } else {
             number_of_byte -= count;
             number_of_page =  number_of_byte / I2C_PAGE_SIZE;
             number_of_single = number_of_byte % I2C_PAGE_SIZE;
             if(0 != count) {
                 eeprom_page_write(p_buffer, write_address, count);
-                delay_ms(5);
                 write_address += count;
                 p_buffer += count;
             }
             /* write page */
             while(number_of_page--) {
                 eeprom_page_write(p_buffer, write_address, I2C_PAGE_SIZE);
-                delay_ms(5);
                 write_address +=  I2C_PAGE_SIZE;
                 p_buffer += I2C_PAGE_SIZE;
             }
             /* write single */
             if(0 != number_of_single) {
                 eeprom_page_write(p_buffer, write_address, number_of_single);
-                delay_ms(5);
             }
         }
     }
@@ -166,102 +202,15 @@ void eeprom_buffer_write(uint8_t *p_buffer, uint8_t write_address, uint16_t numb
 */
 void eeprom_page_write(uint8_t *p_buffer, uint8_t write_address, uint8_t number_of_byte)
 {
-    i2c_process_enum state = I2C_START;
-    uint16_t timeout = 0;
-    uint8_t end_flag = 0;
-
-    while(!end_flag) {
-        switch(state) {
-        case I2C_START:
-            /* configure slave address */
-            i2c_master_addressing(I2CX, eeprom_address, I2C_MASTER_TRANSMIT);
-            /* configure number of bytes to be transferred */
-            i2c_transfer_byte_number_config(I2CX, number_of_byte + 1);
-            /* clear I2C_TDATA register */
-            I2C_STAT(I2CX) |= I2C_STAT_TBE;
-            /* enable I2C automatic end mode in master mode */
-            i2c_automatic_end_enable(I2CX);
-            /* i2c master sends start signal only when the bus is idle */
-            while(i2c_flag_get(I2CX, I2C_FLAG_I2CBSY) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
-            }
-            if(timeout < I2C_TIME_OUT) {
-                i2c_start_on_bus(I2CX);
-                timeout = 0;
-                state = I2C_SEND_ADDRESS;
-            } else {
-                /* timeout, bus reset */
-                i2c_bus_reset();
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c bus is busy in page write!\n");
-            }
-            break;
-        case I2C_SEND_ADDRESS:
-            /* wait until the transmit data buffer is empty */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_TBE)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
-            }
-            if(timeout < I2C_TIME_OUT) {
-                /* send the EEPROM's internal address to write to : only one byte address */
-                i2c_data_transmit(I2CX, write_address);
-                timeout = 0;
-                state = I2C_TRANSMIT_DATA;
-            } else {
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master sends address timeout in page write!\n");
-            }
-            break;
-        case I2C_TRANSMIT_DATA:
-            while(number_of_byte--) {
-                /* wait until TI bit is set */
-                while((!i2c_flag_get(I2CX, I2C_FLAG_TI)) && (timeout < I2C_TIME_OUT)) {
-                    timeout++;
-                }
-                if(timeout < I2C_TIME_OUT) {
-                    /* while there is data to be written */
-                    i2c_data_transmit(I2CX, *p_buffer);
-                    /* point to the next byte to be written */
-                    p_buffer++;
-                    timeout = 0;
-                    state = I2C_STOP;
-                } else {
-                    /* wait TI timeout */
-                    timeout = 0;
-                    state = I2C_START;
-                    printf("i2c master sends data timeout in page write!\n");
-                    return ;
-                }
-            }
-            break;
-        case I2C_STOP:
-            /* wait until the stop condition is finished */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_STPDET)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
-            }
-            if(timeout < I2C_TIME_OUT) {
-                /* clear STPDET flag */
-                i2c_flag_clear(I2CX, I2C_FLAG_STPDET);
-                timeout = 0;
-                state = I2C_END;
-                end_flag = 1;
-            } else {
-                /* stop detect timeout */
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master sends stop signal timeout in page write!\n");
-            }
-            break;
-        default:
-            /* default status */
-            state = I2C_START;
-            end_flag = 1;
-            timeout = 0;
-            printf("i2c master sends start signal in page write!\n");
-            break;
-        }
+    /* the previous page must be programmed before the EEPROM accepts a new one */
+    eeprom_wait_standby_state();
+
+    if(I2C_TRANSACTION_DONE != eeprom_transfer(write_address, p_buffer, number_of_byte, NULL, 0)) {
+        printf("i2c master page write failed!\n");
+        return;
     }
+    /* the EEPROM starts its write cycle at the stop condition */
+    eeprom_write_cycle = 1;
 }
 
 /*!
@@ -274,175 +223,301 @@ void eeprom_page_write(uint8_t *p_buffer, uint8_t write_address, uint8_t number_
 */
 void eeprom_buffer_read(uint8_t *p_buffer, uint8_t read_address, uint16_t number_of_byte)
 {
-    uint32_t nbytes_reload = 0;
-    i2c_process_enum state = I2C_START;
-    uint32_t timeout = 0;
-    uint8_t end_flag = 0;
-    uint8_t restart_flag = 0;
-    uint8_t first_reload_flag = 1;
-
-    while(!end_flag) {
-        switch(state) {
-        case I2C_START:
-            if(0 == restart_flag) {
-                /* clear I2C_TDATA register */
-                I2C_STAT(I2CX) |= I2C_STAT_TBE;
-                /* configure slave address */
-                i2c_master_addressing(I2CX, eeprom_address, I2C_MASTER_TRANSMIT);
-                /* configure number of bytes to be transferred */
-                i2c_transfer_byte_number_config(I2CX, 1);
-                /* disable I2C automatic end mode in master mode */
-                i2c_automatic_end_disable(I2CX);
-                /* i2c master sends start signal only when the bus is idle */
-                while(i2c_flag_get(I2CX, I2C_FLAG_I2CBSY) && (timeout < I2C_TIME_OUT)) {
-                    timeout++;
-                }
-                if(timeout < I2C_TIME_OUT) {
-                    i2c_start_on_bus(I2CX);
-                    timeout = 0;
-                    state = I2C_SEND_ADDRESS;
-                } else {
-                    /* timeout, bus reset */
-                    i2c_bus_reset();
-                    timeout = 0;
-                    state = I2C_START;
-                    printf("i2c bus is busy in read!\n");
-                }
-            } else {
-                /* restart */
-                i2c_start_on_bus(I2CX);
-                restart_flag = 0;
-                state = I2C_TRANSMIT_DATA;
-            }
-            break;
-        case I2C_SEND_ADDRESS:
-            /* wait until the transmit data buffer is empty */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_TBE)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
-            }
-            if(timeout < I2C_TIME_OUT) {
-                /* send the EEPROM's internal address to write to : only one byte address */
-                i2c_data_transmit(I2CX, read_address);
-                timeout = 0;
-                state = I2C_RESTART;
-            } else {
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master sends data timeout in read!\n");
-            }
-            break;
-        case I2C_RESTART:
-            /* wait until the transmit data buffer is empty */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_TC)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
-            }
-            if(timeout < I2C_TIME_OUT) {
-                /* configure the EEPROM's internal address to write to : only one byte address */
-                i2c_master_addressing(I2CX, eeprom_address, I2C_MASTER_RECEIVE);
-                /* enable I2C reload mode */
-                i2c_reload_enable(I2CX);
-                /* configure number of bytes to be transferred */
-                timeout = 0;
-                state = I2C_RELOAD;
-                restart_flag = 1;
-            } else {
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master sends EEPROM's internal address timeout in read!\n");
-            }
-            break;
-        case I2C_RELOAD:
-            if(number_of_byte > MAX_RELOAD_SIZE) {
-                number_of_byte = number_of_byte - MAX_RELOAD_SIZE;
-                nbytes_reload = MAX_RELOAD_SIZE;
-            } else {
-                nbytes_reload = number_of_byte;
-            }
-            if(1 == first_reload_flag) {
-                /* configure number of bytes to be transferred */
-                i2c_transfer_byte_number_config(I2CX, nbytes_reload);
-                first_reload_flag = 0;
-                state = I2C_START;
-            } else {
-                /* wait for TCR flag */
-                while((!i2c_flag_get(I2CX, I2C_FLAG_TCR)) && (timeout < I2C_TIME_OUT)) {
-                    timeout++;
-                }
-                if(timeout < I2C_TIME_OUT) {
-                    /* configure number of bytes to be transferred */
-                    i2c_transfer_byte_number_config(I2CX, nbytes_reload);
-                    /* disable I2C reload mode */
-                    if(number_of_byte <= MAX_RELOAD_SIZE) {
-                        i2c_reload_disable(I2CX);
-                        /* enable I2C automatic end mode in master mode */
-                        i2c_automatic_end_enable(I2CX);
-                    }
-                    timeout = 0;
-                    state = I2C_TRANSMIT_DATA;
-                } else {
-                    timeout = 0;
-                    state = I2C_START;
-                    printf("i2c master reload data timeout in read!\n");
-                }
-            }
-            break;
-        case I2C_TRANSMIT_DATA:
-            /* wait until TI bit is set */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_TBE)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
+    /* the EEPROM doesn't answer during its write cycle */
+    eeprom_wait_standby_state();
+
+    if(I2C_TRANSACTION_DONE != eeprom_transfer(read_address, NULL, 0, p_buffer, number_of_byte)) {
+        printf("i2c master read failed!\n");
+    }
+}
+
+/*!
+    \brief      wait for the EEPROM to finish its write cycle by polling its device address,
+                the EEPROM doesn't acknowledge its address until the write cycle is over
+    \param[in]  none
+    \param[out] none
+    \retval     I2C_OK or I2C_FAIL
+*/
+uint8_t eeprom_wait_standby_state(void)
+{
+    i2c_transaction_struct transaction;
+    i2c_transaction_status_enum status;
+    uint16_t trials;
+
+    if(0 == eeprom_write_cycle) {
+        return I2C_OK;
+    }
+
+    memset(&transaction, 0, sizeof(transaction));
+    transaction.address = eeprom_address;
+    transaction.timeout = I2C_TIME_OUT;
+
+    for(trials = 0; trials < EEPROM_STANDBY_TRIALS; trials++) {
+        /* address only transaction, the stop follows the address byte */
+        i2c_engine_submit(&transaction);
+        status = i2c_engine_wait(&transaction);
+        if(I2C_TRANSACTION_DONE == status) {
+            eeprom_write_cycle = 0;
+            return I2C_OK;
+        }
+        if(I2C_TRANSACTION_NACK != status) {
+            printf("i2c bus error in standby polling!\n");
+            return I2C_FAIL;
+        }
+    }
+
+    printf("i2c EEPROM write cycle timeout!\n");
+    return I2C_FAIL;
+}
+
+/*!
+    \brief      write data to the EEPROM through the write-back cache, the writes to a
+                page are merged and sent by one page write when the page is flushed
+    \param[in]  p_buffer: pointer to the buffer containing the data to be written to the EEPROM
+    \param[in]  write_address: EEPROM's internal address to write to
+    \param[in]  number_of_byte: number of bytes to write to the EEPROM
+    \param[out] none
+    \retval     none
+*/
+void eeprom_cache_write(uint8_t *p_buffer, uint8_t write_address, uint16_t number_of_byte)
+{
+    eeprom_cache_line_struct *line;
+    uint16_t address = write_address;
+    uint8_t offset, count, mask;
+
+    while(number_of_byte) {
+        offset = address % I2C_PAGE_SIZE;
+        count = I2C_PAGE_SIZE - offset;
+        if(count > number_of_byte) {
+            count = number_of_byte;
+        }
+
+        line = eeprom_cache_line_get((uint8_t)(address - offset));
+        memcpy(&line->data[offset], p_buffer, count);
+        mask = (uint8_t)(((1U << count) - 1U) << offset);
+        line->valid |= mask;
+        line->dirty |= mask;
+
+        p_buffer += count;
+        address += count;
+        number_of_byte -= count;
+    }
+
+    /* restart the flush timer */
+    eeprom_cache_timer = EEPROM_CACHE_FLUSH_MS;
+}
+
+/*!
+    \brief      read data from the EEPROM through the write-back cache, the bytes
+                which are cached are not read from the EEPROM
+    \param[in]  p_buffer: pointer to the buffer that receives the data read from the EEPROM
+    \param[in]  read_address: EEPROM's internal address to start reading from
+    \param[in]  number_of_byte: number of bytes to reads from the EEPROM
+    \param[out] none
+    \retval     none
+*/
+void eeprom_cache_read(uint8_t *p_buffer, uint8_t read_address, uint16_t number_of_byte)
+{
+    uint16_t i, address;
+    uint8_t line, hit, missed = 0;
+
+    for(i = 0; (i < number_of_byte) && (0 == missed); i++) {
+        address = read_address + i;
+        missed = 1;
+        for(line = 0; line < EEPROM_CACHE_LINE_NUM; line++) {
+            if((eeprom_cache[line].page == (uint8_t)(address - (address % I2C_PAGE_SIZE))) &&
+                    (eeprom_cache[line].valid & (1U << (address % I2C_PAGE_SIZE)))) {
+                missed = 0;
+                break;
             }
-            if(timeout < I2C_TIME_OUT) {
-                while(nbytes_reload) {
-                    /* wait until the RBNE bit is set and clear it */
-                    if(i2c_flag_get(I2CX, I2C_FLAG_RBNE)) {
-                        /* read a byte from the EEPROM */
-                        *p_buffer = i2c_data_receive(I2CX);
-                        /* point to the next location where the byte read will be saved */
-                        p_buffer++;
-                        /* decrement the read bytes counter */
-                        nbytes_reload--;
-                    }
-                }
-                timeout = 0;
-                /* check if the reload mode is enabled or not */
-                if(I2C_CTL1(I2CX) & I2C_CTL1_RELOAD) {
-                    timeout = 0;
-                    state = I2C_RELOAD;
-                } else {
-                    timeout = 0;
-                    state = I2C_STOP;
-                }
-            } else {
-                /* wait TI timeout */
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master read data timeout in read!\n");
+        }
+    }
+
+    if(0 != missed) {
+        eeprom_buffer_read(p_buffer, read_address, number_of_byte);
+    }
+
+    /* the cached bytes are newer than the EEPROM content */
+    for(i = 0; i < number_of_byte; i++) {
+        address = read_address + i;
+        hit = (uint8_t)(1U << (address % I2C_PAGE_SIZE));
+        for(line = 0; line < EEPROM_CACHE_LINE_NUM; line++) {
+            if((eeprom_cache[line].page == (uint8_t)(address - (address % I2C_PAGE_SIZE))) &&
+                    (eeprom_cache[line].valid & hit)) {
+                p_buffer[i] = eeprom_cache[line].data[address % I2C_PAGE_SIZE];
+                break;
             }
-            break;
-        case I2C_STOP:
-            /* wait until the stop condition is finished */
-            while((!i2c_flag_get(I2CX, I2C_FLAG_STPDET)) && (timeout < I2C_TIME_OUT)) {
-                timeout++;
+        }
+    }
+}
+
+/*!
+    \brief      write the dirty pages of the cache to the EEPROM
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void eeprom_cache_flush(void)
+{
+    uint8_t line;
+
+    for(line = 0; line < EEPROM_CACHE_LINE_NUM; line++) {
+        eeprom_cache_line_flush(&eeprom_cache[line]);
+    }
+}
+
+/*!
+    \brief      count down the cache flush timer, call it every millisecond
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void eeprom_cache_tick(void)
+{
+    if(0U != eeprom_cache_timer) {
+        eeprom_cache_timer--;
+    }
+}
+
+/*!
+    \brief      write the dirty pages once the cache flush timer expires, call it from the main loop
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void eeprom_cache_poll(void)
+{
+    if(0U == eeprom_cache_timer) {
+        eeprom_cache_flush();
+    }
+}
+
+/*!
+    \brief      get the cache line of a page, the oldest line is flushed and replaced on a miss
+    \param[in]  page: EEPROM's internal address of the page
+    \param[out] none
+    \retval     cache line of the page
+*/
+static eeprom_cache_line_struct *eeprom_cache_line_get(uint8_t page)
+{
+    eeprom_cache_line_struct *line, *victim = &eeprom_cache[0];
+    uint8_t i;
+
+    eeprom_cache_clock++;
+
+    for(i = 0; i < EEPROM_CACHE_LINE_NUM; i++) {
+        line = &eeprom_cache[i];
+        if((page == line->page) && (0 != line->valid)) {
+            line->stamp = eeprom_cache_clock;
+            return line;
+        }
+        /* an empty line is taken first, then the oldest one */
+        if((0 != victim->valid) &&
+                ((0 == line->valid) || ((uint16_t)(eeprom_cache_clock - line->stamp) > (uint16_t)(eeprom_cache_clock - victim->stamp)))) {
+            victim = line;
+        }
+    }
+
+    eeprom_cache_line_flush(victim);
+    victim->page = page;
+    victim->valid = 0;
+    victim->stamp = eeprom_cache_clock;
+
+    return victim;
+}
+
+/*!
+    \brief      write the dirty bytes of a cache line by one page write
+    \param[in]  line: cache line
+    \param[out] none
+    \retval     none
+*/
+static void eeprom_cache_line_flush(eeprom_cache_line_struct *line)
+{
+    uint8_t buffer[I2C_PAGE_SIZE];
+    uint8_t first = 0, last = I2C_PAGE_SIZE - 1, span, i;
+
+    if(0 == line->dirty) {
+        return;
+    }
+
+    while(0 == (line->dirty & (1U << first))) {
+        first++;
+    }
+    while(0 == (line->dirty & (1U << last))) {
+        last--;
+    }
+    span = (uint8_t)(((1U << (last - first + 1)) - 1U) << first);
+
+    /* the clean bytes between the dirty ones are written back unchanged */
+    if(span != (line->valid & span)) {
+        eeprom_buffer_read(&buffer[first], line->page + first, last - first + 1);
+        for(i = first; i <= last; i++) {
+            if(0 == (line->valid & (1U << i))) {
+                line->data[i] = buffer[i];
             }
-            if(timeout < I2C_TIME_OUT) {
-                /* clear STPDET flag */
-                i2c_flag_clear(I2CX, I2C_FLAG_STPDET);
-                timeout = 0;
-                state = I2C_END;
-                end_flag = 1;
-            } else {
-                timeout = 0;
-                state = I2C_START;
-                printf("i2c master sends stop signal timeout in read!\n");
+        }
+        line->valid |= span;
+    }
+
+    eeprom_page_write(&line->data[first], line->page + first, last - first + 1);
+    line->dirty = 0;
+}
+
+/*!
+    \brief      copy the data written around the cache into the cached pages
+    \param[in]  p_buffer: pointer to the data written to the EEPROM
+    \param[in]  write_address: EEPROM's internal address written to
+    \param[in]  number_of_byte: number of bytes written
+    \param[out] none
+    \retval     none
+*/
+static void eeprom_cache_update(uint8_t *p_buffer, uint8_t write_address, uint16_t number_of_byte)
+{
+    uint16_t i, address;
+    uint8_t line, bit;
+
+    for(i = 0; i < number_of_byte; i++) {
+        address = write_address + i;
+        bit = (uint8_t)(1U << (address % I2C_PAGE_SIZE));
+        for(line = 0; line < EEPROM_CACHE_LINE_NUM; line++) {
+            if((0 != eeprom_cache[line].valid) &&
+                    (eeprom_cache[line].page == (uint8_t)(address - (address % I2C_PAGE_SIZE)))) {
+                eeprom_cache[line].data[address % I2C_PAGE_SIZE] = p_buffer[i];
+                eeprom_cache[line].valid |= bit;
+                eeprom_cache[line].dirty &= (uint8_t)~bit;
             }
-            break;
-        default:
-            /* default status */
-            state = I2C_START;
-            end_flag = 1;
-            timeout = 0;
-            printf("i2c master sends start signal in read!\n");
-            break;
         }
     }
 }
+
+/*!
+    \brief      run one EEPROM transaction on the I2C engine and wait for it
+    \param[in]  address: EEPROM's internal address sent first
+    \param[in]  p_write: data written after the internal address
+    \param[in]  write_number: number of bytes to write
+    \param[in]  p_read: buffer receiving the data read after the restart
+    \param[in]  read_number: number of bytes to read
+    \param[out] none
+    \retval     status of the transaction
+*/
+static i2c_transaction_status_enum eeprom_transfer(uint8_t address, uint8_t *p_write, uint16_t write_number,
+                                                   uint8_t *p_read, uint16_t read_number)
+{
+    i2c_transaction_struct transaction;
+
+    transaction.address = eeprom_address;
+    transaction.reg[0] = address;
+    transaction.reg_number = 1;
+    transaction.write_buffer = p_write;
+    transaction.write_number = write_number;
+    transaction.read_buffer = p_read;
+    transaction.read_number = read_number;
+    transaction.timeout = I2C_TIME_OUT;
+    transaction.callback = NULL;
+
+    if(ERROR == i2c_engine_submit(&transaction)) {
+        return I2C_TRANSACTION_ERROR;
+    }
+    return i2c_engine_wait(&transaction);
+}
@@ -37,21 +37,19 @@ OF SUCH DAMAGE.
 
 #include "gd32c2x1_it.h"
 
-typedef enum {
-    I2C_START = 0,
-    I2C_SEND_ADDRESS,
-    I2C_RESTART,
-    I2C_TRANSMIT_DATA,
-    I2C_RELOAD,
-    I2C_STOP,
-    I2C_END
-} i2c_process_enum;
-
-#define I2C_TIME_OUT   (uint32_t)(20000)
+/* timeout of one I2C transaction in milliseconds */
+#define I2C_TIME_OUT   20
 #define EEP_FIRST_PAGE 0x00
 #define I2C_OK         0
 #define I2C_FAIL       1
 
+/* device address polls allowed for one write cycle */
+#define EEPROM_STANDBY_TRIALS    1000
+/* number of pages held by the write-back cache */
+#define EEPROM_CACHE_LINE_NUM    4
+/* the dirty pages are written after this many milliseconds without a cached write */
+#define EEPROM_CACHE_FLUSH_MS    100
+
 /* function declarations */
 /* I2C read and write functions */
 uint8_t i2c_24c02_test(void);
@@ -63,5 +61,17 @@ void eeprom_buffer_write(uint8_t *p_buffer, uint8_t write_address, uint16_t numb
 void eeprom_page_write(uint8_t *p_buffer, uint8_t write_address, uint8_t number_of_byte);
 /* read data from the EEPROM */
 void eeprom_buffer_read(uint8_t *p_buffer, uint8_t read_address, uint16_t number_of_byte);
+/* wait for the EEPROM to finish its write cycle */
+uint8_t eeprom_wait_standby_state(void);
+/* write data to the EEPROM through the write-back cache */
+void eeprom_cache_write(uint8_t *p_buffer, uint8_t write_address, uint16_t number_of_byte);
+/* read data from the EEPROM through the write-back cache */
+void eeprom_cache_read(uint8_t *p_buffer, uint8_t read_address, uint16_t number_of_byte);
+/* write the dirty pages of the cache to the EEPROM */
+void eeprom_cache_flush(void);
+/* count down the cache flush timer, call it every millisecond */
+void eeprom_cache_tick(void);
+/* write the dirty pages once the cache flush timer expires */
+void eeprom_cache_poll(void);
 
 #endif /* AT24CXX_H */
@@ -0,0 +1,449 @@
+/*!
+    \file    i2c_engine.c
+    \brief   interrupt driven I2C transaction engine
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "i2c_engine.h"
+#include <stddef.h>
+
+#define I2C_ENGINE_PHASE_WRITE      0U
+#define I2C_ENGINE_PHASE_READ       1U
+/* largest number of bytes of one NBYTES load */
+#define I2C_ENGINE_RELOAD_SIZE      255U
+
+#define I2C_ENGINE_INT              (I2C_INT_ERR | I2C_INT_TC | I2C_INT_STPDET | I2C_INT_NACK)
+#define I2C_ENGINE_ERR_FLAG         (I2C_STAT_BERR | I2C_STAT_LOSTARB | I2C_STAT_OUERR)
+
+static i2c_transaction_struct *i2c_engine_active = NULL;
+static i2c_transaction_struct *i2c_engine_head = NULL;
+static i2c_transaction_struct *i2c_engine_tail = NULL;
+
+static uint8_t i2c_engine_phase;                        /* phase of the active transaction */
+static uint16_t i2c_engine_total;                       /* bytes of the phase */
+static uint16_t i2c_engine_index;                       /* bytes of the phase moved by interrupts */
+static uint16_t i2c_engine_remain;                      /* bytes of the phase not loaded in NBYTES yet */
+static uint8_t i2c_engine_dma;                          /* the data of the phase is moved by DMA */
+static i2c_transaction_status_enum i2c_engine_result;   /* result reported at the stop */
+
+static __IO uint32_t i2c_engine_time = 0U;              /* milliseconds */
+static uint32_t i2c_engine_start_time;
+
+static void i2c_engine_start(i2c_transaction_struct *transaction);
+static void i2c_engine_phase_start(uint8_t phase);
+static void i2c_engine_data_stop(void);
+static void i2c_engine_finish(i2c_transaction_status_enum status);
+#ifdef I2C_ENGINE_DMA
+static void i2c_engine_dma_config(void);
+#endif /* I2C_ENGINE_DMA */
+
+/*!
+    \brief      initialize the I2C transaction engine, the I2C must be configured
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void i2c_engine_init(void)
+{
+#ifdef I2C_ENGINE_DMA
+    i2c_engine_dma_config();
+#endif /* I2C_ENGINE_DMA */
+
+    nvic_irq_enable(I2C_ENGINE_EV_IRQn, 0);
+    nvic_irq_enable(I2C_ENGINE_ER_IRQn, 0);
+}
+
+/*!
+    \brief      queue a transaction, it is started at once if the bus is free
+    \param[in]  transaction: transaction descriptor, must stay valid until it is completed
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the descriptor is invalid
+*/
+ErrStatus i2c_engine_submit(i2c_transaction_struct *transaction)
+{
+    uint32_t primask;
+
+    if((NULL == transaction) || (I2C_ENGINE_REG_SIZE < transaction->reg_number)) {
+        return ERROR;
+    }
+
+    transaction->status = I2C_TRANSACTION_QUEUED;
+    transaction->next = NULL;
+
+    primask = __get_PRIMASK();
+    __disable_irq();
+    if(NULL == i2c_engine_active) {
+        i2c_engine_start(transaction);
+    } else {
+        if(NULL == i2c_engine_tail) {
+            i2c_engine_head = transaction;
+        } else {
+            i2c_engine_tail->next = transaction;
+        }
+        i2c_engine_tail = transaction;
+    }
+    __set_PRIMASK(primask);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      wait for a transaction to complete, not to be called from the engine callbacks
+    \param[in]  transaction: submitted transaction descriptor
+    \param[out] none
+    \retval     status of the transaction
+*/
+i2c_transaction_status_enum i2c_engine_wait(i2c_transaction_struct *transaction)
+{
+    while((I2C_TRANSACTION_QUEUED == transaction->status) || (I2C_TRANSACTION_BUSY == transaction->status)) {
+    }
+
+    return transaction->status;
+}
+
+/*!
+    \brief      I2C event interrupt service, call it from the I2C event IRQ handler
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void i2c_engine_ev_irq_handler(void)
+{
+    i2c_transaction_struct *transaction = i2c_engine_active;
+    uint32_t stat = I2C_STAT(I2CX);
+    uint16_t chunk;
+
+    if(NULL == transaction) {
+        i2c_interrupt_disable(I2CX, I2C_ENGINE_INT | I2C_INT_TI | I2C_INT_RBNE);
+        return;
+    }
+
+    if(RESET != (stat & I2C_STAT_NACK)) {
+        i2c_flag_clear(I2CX, I2C_FLAG_NACK);
+        i2c_engine_result = I2C_TRANSACTION_NACK;
+        i2c_engine_data_stop();
+        /* the hardware only sends the stop by itself in automatic end mode */
+        if(RESET == (I2C_CTL1(I2CX) & I2C_CTL1_AUTOEND)) {
+            i2c_stop_on_bus(I2CX);
+        }
+    } else if((RESET != (stat & I2C_STAT_TI)) && (RESET != (I2C_CTL0(I2CX) & I2C_CTL0_TIE))) {
+        /* the register address goes first, then the write data */
+        if(i2c_engine_index < transaction->reg_number) {
+            i2c_data_transmit(I2CX, transaction->reg[i2c_engine_index]);
+        } else {
+            i2c_data_transmit(I2CX, transaction->write_buffer[i2c_engine_index - transaction->reg_number]);
+        }
+        i2c_engine_index++;
+
+#ifdef I2C_ENGINE_DMA
+        if((0U != i2c_engine_dma) && (i2c_engine_index == transaction->reg_number)) {
+            /* the DMA takes over after the register address */
+            i2c_interrupt_disable(I2CX, I2C_INT_TI);
+            dma_channel_enable(I2C_ENGINE_DMA_TX_CHANNEL);
+            i2c_dma_enable(I2CX, I2C_DMA_TRANSMIT);
+        }
+#endif /* I2C_ENGINE_DMA */
+        if(i2c_engine_index == i2c_engine_total) {
+            i2c_interrupt_disable(I2CX, I2C_INT_TI);
+        }
+    } else if((RESET != (stat & I2C_STAT_RBNE)) && (RESET != (I2C_CTL0(I2CX) & I2C_CTL0_RBNEIE))) {
+        transaction->read_buffer[i2c_engine_index] = i2c_data_receive(I2CX);
+        i2c_engine_index++;
+    } else if(RESET != (stat & I2C_STAT_TCR)) {
+        /* load the next part of the phase, this releases the bus */
+        chunk = (i2c_engine_remain > I2C_ENGINE_RELOAD_SIZE) ? I2C_ENGINE_RELOAD_SIZE : i2c_engine_remain;
+        i2c_engine_remain -= chunk;
+        if(0U == i2c_engine_remain) {
+            i2c_reload_disable(I2CX);
+            if((I2C_ENGINE_PHASE_READ == i2c_engine_phase) || (0U == transaction->read_number)) {
+                i2c_automatic_end_enable(I2CX);
+            }
+        }
+        i2c_transfer_byte_number_config(I2CX, (uint8_t)chunk);
+    } else if(RESET != (stat & I2C_STAT_TC)) {
+        if((I2C_ENGINE_PHASE_WRITE == i2c_engine_phase) && (0U != transaction->read_number)) {
+            /* restart for the read phase */
+            i2c_engine_data_stop();
+            i2c_engine_phase_start(I2C_ENGINE_PHASE_READ);
+        } else {
+            i2c_stop_on_bus(I2CX);
+        }
+    }
+
+    if(RESET != (stat & I2C_STAT_STPDET)) {
+        i2c_flag_clear(I2CX, I2C_FLAG_STPDET);
+        i2c_engine_finish(i2c_engine_result);
+    }
+}
+
+/*!
+    \brief      I2C error interrupt service, call it from the I2C error IRQ handler
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void i2c_engine_er_irq_handler(void)
+{
+    i2c_flag_clear(I2CX, I2C_FLAG_BERR | I2C_FLAG_LOSTARB | I2C_FLAG_OUERR);
+
+    if(NULL != i2c_engine_active) {
+        /* the peripheral is reset, no stop follows an arbitration loss */
+        i2c_disable(I2CX);
+        i2c_enable(I2CX);
+        i2c_engine_finish(I2C_TRANSACTION_ERROR);
+    }
+}
+
+/*!
+    \brief      check the timeout of the active transaction, call it every millisecond
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void i2c_engine_tick(void)
+{
+    i2c_transaction_struct *transaction = i2c_engine_active;
+    uint32_t timeout;
+
+    i2c_engine_time++;
+
+    if(NULL == transaction) {
+        return;
+    }
+
+    timeout = (0U != transaction->timeout) ? transaction->timeout : I2C_ENGINE_TIMEOUT_MS;
+    /* the first tick may come at once, one more tick gives the full timeout */
+    if((i2c_engine_time - i2c_engine_start_time) > timeout) {
+        i2c_disable(I2CX);
+        i2c_bus_reset();
+        i2c_enable(I2CX);
+        i2c_engine_finish(I2C_TRANSACTION_TIMEOUT);
+    }
+}
+
+/*!
+    \brief      put a transaction on the bus
+    \param[in]  transaction: transaction descriptor
+    \param[out] none
+    \retval     none
+*/
+static void i2c_engine_start(i2c_transaction_struct *transaction)
+{
+    i2c_engine_active = transaction;
+    i2c_engine_result = I2C_TRANSACTION_DONE;
+    i2c_engine_start_time = i2c_engine_time;
+    transaction->status = I2C_TRANSACTION_BUSY;
+
+    /* clear I2C_TDATA register */
+    I2C_STAT(I2CX) |= I2C_STAT_TBE;
+    i2c_interrupt_enable(I2CX, I2C_ENGINE_INT);
+
+    if((0U == (transaction->reg_number + transaction->write_number)) && (0U != transaction->read_number)) {
+        i2c_engine_phase_start(I2C_ENGINE_PHASE_READ);
+    } else {
+        i2c_engine_phase_start(I2C_ENGINE_PHASE_WRITE);
+    }
+}
+
+/*!
+    \brief      send the start or restart of a phase
+    \param[in]  phase: I2C_ENGINE_PHASE_WRITE or I2C_ENGINE_PHASE_READ
+    \param[out] none
+    \retval     none
+*/
+static void i2c_engine_phase_start(uint8_t phase)
+{
+    i2c_transaction_struct *transaction = i2c_engine_active;
+    uint16_t chunk;
+    uint8_t last;
+
+    i2c_engine_phase = phase;
+    i2c_engine_index = 0U;
+    i2c_engine_dma = 0U;
+
+    if(I2C_ENGINE_PHASE_WRITE == phase) {
+        i2c_engine_total = transaction->reg_number + transaction->write_number;
+        last = (0U == transaction->read_number);
+        i2c_master_addressing(I2CX, transaction->address, I2C_MASTER_TRANSMIT);
+    } else {
+        i2c_engine_total = transaction->read_number;
+        last = 1U;
+        i2c_master_addressing(I2CX, transaction->address, I2C_MASTER_RECEIVE);
+    }
+
+    /* NBYTES holds at most 255 bytes, the rest is loaded at each TCR */
+    chunk = (i2c_engine_total > I2C_ENGINE_RELOAD_SIZE) ? I2C_ENGINE_RELOAD_SIZE : i2c_engine_total;
+    i2c_engine_remain = i2c_engine_total - chunk;
+    i2c_transfer_byte_number_config(I2CX, (uint8_t)chunk);
+    if(0U != i2c_engine_remain) {
+        i2c_reload_enable(I2CX);
+    } else {
+        i2c_reload_disable(I2CX);
+    }
+    /* the restart of the read phase needs TC, the stop is sent by hardware at the end */
+    if((0U == i2c_engine_remain) && (0U != last)) {
+        i2c_automatic_end_enable(I2CX);
+    } else {
+        i2c_automatic_end_disable(I2CX);
+    }
+
+    if(I2C_ENGINE_PHASE_WRITE == phase) {
+#ifdef I2C_ENGINE_DMA
+        if(I2C_ENGINE_DMA_MIN_SIZE <= transaction->write_number) {
+            i2c_engine_dma = 1U;
+            dma_channel_disable(I2C_ENGINE_DMA_TX_CHANNEL);
+            dma_memory_address_config(I2C_ENGINE_DMA_TX_CHANNEL, (uint32_t)(uintptr_t)transaction->write_buffer);
+            dma_transfer_number_config(I2C_ENGINE_DMA_TX_CHANNEL, transaction->write_number);
+            if(0U == transaction->reg_number) {
+                dma_channel_enable(I2C_ENGINE_DMA_TX_CHANNEL);
+                i2c_dma_enable(I2CX, I2C_DMA_TRANSMIT);
+            }
+        }
+#endif /* I2C_ENGINE_DMA */
+        /* an address only transaction, e.g. the ack polling, has no byte for TI */
+        if((0U != i2c_engine_total) && ((0U == i2c_engine_dma) || (0U != transaction->reg_number))) {
+            i2c_interrupt_enable(I2CX, I2C_INT_TI);
+        }
+    } else {
+#ifdef I2C_ENGINE_DMA
+        if(I2C_ENGINE_DMA_MIN_SIZE <= transaction->read_number) {
+            i2c_engine_dma = 1U;
+            dma_channel_disable(I2C_ENGINE_DMA_RX_CHANNEL);
+            dma_memory_address_config(I2C_ENGINE_DMA_RX_CHANNEL, (uint32_t)(uintptr_t)transaction->read_buffer);
+            dma_transfer_number_config(I2C_ENGINE_DMA_RX_CHANNEL, transaction->read_number);
+            dma_channel_enable(I2C_ENGINE_DMA_RX_CHANNEL);
+            i2c_dma_enable(I2CX, I2C_DMA_RECEIVE);
+        } else {
+            i2c_interrupt_enable(I2CX, I2C_INT_RBNE);
+        }
+#else
+        i2c_interrupt_enable(I2CX, I2C_INT_RBNE);
+#endif /* I2C_ENGINE_DMA */
+    }
+
+    i2c_start_on_bus(I2CX);
+}
+
+/*!
+    \brief      stop moving the data bytes of the phase
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void i2c_engine_data_stop(void)
+{
+    i2c_interrupt_disable(I2CX, I2C_INT_TI | I2C_INT_RBNE);
+#ifdef I2C_ENGINE_DMA
+    i2c_dma_disable(I2CX, I2C_DMA_TRANSMIT);
+    i2c_dma_disable(I2CX, I2C_DMA_RECEIVE);
+    dma_channel_disable(I2C_ENGINE_DMA_TX_CHANNEL);
+    dma_channel_disable(I2C_ENGINE_DMA_RX_CHANNEL);
+#endif /* I2C_ENGINE_DMA */
+}
+
+/*!
+    \brief      complete the active transaction and start the next one
+    \param[in]  status: status of the active transaction
+    \param[out] none
+    \retval     none
+*/
+static void i2c_engine_finish(i2c_transaction_status_enum status)
+{
+    i2c_transaction_struct *transaction = i2c_engine_active;
+    i2c_transaction_struct *next;
+
+    i2c_interrupt_disable(I2CX, I2C_ENGINE_INT);
+    i2c_engine_data_stop();
+    i2c_engine_active = NULL;
+
+    transaction->status = status;
+    if(NULL != transaction->callback) {
+        transaction->callback(transaction);
+    }
+
+    /* the callback may have queued a transaction */
+    next = i2c_engine_head;
+    if((NULL != next) && (NULL == i2c_engine_active)) {
+        i2c_engine_head = next->next;
+        if(NULL == i2c_engine_head) {
+            i2c_engine_tail = NULL;
+        }
+        i2c_engine_start(next);
+    }
+}
+
+#ifdef I2C_ENGINE_DMA
+/*!
+    \brief      configure the DMA channels of the data phases
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void i2c_engine_dma_config(void)
+{
+    dma_parameter_struct dma_init_struct;
+
+    /* enable DMA clock */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    /* the memory address and the number are set for each phase */
+    dma_deinit(I2C_ENGINE_DMA_TX_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = I2C_ENGINE_DMA_TX_REQUEST;
+    dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr  = 0U;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number       = 0U;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&I2C_TDATA(I2CX);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_MEDIUM;
+    dma_init(I2C_ENGINE_DMA_TX_CHANNEL, &dma_init_struct);
+
+    dma_deinit(I2C_ENGINE_DMA_RX_CHANNEL);
+    dma_init_struct.request      = I2C_ENGINE_DMA_RX_REQUEST;
+    dma_init_struct.direction    = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&I2C_RDATA(I2CX);
+    dma_init_struct.priority     = DMA_PRIORITY_HIGH;
+    dma_init(I2C_ENGINE_DMA_RX_CHANNEL, &dma_init_struct);
+
+    /* configure DMA mode */
+    dma_circulation_disable(I2C_ENGINE_DMA_TX_CHANNEL);
+    dma_memory_to_memory_disable(I2C_ENGINE_DMA_TX_CHANNEL);
+    dmamux_synchronization_disable(I2C_ENGINE_DMA_TX_MUXCH);
+    dma_circulation_disable(I2C_ENGINE_DMA_RX_CHANNEL);
+    dma_memory_to_memory_disable(I2C_ENGINE_DMA_RX_CHANNEL);
+    dmamux_synchronization_disable(I2C_ENGINE_DMA_RX_MUXCH);
+}
+#endif /* I2C_ENGINE_DMA */
@@ -0,0 +1,107 @@
+/*!
+    \file    i2c_engine.h
+    \brief   the header file of interrupt driven I2C transaction engine
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef I2C_ENGINE_H
+#define I2C_ENGINE_H
+
+#include "i2c.h"
+
+/* interrupts of the I2C used by the engine */
+#define I2C_ENGINE_EV_IRQn          I2C1_EV_IRQn
+#define I2C_ENGINE_ER_IRQn          I2C1_ER_IRQn
+
+/* comment this line to move the data bytes by interrupts only */
+#define I2C_ENGINE_DMA
+/* DMA channels of the data phases */
+#define I2C_ENGINE_DMA_TX_CHANNEL   DMA_CH0
+#define I2C_ENGINE_DMA_TX_MUXCH     DMAMUX_MUXCH0
+#define I2C_ENGINE_DMA_TX_REQUEST   DMA_REQUEST_I2C1_TX
+#define I2C_ENGINE_DMA_RX_CHANNEL   DMA_CH1
+#define I2C_ENGINE_DMA_RX_MUXCH     DMAMUX_MUXCH1
+#define I2C_ENGINE_DMA_RX_REQUEST   DMA_REQUEST_I2C1_RX
+/* shorter data phases are moved by interrupts, the DMA setup costs more */
+#define I2C_ENGINE_DMA_MIN_SIZE     4U
+
+/* default transaction timeout in milliseconds */
+#define I2C_ENGINE_TIMEOUT_MS       10U
+/* bytes of the register address sent before the write data */
+#define I2C_ENGINE_REG_SIZE         2U
+
+typedef enum {
+    I2C_TRANSACTION_DONE = 0,                   /* completed, every byte acknowledged */
+    I2C_TRANSACTION_QUEUED,                     /* waiting in the queue */
+    I2C_TRANSACTION_BUSY,                       /* on the bus */
+    I2C_TRANSACTION_NACK,                       /* the address or a data byte was not acknowledged */
+    I2C_TRANSACTION_ERROR,                      /* bus error or arbitration lost */
+    I2C_TRANSACTION_TIMEOUT                     /* not completed in time, the bus was reset */
+} i2c_transaction_status_enum;
+
+struct i2c_transaction;
+
+/* transaction complete callback, called in the I2C or SysTick interrupt */
+typedef void (*i2c_transaction_callback)(struct i2c_transaction *transaction);
+
+/* transaction descriptor, owned by the caller until it is completed:
+   START, address+W, reg[], write_buffer[], RESTART, address+R, read_buffer[], STOP,
+   a phase without bytes is skipped, an address only transaction probes the device */
+typedef struct i2c_transaction {
+    uint8_t address;                            /* device address, bits 1-7 */
+    uint8_t reg[I2C_ENGINE_REG_SIZE];           /* register address, sent first */
+    uint8_t reg_number;                         /* number of register address bytes */
+    uint8_t *write_buffer;                      /* data sent after the register address */
+    uint16_t write_number;                      /* number of bytes to write */
+    uint8_t *read_buffer;                       /* data received after the restart */
+    uint16_t read_number;                       /* number of bytes to read */
+    uint16_t timeout;                           /* timeout in milliseconds, 0 for I2C_ENGINE_TIMEOUT_MS */
+    i2c_transaction_callback callback;          /* NULL if not used */
+    __IO i2c_transaction_status_enum status;    /* set by the engine */
+    struct i2c_transaction *next;               /* queue link, used by the engine */
+} i2c_transaction_struct;
+
+/* function declarations */
+/* initialize the I2C transaction engine */
+void i2c_engine_init(void);
+/* queue a transaction */
+ErrStatus i2c_engine_submit(i2c_transaction_struct *transaction);
+/* wait for a transaction to complete */
+i2c_transaction_status_enum i2c_engine_wait(i2c_transaction_struct *transaction);
+/* I2C event interrupt service */
+void i2c_engine_ev_irq_handler(void);
+/* I2C error interrupt service */
+void i2c_engine_er_irq_handler(void);
+/* check the transaction timeout, call it every millisecond */
+void i2c_engine_tick(void);
+
+#endif /* I2C_ENGINE_H */
@@ -34,6 +34,7 @@ OF SUCH DAMAGE.
 
 #include "gd32c2x1_it.h"
 #include "systick.h"
+#include "gd25qxx.h"
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -105,4 +106,16 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
     delay_decrement();
+    spi_flash_job_poll();
+}
+
+/*!
+    \brief      this function handles DMA_Channel0_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel0_IRQHandler(void)
+{
+    spi_flash_dma_irq_handler();
 }
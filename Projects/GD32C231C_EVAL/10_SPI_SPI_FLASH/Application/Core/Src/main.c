@@ -36,6 +36,7 @@ OF SUCH DAMAGE.
 #include <stdio.h>
 #include "systick.h"
 #include "gd25qxx.h"
+#include "flash_kv.h"
 #include "gd32c231c_eval.h"
 
 #define BUFFER_SIZE              256
@@ -48,6 +49,8 @@ OF SUCH DAMAGE.
 #define FLASH_WRITE_ADDRESS      0x000000
 #define FLASH_READ_ADDRESS       FLASH_WRITE_ADDRESS
 
+#define KV_KEY_BOOT_COUNT        0x0001U
+
 uint32_t int_device_serial[3];
 uint8_t led_count;
 
@@ -62,6 +65,7 @@ void nvic_configuration(void);
 void turn_on_led(uint8_t led_num);
 void get_chip_serial_num(void);
 ErrStatus memory_compare(uint8_t* src, uint8_t* dst, uint16_t length);
+void boot_count_update(void);
 void test_status_led_init(void);
 
 /*!
@@ -103,24 +107,32 @@ int main(void)
 
     /* flash id is correct */
     if(SFLASH_ID == flash_id){
+        /* fill tx_buffer, the queued write reads it */
+        for(i = 0; i < BUFFER_SIZE; i++){
+            tx_buffer[i] = i;
+        }
+
+        /* queue the erase of the specified flash sector */
+        spi_flash_submit_erase(FLASH_WRITE_ADDRESS, NULL);
+
+        /* queue the write of tx_buffer data to the flash */
+        spi_flash_submit_write(tx_buffer, FLASH_WRITE_ADDRESS, TX_BUFFER_SIZE, NULL);
+
+        /* the SysTick interrupt erases and programs the flash while tx_buffer is printed */
         printf("\n\rWrite to tx_buffer:\n\r\n\r");
 
         /* printf tx_buffer value */
         for(i = 0; i < BUFFER_SIZE; i++){
-            tx_buffer[i] = i;
             printf("0x%02X ",tx_buffer[i]);
 
             if(15 == i%16)
                 printf("\n\r");
         }
 
-        printf("\n\r\n\rRead from rx_buffer:\n\r\n\r");
-
-        /* erase the specified flash sector */
-        spi_flash_sector_erase(FLASH_WRITE_ADDRESS);
+        /* wait for the jobs which are left */
+        spi_flash_job_wait();
 
-        /* write tx_buffer data to the flash */ 
-        spi_flash_buffer_write(tx_buffer, FLASH_WRITE_ADDRESS, TX_BUFFER_SIZE);
+        printf("\n\r\n\rRead from rx_buffer:\n\r\n\r");
 
         delay_ms(10);
         /* read a block of data from the flash to rx_buffer */
@@ -142,6 +154,9 @@ int main(void)
         if(0 == is_successful){
             printf("\n\rSPI-GD25Q16 Test Passed!\n\r");
         }
+
+        /* count the resets in the key/value store */
+        boot_count_update();
     }else{
         /* spi flash read id fail */
         printf("\n\rSPI Flash: Read ID Fail!\n\r");
@@ -159,10 +174,40 @@ int main(void)
         if(3 <= led_count)
            led_count = 0;
 
+        /* collect the key/value store while idle */
+        flash_kv_gc();
+
         delay_ms(500);
     }
 }
 
+/*!
+    \brief      read, increase and store the boot count kept in the key/value store
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void boot_count_update(void)
+{
+    uint32_t boot_count = 0;
+    uint16_t length = sizeof(boot_count);
+
+    if(ERROR == flash_kv_init()){
+        printf("\n\rKV: Index Full!\n\r");
+    }
+
+    if(ERROR == flash_kv_get(KV_KEY_BOOT_COUNT, (uint8_t *)&boot_count, &length)){
+        boot_count = 0;
+    }
+    boot_count++;
+
+    if(ERROR == flash_kv_set(KV_KEY_BOOT_COUNT, (uint8_t *)&boot_count, sizeof(boot_count))){
+        printf("\n\rKV: Store Full!\n\r");
+    }else{
+        printf("\n\rKV: Boot Count:%d\n\r", boot_count);
+    }
+}
+
 /*!
     \brief      get chip serial number
     \param[in]  none
@@ -0,0 +1,679 @@
+/*!
+    \file  flash_kv.c
+    \brief key/value store on the SPI flash
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "flash_kv.h"
+#include "gd25qxx.h"
+#include <string.h>
+
+/*
+    every sector starts with a header, the records are appended after it:
+    word 0: key in bits 0-15, value length in bits 16-31, a length of 0 deletes the key
+    word 1: CRC-32 of word 0 and of the value padded with 0xFF to whole words
+    then the value, a record never crosses a flash page so that it takes one page program
+*/
+
+#define KV_MAGIC                0x3153564BU     /* "KVS1" */
+#define KV_SEQUENCE_FREE        0xFFFFFFFFU     /* sequence of a sector which is not in the log */
+#define KV_NONE                 0xFFU           /* no sector */
+
+#define KV_HEADER_SIZE          16U
+#define KV_RECORD_HEADER_SIZE   8U
+#define KV_PAD(length)          (((uint32_t)(length) + 3U) & ~3U)
+#define KV_RECORD_SIZE(length)  (KV_RECORD_HEADER_SIZE + KV_PAD(length))
+#define KV_SECTOR_ADDRESS(s)    (FLASH_KV_START_ADDRESS + (uint32_t)(s) * FLASH_KV_SECTOR_SIZE)
+#define KV_SECTOR_OF(addr)      ((uint8_t)(((addr) - FLASH_KV_START_ADDRESS) / FLASH_KV_SECTOR_SIZE))
+
+/* sector state */
+#define KV_SECTOR_FREE          0x00U           /* erased, header written */
+#define KV_SECTOR_USED          0x01U           /* part of the log */
+#define KV_SECTOR_ERASING       0x02U           /* erase queued by the garbage collection */
+
+/* sector header */
+typedef struct {
+    uint32_t magic;
+    uint32_t erase_count;
+    uint32_t check;                             /* inverted erase count */
+    uint32_t sequence;                          /* programmed when the sector joins the log */
+} kv_header_struct;
+
+/* RAM index entry */
+typedef struct {
+    uint16_t key;
+    uint16_t length;
+    uint32_t addr;                              /* flash address of the record */
+} kv_index_struct;
+
+static kv_index_struct kv_index[FLASH_KV_KEY_NUM];
+static uint8_t kv_key_num = 0U;
+
+static uint8_t kv_sector_state[FLASH_KV_SECTOR_NUM];
+static uint32_t kv_sector_erase[FLASH_KV_SECTOR_NUM];
+static uint32_t kv_sector_sequence[FLASH_KV_SECTOR_NUM];
+/* bytes of the records still referenced by the index */
+static uint16_t kv_sector_live[FLASH_KV_SECTOR_NUM];
+
+static uint8_t kv_active = KV_NONE;             /* sector the records are appended to */
+static uint32_t kv_offset = 0U;                 /* append offset in the active sector */
+static uint32_t kv_sequence = 0U;               /* sequence of the active sector */
+static uint8_t kv_erasing = KV_NONE;            /* sector whose erase is queued */
+static uint8_t kv_reserve = 1U;                 /* free sectors kept for the garbage collection */
+
+/* record being written or checked */
+static uint32_t kv_record[KV_RECORD_SIZE(FLASH_KV_VALUE_MAX) / 4U];
+
+static int16_t kv_index_find(uint16_t key);
+static ErrStatus kv_index_set(uint16_t key, uint16_t length, uint32_t addr);
+static void kv_index_remove(int16_t index);
+static uint32_t kv_crc(uint16_t length);
+static ErrStatus kv_scan(uint8_t sector, uint32_t *offset);
+static void kv_prepare(uint8_t sector);
+static uint8_t kv_free_count(void);
+static ErrStatus kv_open(void);
+static FlagStatus kv_fits(uint32_t size);
+static ErrStatus kv_write_record(void);
+static ErrStatus kv_make_room(uint32_t size);
+static uint8_t kv_victim(void);
+static ErrStatus kv_collect(void);
+
+/*!
+    \brief      mount the key/value store and build the RAM index, the SPI flash must be initialized
+    \param[in]  none
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the index is too small for the stored keys
+*/
+ErrStatus flash_kv_init(void)
+{
+    kv_header_struct header;
+    ErrStatus status = SUCCESS;
+    uint32_t last = 0U;
+    uint8_t sector, next;
+
+    /* the records are protected by the CRC-32 of the CRC unit */
+    rcu_periph_clock_enable(RCU_CRC);
+    crc_deinit();
+
+    kv_key_num = 0U;
+    kv_active = KV_NONE;
+    kv_erasing = KV_NONE;
+    kv_sequence = 0U;
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        spi_flash_buffer_read((uint8_t *)&header, KV_SECTOR_ADDRESS(sector), sizeof(header));
+        kv_sector_live[sector] = 0U;
+
+        if((KV_MAGIC == header.magic) && (header.erase_count == ~header.check)) {
+            kv_sector_erase[sector] = header.erase_count;
+            kv_sector_sequence[sector] = header.sequence;
+            kv_sector_state[sector] = (KV_SEQUENCE_FREE == header.sequence) ? KV_SECTOR_FREE : KV_SECTOR_USED;
+        } else {
+            /* never formatted or erase interrupted, the erase count is lost */
+            kv_sector_erase[sector] = 0U;
+            spi_flash_sector_erase(KV_SECTOR_ADDRESS(sector));
+            kv_prepare(sector);
+        }
+    }
+
+    /* replay the sectors of the log from the oldest one, later records win */
+    while(1) {
+        next = KV_NONE;
+        for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+            if((KV_SECTOR_USED == kv_sector_state[sector]) && (kv_sector_sequence[sector] > last) &&
+                    ((KV_NONE == next) || (kv_sector_sequence[sector] < kv_sector_sequence[next]))) {
+                next = sector;
+            }
+        }
+        if(KV_NONE == next) {
+            break;
+        }
+
+        if(ERROR == kv_scan(next, &kv_offset)) {
+            status = ERROR;
+        }
+        kv_active = next;
+        last = kv_sector_sequence[next];
+    }
+    kv_sequence = last;
+
+    return status;
+}
+
+/*!
+    \brief      erase the key/value store
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void flash_kv_format(void)
+{
+    uint8_t sector;
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        spi_flash_sector_erase(KV_SECTOR_ADDRESS(sector));
+        kv_sector_erase[sector]++;
+        kv_sector_live[sector] = 0U;
+        kv_prepare(sector);
+    }
+
+    kv_key_num = 0U;
+    kv_active = KV_NONE;
+    kv_erasing = KV_NONE;
+    kv_sequence = 0U;
+}
+
+/*!
+    \brief      store the value of a key, it costs one page program
+    \param[in]  key: key of the value, except FLASH_KV_KEY_INVALID
+    \param[in]  pbuffer: pointer to the value
+    \param[in]  length: length of the value, 1 to FLASH_KV_VALUE_MAX
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR
+*/
+ErrStatus flash_kv_set(uint16_t key, uint8_t *pbuffer, uint16_t length)
+{
+    uint8_t *value = (uint8_t *)&kv_record[2];
+
+    if((FLASH_KV_KEY_INVALID == key) || (0U == length) || (FLASH_KV_VALUE_MAX < length)) {
+        return ERROR;
+    }
+    if((0 > kv_index_find(key)) && (FLASH_KV_KEY_NUM == kv_key_num)) {
+        return ERROR;
+    }
+    if(ERROR == kv_make_room(KV_RECORD_SIZE(length))) {
+        return ERROR;
+    }
+
+    kv_record[0] = (uint32_t)key | ((uint32_t)length << 16);
+    memcpy(value, pbuffer, length);
+    memset(value + length, 0xFF, KV_PAD(length) - length);
+    kv_record[1] = kv_crc(length);
+
+    return kv_write_record();
+}
+
+/*!
+    \brief      read the value of a key
+    \param[in]  key: key of the value
+    \param[in]  pbuffer: pointer to the buffer that receives the value
+    \param[in]  length: pointer to the size of the buffer
+    \param[out] length: length of the value
+    \retval     ErrStatus: SUCCESS or ERROR if the key is not found or the buffer is too small
+*/
+ErrStatus flash_kv_get(uint16_t key, uint8_t *pbuffer, uint16_t *length)
+{
+    int16_t index = kv_index_find(key);
+
+    if((0 > index) || (0U == kv_index[index].length) || (*length < kv_index[index].length)) {
+        return ERROR;
+    }
+
+    *length = kv_index[index].length;
+    spi_flash_buffer_read(pbuffer, kv_index[index].addr + KV_RECORD_HEADER_SIZE, *length);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      delete a key
+    \param[in]  key: key to delete
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the key is not found
+*/
+ErrStatus flash_kv_delete(uint16_t key)
+{
+    int16_t index = kv_index_find(key);
+
+    if((0 > index) || (0U == kv_index[index].length)) {
+        return ERROR;
+    }
+    if(ERROR == kv_make_room(KV_RECORD_HEADER_SIZE)) {
+        return ERROR;
+    }
+
+    /* the deleted key stays in the index until its record is collected */
+    kv_record[0] = (uint32_t)key;
+    kv_record[1] = kv_crc(0U);
+
+    return kv_write_record();
+}
+
+/*!
+    \brief      run one step of the background garbage collection, call it when the
+                application is idle, a step moves the records of one sector and queues its erase
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void flash_kv_gc(void)
+{
+    if(KV_NONE != kv_erasing) {
+        /* the queued erase completes in the background */
+        if(0U != spi_flash_job_count()) {
+            return;
+        }
+        kv_prepare(kv_erasing);
+        kv_erasing = KV_NONE;
+        return;
+    }
+
+    if(FLASH_KV_GC_FREE_SECTORS > kv_free_count()) {
+        (void)kv_collect();
+    }
+}
+
+/*!
+    \brief      find a key in the RAM index
+    \param[in]  key: key to find
+    \param[out] none
+    \retval     position in the index, -1 if the key is not found
+*/
+static int16_t kv_index_find(uint16_t key)
+{
+    int16_t index;
+
+    for(index = 0; index < (int16_t)kv_key_num; index++) {
+        if(key == kv_index[index].key) {
+            return index;
+        }
+    }
+
+    return -1;
+}
+
+/*!
+    \brief      point a key of the RAM index to a new record
+    \param[in]  key: key of the record
+    \param[in]  length: value length of the record
+    \param[in]  addr: flash address of the record
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the index is full
+*/
+static ErrStatus kv_index_set(uint16_t key, uint16_t length, uint32_t addr)
+{
+    int16_t index = kv_index_find(key);
+
+    if(0 > index) {
+        if(FLASH_KV_KEY_NUM == kv_key_num) {
+            return ERROR;
+        }
+        index = (int16_t)kv_key_num;
+        kv_key_num++;
+    } else {
+        /* the older record becomes garbage */
+        kv_sector_live[KV_SECTOR_OF(kv_index[index].addr)] -= KV_RECORD_SIZE(kv_index[index].length);
+    }
+
+    kv_index[index].key = key;
+    kv_index[index].length = length;
+    kv_index[index].addr = addr;
+    kv_sector_live[KV_SECTOR_OF(addr)] += KV_RECORD_SIZE(length);
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      remove an entry of the RAM index
+    \param[in]  index: position in the index
+    \param[out] none
+    \retval     none
+*/
+static void kv_index_remove(int16_t index)
+{
+    kv_sector_live[KV_SECTOR_OF(kv_index[index].addr)] -= KV_RECORD_SIZE(kv_index[index].length);
+    kv_key_num--;
+    kv_index[index] = kv_index[kv_key_num];
+}
+
+/*!
+    \brief      calculate the CRC of the record in kv_record
+    \param[in]  length: value length of the record
+    \param[out] none
+    \retval     CRC-32 of the record
+*/
+static uint32_t kv_crc(uint16_t length)
+{
+    uint32_t crc;
+
+    crc_data_register_reset();
+    crc = crc_block_data_calculate(&kv_record[0], 1U, INPUT_FORMAT_WORD);
+    if(0U != length) {
+        crc = crc_block_data_calculate(&kv_record[2], KV_PAD(length) / 4U, INPUT_FORMAT_WORD);
+    }
+
+    return crc;
+}
+
+/*!
+    \brief      add the records of a sector to the RAM index
+    \param[in]  sector: sector of the log
+    \param[out] offset: append offset in the sector
+    \retval     ErrStatus: SUCCESS or ERROR if a key didn't fit in the index
+*/
+static ErrStatus kv_scan(uint8_t sector, uint32_t *offset)
+{
+    uint32_t base = KV_SECTOR_ADDRESS(sector);
+    uint32_t position = KV_HEADER_SIZE;
+    uint32_t empty = 0U;
+    uint32_t size;
+    uint16_t key, length;
+    ErrStatus status = SUCCESS;
+
+    while((position + KV_RECORD_HEADER_SIZE) <= FLASH_KV_SECTOR_SIZE) {
+        if(SPI_FLASH_PAGE_SIZE < ((position % SPI_FLASH_PAGE_SIZE) + KV_RECORD_HEADER_SIZE)) {
+            /* the tail of the page can't hold a record */
+            kv_record[0] = 0xFFFFFFFFU;
+            kv_record[1] = 0xFFFFFFFFU;
+        } else {
+            spi_flash_buffer_read((uint8_t *)kv_record, base + position, KV_RECORD_HEADER_SIZE);
+        }
+
+        if((0xFFFFFFFFU == kv_record[0]) && (0xFFFFFFFFU == kv_record[1])) {
+            /* erased, the log goes on at the next page if a record didn't fit in this one */
+            if(0U == empty) {
+                empty = position;
+            }
+            if(0U == (position % SPI_FLASH_PAGE_SIZE)) {
+                break;
+            }
+            position = (position | (SPI_FLASH_PAGE_SIZE - 1U)) + 1U;
+            continue;
+        }
+
+        key = (uint16_t)kv_record[0];
+        length = (uint16_t)(kv_record[0] >> 16);
+        size = KV_RECORD_SIZE(length);
+        empty = 0U;
+
+        if((FLASH_KV_KEY_INVALID == key) || (FLASH_KV_VALUE_MAX < length) ||
+                (SPI_FLASH_PAGE_SIZE < ((position % SPI_FLASH_PAGE_SIZE) + size))) {
+            /* torn record, close the sector */
+            *offset = FLASH_KV_SECTOR_SIZE;
+            return status;
+        }
+        if(0U != length) {
+            spi_flash_buffer_read((uint8_t *)&kv_record[2], base + position + KV_RECORD_HEADER_SIZE, (uint16_t)KV_PAD(length));
+        }
+        if(kv_record[1] != kv_crc(length)) {
+            *offset = FLASH_KV_SECTOR_SIZE;
+            return status;
+        }
+
+        if(ERROR == kv_index_set(key, length, base + position)) {
+            status = ERROR;
+        }
+        position += size;
+    }
+
+    *offset = (0U != empty) ? empty : position;
+
+    return status;
+}
+
+/*!
+    \brief      write the header of an erased sector and make it free
+    \param[in]  sector: erased sector
+    \param[out] none
+    \retval     none
+*/
+static void kv_prepare(uint8_t sector)
+{
+    kv_header_struct header;
+
+    header.magic = KV_MAGIC;
+    header.erase_count = kv_sector_erase[sector];
+    header.check = ~kv_sector_erase[sector];
+
+    /* the sequence is left erased until the sector joins the log */
+    spi_flash_page_write((uint8_t *)&header, KV_SECTOR_ADDRESS(sector), 12U);
+
+    kv_sector_state[sector] = KV_SECTOR_FREE;
+    kv_sector_sequence[sector] = KV_SEQUENCE_FREE;
+}
+
+/*!
+    \brief      get the number of free sectors
+    \param[in]  none
+    \param[out] none
+    \retval     number of free sectors
+*/
+static uint8_t kv_free_count(void)
+{
+    uint8_t sector, count = 0U;
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        if(KV_SECTOR_FREE == kv_sector_state[sector]) {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/*!
+    \brief      append a free sector to the log, the least worn one is taken
+    \param[in]  none
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if only the reserved sectors are free
+*/
+static ErrStatus kv_open(void)
+{
+    uint8_t sector, next = KV_NONE;
+
+    if(kv_reserve >= kv_free_count()) {
+        return ERROR;
+    }
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        if((KV_SECTOR_FREE == kv_sector_state[sector]) &&
+                ((KV_NONE == next) || (kv_sector_erase[sector] < kv_sector_erase[next]))) {
+            next = sector;
+        }
+    }
+
+    kv_sequence++;
+    spi_flash_page_write((uint8_t *)&kv_sequence, KV_SECTOR_ADDRESS(next) + 12U, sizeof(kv_sequence));
+
+    kv_sector_state[next] = KV_SECTOR_USED;
+    kv_sector_sequence[next] = kv_sequence;
+    kv_sector_live[next] = 0U;
+    kv_active = next;
+    kv_offset = KV_HEADER_SIZE;
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      check whether a record fits in the active sector
+    \param[in]  size: size of the record
+    \param[out] none
+    \retval     SET if it fits, RESET otherwise
+*/
+static FlagStatus kv_fits(uint32_t size)
+{
+    uint32_t offset = kv_offset;
+
+    if(KV_NONE == kv_active) {
+        return RESET;
+    }
+    if(SPI_FLASH_PAGE_SIZE < ((offset % SPI_FLASH_PAGE_SIZE) + size)) {
+        offset = (offset | (SPI_FLASH_PAGE_SIZE - 1U)) + 1U;
+    }
+
+    return ((offset + size) <= FLASH_KV_SECTOR_SIZE) ? SET : RESET;
+}
+
+/*!
+    \brief      append the record in kv_record to the log
+    \param[in]  none
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if there is no room
+*/
+static ErrStatus kv_write_record(void)
+{
+    uint16_t key = (uint16_t)kv_record[0];
+    uint16_t length = (uint16_t)(kv_record[0] >> 16);
+    uint32_t size = KV_RECORD_SIZE(length);
+    uint32_t addr;
+
+    if(RESET == kv_fits(size)) {
+        if(ERROR == kv_open()) {
+            return ERROR;
+        }
+    }
+    if(SPI_FLASH_PAGE_SIZE < ((kv_offset % SPI_FLASH_PAGE_SIZE) + size)) {
+        kv_offset = (kv_offset | (SPI_FLASH_PAGE_SIZE - 1U)) + 1U;
+    }
+
+    addr = KV_SECTOR_ADDRESS(kv_active) + kv_offset;
+    spi_flash_page_write((uint8_t *)kv_record, addr, (uint16_t)size);
+    kv_offset += size;
+
+    return kv_index_set(key, length, addr);
+}
+
+/*!
+    \brief      collect sectors in the foreground until a record can be appended
+    \param[in]  size: size of the record
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the store is full
+*/
+static ErrStatus kv_make_room(uint32_t size)
+{
+    while((RESET == kv_fits(size)) && (kv_reserve >= kv_free_count())) {
+        if(KV_NONE != kv_erasing) {
+            spi_flash_job_wait();
+            flash_kv_gc();
+        } else if(ERROR == kv_collect()) {
+            return ERROR;
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      select the sector to collect
+    \param[in]  none
+    \param[out] none
+    \retval     sector to collect, KV_NONE if no sector is worth collecting
+*/
+static uint8_t kv_victim(void)
+{
+    uint8_t sector, victim = KV_NONE, coldest = KV_NONE;
+    uint32_t worn = 0U;
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        if(worn < kv_sector_erase[sector]) {
+            worn = kv_sector_erase[sector];
+        }
+        if((KV_SECTOR_USED != kv_sector_state[sector]) || (kv_active == sector)) {
+            continue;
+        }
+        /* the sector with the least live data frees the most space */
+        if((KV_NONE == victim) || (kv_sector_live[sector] < kv_sector_live[victim])) {
+            victim = sector;
+        }
+        if((KV_NONE == coldest) || (kv_sector_erase[sector] < kv_sector_erase[coldest])) {
+            coldest = sector;
+        }
+    }
+
+    /* static data keeps its sector from being erased, move it once the wear drifts apart */
+    if((KV_NONE != coldest) && (FLASH_KV_WEAR_DELTA < (worn - kv_sector_erase[coldest]))) {
+        return coldest;
+    }
+    /* a sector without at least a page of garbage is not worth an erase */
+    if((KV_NONE != victim) &&
+            ((FLASH_KV_SECTOR_SIZE - KV_HEADER_SIZE - SPI_FLASH_PAGE_SIZE) < kv_sector_live[victim])) {
+        return KV_NONE;
+    }
+
+    return victim;
+}
+
+/*!
+    \brief      move the live records of a sector to the log and queue its erase
+    \param[in]  none
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if there is nothing to collect or no room
+*/
+static ErrStatus kv_collect(void)
+{
+    uint8_t sector, victim = kv_victim();
+    FlagStatus oldest = SET;
+    int16_t index;
+    ErrStatus status = SUCCESS;
+
+    if(KV_NONE == victim) {
+        return ERROR;
+    }
+
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        if((KV_SECTOR_USED == kv_sector_state[sector]) &&
+                (kv_sector_sequence[sector] < kv_sector_sequence[victim])) {
+            oldest = RESET;
+        }
+    }
+
+    /* the records may take the reserved sector */
+    kv_reserve = 0U;
+    index = (int16_t)kv_key_num - 1;
+    while((0 <= index) && (SUCCESS == status)) {
+        if(victim == KV_SECTOR_OF(kv_index[index].addr)) {
+            if((0U == kv_index[index].length) && (SET == oldest)) {
+                /* no older record of a deleted key is left once the oldest sector is erased */
+                kv_index_remove(index);
+            } else {
+                spi_flash_buffer_read((uint8_t *)kv_record, kv_index[index].addr,
+                                      (uint16_t)KV_RECORD_SIZE(kv_index[index].length));
+                status = kv_write_record();
+            }
+        }
+        index--;
+    }
+    kv_reserve = 1U;
+
+    if(ERROR == status) {
+        return ERROR;
+    }
+
+    kv_sector_state[victim] = KV_SECTOR_ERASING;
+    kv_sector_erase[victim]++;
+    if(ERROR == spi_flash_submit_erase(KV_SECTOR_ADDRESS(victim), NULL)) {
+        spi_flash_sector_erase(KV_SECTOR_ADDRESS(victim));
+    }
+    kv_erasing = victim;
+
+    return SUCCESS;
+}
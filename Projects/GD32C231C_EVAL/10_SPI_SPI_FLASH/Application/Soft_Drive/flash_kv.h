@@ -0,0 +1,71 @@
+/*!
+    \file  flash_kv.h
+    \brief the header file of key/value store on the SPI flash
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef FLASH_KV_H
+#define FLASH_KV_H
+
+#include "gd32c2x1.h"
+
+/* flash area used by the key/value log, whole sectors at the end of the GD25Q16 */
+#define FLASH_KV_START_ADDRESS      0x1F8000U
+#define FLASH_KV_SECTOR_SIZE        0x1000U
+#define FLASH_KV_SECTOR_NUM         8U
+
+/* number of keys held by the RAM index, deleted keys included */
+#define FLASH_KV_KEY_NUM            32U
+/* largest value in bytes, a record never crosses a flash page */
+#define FLASH_KV_VALUE_MAX          64U
+/* flash_kv_gc() collects a sector while fewer sectors are free */
+#define FLASH_KV_GC_FREE_SECTORS    2U
+/* erase count spread which moves the data out of the least worn sector */
+#define FLASH_KV_WEAR_DELTA         32U
+
+/* key of the erased flash, it can't be stored */
+#define FLASH_KV_KEY_INVALID        0xFFFFU
+
+/* mount the key/value store and build the RAM index */
+ErrStatus flash_kv_init(void);
+/* erase the key/value store */
+void flash_kv_format(void);
+/* store the value of a key */
+ErrStatus flash_kv_set(uint16_t key, uint8_t *pbuffer, uint16_t length);
+/* read the value of a key */
+ErrStatus flash_kv_get(uint16_t key, uint8_t *pbuffer, uint16_t *length);
+/* delete a key */
+ErrStatus flash_kv_delete(uint16_t key);
+/* run one step of the background garbage collection */
+void flash_kv_gc(void);
+
+#endif /* FLASH_KV_H */
@@ -42,6 +42,7 @@ OF SUCH DAMAGE.
 #define WREN             0x06     /* write enable instruction */
 
 #define READ             0x03     /* read from memory instruction */
+#define FAST_READ        0x0B     /* fast read from memory instruction */
 #define QUADREAD         0x6B     /* read from memory instruction */
 #define RDSR             0x05     /* read status register instruction */
 #define RDID             0x9F     /* read identification */
@@ -53,6 +54,43 @@ OF SUCH DAMAGE.
 #define WIP_FLAG         0x01     /* write in progress(wip) flag */
 #define DUMMY_BYTE       0xA5
 
+#define JOB_WRITE        0x00     /* queued page program job */
+#define JOB_ERASE        0x01     /* queued sector erase job */
+
+/* queued program/erase job */
+typedef struct {
+    uint8_t type;
+    uint8_t *pbuffer;
+    uint32_t addr;
+    uint32_t remain;
+    spi_flash_callback callback;
+} spi_flash_job_struct;
+
+static __IO FlagStatus spi_flash_dma_state = RESET;
+static __IO uint32_t spi_flash_dma_remain = 0U;
+static __IO uint32_t spi_flash_dma_memory = 0U;
+static spi_flash_callback spi_flash_dma_done = NULL;
+static uint32_t spi_flash_read_prescale = SPI_FLASH_PSC_READ;
+static uint8_t spi_flash_dma_dummy = DUMMY_BYTE;
+
+/* the job queue is filled by the application and emptied by spi_flash_job_poll() */
+static spi_flash_job_struct spi_flash_job[SPI_FLASH_JOB_NUM];
+static __IO uint8_t spi_flash_job_head = 0U;
+static __IO uint8_t spi_flash_job_tail = 0U;
+/* SET while the flash executes a program or erase instruction issued by the queue */
+static __IO FlagStatus spi_flash_job_step = RESET;
+/* SET while a DMA read holds the queue off the bus */
+static __IO FlagStatus spi_flash_job_hold = RESET;
+
+static void spi_flash_dma_init(void);
+static void spi_flash_prescale_set(uint32_t prescale);
+static void spi_flash_dma_block_start(void);
+static void spi_flash_dma_stop(void);
+static void spi_flash_sector_erase_start(uint32_t sector_addr);
+static void spi_flash_page_program_start(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write);
+static void spi_flash_write_enable_send(void);
+static uint8_t spi_flash_status_read(void);
+
 /*!
     \brief      initialize SPI1 GPIO and parameter
     \param[in]  none
@@ -84,7 +122,7 @@ void spi_flash_init(void)
     spi_init_struct.frame_size           = SPI_FRAMESIZE_8BIT;
     spi_init_struct.clock_polarity_phase = SPI_CK_PL_LOW_PH_1EDGE;
     spi_init_struct.nss                  = SPI_NSS_SOFT;
-    spi_init_struct.prescale             = SPI_PSC_32;
+    spi_init_struct.prescale             = SPI_FLASH_PSC_COMMAND;
     spi_init_struct.endian               = SPI_ENDIAN_MSB;
     spi_init(SPI1, &spi_init_struct);
 
@@ -96,6 +134,59 @@ void spi_flash_init(void)
 
     /* enable SPI1 */
     spi_enable(SPI1);
+
+    spi_flash_dma_init();
+}
+
+/*!
+    \brief      initialize the DMA channels which read the flash through SPI1
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_dma_init(void)
+{
+    dma_parameter_struct dma_init_struct;
+
+    /* enable DMA clock */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    /* SPI1 receive channel, the memory address is set for each transfer */
+    dma_deinit(SPI_FLASH_DMA_RX_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = DMA_REQUEST_SPI1_RX;
+    dma_init_struct.direction    = DMA_PERIPHERAL_TO_MEMORY;
+    dma_init_struct.memory_addr  = 0U;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+    dma_init_struct.number       = 0U;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&SPI_DATA(SPI1);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_ULTRA_HIGH;
+    dma_init(SPI_FLASH_DMA_RX_CHANNEL, &dma_init_struct);
+
+    /* SPI1 transmit channel, clocks the same dummy byte out for each byte read */
+    dma_deinit(SPI_FLASH_DMA_TX_CHANNEL);
+    dma_init_struct.request      = DMA_REQUEST_SPI1_TX;
+    dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)&spi_flash_dma_dummy;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_DISABLE;
+    dma_init_struct.priority     = DMA_PRIORITY_HIGH;
+    dma_init(SPI_FLASH_DMA_TX_CHANNEL, &dma_init_struct);
+
+    /* configure DMA mode */
+    dma_circulation_disable(SPI_FLASH_DMA_RX_CHANNEL);
+    dma_memory_to_memory_disable(SPI_FLASH_DMA_RX_CHANNEL);
+    dmamux_synchronization_disable(SPI_FLASH_DMA_RX_MUXCH);
+    dma_circulation_disable(SPI_FLASH_DMA_TX_CHANNEL);
+    dma_memory_to_memory_disable(SPI_FLASH_DMA_TX_CHANNEL);
+    dmamux_synchronization_disable(SPI_FLASH_DMA_TX_MUXCH);
+
+    /* the last received byte completes the transfer */
+    dma_interrupt_enable(SPI_FLASH_DMA_RX_CHANNEL, DMA_INT_FTF | DMA_INT_ERR);
+    nvic_irq_enable(SPI_FLASH_DMA_RX_IRQn, 0);
 }
 
 /*!
@@ -105,9 +196,26 @@ void spi_flash_init(void)
     \retval     none
 */
 void spi_flash_sector_erase(uint32_t sector_addr)
+{
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+
+    spi_flash_sector_erase_start(sector_addr);
+
+    /* wait the end of flash writing */
+    spi_flash_wait_for_write_end();
+}
+
+/*!
+    \brief      send the erase instruction of the specified flash sector
+    \param[in]  sector_addr: address of the sector to erase
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_sector_erase_start(uint32_t sector_addr)
 {
     /* send write enable instruction */
-    spi_flash_write_enable();
+    spi_flash_write_enable_send();
 
     /* sector erase */
     /* select the flash: chip select low */
@@ -122,9 +230,6 @@ void spi_flash_sector_erase(uint32_t sector_addr)
     spi_flash_send_byte(sector_addr & 0xFF);
     /* deselect the flash: chip select high */
     SPI_FLASH_CS_HIGH();
-
-    /* wait the end of flash writing */
-    spi_flash_wait_for_write_end();
 }
 
 /*!
@@ -135,6 +240,9 @@ void spi_flash_sector_erase(uint32_t sector_addr)
 */
 void spi_flash_bulk_erase(void)
 {
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+
     /* send write enable instruction */
     spi_flash_write_enable();
 
@@ -159,9 +267,28 @@ void spi_flash_bulk_erase(void)
     \retval     none
 */
 void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
+{
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+
+    spi_flash_page_program_start(pbuffer, write_addr, num_byte_to_write);
+
+    /* wait the end of flash writing */
+    spi_flash_wait_for_write_end();
+}
+
+/*!
+    \brief      send the page program instruction and the data
+    \param[in]  pbuffer: pointer to the buffer
+    \param[in]  write_addr: flash's internal address to write
+    \param[in]  num_byte_to_write: number of bytes to write, the page boundary must not be crossed
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_page_program_start(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
 {
     /* enable the write access to the flash */
-    spi_flash_write_enable();
+    spi_flash_write_enable_send();
 
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
@@ -185,9 +312,6 @@ void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_by
 
     /* deselect the flash: chip select high */
     SPI_FLASH_CS_HIGH();
-
-    /* wait the end of flash writing */
-    spi_flash_wait_for_write_end();
 }
 
 /*!
@@ -267,11 +391,55 @@ void spi_flash_buffer_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_
 */
 void spi_flash_buffer_read(uint8_t *pbuffer, uint32_t read_addr, uint16_t num_byte_to_read)
 {
-    /* select the flash: chip slect low */
+    spi_flash_dma_read(pbuffer, read_addr, num_byte_to_read, NULL);
+    spi_flash_dma_wait();
+}
+
+/*!
+    \brief      select the SPI1 prescaler used while reading data
+    \param[in]  prescale: SPI clock prescale factor
+                only one parameter can be selected which is shown as below:
+      \arg        SPI_PSC_n (n=2,4,8,16,32,64,128,256)
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_read_prescale_config(uint32_t prescale)
+{
+    spi_flash_read_prescale = prescale & SPI_CTL0_PSC;
+}
+
+/*!
+    \brief      read a block of data from the flash using fast read and DMA
+    \param[in]  pbuffer: pointer to the buffer that receives the data, must stay valid until the read is done
+    \param[in]  read_addr: flash's internal address to read from
+    \param[in]  num_byte_to_read: number of bytes to read from the flash
+    \param[in]  callback: function called in the DMA interrupt when the read is done, NULL if not used
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_dma_read(uint8_t *pbuffer, uint32_t read_addr, uint32_t num_byte_to_read, spi_flash_callback callback)
+{
+    spi_flash_dma_wait();
+
+    if(0U == num_byte_to_read) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+
+    /* no data can be read while the flash executes a queued program or erase */
+    spi_flash_job_hold = SET;
+    while(RESET != spi_flash_job_step) {
+    }
+
+    spi_flash_prescale_set(spi_flash_read_prescale);
+
+    /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
 
-    /* send "read from memory " instruction */
-    spi_flash_send_byte(READ);
+    /* send "fast read from memory" instruction */
+    spi_flash_send_byte(FAST_READ);
 
     /* send read_addr high nibble address byte to read from */
     spi_flash_send_byte((read_addr & 0xFF0000) >> 16);
@@ -279,17 +447,312 @@ void spi_flash_buffer_read(uint8_t *pbuffer, uint32_t read_addr, uint16_t num_by
     spi_flash_send_byte((read_addr & 0xFF00) >> 8);
     /* send read_addr low nibble address byte to read from */
     spi_flash_send_byte(read_addr & 0xFF);
+    /* send the dummy byte which gives the flash its 8 dummy clocks */
+    spi_flash_send_byte(DUMMY_BYTE);
+
+    spi_flash_dma_state = SET;
+    spi_flash_dma_memory = (uint32_t)(uintptr_t)pbuffer;
+    spi_flash_dma_remain = num_byte_to_read;
+    spi_flash_dma_done = callback;
+
+    /* the receive request must be enabled before the first byte is clocked */
+    spi_dma_enable(SPI1, SPI_DMA_RECEIVE);
+    spi_dma_enable(SPI1, SPI_DMA_TRANSMIT);
+    spi_flash_dma_block_start();
+}
 
-    /* while there is data to be read */
-    while(num_byte_to_read--) {
-        /* read a byte from the flash */
-        *pbuffer = spi_flash_send_byte(DUMMY_BYTE);
-        /* point to the next location where the byte read will be saved */
-        pbuffer++;
+/*!
+    \brief      get the flash DMA read state
+    \param[in]  none
+    \param[out] none
+    \retval     SET if a DMA read is on-going, RESET otherwise
+*/
+FlagStatus spi_flash_dma_busy(void)
+{
+    return spi_flash_dma_state;
+}
+
+/*!
+    \brief      wait for the flash DMA read to complete
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_dma_wait(void)
+{
+    while(RESET != spi_flash_dma_state) {
     }
+}
+
+/*!
+    \brief      flash DMA receive channel interrupt service, call it from the DMA channel IRQ handler
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_dma_irq_handler(void)
+{
+    if(RESET != dma_interrupt_flag_get(SPI_FLASH_DMA_RX_CHANNEL, DMA_INT_FLAG_ERR)) {
+        dma_interrupt_flag_clear(SPI_FLASH_DMA_RX_CHANNEL, DMA_INT_FLAG_G);
+        /* abort the remaining blocks */
+        spi_flash_dma_remain = 0U;
+        spi_flash_dma_stop();
+    } else if(RESET != dma_interrupt_flag_get(SPI_FLASH_DMA_RX_CHANNEL, DMA_INT_FLAG_FTF)) {
+        dma_interrupt_flag_clear(SPI_FLASH_DMA_RX_CHANNEL, DMA_INT_FLAG_G);
+        if(0U != spi_flash_dma_remain) {
+            spi_flash_dma_block_start();
+        } else {
+            spi_flash_dma_stop();
+        }
+    }
+}
+
+/*!
+    \brief      queue a write of a block of data to the flash, the sectors must be erased
+    \param[in]  pbuffer: pointer to the buffer, must stay valid until the job is done
+    \param[in]  write_addr: flash's internal address to write
+    \param[in]  num_byte_to_write: number of bytes to write to the flash
+    \param[in]  callback: function called in the spi_flash_job_poll() context when the job is done, NULL if not used
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the queue is full
+*/
+ErrStatus spi_flash_submit_write(uint8_t *pbuffer, uint32_t write_addr, uint32_t num_byte_to_write, spi_flash_callback callback)
+{
+    spi_flash_job_struct *job;
+
+    if(SPI_FLASH_JOB_NUM == spi_flash_job_count()) {
+        return ERROR;
+    }
+
+    job = &spi_flash_job[spi_flash_job_tail & (SPI_FLASH_JOB_NUM - 1U)];
+    job->type = JOB_WRITE;
+    job->pbuffer = pbuffer;
+    job->addr = write_addr;
+    job->remain = num_byte_to_write;
+    job->callback = callback;
+
+    /* publish the job to spi_flash_job_poll() */
+    spi_flash_job_tail++;
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      queue an erase of the specified flash sector
+    \param[in]  sector_addr: address of the sector to erase
+    \param[in]  callback: function called in the spi_flash_job_poll() context when the job is done, NULL if not used
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the queue is full
+*/
+ErrStatus spi_flash_submit_erase(uint32_t sector_addr, spi_flash_callback callback)
+{
+    spi_flash_job_struct *job;
+
+    if(SPI_FLASH_JOB_NUM == spi_flash_job_count()) {
+        return ERROR;
+    }
+
+    job = &spi_flash_job[spi_flash_job_tail & (SPI_FLASH_JOB_NUM - 1U)];
+    job->type = JOB_ERASE;
+    job->pbuffer = NULL;
+    job->addr = sector_addr;
+    job->remain = 1U;
+    job->callback = callback;
+
+    /* publish the job to spi_flash_job_poll() */
+    spi_flash_job_tail++;
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      get the number of jobs in the queue, the running one included
+    \param[in]  none
+    \param[out] none
+    \retval     number of jobs
+*/
+uint8_t spi_flash_job_count(void)
+{
+    return (uint8_t)(spi_flash_job_tail - spi_flash_job_head);
+}
+
+/*!
+    \brief      wait for all the queued jobs to complete, not to be called from a job callback
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_job_wait(void)
+{
+    while(0U != spi_flash_job_count()) {
+    }
+}
+
+/*!
+    \brief      advance the queued jobs, call it from a periodic interrupt
+                which has the same priority as the flash DMA interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void spi_flash_job_poll(void)
+{
+    spi_flash_job_struct *job;
+    spi_flash_callback callback;
+    uint32_t number;
+
+    /* the application is using the bus, try again at the next tick */
+    if((RESET == gpio_output_bit_get(GPIOB, GPIO_PIN_11)) || (RESET != spi_flash_dma_state)) {
+        return;
+    }
+
+    if(RESET != spi_flash_job_step) {
+        if(0U != (spi_flash_status_read() & WIP_FLAG)) {
+            return;
+        }
+        spi_flash_job_step = RESET;
+    }
+
+    while(0U != spi_flash_job_count()) {
+        job = &spi_flash_job[spi_flash_job_head & (SPI_FLASH_JOB_NUM - 1U)];
+
+        if(0U == job->remain) {
+            /* the job is done */
+            callback = job->callback;
+            spi_flash_job_head++;
+            if(NULL != callback) {
+                callback();
+            }
+            continue;
+        }
+
+        if(RESET != spi_flash_job_hold) {
+            break;
+        }
+
+        /* issue the next instruction in the same tick so that the pages follow each other */
+        if(JOB_ERASE == job->type) {
+            spi_flash_sector_erase_start(job->addr);
+            job->remain = 0U;
+        } else {
+            /* program up to the end of the page */
+            number = SPI_FLASH_PAGE_SIZE - (job->addr % SPI_FLASH_PAGE_SIZE);
+            if(number > job->remain) {
+                number = job->remain;
+            }
+            spi_flash_page_program_start(job->pbuffer, job->addr, (uint16_t)number);
+            job->pbuffer += number;
+            job->addr += number;
+            job->remain -= number;
+        }
+        spi_flash_job_step = SET;
+        break;
+    }
+}
+
+/*!
+    \brief      read the flash status register once
+    \param[in]  none
+    \param[out] none
+    \retval     the value of the status register
+*/
+static uint8_t spi_flash_status_read(void)
+{
+    uint8_t flash_status;
+
+    /* select the flash: chip select low */
+    SPI_FLASH_CS_LOW();
+
+    /* send "read status register" instruction */
+    spi_flash_send_byte(RDSR);
+    flash_status = spi_flash_send_byte(DUMMY_BYTE);
+
+    /* deselect the flash: chip select high */
+    SPI_FLASH_CS_HIGH();
+
+    return flash_status;
+}
+
+/*!
+    \brief      change the SPI1 prescaler
+    \param[in]  prescale: SPI clock prescale factor
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_prescale_set(uint32_t prescale)
+{
+    if(prescale != (SPI_CTL0(SPI1) & SPI_CTL0_PSC)) {
+        /* the prescaler can only be changed while SPI1 is disabled */
+        spi_disable(SPI1);
+        SPI_CTL0(SPI1) = (SPI_CTL0(SPI1) & ~SPI_CTL0_PSC) | prescale;
+        spi_enable(SPI1);
+    }
+}
+
+/*!
+    \brief      start the next DMA block of the current read
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_dma_block_start(void)
+{
+    uint32_t number = spi_flash_dma_remain;
+
+    /* the DMA counter is 16 bits wide, the flash keeps streaming while chip select is low */
+    if(number > SPI_FLASH_DMA_BLOCK_SIZE) {
+        number = SPI_FLASH_DMA_BLOCK_SIZE;
+    }
+
+    dma_channel_disable(SPI_FLASH_DMA_TX_CHANNEL);
+    dma_channel_disable(SPI_FLASH_DMA_RX_CHANNEL);
+    dma_memory_address_config(SPI_FLASH_DMA_RX_CHANNEL, spi_flash_dma_memory);
+    dma_transfer_number_config(SPI_FLASH_DMA_RX_CHANNEL, number);
+    dma_transfer_number_config(SPI_FLASH_DMA_TX_CHANNEL, number);
+
+    spi_flash_dma_remain -= number;
+    spi_flash_dma_memory += number;
+
+    /* the receive channel is armed first so that no byte is lost */
+    dma_channel_enable(SPI_FLASH_DMA_RX_CHANNEL);
+    dma_channel_enable(SPI_FLASH_DMA_TX_CHANNEL);
+}
+
+/*!
+    \brief      finish the current read and restore the SPI for the command phase
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_dma_stop(void)
+{
+    spi_flash_callback callback = spi_flash_dma_done;
+
+    dma_channel_disable(SPI_FLASH_DMA_TX_CHANNEL);
+    dma_channel_disable(SPI_FLASH_DMA_RX_CHANNEL);
+
+    /* the last byte is received, only an aborted read can leave a frame on the bus */
+    while(RESET != (SPI_STAT(SPI1) & SPI_FLAG_TRANS));
+    spi_dma_disable(SPI1, SPI_DMA_TRANSMIT);
+    spi_dma_disable(SPI1, SPI_DMA_RECEIVE);
 
     /* deselect the flash: chip select high */
     SPI_FLASH_CS_HIGH();
+
+    /* drop what an aborted read left in the receive FIFO, spi_flash_send_byte relies on RBNE */
+    while(RESET != (SPI_STAT(SPI1) & SPI_FLAG_RBNE)) {
+        (void)SPI_DATA(SPI1);
+    }
+
+    spi_flash_prescale_set(SPI_FLASH_PSC_COMMAND);
+
+    spi_flash_dma_done = NULL;
+    spi_flash_dma_state = RESET;
+    spi_flash_job_hold = RESET;
+
+    if(NULL != callback) {
+        callback();
+    }
 }
 
 /*!
@@ -302,6 +765,11 @@ uint32_t spi_flash_read_id(void)
 {
     uint32_t temp = 0, temp0 = 0, temp1 = 0, temp2 = 0;
 
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+    /* wait for the running DMA read to release SPI1 */
+    spi_flash_dma_wait();
+
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
 
@@ -333,6 +801,11 @@ uint32_t spi_flash_read_id(void)
 */
 void spi_flash_start_read_sequence(uint32_t read_addr)
 {
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+    /* wait for the running DMA read to release SPI1 */
+    spi_flash_dma_wait();
+
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
 
@@ -408,6 +881,22 @@ uint16_t spi_flash_send_halfword(uint16_t half_word)
     \retval     none
 */
 void spi_flash_write_enable(void)
+{
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+    /* wait for the running DMA read to release SPI1 */
+    spi_flash_dma_wait();
+
+    spi_flash_write_enable_send();
+}
+
+/*!
+    \brief      send the write enable instruction, the bus must be free
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void spi_flash_write_enable_send(void)
 {
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
@@ -429,6 +918,11 @@ void spi_flash_wait_for_write_end(void)
 {
     uint8_t flash_status = 0;
 
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+    /* wait for the running DMA read to release SPI1 */
+    spi_flash_dma_wait();
+
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
 
@@ -453,6 +947,9 @@ void spi_flash_wait_for_write_end(void)
   */
 void spi_quad_flash_quad_enable(void)
 {
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+
     /* enable the write access to the flash */
     spi_flash_write_enable();
     /* select the flash: chip select low */
@@ -542,6 +1039,11 @@ void spi_quad_flash_buffer_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t
   */
 void spi_quad_flash_buffer_read(uint8_t *pbuffer, uint32_t read_addr, uint16_t num_byte_to_read)
 {
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+    /* wait for the running DMA read to release SPI1 */
+    spi_flash_dma_wait();
+
     /* select the flash: chip select low */
     SPI_FLASH_CS_LOW();
     /* send "quad fast read from memory " instruction */
@@ -588,6 +1090,9 @@ void spi_quad_flash_buffer_read(uint8_t *pbuffer, uint32_t read_addr, uint16_t n
   */
 void spi_quad_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write)
 {
+    /* let the queued jobs complete first */
+    spi_flash_job_wait();
+
     /* enable the flash quad mode */
     spi_quad_flash_quad_enable();
     /* enable the write access to the flash */
@@ -41,6 +41,26 @@ OF SUCH DAMAGE.
 #define  SPI_FLASH_CS_LOW()        gpio_bit_reset(GPIOB,GPIO_PIN_11)
 #define  SPI_FLASH_CS_HIGH()       gpio_bit_set(GPIOB,GPIO_PIN_11)
 
+/* SPI1 prescaler used for the command phase and by default for the read phase */
+#define  SPI_FLASH_PSC_COMMAND     SPI_PSC_32
+#define  SPI_FLASH_PSC_READ        SPI_PSC_2
+
+/* DMA channels used for the full-duplex read, the receive channel has the higher priority */
+#define  SPI_FLASH_DMA_RX_CHANNEL  DMA_CH0
+#define  SPI_FLASH_DMA_RX_MUXCH    DMAMUX_MUXCH0
+#define  SPI_FLASH_DMA_RX_IRQn     DMA_Channel0_IRQn
+#define  SPI_FLASH_DMA_TX_CHANNEL  DMA_CH1
+#define  SPI_FLASH_DMA_TX_MUXCH    DMAMUX_MUXCH1
+
+/* maximum number of bytes moved by one DMA block */
+#define  SPI_FLASH_DMA_BLOCK_SIZE  0xFFFFU
+
+/* number of queued program/erase jobs, a power of two */
+#define  SPI_FLASH_JOB_NUM         8U
+
+/* spi flash DMA read and job complete callback */
+typedef void (*spi_flash_callback)(void);
+
 /* initialize SPI1 GPIO and parameter */
 void spi_flash_init(void);
 /* erase the specified flash sector */
@@ -53,6 +73,26 @@ void spi_flash_page_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_by
 void spi_flash_buffer_write(uint8_t *pbuffer, uint32_t write_addr, uint16_t num_byte_to_write);
 /* read a block of data from the flash */
 void spi_flash_buffer_read(uint8_t *pbuffer, uint32_t read_addr, uint16_t num_byte_to_read);
+/* select the SPI1 prescaler used while reading data */
+void spi_flash_read_prescale_config(uint32_t prescale);
+/* read a block of data from the flash using fast read and DMA */
+void spi_flash_dma_read(uint8_t *pbuffer, uint32_t read_addr, uint32_t num_byte_to_read, spi_flash_callback callback);
+/* get the flash DMA read state */
+FlagStatus spi_flash_dma_busy(void);
+/* wait for the flash DMA read to complete */
+void spi_flash_dma_wait(void);
+/* flash DMA receive channel interrupt service */
+void spi_flash_dma_irq_handler(void);
+/* queue a write of a block of data to the flash */
+ErrStatus spi_flash_submit_write(uint8_t *pbuffer, uint32_t write_addr, uint32_t num_byte_to_write, spi_flash_callback callback);
+/* queue an erase of the specified flash sector */
+ErrStatus spi_flash_submit_erase(uint32_t sector_addr, spi_flash_callback callback);
+/* get the number of jobs in the queue */
+uint8_t spi_flash_job_count(void);
+/* wait for all the queued jobs to complete */
+void spi_flash_job_wait(void);
+/* advance the queued jobs, call it from a periodic interrupt */
+void spi_flash_job_poll(void);
 /* read flash identification */
 uint32_t spi_flash_read_id(void);
 /* start a read data byte (read) sequence from the flash */
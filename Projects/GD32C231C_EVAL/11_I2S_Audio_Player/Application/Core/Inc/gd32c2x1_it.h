@@ -48,5 +48,7 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 /* this function handles SPI0 exception */
 void SPI0_IRQHandler(void);
+/* this function handles DMA_Channel2_IRQHandler interrupt */
+void DMA_Channel2_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
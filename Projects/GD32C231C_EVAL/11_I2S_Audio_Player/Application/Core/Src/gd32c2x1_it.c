@@ -34,6 +34,9 @@ OF SUCH DAMAGE.
 
 #include "gd32c2x1_it.h"
 #include "i2s_codec.h"
+#ifdef WAVE_SOURCE_USART
+#include "usart_dma_rx.h"
+#endif /* WAVE_SOURCE_USART */
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -108,3 +111,38 @@ void SPI0_IRQHandler(void)
         /* send data */
         i2s_audio_data_send();
 }
+
+/*!
+    \brief      this function handles DMA_Channel2_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel2_IRQHandler(void)
+{
+    i2s_audio_dma_irq_handler();
+}
+
+#ifdef WAVE_SOURCE_USART
+/*!
+    \brief      this function handles DMA_Channel1_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel1_IRQHandler(void)
+{
+    usart_dma_rx_dma_irq_handler();
+}
+
+/*!
+    \brief      this function handles USART0 exception
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void USART0_IRQHandler(void)
+{
+    usart_dma_rx_irq_handler();
+}
+#endif /* WAVE_SOURCE_USART */
@@ -35,6 +35,17 @@ OF SUCH DAMAGE.
 #include "gd32c2x1.h"
 #include "gd32c231c_eval.h"
 #include "i2s_codec.h"
+#include "wave_data.h"
+
+#ifdef WAVE_SOURCE_USART
+/* the audio file received on the COM port, the playback starts once half of it is full */
+#define AUDIO_RING_SIZE     4096U
+
+static uint8_t audio_ring[AUDIO_RING_SIZE];
+#endif /* WAVE_SOURCE_USART */
+
+/* audio file of the internal flash or the COM port */
+static wave_source_struct audio_source;
 
 /*!
     \brief      main function
@@ -49,7 +60,16 @@ int main(void)
     /* configure TIMER */
     timer_config();
     /* play audio file */
-    i2s_audio_play();
+#ifdef WAVE_SOURCE_USART
+    gd_eval_com_init(EVAL_COM);
+    wave_source_usart_init(&audio_source, audio_ring, AUDIO_RING_SIZE, EVAL_COM);
+    /* the wave header must be in the ring before the playback starts */
+    while(audio_source.ring_head < (AUDIO_RING_SIZE / 2U)) {
+    }
+#else
+    wave_source_flash_init(&audio_source, (const uint8_t *)wavetestdata, sizeof(wavetestdata));
+#endif /* WAVE_SOURCE_USART */
+    i2s_audio_play(&audio_source);
 
     while (1){ 
     }
@@ -0,0 +1,220 @@
+/*!
+    \file  audio_convert.c
+    \brief audio sample conversion stage: sample width, digital volume and linear
+           resampling, written for the Cortex-M23 which has no DSP or FPU instructions
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice, 
+       this list of conditions and the following disclaimer in the documentation 
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors 
+       may be used to endorse or promote products derived from this software without 
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "audio_convert.h"
+
+static int16_t audio_convert_gain(const audio_convert_struct *convert, int32_t sample);
+static ErrStatus audio_convert_frame_next(audio_convert_struct *convert);
+
+/*!
+    \brief      initialize a conversion
+    \param[in]  convert: conversion to initialize
+    \param[in]  channels: channels of the input, 1 or 2
+    \param[in]  bits: bits per input sample, 8, 16, 24 or 32
+    \param[in]  input_rate: sample rate of the input
+    \param[in]  output_rate: sample rate of the I2S
+    \param[out] none
+    \retval     none
+*/
+void audio_convert_init(audio_convert_struct *convert, uint8_t channels, uint8_t bits,
+                        uint32_t input_rate, uint32_t output_rate)
+{
+    memset(convert, 0, sizeof(audio_convert_struct));
+    convert->channels = channels;
+    convert->bytes = bits / 8U;
+    convert->gain = AUDIO_GAIN_UNITY;
+    convert->step = (uint32_t)(((uint64_t)input_rate << 16) / output_rate);
+    /* two input frames are taken before the first output frame, which is the first input frame */
+    convert->phase = 2U * AUDIO_STEP_UNITY;
+}
+
+/*!
+    \brief      set the digital volume
+    \param[in]  convert: conversion
+    \param[in]  gain: gain in Q12, AUDIO_GAIN_UNITY for 1.0, the output saturates
+    \param[out] none
+    \retval     none
+*/
+void audio_convert_gain_set(audio_convert_struct *convert, uint16_t gain)
+{
+    convert->gain = gain;
+}
+
+/*!
+    \brief      get the raw input block, up to AUDIO_CONVERT_FRAME_NUM frames of the input
+                format are read to it and then loaded by audio_convert_block_load()
+    \param[in]  convert: conversion
+    \param[out] none
+    \retval     raw input block
+*/
+uint8_t *audio_convert_block_get(audio_convert_struct *convert)
+{
+    return (uint8_t *)convert->block;
+}
+
+/*!
+    \brief      convert the raw frames of the block to 16-bit samples in place, 8-bit
+                samples are unsigned and widened, wider samples keep their upper 16 bits
+    \param[in]  convert: conversion
+    \param[in]  frames: frames read to the block
+    \param[out] none
+    \retval     none
+*/
+void audio_convert_block_load(audio_convert_struct *convert, uint32_t frames)
+{
+    const uint8_t *raw = (const uint8_t *)convert->block;
+    int16_t *pcm = (int16_t *)convert->block;
+    uint32_t number = frames * convert->channels;
+    uint32_t index;
+
+    switch(convert->bytes) {
+    case 1:
+        /* the samples grow, convert from the end */
+        for(index = number; index != 0U; index--) {
+            pcm[index - 1U] = (int16_t)(((int32_t)raw[index - 1U] - 128) << 8);
+        }
+        break;
+    case 3:
+        for(index = 0U; index < number; index++) {
+            pcm[index] = (int16_t)(raw[1] | ((uint16_t)raw[2] << 8));
+            raw += 3;
+        }
+        break;
+    case 4:
+        for(index = 0U; index < number; index++) {
+            pcm[index] = (int16_t)(raw[2] | ((uint16_t)raw[3] << 8));
+            raw += 4;
+        }
+        break;
+    default:
+        /* little endian 16-bit samples are used as they are */
+        break;
+    }
+
+    convert->index = 0U;
+    convert->number = (uint16_t)frames;
+}
+
+/*!
+    \brief      produce stereo output frames from the block by linear interpolation
+                between the input frames, a mono frame is sent to both channels
+    \param[in]  convert: conversion
+    \param[in]  frames: output frames wanted
+    \param[out] buffer: interleaved left and right samples
+    \retval     number of output frames, less than frames when the block is used up
+*/
+uint32_t audio_convert_run(audio_convert_struct *convert, uint16_t *buffer, uint32_t frames)
+{
+    uint32_t done = 0U;
+    uint32_t phase = convert->phase;
+    int32_t fraction;
+    int32_t left, right;
+
+    while(done < frames) {
+        /* move to the input frames around the output position */
+        while(phase >= AUDIO_STEP_UNITY) {
+            if(SUCCESS != audio_convert_frame_next(convert)) {
+                convert->phase = phase;
+                return done;
+            }
+            phase -= AUDIO_STEP_UNITY;
+        }
+
+        /* Q15 fraction, the 17-bit difference times it fits 32 bits */
+        fraction = (int32_t)(phase >> 1);
+        left = convert->previous[0] + ((((int32_t)convert->next[0] - convert->previous[0]) * fraction) >> 15);
+        right = convert->previous[1] + ((((int32_t)convert->next[1] - convert->previous[1]) * fraction) >> 15);
+
+        *buffer++ = (uint16_t)audio_convert_gain(convert, left);
+        *buffer++ = (uint16_t)audio_convert_gain(convert, right);
+        phase += convert->step;
+        done++;
+    }
+
+    convert->phase = phase;
+    return done;
+}
+
+/*!
+    \brief      apply the digital volume to a sample
+    \param[in]  convert: conversion
+    \param[in]  sample: 16-bit sample
+    \param[out] none
+    \retval     sample saturated to 16 bits
+*/
+static int16_t audio_convert_gain(const audio_convert_struct *convert, int32_t sample)
+{
+    if(AUDIO_GAIN_UNITY == convert->gain) {
+        return (int16_t)sample;
+    }
+    sample = (sample * convert->gain) >> 12;
+    if(sample > 32767) {
+        sample = 32767;
+    } else if(sample < -32768) {
+        sample = -32768;
+    }
+    return (int16_t)sample;
+}
+
+/*!
+    \brief      take the next input frame of the block
+    \param[in]  convert: conversion
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the block is used up
+*/
+static ErrStatus audio_convert_frame_next(audio_convert_struct *convert)
+{
+    const int16_t *pcm = (const int16_t *)convert->block;
+
+    if(convert->index >= convert->number) {
+        return ERROR;
+    }
+
+    convert->previous[0] = convert->next[0];
+    convert->previous[1] = convert->next[1];
+    if(1U == convert->channels) {
+        convert->next[0] = pcm[convert->index];
+        convert->next[1] = convert->next[0];
+    } else {
+        convert->next[0] = pcm[2U * convert->index];
+        convert->next[1] = pcm[2U * convert->index + 1U];
+    }
+    convert->index++;
+
+    return SUCCESS;
+}
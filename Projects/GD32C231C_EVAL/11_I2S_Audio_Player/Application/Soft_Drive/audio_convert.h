@@ -0,0 +1,76 @@
+/*!
+    \file  audio_convert.h
+    \brief the header file of the audio sample conversion stage
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice, 
+       this list of conditions and the following disclaimer in the documentation 
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors 
+       may be used to endorse or promote products derived from this software without 
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+OF SUCH DAMAGE.
+*/
+
+#ifndef AUDIO_CONVERT_H
+#define AUDIO_CONVERT_H
+
+#include "gd32c2x1.h"
+
+/* input frames converted in one block */
+#define AUDIO_CONVERT_FRAME_NUM     64U
+/* gain of the digital volume, Q12 */
+#define AUDIO_GAIN_UNITY            4096U
+/* input frames per output frame, Q16 */
+#define AUDIO_STEP_UNITY            0x10000U
+
+/* conversion of the audio file samples to 16-bit stereo at the I2S rate */
+typedef struct {
+    uint8_t channels;                           /* channels of the input, 1 or 2 */
+    uint8_t bytes;                              /* bytes per input sample, 1 to 4 */
+    uint16_t gain;                              /* digital volume, AUDIO_GAIN_UNITY for 1.0 */
+    uint32_t step;                              /* input frames per output frame, Q16 */
+    uint32_t phase;                             /* output position after the previous frame, Q16 */
+    int16_t previous[2];                        /* input frame before the output position */
+    int16_t next[2];                            /* input frame after the output position */
+    uint16_t index;                             /* next frame of the block */
+    uint16_t number;                            /* frames in the block */
+    uint32_t block[AUDIO_CONVERT_FRAME_NUM * 2U];  /* raw input frames, converted in place to 16-bit */
+} audio_convert_struct;
+
+/* function declarations */
+/* initialize a conversion */
+void audio_convert_init(audio_convert_struct *convert, uint8_t channels, uint8_t bits,
+                        uint32_t input_rate, uint32_t output_rate);
+/* set the digital volume */
+void audio_convert_gain_set(audio_convert_struct *convert, uint16_t gain);
+/* raw input block to be filled with up to AUDIO_CONVERT_FRAME_NUM frames */
+uint8_t *audio_convert_block_get(audio_convert_struct *convert);
+/* convert the raw frames of the block to 16-bit */
+void audio_convert_block_load(audio_convert_struct *convert, uint32_t frames);
+/* produce stereo output frames from the block */
+uint32_t audio_convert_run(audio_convert_struct *convert, uint16_t *buffer, uint32_t frames);
+
+#endif /* AUDIO_CONVERT_H */
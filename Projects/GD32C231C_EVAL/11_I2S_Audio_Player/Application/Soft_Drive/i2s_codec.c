@@ -35,117 +35,150 @@ OF SUCH DAMAGE.
 */
 
 #include <stdio.h>
-#include "wave_data.h"
 #include "i2s_codec.h"
 
 wave_file_struct wave_struct;
-uint16_t i2saudiofreq = 0;
-__IO uint8_t headertab_index = 0;
+uint32_t i2saudiofreq = 0;
+/* offsets of the data chunk and of its end in the audio file */
 uint32_t datastartaddr = 0;
-__IO uint32_t audiodataindex = 0;
+uint32_t dataendaddr = 0;
+
+/* audio file being played */
+static wave_source_struct *wave_source = NULL;
+/* conversion to 16-bit stereo at i2saudiofreq, skipped if the audio file is already in this format */
+static audio_convert_struct audio_convert;
+static __IO uint8_t audio_convert_enable = 0;
+
+#ifdef I2S_AUDIO_DMA
+/* circular DMA buffer of interleaved left and right samples */
+static uint16_t i2s_audio_buffer[I2S_BUFFER_SIZE];
+#endif /* I2S_AUDIO_DMA */
+static void i2s_audio_convert_fill(uint16_t *buffer, uint32_t number);
+#ifdef I2S_AUDIO_DMA
+static void i2s_dma_config(void);
+#endif /* I2S_AUDIO_DMA */
 
 /*!
     \brief      read uint data according to endianness
-    \param[in]  nbrofbytes: number of read bytes
+    \param[in]  buffer: bytes of the data
+    \param[in]  nbrofbytes: number of read bytes, up to 4
     \param[in]  bytesformat: littleendian or bigendian
     \param[out] none
     \retval     the uint data
 */
-uint32_t read_unit(uint8_t nbrofbytes, endianness_enum bytesformat)
+uint32_t read_unit(const uint8_t *buffer, uint8_t nbrofbytes, endianness_enum bytesformat)
 {
     uint32_t index = 0;
     uint32_t temp = 0;
     if(littleendian == bytesformat) {
         for(index = 0; index < nbrofbytes; index++) {
-            temp |= AUDIOFILEADDRESS[headertab_index++] << (index * 8);
+            temp |= (uint32_t)buffer[index] << (index * 8);
         }
     } else {
-        for(index = nbrofbytes; index != 0; index--) {
-            temp |= AUDIOFILEADDRESS[headertab_index++] << ((index - 1) * 8);
+        for(index = 0; index < nbrofbytes; index++) {
+            temp = (temp << 8) | buffer[index];
         }
     }
     return temp;
 }
 
 /*!
-    \brief      wave audio file parsing function
+    \brief      wave audio file parsing function, walks the RIFF chunks up to the data
+                chunk, the chunks other than 'fmt ' and 'data' are skipped
     \param[in]  none
     \param[out] none
     \retval     errorcode_enum
 */
 errorcode_enum codec_wave_parsing(void)
 {
-    uint32_t temp = 0;
-    uint32_t extraformatbytes = 0;
-    /* initialize the headertab index variable */
-    headertab_index = 0;
+    uint8_t header[FORMATCHUNKSIZE];
+    uint32_t chunkid = 0;
+    uint32_t chunksize = 0;
+    uint32_t riffend = 0;
+    uint32_t nextchunk = 0;
+    uint8_t formatfound = 0;
+
     /* read chunkid, must be 'riff' */
-    if(CHUNKID != read_unit(4, bigendian)) {
+    if((SUCCESS != wave_source_seek(wave_source, 0)) || (12 != wave_source_read(wave_source, header, 12))) {
+        return(UNVALID_RIFF_ID);
+    }
+    if(CHUNKID != read_unit(&header[0], 4, bigendian)) {
         return(UNVALID_RIFF_ID);
     }
     /* read the file length */
-    wave_struct.riffchunksize = read_unit(4, littleendian);
+    wave_struct.riffchunksize = read_unit(&header[4], 4, littleendian);
     /* read the file format, must be 'wave' */
-    if(FILEFORMAT != read_unit(4, bigendian)) {
+    if(FILEFORMAT != read_unit(&header[8], 4, bigendian)) {
         return(UNVALID_WAVE_FORMAT);
     }
-    /* read the format chunk, must be 'fmt' */
-    if(FORMATID != read_unit(4, bigendian)) {
-        return(UNVALID_FORMATCHUNK_ID);
-    }
-    /* read the size of the 'fmt' data, must be 0x10 */
-    if(FORMATCHUNKSIZE != read_unit(4, littleendian)) {
-        extraformatbytes = 1;
-    }
-    /* read the audio format, must be 0x01 (pcm) */
-    wave_struct.formattag = read_unit(2, littleendian);
-    if(WAVE_FORMAT_PCM != wave_struct.formattag) {
-        return(UNSUPPORETD_FORMATTAG);
-    }
-    /* read the number of channels: 0x02->stereo 0x01->mono */
-    wave_struct.numchannels = read_unit(2, littleendian);
-    /* read the sample rate */
-    wave_struct.samplerate = read_unit(4, littleendian);
-    /* update the i2s_audiofreq value according to the .wav file sample rate */
-    if((wave_struct.samplerate < 8000) || (wave_struct.samplerate > 192000)) {
-        return(UNSUPPORETD_SAMPLE_RATE);
-    } else {
-        i2saudiofreq = wave_struct.samplerate;
-    }
-    /* read the byte rate */
-    wave_struct.byterate = read_unit(4, littleendian);
-    /* read the block alignment */
-    wave_struct.blockalign = read_unit(2, littleendian);
-    /* read the number of bits per sample */
-    wave_struct.bitspersample = read_unit(2, littleendian);
-    if(BITS_PER_SAMPLE_16 != wave_struct.bitspersample) {
-        return(UNSUPPORETD_BITS_PER_SAMPLE);
-    }
-    /* if there are extra format bytes, these bytes will be defined in "fact chunk" */
-    if(1 == extraformatbytes) {
-        /* read th extra format bytes, must be 0x00 */
-        if(0x00 != read_unit(2, littleendian)) {
-            return(UNSUPPORETD_EXTRAFORMATBYTES);
+    riffend = (wave_struct.riffchunksize > (0xFFFFFFFFU - 8U)) ? 0xFFFFFFFFU : (wave_struct.riffchunksize + 8U);
+
+    while(wave_source->position < riffend) {
+        /* read the chunk id and size */
+        if(8 != wave_source_read(wave_source, header, 8)) {
+            break;
         }
-        /* read the fact chunk, must be 'fact' */
-        if(FACTID != read_unit(4, bigendian)) {
-            return(UNVALID_FACTCHUNK_ID);
+        chunkid = read_unit(&header[0], 4, bigendian);
+        chunksize = read_unit(&header[4], 4, littleendian);
+
+        if(DATAID == chunkid) {
+            if(0 == formatfound) {
+                return(UNVALID_FORMATCHUNK_ID);
+            }
+            /* set the data pointer at the beginning of the effective audio data */
+            wave_struct.datasize = chunksize;
+            datastartaddr = wave_source->position;
+            return(VALID_WAVE_FILE);
+        }
+
+        /* the chunks are padded to an even size */
+        if(chunksize > (0xFFFFFFFFU - 1U - wave_source->position)) {
+            break;
+        }
+        nextchunk = wave_source->position + chunksize + (chunksize & 1U);
+
+        if(FORMATID == chunkid) {
+            /* read the 16 bytes of the pcm format, the extra format bytes are skipped */
+            if((FORMATCHUNKSIZE > chunksize) ||
+                    (FORMATCHUNKSIZE != wave_source_read(wave_source, header, FORMATCHUNKSIZE))) {
+                return(UNVALID_FORMATCHUNK_ID);
+            }
+            /* read the audio format, must be 0x01 (pcm) */
+            wave_struct.formattag = read_unit(&header[0], 2, littleendian);
+            if(WAVE_FORMAT_PCM != wave_struct.formattag) {
+                return(UNSUPPORETD_FORMATTAG);
+            }
+            /* read the number of channels: 0x02->stereo 0x01->mono */
+            wave_struct.numchannels = read_unit(&header[2], 2, littleendian);
+            if((CHANNEL_MONO != wave_struct.numchannels) && (CHANNEL_STEREO != wave_struct.numchannels)) {
+                return(UNSUPPORETD_NUMBER_OF_CHANNEL);
+            }
+            /* read the sample rate */
+            wave_struct.samplerate = read_unit(&header[4], 4, littleendian);
+            if((wave_struct.samplerate < 8000) || (wave_struct.samplerate > 192000)) {
+                return(UNSUPPORETD_SAMPLE_RATE);
+            }
+            /* read the byte rate */
+            wave_struct.byterate = read_unit(&header[8], 4, littleendian);
+            /* read the block alignment */
+            wave_struct.blockalign = read_unit(&header[12], 2, littleendian);
+            /* read the number of bits per sample */
+            wave_struct.bitspersample = read_unit(&header[14], 2, littleendian);
+            if((BITS_PER_SAMPLE_8 != wave_struct.bitspersample) && (BITS_PER_SAMPLE_16 != wave_struct.bitspersample) &&
+                    (BITS_PER_SAMPLE_24 != wave_struct.bitspersample) && (BITS_PER_SAMPLE_32 != wave_struct.bitspersample)) {
+                return(UNSUPPORETD_BITS_PER_SAMPLE);
+            }
+            formatfound = 1;
+        }
+
+        /* skip the rest of the chunk, e.g. 'LIST' or 'fact' */
+        if(SUCCESS != wave_source_seek(wave_source, nextchunk)) {
+            break;
         }
-        /* read fact chunk data size */
-        temp = read_unit(4, littleendian);
-        /* set the index to start reading just after the header end */
-        headertab_index += temp;
-    }
-    /* read the data chunk, must be 'data' */
-    if(DATAID != read_unit(4, bigendian)) {
-        return(UNVALID_DATACHUNK_ID);
     }
-    /* read the number of sample data */
-    wave_struct.datasize = read_unit(4, littleendian);
-    /* set the data pointer at the beginning of the effective audio data */
-    datastartaddr += headertab_index;
 
-    return(VALID_WAVE_FILE);
+    /* no data chunk found */
+    return((0 == formatfound) ? UNVALID_FORMATCHUNK_ID : UNVALID_DATACHUNK_ID);
 }
 
 /*!
@@ -235,59 +268,246 @@ void timer_config(void)
 */
 void i2s_audio_data_send(void)
 {
-    /* send the data read from the memory */
-    spi_i2s_data_transmit(SPI0, read_half_word(audiodataindex + datastartaddr));
-    /* increment the index */
-    audiodataindex += (uint32_t)wave_struct.numchannels ;
+    static uint16_t frame[2];
+    static uint8_t frameindex = 2;
+
+    /* read the left and right samples of the next frame */
+    if(2 <= frameindex) {
+        i2s_audio_buffer_fill(frame, 2);
+        frameindex = 0;
+    }
+    /* send the data read from the audio file */
+    spi_i2s_data_transmit(SPI0, frame[frameindex++]);
 }
 
 /*!
     \brief      I2S audio play
-    \param[in]  none
+    \param[in]  source: audio file to play, must stay valid while it is played
     \param[out] none
     \retval     errorcode_enum
 */
-errorcode_enum i2s_audio_play(void)
+errorcode_enum i2s_audio_play(wave_source_struct *source)
 {
     errorcode_enum errorcode = UNVALID_RIFF_ID;
+
+    wave_source = source;
     /* read the audio file to extract the audio frequency */
     errorcode = codec_wave_parsing();
     if(VALID_WAVE_FILE == errorcode) {
+        /* play the data chunk, but not beyond the end of the audio file */
+        dataendaddr = datastartaddr + wave_struct.datasize;
+        if((dataendaddr < datastartaddr) || (dataendaddr > source->size)) {
+            dataendaddr = source->size;
+        }
+        /* the RAM ring source gives whole frames */
+        source->frame_size = (uint8_t)(wave_struct.numchannels * (wave_struct.bitspersample / 8U));
+
+        /* update the i2s_audiofreq value according to the .wav file sample rate */
+        i2saudiofreq = (0U != I2S_OUTPUT_FREQ) ? I2S_OUTPUT_FREQ : wave_struct.samplerate;
+        audio_convert_init(&audio_convert, (uint8_t)wave_struct.numchannels, (uint8_t)wave_struct.bitspersample,
+                           wave_struct.samplerate, i2saudiofreq);
+        /* 16-bit samples at the I2S rate are read directly */
+        audio_convert_enable = (BITS_PER_SAMPLE_16 != wave_struct.bitspersample) ||
+                               (wave_struct.samplerate != i2saudiofreq);
         i2s_config();
+#ifdef I2S_AUDIO_DMA
+        /* send the samples by DMA, the buffer halves are refilled in the DMA interrupt */
+        i2s_dma_config();
+#else
         /* enable the I2S0 TBE interrupt */
         spi_i2s_interrupt_enable(SPI0, SPI_I2S_INT_TBE);
+#endif /* I2S_AUDIO_DMA */
     }
     return errorcode;
 }
 
 /*!
-    \brief      read half word
-    \param[in]  offset : audio data index
+    \brief      fill a buffer with the next stereo samples of the audio file, a mono sample
+                is sent to both channels and the audio file is played in a loop, the
+                samples missing at the end of a stream are filled with silence
+    \param[in]  number: number of half words to fill, even
+    \param[out] buffer: interleaved left and right samples
+    \retval     none
+*/
+void i2s_audio_buffer_fill(uint16_t *buffer, uint32_t number)
+{
+    uint32_t count, index;
+    uint16_t *samples;
+
+    if(0U != audio_convert_enable) {
+        i2s_audio_convert_fill(buffer, number);
+        return;
+    }
+
+    while(0U != number) {
+        if((wave_source->position + 2U) > dataendaddr) {
+            /* loop to the first sample, a stream can't go back */
+            if(SUCCESS != wave_source_seek(wave_source, datastartaddr)) {
+                break;
+            }
+        }
+        /* samples to read in this pass */
+        count = (CHANNEL_MONO == wave_struct.numchannels) ? (number / 2U) : number;
+        if(count > ((dataendaddr - wave_source->position) / 2U)) {
+            count = (dataendaddr - wave_source->position) / 2U;
+        }
+        if(0U == count) {
+            break;
+        }
+
+        if(CHANNEL_MONO == wave_struct.numchannels) {
+            /* read the mono samples to the end of their stereo room and expand them forwards,
+               a sample is always read before its place is written */
+            samples = buffer + count;
+            count = wave_source_read(wave_source, (uint8_t *)samples, 2U * count) / 2U;
+            for(index = 0U; index < count; index++) {
+                buffer[2U * index] = samples[index];
+                buffer[2U * index + 1U] = samples[index];
+            }
+            buffer += 2U * count;
+            number -= 2U * count;
+        } else {
+            count = wave_source_read(wave_source, (uint8_t *)buffer, 2U * count) / 2U;
+            buffer += count;
+            number -= count;
+        }
+
+        /* the RAM ring ran empty */
+        if(0U == count) {
+            break;
+        }
+    }
+
+    /* silence */
+    while(number--) {
+        *buffer++ = 0U;
+    }
+}
+
+/*!
+    \brief      set the digital volume, the samples then always go through the conversion
+    \param[in]  gain: gain in Q12, AUDIO_GAIN_UNITY for 1.0
+    \param[out] none
+    \retval     none
+*/
+void i2s_audio_volume_set(uint16_t gain)
+{
+    audio_convert_gain_set(&audio_convert, gain);
+    if(AUDIO_GAIN_UNITY != gain) {
+        audio_convert_enable = 1;
+    }
+}
+
+/*!
+    \brief      I2S DMA interrupt service, refill the half of the buffer which was just sent
+    \param[in]  none
     \param[out] none
-    \retval     audio data
+    \retval     none
 */
-uint16_t read_half_word(uint32_t offset)
+void i2s_audio_dma_irq_handler(void)
 {
-    static  uint32_t monovar = 0, tmpvar = 0;
-    if((AUDIOFILEADDRESS + offset) >= AUDIOFILEADDRESSEND) {
-        audiodataindex = 0;
+#ifdef I2S_AUDIO_DMA
+    if(RESET != dma_interrupt_flag_get(I2S_DMA_CHANNEL, DMA_INT_FLAG_HTF)) {
+        dma_interrupt_flag_clear(I2S_DMA_CHANNEL, DMA_INT_FLAG_HTF);
+        /* the DMA sends the second half */
+        i2s_audio_buffer_fill(&i2s_audio_buffer[0], I2S_BUFFER_SIZE / 2U);
     }
-    /* test if the left channel is to be sent */
-    if(0 == monovar) {
-        tmpvar = (*(__IO uint16_t *)(AUDIOFILEADDRESS + offset));
-        /* increment the mono variable only if the file is in mono format */
-        if(CHANNEL_MONO == wave_struct.numchannels)
-            /* increment the monovar variable */
-        {
-            monovar++;
+    if(RESET != dma_interrupt_flag_get(I2S_DMA_CHANNEL, DMA_INT_FLAG_FTF)) {
+        dma_interrupt_flag_clear(I2S_DMA_CHANNEL, DMA_INT_FLAG_FTF);
+        /* the DMA wrapped to the first half */
+        i2s_audio_buffer_fill(&i2s_audio_buffer[I2S_BUFFER_SIZE / 2U], I2S_BUFFER_SIZE / 2U);
+    }
+#endif /* I2S_AUDIO_DMA */
+}
+
+/*!
+    \brief      fill a buffer with stereo samples converted from blocks of the audio file
+    \param[in]  number: number of half words to fill, even
+    \param[out] buffer: interleaved left and right samples
+    \retval     none
+*/
+static void i2s_audio_convert_fill(uint16_t *buffer, uint32_t number)
+{
+    uint32_t frames = number / 2U;
+    uint32_t framesize = wave_source->frame_size;
+    uint32_t count;
+
+    while(0U != frames) {
+        count = audio_convert_run(&audio_convert, buffer, frames);
+        buffer += 2U * count;
+        frames -= count;
+        if(0U == frames) {
+            break;
         }
-        /* return the read value */
-        return tmpvar;
-        /* right channel to be sent in mono format */
-    } else {
-        /* reset the monovar variable */
-        monovar = 0;
-        /* return the previous read data in mono format */
-        return tmpvar;
+
+        /* the block is used up, read the next one */
+        if((wave_source->position + framesize) > dataendaddr) {
+            /* loop to the first frame, a stream can't go back */
+            if(SUCCESS != wave_source_seek(wave_source, datastartaddr)) {
+                break;
+            }
+        }
+        count = (dataendaddr - wave_source->position) / framesize;
+        if(count > AUDIO_CONVERT_FRAME_NUM) {
+            count = AUDIO_CONVERT_FRAME_NUM;
+        }
+        count = wave_source_read(wave_source, audio_convert_block_get(&audio_convert), count * framesize) / framesize;
+        /* no whole frame in the audio file or the RAM ring ran empty */
+        if(0U == count) {
+            break;
+        }
+        audio_convert_block_load(&audio_convert, count);
     }
+
+    /* silence */
+    frames *= 2U;
+    while(frames--) {
+        *buffer++ = 0U;
+    }
+}
+
+#ifdef I2S_AUDIO_DMA
+/*!
+    \brief      fill the buffer and start the circular DMA which streams it to I2S0
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void i2s_dma_config(void)
+{
+    dma_parameter_struct dma_init_struct;
+
+    /* enable DMA clock */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    i2s_audio_buffer_fill(i2s_audio_buffer, I2S_BUFFER_SIZE);
+
+    /* initialize DMA channel */
+    dma_deinit(I2S_DMA_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = DMA_REQUEST_SPI0_TX;
+    dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)i2s_audio_buffer;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_16BIT;
+    dma_init_struct.number       = I2S_BUFFER_SIZE;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&SPI_DATA(SPI0);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_16BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_HIGH;
+    dma_init(I2S_DMA_CHANNEL, &dma_init_struct);
+
+    /* configure DMA mode */
+    dma_circulation_enable(I2S_DMA_CHANNEL);
+    dma_memory_to_memory_disable(I2S_DMA_CHANNEL);
+    dmamux_synchronization_disable(I2S_DMA_MUXCH);
+
+    /* enable DMA half and full transfer finish interrupt */
+    dma_interrupt_enable(I2S_DMA_CHANNEL, DMA_INT_HTF | DMA_INT_FTF);
+    nvic_irq_enable(I2S_DMA_IRQn, 1);
+
+    dma_channel_enable(I2S_DMA_CHANNEL);
+    spi_dma_enable(SPI0, SPI_DMA_TRANSMIT);
 }
+#endif /* I2S_AUDIO_DMA */
@@ -64,6 +64,8 @@ OF SUCH DAMAGE.
 */
 
 #include "gd32c2x1.h"
+#include "wave_source.h"
+#include "audio_convert.h"
 
 /* extern audio file */
 extern const char wavetestdata[];
@@ -83,12 +85,21 @@ extern const char wavetestdata[];
 #define CHANNEL_STEREO      0x02        /* stereo channel */
 #define BITS_PER_SAMPLE_8   8           /* 8 bits per sample */
 #define BITS_PER_SAMPLE_16  16          /* 16 bits per sample */
-/* audio start address and end address constants */
-#define AUDIOFILEADDRESS       (uint32_t)wavetestdata                                /* audio start address */
-#define AUDIOFILEADDRESSEND    (uint32_t)(wavetestdata + (COUNTOF(wavetestdata)))    /* audio end address */
+#define BITS_PER_SAMPLE_24  24          /* 24 bits per sample */
+#define BITS_PER_SAMPLE_32  32          /* 32 bits per sample */
 /* I2S configuration parameters */
 #define I2S_STANDARD                  I2S_STD_MSB         /* I2S MSB standard */
 #define I2S_MCLKOUTPUT                I2S_MCKOUT_ENABLE   /* mck output enable */
+/* I2S sample rate, the audio file is resampled to it, 0 to use the rate of the audio file */
+#define I2S_OUTPUT_FREQ               0U
+/* comment this line to send the samples by the SPI0 TBE interrupt */
+#define I2S_AUDIO_DMA
+/* DMA channel streaming the samples to I2S0 */
+#define I2S_DMA_CHANNEL               DMA_CH2
+#define I2S_DMA_MUXCH                 DMAMUX_MUXCH2
+#define I2S_DMA_IRQn                  DMA_Channel2_IRQn
+/* half words of the circular DMA buffer, a half is refilled while the other one is sent */
+#define I2S_BUFFER_SIZE               512U
 
 /* audio file information structure */
 typedef struct
@@ -129,7 +140,7 @@ typedef enum
 /* function declarations */
 
 /* read uint data according to endianness */
-uint32_t read_unit(uint8_t nbrofbytes, endianness_enum bytesformat);
+uint32_t read_unit(const uint8_t *buffer, uint8_t nbrofbytes, endianness_enum bytesformat);
 /* wave audio file parsing function */
 errorcode_enum codec_wave_parsing(void);
 /* configure I2S GPIO and parameters */
@@ -139,8 +150,12 @@ void timer_config(void);
 /* send audio data */
 void i2s_audio_data_send(void);
 /* start audio paly */
-errorcode_enum i2s_audio_play(void);
-/* read half word */
-uint16_t read_half_word(uint32_t offset);
+errorcode_enum i2s_audio_play(wave_source_struct *source);
+/* set the digital volume */
+void i2s_audio_volume_set(uint16_t gain);
+/* fill a buffer with the next stereo samples */
+void i2s_audio_buffer_fill(uint16_t *buffer, uint32_t number);
+/* I2S DMA interrupt service */
+void i2s_audio_dma_irq_handler(void);
 
 #endif /* I2S_CODEC_H */
@@ -0,0 +1,330 @@
+/*!
+    \file  wave_source.c
+    \brief wave audio stream sources: internal flash, SPI flash and RAM ring buffer
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice, 
+       this list of conditions and the following disclaimer in the documentation 
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors 
+       may be used to endorse or promote products derived from this software without 
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "wave_source.h"
+#ifdef WAVE_SOURCE_SPI_FLASH
+#include "gd25qxx.h"
+#endif /* WAVE_SOURCE_SPI_FLASH */
+#ifdef WAVE_SOURCE_USART
+#include "usart_dma_rx.h"
+#endif /* WAVE_SOURCE_USART */
+
+#define WAVE_SOURCE_SIZE_UNKNOWN    0xFFFFFFFFU
+
+static uint32_t flash_read(wave_source_struct *source, uint8_t *buffer, uint32_t number);
+static ErrStatus flash_seek(wave_source_struct *source, uint32_t offset);
+#ifdef WAVE_SOURCE_SPI_FLASH
+static uint32_t spi_flash_source_read(wave_source_struct *source, uint8_t *buffer, uint32_t number);
+#endif /* WAVE_SOURCE_SPI_FLASH */
+static uint32_t ring_read(wave_source_struct *source, uint8_t *buffer, uint32_t number);
+static ErrStatus ring_seek(wave_source_struct *source, uint32_t offset);
+#ifdef WAVE_SOURCE_USART
+static void usart_source_receive(const uint8_t *data, uint32_t number, FlagStatus frame_end);
+
+/* the source filled by the USART receive */
+static wave_source_struct *usart_source = NULL;
+#endif /* WAVE_SOURCE_USART */
+
+/*!
+    \brief      initialize a source reading an audio file of the internal flash
+    \param[in]  source: source to initialize
+    \param[in]  data: start of the audio file
+    \param[in]  size: size of the audio file in bytes
+    \param[out] none
+    \retval     none
+*/
+void wave_source_flash_init(wave_source_struct *source, const uint8_t *data, uint32_t size)
+{
+    memset(source, 0, sizeof(wave_source_struct));
+    source->read = flash_read;
+    source->seek = flash_seek;
+    source->data = data;
+    source->size = size;
+}
+
+#ifdef WAVE_SOURCE_SPI_FLASH
+/*!
+    \brief      initialize a source reading an audio file of the SPI flash
+    \param[in]  source: source to initialize
+    \param[in]  address: SPI flash address of the audio file
+    \param[in]  size: size of the audio file in bytes
+    \param[out] none
+    \retval     none
+*/
+void wave_source_spi_flash_init(wave_source_struct *source, uint32_t address, uint32_t size)
+{
+    memset(source, 0, sizeof(wave_source_struct));
+    source->read = spi_flash_source_read;
+    source->seek = flash_seek;
+    source->address = address;
+    source->size = size;
+}
+#endif /* WAVE_SOURCE_SPI_FLASH */
+
+/*!
+    \brief      initialize a source reading a RAM ring buffer filled by a stream,
+                the stream can only be read once, a seek backwards fails
+    \param[in]  source: source to initialize
+    \param[in]  buffer: ring buffer
+    \param[in]  size: size of the ring buffer, a power of two
+    \param[out] none
+    \retval     none
+*/
+void wave_source_ring_init(wave_source_struct *source, uint8_t *buffer, uint32_t size)
+{
+    memset(source, 0, sizeof(wave_source_struct));
+    source->read = ring_read;
+    source->seek = ring_seek;
+    source->ring = buffer;
+    source->ring_size = size;
+    source->size = WAVE_SOURCE_SIZE_UNKNOWN;
+    /* the reads of the wave header are even */
+    source->frame_size = 2U;
+}
+
+/*!
+    \brief      write stream bytes to a RAM ring source, may be called from an interrupt
+    \param[in]  source: RAM ring source
+    \param[in]  data: stream bytes
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     number of bytes written, less than number if the ring is full
+*/
+uint32_t wave_source_ring_write(wave_source_struct *source, const uint8_t *data, uint32_t number)
+{
+    uint32_t head = source->ring_head;
+    uint32_t space = source->ring_size - (head - source->ring_tail);
+    uint32_t index, count;
+
+    if(number > space) {
+        source->ring_dropped += number - space;
+        number = space;
+    }
+    /* copy up to the end of the ring, then from its start */
+    index = head & (source->ring_size - 1U);
+    count = source->ring_size - index;
+    if(count > number) {
+        count = number;
+    }
+    memcpy(&source->ring[index], data, count);
+    memcpy(source->ring, data + count, number - count);
+
+    source->ring_head = head + number;
+    return number;
+}
+
+#ifdef WAVE_SOURCE_USART
+/*!
+    \brief      initialize a RAM ring source filled by the DMA receive of a USART, the
+                sender paces the stream, the bytes which don't fit in the ring are lost
+    \param[in]  source: source to initialize
+    \param[in]  buffer: ring buffer
+    \param[in]  size: size of the ring buffer, a power of two
+    \param[in]  usart_periph: configured and enabled USART, USARTx(x=0,1,2)
+    \param[out] none
+    \retval     none
+*/
+void wave_source_usart_init(wave_source_struct *source, uint8_t *buffer, uint32_t size, uint32_t usart_periph)
+{
+    wave_source_ring_init(source, buffer, size);
+    usart_source = source;
+    usart_dma_rx_init(usart_periph, usart_source_receive);
+}
+
+#endif /* WAVE_SOURCE_USART */
+/*!
+    \brief      read bytes at the position of a source
+    \param[in]  source: source to read
+    \param[in]  number: number of bytes to read
+    \param[out] buffer: bytes read
+    \retval     number of bytes read, less than number at the end of the stream or
+                when a RAM ring runs empty
+*/
+uint32_t wave_source_read(wave_source_struct *source, uint8_t *buffer, uint32_t number)
+{
+    if(source->position >= source->size) {
+        return 0U;
+    }
+    if(number > (source->size - source->position)) {
+        number = source->size - source->position;
+    }
+    return source->read(source, buffer, number);
+}
+
+/*!
+    \brief      move the position of a source
+    \param[in]  source: source to seek
+    \param[in]  offset: new position from the start of the stream
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR if the source can't reach the position
+*/
+ErrStatus wave_source_seek(wave_source_struct *source, uint32_t offset)
+{
+    if(offset > source->size) {
+        return ERROR;
+    }
+    return source->seek(source, offset);
+}
+
+/*!
+    \brief      read bytes of an audio file of the internal flash
+    \param[in]  source: internal flash source
+    \param[in]  number: number of bytes to read
+    \param[out] buffer: bytes read
+    \retval     number of bytes read
+*/
+static uint32_t flash_read(wave_source_struct *source, uint8_t *buffer, uint32_t number)
+{
+    memcpy(buffer, source->data + source->position, number);
+    source->position += number;
+    return number;
+}
+
+/*!
+    \brief      move the position of a random access source
+    \param[in]  source: internal flash or SPI flash source
+    \param[in]  offset: new position
+    \param[out] none
+    \retval     ErrStatus: SUCCESS
+*/
+static ErrStatus flash_seek(wave_source_struct *source, uint32_t offset)
+{
+    source->position = offset;
+    return SUCCESS;
+}
+
+#ifdef WAVE_SOURCE_SPI_FLASH
+/*!
+    \brief      read bytes of an audio file of the SPI flash
+    \param[in]  source: SPI flash source
+    \param[in]  number: number of bytes to read
+    \param[out] buffer: bytes read
+    \retval     number of bytes read
+*/
+static uint32_t spi_flash_source_read(wave_source_struct *source, uint8_t *buffer, uint32_t number)
+{
+    uint32_t count;
+    uint32_t done = 0U;
+
+    /* spi_flash_buffer_read() takes at most 0xFFFF bytes */
+    while(done < number) {
+        count = number - done;
+        if(count > 0xFFFFU) {
+            count = 0xFFFFU;
+        }
+        spi_flash_buffer_read(buffer + done, source->address + source->position, (uint16_t)count);
+        source->position += count;
+        done += count;
+    }
+    return number;
+}
+#endif /* WAVE_SOURCE_SPI_FLASH */
+
+/*!
+    \brief      read bytes of a RAM ring source
+    \param[in]  source: RAM ring source
+    \param[in]  number: number of bytes to read
+    \param[out] buffer: bytes read
+    \retval     number of bytes read, limited to the whole frames in the ring
+*/
+static uint32_t ring_read(wave_source_struct *source, uint8_t *buffer, uint32_t number)
+{
+    uint32_t tail = source->ring_tail;
+    uint32_t used = source->ring_head - tail;
+    uint32_t index, count;
+
+    /* drop the bytes skipped by a seek forward first */
+    count = (source->ring_skip < used) ? source->ring_skip : used;
+    tail += count;
+    used -= count;
+    source->ring_skip -= count;
+    if(0U != source->ring_skip) {
+        source->ring_tail = tail;
+        return 0U;
+    }
+
+    /* whole frames only, a sample is never split between two reads */
+    used -= used % source->frame_size;
+    if(number > used) {
+        number = used;
+    }
+    index = tail & (source->ring_size - 1U);
+    count = source->ring_size - index;
+    if(count > number) {
+        count = number;
+    }
+    memcpy(buffer, &source->ring[index], count);
+    memcpy(buffer + count, source->ring, number - count);
+
+    source->ring_tail = tail + number;
+    source->position += number;
+    return number;
+}
+
+/*!
+    \brief      move the position of a RAM ring source forwards, the skipped bytes are
+                dropped when they arrive
+    \param[in]  source: RAM ring source
+    \param[in]  offset: new position, not before the current one
+    \param[out] none
+    \retval     ErrStatus: SUCCESS or ERROR for a seek backwards
+*/
+static ErrStatus ring_seek(wave_source_struct *source, uint32_t offset)
+{
+    if(offset < source->position) {
+        return ERROR;
+    }
+    source->ring_skip += offset - source->position;
+    source->position = offset;
+    return SUCCESS;
+}
+
+#ifdef WAVE_SOURCE_USART
+/*!
+    \brief      write the received bytes to the ring, called by usart_dma_rx in its interrupts
+    \param[in]  data: received bytes, in the DMA buffer
+    \param[in]  number: number of bytes
+    \param[in]  frame_end: end of a frame, the stream has no frames
+    \param[out] none
+    \retval     none
+*/
+static void usart_source_receive(const uint8_t *data, uint32_t number, FlagStatus frame_end)
+{
+    (void)frame_end;
+    wave_source_ring_write(usart_source, data, number);
+}
+#endif /* WAVE_SOURCE_USART */
@@ -0,0 +1,94 @@
+/*!
+    \file  wave_source.h
+    \brief the header file of the wave audio stream sources
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    All rights reserved.
+
+    Redistribution and use in source and binary forms, with or without modification, 
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this 
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice, 
+       this list of conditions and the following disclaimer in the documentation 
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors 
+       may be used to endorse or promote products derived from this software without 
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" 
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED 
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. 
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, 
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT 
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR 
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) 
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY 
+OF SUCH DAMAGE.
+*/
+
+#ifndef WAVE_SOURCE_H
+#define WAVE_SOURCE_H
+
+#include "gd32c2x1.h"
+
+/* uncomment this line to read the audio file from the GD25Qxx SPI flash, gd25qxx.c of
+   10_SPI_SPI_FLASH must be built with the project and spi_flash_init() called first */
+/* #define WAVE_SOURCE_SPI_FLASH */
+
+/* uncomment this line to receive the audio file on the COM port into a RAM ring, usart_dma_rx.c
+   of 06_USART_DMA must be built with the project, it takes DMA channel 1 like the SPI flash */
+/* #define WAVE_SOURCE_USART */
+
+struct wave_source;
+
+/* read up to number bytes at the position, returns the number of bytes read */
+typedef uint32_t (*wave_source_read_func)(struct wave_source *source, uint8_t *buffer, uint32_t number);
+/* move the position to offset bytes from the start of the stream */
+typedef ErrStatus (*wave_source_seek_func)(struct wave_source *source, uint32_t offset);
+
+/* stream of the audio file bytes */
+typedef struct wave_source {
+    wave_source_read_func read;         /* backend read function */
+    wave_source_seek_func seek;         /* backend seek function */
+    uint32_t position;                  /* offset of the next byte from the start of the stream */
+    uint32_t size;                      /* stream size in bytes, 0xFFFFFFFF if unknown */
+    const uint8_t *data;                /* internal flash: audio file */
+    uint32_t address;                   /* SPI flash: address of the audio file */
+    uint8_t *ring;                      /* RAM ring: ring buffer */
+    uint32_t ring_size;                 /* RAM ring: buffer size, a power of two */
+    __IO uint32_t ring_head;            /* RAM ring: bytes written, free running */
+    __IO uint32_t ring_tail;            /* RAM ring: bytes read, free running */
+    uint32_t ring_skip;                 /* RAM ring: bytes to drop before the next read */
+    uint32_t ring_dropped;              /* RAM ring: stream bytes lost because the ring was full */
+    uint8_t frame_size;                 /* RAM ring: reads return whole frames of this size */
+} wave_source_struct;
+
+/* function declarations */
+/* initialize a source reading an audio file of the internal flash */
+void wave_source_flash_init(wave_source_struct *source, const uint8_t *data, uint32_t size);
+#ifdef WAVE_SOURCE_SPI_FLASH
+/* initialize a source reading an audio file of the SPI flash */
+void wave_source_spi_flash_init(wave_source_struct *source, uint32_t address, uint32_t size);
+#endif /* WAVE_SOURCE_SPI_FLASH */
+/* initialize a source reading a RAM ring buffer filled by a stream */
+void wave_source_ring_init(wave_source_struct *source, uint8_t *buffer, uint32_t size);
+/* write stream bytes to a RAM ring source */
+uint32_t wave_source_ring_write(wave_source_struct *source, const uint8_t *data, uint32_t number);
+#ifdef WAVE_SOURCE_USART
+/* initialize a RAM ring source filled by the DMA receive of a USART */
+void wave_source_usart_init(wave_source_struct *source, uint8_t *buffer, uint32_t size, uint32_t usart_periph);
+#endif /* WAVE_SOURCE_USART */
+/* read bytes at the position of a source */
+uint32_t wave_source_read(wave_source_struct *source, uint8_t *buffer, uint32_t number);
+/* move the position of a source */
+ErrStatus wave_source_seek(wave_source_struct *source, uint32_t offset);
+
+#endif /* WAVE_SOURCE_H */
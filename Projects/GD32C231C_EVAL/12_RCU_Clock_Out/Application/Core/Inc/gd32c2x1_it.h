@@ -50,4 +50,6 @@ void PendSV_Handler(void);
 void SysTick_Handler(void);
 /* this function handles external lines 4 interrupt request */
 void EXTI4_IRQHandler(void);
+/* this function handles DMA_Channel2_IRQHandler interrupt */
+void DMA_Channel2_IRQHandler(void);
 #endif /* GD32L23X_IT_H */
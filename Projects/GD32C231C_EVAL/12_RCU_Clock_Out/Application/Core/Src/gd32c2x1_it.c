@@ -119,4 +119,15 @@ void EXTI4_IRQHandler(void)
         g_button_press_flag = 1;
         exti_interrupt_flag_clear(USER_KEY_EXTI_LINE);
     }
-}
\ No newline at end of file
+}
+
+/*!
+    \brief      this function handles DMA_Channel2_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel2_IRQHandler(void)
+{
+    gd_eval_com_tx_dma_irq_handler();
+}
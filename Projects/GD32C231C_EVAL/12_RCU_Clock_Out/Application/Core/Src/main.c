@@ -65,6 +65,8 @@ int main(void)
 
     /* initialize the USART */
     gd_eval_com_init(EVAL_COM);
+    /* printf returns once the text is in the COM ring buffer */
+    gd_eval_com_tx_dma_init(EVAL_COM);
 
     printf("\r\n /=========== Gigadevice Clock Output Demo ===========/ \r\n");
     printf("press user key to select clock output source \r\n");
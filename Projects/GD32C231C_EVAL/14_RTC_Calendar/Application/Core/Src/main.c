@@ -38,6 +38,7 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include "lcd_driver.h"
 #include "gui.h"
+#include "gui_tile.h"
 
 #define RTC_CLOCK_SOURCE_IRC32K 
 
@@ -76,44 +77,50 @@ int main(void)
     gui_draw_font_gbk16(2, 50, WHITE,BLUE, "     GD32C231C_EAVL  ");
     gui_draw_font_gbk16(2, 70, WHITE,BLUE, " RTC Test :");
 
+    /* the loop below only sends the tiles which changed since the last frame */
+    gui_tile_init(BLUE);
+
     while( 1 )
     {
         /* get the current date & time, in BCD mode */
         rtc_current_time_get(&initpara);
 
-        gui_draw_font_gbk24(10, 132, YELLOW, BLUE, "  Today is ");
+        gui_tile_begin();
+        gui_tile_draw_font(10, 132, YELLOW, BLUE, "  Today is ");
 
         /* year */
-        gui_draw_font_num32(20 - 15, 160, YELLOW, BLUE, 2 );
-        gui_draw_font_num32(44 - 15, 160, YELLOW, BLUE, 0 );
-        gui_draw_font_num32(68 - 15, 160, YELLOW, BLUE, initpara.year >> 4);
-        gui_draw_font_num32(92 - 15, 160, YELLOW, BLUE, (initpara.year & 0x0F));  
+        gui_tile_draw_font_num32(20 - 15, 160, YELLOW, BLUE, 2 );
+        gui_tile_draw_font_num32(44 - 15, 160, YELLOW, BLUE, 0 );
+        gui_tile_draw_font_num32(68 - 15, 160, YELLOW, BLUE, initpara.year >> 4);
+        gui_tile_draw_font_num32(92 - 15, 160, YELLOW, BLUE, (initpara.year & 0x0F));  
         /* month */
-        gui_draw_font_num32(120, 160, YELLOW, BLUE, initpara.month >> 4);
-        gui_draw_font_num32(144, 160, YELLOW, BLUE, (initpara.month & 0x0F));
+        gui_tile_draw_font_num32(120, 160, YELLOW, BLUE, initpara.month >> 4);
+        gui_tile_draw_font_num32(144, 160, YELLOW, BLUE, (initpara.month & 0x0F));
         /* date */
-        gui_draw_font_num32(172, 160, YELLOW, BLUE, initpara.date >> 4);
-        gui_draw_font_num32(196, 160, YELLOW, BLUE, (initpara.date & 0x0F));
+        gui_tile_draw_font_num32(172, 160, YELLOW, BLUE, initpara.date >> 4);
+        gui_tile_draw_font_num32(196, 160, YELLOW, BLUE, (initpara.date & 0x0F));
 
-        gui_draw_font_gbk24(10, 208, YELLOW, BLUE, "  Now Time is ");
+        gui_tile_draw_font(10, 208, YELLOW, BLUE, "  Now Time is ");
 
         if(0 == initpara.am_pm){
-            gui_draw_font_gbk24(20, 244, YELLOW, BLUE, "  AM ");
+            gui_tile_draw_font(20, 244, YELLOW, BLUE, "  AM ");
         }else{
-            gui_draw_font_gbk24(20, 244, YELLOW, BLUE, "  PM ");
+            gui_tile_draw_font(20, 244, YELLOW, BLUE, "  PM ");
         }
 
         /* hour */
-        gui_draw_font_num32(60, 236, YELLOW, BLUE, initpara.hour >> 4);
-        gui_draw_font_num32(84, 236, YELLOW, BLUE, (initpara.hour & 0x0F));
-        gui_draw_font_gbk24(112, 244, YELLOW, BLUE, ":");
+        gui_tile_draw_font_num32(60, 236, YELLOW, BLUE, initpara.hour >> 4);
+        gui_tile_draw_font_num32(84, 236, YELLOW, BLUE, (initpara.hour & 0x0F));
+        gui_tile_draw_font(112, 244, YELLOW, BLUE, ":");
         /* minute */
-        gui_draw_font_num32(116, 236, YELLOW, BLUE, initpara.minute >> 4);
-        gui_draw_font_num32(140, 236, YELLOW, BLUE, (initpara.minute & 0x0F));
-        gui_draw_font_gbk24(164, 244, YELLOW, BLUE, ":");
+        gui_tile_draw_font_num32(116, 236, YELLOW, BLUE, initpara.minute >> 4);
+        gui_tile_draw_font_num32(140, 236, YELLOW, BLUE, (initpara.minute & 0x0F));
+        gui_tile_draw_font(164, 244, YELLOW, BLUE, ":");
         /* second */
-        gui_draw_font_num32(168, 236, YELLOW, BLUE, initpara.second >> 4);
-        gui_draw_font_num32(192, 236, YELLOW, BLUE, (initpara.second & 0x0F));
+        gui_tile_draw_font_num32(168, 236, YELLOW, BLUE, initpara.second >> 4);
+        gui_tile_draw_font_num32(192, 236, YELLOW, BLUE, (initpara.second & 0x0F));
+
+        gui_tile_flush();
         
         if(1 == gd_eval_key_state_get(KEY_WAKEUP)){
             delay_ms(50);
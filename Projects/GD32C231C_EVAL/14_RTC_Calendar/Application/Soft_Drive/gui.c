@@ -38,6 +38,24 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include "font.h"
 
+/* number of pixels in each half of the glyph line buffer, a multiple of 8 */
+#define GUI_SPAN_BUFFER_SIZE        128U
+
+/* glyph line buffer, one half is expanded while the other one is sent by DMA */
+static uint16_t gui_span_buffer[2][GUI_SPAN_BUFFER_SIZE];
+static uint8_t gui_span_index = 0U;
+static uint16_t gui_span_fill = 0U;
+
+static uint16_t gui_clip(uint16_t start, uint16_t size, uint16_t max);
+static void gui_fill_clip(int x0, int y0, int x1, int y1, uint16_t color);
+static void gui_circle_run(int x, int y, int a0, int a1, int b, uint16_t fc);
+static void gui_span_begin(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+static void gui_span_bits(uint8_t bits, uint8_t count, uint16_t fc, uint16_t bc);
+static void gui_span_flush(void);
+static void gui_span_end(void);
+static void gui_draw_bitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const char *msk, uint16_t fc, uint16_t bc);
+static void gui_draw_ascii_run(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s, uint16_t n);
+
 /*!
     \brief      convert bgr format to rgb format
     \param[in]  c: bgr color value
@@ -65,44 +83,69 @@ uint16_t lcd_bgr2rgb(uint16_t c)
 */
 void gui_circle(uint16_t x, uint16_t y, uint16_t r, uint16_t fc)
 {
-    unsigned short a, b;
-    int c;
+    int a, b, c, start;
     a = 0;
     b = r;
     c = 3 - 2 * r;
-    LCD_CS_CLR;
+    start = 0;
 
     while(a < b) {
-        /* draw points on the lcd */
-        gui_draw_point(x + a, y + b, fc);
-        gui_draw_point(x - a, y + b, fc);
-        gui_draw_point(x + a, y - b, fc);
-        gui_draw_point(x - a, y - b, fc);
-        gui_draw_point(x + b, y + a, fc);
-        gui_draw_point(x - b, y + a, fc);
-        gui_draw_point(x + b, y - a, fc);
-        gui_draw_point(x - b, y - a, fc);
-
         if(c < 0) {
             c = c + 4 * a + 6;
         } else {
+            /* b changes after this point, send the run of points [start, a] */
+            gui_circle_run(x, y, start, a, b, fc);
+            start = a + 1;
             c = c + 4 * (a - b) + 10;
             b -= 1;
         }
         a += 1;
     }
     if(a == b) {
-        /* draw points on the lcd */
-        gui_draw_point(x + a, y + b, fc);
-        gui_draw_point(x + a, y + b, fc);
-        gui_draw_point(x + a, y - b, fc);
-        gui_draw_point(x - a, y - b, fc);
-        gui_draw_point(x + b, y + a, fc);
-        gui_draw_point(x - b, y + a, fc);
-        gui_draw_point(x + b, y - a, fc);
-        gui_draw_point(x - b, y - a, fc);
-    }
-    LCD_CS_SET;
+        gui_circle_run(x, y, start, a, b, fc);
+    } else if(start < a) {
+        gui_circle_run(x, y, start, a - 1, b, fc);
+    }
+    lcd_dma_wait();
+}
+
+/*!
+    \brief      gui fill circle
+    \param[in]  x: the x position of the center
+    \param[in]  y: the y position of the center
+    \param[in]  r: the radius of circle
+    \param[in]  fc: lcd display color
+    \param[out] none
+    \retval     none
+*/
+void gui_fill_circle(uint16_t x, uint16_t y, uint16_t r, uint16_t fc)
+{
+    int a, b, c;
+    a = 0;
+    b = r;
+    c = 3 - 2 * r;
+
+    while(a <= b) {
+        /* rows y +/- a, from x - b to x + b */
+        gui_fill_clip(x - b, y + a, x + b, y + a, fc);
+        if(0 != a) {
+            gui_fill_clip(x - b, y - a, x + b, y - a, fc);
+        }
+
+        if(c < 0) {
+            c = c + 4 * a + 6;
+        } else {
+            /* rows y +/- b are left with their widest span, from x - a to x + a */
+            if(b > a) {
+                gui_fill_clip(x - a, y + b, x + a, y + b, fc);
+                gui_fill_clip(x - a, y - b, x + a, y - b, fc);
+            }
+            c = c + 4 * (a - b) + 10;
+            b -= 1;
+        }
+        a += 1;
+    }
+    lcd_dma_wait();
 }
 
 /*!
@@ -125,10 +168,12 @@ void gui_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t
        - the discriminant i.e. error i.e. decision variable
        - used for looping */
     int dx, dy, dx2, dy2, x_inc, y_inc, error, index;
+    /* - current pixel
+       - first pixel of the current run */
+    int x, y, start;
 
-    LCD_CS_CLR;
-
-    lcd_set_xy(x0, y0);
+    x = x0;
+    y = y0;
     /* calculate x distance */
     dx = x1 - x0;
     /* calculate y distance */
@@ -154,42 +199,52 @@ void gui_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t
     if(dx > dy) {
         /* initialize error */
         error = dy2 - dx;
-        /* draw the line */
+        start = x;
+        /* draw the line as horizontal runs */
         for(index = 0; index <= dx; index ++) {
-            gui_draw_point(x0, y0, color);
             /* test if error has overflowed */
             if(0 <= error) {
+                /* send the run of this line */
+                gui_fill_clip(start, y, x, y, color);
+                start = x + x_inc;
                 error -= dx2;
                 /* move to next line */
-                y0 += y_inc;
+                y += y_inc;
             }
             /* adjust the error term */
             error += dy2;
             /* move to the next pixel */
-            x0 += x_inc;
+            x += x_inc;
+        }
+        if(start != x) {
+            gui_fill_clip(start, y, x - x_inc, y, color);
         }
     } else {
         /* initialize error term */
         error = dx2 - dy;
-        /* draw the linedraw the line*/
+        start = y;
+        /* draw the line as vertical runs */
         for(index = 0; index <= dy; index ++) {
-            /* set the pixel */
-            gui_draw_point(x0, y0, color);
-
             /* test if error overflowed */
             if(0 <= error) {
+                /* send the run of this column */
+                gui_fill_clip(x, start, x, y, color);
+                start = y + y_inc;
                 error -= dy2;
-                /* move to next line */
-                x0 += x_inc;
+                /* move to next column */
+                x += x_inc;
             }
             /* adjust the error term */
             error += dx2;
 
             /* move to the next pixel */
-            y0 += y_inc;
+            y += y_inc;
+        }
+        if(start != y) {
+            gui_fill_clip(x, start, x, y - y_inc, color);
         }
     }
-    LCD_CS_SET;
+    lcd_dma_wait();
 }
 
 /*!
@@ -204,16 +259,12 @@ void gui_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t
 */
 void gui_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc)
 {
-    LCD_CS_CLR;
-
     /* gui draw line*/
     gui_draw_line(x, y, x + w, y, 0xEF7D);
     gui_draw_line(x + w - 1, y + 1, x + w - 1, y + 1 + h, 0x2965);
     gui_draw_line(x, y + h, x + w, y + h, 0x2965);
     gui_draw_line(x, y, x, y + h, 0xEF7D);
     gui_draw_line(x + 1, y + 1, x + 1 + w - 2, y + 1 + h - 2, bc);
-
-    LCD_CS_SET;
 }
 
 /*!
@@ -228,7 +279,6 @@ void gui_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc)
 */
 void gui_box2(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t mode)
 {
-    LCD_CS_CLR;
     /* gui box2 display mode0 */
     if(0 == mode) {
         gui_draw_line(x, y, x + w, y, 0xEF7D);
@@ -250,7 +300,6 @@ void gui_box2(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t mode)
         gui_draw_line(x, y + h, x + w, y + h, 0xffff);
         gui_draw_line(x, y, x, y + h, 0xffff);
     }
-    LCD_CS_SET;
 }
 
 /*!
@@ -265,17 +314,28 @@ void gui_box2(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t mode)
 */
 void gui_rect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t fc)
 {
-    int ix, iy;
-    LCD_CS_CLR;
-    for(ix = x1; ix < x2; ix ++) {
-        for(iy = y1; iy < y2; iy ++)
-            /* set the pixel */
-        {
-            gui_draw_point(ix, iy, fc);
-        }
+    if((x1 < x2) && (y1 < y2)) {
+        gui_fill_clip(x1, y1, x2 - 1, y2 - 1, fc);
     }
+    lcd_dma_wait();
+}
 
-    LCD_CS_SET;
+/*!
+    \brief      gui fill box
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the box
+    \param[in]  h: the high of the box
+    \param[in]  bc: lcd display color
+    \param[out] none
+    \retval     none
+*/
+void gui_fill_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc)
+{
+    if((0 != w) && (0 != h)) {
+        gui_fill_clip(x, y, x + w - 1, y + h - 1, bc);
+    }
+    lcd_dma_wait();
 }
 
 /*!
@@ -289,8 +349,6 @@ void gui_rect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t fc)
 */
 void display_button_down(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 {
-    LCD_CS_CLR;
-
     /* gui draw line with gray color*/
     gui_draw_line(x1, y1, x2, y1, GRAY2);
     gui_draw_line(x1 + 1, y1 + 1, x2, y1 + 1, GRAY1);
@@ -300,7 +358,6 @@ void display_button_down(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
     /* gui draw line with white color*/
     gui_draw_line(x1, y2, x2, y2, WHITE);
     gui_draw_line(x2, y1, x2, y2, WHITE);
-    LCD_CS_SET;
 }
 
 /*!
@@ -314,8 +371,6 @@ void display_button_down(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 */
 void display_button_up(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 {
-    LCD_CS_CLR;
-
     /* gui draw line with white color*/
     gui_draw_line(x1, y1, x2, y1, WHITE);
     gui_draw_line(x1, y1, x1, y2, WHITE);
@@ -325,7 +380,6 @@ void display_button_up(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
     gui_draw_line(x1, y2, x2, y2, GRAY2);
     gui_draw_line(x2 - 1, y1 + 1, x2 - 1, y2, GRAY1);
     gui_draw_line(x2, y1, x2, y2, GRAY2);
-    LCD_CS_SET;
 }
 
 /*!
@@ -341,44 +395,31 @@ void display_button_up(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
 
 void gui_draw_font_gbk16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char *s)
 {
-    unsigned char i, j;
-    unsigned short k, x0;
+    unsigned short n, x0;
     x0 = x;
 
-    LCD_CS_CLR;
     while(*s) {
-        /* ASCII character table from 32 to 128 */
-        if(((uint8_t)(*s)) < 128) {
-            k = *s;
-            if(13 == k) {
-                x = x0;
-                y += 16;
-            } else {
-                if(k > 32) {
-                    k -= 32;
-                } else {
-                    k = 0;
-                }
-                for(i = 0; i < 16; i ++)
-                    for(j = 0; j < 8; j ++) {
-                        if(asc16[k * 16 + i] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j, y + i, bc);
-                            }
-                        }
-                    }
-                x += 8;
-            }
+        if(13 == *s) {
+            x = x0;
+            y += 16;
             s ++;
+            continue;
         }
+
+        /* ASCII character table from 32 to 128, one window per run up to the next line break */
+        n = 0;
+        while((0 != s[n]) && (13 != s[n]) && (((uint8_t)s[n]) < 128)) {
+            n ++;
+        }
+        if(0 == n) {
+            s ++;
+            continue;
+        }
+
+        gui_draw_ascii_run(x, y, fc, bc, s, n);
+        x += n * 8;
+        s += n;
     }
-    LCD_CS_SET;
 }
 
 /*!
@@ -393,39 +434,23 @@ void gui_draw_font_gbk16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char
 */
 void gui_draw_font_gbk24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char *s)
 {
-    unsigned char i, j;
-    unsigned short k;
+    unsigned short n;
 
-    LCD_CS_CLR;
     while(*s) {
-        /* ASCII character table from 32 to 128 */
-        if(((uint8_t)(*s)) < 0x80) {
-            k = *s;
-            if(k > 32) {
-                k -= 32;
-            } else {
-                k = 0;
-            }
-
-            for(i = 0; i < 16; i ++)
-                for(j = 0; j < 8; j ++) {
-                    if(asc16[k * 16 + i] & (0x80 >> j))
-                        /* draw a point on the lcd */
-                    {
-                        gui_draw_point(x + j, y + i, fc);
-                    } else {
-                        if(fc != bc)
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j, y + i, bc);
-                        }
-                    }
-                }
+        /* ASCII character table from 32 to 128, one window per run */
+        n = 0;
+        while((0 != s[n]) && (((uint8_t)s[n]) < 0x80)) {
+            n ++;
+        }
+        if(0 == n) {
             s ++;
-            x += 8;
+            continue;
         }
+
+        gui_draw_ascii_run(x, y, fc, bc, s, n);
+        x += n * 8;
+        s += n;
     }
-    LCD_CS_SET;
 }
 
 /*!
@@ -440,48 +465,18 @@ void gui_draw_font_gbk24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char
 */
 void gui_draw_characters_gbk16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char *s)
 {
-    unsigned char i, j;
     unsigned short k;
 
-    LCD_CS_CLR;
-
     while(*s) {
         for(k = 0; k < hz16_num; k ++) {
-            if((hz16[k].Index[0] == *(s)) && (hz16[k].Index[1] == *(s + 1))) {
-                for(i = 0; i < 16; i ++) {
-                    for(j = 0; j < 8; j ++) {
-                        if(hz16[k].Msk[i * 2] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j, y + i, bc);
-                            }
-                        }
-                    }
-                    for(j = 0; j < 8; j ++) {
-                        if(hz16[k].Msk[i * 2 + 1] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j + 8, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j + 8, y + i, bc);
-                            }
-                        }
-                    }
-                }
+            if((hz16[k].Index[0] == (uint8_t)(*s)) && (hz16[k].Index[1] == (uint8_t)(*(s + 1)))) {
+                gui_draw_bitmap(x, y, 16, 16, hz16[k].Msk, fc, bc);
+                break;
             }
         }
         s += 3;
         x += 16;
     }
-    LCD_CS_SET;
 }
 
 /*!
@@ -496,61 +491,19 @@ void gui_draw_characters_gbk16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc,
 */
 void gui_draw_characters_gbk24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, char *s)
 {
-    unsigned char i, j;
     unsigned short k;
 
-    LCD_CS_CLR;
     while(*s) {
         for(k = 0; k < hz24_num; k ++) {
-            if((hz24[k].Index[0] == *(s)) && (hz24[k].Index[1] == *(s + 1))) {
-                for(i = 0; i < 24; i ++) {
-                    for(j = 0; j < 8; j ++) {
-                        if(hz24[k].Msk[i * 3] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j, y + i, bc);
-                            }
-                        }
-                    }
-                    for(j = 0; j < 8; j ++) {
-                        if(hz24[k].Msk[i * 3 + 1] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j + 8, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j + 8, y + i, bc);
-                            }
-                        }
-                    }
-                    for(j = 0; j < 8; j ++) {
-                        if(hz24[k].Msk[i * 3 + 2] & (0x80 >> j))
-                            /* draw a point on the lcd */
-                        {
-                            gui_draw_point(x + j + 16, y + i, fc);
-                        } else {
-                            if(fc != bc)
-                                /* draw a point on the lcd */
-                            {
-                                gui_draw_point(x + j + 16, y + i, bc);
-                            }
-                        }
-                    }
-                }
+            if((hz24[k].Index[0] == (uint8_t)(*s)) && (hz24[k].Index[1] == (uint8_t)(*(s + 1)))) {
+                gui_draw_bitmap(x, y, 24, 24, hz24[k].Msk, fc, bc);
+                break;
             }
         }
         s += 3;
         x += 24;
     }
     delay_ms(1);
-    LCD_CS_SET;
 }
 
 /*!
@@ -565,26 +518,259 @@ void gui_draw_characters_gbk24(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc,
 */
 void gui_draw_font_num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num)
 {
-    unsigned char i, j, k, c;
-
-    LCD_CS_CLR;
-    for(i = 0; i < 32; i ++) {
-        for(j = 0; j < 4; j++) {
-            c = *(sz32 + num * 32 * 4 + i * 4 + j);
-            for(k = 0; k < 8; k ++) {
-                if(c & (0x80 >> k))
+    gui_draw_bitmap(x, y, 32, 32, (const char *)(sz32 + num * 32 * 4), fc, bc);
+}
+
+/*!
+    \brief      clip a size to the lcd panel
+    \param[in]  start: the start position
+    \param[in]  size: the size from the start position
+    \param[in]  max: the panel size
+    \param[out] none
+    \retval     the visible size, 0 if nothing is visible
+*/
+static uint16_t gui_clip(uint16_t start, uint16_t size, uint16_t max)
+{
+    if(start >= max) {
+        return 0;
+    }
+    if(size > (max - start)) {
+        size = max - start;
+    }
+    return size;
+}
+
+/*!
+    \brief      fill a rectangle clipped to the lcd panel as one burst
+    \param[in]  x0: the x position of a corner
+    \param[in]  y0: the y position of a corner
+    \param[in]  x1: the x position of the opposite corner
+    \param[in]  y1: the y position of the opposite corner
+    \param[in]  color: lcd display color
+    \param[out] none
+    \retval     none
+*/
+static void gui_fill_clip(int x0, int y0, int x1, int y1, uint16_t color)
+{
+    int t;
+
+    if(x0 > x1) {
+        t = x0;
+        x0 = x1;
+        x1 = t;
+    }
+    if(y0 > y1) {
+        t = y0;
+        y0 = y1;
+        y1 = t;
+    }
+
+    if(x0 < 0) {
+        x0 = 0;
+    }
+    if(y0 < 0) {
+        y0 = 0;
+    }
+    if(x1 >= X_MAX_PIXEL) {
+        x1 = X_MAX_PIXEL - 1;
+    }
+    if(y1 >= Y_MAX_PIXEL) {
+        y1 = Y_MAX_PIXEL - 1;
+    }
+    if((x0 > x1) || (y0 > y1)) {
+        return;
+    }
+
+    /* a single pixel costs less without the window */
+    if((x0 == x1) && (y0 == y1)) {
+        gui_draw_point(x0, y0, color);
+        return;
+    }
+
+    lcd_fill_rect(x0, y0, x1 - x0 + 1, y1 - y0 + 1, color, NULL);
+}
+
+/*!
+    \brief      draw a run of circle points in the eight octants
+    \param[in]  x: the x position of the center
+    \param[in]  y: the y position of the center
+    \param[in]  a0: the first offset of the run
+    \param[in]  a1: the last offset of the run
+    \param[in]  b: the other offset, the same for the whole run
+    \param[in]  fc: lcd display color
+    \param[out] none
+    \retval     none
+*/
+static void gui_circle_run(int x, int y, int a0, int a1, int b, uint16_t fc)
+{
+    /* horizontal runs on the rows y +/- b */
+    gui_fill_clip(x + a0, y + b, x + a1, y + b, fc);
+    gui_fill_clip(x - a1, y + b, x - a0, y + b, fc);
+    gui_fill_clip(x + a0, y - b, x + a1, y - b, fc);
+    gui_fill_clip(x - a1, y - b, x - a0, y - b, fc);
+
+    /* vertical runs on the columns x +/- b */
+    gui_fill_clip(x + b, y + a0, x + b, y + a1, fc);
+    gui_fill_clip(x - b, y + a0, x - b, y + a1, fc);
+    gui_fill_clip(x + b, y - a1, x + b, y - a0, fc);
+    gui_fill_clip(x - b, y - a1, x - b, y - a0, fc);
+}
+
+/*!
+    \brief      open a window for a span stream
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the window
+    \param[in]  h: the height of the window
+    \param[out] none
+    \retval     none
+*/
+static void gui_span_begin(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    lcd_set_region(x, y, x + w - 1, y + h - 1);
+    gui_span_fill = 0;
+}
+
+/*!
+    \brief      expand the bits of a 1bpp byte into the line buffer
+    \param[in]  bits: font bits, msb is the leftmost pixel
+    \param[in]  count: number of pixels to expand(1-8)
+    \param[in]  fc: color of the set bits
+    \param[in]  bc: color of the cleared bits
+    \param[out] none
+    \retval     none
+*/
+static void gui_span_bits(uint8_t bits, uint8_t count, uint16_t fc, uint16_t bc)
+{
+    uint16_t *p;
+    uint8_t mask = 0x80;
+
+    if((gui_span_fill + count) > GUI_SPAN_BUFFER_SIZE) {
+        gui_span_flush();
+    }
+
+    p = &gui_span_buffer[gui_span_index][gui_span_fill];
+    gui_span_fill += count;
+    while(count --) {
+        *p ++ = (bits & mask) ? fc : bc;
+        mask >>= 1;
+    }
+}
+
+/*!
+    \brief      send the filled half of the line buffer and switch to the other half
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void gui_span_flush(void)
+{
+    if(0 != gui_span_fill) {
+        lcd_write_pixels(gui_span_buffer[gui_span_index], gui_span_fill, NULL);
+        gui_span_index ^= 1U;
+        gui_span_fill = 0;
+    }
+}
+
+/*!
+    \brief      send the rest of a span stream and wait until it is done
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void gui_span_end(void)
+{
+    gui_span_flush();
+    lcd_dma_wait();
+}
+
+/*!
+    \brief      gui draw a 1bpp bitmap, rows are padded to whole bytes
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the bitmap
+    \param[in]  h: the height of the bitmap
+    \param[in]  msk: bitmap data
+    \param[in]  fc: lcd display color
+    \param[in]  bc: display color of font, only the set bits are drawn if it equals fc
+    \param[out] none
+    \retval     none
+*/
+static void gui_draw_bitmap(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const char *msk, uint16_t fc, uint16_t bc)
+{
+    uint16_t i, j, stride, wv, hv;
+    uint8_t bits;
+
+    stride = (w + 7) / 8;
+
+    if(fc == bc) {
+        /* transparent background, only the set bits are drawn */
+        for(i = 0; i < h; i ++) {
+            for(j = 0; j < w; j ++) {
+                if(((uint8_t)msk[i * stride + j / 8]) & (0x80 >> (j % 8))) {
                     /* draw a point on the lcd */
-                {
-                    gui_draw_point(x + j * 8 + k, y + i, fc);
-                } else {
-                    if(fc != bc)
-                        /* draw a point on the lcd */
-                    {
-                        gui_draw_point(x + j * 8 + k, y + i, bc);
-                    }
+                    gui_draw_point(x + j, y + i, fc);
                 }
             }
         }
+        return;
+    }
+
+    wv = gui_clip(x, w, X_MAX_PIXEL);
+    hv = gui_clip(y, h, Y_MAX_PIXEL);
+    if((0 == wv) || (0 == hv)) {
+        return;
+    }
+
+    gui_span_begin(x, y, wv, hv);
+    for(i = 0; i < hv; i ++) {
+        for(j = 0; j < wv; j += 8) {
+            bits = (uint8_t)msk[i * stride + j / 8];
+            gui_span_bits(bits, ((wv - j) < 8) ? (wv - j) : 8, fc, bc);
+        }
+    }
+    gui_span_end();
+}
+
+/*!
+    \brief      gui draw a run of 8x16 ASCII characters in one window
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  fc: lcd display color
+    \param[in]  bc: display color of font, only the set bits are drawn if it equals fc
+    \param[in]  s: display chars
+    \param[in]  n: number of chars in the run
+    \param[out] none
+    \retval     none
+*/
+static void gui_draw_ascii_run(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s, uint16_t n)
+{
+    uint16_t i, j, k, wv, hv;
+
+    if(fc == bc) {
+        /* transparent background, draw the chars one by one */
+        for(j = 0; j < n; j ++) {
+            k = (uint8_t)s[j];
+            k = (k > 32) ? (k - 32) : 0;
+            gui_draw_bitmap(x + j * 8, y, 8, 16, (const char *)&asc16[k * 16], fc, bc);
+        }
+        return;
+    }
+
+    wv = gui_clip(x, n * 8, X_MAX_PIXEL);
+    hv = gui_clip(y, 16, Y_MAX_PIXEL);
+    if((0 == wv) || (0 == hv)) {
+        return;
+    }
+
+    /* rows of all the chars are sent line by line */
+    gui_span_begin(x, y, wv, hv);
+    for(i = 0; i < hv; i ++) {
+        for(j = 0; (j * 8) < wv; j ++) {
+            k = (uint8_t)s[j];
+            k = (k > 32) ? (k - 32) : 0;
+            gui_span_bits(asc16[k * 16 + i], ((wv - j * 8) < 8) ? (wv - j * 8) : 8, fc, bc);
+        }
     }
-    LCD_CS_SET;
+    gui_span_end();
 }
@@ -42,6 +42,8 @@ OF SUCH DAMAGE.
 uint16_t lcd_bgr2rgb(uint16_t c);
 /* gui circle */
 void gui_circle(uint16_t x, uint16_t y, uint16_t r, uint16_t fc);
+/* gui fill circle */
+void gui_fill_circle(uint16_t x, uint16_t y, uint16_t r, uint16_t fc);
 /* gui draw line */
 void gui_draw_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color);
 /* gui box */
@@ -50,6 +52,8 @@ void gui_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc);
 void gui_box2(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint8_t mode);
 /* gui rect */
 void gui_rect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t fc);
+/* gui fill box */
+void gui_fill_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc);
 /* display button down */
 void display_button_down(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2);
 /* display button up */
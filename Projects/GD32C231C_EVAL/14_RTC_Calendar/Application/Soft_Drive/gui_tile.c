@@ -0,0 +1,436 @@
+/*!
+    \file  gui_tile.c
+    \brief gui tile layer, only the tiles whose content changed are sent to the lcd
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "gd32c2x1.h"
+#include "lcd_driver.h"
+#include "gui_tile.h"
+#include <string.h>
+
+/* font tables of font.h, defined in gui.c */
+extern const unsigned char asc16[];
+extern const unsigned char sz32[];
+
+#define GUI_TILE_BITMAP_SIZE        ((GUI_TILE_NUM + 7U) / 8U)
+#define GUI_TILE_PIXELS             (GUI_TILE_SIZE * GUI_TILE_SIZE)
+
+/* display lists of the frame on the panel and of the frame being built */
+static gui_tile_list_struct gui_tile_list[2];
+static uint8_t gui_tile_shown_list = 0U;
+static uint8_t gui_tile_current = 1U;
+static uint16_t gui_tile_bc = 0U;
+/* the panel content is unknown, every tile is sent on the next flush */
+static FlagStatus gui_tile_forced = RESET;
+
+/* tiles covered by the current frame and by the frame on the panel */
+static uint8_t gui_tile_dirty[GUI_TILE_BITMAP_SIZE];
+static uint8_t gui_tile_shown[GUI_TILE_BITMAP_SIZE];
+
+/* one tile is rendered while the other one is sent by DMA */
+static uint16_t gui_tile_buffer[2][GUI_TILE_PIXELS];
+
+static ErrStatus gui_tile_add(gui_tile_item_struct *item);
+static void gui_tile_render(uint16_t tx, uint16_t ty, uint16_t *buffer);
+static FlagStatus gui_tile_covers(const gui_tile_item_struct *item, uint16_t tx, uint16_t ty);
+static FlagStatus gui_tile_item_same(const gui_tile_item_struct *a, const gui_tile_item_struct *b);
+static FlagStatus gui_tile_unchanged(uint16_t tx, uint16_t ty);
+
+/*!
+    \brief      initialize the tile layer, the panel must be cleared to bc
+    \param[in]  bc: color of the cleared panel, also used as frame background
+    \param[out] none
+    \retval     none
+*/
+void gui_tile_init(uint16_t bc)
+{
+    gui_tile_bc = bc;
+    gui_tile_forced = RESET;
+    memset(gui_tile_dirty, 0, sizeof(gui_tile_dirty));
+    memset(gui_tile_shown, 0, sizeof(gui_tile_shown));
+
+    /* every tile shows the background, the frame on the panel is empty */
+    gui_tile_list[0].count = 0U;
+    gui_tile_list[0].text_length = 0U;
+    gui_tile_list[1].count = 0U;
+    gui_tile_list[1].text_length = 0U;
+    gui_tile_shown_list = 0U;
+    gui_tile_current = 1U;
+}
+
+/*!
+    \brief      force every tile to be sent on the next flush
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gui_tile_invalidate(void)
+{
+    gui_tile_forced = SET;
+    memset(gui_tile_shown, 0xFF, sizeof(gui_tile_shown));
+}
+
+/*!
+    \brief      start a new frame
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gui_tile_begin(void)
+{
+    /* the list of the frame on the panel is kept for gui_tile_flush */
+    gui_tile_current = gui_tile_shown_list ^ 1U;
+    gui_tile_list[gui_tile_current].count = 0U;
+    gui_tile_list[gui_tile_current].text_length = 0U;
+    memset(gui_tile_dirty, 0, sizeof(gui_tile_dirty));
+}
+
+/*!
+    \brief      add a filled rectangle to the frame
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the rectangle
+    \param[in]  h: the height of the rectangle
+    \param[in]  color: lcd display color
+    \param[out] none
+    \retval     ErrStatus: ERROR if the display list is full, SUCCESS otherwise
+*/
+ErrStatus gui_tile_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    gui_tile_item_struct item;
+
+    item.type = GUI_TILE_FILL;
+    item.x = x;
+    item.y = y;
+    item.w = w;
+    item.h = h;
+    item.fc = color;
+    item.bc = color;
+    item.num = 0U;
+    item.s = NULL;
+
+    return gui_tile_add(&item);
+}
+
+/*!
+    \brief      add a 8x16 ASCII string to the frame, as drawn by gui_draw_font_gbk16/gbk24
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  fc: lcd display color
+    \param[in]  bc: display color of font, transparent if it equals fc
+    \param[in]  s: one line of display chars, copied into the frame
+    \param[out] none
+    \retval     ErrStatus: ERROR if the display list or the frame text is full, SUCCESS otherwise
+*/
+ErrStatus gui_tile_draw_font(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s)
+{
+    gui_tile_item_struct item;
+
+    item.type = GUI_TILE_FONT;
+    item.x = x;
+    item.y = y;
+    item.w = (uint16_t)(strlen(s) * 8U);
+    item.h = 16U;
+    item.fc = fc;
+    item.bc = bc;
+    item.num = 0U;
+    item.s = s;
+
+    return gui_tile_add(&item);
+}
+
+/*!
+    \brief      add a 32x32 digit to the frame, as drawn by gui_draw_font_num32
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  fc: lcd display color
+    \param[in]  bc: display color of font, transparent if it equals fc
+    \param[in]  num: display num
+    \param[out] none
+    \retval     ErrStatus: ERROR if the display list is full, SUCCESS otherwise
+*/
+ErrStatus gui_tile_draw_font_num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num)
+{
+    gui_tile_item_struct item;
+
+    item.type = GUI_TILE_NUM32;
+    item.x = x;
+    item.y = y;
+    item.w = 32U;
+    item.h = 32U;
+    item.fc = fc;
+    item.bc = bc;
+    item.num = num;
+    item.s = NULL;
+
+    return gui_tile_add(&item);
+}
+
+/*!
+    \brief      send the changed tiles of the frame to the lcd, a tile is skipped only
+                when the primitives covering it are the same as in the frame on the panel
+    \param[in]  none
+    \param[out] none
+    \retval     number of tiles sent, each one costs GUI_TILE_PIXELS * 2 bytes of pixels
+*/
+uint16_t gui_tile_flush(void)
+{
+    uint16_t tx, ty, index, sent = 0U;
+    uint8_t mask, half = 0U;
+
+    for(ty = 0U; ty < GUI_TILE_Y_NUM; ty ++) {
+        for(tx = 0U; tx < GUI_TILE_X_NUM; tx ++) {
+            index = ty * GUI_TILE_X_NUM + tx;
+            mask = (uint8_t)(1U << (index & 7U));
+
+            /* tiles out of both frames still show the background */
+            if(0U == ((gui_tile_dirty[index >> 3] | gui_tile_shown[index >> 3]) & mask)) {
+                continue;
+            }
+
+            /* the same primitives render the same pixels */
+            if((RESET == gui_tile_forced) && (SET == gui_tile_unchanged(tx, ty))) {
+                continue;
+            }
+
+            gui_tile_render(tx, ty, gui_tile_buffer[half]);
+            lcd_blit(tx * GUI_TILE_SIZE, ty * GUI_TILE_SIZE, GUI_TILE_SIZE, GUI_TILE_SIZE,
+                     gui_tile_buffer[half], NULL);
+            half ^= 1U;
+            sent ++;
+        }
+    }
+    lcd_dma_wait();
+
+    memcpy(gui_tile_shown, gui_tile_dirty, sizeof(gui_tile_shown));
+    gui_tile_shown_list = gui_tile_current;
+    gui_tile_forced = RESET;
+
+    return sent;
+}
+
+/*!
+    \brief      add a primitive to the display list and mark the tiles it covers
+    \param[in]  item: the primitive
+    \param[out] none
+    \retval     ErrStatus: ERROR if the display list or the frame text is full, SUCCESS otherwise
+*/
+static ErrStatus gui_tile_add(gui_tile_item_struct *item)
+{
+    gui_tile_list_struct *list = &gui_tile_list[gui_tile_current];
+    uint16_t tx, ty, tx1, ty1, index, length;
+
+    if(list->count >= GUI_TILE_ITEM_NUM) {
+        return ERROR;
+    }
+    if((0U == item->w) || (0U == item->h) || (item->x >= X_MAX_PIXEL) || (item->y >= Y_MAX_PIXEL)) {
+        return SUCCESS;
+    }
+
+    /* the strings are kept with the frame, the next frame is compared with them */
+    if(GUI_TILE_FONT == item->type) {
+        length = item->w / 8U;
+        if((list->text_length + length) > GUI_TILE_TEXT_SIZE) {
+            return ERROR;
+        }
+        memcpy(&list->text[list->text_length], item->s, length);
+        item->s = &list->text[list->text_length];
+        list->text_length += length;
+    }
+
+    list->item[list->count ++] = *item;
+
+    tx1 = (uint16_t)((item->x + item->w - 1U) / GUI_TILE_SIZE);
+    ty1 = (uint16_t)((item->y + item->h - 1U) / GUI_TILE_SIZE);
+    if(tx1 >= GUI_TILE_X_NUM) {
+        tx1 = GUI_TILE_X_NUM - 1U;
+    }
+    if(ty1 >= GUI_TILE_Y_NUM) {
+        ty1 = GUI_TILE_Y_NUM - 1U;
+    }
+
+    for(ty = item->y / GUI_TILE_SIZE; ty <= ty1; ty ++) {
+        for(tx = item->x / GUI_TILE_SIZE; tx <= tx1; tx ++) {
+            index = ty * GUI_TILE_X_NUM + tx;
+            gui_tile_dirty[index >> 3] |= (uint8_t)(1U << (index & 7U));
+        }
+    }
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      render the display list into one tile
+    \param[in]  tx: the column of the tile
+    \param[in]  ty: the row of the tile
+    \param[out] buffer: GUI_TILE_PIXELS RGB565 pixels
+    \retval     none
+*/
+static void gui_tile_render(uint16_t tx, uint16_t ty, uint16_t *buffer)
+{
+    uint16_t i, x, y, x0, y0, x1, y1, col, row, k;
+    uint8_t bits;
+    uint16_t *p;
+    const gui_tile_list_struct *list = &gui_tile_list[gui_tile_current];
+    const gui_tile_item_struct *item;
+
+    for(i = 0U; i < GUI_TILE_PIXELS; i ++) {
+        buffer[i] = gui_tile_bc;
+    }
+
+    for(i = 0U; i < list->count; i ++) {
+        item = &list->item[i];
+
+        /* intersection of the primitive and the tile */
+        x0 = tx * GUI_TILE_SIZE;
+        y0 = ty * GUI_TILE_SIZE;
+        x1 = x0 + GUI_TILE_SIZE;
+        y1 = y0 + GUI_TILE_SIZE;
+        if(item->x > x0) {
+            x0 = item->x;
+        }
+        if(item->y > y0) {
+            y0 = item->y;
+        }
+        if((uint32_t)item->x + item->w < x1) {
+            x1 = item->x + item->w;
+        }
+        if((uint32_t)item->y + item->h < y1) {
+            y1 = item->y + item->h;
+        }
+        if((x0 >= x1) || (y0 >= y1)) {
+            continue;
+        }
+
+        for(y = y0; y < y1; y ++) {
+            p = &buffer[(y % GUI_TILE_SIZE) * GUI_TILE_SIZE + (x0 % GUI_TILE_SIZE)];
+            row = y - item->y;
+            for(x = x0; x < x1; x ++, p ++) {
+                col = x - item->x;
+                if(GUI_TILE_FILL == item->type) {
+                    *p = item->fc;
+                    continue;
+                }
+
+                if(GUI_TILE_FONT == item->type) {
+                    k = (uint8_t)item->s[col >> 3];
+                    k = (k > 32U) ? (k - 32U) : 0U;
+                    bits = asc16[k * 16U + row];
+                } else {
+                    bits = sz32[item->num * 32U * 4U + row * 4U + (col >> 3)];
+                }
+
+                if(bits & (0x80U >> (col & 7U))) {
+                    *p = item->fc;
+                } else if(item->fc != item->bc) {
+                    *p = item->bc;
+                }
+            }
+        }
+    }
+}
+
+/*!
+    \brief      check whether a primitive covers a tile
+    \param[in]  item: the primitive
+    \param[in]  tx: the column of the tile
+    \param[in]  ty: the row of the tile
+    \param[out] none
+    \retval     SET if the primitive draws in the tile, RESET otherwise
+*/
+static FlagStatus gui_tile_covers(const gui_tile_item_struct *item, uint16_t tx, uint16_t ty)
+{
+    uint32_t x0 = (uint32_t)tx * GUI_TILE_SIZE;
+    uint32_t y0 = (uint32_t)ty * GUI_TILE_SIZE;
+
+    if((item->x >= x0 + GUI_TILE_SIZE) || ((uint32_t)item->x + item->w <= x0) ||
+            (item->y >= y0 + GUI_TILE_SIZE) || ((uint32_t)item->y + item->h <= y0)) {
+        return RESET;
+    }
+
+    return SET;
+}
+
+/*!
+    \brief      compare two primitives
+    \param[in]  a: the first primitive
+    \param[in]  b: the second primitive
+    \param[out] none
+    \retval     SET if they draw the same pixels, RESET otherwise
+*/
+static FlagStatus gui_tile_item_same(const gui_tile_item_struct *a, const gui_tile_item_struct *b)
+{
+    if((a->type != b->type) || (a->x != b->x) || (a->y != b->y) || (a->w != b->w) || (a->h != b->h) ||
+            (a->fc != b->fc) || (a->bc != b->bc) || (a->num != b->num)) {
+        return RESET;
+    }
+    if((GUI_TILE_FONT == a->type) && (0 != memcmp(a->s, b->s, a->w / 8U))) {
+        return RESET;
+    }
+
+    return SET;
+}
+
+/*!
+    \brief      check whether a tile renders as in the frame on the panel, the
+                primitives covering it must be the same and in the same order
+    \param[in]  tx: the column of the tile
+    \param[in]  ty: the row of the tile
+    \param[out] none
+    \retval     SET if the tile on the panel is up to date, RESET otherwise
+*/
+static FlagStatus gui_tile_unchanged(uint16_t tx, uint16_t ty)
+{
+    const gui_tile_list_struct *now = &gui_tile_list[gui_tile_current];
+    const gui_tile_list_struct *shown = &gui_tile_list[gui_tile_shown_list];
+    uint8_t i = 0U, j = 0U;
+
+    while(1) {
+        while((i < now->count) && (RESET == gui_tile_covers(&now->item[i], tx, ty))) {
+            i ++;
+        }
+        while((j < shown->count) && (RESET == gui_tile_covers(&shown->item[j], tx, ty))) {
+            j ++;
+        }
+        if((i >= now->count) || (j >= shown->count)) {
+            break;
+        }
+        if(RESET == gui_tile_item_same(&now->item[i], &shown->item[j])) {
+            return RESET;
+        }
+        i ++;
+        j ++;
+    }
+
+    return ((i >= now->count) && (j >= shown->count)) ? SET : RESET;
+}
@@ -0,0 +1,94 @@
+/*!
+    \file  gui_tile.h
+    \brief the header file of gui tile layer
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef GUI_TILE_H
+#define GUI_TILE_H
+
+#include "gd32c2x1.h"
+#include "lcd_driver.h"
+
+/* tile size in pixels, the panel is split into GUI_TILE_X_NUM * GUI_TILE_Y_NUM tiles */
+#define GUI_TILE_SIZE               16U
+#define GUI_TILE_X_NUM              (X_MAX_PIXEL / GUI_TILE_SIZE)
+#define GUI_TILE_Y_NUM              (Y_MAX_PIXEL / GUI_TILE_SIZE)
+#define GUI_TILE_NUM                (GUI_TILE_X_NUM * GUI_TILE_Y_NUM)
+
+/* maximum number of primitives drawn in one frame */
+#define GUI_TILE_ITEM_NUM           24U
+/* maximum number of chars of the strings drawn in one frame */
+#define GUI_TILE_TEXT_SIZE          128U
+
+/* primitive type */
+#define GUI_TILE_FILL               0x00U
+#define GUI_TILE_FONT               0x01U
+#define GUI_TILE_NUM32              0x02U
+
+/* primitive of the frame display list */
+typedef struct {
+    uint8_t type;                   /*!< GUI_TILE_FILL, GUI_TILE_FONT or GUI_TILE_NUM32 */
+    uint16_t x;                     /*!< the x position of the start point */
+    uint16_t y;                     /*!< the y position of the start point */
+    uint16_t w;                     /*!< the width of the primitive */
+    uint16_t h;                     /*!< the height of the primitive */
+    uint16_t fc;                    /*!< foreground color */
+    uint16_t bc;                    /*!< background color, transparent if it equals fc */
+    uint16_t num;                   /*!< digit of GUI_TILE_NUM32 */
+    const char *s;                  /*!< string of GUI_TILE_FONT, w / 8 chars in the frame text */
+} gui_tile_item_struct;
+
+/* display list of one frame */
+typedef struct {
+    gui_tile_item_struct item[GUI_TILE_ITEM_NUM];
+    uint8_t count;                  /*!< number of primitives */
+    uint8_t text_length;            /*!< number of chars used in text */
+    char text[GUI_TILE_TEXT_SIZE];  /*!< copy of the strings of the primitives */
+} gui_tile_list_struct;
+
+/* initialize the tile layer, the panel must be cleared to bc */
+void gui_tile_init(uint16_t bc);
+/* force every tile to be sent on the next flush */
+void gui_tile_invalidate(void);
+/* start a new frame */
+void gui_tile_begin(void);
+/* add a filled rectangle to the frame */
+ErrStatus gui_tile_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color);
+/* add a 8x16 ASCII string to the frame */
+ErrStatus gui_tile_draw_font(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s);
+/* add a 32x32 digit to the frame */
+ErrStatus gui_tile_draw_font_num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num);
+/* send the changed tiles of the frame to the lcd */
+uint16_t gui_tile_flush(void);
+
+#endif /* GUI_TILE_H */
@@ -36,16 +36,23 @@ OF SUCH DAMAGE.
 #include "lcd_driver.h"
 #include "systick.h"
 
-#ifdef H_VIEW
-#define X_MAX_PIXEL         (uint16_t)320
-#define Y_MAX_PIXEL         (uint16_t)240
-#else
-#define X_MAX_PIXEL         (uint16_t)240
-#define Y_MAX_PIXEL         (uint16_t)320
-#endif
+/* lcd DMA transfer state */
+static __IO FlagStatus lcd_dma_state = RESET;
+/* SPI still in 16-bit DMA mode, restored by the foreground after the last pixel */
+static FlagStatus lcd_dma_release_pending = RESET;
+static __IO uint32_t lcd_dma_remain = 0U;
+static __IO uint32_t lcd_dma_memory = 0U;
+static uint8_t lcd_dma_memory_inc = DMA_MEMORY_INCREASE_DISABLE;
+static lcd_dma_callback lcd_dma_done = NULL;
+static uint16_t lcd_dma_color;
 
 static uint8_t spi_write_byte(uint32_t spi_periph, uint8_t byte);
 static void spi1_init(void);
+static void spi1_dma_init(void);
+static void lcd_dma_start(uint32_t memory, uint32_t number, uint8_t memory_inc, lcd_dma_callback callback);
+static void lcd_dma_block_start(void);
+static void lcd_dma_stop(void);
+static void lcd_dma_release(void);
 static void lcd_write_index(uint8_t index);
 static void lcd_write_data(uint8_t data);
 static void lcd_write_data_16bit(uint8_t datah, uint8_t datal);
@@ -111,6 +118,45 @@ static void spi1_init(void)
     spi_enable(SPI1);
 }
 
+/*!
+    \brief      initialize the DMA channel which streams pixels to SPI1
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void spi1_dma_init(void)
+{
+    dma_parameter_struct dma_init_struct;
+
+    /* enable DMA clock */
+    rcu_periph_clock_enable(RCU_DMA);
+    rcu_periph_clock_enable(RCU_DMAMUX);
+
+    /* SPI1 transmits 16-bit pixels, the memory address is set for each transfer */
+    dma_deinit(LCD_DMA_CHANNEL);
+    dma_struct_para_init(&dma_init_struct);
+    dma_init_struct.request      = DMA_REQUEST_SPI1_TX;
+    dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+    dma_init_struct.memory_addr  = (uint32_t)(uintptr_t)&lcd_dma_color;
+    dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_DISABLE;
+    dma_init_struct.memory_width = DMA_MEMORY_WIDTH_16BIT;
+    dma_init_struct.number       = 0U;
+    dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&SPI_DATA(SPI1);
+    dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+    dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_16BIT;
+    dma_init_struct.priority     = DMA_PRIORITY_HIGH;
+    dma_init(LCD_DMA_CHANNEL, &dma_init_struct);
+
+    /* configure DMA mode */
+    dma_circulation_disable(LCD_DMA_CHANNEL);
+    dma_memory_to_memory_disable(LCD_DMA_CHANNEL);
+    dmamux_synchronization_disable(LCD_DMA_MUXCH);
+
+    /* enable DMA transfer complete and error interrupt */
+    dma_interrupt_enable(LCD_DMA_CHANNEL, DMA_INT_FTF | DMA_INT_ERR);
+    nvic_irq_enable(LCD_DMA_IRQn, 0);
+}
+
 /*!
     \brief      write the register address
     \param[in]  index: the value of register address to be written
@@ -171,6 +217,7 @@ static void lcd_reset(void)
 void lcd_init(void)
 {
     spi1_init();
+    spi1_dma_init();
 
     LCD_CS_CLR;
     lcd_reset();
@@ -315,6 +362,7 @@ void lcd_init(void)
 */
 void lcd_set_region(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
 {
+    lcd_dma_wait();
     LCD_CS_CLR;
 
     /* write the register address 0x2A*/
@@ -341,6 +389,9 @@ void lcd_set_region(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t
 */
 void lcd_set_xy(uint16_t x, uint16_t y)
 {
+    lcd_dma_wait();
+    LCD_CS_CLR;
+
     /* write the register address 0x2A*/
     lcd_write_index(0x2A);
     lcd_write_data_16bit(x >> 8, x);
@@ -376,17 +427,260 @@ void gui_draw_point(uint16_t x, uint16_t y, uint16_t data)
 */
 void lcd_clear(uint16_t color)
 {
-    unsigned int i, m;
+    lcd_fill_rect(0, 0, X_MAX_PIXEL, Y_MAX_PIXEL, color, NULL);
+    lcd_dma_wait();
+}
+
+/*!
+    \brief      fill a rectangle of the lcd with one color by DMA
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the rectangle
+    \param[in]  h: the height of the rectangle
+    \param[in]  color: lcd display color
+    \param[in]  callback: function called in the DMA interrupt once the pixels are handed to the SPI, NULL if not used
+    \param[out] none
+    \retval     none
+*/
+void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, lcd_dma_callback callback)
+{
+    uint32_t number;
+
+    if((0U == w) || (0U == h)) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+
     /* set lcd display region */
-    lcd_set_region(0, 0, X_MAX_PIXEL - 1, Y_MAX_PIXEL - 1);
-    LCD_RS_SET;
+    lcd_set_region(x, y, x + w - 1, y + h - 1);
 
-    LCD_CS_CLR;
-    for(i = 0; i < Y_MAX_PIXEL; i ++) {
-        for(m = 0; m < X_MAX_PIXEL; m ++) {
+    if(((uint32_t)w * h) < LCD_DMA_MIN_PIXELS) {
+        LCD_RS_SET;
+        LCD_CS_CLR;
+        for(number = (uint32_t)w * h; number > 0U; number --) {
             spi_write_byte(SPI1, color >> 8);
             spi_write_byte(SPI1, color);
         }
+        LCD_CS_SET;
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+
+    /* the DMA reads the same color for every pixel */
+    lcd_dma_color = color;
+    lcd_dma_start((uint32_t)(uintptr_t)&lcd_dma_color, (uint32_t)w * h, DMA_MEMORY_INCREASE_DISABLE, callback);
+}
+
+/*!
+    \brief      copy a pixel buffer to a rectangle of the lcd by DMA
+    \param[in]  x: the x position of the start point
+    \param[in]  y: the y position of the start point
+    \param[in]  w: the width of the rectangle
+    \param[in]  h: the height of the rectangle
+    \param[in]  pixels: RGB565 pixels in row order, must stay valid until the transfer is done
+    \param[in]  callback: function called in the DMA interrupt once the pixels are handed to the SPI, NULL if not used
+    \param[out] none
+    \retval     none
+*/
+void lcd_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels, lcd_dma_callback callback)
+{
+    if((0U == w) || (0U == h)) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+
+    /* set lcd display region */
+    lcd_set_region(x, y, x + w - 1, y + h - 1);
+
+    lcd_write_pixels(pixels, (uint32_t)w * h, callback);
+}
+
+/*!
+    \brief      send pixels to the region set by lcd_set_region by DMA, consecutive
+                calls continue where the previous one stopped
+    \param[in]  pixels: RGB565 pixels, must stay valid until the transfer is done
+    \param[in]  number: number of pixels to be sent
+    \param[in]  callback: function called in the DMA interrupt once the pixels are handed to the SPI, NULL if not used
+    \param[out] none
+    \retval     none
+*/
+void lcd_write_pixels(const uint16_t *pixels, uint32_t number, lcd_dma_callback callback)
+{
+    lcd_dma_wait();
+
+    if(0U == number) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+
+    lcd_dma_start((uint32_t)(uintptr_t)pixels, number, DMA_MEMORY_INCREASE_ENABLE, callback);
+}
+
+/*!
+    \brief      get the lcd DMA transfer state
+    \param[in]  none
+    \param[out] none
+    \retval     SET if a DMA transfer is on-going, RESET otherwise
+*/
+FlagStatus lcd_dma_busy(void)
+{
+    return lcd_dma_state;
+}
+
+/*!
+    \brief      wait for the lcd DMA transfer to complete and release the SPI
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void lcd_dma_wait(void)
+{
+    while(RESET != lcd_dma_state) {
+    }
+
+    if(RESET != lcd_dma_release_pending) {
+        lcd_dma_release();
+    }
+}
+
+/*!
+    \brief      lcd DMA channel interrupt service, call it from the DMA channel IRQ handler
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void lcd_dma_irq_handler(void)
+{
+    if(RESET != dma_interrupt_flag_get(LCD_DMA_CHANNEL, DMA_INT_FLAG_ERR)) {
+        dma_interrupt_flag_clear(LCD_DMA_CHANNEL, DMA_INT_FLAG_G);
+        /* abort the remaining blocks */
+        lcd_dma_remain = 0U;
+        lcd_dma_stop();
+    } else if(RESET != dma_interrupt_flag_get(LCD_DMA_CHANNEL, DMA_INT_FLAG_FTF)) {
+        dma_interrupt_flag_clear(LCD_DMA_CHANNEL, DMA_INT_FLAG_G);
+        if(0U != lcd_dma_remain) {
+            lcd_dma_block_start();
+        } else {
+            lcd_dma_stop();
+        }
+    }
+}
+
+/*!
+    \brief      start streaming pixels to the region set by lcd_set_region
+    \param[in]  memory: address of the first pixel
+    \param[in]  number: number of pixels to be sent
+    \param[in]  memory_inc: DMA_MEMORY_INCREASE_ENABLE or DMA_MEMORY_INCREASE_DISABLE
+    \param[in]  callback: function called when all the pixels are sent
+    \param[out] none
+    \retval     none
+*/
+static void lcd_dma_start(uint32_t memory, uint32_t number, uint8_t memory_inc, lcd_dma_callback callback)
+{
+    lcd_dma_state = SET;
+    lcd_dma_release_pending = SET;
+    lcd_dma_memory = memory;
+    lcd_dma_remain = number;
+    lcd_dma_memory_inc = memory_inc;
+    lcd_dma_done = callback;
+
+    if(DMA_MEMORY_INCREASE_ENABLE == memory_inc) {
+        dma_memory_increase_enable(LCD_DMA_CHANNEL);
+    } else {
+        dma_memory_increase_disable(LCD_DMA_CHANNEL);
+    }
+
+    /* one 16-bit frame per pixel, sent high byte first */
+    spi_disable(SPI1);
+    spi_i2s_data_frame_format_config(SPI1, SPI_FRAMESIZE_16BIT);
+    spi_fifo_access_size_config(SPI1, SPI_HALFWORD_ACCESS);
+    spi_enable(SPI1);
+
+    LCD_RS_SET;
+    LCD_CS_CLR;
+    spi_dma_enable(SPI1, SPI_DMA_TRANSMIT);
+    lcd_dma_block_start();
+}
+
+/*!
+    \brief      start the next DMA block of the current transfer
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void lcd_dma_block_start(void)
+{
+    uint32_t number = lcd_dma_remain;
+
+    /* the DMA counter is 16 bits wide */
+    if(number > LCD_DMA_BLOCK_SIZE) {
+        number = LCD_DMA_BLOCK_SIZE;
+    }
+
+    dma_channel_disable(LCD_DMA_CHANNEL);
+    dma_memory_address_config(LCD_DMA_CHANNEL, lcd_dma_memory);
+    dma_transfer_number_config(LCD_DMA_CHANNEL, number);
+
+    lcd_dma_remain -= number;
+    if(DMA_MEMORY_INCREASE_ENABLE == lcd_dma_memory_inc) {
+        lcd_dma_memory += number * sizeof(uint16_t);
+    }
+
+    dma_channel_enable(LCD_DMA_CHANNEL);
+}
+
+/*!
+    \brief      end the current transfer in the DMA interrupt, the SPI is released by lcd_dma_wait
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void lcd_dma_stop(void)
+{
+    lcd_dma_callback callback = lcd_dma_done;
+
+    dma_channel_disable(LCD_DMA_CHANNEL);
+
+    lcd_dma_done = NULL;
+    lcd_dma_state = RESET;
+
+    if(NULL != callback) {
+        callback();
     }
+}
+
+/*!
+    \brief      wait for the last pixel to leave the SPI and restore the SPI for byte access
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void lcd_dma_release(void)
+{
+    /* wait until the last pixel is shifted out */
+    while(RESET != (SPI_STAT(SPI1) & SPI_STAT_TXLVL));
+    while(RESET != (SPI_STAT(SPI1) & SPI_FLAG_TRANS));
+    spi_dma_disable(SPI1, SPI_DMA_TRANSMIT);
     LCD_CS_SET;
+
+    spi_disable(SPI1);
+    spi_i2s_data_frame_format_config(SPI1, SPI_FRAMESIZE_8BIT);
+    spi_fifo_access_size_config(SPI1, SPI_BYTE_ACCESS);
+    spi_enable(SPI1);
+
+    /* drop the data received while sending, spi_write_byte relies on RBNE */
+    while(RESET != (SPI_STAT(SPI1) & SPI_FLAG_RBNE)) {
+        (void)SPI_DATA(SPI1);
+    }
+    (void)SPI_STAT(SPI1);
+
+    lcd_dma_release_pending = RESET;
 }
@@ -36,6 +36,10 @@ OF SUCH DAMAGE.
 #define GD32C2X1_IT_H
 
 #include "gd32c2x1.h"
+#include "sched.h"
+
+/* scheduler event of the user key interrupt */
+#define KEY_EVENT                   SCHED_EVENT(0U)
 
 /* function declarations */
 /* this function handles NMI exception */
@@ -48,5 +52,7 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 /* this function handles SysTick exception */
 void SysTick_Handler(void);
+/* this function handles external line 4 interrupt request */
+void EXTI4_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
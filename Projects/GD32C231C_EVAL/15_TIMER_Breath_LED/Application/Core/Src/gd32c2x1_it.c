@@ -105,4 +105,20 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
     delay_decrement();
+    sched_tick_handler();
+}
+
+/*!
+    \brief      this function handles external line 4 interrupt request
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void EXTI4_IRQHandler(void)
+{
+    if(RESET != exti_interrupt_flag_get(EXTI_4)) {
+        /* the key task debounces the press */
+        sched_event_set(KEY_EVENT);
+        exti_interrupt_flag_clear(EXTI_4);
+    }
 }
@@ -36,9 +36,23 @@ OF SUCH DAMAGE.
 #include "systick.h"
 #include <stdio.h>
 #include "gd32c231c_eval.h"
+#include "gd32c2x1_it.h"
+#include "sched.h"
+
+/* breathing step period in milliseconds */
+#define BREATHE_PERIOD              40U
+/* key debounce time in milliseconds */
+#define KEY_DEBOUNCE                20U
+
+static int16_t breathe_pulse = 0;
+static FlagStatus breathe_flag = SET;
+static FlagStatus breathe_pause = RESET;
+static uint8_t key_task_id = SCHED_TASK_INVALID;
 
 void gpio_config(void);
 void timer_config(void);
+void breathe_task(uint32_t events);
+void key_task(uint32_t events);
 
 /**
     \brief      configure the GPIO ports
@@ -117,6 +131,50 @@ void timer_config(void)
     timer_enable(TIMER0);
 }
 
+/*!
+    \brief      step the LED brightness, runs every BREATHE_PERIOD milliseconds
+    \param[in]  events: not used
+    \param[out] none
+    \retval     none
+*/
+void breathe_task(uint32_t events)
+{
+    (void)events;
+
+    if(SET == breathe_pause) {
+        return;
+    }
+    if(SET == breathe_flag) {
+        breathe_pulse = breathe_pulse + 10;
+    } else {
+        breathe_pulse = breathe_pulse - 10;
+    }
+    if(500 < breathe_pulse) {
+        breathe_flag = RESET;
+    }
+    if(0 >= breathe_pulse) {
+        breathe_flag = SET;
+    }
+    /* configure TIMER channel output pulse value */
+    timer_channel_output_pulse_value_config(TIMER0, TIMER_CH_0, breathe_pulse);
+}
+
+/*!
+    \brief      pause or resume the breathing on a debounced user key press
+    \param[in]  events: KEY_EVENT on the key interrupt, 0 when the debounce time is over
+    \param[out] none
+    \retval     none
+*/
+void key_task(uint32_t events)
+{
+    if(0U != (events & KEY_EVENT)) {
+        /* check the key again after the bounce */
+        sched_task_delay(key_task_id, KEY_DEBOUNCE);
+    } else if(SET == gd_eval_key_state_get(KEY_USER)) {
+        breathe_pause = (SET == breathe_pause) ? RESET : SET;
+    }
+}
+
 /*!
     \brief      main function
     \param[in]  none
@@ -125,33 +183,21 @@ void timer_config(void)
 */
 int main(void)
 {
-    int16_t i = 0;
-    FlagStatus breathe_flag = SET;
-
     /* configure the GPIO ports */
     gpio_config();
 
     /* configure the TIMER peripheral */
     timer_config();
 
+    /* configure the user key to interrupt on a press */
+    gd_eval_key_init(KEY_USER, KEY_MODE_EXTI);
+
     /* configure systick */
     systick_config();
 
-    while(1) {
-        /* delay a time in milliseconds */
-        delay_ms(40);
-        if(SET == breathe_flag) {
-            i = i + 10;
-        } else {
-            i = i - 10;
-        }
-        if(500 < i) {
-            breathe_flag = RESET;
-        }
-        if(0 >= i) {
-            breathe_flag = SET;
-        }
-        /* configure TIMER channel output pulse value */
-        timer_channel_output_pulse_value_config(TIMER0, TIMER_CH_0, i);
-    }
+    /* the LED breathes in a timed task, the key runs an event task, the MCU sleeps in between */
+    sched_init();
+    sched_task_create(breathe_task, BREATHE_PERIOD, 0U);
+    key_task_id = sched_task_create(key_task, 0U, KEY_EVENT);
+    sched_run();
 }
@@ -0,0 +1,397 @@
+/*!
+    \file  sched.c
+    \brief cooperative run to completion task scheduler with tickless idle
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "sched.h"
+#include <stddef.h>
+
+#ifndef SCHED_STOPPED_CLOCKS
+/* SysTick clocks lost each time the idle path stops and restarts the counter */
+#define SCHED_STOPPED_CLOCKS        12U
+#endif /* SCHED_STOPPED_CLOCKS */
+
+/* task control block */
+typedef struct {
+    sched_task_func func;           /*!< task function */
+    uint32_t period;                /*!< period in milliseconds, 0 for one-shot runs */
+    uint32_t deadline;              /*!< tick of the next timed run */
+    uint32_t event_mask;            /*!< events which run the task */
+    uint8_t timed;                  /*!< the deadline is armed */
+} sched_task_struct;
+
+static sched_task_struct sched_task[SCHED_TASK_NUM];
+static uint8_t sched_task_count = 0U;
+/* events any task waits for */
+static uint32_t sched_event_mask = 0U;
+static volatile uint32_t sched_event = 0U;
+static volatile uint32_t sched_tick = 0U;
+
+static uint32_t sched_irq_save(void);
+static void sched_irq_restore(uint32_t primask);
+#ifndef SCHED_HOST
+static void sched_idle(uint32_t wait);
+static void sched_systick_restart(uint32_t count, uint32_t cycles);
+#endif /* SCHED_HOST */
+
+/*!
+    \brief      initialize the scheduler, the 1ms SysTick of systick_config() is its time base
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void sched_init(void)
+{
+    sched_task_count = 0U;
+    sched_event_mask = 0U;
+    sched_event = 0U;
+    sched_tick = 0U;
+}
+
+/*!
+    \brief      add a task
+    \param[in]  func: task function
+    \param[in]  period: period in milliseconds, the first run is one period from now,
+                0 runs the task on events or after sched_task_delay() only
+    \param[in]  event_mask: SCHED_EVENT() flags which run the task, 0 for none
+    \param[out] none
+    \retval     task number, SCHED_TASK_INVALID if the task table is full
+*/
+uint8_t sched_task_create(sched_task_func func, uint32_t period, uint32_t event_mask)
+{
+    sched_task_struct *task;
+
+    if((SCHED_TASK_NUM <= sched_task_count) || (NULL == func)) {
+        return SCHED_TASK_INVALID;
+    }
+
+    task = &sched_task[sched_task_count];
+    task->func = func;
+    task->period = period;
+    task->deadline = sched_tick + period;
+    task->event_mask = event_mask;
+    task->timed = (0U != period) ? 1U : 0U;
+    sched_event_mask |= event_mask;
+
+    return sched_task_count++;
+}
+
+/*!
+    \brief      run a task once after a delay, a periodic task restarts its period, in task context only
+    \param[in]  task: task number of sched_task_create()
+    \param[in]  delay: delay in milliseconds, 0 runs the task in the next pass
+    \param[out] none
+    \retval     none
+*/
+void sched_task_delay(uint8_t task, uint32_t delay)
+{
+    if(sched_task_count > task) {
+        sched_task[task].deadline = sched_tick + delay;
+        sched_task[task].timed = 1U;
+    }
+}
+
+/*!
+    \brief      cancel the timed runs of a task, events still run it, in task context only
+    \param[in]  task: task number of sched_task_create()
+    \param[out] none
+    \retval     none
+*/
+void sched_task_stop(uint8_t task)
+{
+    if(sched_task_count > task) {
+        sched_task[task].timed = 0U;
+    }
+}
+
+/*!
+    \brief      set event flags, safe to call from interrupts
+    \param[in]  events: SCHED_EVENT() flags
+    \param[out] none
+    \retval     none
+*/
+void sched_event_set(uint32_t events)
+{
+    uint32_t primask = sched_irq_save();
+
+    sched_event |= events;
+    sched_irq_restore(primask);
+}
+
+/*!
+    \brief      get the time in milliseconds
+    \param[in]  none
+    \param[out] none
+    \retval     milliseconds since sched_init(), wraps after 49.7 days
+*/
+uint32_t sched_tick_get(void)
+{
+    return sched_tick;
+}
+
+/*!
+    \brief      account elapsed milliseconds, called by the tick interrupt and the idle path
+    \param[in]  count: elapsed milliseconds
+    \param[out] none
+    \retval     none
+*/
+void sched_tick_advance(uint32_t count)
+{
+    sched_tick += count;
+}
+
+/*!
+    \brief      run every task which is due or has a pending event once, in table order
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void sched_dispatch(void)
+{
+    sched_task_struct *task;
+    uint32_t primask, event, now;
+    uint8_t i, run;
+
+    /* take the pending events, one set delivers to every task waiting for it */
+    primask = sched_irq_save();
+    event = sched_event & sched_event_mask;
+    sched_event &= ~event;
+    sched_irq_restore(primask);
+
+    for(i = 0U; i < sched_task_count; i++) {
+        task = &sched_task[i];
+        run = (0U != (event & task->event_mask)) ? 1U : 0U;
+        now = sched_tick;
+
+        if((0U != task->timed) && (0 <= (int32_t)(now - task->deadline))) {
+            run = 1U;
+            if(0U == task->period) {
+                task->timed = 0U;
+            } else {
+                task->deadline += task->period;
+                /* skip the runs missed by a long task instead of running them back to back */
+                if(0 <= (int32_t)(now - task->deadline)) {
+                    task->deadline = now + task->period;
+                }
+            }
+        }
+
+        if(0U != run) {
+            task->func(event & task->event_mask);
+        }
+    }
+}
+
+/*!
+    \brief      get the milliseconds until the next task is due
+    \param[in]  none
+    \param[out] none
+    \retval     0 if a task is ready, SCHED_WAIT_FOREVER if only events can run a task
+*/
+uint32_t sched_wait_get(void)
+{
+    uint32_t wait = SCHED_WAIT_FOREVER;
+    uint32_t now = sched_tick;
+    int32_t left;
+    uint8_t i;
+
+    if(0U != (sched_event & sched_event_mask)) {
+        return 0U;
+    }
+
+    for(i = 0U; i < sched_task_count; i++) {
+        if(0U != sched_task[i].timed) {
+            left = (int32_t)(sched_task[i].deadline - now);
+            if(0 >= left) {
+                return 0U;
+            }
+            if((uint32_t)left < wait) {
+                wait = (uint32_t)left;
+            }
+        }
+    }
+
+    return wait;
+}
+
+#ifndef SCHED_HOST
+/*!
+    \brief      the SysTick interrupt part of the scheduler, call it from SysTick_Handler()
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void sched_tick_handler(void)
+{
+    sched_tick++;
+}
+
+/*!
+    \brief      run the tasks forever, the MCU sleeps in between
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void sched_run(void)
+{
+    uint32_t wait;
+
+    while(1) {
+        sched_dispatch();
+
+        /* an interrupt between the check and the WFI stays pending and wakes the MCU up at once */
+        __disable_irq();
+        wait = sched_wait_get();
+        if(0U != wait) {
+            sched_idle(wait);
+        }
+        __enable_irq();
+    }
+}
+
+/*!
+    \brief      sleep until the next deadline or an interrupt, called with the interrupts disabled
+    \param[in]  wait: milliseconds to the next deadline, at least 1
+    \param[out] none
+    \retval     none
+*/
+static void sched_idle(uint32_t wait)
+{
+    uint32_t cycles = SystemCoreClock / 1000U;
+    uint32_t max = SysTick_LOAD_RELOAD_Msk / cycles;
+    uint32_t count, ctrl, left, reload;
+
+    if(wait > max) {
+        wait = max;
+    }
+    /* the next tick wakes the MCU up anyway */
+    if(2U > wait) {
+        pmu_to_sleepmode(WFI_CMD);
+        return;
+    }
+
+    /* stop the tick, the read clears COUNTFLAG */
+    SysTick->CTRL &= ~SysTick_CTRL_ENABLE_Msk;
+    count = SysTick->VAL;
+    if((0U != (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) || (SCHED_STOPPED_CLOCKS >= count)) {
+        /* the tick is due, let its interrupt run first */
+        sched_systick_restart(count, cycles);
+        return;
+    }
+
+    /* one period from now to the deadline, the rest of the current tick plus the whole ticks */
+    reload = count - SCHED_STOPPED_CLOCKS + ((wait - 1U) * cycles);
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0U;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    /* reloaded after the long period, the counter goes on with 1ms ticks */
+    SysTick->LOAD = cycles - 1U;
+
+    pmu_to_sleepmode(WFI_CMD);
+
+    ctrl = SysTick->CTRL;
+    SysTick->CTRL = ctrl & ~SysTick_CTRL_ENABLE_Msk;
+    ctrl |= SysTick->CTRL;
+    count = SysTick->VAL;
+
+    if(0U != (ctrl & SysTick_CTRL_COUNTFLAG_Msk)) {
+        /* the deadline is reached, the pending SysTick interrupt counts the last tick */
+        sched_tick_advance(wait - 1U);
+        sched_systick_restart(count, cycles);
+    } else {
+        /* woken up early, count the whole ticks which elapsed and keep the tick phase */
+        if(0U == count) {
+            /* not reloaded yet */
+            count = reload;
+        }
+        left = (count + cycles - 1U) / cycles;
+        sched_tick_advance(wait - left);
+        sched_systick_restart(count - ((left - 1U) * cycles), cycles);
+    }
+}
+
+/*!
+    \brief      restart the 1ms tick
+    \param[in]  count: SysTick clocks to the next tick
+    \param[in]  cycles: SysTick clocks of 1ms
+    \param[out] none
+    \retval     none
+*/
+static void sched_systick_restart(uint32_t count, uint32_t cycles)
+{
+    if(count > SCHED_STOPPED_CLOCKS) {
+        count -= SCHED_STOPPED_CLOCKS;
+    }
+    if((2U > count) || (cycles < count)) {
+        count = cycles;
+    }
+
+    SysTick->LOAD = count - 1U;
+    SysTick->VAL = 0U;
+    SysTick->CTRL |= SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = cycles - 1U;
+}
+#endif /* SCHED_HOST */
+
+/*!
+    \brief      disable the interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     the previous PRIMASK
+*/
+static uint32_t sched_irq_save(void)
+{
+#ifdef SCHED_HOST
+    return 0U;
+#else
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    return primask;
+#endif /* SCHED_HOST */
+}
+
+/*!
+    \brief      restore the interrupts
+    \param[in]  primask: PRIMASK of sched_irq_save()
+    \param[out] none
+    \retval     none
+*/
+static void sched_irq_restore(uint32_t primask)
+{
+#ifdef SCHED_HOST
+    (void)primask;
+#else
+    __set_PRIMASK(primask);
+#endif /* SCHED_HOST */
+}
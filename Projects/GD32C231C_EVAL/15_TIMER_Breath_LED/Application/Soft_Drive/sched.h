@@ -0,0 +1,84 @@
+/*!
+    \file  sched.h
+    \brief the header file of the cooperative task scheduler
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef SCHED_H
+#define SCHED_H
+
+/* define SCHED_HOST to build the scheduler core only, e.g. on a host with a simulated clock */
+#ifdef SCHED_HOST
+#include <stdint.h>
+#else
+#include "gd32c2x1.h"
+#endif
+
+/* maximum number of tasks */
+#define SCHED_TASK_NUM              8U
+/* returned by sched_task_create() when the task table is full */
+#define SCHED_TASK_INVALID          0xFFU
+/* returned by sched_wait_get() when no task is timed and no event is pending */
+#define SCHED_WAIT_FOREVER          0xFFFFFFFFU
+
+/* event flags, each bit is one event */
+#define SCHED_EVENT(n)              ((uint32_t)1U << (n))
+
+/* task function, called with the events of its mask which were set since its last run */
+typedef void (*sched_task_func)(uint32_t events);
+
+/* initialize the scheduler, the 1ms SysTick of systick_config() is its time base */
+void sched_init(void);
+/* add a task, the first timed run is one period from now, a period of 0 runs on events or sched_task_delay() only */
+uint8_t sched_task_create(sched_task_func func, uint32_t period, uint32_t event_mask);
+/* run a task once after a delay in milliseconds, in task context only */
+void sched_task_delay(uint8_t task, uint32_t delay);
+/* cancel the timed runs of a task, in task context only */
+void sched_task_stop(uint8_t task);
+/* set event flags, safe to call from interrupts */
+void sched_event_set(uint32_t events);
+/* get the time in milliseconds */
+uint32_t sched_tick_get(void);
+/* account elapsed milliseconds, called by the tick interrupt and the idle path */
+void sched_tick_advance(uint32_t count);
+/* run every task which is due or has a pending event once */
+void sched_dispatch(void);
+/* get the milliseconds until the next task is due */
+uint32_t sched_wait_get(void);
+#ifndef SCHED_HOST
+/* the SysTick interrupt part of the scheduler */
+void sched_tick_handler(void);
+/* run the tasks forever, sleeping between them */
+void sched_run(void);
+#endif /* SCHED_HOST */
+
+#endif /* SCHED_H */
@@ -48,5 +48,7 @@ void SVC_Handler(void);
 void PendSV_Handler(void);
 /* this function handles SysTick exception */
 void SysTick_Handler(void);
+/* this function handles DMA_Channel0_IRQHandler interrupt */
+void DMA_Channel0_IRQHandler(void);
 
 #endif /* GD32C2X1_IT_H */
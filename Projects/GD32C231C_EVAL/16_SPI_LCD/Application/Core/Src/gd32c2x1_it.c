@@ -34,6 +34,7 @@ OF SUCH DAMAGE.
 
 #include "gd32c2x1_it.h"
 #include "systick.h"
+#include "lcd_driver.h"
 
 #define SRAM_ECC_ERROR_HANDLE(s)    do{}while(1)
 
@@ -106,3 +107,14 @@ void SysTick_Handler(void)
 {
     delay_decrement();
 }
+
+/*!
+    \brief      this function handles DMA_Channel0_IRQHandler interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void DMA_Channel0_IRQHandler(void)
+{
+    lcd_dma_irq_handler();
+}
@@ -184,12 +184,12 @@ struct typFNT_GB162 {
 
 const struct typFNT_GB162 hz16[] = {
 #if USE_ONCHIP_FLASH_FONT
-    "显", 0x00, 0x00, 0x1F, 0xF0, 0x10, 0x10, 0x10, 0x10, 0x1F, 0xF0, 0x10, 0x10, 0x10, 0x10, 0x1F, 0xF0, 0x04, 0x40, 0x44, 0x44, 0x24, 0x44, 0x14, 0x48, 0x14, 0x50, 0x04, 0x40, 0xFF, 0xFE, 0x00, 0x00,
-    "示", 0x00, 0x00, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFE, 0x01, 0x00, 0x01, 0x00, 0x11, 0x10, 0x11, 0x08, 0x21, 0x04, 0x41, 0x02, 0x81, 0x02, 0x05, 0x00, 0x02, 0x00,
-    "测", 0x00, 0x04, 0x27, 0xC4, 0x14, 0x44, 0x14, 0x54, 0x85, 0x54, 0x45, 0x54, 0x45, 0x54, 0x15, 0x54, 0x15, 0x54, 0x25, 0x54, 0xE5, 0x54, 0x21, 0x04, 0x22, 0x84, 0x22, 0x44, 0x24, 0x14, 0x08, 0x08,
-    "试", 0x00, 0x28, 0x20, 0x24, 0x10, 0x24, 0x10, 0x20, 0x07, 0xFE, 0x00, 0x20, 0xF0, 0x20, 0x17, 0xE0, 0x11, 0x20, 0x11, 0x10, 0x11, 0x10, 0x15, 0x10, 0x19, 0xCA, 0x17, 0x0A, 0x02, 0x06, 0x00, 0x02,
+    {"显", {0x00, 0x00, 0x1F, 0xF0, 0x10, 0x10, 0x10, 0x10, 0x1F, 0xF0, 0x10, 0x10, 0x10, 0x10, 0x1F, 0xF0, 0x04, 0x40, 0x44, 0x44, 0x24, 0x44, 0x14, 0x48, 0x14, 0x50, 0x04, 0x40, 0xFF, 0xFE, 0x00, 0x00}},
+    {"示", {0x00, 0x00, 0x3F, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFE, 0x01, 0x00, 0x01, 0x00, 0x11, 0x10, 0x11, 0x08, 0x21, 0x04, 0x41, 0x02, 0x81, 0x02, 0x05, 0x00, 0x02, 0x00}},
+    {"测", {0x00, 0x04, 0x27, 0xC4, 0x14, 0x44, 0x14, 0x54, 0x85, 0x54, 0x45, 0x54, 0x45, 0x54, 0x15, 0x54, 0x15, 0x54, 0x25, 0x54, 0xE5, 0x54, 0x21, 0x04, 0x22, 0x84, 0x22, 0x44, 0x24, 0x14, 0x08, 0x08}},
+    {"试", {0x00, 0x28, 0x20, 0x24, 0x10, 0x24, 0x10, 0x20, 0x07, 0xFE, 0x00, 0x20, 0xF0, 0x20, 0x17, 0xE0, 0x11, 0x20, 0x11, 0x10, 0x11, 0x10, 0x15, 0x10, 0x19, 0xCA, 0x17, 0x0A, 0x02, 0x06, 0x00, 0x02}},
 #endif
-    0x00,
+    {{0x00}},
 };
 
 struct typFNT_GB242 {
@@ -201,12 +201,12 @@ struct typFNT_GB242 {
 /* song typeface bold small 2 font */
 const struct typFNT_GB242 hz24[] = {
 #if USE_ONCHIP_FLASH_FONT
-    "显", 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x00, 0x0F, 0x03, 0xC0, 0x0C, 0x00, 0x40, 0x1F, 0xF8, 0x60, 0x18, 0x00, 0x60, 0x08, 0x00, 0x40, 0x0E, 0x01, 0xC0, 0x07, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x01, 0x84, 0x00, 0x01, 0x84, 0x00, 0x19, 0x87, 0x80, 0x0F, 0x8C, 0xE0, 0x07, 0x8C, 0x20, 0x00, 0xCC, 0x00, 0x03, 0xFF, 0xE0, 0x1F, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    "示", 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x1F, 0xFF, 0xC0, 0x00, 0x7F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xC0, 0x3F, 0xFF, 0xE0, 0x00, 0x30, 0x00, 0x00, 0x30, 0x00, 0x00, 0x30, 0x00, 0x06, 0x13, 0x00, 0x0C, 0x13, 0xC0, 0x0C, 0x18, 0xF0, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    "测", 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x39, 0xFC, 0x30, 0x1F, 0xCC, 0x30, 0x07, 0x06, 0xB0, 0x0F, 0x06, 0xF0, 0x19, 0x07, 0xB0, 0x31, 0x37, 0xB0, 0x31, 0x36, 0xF0, 0x1F, 0x27, 0xF0, 0x01, 0x67, 0xF0, 0x01, 0xE5, 0xF0, 0x01, 0xE1, 0xF0, 0x00, 0x41, 0xF0, 0x0C, 0xF8, 0xB0, 0x3C, 0xD8, 0x30, 0x00, 0x8C, 0x30, 0x00, 0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-    "试", 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x03, 0x60, 0x0C, 0x03, 0x70, 0x0C, 0x03, 0x30, 0x00, 0x3F, 0xE0, 0x00, 0x3F, 0x80, 0x08, 0x01, 0x00, 0x3C, 0x01, 0x80, 0x04, 0x7F, 0x80, 0x04, 0x7D, 0x80, 0x0C, 0x00, 0x80, 0x0C, 0x10, 0xC0, 0x0C, 0x10, 0xC0, 0x0C, 0x18, 0x40, 0x0C, 0x1C, 0x60, 0x0F, 0x7E, 0x60, 0x06, 0x70, 0x30, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    {"显", {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xFF, 0x00, 0x0F, 0x03, 0xC0, 0x0C, 0x00, 0x40, 0x1F, 0xF8, 0x60, 0x18, 0x00, 0x60, 0x08, 0x00, 0x40, 0x0E, 0x01, 0xC0, 0x07, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x01, 0x84, 0x00, 0x01, 0x84, 0x00, 0x19, 0x87, 0x80, 0x0F, 0x8C, 0xE0, 0x07, 0x8C, 0x20, 0x00, 0xCC, 0x00, 0x03, 0xFF, 0xE0, 0x1F, 0xFF, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"示", {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0E, 0x00, 0x00, 0x1F, 0xFF, 0xC0, 0x00, 0x7F, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3F, 0xC0, 0x3F, 0xFF, 0xE0, 0x00, 0x30, 0x00, 0x00, 0x30, 0x00, 0x00, 0x30, 0x00, 0x06, 0x13, 0x00, 0x0C, 0x13, 0xC0, 0x0C, 0x18, 0xF0, 0x18, 0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"测", {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x39, 0xFC, 0x30, 0x1F, 0xCC, 0x30, 0x07, 0x06, 0xB0, 0x0F, 0x06, 0xF0, 0x19, 0x07, 0xB0, 0x31, 0x37, 0xB0, 0x31, 0x36, 0xF0, 0x1F, 0x27, 0xF0, 0x01, 0x67, 0xF0, 0x01, 0xE5, 0xF0, 0x01, 0xE1, 0xF0, 0x00, 0x41, 0xF0, 0x0C, 0xF8, 0xB0, 0x3C, 0xD8, 0x30, 0x00, 0x8C, 0x30, 0x00, 0x80, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
+    {"试", {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x03, 0x60, 0x0C, 0x03, 0x70, 0x0C, 0x03, 0x30, 0x00, 0x3F, 0xE0, 0x00, 0x3F, 0x80, 0x08, 0x01, 0x00, 0x3C, 0x01, 0x80, 0x04, 0x7F, 0x80, 0x04, 0x7D, 0x80, 0x0C, 0x00, 0x80, 0x0C, 0x10, 0xC0, 0x0C, 0x10, 0xC0, 0x0C, 0x18, 0x40, 0x0C, 0x1C, 0x60, 0x0F, 0x7E, 0x60, 0x06, 0x70, 0x30, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}},
 #endif
-    0x00,
+    {{0x00}},
 };
 
 #endif /* FONT_H */
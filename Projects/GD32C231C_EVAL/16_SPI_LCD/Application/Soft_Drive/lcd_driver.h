@@ -38,6 +38,14 @@ OF SUCH DAMAGE.
 #include <stdlib.h>
 #include "gd32c2x1.h"
 
+#ifdef H_VIEW
+#define X_MAX_PIXEL         (uint16_t)320
+#define Y_MAX_PIXEL         (uint16_t)240
+#else
+#define X_MAX_PIXEL         (uint16_t)240
+#define Y_MAX_PIXEL         (uint16_t)320
+#endif
+
 #define RED             (uint16_t)0xF800
 #define GREEN           (uint16_t)0x07E0
 #define BLUE            (uint16_t)0x001F
@@ -62,6 +70,19 @@ OF SUCH DAMAGE.
 #define LCD_RST_SET     ((uint32_t)(GPIO_BOP(GPIOC) = GPIO_PIN_6))
 #define LCD_RST_CLR     ((uint32_t)(GPIO_BC(GPIOC) = GPIO_PIN_6))
 
+/* DMA channel used to stream pixels to SPI1 */
+#define LCD_DMA_CHANNEL         DMA_CH0
+#define LCD_DMA_MUXCH           DMAMUX_MUXCH0
+#define LCD_DMA_IRQn            DMA_Channel0_IRQn
+
+/* maximum number of pixels moved by one DMA block */
+#define LCD_DMA_BLOCK_SIZE      0xFFFFU
+/* fills shorter than this are sent by the CPU, the DMA setup costs more */
+#define LCD_DMA_MIN_PIXELS      16U
+
+/* lcd DMA transfer complete callback */
+typedef void (*lcd_dma_callback)(void);
+
 /* initialize the lcd */
 void lcd_init(void);
 /* set lcd display region */
@@ -72,5 +93,17 @@ void lcd_set_xy(uint16_t x, uint16_t y);
 void gui_draw_point(uint16_t x, uint16_t y, uint16_t data);
 /* clear the lcd */
 void lcd_clear(uint16_t color);
+/* fill a rectangle of the lcd with one color by DMA */
+void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, lcd_dma_callback callback);
+/* send pixels to the region set by lcd_set_region by DMA */
+void lcd_write_pixels(const uint16_t *pixels, uint32_t number, lcd_dma_callback callback);
+/* copy a pixel buffer to a rectangle of the lcd by DMA */
+void lcd_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels, lcd_dma_callback callback);
+/* get the lcd DMA transfer state */
+FlagStatus lcd_dma_busy(void);
+/* wait for the lcd DMA transfer to complete */
+void lcd_dma_wait(void);
+/* lcd DMA channel interrupt service */
+void lcd_dma_irq_handler(void);
 
 #endif /* LCD_DRIVER_H */
@@ -0,0 +1,169 @@
+/*!
+    \file    main.c
+    \brief   dual slot bootloader
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "gd32c2x1.h"
+#include "gd32c231c_eval.h"
+#include "boot_slot.h"
+#include "crc_service.h"
+
+static const uint32_t slot_address[BOOT_SLOT_NUM] = {BOOT_SLOT_A_ADDRESS, BOOT_SLOT_B_ADDRESS};
+
+static uint32_t boot_slot_select(void);
+static FlagStatus boot_slot_check(uint32_t slot);
+static FlagStatus boot_slot_vector_check(uint32_t slot);
+static void boot_slot_start(uint32_t slot);
+
+/*!
+    \brief      main function
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+int main(void)
+{
+    uint32_t slot;
+
+    crc_service_init();
+
+    slot = boot_slot_select();
+    if(0U != slot) {
+        boot_slot_start(slot);
+    }
+
+    /* no image to start, LED1 stays on */
+    gd_eval_led_init(LED1);
+    gd_eval_led_on(LED1);
+    while(1) {
+    }
+}
+
+/*!
+    \brief      select the slot to start
+    \param[in]  none
+    \param[out] none
+    \retval     address of the slot, 0 if none can be started
+*/
+static uint32_t boot_slot_select(void)
+{
+    const boot_slot_descriptor_struct *descriptor;
+    uint32_t selected = 0U;
+    uint32_t sequence = 0U;
+    uint32_t i;
+
+    /* the verified slot written last */
+    for(i = 0U; i < BOOT_SLOT_NUM; i++) {
+        descriptor = BOOT_SLOT_DESCRIPTOR(slot_address[i]);
+        if(SET == boot_slot_check(slot_address[i])) {
+            if((0U == selected) || ((int32_t)(descriptor->sequence - sequence) > 0)) {
+                selected = slot_address[i];
+                sequence = descriptor->sequence;
+            }
+        }
+    }
+
+    /* an image programmed by the debugger into slot A has no descriptor yet */
+    if((0U == selected) && (0xFFFFFFFFU == BOOT_SLOT_DESCRIPTOR(BOOT_SLOT_A_ADDRESS)->magic) &&
+            (SET == boot_slot_vector_check(BOOT_SLOT_A_ADDRESS))) {
+        selected = BOOT_SLOT_A_ADDRESS;
+    }
+
+    return selected;
+}
+
+/*!
+    \brief      check the descriptor and the CRC of the image of a slot
+    \param[in]  slot: address of the slot
+    \param[out] none
+    \retval     SET if the image is valid
+*/
+static FlagStatus boot_slot_check(uint32_t slot)
+{
+    const boot_slot_descriptor_struct *descriptor = BOOT_SLOT_DESCRIPTOR(slot);
+    crc_service_context_struct context;
+
+    if((BOOT_SLOT_MAGIC != descriptor->magic) || (descriptor->size > BOOT_SLOT_IMAGE_SIZE) ||
+            (RESET == boot_slot_vector_check(slot))) {
+        return RESET;
+    }
+
+    /* the DMA feeds the image to the CRC unit */
+    crc_service_start(&context, &crc_service_crc32);
+    crc_service_update_dma(&context, (const void *)(uintptr_t)slot, descriptor->size);
+
+    return (crc_service_finish(&context) == descriptor->crc) ? SET : RESET;
+}
+
+/*!
+    \brief      check the initial stack pointer and the reset vector of a slot
+    \param[in]  slot: address of the slot
+    \param[out] none
+    \retval     SET if they point into the RAM and into the slot
+*/
+static FlagStatus boot_slot_vector_check(uint32_t slot)
+{
+    uint32_t stack = REG32(slot);
+    uint32_t entry = REG32(slot + 4U);
+
+    if((stack < SRAM_BASE) || (stack > (SRAM_BASE + 0x3000U)) ||
+            (entry < slot) || (entry >= (slot + BOOT_SLOT_IMAGE_SIZE))) {
+        return RESET;
+    }
+
+    return SET;
+}
+
+/*!
+    \brief      start the image of a slot
+    \param[in]  slot: address of the slot
+    \param[out] none
+    \retval     none
+*/
+static void boot_slot_start(uint32_t slot)
+{
+    void (*entry)(void) = (void (*)(void))(uintptr_t)REG32(slot + 4U);
+
+    /* leave the peripherals used by the bootloader in their reset state */
+    dma_deinit(CRC_SERVICE_DMA_CHANNEL);
+    crc_deinit();
+    rcu_periph_clock_disable(RCU_DMA);
+    rcu_periph_clock_disable(RCU_DMAMUX);
+    rcu_periph_clock_disable(RCU_CRC);
+
+    /* the vector table of the image, then its stack and its reset handler */
+    __disable_irq();
+    nvic_vector_table_set(NVIC_VECTTAB_FLASH, slot - NVIC_VECTTAB_FLASH);
+    __set_MSP(REG32(slot));
+    __enable_irq();
+    entry();
+}
@@ -0,0 +1,427 @@
+/*!
+    \file  crc_service.c
+    \brief CRC service on the CRC unit, CPU or DMA fed, with a software model
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "crc_service.h"
+
+const crc_service_config_struct crc_service_crc32 = {0x04C11DB7U, 0xFFFFFFFFU, 0xFFFFFFFFU, 32U, 1U};
+const crc_service_config_struct crc_service_crc32_mpeg2 = {0x04C11DB7U, 0xFFFFFFFFU, 0x00000000U, 32U, 0U};
+const crc_service_config_struct crc_service_crc16_ccitt = {0x1021U, 0xFFFFU, 0x0000U, 16U, 0U};
+const crc_service_config_struct crc_service_crc8 = {0x07U, 0x00U, 0x00U, 8U, 0U};
+
+static uint32_t crc_service_mask(uint8_t width);
+static uint32_t crc_service_reflect(uint32_t value, uint8_t width);
+#ifndef CRC_SERVICE_SOFTWARE
+static void crc_service_load(const crc_service_context_struct *context, uint32_t data_reverse);
+#endif /* CRC_SERVICE_SOFTWARE */
+
+/*!
+    \brief      start a calculation
+    \param[in]  config: CRC algorithm
+      \arg        &crc_service_crc32, &crc_service_crc32_mpeg2, &crc_service_crc16_ccitt, &crc_service_crc8
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_start(crc_service_context_struct *context, const crc_service_config_struct *config)
+{
+    context->config = config;
+    context->value = config->init;
+}
+
+/*!
+    \brief      add data to a calculation in software, bit exact with the CRC unit
+    \param[in]  context: state of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_software_update(crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    const crc_service_config_struct *config = context->config;
+    const uint8_t *byte = (const uint8_t *)data;
+    uint32_t top = 1UL << (config->width - 1U);
+    uint32_t mask = crc_service_mask(config->width);
+    uint32_t crc = context->value;
+    uint32_t value;
+    uint32_t i, bit;
+
+    for(i = 0U; i < number; i++) {
+        value = byte[i];
+        if(0U != config->reflect) {
+            value = crc_service_reflect(value, 8U);
+        }
+        crc ^= value << (config->width - 8U);
+        for(bit = 0U; bit < 8U; bit++) {
+            if(0U != (crc & top)) {
+                crc = (crc << 1) ^ config->poly;
+            } else {
+                crc <<= 1;
+            }
+        }
+        crc &= mask;
+    }
+    context->value = crc;
+}
+
+/*!
+    \brief      build the lookup table of crc_service_table_update() for an algorithm
+    \param[in]  config: CRC algorithm
+      \arg        &crc_service_crc32, &crc_service_crc32_mpeg2, &crc_service_crc16_ccitt, &crc_service_crc8
+    \param[out] table: CRC_SERVICE_TABLE_SIZE entries
+    \retval     none
+*/
+void crc_service_table_build(const crc_service_config_struct *config, uint32_t *table)
+{
+    uint32_t poly, crc;
+    uint32_t i, bit;
+
+    if(0U != config->reflect) {
+        /* the reflected algorithms shift right, the register is bit reversed during the update */
+        poly = crc_service_reflect(config->poly, config->width);
+        for(i = 0U; i < CRC_SERVICE_TABLE_SIZE; i++) {
+            crc = i;
+            for(bit = 0U; bit < 8U; bit++) {
+                crc = (0U != (crc & 1U)) ? ((crc >> 1) ^ poly) : (crc >> 1);
+            }
+            table[i] = crc;
+        }
+    } else {
+        /* the other ones shift left with the register at the top of 32 bits */
+        poly = config->poly << (32U - config->width);
+        for(i = 0U; i < CRC_SERVICE_TABLE_SIZE; i++) {
+            crc = i << 24;
+            for(bit = 0U; bit < 8U; bit++) {
+                crc = (0U != (crc & 0x80000000U)) ? ((crc << 1) ^ poly) : (crc << 1);
+            }
+            table[i] = crc;
+        }
+    }
+}
+
+/*!
+    \brief      add data to a calculation in software, a byte per table lookup, bit exact with the CRC unit
+    \param[in]  context: state of the calculation
+    \param[in]  table: table of crc_service_table_build() for the algorithm of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_table_update(crc_service_context_struct *context, const uint32_t *table, const void *data,
+                              uint32_t number)
+{
+    const crc_service_config_struct *config = context->config;
+    const uint8_t *byte = (const uint8_t *)data;
+    uint32_t crc;
+    uint32_t i;
+
+    if(0U != config->reflect) {
+        crc = crc_service_reflect(context->value, config->width);
+        for(i = 0U; i < number; i++) {
+            crc = (crc >> 8) ^ table[(crc ^ byte[i]) & 0xFFU];
+        }
+        context->value = crc_service_reflect(crc, config->width);
+    } else {
+        crc = context->value << (32U - config->width);
+        for(i = 0U; i < number; i++) {
+            crc = (crc << 8) ^ table[(crc >> 24) ^ byte[i]];
+        }
+        context->value = crc >> (32U - config->width);
+    }
+}
+
+/*!
+    \brief      get the result of a calculation, the context may still be updated
+    \param[in]  context: state of the calculation
+    \param[out] none
+    \retval     CRC value
+*/
+uint32_t crc_service_finish(const crc_service_context_struct *context)
+{
+    const crc_service_config_struct *config = context->config;
+    uint32_t crc = context->value;
+
+    /* the CRC unit runs with the output reverse off, so the register can be restored */
+    if(0U != config->reflect) {
+        crc = crc_service_reflect(crc, config->width);
+    }
+
+    return (crc ^ config->xor_out) & crc_service_mask(config->width);
+}
+
+/*!
+    \brief      calculate the CRC of a buffer
+    \param[in]  config: CRC algorithm
+      \arg        &crc_service_crc32, &crc_service_crc32_mpeg2, &crc_service_crc16_ccitt, &crc_service_crc8
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     CRC value
+*/
+uint32_t crc_service_calculate(const crc_service_config_struct *config, const void *data, uint32_t number)
+{
+    crc_service_context_struct context;
+
+    crc_service_start(&context, config);
+    crc_service_update(&context, data, number);
+
+    return crc_service_finish(&context);
+}
+
+#ifdef CRC_SERVICE_SOFTWARE
+/*!
+    \brief      enable the CRC unit, nothing to do for the software model
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void crc_service_init(void)
+{
+}
+
+/*!
+    \brief      add data to a calculation, the software model replaces the CRC unit
+    \param[in]  context: state of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_update(crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    crc_service_software_update(context, data, number);
+}
+
+/*!
+    \brief      add data to a calculation, the software model replaces the DMA feed
+    \param[in]  context: state of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_update_dma(crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    crc_service_software_update(context, data, number);
+}
+#else
+/*!
+    \brief      enable the CRC unit
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void crc_service_init(void)
+{
+    rcu_periph_clock_enable(RCU_CRC);
+    crc_deinit();
+}
+
+/*!
+    \brief      add data to a calculation, the CPU feeds the CRC unit, callable from interrupts
+    \param[in]  context: state of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_update(crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    uint32_t address = (uint32_t)(uintptr_t)data;
+    uint32_t primask;
+    uint32_t head, words;
+
+    /* the CRC unit is shared, each update restores its context */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    crc_service_load(context, (0U != context->config->reflect) ? CRC_INPUT_DATA_BYTE : CRC_INPUT_DATA_NOT);
+
+    if(0U != context->config->reflect) {
+        /* a word reversed as a whole is its four bytes reversed one by one, in memory order */
+        head = (4U - (address & 3U)) & 3U;
+        if(head > number) {
+            head = number;
+        }
+        crc_block_data_calculate((void *)(uintptr_t)address, head, INPUT_FORMAT_BYTE);
+        address += head;
+        number -= head;
+
+        words = number >> 2;
+        if(0U != words) {
+            crc_input_data_reverse_config(CRC_INPUT_DATA_WORD);
+            crc_block_data_calculate((void *)(uintptr_t)address, words, INPUT_FORMAT_WORD);
+            crc_input_data_reverse_config(CRC_INPUT_DATA_BYTE);
+            address += words << 2;
+            number -= words << 2;
+        }
+    }
+    crc_block_data_calculate((void *)(uintptr_t)address, number, INPUT_FORMAT_BYTE);
+
+    context->value = crc_data_register_read() & crc_service_mask(context->config->width);
+    __set_PRIMASK(primask);
+}
+
+/*!
+    \brief      add data to a calculation, the DMA feeds the CRC unit by memory to memory
+                transfers, no other CRC calculation may run until it returns
+    \param[in]  context: state of the calculation
+    \param[in]  data: pointer to the data
+    \param[in]  number: number of bytes
+    \param[out] context: state of the calculation
+    \retval     none
+*/
+void crc_service_update_dma(crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    dma_parameter_struct dma_init_struct;
+    uint32_t address = (uint32_t)(uintptr_t)data;
+    uint32_t head = 0U;
+    uint32_t body = number;
+    uint32_t block;
+
+    /* the reflected algorithms are fed by words, the CPU feeds the unaligned bytes */
+    if(0U != context->config->reflect) {
+        head = (4U - (address & 3U)) & 3U;
+        if(head > number) {
+            head = number;
+        }
+        crc_service_update(context, data, head);
+        address += head;
+        body = (number - head) & ~3U;
+    }
+
+    if(0U != body) {
+        rcu_periph_clock_enable(RCU_DMA);
+        rcu_periph_clock_enable(RCU_DMAMUX);
+
+        dma_deinit(CRC_SERVICE_DMA_CHANNEL);
+        dma_struct_para_init(&dma_init_struct);
+        dma_init_struct.request      = DMA_REQUEST_M2M;
+        dma_init_struct.direction    = DMA_MEMORY_TO_PERIPHERAL;
+        dma_init_struct.memory_addr  = address;
+        dma_init_struct.memory_inc   = DMA_MEMORY_INCREASE_ENABLE;
+        dma_init_struct.number       = 0U;
+        dma_init_struct.periph_addr  = (uint32_t)(uintptr_t)&CRC_DATA;
+        dma_init_struct.periph_inc   = DMA_PERIPH_INCREASE_DISABLE;
+        dma_init_struct.priority     = DMA_PRIORITY_LOW;
+        if(0U != context->config->reflect) {
+            dma_init_struct.memory_width = DMA_MEMORY_WIDTH_32BIT;
+            dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_32BIT;
+        } else {
+            dma_init_struct.memory_width = DMA_MEMORY_WIDTH_8BIT;
+            dma_init_struct.periph_width = DMA_PERIPHERAL_WIDTH_8BIT;
+        }
+        dma_init(CRC_SERVICE_DMA_CHANNEL, &dma_init_struct);
+        dma_circulation_disable(CRC_SERVICE_DMA_CHANNEL);
+        dma_memory_to_memory_enable(CRC_SERVICE_DMA_CHANNEL);
+        dmamux_synchronization_disable(CRC_SERVICE_DMA_MUXCH);
+
+        crc_service_load(context, (0U != context->config->reflect) ? CRC_INPUT_DATA_WORD : CRC_INPUT_DATA_NOT);
+
+        /* the transfer number register holds up to 65535 items */
+        while(0U != body) {
+            block = (body > CRC_SERVICE_DMA_BLOCK) ? CRC_SERVICE_DMA_BLOCK : body;
+            dma_memory_address_config(CRC_SERVICE_DMA_CHANNEL, address);
+            dma_transfer_number_config(CRC_SERVICE_DMA_CHANNEL, (0U != context->config->reflect) ? (block >> 2) : block);
+            dma_flag_clear(CRC_SERVICE_DMA_CHANNEL, DMA_FLAG_G);
+            dma_channel_enable(CRC_SERVICE_DMA_CHANNEL);
+            while(RESET == dma_flag_get(CRC_SERVICE_DMA_CHANNEL, DMA_FLAG_FTF)) {
+            }
+            dma_channel_disable(CRC_SERVICE_DMA_CHANNEL);
+            address += block;
+            body -= block;
+        }
+
+        context->value = crc_data_register_read() & crc_service_mask(context->config->width);
+    }
+
+    /* the bytes after the last word */
+    crc_service_update(context, (const void *)(uintptr_t)address, number - (address - (uint32_t)(uintptr_t)data));
+}
+
+/*!
+    \brief      program the CRC unit with the algorithm and the register of a calculation
+    \param[in]  context: state of the calculation
+    \param[in]  data_reverse: input data reverse function
+      \arg        CRC_INPUT_DATA_NOT, CRC_INPUT_DATA_BYTE, CRC_INPUT_DATA_WORD
+    \param[out] none
+    \retval     none
+*/
+static void crc_service_load(const crc_service_context_struct *context, uint32_t data_reverse)
+{
+    if(32U == context->config->width) {
+        crc_polynomial_size_set(CRC_CTL_PS_32);
+    } else if(16U == context->config->width) {
+        crc_polynomial_size_set(CRC_CTL_PS_16);
+    } else {
+        crc_polynomial_size_set(CRC_CTL_PS_8);
+    }
+    crc_polynomial_set(context->config->poly);
+    crc_input_data_reverse_config(data_reverse);
+    crc_reverse_output_data_disable();
+    crc_init_data_register_write(context->value);
+    crc_data_register_reset();
+}
+#endif /* CRC_SERVICE_SOFTWARE */
+
+/*!
+    \brief      get the mask of a CRC width
+    \param[in]  width: 8, 16 or 32
+    \param[out] none
+    \retval     mask of the CRC bits
+*/
+static uint32_t crc_service_mask(uint8_t width)
+{
+    return (32U == width) ? 0xFFFFFFFFU : ((1UL << width) - 1U);
+}
+
+/*!
+    \brief      reverse the bit order of a value, there is no RBIT instruction on the Cortex-M23
+    \param[in]  value: value to reverse
+    \param[in]  width: number of bits
+    \param[out] none
+    \retval     reversed value
+*/
+static uint32_t crc_service_reflect(uint32_t value, uint8_t width)
+{
+    uint32_t result = 0U;
+    uint8_t i;
+
+    for(i = 0U; i < width; i++) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+
+    return result;
+}
@@ -0,0 +1,98 @@
+/*!
+    \file  crc_service.h
+    \brief the header file of the CRC service
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef CRC_SERVICE_H
+#define CRC_SERVICE_H
+
+/* define CRC_SERVICE_SOFTWARE to build the bit exact software model only, e.g. on a host */
+#ifdef CRC_SERVICE_SOFTWARE
+#include <stdint.h>
+#else
+#include "gd32c2x1.h"
+#endif
+
+/* DMA channel of the memory to CRC feed, free while crc_service_update_dma() runs */
+#define CRC_SERVICE_DMA_CHANNEL         DMA_CH0
+#define CRC_SERVICE_DMA_MUXCH           DMAMUX_MUXCH0
+/* largest number of bytes of one DMA transfer, a multiple of 4 */
+#define CRC_SERVICE_DMA_BLOCK           0xFFFCU
+/* entries of the table of crc_service_table_build() */
+#define CRC_SERVICE_TABLE_SIZE          256U
+
+/* CRC algorithm */
+typedef struct {
+    uint32_t poly;                      /*!< polynomial without the top bit */
+    uint32_t init;                      /*!< initial value */
+    uint32_t xor_out;                   /*!< value XORed to the result */
+    uint8_t width;                      /*!< 8, 16 or 32 bits */
+    uint8_t reflect;                    /*!< 1 if the input bytes and the result are bit reversed */
+} crc_service_config_struct;
+
+/* state of a streaming calculation, copy it to save or restore the calculation */
+typedef struct {
+    const crc_service_config_struct *config;
+    uint32_t value;                     /*!< CRC register between the updates */
+} crc_service_context_struct;
+
+/* CRC-32/ISO-HDLC, the CRC of zip and Ethernet */
+extern const crc_service_config_struct crc_service_crc32;
+/* CRC-32/MPEG-2, the reset configuration of the CRC unit */
+extern const crc_service_config_struct crc_service_crc32_mpeg2;
+/* CRC-16/CCITT-FALSE */
+extern const crc_service_config_struct crc_service_crc16_ccitt;
+/* CRC-8/SMBUS */
+extern const crc_service_config_struct crc_service_crc8;
+
+/* enable the CRC unit */
+void crc_service_init(void);
+/* start a calculation */
+void crc_service_start(crc_service_context_struct *context, const crc_service_config_struct *config);
+/* add data to a calculation, the CPU feeds the CRC unit */
+void crc_service_update(crc_service_context_struct *context, const void *data, uint32_t number);
+/* add data to a calculation, the DMA feeds the CRC unit */
+void crc_service_update_dma(crc_service_context_struct *context, const void *data, uint32_t number);
+/* add data to a calculation in software */
+void crc_service_software_update(crc_service_context_struct *context, const void *data, uint32_t number);
+/* build the table of crc_service_table_update() */
+void crc_service_table_build(const crc_service_config_struct *config, uint32_t *table);
+/* add data to a calculation in software, a table lookup per byte */
+void crc_service_table_update(crc_service_context_struct *context, const uint32_t *table, const void *data,
+                              uint32_t number);
+/* get the result of a calculation */
+uint32_t crc_service_finish(const crc_service_context_struct *context);
+/* calculate the CRC of a buffer */
+uint32_t crc_service_calculate(const crc_service_config_struct *config, const void *data, uint32_t number);
+
+#endif /* CRC_SERVICE_H */
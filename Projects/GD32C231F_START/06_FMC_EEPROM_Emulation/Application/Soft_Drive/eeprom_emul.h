@@ -0,0 +1,57 @@
+/*!
+    \file  eeprom_emul.h
+    \brief the header file of the EEPROM emulation in the internal flash
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef EEPROM_EMUL_H
+#define EEPROM_EMUL_H
+
+#include "gd32c2x1.h"
+
+/* pages used in rotation at the end of the main flash, the linker script must keep them free */
+#define EEPROM_EMUL_PAGE_NUM            4U
+#define EEPROM_EMUL_START_ADDRESS       (MAIN_FLASH_BASE_ADDRESS + MAIN_FLASH_SIZE - (EEPROM_EMUL_PAGE_NUM * MAIN_FLASH_PAGE_SIZE))
+
+/* number of 32-bit variables, their virtual addresses are 0 to EEPROM_EMUL_VAR_NUM - 1 */
+#define EEPROM_EMUL_VAR_NUM             32U
+
+/* load the variables of the active page, the pages are formatted if none is active */
+fmc_state_enum eeprom_emul_init(void);
+/* clear all the variables */
+fmc_state_enum eeprom_emul_format(void);
+/* read a variable from the RAM index */
+ErrStatus eeprom_emul_read(uint16_t virt_address, uint32_t *data);
+/* write a variable */
+fmc_state_enum eeprom_emul_write(uint16_t virt_address, uint32_t data);
+
+#endif /* EEPROM_EMUL_H */
@@ -0,0 +1,122 @@
+/*!
+    \file    main.c
+    \brief   EEPROM emulation in the internal flash
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "gd32c2x1.h"
+#include "systick.h"
+#include "eeprom_emul.h"
+
+/* virtual addresses of the variables */
+#define VAR_LED_STATE           0U
+#define VAR_KEY_COUNT           1U
+#define VAR_BOOT_COUNT          2U
+
+static void eeprom_error(void);
+
+/*!
+    \brief      main function
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+int main(void)
+{
+    uint32_t led_state = 0U;
+    uint32_t key_count = 0U;
+    uint32_t boot_count = 0U;
+
+    systick_config();
+
+    /* enable the LED GPIO clock */
+    rcu_periph_clock_enable(RCU_GPIOA);
+
+    /* configure LED GPIO pin */
+    gpio_mode_set(GPIOA, GPIO_MODE_OUTPUT, GPIO_PUPD_NONE, GPIO_PIN_15);
+    gpio_output_options_set(GPIOA, GPIO_OTYPE_PP, GPIO_OSPEED_LEVEL_1, GPIO_PIN_15);
+
+    /* reset LED GPIO pin */
+    gpio_bit_reset(GPIOA, GPIO_PIN_15);
+
+    /* configure key pin as input */
+    gpio_mode_set(GPIOA, GPIO_MODE_INPUT, GPIO_PUPD_NONE, GPIO_PIN_0);
+
+    /* load the variables, the pages are formatted at the first start */
+    if(FMC_READY != eeprom_emul_init()) {
+        eeprom_error();
+    }
+
+    /* count the starts and restore the LED state saved before the reset */
+    eeprom_emul_read(VAR_BOOT_COUNT, &boot_count);
+    if(FMC_READY != eeprom_emul_write(VAR_BOOT_COUNT, boot_count + 1U)) {
+        eeprom_error();
+    }
+    eeprom_emul_read(VAR_KEY_COUNT, &key_count);
+    if((SUCCESS == eeprom_emul_read(VAR_LED_STATE, &led_state)) && (0U != led_state)) {
+        gpio_bit_set(GPIOA, GPIO_PIN_15);
+    }
+
+    while(1) {
+        /* check whether the key is pressed */
+        if(SET == gpio_input_bit_get(GPIOA, GPIO_PIN_0)) {
+            delay_ms(100);
+
+            /* check whether the key is pressed */
+            if(SET == gpio_input_bit_get(GPIOA, GPIO_PIN_0)) {
+                /* toggle LED GPIO pin and save its state */
+                gpio_bit_toggle(GPIOA, GPIO_PIN_15);
+                led_state = (SET == gpio_output_bit_get(GPIOA, GPIO_PIN_15)) ? 1U : 0U;
+                key_count++;
+                if((FMC_READY != eeprom_emul_write(VAR_LED_STATE, led_state)) ||
+                        (FMC_READY != eeprom_emul_write(VAR_KEY_COUNT, key_count))) {
+                    eeprom_error();
+                }
+            }
+            while(SET == gpio_input_bit_get(GPIOA, GPIO_PIN_0)) {
+            }
+        }
+    }
+}
+
+/*!
+    \brief      blink the LED fast forever on a flash error
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void eeprom_error(void)
+{
+    while(1) {
+        gpio_bit_toggle(GPIOA, GPIO_PIN_15);
+        delay_ms(50);
+    }
+}
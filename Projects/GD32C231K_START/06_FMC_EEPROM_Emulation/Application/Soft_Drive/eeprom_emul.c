@@ -0,0 +1,405 @@
+/*!
+    \file  eeprom_emul.c
+    \brief EEPROM emulation in the internal flash
+
+    \version 2025-06-03, V1.0.0, demo for gd32c2x1
+*/
+
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include "eeprom_emul.h"
+#include <string.h>
+
+/*
+    each page starts with three header doublewords, then holds the records:
+
+    RECEIVE  {EEPROM_EMUL_RECEIVE_MARK, sequence}    the page is being filled
+    ACTIVE   {EEPROM_EMUL_ACTIVE_MARK, sequence}     the page holds the variables
+    OBSOLETE {EEPROM_EMUL_OBSOLETE_MARK, sequence}   a newer page holds the variables
+    record   {value, (crc << 16) | virtual address}
+
+    a doubleword is programmed once after its erase, so a page goes from erased to RECEIVE,
+    ACTIVE and OBSOLETE by programming the next header doubleword. the records of a full page
+    are copied from the RAM index to the next page of the ring, which is only used once its
+    ACTIVE header is written; the sequence decides between two ACTIVE pages left by a reset
+*/
+#define EEPROM_EMUL_RECEIVE_MARK        0x56434552U
+#define EEPROM_EMUL_ACTIVE_MARK         0x56544341U
+#define EEPROM_EMUL_OBSOLETE_MARK       0x4C4F5342U
+
+#define EEPROM_EMUL_RECEIVE_OFFSET      0x00U
+#define EEPROM_EMUL_ACTIVE_OFFSET       0x08U
+#define EEPROM_EMUL_OBSOLETE_OFFSET     0x10U
+#define EEPROM_EMUL_RECORD_OFFSET       0x18U
+#define EEPROM_EMUL_RECORD_SIZE         8U
+
+#define EEPROM_EMUL_PAGE_ADDRESS(page)  (EEPROM_EMUL_START_ADDRESS + ((page) * MAIN_FLASH_PAGE_SIZE))
+#define EEPROM_EMUL_NO_PAGE             EEPROM_EMUL_PAGE_NUM
+#define EEPROM_EMUL_ERROR_FLAGS         (FMC_FLAG_OBERR | FMC_FLAG_RPERR | FMC_FLAG_FSTPERR | FMC_FLAG_PGSERR | \
+                                         FMC_FLAG_PGMERR | FMC_FLAG_PGAERR | FMC_FLAG_WPERR | FMC_FLAG_PGERR | \
+                                         FMC_FLAG_OPRERR | FMC_FLAG_ENDF)
+
+#if (EEPROM_EMUL_PAGE_NUM < 2U)
+#error "EEPROM_EMUL_PAGE_NUM must be 2 at least"
+#endif
+/* the page size of 1K is written as a number, the cast of MAIN_FLASH_PAGE_SIZE can't be used by #if */
+#if ((EEPROM_EMUL_RECORD_OFFSET + ((EEPROM_EMUL_VAR_NUM + 1U) * EEPROM_EMUL_RECORD_SIZE)) > 0x400U)
+#error "EEPROM_EMUL_VAR_NUM is too large, a page must hold all the variables and a new record"
+#endif
+
+/* RAM index, the last value of each variable */
+static uint32_t var_value[EEPROM_EMUL_VAR_NUM];
+static uint32_t var_valid[(EEPROM_EMUL_VAR_NUM + 31U) / 32U];
+static uint32_t active_page = EEPROM_EMUL_NO_PAGE;
+static uint32_t active_sequence = 0U;
+/* offset of the first free record of the active page */
+static uint32_t free_offset = MAIN_FLASH_PAGE_SIZE;
+
+static fmc_state_enum eeprom_emul_page_transfer(void);
+static void eeprom_emul_page_load(uint32_t page);
+static FlagStatus eeprom_emul_page_sequence_get(uint32_t page, uint32_t *sequence);
+static fmc_state_enum eeprom_emul_record_program(uint32_t address, uint16_t virt_address, uint32_t data);
+static uint16_t eeprom_emul_crc_calculate(uint16_t virt_address, uint32_t data);
+static FlagStatus eeprom_emul_blank_check(uint32_t address, uint32_t number);
+
+/*!
+    \brief      load the variables of the active page, the pages are formatted if none is active
+    \param[in]  none
+    \param[out] none
+    \retval     state of FMC
+*/
+fmc_state_enum eeprom_emul_init(void)
+{
+    uint32_t page, sequence;
+    uint32_t last_sequence = 0U;
+
+    active_page = EEPROM_EMUL_NO_PAGE;
+    active_sequence = 0U;
+
+    /* the active page is the newest page whose ACTIVE header is complete and not obsoleted */
+    for(page = 0U; page < EEPROM_EMUL_PAGE_NUM; page++) {
+        if(SET == eeprom_emul_page_sequence_get(page, &sequence)) {
+            if(sequence > last_sequence) {
+                last_sequence = sequence;
+            }
+            if((SET == eeprom_emul_blank_check(EEPROM_EMUL_PAGE_ADDRESS(page) + EEPROM_EMUL_OBSOLETE_OFFSET, 8U)) &&
+                    ((EEPROM_EMUL_NO_PAGE == active_page) || (sequence > active_sequence))) {
+                active_page = page;
+                active_sequence = sequence;
+            }
+        }
+    }
+
+    if(EEPROM_EMUL_NO_PAGE == active_page) {
+        /* start after any header left in the pages so that it can't win over the new page */
+        active_sequence = last_sequence;
+        return eeprom_emul_format();
+    }
+
+    /* a reset after a transfer may have left the previous page ACTIVE */
+    fmc_unlock();
+    fmc_flag_clear(EEPROM_EMUL_ERROR_FLAGS);
+    for(page = 0U; page < EEPROM_EMUL_PAGE_NUM; page++) {
+        if((page != active_page) && (SET == eeprom_emul_page_sequence_get(page, &sequence)) &&
+                (SET == eeprom_emul_blank_check(EEPROM_EMUL_PAGE_ADDRESS(page) + EEPROM_EMUL_OBSOLETE_OFFSET, 8U))) {
+            fmc_doubleword_program(EEPROM_EMUL_PAGE_ADDRESS(page) + EEPROM_EMUL_OBSOLETE_OFFSET,
+                                   ((uint64_t)sequence << 32) | EEPROM_EMUL_OBSOLETE_MARK);
+        }
+    }
+    fmc_lock();
+
+    eeprom_emul_page_load(active_page);
+
+    return FMC_READY;
+}
+
+/*!
+    \brief      clear all the variables, an empty page of the ring becomes the active page
+    \param[in]  none
+    \param[out] none
+    \retval     state of FMC
+*/
+fmc_state_enum eeprom_emul_format(void)
+{
+    fmc_state_enum state;
+
+    memset(var_valid, 0, sizeof(var_valid));
+    state = eeprom_emul_page_transfer();
+    if((FMC_READY != state) && (EEPROM_EMUL_NO_PAGE != active_page)) {
+        /* the variables are still in the active page */
+        eeprom_emul_page_load(active_page);
+    }
+
+    return state;
+}
+
+/*!
+    \brief      read a variable from the RAM index
+    \param[in]  virt_address: virtual address of the variable, 0 to EEPROM_EMUL_VAR_NUM - 1
+    \param[out] data: value of the variable
+    \retval     ErrStatus: ERROR if the variable has never been written, SUCCESS otherwise
+*/
+ErrStatus eeprom_emul_read(uint16_t virt_address, uint32_t *data)
+{
+    if((virt_address >= EEPROM_EMUL_VAR_NUM) || (0U == (var_valid[virt_address >> 5] & (1UL << (virt_address & 31U))))) {
+        return ERROR;
+    }
+    *data = var_value[virt_address];
+
+    return SUCCESS;
+}
+
+/*!
+    \brief      write a variable, a record is appended to the active page and the variables
+                are moved to the next page when it is full, not reentrant
+    \param[in]  virt_address: virtual address of the variable, 0 to EEPROM_EMUL_VAR_NUM - 1
+    \param[in]  data: value of the variable
+    \param[out] none
+    \retval     state of FMC
+*/
+fmc_state_enum eeprom_emul_write(uint16_t virt_address, uint32_t data)
+{
+    fmc_state_enum state;
+    uint32_t mask;
+    uint32_t value;
+
+    if((virt_address >= EEPROM_EMUL_VAR_NUM) || (EEPROM_EMUL_NO_PAGE == active_page)) {
+        return FMC_UNDEFINEDERR;
+    }
+
+    mask = 1UL << (virt_address & 31U);
+    /* rewriting the same value costs no flash */
+    if((0U != (var_valid[virt_address >> 5] & mask)) && (data == var_value[virt_address])) {
+        return FMC_READY;
+    }
+
+    if(free_offset < MAIN_FLASH_PAGE_SIZE) {
+        fmc_unlock();
+        fmc_flag_clear(EEPROM_EMUL_ERROR_FLAGS);
+        state = eeprom_emul_record_program(EEPROM_EMUL_PAGE_ADDRESS(active_page) + free_offset, virt_address, data);
+        fmc_lock();
+        if(FMC_READY == state) {
+            free_offset += EEPROM_EMUL_RECORD_SIZE;
+            var_value[virt_address] = data;
+            var_valid[virt_address >> 5] |= mask;
+        } else if(RESET == eeprom_emul_blank_check(EEPROM_EMUL_PAGE_ADDRESS(active_page) + free_offset, EEPROM_EMUL_RECORD_SIZE)) {
+            /* a failed record is skipped, its crc won't match, but an erased one would end the page at load */
+            free_offset += EEPROM_EMUL_RECORD_SIZE;
+        }
+    } else {
+        value = var_value[virt_address];
+        var_value[virt_address] = data;
+        if(0U != (var_valid[virt_address >> 5] & mask)) {
+            state = eeprom_emul_page_transfer();
+            if(FMC_READY != state) {
+                var_value[virt_address] = value;
+            }
+        } else {
+            var_valid[virt_address >> 5] |= mask;
+            state = eeprom_emul_page_transfer();
+            if(FMC_READY != state) {
+                var_valid[virt_address >> 5] &= ~mask;
+            }
+        }
+    }
+
+    return state;
+}
+
+/*!
+    \brief      copy the variables of the RAM index to the next page of the ring and make it the active page
+    \param[in]  none
+    \param[out] none
+    \retval     state of FMC
+*/
+static fmc_state_enum eeprom_emul_page_transfer(void)
+{
+    fmc_state_enum state = FMC_READY;
+    uint32_t page, address, offset;
+    uint32_t sequence = active_sequence + 1U;
+    uint16_t i;
+
+    page = (EEPROM_EMUL_NO_PAGE == active_page) ? 0U : ((active_page + 1U) % EEPROM_EMUL_PAGE_NUM);
+    address = EEPROM_EMUL_PAGE_ADDRESS(page);
+
+    fmc_unlock();
+    fmc_flag_clear(EEPROM_EMUL_ERROR_FLAGS);
+
+    /* the pages are used in turn, so each of them is erased once every EEPROM_EMUL_PAGE_NUM transfers */
+    if(RESET == eeprom_emul_blank_check(address, MAIN_FLASH_PAGE_SIZE)) {
+        state = fmc_page_erase((address - MAIN_FLASH_BASE_ADDRESS) / MAIN_FLASH_PAGE_SIZE);
+    }
+    if(FMC_READY == state) {
+        state = fmc_doubleword_program(address + EEPROM_EMUL_RECEIVE_OFFSET, ((uint64_t)sequence << 32) | EEPROM_EMUL_RECEIVE_MARK);
+    }
+
+    offset = EEPROM_EMUL_RECORD_OFFSET;
+    for(i = 0U; (i < EEPROM_EMUL_VAR_NUM) && (FMC_READY == state); i++) {
+        if(0U != (var_valid[i >> 5] & (1UL << (i & 31U)))) {
+            state = eeprom_emul_record_program(address + offset, i, var_value[i]);
+            offset += EEPROM_EMUL_RECORD_SIZE;
+        }
+    }
+
+    /* the new page takes over once its ACTIVE header is written */
+    if(FMC_READY == state) {
+        state = fmc_doubleword_program(address + EEPROM_EMUL_ACTIVE_OFFSET, ((uint64_t)sequence << 32) | EEPROM_EMUL_ACTIVE_MARK);
+    }
+    if(FMC_READY == state) {
+        if(EEPROM_EMUL_NO_PAGE != active_page) {
+            /* if this fails, the higher sequence of the new page still wins at the next init */
+            fmc_doubleword_program(EEPROM_EMUL_PAGE_ADDRESS(active_page) + EEPROM_EMUL_OBSOLETE_OFFSET,
+                                   ((uint64_t)sequence << 32) | EEPROM_EMUL_OBSOLETE_MARK);
+        }
+        active_page = page;
+        active_sequence = sequence;
+        free_offset = offset;
+    }
+
+    fmc_lock();
+
+    return state;
+}
+
+/*!
+    \brief      build the RAM index from the records of a page
+    \param[in]  page: page of the ring
+    \param[out] none
+    \retval     none
+*/
+static void eeprom_emul_page_load(uint32_t page)
+{
+    uint32_t address = EEPROM_EMUL_PAGE_ADDRESS(page);
+    uint32_t offset, value, tag;
+    uint16_t virt_address;
+
+    memset(var_valid, 0, sizeof(var_valid));
+
+    for(offset = EEPROM_EMUL_RECORD_OFFSET; offset < MAIN_FLASH_PAGE_SIZE; offset += EEPROM_EMUL_RECORD_SIZE) {
+        value = REG32(address + offset);
+        tag = REG32(address + offset + 4U);
+        if((0xFFFFFFFFU == value) && (0xFFFFFFFFU == tag)) {
+            break;
+        }
+        /* a record cut by a reset fails its crc and is ignored, the later records are newer */
+        virt_address = (uint16_t)tag;
+        if((virt_address < EEPROM_EMUL_VAR_NUM) && ((uint16_t)(tag >> 16) == eeprom_emul_crc_calculate(virt_address, value))) {
+            var_value[virt_address] = value;
+            var_valid[virt_address >> 5] |= 1UL << (virt_address & 31U);
+        }
+    }
+
+    free_offset = offset;
+}
+
+/*!
+    \brief      get the sequence of a page whose RECEIVE and ACTIVE headers are complete
+    \param[in]  page: page of the ring
+    \param[out] sequence: sequence of the page
+    \retval     SET if the ACTIVE header is complete
+*/
+static FlagStatus eeprom_emul_page_sequence_get(uint32_t page, uint32_t *sequence)
+{
+    uint32_t address = EEPROM_EMUL_PAGE_ADDRESS(page);
+
+    /* an interrupted program leaves a header with some bits still erased, it can't match both marks */
+    if((EEPROM_EMUL_RECEIVE_MARK != REG32(address + EEPROM_EMUL_RECEIVE_OFFSET)) ||
+            (EEPROM_EMUL_ACTIVE_MARK != REG32(address + EEPROM_EMUL_ACTIVE_OFFSET)) ||
+            (REG32(address + EEPROM_EMUL_RECEIVE_OFFSET + 4U) != REG32(address + EEPROM_EMUL_ACTIVE_OFFSET + 4U))) {
+        return RESET;
+    }
+    *sequence = REG32(address + EEPROM_EMUL_ACTIVE_OFFSET + 4U);
+
+    return SET;
+}
+
+/*!
+    \brief      program a record
+    \param[in]  address: record address
+    \param[in]  virt_address: virtual address of the variable
+    \param[in]  data: value of the variable
+    \param[out] none
+    \retval     state of FMC
+*/
+static fmc_state_enum eeprom_emul_record_program(uint32_t address, uint16_t virt_address, uint32_t data)
+{
+    uint32_t tag = ((uint32_t)eeprom_emul_crc_calculate(virt_address, data) << 16) | virt_address;
+
+    return fmc_doubleword_program(address, ((uint64_t)tag << 32) | data);
+}
+
+/*!
+    \brief      calculate the CRC-16/CCITT of a record
+    \param[in]  virt_address: virtual address of the variable
+    \param[in]  data: value of the variable
+    \param[out] none
+    \retval     crc of the record
+*/
+static uint16_t eeprom_emul_crc_calculate(uint16_t virt_address, uint32_t data)
+{
+    uint8_t byte[6];
+    uint16_t crc = 0xFFFFU;
+    uint8_t i, j;
+
+    byte[0] = (uint8_t)virt_address;
+    byte[1] = (uint8_t)(virt_address >> 8);
+    byte[2] = (uint8_t)data;
+    byte[3] = (uint8_t)(data >> 8);
+    byte[4] = (uint8_t)(data >> 16);
+    byte[5] = (uint8_t)(data >> 24);
+
+    for(i = 0U; i < sizeof(byte); i++) {
+        crc ^= (uint16_t)byte[i] << 8;
+        for(j = 0U; j < 8U; j++) {
+            crc = (0U != (crc & 0x8000U)) ? (uint16_t)((crc << 1) ^ 0x1021U) : (uint16_t)(crc << 1);
+        }
+    }
+
+    return crc;
+}
+
+/*!
+    \brief      check that a flash area is erased
+    \param[in]  address: flash address, word aligned
+    \param[in]  number: number of bytes, a multiple of 4
+    \param[out] none
+    \retval     SET if all the words are 0xFFFFFFFF
+*/
+static FlagStatus eeprom_emul_blank_check(uint32_t address, uint32_t number)
+{
+    uint32_t end = address + number;
+
+    for(; address < end; address += 4U) {
+        if(0xFFFFFFFFU != REG32(address)) {
+            return RESET;
+        }
+    }
+
+    return SET;
+}
@@ -0,0 +1,277 @@
+/*!
+    \file    crc_model.c
+    \brief   CRC unit and memory to memory DMA channel model behind the functions used by crc_service.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "crc_model.h"
+
+crc_model_struct crc_model;
+
+static uint8_t model_dma_flag = 0U;
+
+/*!
+    \brief      clear the model
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void crc_model_init(void)
+{
+    memset(&crc_model, 0, sizeof(crc_model));
+    crc_model.width = 32U;
+    crc_model.poly = 0x04C11DB7U;
+    crc_model.init = 0xFFFFFFFFU;
+    crc_model.data = 0xFFFFFFFFU;
+    model_dma_flag = 0U;
+}
+
+/*!
+    \brief      bit reverse a value
+    \param[in]  value: value to reverse
+    \param[in]  width: number of bits
+    \param[out] none
+    \retval     reversed value
+*/
+static uint32_t model_reverse(uint32_t value, uint32_t width)
+{
+    uint32_t result = 0U;
+    uint32_t i;
+
+    for(i = 0U; i < width; i++) {
+        result = (result << 1) | (value & 1U);
+        value >>= 1;
+    }
+    return result;
+}
+
+/*!
+    \brief      mask of the CRC bits
+    \param[in]  none
+    \param[out] none
+    \retval     mask
+*/
+static uint32_t model_mask(void)
+{
+    return (32U == crc_model.width) ? 0xFFFFFFFFU : ((1UL << crc_model.width) - 1U);
+}
+
+/*!
+    \brief      shift a data item into the CRC register, most significant bit first
+    \param[in]  value: data item
+    \param[in]  bits: 8, 16 or 32
+    \param[out] none
+    \retval     none
+*/
+static void model_feed(uint32_t value, uint32_t bits)
+{
+    uint32_t top, out = 0U;
+    int32_t bit;
+    uint32_t i;
+
+    if(CRC_INPUT_DATA_BYTE == crc_model.data_reverse) {
+        for(i = 0U; i < bits; i += 8U) {
+            out |= model_reverse((value >> i) & 0xFFU, 8U) << i;
+        }
+        value = out;
+    } else if(CRC_INPUT_DATA_WORD == crc_model.data_reverse) {
+        value = model_reverse(value, 32U) >> (32U - bits);
+    }
+
+    for(bit = (int32_t)bits - 1; bit >= 0; bit--) {
+        top = ((crc_model.data >> (crc_model.width - 1U)) & 1U) ^ ((value >> bit) & 1U);
+        crc_model.data = (crc_model.data << 1) & model_mask();
+        if(0U != top) {
+            crc_model.data ^= crc_model.poly;
+        }
+    }
+    crc_model.data &= model_mask();
+}
+
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void crc_deinit(void)
+{
+    crc_model_init();
+}
+
+void crc_polynomial_size_set(uint32_t poly_size)
+{
+    crc_model.width = (CRC_CTL_PS_32 == poly_size) ? 32U : ((CRC_CTL_PS_16 == poly_size) ? 16U : 8U);
+}
+
+void crc_polynomial_set(uint32_t poly)
+{
+    crc_model.poly = poly;
+}
+
+void crc_input_data_reverse_config(uint32_t data_reverse)
+{
+    crc_model.data_reverse = data_reverse;
+}
+
+void crc_reverse_output_data_disable(void)
+{
+    crc_model.output_reverse = 0U;
+}
+
+void crc_init_data_register_write(uint32_t init_data)
+{
+    crc_model.init = init_data;
+}
+
+void crc_data_register_reset(void)
+{
+    crc_model.data = crc_model.init & model_mask();
+}
+
+uint32_t crc_data_register_read(void)
+{
+    return crc_model.data;
+}
+
+uint32_t crc_block_data_calculate(void *array, uint32_t size, uint8_t data_format)
+{
+    uint32_t i;
+
+    if((INPUT_FORMAT_WORD == data_format) && (0U != (3U & (uintptr_t)array)) && (0U != size)) {
+        crc_model.unaligned++;
+    }
+    for(i = 0U; i < size; i++) {
+        if(INPUT_FORMAT_WORD == data_format) {
+            model_feed(((const uint32_t *)array)[i], 32U);
+            crc_model.fed_bytes += 4U;
+        } else {
+            model_feed(((const uint8_t *)array)[i], 8U);
+            crc_model.fed_bytes++;
+        }
+    }
+    return crc_model.data;
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    (void)channelx;
+    crc_model.dma_m2m = 0U;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    (void)channelx;
+    crc_model.dma_memory = init_struct->memory_addr;
+    crc_model.dma_number = init_struct->number;
+    crc_model.dma_memory_width = init_struct->memory_width;
+    crc_model.dma_periph_width = init_struct->periph_width;
+    crc_model.dma_periph_addr = init_struct->periph_addr;
+}
+
+void dma_circulation_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_to_memory_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    crc_model.dma_m2m = 1U;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_address_config(dma_channel_enum channelx, uint32_t address)
+{
+    (void)channelx;
+    crc_model.dma_memory = address;
+}
+
+void dma_transfer_number_config(dma_channel_enum channelx, uint32_t number)
+{
+    (void)channelx;
+    crc_model.dma_number = number;
+}
+
+void dma_flag_clear(dma_channel_enum channelx, uint32_t flag)
+{
+    (void)channelx;
+    (void)flag;
+    model_dma_flag = 0U;
+}
+
+FlagStatus dma_flag_get(dma_channel_enum channelx, uint32_t flag)
+{
+    (void)channelx;
+    (void)flag;
+    return (0U != model_dma_flag) ? SET : RESET;
+}
+
+/* the memory to memory transfer runs at once */
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    uint32_t i;
+
+    (void)channelx;
+    if((DMA_MEMORY_WIDTH_32BIT == crc_model.dma_memory_width) && (0U != (crc_model.dma_memory & 3U))) {
+        crc_model.unaligned++;
+    }
+    if((0U == crc_model.dma_m2m) || (crc_model.dma_periph_addr != (uint32_t)(uintptr_t)&CRC_DATA) ||
+            (crc_model.dma_memory_width != (crc_model.dma_periph_width << 2)) ||
+            (0U == crc_model.dma_number) || (crc_model.dma_number > 0xFFFFU)) {
+        crc_model.dma_errors++;
+    }
+    for(i = 0U; i < crc_model.dma_number; i++) {
+        if(DMA_MEMORY_WIDTH_32BIT == crc_model.dma_memory_width) {
+            model_feed(((const uint32_t *)(uintptr_t)crc_model.dma_memory)[i], 32U);
+            crc_model.dma_bytes += 4U;
+        } else {
+            model_feed(((const uint8_t *)(uintptr_t)crc_model.dma_memory)[i], 8U);
+            crc_model.dma_bytes++;
+        }
+    }
+    crc_model.dma_transfers++;
+    model_dma_flag = 1U;
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
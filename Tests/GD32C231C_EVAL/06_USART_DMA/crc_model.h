@@ -0,0 +1,67 @@
+/*!
+    \file    crc_model.h
+    \brief   CRC unit and memory to memory DMA channel model behind the functions used by crc_service.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef CRC_MODEL_H
+#define CRC_MODEL_H
+
+#include "gd32c2x1.h"
+
+typedef struct {
+    /* CRC unit */
+    uint32_t data;                      /* data register */
+    uint32_t init;                      /* initial value register */
+    uint32_t poly;
+    uint32_t width;
+    uint32_t data_reverse;              /* CRC_INPUT_DATA_NOT, _BYTE or _WORD */
+    uint8_t output_reverse;
+    uint32_t fed_bytes;                 /* bytes fed by the CPU */
+    uint32_t unaligned;                 /* words read at an unaligned address, a fault on the Cortex-M23 */
+    /* DMA channel */
+    uint32_t dma_memory;
+    uint32_t dma_number;
+    uint32_t dma_memory_width;
+    uint32_t dma_periph_width;
+    uint32_t dma_periph_addr;
+    uint8_t dma_m2m;
+    uint32_t dma_transfers;
+    uint32_t dma_bytes;                 /* bytes fed by the DMA */
+    uint32_t dma_errors;                /* transfer of the wrong width or target */
+} crc_model_struct;
+
+extern crc_model_struct crc_model;
+
+/* clear the model */
+void crc_model_init(void);
+
+#endif /* CRC_MODEL_H */
@@ -0,0 +1,185 @@
+/*!
+    \file    test_crc_service.c
+    \brief   the CPU, DMA, table and bitwise paths of crc_service.c give the same CRC
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_cmsis.h"
+#include "crc_model.h"
+#include "crc_service.c"
+
+#define TEST_BUFFER_SIZE    1024U
+
+typedef enum {
+    PATH_CPU = 0,
+    PATH_DMA,
+    PATH_TABLE,
+    PATH_BITWISE,
+    PATH_NUM
+} path_enum;
+
+static const crc_service_config_struct *const configs[] = {
+    &crc_service_crc32, &crc_service_crc32_mpeg2, &crc_service_crc16_ccitt, &crc_service_crc8
+};
+
+static uint32_t table[CRC_SERVICE_TABLE_SIZE];
+static uint8_t buffer[TEST_BUFFER_SIZE] __attribute__((aligned(4)));
+
+/* add data to a calculation by one of the paths */
+static void update(path_enum path, crc_service_context_struct *context, const void *data, uint32_t number)
+{
+    switch(path) {
+    case PATH_CPU:
+        crc_service_update(context, data, number);
+        break;
+    case PATH_DMA:
+        crc_service_update_dma(context, data, number);
+        break;
+    case PATH_TABLE:
+        crc_service_table_build(context->config, table);
+        crc_service_table_update(context, table, data, number);
+        break;
+    default:
+        crc_service_software_update(context, data, number);
+        break;
+    }
+}
+
+static uint32_t calculate(path_enum path, const crc_service_config_struct *config, const void *data, uint32_t number)
+{
+    crc_service_context_struct context;
+
+    crc_service_start(&context, config);
+    update(path, &context, data, number);
+    return crc_service_finish(&context);
+}
+
+/* the check values of the catalogue of CRC algorithms, "123456789" */
+static void test_vectors(void)
+{
+    static const uint32_t check[] = {0xCBF43926U, 0x0376E6E7U, 0x29B1U, 0xF4U};
+    static const uint8_t digits[] __attribute__((aligned(4))) = "123456789";
+    /* CRC-32 of empty data and of a 4-byte zero word */
+    static const uint8_t zeros[4] __attribute__((aligned(4))) = {0U, 0U, 0U, 0U};
+    uint32_t path, k;
+
+    crc_model_init();
+    crc_service_init();
+    for(path = 0U; path < PATH_NUM; path++) {
+        for(k = 0U; k < sizeof(configs) / sizeof(configs[0]); k++) {
+            HOST_CHECK_EQ(calculate((path_enum)path, configs[k], digits, 9U), check[k]);
+        }
+        HOST_CHECK_EQ(calculate((path_enum)path, &crc_service_crc32, digits, 0U), 0x00000000U);
+        HOST_CHECK_EQ(calculate((path_enum)path, &crc_service_crc32, zeros, 4U), 0x2144DF1CU);
+        HOST_CHECK_EQ(calculate((path_enum)path, &crc_service_crc32_mpeg2, zeros, 4U), 0xC704DD7BU);
+    }
+    HOST_CHECK_EQ(crc_model.dma_errors, 0);
+    HOST_CHECK_EQ(crc_model.unaligned, 0);
+}
+
+/* every alignment and length, streamed in two parts and interleaved with another calculation */
+static void test_paths(void)
+{
+    crc_service_context_struct context[PATH_NUM], other;
+    uint32_t expected, crc, k, path, offset, number, split;
+
+    for(k = 0U; k < TEST_BUFFER_SIZE; k++) {
+        buffer[k] = (uint8_t)(k * 151U + (k >> 7) + 3U);
+    }
+
+    crc_model_init();
+    crc_service_init();
+    for(k = 0U; k < sizeof(configs) / sizeof(configs[0]); k++) {
+        for(offset = 0U; offset < 4U; offset++) {
+            for(number = 0U; number < 70U; number += 3U) {
+                expected = calculate(PATH_BITWISE, configs[k], &buffer[offset], number);
+                for(path = 0U; path < PATH_NUM; path++) {
+                    HOST_CHECK_EQ(calculate((path_enum)path, configs[k], &buffer[offset], number), expected);
+                }
+
+                /* the CRC unit is shared, each update restores its context */
+                split = number / 3U;
+                for(path = 0U; path < PATH_NUM; path++) {
+                    crc_service_start(&context[path], configs[k]);
+                    update((path_enum)path, &context[path], &buffer[offset], split);
+                }
+                crc_service_start(&other, &crc_service_crc16_ccitt);
+                crc_service_update(&other, buffer, 11U);
+                for(path = 0U; path < PATH_NUM; path++) {
+                    update((path_enum)path, &context[path], &buffer[offset + split], number - split);
+                    crc = crc_service_finish(&context[path]);
+                    HOST_CHECK_EQ(crc, expected);
+                }
+            }
+        }
+    }
+    HOST_CHECK_EQ(crc_model.dma_errors, 0);
+    HOST_CHECK_EQ(crc_model.unaligned, 0);
+}
+
+/* a large buffer goes through the DMA in blocks of CRC_SERVICE_DMA_BLOCK bytes at most */
+static void test_dma_blocks(void)
+{
+    static uint8_t image[0x10000U + 7U] __attribute__((aligned(4)));
+    uint32_t k, expected;
+
+    for(k = 0U; k < sizeof(image); k++) {
+        image[k] = (uint8_t)(k ^ (k >> 8) ^ (k >> 13));
+    }
+
+    crc_model_init();
+    crc_service_init();
+    for(k = 0U; k < sizeof(configs) / sizeof(configs[0]); k++) {
+        expected = calculate(PATH_BITWISE, configs[k], &image[1], sizeof(image) - 1U);
+        crc_model.dma_bytes = 0U;
+        crc_model.dma_transfers = 0U;
+        HOST_CHECK_EQ(calculate(PATH_DMA, configs[k], &image[1], sizeof(image) - 1U), expected);
+        HOST_CHECK_EQ(calculate(PATH_TABLE, configs[k], &image[1], sizeof(image) - 1U), expected);
+        /* the DMA feeds everything but the unaligned head and tail of the reflected algorithms */
+        HOST_CHECK(crc_model.dma_bytes >= (sizeof(image) - 8U));
+        HOST_CHECK_EQ(crc_model.dma_transfers, 2);
+    }
+    HOST_CHECK_EQ(crc_model.dma_errors, 0);
+    HOST_CHECK_EQ(crc_model.unaligned, 0);
+}
+
+int main(void)
+{
+    test_vectors();
+    test_paths();
+    test_dma_blocks();
+
+    return host_test_result("crc_service");
+}
@@ -0,0 +1,186 @@
+/*!
+    \file    test_flash_write.c
+    \brief   host test of the flash writer: row merging, fast program and lazy page erase
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "host_cmsis.h"
+#include "fmc_model.h"
+#include "flash_write.c"
+
+/* four pages of the upper flash */
+#define TEST_AREA           (MAIN_FLASH_BASE_ADDRESS + 0x8000U)
+#define TEST_AREA_SIZE      (4U * MAIN_FLASH_PAGE_SIZE)
+
+/* sources below 4 GiB, fmc_fast_program() takes the buffer address as a 32-bit value */
+static uint8_t source[TEST_AREA_SIZE + 8U] __attribute__((aligned(8)));
+static uint8_t image[TEST_AREA_SIZE];
+
+/* every call leaves the FMC locked and the interrupts enabled */
+static void check_idle(void)
+{
+    HOST_CHECK_EQ(fmc_model.locked, 1);
+    HOST_CHECK_EQ(host_primask, 0);
+    HOST_CHECK_EQ(fmc_model.errors, 0);
+}
+
+/* a stream of random chunks from random source alignments over written pages */
+static void test_stream(void)
+{
+    uint32_t written = 0U, number, align, k;
+
+    host_periph_reset();
+    srand(17U);
+    for(k = 0U; k < TEST_AREA_SIZE; k++) {
+        image[k] = (uint8_t)rand();
+    }
+    /* old data, each page is erased once */
+    memset((void *)(uintptr_t)TEST_AREA, 0x5A, TEST_AREA_SIZE);
+
+    fmc_model_init();
+    flash_write_init();
+    while(written < TEST_AREA_SIZE) {
+        number = 1U + ((uint32_t)rand() % 200U);
+        if(number > (TEST_AREA_SIZE - written)) {
+            number = TEST_AREA_SIZE - written;
+        }
+        align = (uint32_t)rand() & 7U;
+        memcpy(&source[align], &image[written], number);
+        HOST_CHECK_EQ(flash_write(TEST_AREA + written, &source[align], number), FMC_READY);
+        check_idle();
+        written += number;
+    }
+    HOST_CHECK_EQ(flash_write_flush(), FMC_READY);
+    check_idle();
+
+    HOST_CHECK(0 == memcmp((const void *)(uintptr_t)TEST_AREA, image, TEST_AREA_SIZE));
+    HOST_CHECK_EQ(fmc_model.erases, TEST_AREA_SIZE / MAIN_FLASH_PAGE_SIZE);
+    /* every row is completed in RAM or given whole, none is programmed by doublewords */
+    HOST_CHECK_EQ(fmc_model.rows, TEST_AREA_SIZE / FLASH_WRITE_ROW_SIZE);
+    HOST_CHECK_EQ(fmc_model.doublewords, 0);
+
+    /* a new session erases the written pages again */
+    fmc_model_init();
+    flash_write_init();
+    memcpy(source, image, TEST_AREA_SIZE);
+    HOST_CHECK_EQ(flash_write(TEST_AREA, source, TEST_AREA_SIZE), FMC_READY);
+    check_idle();
+    HOST_CHECK_EQ(fmc_model.erases, TEST_AREA_SIZE / MAIN_FLASH_PAGE_SIZE);
+    HOST_CHECK_EQ(fmc_model.rows, TEST_AREA_SIZE / FLASH_WRITE_ROW_SIZE);
+    HOST_CHECK(0 == memcmp((const void *)(uintptr_t)TEST_AREA, image, TEST_AREA_SIZE));
+}
+
+/* a partial row is programmed by doublewords, its programmed bytes can only be written again unchanged */
+static void test_partial(void)
+{
+    const uint32_t row = TEST_AREA + FLASH_WRITE_ROW_SIZE;
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)row;
+    uint32_t k;
+
+    host_periph_reset();
+    fmc_model_init();
+    flash_write_init();
+    for(k = 0U; k < FLASH_WRITE_ROW_SIZE; k++) {
+        source[k] = (uint8_t)(0xA0U + k);
+    }
+
+    /* bytes 3 to 15 are kept in RAM until the flush, the blank page is not erased */
+    HOST_CHECK_EQ(flash_write(row + 3U, &source[3], 13U), FMC_READY);
+    HOST_CHECK_EQ(fmc_model.operations, 0);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_READY);
+    check_idle();
+    HOST_CHECK_EQ(fmc_model.erases, 0);
+    HOST_CHECK_EQ(fmc_model.doublewords, 2);
+    HOST_CHECK_EQ(fmc_model.rows, 0);
+    for(k = 0U; k < FLASH_WRITE_ROW_SIZE; k++) {
+        HOST_CHECK_EQ(flash[k], ((k >= 3U) && (k < 16U)) ? source[k] : 0xFFU);
+    }
+
+    /* the rest of the row is still blank, only its doublewords are programmed */
+    HOST_CHECK_EQ(flash_write(row + 16U, &source[16], FLASH_WRITE_ROW_SIZE - 16U), FMC_READY);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_READY);
+    check_idle();
+    HOST_CHECK_EQ(fmc_model.doublewords, FLASH_WRITE_DOUBLEWORD_NUM);
+    HOST_CHECK_EQ(fmc_model.rows, 0);
+
+    /* the same bytes again are accepted without programming, other bytes are refused */
+    HOST_CHECK_EQ(flash_write(row + 3U, &source[3], 13U), FMC_READY);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_READY);
+    HOST_CHECK_EQ(fmc_model.doublewords, FLASH_WRITE_DOUBLEWORD_NUM);
+    source[20] ^= 0x01U;
+    HOST_CHECK_EQ(flash_write(row + 20U, &source[20], 1U), FMC_READY);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_PGERR);
+    check_idle();
+    HOST_CHECK_EQ(flash[20], (uint8_t)(source[20] ^ 0x01U));
+    /* bytes 0 to 2 share a programmed doubleword, the programmed bytes are compared as well */
+    HOST_CHECK_EQ(flash_write(row, source, 3U), FMC_READY);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_PGERR);
+    check_idle();
+    HOST_CHECK_EQ(fmc_model.doublewords, FLASH_WRITE_DOUBLEWORD_NUM);
+}
+
+/* the writes outside the main flash are refused before any operation */
+static void test_range(void)
+{
+    const uint32_t end = MAIN_FLASH_BASE_ADDRESS + MAIN_FLASH_SIZE;
+
+    host_periph_reset();
+    fmc_model_init();
+    flash_write_init();
+    HOST_CHECK_EQ(flash_write(MAIN_FLASH_BASE_ADDRESS - 1U, source, 1U), FMC_UNDEFINEDERR);
+    HOST_CHECK_EQ(flash_write(end - 8U, source, 9U), FMC_UNDEFINEDERR);
+    HOST_CHECK_EQ(flash_write(end, source, 1U), FMC_UNDEFINEDERR);
+    HOST_CHECK_EQ(flash_write(end - 8U, source, 0xFFFFFFFFU), FMC_UNDEFINEDERR);
+    HOST_CHECK_EQ(fmc_model.operations, 0);
+
+    /* the last bytes of the flash */
+    memset(source, 0x3C, 8U);
+    HOST_CHECK_EQ(flash_write(end - 8U, source, 8U), FMC_READY);
+    HOST_CHECK_EQ(flash_write(end, source, 0U), FMC_READY);
+    HOST_CHECK_EQ(flash_write_flush(), FMC_READY);
+    check_idle();
+    HOST_CHECK_EQ(fmc_model.doublewords, 1);
+    HOST_CHECK_EQ(REG32(end - 4U), 0x3C3C3C3CU);
+}
+
+int main(void)
+{
+    test_stream();
+    test_partial();
+    test_range();
+
+    return host_test_result("flash_write");
+}
@@ -0,0 +1,412 @@
+/*!
+    \file    test_frame_link.c
+    \brief   frame_link.c against the host library of 06_USART_DMA/Host: COBS round trip,
+             CRC rejection, and acknowledge, retransmit and resync over a pseudo-terminal
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#define _GNU_SOURCE
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_cmsis.h"
+#include "usart_rx_model.h"
+#include "frame_host.h"
+#include "frame_link.c"
+
+#define TEST_TIMEOUT_MS     100
+#define TEST_RETRIES        3U
+#define TEST_FRAMES         500U
+
+/* faults of the line, applied once to the frame counted by fault_frame */
+typedef enum {
+    FAULT_NONE = 0,
+    FAULT_FLIP,                         /* a byte of the frame is changed */
+    FAULT_DROP,                         /* a byte of the frame is lost */
+    FAULT_DELIMITER,                    /* the delimiter of the frame is lost */
+} fault_enum;
+
+/* payloads passed to the callback of frame_link_init() */
+static uint8_t board_payload[FRAME_LINK_PAYLOAD_SIZE];
+static uint32_t board_number;
+static uint32_t board_frames;
+static uint8_t board_echo = 0U;
+
+/* pseudo-terminal, the board holds the master side */
+static int board_fd = -1;
+static volatile int board_stop = 0;
+static volatile fault_enum fault_rx = FAULT_NONE;     /* host to board */
+static volatile uint32_t fault_rx_frame;
+static volatile uint32_t rx_delimiters = 0U;
+static volatile fault_enum fault_tx = FAULT_NONE;     /* board to host */
+static volatile uint32_t fault_tx_frame;
+static volatile uint32_t tx_delimiters = 0U;
+
+/* frames of the board, the demo answers with an echo and a status frame */
+static void board_frame(const uint8_t *payload, uint32_t number)
+{
+    uint8_t status[9];
+    uint32_t errors = frame_link_rx_error_get();
+
+    memcpy(board_payload, payload, number);
+    board_number = number;
+    board_frames++;
+    if(0U != board_echo) {
+        status[0] = 0x80U;
+        memcpy(&status[1], (const void *)&rx_frames, 4U);
+        memcpy(&status[5], &errors, 4U);
+        frame_link_tx_put(payload, number);
+        frame_link_tx_put(status, sizeof(status));
+    }
+}
+
+/* the COM ring buffer of the BSP: the batches go to the pseudo-terminal */
+uint32_t gd_eval_com_tx_write(const uint8_t *data, uint32_t number)
+{
+    static uint32_t position = 0U;
+    uint8_t byte;
+    uint32_t index;
+
+    for(index = 0U; index < number; index++) {
+        byte = data[index];
+        if((FAULT_NONE != fault_tx) && (fault_tx_frame == tx_delimiters) && (2U == position)) {
+            byte ^= (0x01U == byte) ? 0x02U : 0x01U;
+            fault_tx = FAULT_NONE;
+        }
+        position++;
+        if(FRAME_LINK_DELIMITER == data[index]) {
+            tx_delimiters++;
+            position = 0U;
+        }
+        if(1 != write(board_fd, &byte, 1U)) {
+            break;
+        }
+    }
+    return index;
+}
+
+/* the board: the received bytes go through the DMA model, the line goes idle when they stop */
+static void *board_thread(void *arg)
+{
+    uint32_t position = 0U, pending = 0U;
+    struct pollfd pfd;
+    uint8_t input[256];
+    uint8_t byte;
+    ssize_t count, index;
+
+    (void)arg;
+    while(0 == board_stop) {
+        pfd.fd = board_fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, 1) > 0) {
+            count = read(board_fd, input, sizeof(input));
+            for(index = 0; index < count; index++) {
+                byte = input[index];
+                if((FAULT_NONE != fault_rx) && (fault_rx_frame == rx_delimiters)) {
+                    if((FAULT_FLIP == fault_rx) && (2U == position)) {
+                        byte ^= (0x01U == byte) ? 0x02U : 0x01U;
+                        fault_rx = FAULT_NONE;
+                    } else if((FAULT_DROP == fault_rx) && (2U == position)) {
+                        position++;
+                        fault_rx = FAULT_NONE;
+                        continue;
+                    } else if((FAULT_DELIMITER == fault_rx) && (FRAME_LINK_DELIMITER == byte)) {
+                        rx_delimiters++;
+                        position = 0U;
+                        fault_rx = FAULT_NONE;
+                        continue;
+                    }
+                }
+                position++;
+                if(FRAME_LINK_DELIMITER == input[index]) {
+                    rx_delimiters++;
+                    position = 0U;
+                }
+                usart_rx_model_receive(&byte, 1U);
+                pending++;
+            }
+        } else if(0U != pending) {
+            usart_rx_model_idle();
+            pending = 0U;
+        }
+        frame_link_tx_flush();
+    }
+    return NULL;
+}
+
+/* board side decode of a host frame, straight through the receive callback */
+static void board_receive(const uint8_t *frame, uint32_t number)
+{
+    uint32_t index;
+
+    /* one byte per call, as the pieces of the DMA buffer may split a frame anywhere */
+    for(index = 0U; index < number; index++) {
+        frame_link_receive(&frame[index], 1U, RESET);
+    }
+}
+
+static void pattern(uint8_t *payload, uint32_t number, uint32_t kind)
+{
+    uint32_t index;
+
+    for(index = 0U; index < number; index++) {
+        switch(kind) {
+        case 0U:
+            payload[index] = 0x00U;
+            break;
+        case 1U:
+            payload[index] = (uint8_t)(index % 255U + 1U);
+            break;
+        default:
+            payload[index] = (0U == (index % (kind + 1U))) ? 0x00U : (uint8_t)(index * 31U + kind);
+            break;
+        }
+    }
+}
+
+/* the host and the board encode alike and each decodes the frames of the other */
+static void test_cobs(void)
+{
+    uint8_t payload[FRAME_LINK_PAYLOAD_SIZE];
+    uint8_t host_frame[FRAME_HOST_ENCODED_SIZE(FRAME_HOST_PAYLOAD_SIZE)];
+    uint8_t board_frame_buffer[FRAME_LINK_ENCODED_SIZE(FRAME_LINK_PAYLOAD_SIZE)];
+    frame_host_decoder_struct decoder;
+    uint32_t number, kind, length, board_length, index, zero;
+    int decoded = -1;
+
+    frame_link_init(board_frame);
+    board_echo = 0U;
+    frame_host_decoder_init(&decoder);
+    for(kind = 0U; kind < 5U; kind++) {
+        for(number = 0U; number <= FRAME_LINK_PAYLOAD_SIZE; number++) {
+            pattern(payload, number, kind);
+            length = frame_host_encode(host_frame, payload, number);
+            board_length = frame_link_encode(board_frame_buffer, payload, number,
+                                             crc_service_calculate(&crc_service_crc32_mpeg2, payload, number));
+            HOST_CHECK_EQ(length, board_length);
+            HOST_CHECK(0 == memcmp(host_frame, board_frame_buffer, length));
+            HOST_CHECK(length <= FRAME_HOST_ENCODED_SIZE(number));
+            /* the delimiter only ends the frame */
+            zero = 0U;
+            for(index = 0U; index < length; index++) {
+                zero += (0x00U == host_frame[index]) ? 1U : 0U;
+            }
+            HOST_CHECK_EQ(zero, 1);
+            HOST_CHECK_EQ(host_frame[length - 1U], FRAME_HOST_DELIMITER);
+
+            board_number = 0xFFFFFFFFU;
+            board_receive(host_frame, length);
+            HOST_CHECK_EQ(board_number, number);
+            HOST_CHECK(0 == memcmp(board_payload, payload, number));
+
+            for(index = 0U; index < board_length; index++) {
+                decoded = frame_host_decode(&decoder, board_frame_buffer[index]);
+            }
+            HOST_CHECK_EQ(decoded, number);
+            HOST_CHECK(0 == memcmp(decoder.frame, payload, number));
+        }
+    }
+    HOST_CHECK_EQ(frame_link_rx_error_get(), 0);
+    HOST_CHECK_EQ(decoder.errors, 0);
+}
+
+/* any changed byte of a frame drops it, the next frame is received */
+static void test_crc(void)
+{
+    uint8_t payload[40];
+    uint8_t frame[FRAME_HOST_ENCODED_SIZE(40U)];
+    uint8_t bad[FRAME_HOST_ENCODED_SIZE(40U)];
+    uint32_t length, index, bit, errors, dropped = 0U;
+
+    frame_link_init(board_frame);
+    pattern(payload, sizeof(payload), 6U);
+    length = frame_host_encode(frame, payload, sizeof(payload));
+    for(index = 0U; index < (length - 1U); index++) {
+        for(bit = 0U; bit < 8U; bit++) {
+            memcpy(bad, frame, length);
+            bad[index] ^= (uint8_t)(1U << bit);
+            if(0x00U == bad[index]) {
+                /* a new delimiter, tested by test_link() */
+                continue;
+            }
+            errors = frame_link_rx_error_get();
+            board_frames = 0U;
+            board_receive(bad, length);
+            HOST_CHECK_EQ(board_frames, 0);
+            HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 1U);
+            dropped++;
+        }
+    }
+    HOST_CHECK(dropped > (length * 7U));
+
+    /* a valid COBS body with a wrong CRC */
+    memcpy(bad, frame, length);
+    bad[length - 2U] ^= 0x10U;
+    board_frames = 0U;
+    board_receive(bad, length);
+    board_receive(frame, length);
+    HOST_CHECK_EQ(board_frames, 1);
+    HOST_CHECK_EQ(board_number, sizeof(payload));
+
+    /* a frame longer than the payload size */
+    memset(bad, 0x55U, sizeof(bad));
+    errors = frame_link_rx_error_get();
+    board_receive(bad, sizeof(bad));
+    board_receive((const uint8_t *)"\0", 1U);
+    HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 1U);
+}
+
+static double now_s(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + ((double)now.tv_nsec / 1e9);
+}
+
+/* one request, its echo is the acknowledge */
+static void request(frame_host_link_struct *link, uint32_t number, uint32_t seed, uint32_t retransmits)
+{
+    uint8_t payload[FRAME_HOST_PAYLOAD_SIZE];
+    uint8_t reply[FRAME_HOST_PAYLOAD_SIZE];
+    uint32_t before = link->retransmits;
+    int length;
+
+    pattern(payload, number, seed % 7U);
+    if(0U != number) {
+        payload[0] = (uint8_t)(seed & 0x0FU);
+    }
+    length = frame_host_request(link, payload, number, reply, sizeof(reply), frame_host_ack_echo,
+                                TEST_TIMEOUT_MS, TEST_RETRIES);
+    HOST_CHECK_EQ(length, number);
+    HOST_CHECK(0 == memcmp(reply, payload, number));
+    HOST_CHECK_EQ(link->retransmits - before, retransmits);
+}
+
+/* the board and the host library over a pseudo-terminal */
+static void test_link(void)
+{
+    frame_host_link_struct link;
+    pthread_t thread;
+    uint8_t status[9];
+    uint32_t index, errors, frames;
+    double start, seconds;
+    int length;
+
+    board_fd = posix_openpt(O_RDWR | O_NOCTTY);
+    HOST_CHECK(board_fd >= 0);
+    HOST_CHECK(0 == grantpt(board_fd));
+    HOST_CHECK(0 == unlockpt(board_fd));
+    HOST_CHECK(0 == frame_host_open(&link, ptsname(board_fd), 115200U));
+    if((board_fd < 0) || (link.fd < 0)) {
+        return;
+    }
+
+    usart_rx_model_init(0U);
+    usart_enable(USART0);
+    frame_link_init(board_frame);
+    board_echo = 1U;
+    board_stop = 0;
+    pthread_create(&thread, NULL, board_thread, NULL);
+
+    /* every length, the status frame after each echo is skipped */
+    for(index = 0U; index <= FRAME_HOST_PAYLOAD_SIZE; index++) {
+        request(&link, index, index, 0U);
+    }
+
+    /* the request is lost to a changed byte, a lost byte or a lost delimiter and sent again */
+    errors = frame_link_rx_error_get();
+    fault_rx_frame = rx_delimiters;
+    fault_rx = FAULT_FLIP;
+    request(&link, 20U, 1U, 1U);
+    HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 1U);
+    fault_rx_frame = rx_delimiters;
+    fault_rx = FAULT_DROP;
+    request(&link, 33U, 2U, 1U);
+    HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 2U);
+    fault_rx_frame = rx_delimiters;
+    fault_rx = FAULT_DELIMITER;
+    /* the first retransmit ends the frame left open, only the second one gets through */
+    request(&link, 64U, 3U, 2U);
+    HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 3U);
+
+    /* the echo is lost, the board answers the retransmit */
+    frame_host_receive(&link, status, sizeof(status), 20);
+    frames = link.decoder.errors;
+    fault_tx_frame = tx_delimiters;
+    fault_tx = FAULT_FLIP;
+    request(&link, 50U, 4U, 1U);
+    HOST_CHECK_EQ(link.decoder.errors, frames + 1U);
+
+    /* bytes without a delimiter before the next frame, the board resyncs at the retransmit */
+    HOST_CHECK_EQ(write(link.fd, "\x05garbage", 8U), 8);
+    request(&link, 10U, 5U, 1U);
+    HOST_CHECK_EQ(frame_link_rx_error_get(), errors + 4U);
+
+    /* the status frame counts the frames and the errors */
+    length = frame_host_receive(&link, status, sizeof(status), TEST_TIMEOUT_MS);
+    HOST_CHECK_EQ(length, sizeof(status));
+    HOST_CHECK_EQ(status[0], 0x80U);
+    HOST_CHECK_EQ(status[5], errors + 4U);
+
+    /* round trips without faults */
+    start = now_s();
+    for(index = 0U; index < TEST_FRAMES; index++) {
+        request(&link, 64U, index, 0U);
+    }
+    seconds = now_s() - start;
+    printf("pty loopback: %.0f round trips/s of 64 byte frames\n", TEST_FRAMES / seconds);
+    HOST_CHECK_EQ(link.failures, 0);
+    HOST_CHECK_EQ(usart_rx_model.lost_bytes, 0);
+
+    board_stop = 1;
+    pthread_join(thread, NULL);
+    frame_host_close(&link);
+    close(board_fd);
+}
+
+int main(void)
+{
+    test_cobs();
+    test_crc();
+    test_link();
+
+    return host_test_result("frame_link");
+}
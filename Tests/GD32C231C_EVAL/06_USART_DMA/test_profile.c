@@ -0,0 +1,219 @@
+/*!
+    \file    test_profile.c
+    \brief   host test of the profiling probes: statistics against a reference, timing by the
+             probe macros and the printed table
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_cmsis.h"
+#include "profile.c"
+
+#define TEST_SAMPLES        100000U
+
+/* microseconds read by the probe macros */
+static uint32_t test_now;
+
+uint32_t time_now_us32(void)
+{
+    return test_now;
+}
+
+static void check_entry(profile_probe_enum probe, uint32_t count, uint32_t min, uint32_t max, uint64_t total)
+{
+    profile_entry_struct entry;
+
+    profile_get(probe, &entry);
+    HOST_CHECK_EQ(entry.count, count);
+    HOST_CHECK_EQ(entry.min, min);
+    HOST_CHECK_EQ(entry.max, max);
+    HOST_CHECK(entry.total == total);
+}
+
+/* random samples on every probe against the statistics kept here */
+static void test_record(void)
+{
+    profile_entry_struct reference[PROFILE_PROBE_NUM];
+    uint32_t k, us;
+    uint8_t probe;
+
+    srand(25U);
+    memset(reference, 0, sizeof(reference));
+    profile_reset();
+    for(k = 0U; k < TEST_SAMPLES; k++) {
+        probe = (uint8_t)((uint32_t)rand() % PROFILE_PROBE_NUM);
+        us = (0 != (rand() % 16)) ? ((uint32_t)rand() % 1000U) : (((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        if((0U == reference[probe].count) || (us < reference[probe].min)) {
+            reference[probe].min = us;
+        }
+        if(us > reference[probe].max) {
+            reference[probe].max = us;
+        }
+        reference[probe].total += us;
+        reference[probe].count++;
+        /* masked or not, the interrupts are as they were */
+        host_primask = k & 1U;
+        profile_record((profile_probe_enum)probe, us);
+        HOST_CHECK_EQ(host_primask, k & 1U);
+    }
+    host_primask = 0U;
+    for(probe = 0U; probe < PROFILE_PROBE_NUM; probe++) {
+        check_entry((profile_probe_enum)probe, reference[probe].count, reference[probe].min,
+                    reference[probe].max, reference[probe].total);
+    }
+
+    /* the first sample sets the minimum, even a large one */
+    profile_reset();
+    check_entry(PROFILE_MAIN_LOOP, 0U, 0U, 0U, 0U);
+    profile_record(PROFILE_MAIN_LOOP, 500U);
+    check_entry(PROFILE_MAIN_LOOP, 1U, 500U, 500U, 500U);
+    profile_record(PROFILE_MAIN_LOOP, 0U);
+    check_entry(PROFILE_MAIN_LOOP, 2U, 0U, 500U, 500U);
+
+    /* the total does not wrap at 32 bits */
+    for(k = 0U; k < 4U; k++) {
+        profile_record(PROFILE_USART0_IRQ, 0xFFFFFFFFU);
+    }
+    check_entry(PROFILE_USART0_IRQ, 4U, 0xFFFFFFFFU, 0xFFFFFFFFU, 4ULL * 0xFFFFFFFFULL);
+
+    /* unknown probes */
+    profile_record(PROFILE_PROBE_NUM, 7U);
+    check_entry(PROFILE_PROBE_NUM, 0U, 0U, 0U, 0U);
+    HOST_CHECK(0 == strcmp(profile_name_get(PROFILE_PROBE_NUM), "?"));
+}
+
+/* the rounded average */
+static void test_average(void)
+{
+    profile_entry_struct entry = {0U, 0U, 0U, 0U};
+
+    HOST_CHECK_EQ(profile_average(&entry), 0U);
+    entry.count = 4U;
+    entry.total = 10U;
+    HOST_CHECK_EQ(profile_average(&entry), 3U);
+    entry.total = 9U;
+    HOST_CHECK_EQ(profile_average(&entry), 2U);
+    entry.count = 3U;
+    entry.total = 4U;
+    HOST_CHECK_EQ(profile_average(&entry), 1U);
+    entry.total = 5U;
+    HOST_CHECK_EQ(profile_average(&entry), 2U);
+    entry.count = 4U;
+    entry.total = 4ULL * 0xFFFFFFFFULL;
+    HOST_CHECK_EQ(profile_average(&entry), 0xFFFFFFFFU);
+}
+
+/* the probe macros time their block, across the wrap of the 32-bit time */
+static void timed_block(uint32_t us)
+{
+    PROFILE_BEGIN(PROFILE_DMA_CH1_IRQ);
+    test_now += us;
+    PROFILE_END(PROFILE_DMA_CH1_IRQ);
+}
+
+static void test_macros(void)
+{
+    profile_reset();
+    test_now = 1000U;
+    timed_block(25U);
+    test_now = 0xFFFFFFF0U;
+    timed_block(40U);
+    PROFILE_RECORD(PROFILE_TIMER13_LATENCY, 3U);
+    check_entry(PROFILE_DMA_CH1_IRQ, 2U, 25U, 40U, 65U);
+    check_entry(PROFILE_TIMER13_LATENCY, 1U, 3U, 3U, 3U);
+}
+
+/* one line per probe with its name, count, min, average and max */
+static void test_dump(void)
+{
+    char line[128], name[32], expected[32];
+    unsigned int count, min, average, max;
+    uint32_t lines = 0U;
+    FILE *file;
+    int saved;
+    uint8_t i;
+
+    profile_reset();
+    for(i = 0U; i < PROFILE_PROBE_NUM; i++) {
+        profile_record((profile_probe_enum)i, i);
+        profile_record((profile_probe_enum)i, 2U * i + 1U);
+        HOST_CHECK(0 != strcmp(profile_name_get((profile_probe_enum)i), "?"));
+        if(0U != i) {
+            HOST_CHECK(0 != strcmp(profile_name_get((profile_probe_enum)i), profile_name_get((profile_probe_enum)(i - 1U))));
+        }
+    }
+    HOST_CHECK(0 == strcmp(profile_name_get(PROFILE_USART0_IRQ), "USART0_IRQ"));
+    HOST_CHECK(0 == strcmp(profile_name_get(PROFILE_MAIN_LOOP), "MAIN_LOOP"));
+
+    file = tmpfile();
+    fflush(stdout);
+    saved = dup(fileno(stdout));
+    dup2(fileno(file), fileno(stdout));
+    profile_dump();
+    fflush(stdout);
+    dup2(saved, fileno(stdout));
+    close(saved);
+
+    rewind(file);
+    HOST_CHECK(NULL != fgets(line, sizeof(line), file));
+    HOST_CHECK(0 == strncmp(line, "probe", 5U));
+    while(NULL != fgets(line, sizeof(line), file)) {
+        /* the lines end with "\n\r" for the terminal */
+        if('\0' == line[strspn(line, "\r\n")]) {
+            continue;
+        }
+        HOST_CHECK_EQ(sscanf(line, "%31s %u %u %u %u", name, &count, &min, &average, &max), 5);
+        snprintf(expected, sizeof(expected), "%s", profile_name_get((profile_probe_enum)lines));
+        HOST_CHECK(0 == strcmp(name, expected));
+        HOST_CHECK_EQ(count, 2U);
+        HOST_CHECK_EQ(min, lines);
+        HOST_CHECK_EQ(max, 2U * lines + 1U);
+        HOST_CHECK_EQ(average, (3U * lines + 2U) / 2U);
+        lines++;
+    }
+    fclose(file);
+    HOST_CHECK_EQ(lines, PROFILE_PROBE_NUM);
+}
+
+int main(void)
+{
+    test_record();
+    test_average();
+    test_macros();
+    test_dump();
+
+    return host_test_result("profile");
+}
@@ -0,0 +1,254 @@
+/*!
+    \file    test_time_base.c
+    \brief   host test of the overflow extension of time_base.c on a TIMER model whose counter
+             moves during the reads and whose interrupt comes late
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include "host_test.h"
+#include "time_base.c"
+
+/* one simulated hour */
+#define TEST_RUN_US         (3600ULL * 1000000ULL)
+/* longest latency of the update interrupt */
+#define TEST_LATENCY_US     30000U
+
+/* true time in microseconds, the counter is its low 16 bits */
+static uint64_t model_time;
+static uint32_t model_upif;
+static uint64_t model_wrap;
+static uint32_t model_double_wraps;
+/* each counter read takes exactly 1us, after the read */
+static uint8_t model_exact;
+
+/* the time goes on, an overflow sets the update flag */
+static void model_step(uint32_t us)
+{
+    uint64_t before = model_time >> 16;
+
+    model_time += us;
+    if((model_time >> 16) != before) {
+        if(((model_time >> 16) - before) > 1U) {
+            model_double_wraps++;
+        }
+        model_upif = 1U;
+        model_wrap = model_time & ~0xFFFFULL;
+    }
+}
+
+/* each register access takes a few microseconds, the counter moves on either side of the read */
+uint32_t time_base_host_counter(void)
+{
+    uint32_t value;
+
+    if(0U != model_exact) {
+        value = (uint32_t)(model_time & 0xFFFFU);
+        model_step(1U);
+        return value;
+    }
+    model_step((uint32_t)rand() % 4U);
+    value = (uint32_t)(model_time & 0xFFFFU);
+    model_step((uint32_t)rand() % 4U);
+    return value;
+}
+
+uint32_t time_base_host_update(void)
+{
+    if(0U == model_exact) {
+        model_step((uint32_t)rand() % 3U);
+    }
+    return model_upif;
+}
+
+void time_base_host_update_clear(void)
+{
+    model_upif = 0U;
+}
+
+/* the time base is started at a time, its overflows counted */
+static void model_init(uint64_t time)
+{
+    time_base_overflow = time >> 16;
+    model_time = time;
+    model_upif = 0U;
+    model_wrap = 0U;
+    model_double_wraps = 0U;
+    model_exact = 0U;
+}
+
+/* every read is inside its read window and the reads never go back */
+static void test_reads(void)
+{
+    uint64_t before, now, prev = 0U, irq_due = 0U;
+    uint32_t reads = 0U, outside = 0U, backwards = 0U, irqs = 0U, late_reads = 0U;
+    uint8_t irq_pending = 0U;
+
+    srand(24U);
+    model_init(0U);
+    while(model_time < TEST_RUN_US) {
+        /* the update interrupt is served up to 30ms after the overflow */
+        if((0U != model_upif) && (0U == irq_pending)) {
+            irq_pending = 1U;
+            irq_due = model_wrap + ((0 != (rand() % 4)) ? ((uint32_t)rand() % 50U) : ((uint32_t)rand() % TEST_LATENCY_US));
+        }
+        if((0U != irq_pending) && (model_time >= irq_due)) {
+            irq_pending = 0U;
+            time_base_irq_handler();
+            irqs++;
+        }
+        if(0U != irq_pending) {
+            late_reads++;
+        }
+
+        before = model_time;
+        if(0 != (rand() & 1)) {
+            now = time_now_us();
+        } else {
+            now = (uint64_t)time_now_us32() | (model_time & ~0xFFFFFFFFULL);
+            /* the 32-bit read wrapped in between */
+            if(now > model_time) {
+                now -= 0x100000000ULL;
+            }
+        }
+        if((now < before) || (now > model_time)) {
+            outside++;
+        }
+        if(now < prev) {
+            backwards++;
+        }
+        prev = now;
+        reads++;
+        model_step((uint32_t)rand() % ((0 != (rand() % 8)) ? 40U : 5000U));
+    }
+
+    HOST_CHECK_EQ(outside, 0U);
+    HOST_CHECK_EQ(backwards, 0U);
+    HOST_CHECK_EQ(model_double_wraps, 0U);
+    HOST_CHECK_EQ(irqs, (uint32_t)(model_time >> 16));
+    HOST_CHECK(late_reads > 100000U);
+    HOST_CHECK(reads > 5000000U);
+}
+
+/* the interrupt without a pending overflow counts nothing */
+static void test_irq(void)
+{
+    uint64_t now;
+
+    model_init(0x123450000ULL);
+    time_base_irq_handler();
+    now = time_now_us();
+    HOST_CHECK(now >= 0x123450000ULL);
+    HOST_CHECK(now < 0x123450100ULL);
+
+    /* an overflow served between two reads is counted once */
+    model_step(0x10000U);
+    HOST_CHECK_EQ(model_upif, 1U);
+    now = time_now_us();
+    HOST_CHECK(now >= 0x123460000ULL);
+    HOST_CHECK(now < 0x123460100ULL);
+    time_base_irq_handler();
+    HOST_CHECK_EQ(model_upif, 0U);
+    HOST_CHECK_EQ(time_base_overflow, 0x12346U);
+    now = time_now_us();
+    HOST_CHECK(now >= 0x123460000ULL);
+    HOST_CHECK(now < 0x123460100ULL);
+    time_base_irq_handler();
+    HOST_CHECK_EQ(time_base_overflow, 0x12346U);
+
+    /* the overflows carry beyond 32 bits, before and after the interrupt is served */
+    model_init(0xFFFFFFFF0000ULL);
+    model_step(0x10000U);
+    now = time_now_us();
+    HOST_CHECK(now >= 0x1000000000000ULL);
+    HOST_CHECK(now < 0x1000000000100ULL);
+    time_base_irq_handler();
+    HOST_CHECK_EQ(time_base_overflow, 0x100000000ULL);
+    now = time_now_us();
+    HOST_CHECK(now >= 0x1000000000000ULL);
+    HOST_CHECK(now < 0x1000000000100ULL);
+}
+
+/* delays, intervals and deadlines, across the 32-bit wrap */
+static void test_helpers(void)
+{
+    uint64_t start, deadline;
+    uint32_t start32, elapsed;
+
+    srand(25U);
+    model_init(0xFFFF0000ULL - 300U);
+
+    start32 = time_now_us32();
+    model_step(777U);
+    time_base_irq_handler();
+    elapsed = time_elapsed_us(start32);
+    HOST_CHECK(elapsed >= 777U);
+    HOST_CHECK(elapsed < 800U);
+
+    /* delay_us() waits the count at least and stops a few reads later */
+    start = model_time;
+    delay_us(70000U);
+    time_base_irq_handler();
+    HOST_CHECK(model_time >= (start + 70000U));
+    HOST_CHECK(model_time < (start + 70020U));
+    HOST_CHECK(time_now_us32() < start32);
+    start = model_time;
+    delay_us(0U);
+    HOST_CHECK(model_time < (start + 20U));
+
+    deadline = time_deadline_get(1000U);
+    HOST_CHECK_EQ(time_deadline_reached(deadline), RESET);
+    model_step(990U);
+    HOST_CHECK_EQ(time_deadline_reached(deadline), RESET);
+    model_step(20U);
+    HOST_CHECK_EQ(time_deadline_reached(deadline), SET);
+    HOST_CHECK(deadline > 0x100000000ULL);
+
+    /* to the microsecond with reads of 1us */
+    model_exact = 1U;
+    start = model_time;
+    delay_us(100U);
+    HOST_CHECK_EQ(model_time, start + 101U);
+    deadline = time_deadline_get(1000U);
+    HOST_CHECK_EQ(deadline, model_time - 1U + 1000U);
+    model_step(998U);
+    HOST_CHECK_EQ(time_deadline_reached(deadline), RESET);
+    HOST_CHECK_EQ(time_deadline_reached(deadline), SET);
+}
+
+int main(void)
+{
+    test_irq();
+    test_helpers();
+    test_reads();
+
+    return host_test_result("time_base");
+}
@@ -0,0 +1,364 @@
+/*!
+    \file    test_update_agent.c
+    \brief   host test of a dual-slot update replayed into the main flash model, the slot
+             selection of the 17_FMC_Dual_Slot_Bootloader after each update, a rejected
+             image and a power cut at every flash operation
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "host_cmsis.h"
+#include "crc_model.h"
+#include "fmc_model.h"
+#include "crc_service.c"
+#include "flash_write.c"
+#include "update_agent.c"
+
+/* the bootloader, its main() is not run */
+#define __set_MSP(stack)    ((void)(stack))
+#define main                boot_main
+#include "Src/main.c"
+#undef main
+
+/* the largest image, it ends in the last page of the slot */
+#define TEST_IMAGE_SIZE     BOOT_SLOT_IMAGE_SIZE
+#define TEST_CHUNK_SIZE     123U
+/* the image of the power cut test doesn't reach the last page, the descriptor erases it */
+#define TEST_CUT_IMAGE_SIZE 4500U
+
+static uint8_t image[3][TEST_IMAGE_SIZE] __attribute__((aligned(4)));
+static uint8_t saved[MAIN_FLASH_SIZE];
+static uint8_t reply[7];
+static jmp_buf reset_jump;
+static uint32_t resets;
+/* a bit of this flash address is cleared before the end command, 0 none */
+static uint32_t flash_fault = 0U;
+
+ErrStatus frame_link_tx_put(const uint8_t *payload, uint32_t number)
+{
+    memcpy(reply, payload, (number < sizeof(reply)) ? number : sizeof(reply));
+    return SUCCESS;
+}
+
+void frame_link_tx_flush(void)
+{
+}
+
+void gd_eval_com_tx_flush(void)
+{
+}
+
+void gd_eval_led_init(led_typedef_enum lednum)
+{
+    (void)lednum;
+}
+
+void gd_eval_led_on(led_typedef_enum lednum)
+{
+    (void)lednum;
+}
+
+void rcu_periph_clock_disable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void nvic_vector_table_set(uint32_t nvic_vict_tab, uint32_t offset)
+{
+    SCB->VTOR = nvic_vict_tab | offset;
+}
+
+void nvic_system_reset(void)
+{
+    resets++;
+    longjmp(reset_jump, 1);
+}
+
+/* pass a frame to the agent and process it, return the status of the reply */
+static uint8_t command(const uint8_t *payload, uint32_t number)
+{
+    memset(reply, 0, sizeof(reply));
+    HOST_CHECK_EQ(update_agent_receive(payload, number), SUCCESS);
+    update_agent_poll();
+    HOST_CHECK_EQ(reply[0], UPDATE_AGENT_REPLY);
+    HOST_CHECK_EQ(reply[1], payload[0]);
+    return reply[2];
+}
+
+static uint32_t reply_value(void)
+{
+    return (uint32_t)reply[3] | ((uint32_t)reply[4] << 8) | ((uint32_t)reply[5] << 16) | ((uint32_t)reply[6] << 24);
+}
+
+static void value_put(uint8_t *data, uint32_t value)
+{
+    data[0] = (uint8_t)value;
+    data[1] = (uint8_t)(value >> 8);
+    data[2] = (uint8_t)(value >> 16);
+    data[3] = (uint8_t)(value >> 24);
+}
+
+/* a reset: the RAM of the agent is lost, the bootloader selects a slot and starts it */
+static uint32_t reboot(void)
+{
+    uint32_t slot;
+
+    agent_frame_length = 0U;
+    agent_started = RESET;
+    agent_reset = RESET;
+    crc_model_init();
+    crc_service_init();
+    slot = boot_slot_select();
+    SCB->VTOR = slot;
+
+    return slot;
+}
+
+/* an image of random data with the vectors of a slot */
+static void image_make(uint8_t *data, uint32_t slot)
+{
+    uint32_t k;
+
+    for(k = 0U; k < TEST_IMAGE_SIZE; k++) {
+        data[k] = (uint8_t)rand();
+    }
+    value_put(&data[0], SRAM_BASE + 0x3000U);
+    value_put(&data[4], slot + 0x101U);
+}
+
+/* replay an update in chunks, some of them sent twice, the byte at offset corrupt, if not 0,
+   is corrupted on the link, return the status of the end command */
+static uint8_t update(const uint8_t *data, uint32_t size, uint32_t corrupt)
+{
+    uint8_t frame[5U + TEST_CHUNK_SIZE];
+    uint32_t offset = 0U, resend, number;
+    uint8_t status;
+
+    frame[0] = UPDATE_AGENT_START;
+    value_put(&frame[1], size);
+    value_put(&frame[5], crc_service_calculate(&crc_service_crc32, data, size));
+    status = command(frame, 9U);
+    if(UPDATE_AGENT_OK != status) {
+        return status;
+    }
+
+    while(offset < size) {
+        number = 1U + ((uint32_t)rand() % TEST_CHUNK_SIZE);
+        if(number > (size - offset)) {
+            number = size - offset;
+        }
+        /* a chunk whose reply was lost is sent again, the agent gives the offset to resume from */
+        resend = ((0U != offset) && (0U == ((uint32_t)rand() % 16U))) ? 1U : 0U;
+        frame[0] = UPDATE_AGENT_DATA;
+        value_put(&frame[1], offset - resend);
+        memcpy(&frame[5], &data[offset - resend], number);
+        if((0U != corrupt) && (offset <= corrupt) && (corrupt < (offset + number))) {
+            frame[5U + corrupt - offset] ^= 0x10U;
+        }
+        status = command(frame, 5U + number);
+        if(0U != resend) {
+            HOST_CHECK_EQ(status, UPDATE_AGENT_ERROR_OFFSET);
+            HOST_CHECK_EQ(reply_value(), offset);
+            continue;
+        }
+        if(UPDATE_AGENT_OK != status) {
+            return status;
+        }
+        HOST_CHECK_EQ(reply_value(), offset + number);
+        offset = reply_value();
+    }
+
+    if(0U != flash_fault) {
+        *(uint8_t *)(uintptr_t)flash_fault &= 0xFEU;
+    }
+    frame[0] = UPDATE_AGENT_END;
+    status = command(frame, 1U);
+    if(UPDATE_AGENT_OK == status) {
+        /* the next poll resets the MCU */
+        if(0 == setjmp(reset_jump)) {
+            update_agent_poll();
+            HOST_CHECK(0);
+        }
+    }
+
+    return status;
+}
+
+/* a factory image in slot A, then updates of slot B and of slot A */
+static void test_update(void)
+{
+    const uint8_t query = UPDATE_AGENT_QUERY;
+
+    host_periph_reset();
+    fmc_model_init();
+    srand(18U);
+    image_make(image[0], BOOT_SLOT_A_ADDRESS);
+    image_make(image[1], BOOT_SLOT_B_ADDRESS);
+    image_make(image[2], BOOT_SLOT_A_ADDRESS);
+
+    /* programmed by the debugger without descriptor */
+    memcpy((void *)(uintptr_t)BOOT_SLOT_A_ADDRESS, image[0], 0x4000U);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+    HOST_CHECK_EQ(command(&query, 1U), UPDATE_AGENT_OK);
+    HOST_CHECK_EQ(reply_value(), BOOT_SLOT_B_ADDRESS);
+
+    resets = 0U;
+    HOST_CHECK_EQ(update(image[1], 20001U, 0U), UPDATE_AGENT_OK);
+    HOST_CHECK_EQ(resets, 1);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_B_ADDRESS);
+    HOST_CHECK(0 == memcmp((const void *)(uintptr_t)BOOT_SLOT_B_ADDRESS, image[1], 20001U));
+    HOST_CHECK_EQ(BOOT_SLOT_DESCRIPTOR(BOOT_SLOT_B_ADDRESS)->sequence, 1);
+    HOST_CHECK_EQ(command(&query, 1U), UPDATE_AGENT_OK);
+    HOST_CHECK_EQ(reply_value(), BOOT_SLOT_A_ADDRESS);
+
+    HOST_CHECK_EQ(update(image[2], TEST_IMAGE_SIZE, 0U), UPDATE_AGENT_OK);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+    HOST_CHECK(0 == memcmp((const void *)(uintptr_t)BOOT_SLOT_A_ADDRESS, image[2], TEST_IMAGE_SIZE));
+    HOST_CHECK_EQ(BOOT_SLOT_DESCRIPTOR(BOOT_SLOT_A_ADDRESS)->sequence, 2);
+    HOST_CHECK_EQ(fmc_model.errors, 0);
+    HOST_CHECK_EQ(crc_model.dma_errors, 0);
+    HOST_CHECK_EQ(crc_model.unaligned, 0);
+}
+
+/* the rejected images and commands leave the running slot selected */
+static void test_rollback(void)
+{
+    uint8_t frame[9] = {UPDATE_AGENT_START};
+
+    /* slot A runs, slot B is updated */
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+    image_make(image[1], BOOT_SLOT_B_ADDRESS);
+
+    /* a chunk corrupted on the link */
+    HOST_CHECK_EQ(update(image[1], 9000U, 4321U), UPDATE_AGENT_ERROR_CRC);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+
+    /* a bit lost in the flash, the read back catches it */
+    image[1][777] |= 0x01U;
+    flash_fault = BOOT_SLOT_B_ADDRESS + 777U;
+    HOST_CHECK_EQ(update(image[1], 9000U, 0U), UPDATE_AGENT_ERROR_CRC);
+    flash_fault = 0U;
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+
+    /* commands out of sequence and an image too large */
+    frame[0] = UPDATE_AGENT_END;
+    HOST_CHECK_EQ(command(frame, 1U), UPDATE_AGENT_ERROR_STATE);
+    frame[0] = UPDATE_AGENT_DATA;
+    HOST_CHECK_EQ(command(frame, 6U), UPDATE_AGENT_ERROR_STATE);
+    frame[0] = UPDATE_AGENT_START;
+    value_put(&frame[1], TEST_IMAGE_SIZE + 1U);
+    HOST_CHECK_EQ(command(frame, 9U), UPDATE_AGENT_ERROR_SIZE);
+    frame[0] = 0x1EU;
+    HOST_CHECK_EQ(command(frame, 1U), UPDATE_AGENT_ERROR_STATE);
+
+    /* an application not started by the bootloader doesn't know its slot */
+    SCB->VTOR = BOOT_LOADER_ADDRESS;
+    frame[0] = UPDATE_AGENT_QUERY;
+    HOST_CHECK_EQ(command(frame, 1U), UPDATE_AGENT_ERROR_SLOT);
+    frame[0] = UPDATE_AGENT_START;
+    HOST_CHECK_EQ(command(frame, 9U), UPDATE_AGENT_ERROR_SLOT);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+    HOST_CHECK_EQ(fmc_model.errors, 0);
+}
+
+/* a power cut at each erase or program of an update of the other slot: the running slot is
+   started until the descriptor of the new one is complete, then the update is replayed */
+static void test_power_cut(void)
+{
+    uint32_t total, cut, slot, seed;
+
+    /* slot B runs, slot A is updated */
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+    image_make(image[1], BOOT_SLOT_B_ADDRESS);
+    HOST_CHECK_EQ(update(image[1], 20001U, 0U), UPDATE_AGENT_OK);
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_B_ADDRESS);
+    memcpy(saved, (const void *)(uintptr_t)MAIN_FLASH_BASE_ADDRESS, MAIN_FLASH_SIZE);
+    image_make(image[2], BOOT_SLOT_A_ADDRESS);
+
+    /* the operations of the update */
+    seed = (uint32_t)rand();
+    srand(seed);
+    fmc_model_init();
+    HOST_CHECK_EQ(update(image[2], TEST_CUT_IMAGE_SIZE, 0U), UPDATE_AGENT_OK);
+    total = fmc_model.operations;
+    HOST_CHECK(total > (TEST_CUT_IMAGE_SIZE / FLASH_WRITE_ROW_SIZE));
+
+    for(cut = 1U; cut <= total; cut++) {
+        memcpy((void *)(uintptr_t)MAIN_FLASH_BASE_ADDRESS, saved, MAIN_FLASH_SIZE);
+        HOST_CHECK_EQ(reboot(), BOOT_SLOT_B_ADDRESS);
+        srand(seed);
+        fmc_model_init();
+        fmc_model.cut_at = cut;
+        if(0 == setjmp(fmc_model_cut)) {
+            (void)update(image[2], TEST_CUT_IMAGE_SIZE, 0U);
+            HOST_CHECK(0);
+            continue;
+        }
+
+        slot = reboot();
+        if(cut < total) {
+            HOST_CHECK_EQ(slot, BOOT_SLOT_B_ADDRESS);
+        } else {
+            /* the sequence number is not programmed yet, either slot holds a verified image */
+            HOST_CHECK((BOOT_SLOT_A_ADDRESS == slot) || (BOOT_SLOT_B_ADDRESS == slot));
+        }
+        if(BOOT_SLOT_B_ADDRESS != slot) {
+            continue;
+        }
+
+        /* the update is sent again after the power is back */
+        fmc_model_init();
+        HOST_CHECK_EQ(update(image[2], TEST_CUT_IMAGE_SIZE, 0U), UPDATE_AGENT_OK);
+        HOST_CHECK_EQ(reboot(), BOOT_SLOT_A_ADDRESS);
+        HOST_CHECK_EQ(BOOT_SLOT_DESCRIPTOR(BOOT_SLOT_A_ADDRESS)->sequence,
+                      BOOT_SLOT_DESCRIPTOR(BOOT_SLOT_B_ADDRESS)->sequence + 1U);
+        HOST_CHECK_EQ(fmc_model.errors, 0);
+    }
+    HOST_CHECK(0 == memcmp((const void *)(uintptr_t)BOOT_SLOT_A_ADDRESS, image[2], TEST_CUT_IMAGE_SIZE));
+
+    /* a bit lost in the new image, the bootloader goes back to the previous one */
+    *(uint8_t *)(uintptr_t)(BOOT_SLOT_A_ADDRESS + 1000U) ^= 0x01U;
+    HOST_CHECK_EQ(reboot(), BOOT_SLOT_B_ADDRESS);
+    HOST_CHECK_EQ(crc_model.dma_errors, 0);
+}
+
+int main(void)
+{
+    test_update();
+    test_rollback();
+    test_power_cut();
+
+    return host_test_result("update_agent");
+}
@@ -0,0 +1,193 @@
+/*!
+    \file    test_usart_dma_rx.c
+    \brief   frame boundaries of the circular DMA receive of usart_dma_rx.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "usart_rx_model.h"
+#include "usart_dma_rx.c"
+
+#define TEST_MAX_FRAMES     64U
+#define TEST_STREAM_SIZE    8192U
+
+/* frames seen by the callback, their bytes are concatenated */
+static uint8_t received[TEST_STREAM_SIZE];
+static uint32_t received_size;
+static uint32_t frame_ends[TEST_MAX_FRAMES];
+static uint32_t frames;
+/* callback misuse, all of them must stay zero */
+static uint32_t outside;                /* piece not inside the DMA buffer */
+static uint32_t empty_pieces;           /* empty piece which does not end a frame */
+
+static void test_callback(const uint8_t *data, uint32_t number, FlagStatus frame_end)
+{
+    if((data < rx_buffer) || ((data + number) > &rx_buffer[USART_DMA_RX_BUFFER_SIZE])) {
+        outside++;
+    }
+    if((0U == number) && (SET != frame_end)) {
+        empty_pieces++;
+    }
+    if((received_size + number) <= TEST_STREAM_SIZE) {
+        memcpy(&received[received_size], data, number);
+    }
+    received_size += number;
+    if((SET == frame_end) && (frames < TEST_MAX_FRAMES)) {
+        frame_ends[frames++] = received_size;
+    }
+}
+
+static void test_start(uint32_t usart_periph, uint32_t latency)
+{
+    usart_rx_model_init(latency);
+    received_size = 0U;
+    frames = 0U;
+    outside = 0U;
+    empty_pieces = 0U;
+    usart_enable(usart_periph);
+    usart_dma_rx_init(usart_periph, test_callback);
+}
+
+/* the DMA channel and the frame end interrupt of each USART */
+static void test_config(void)
+{
+    test_start(USART0, 0U);
+    HOST_CHECK_EQ(usart_rx_model.dma_channel, USART_DMA_RX_CHANNEL);
+    HOST_CHECK_EQ(usart_rx_model.dma_request, DMA_REQUEST_USART0_RX);
+    HOST_CHECK_EQ(usart_rx_model.dma_number, USART_DMA_RX_BUFFER_SIZE);
+    HOST_CHECK_EQ(usart_rx_model.dma_memory, (uint32_t)(uintptr_t)rx_buffer);
+    HOST_CHECK_EQ(usart_rx_model.dma_circular, 1);
+    HOST_CHECK_EQ(usart_rx_model.dma_enabled, 1);
+    HOST_CHECK_EQ(usart_rx_model.dma_interrupts, DMA_INT_HTF | DMA_INT_FTF);
+    HOST_CHECK_EQ(usart_rx_model.enabled, 1);
+    HOST_CHECK_EQ(usart_rx_model.rx_dma, 1);
+    HOST_CHECK_EQ(usart_rx_model.timeout_enabled, 1);
+    HOST_CHECK_EQ(usart_rx_model.timeout, USART_DMA_RX_TIMEOUT);
+    HOST_CHECK_EQ(usart_rx_model.rt_interrupt, 1);
+    HOST_CHECK_EQ(usart_rx_model.idle_interrupt, 0);
+    HOST_CHECK_EQ(usart_rx_model.err_interrupt, 1);
+
+    test_start(USART1, 0U);
+    HOST_CHECK_EQ(usart_rx_model.dma_request, DMA_REQUEST_USART1_RX);
+    HOST_CHECK_EQ(usart_rx_model.timeout_enabled, 0);
+    HOST_CHECK_EQ(usart_rx_model.rt_interrupt, 0);
+    HOST_CHECK_EQ(usart_rx_model.idle_interrupt, 1);
+}
+
+/* frames of every length around the half and full buffer, each followed by an idle line */
+static void test_frames(uint32_t usart_periph, uint32_t latency)
+{
+    static const uint32_t lengths[] = {1U, 10U, 63U, 64U, 65U, 127U, 128U, 129U, 300U, 5U, 200U, 64U,
+                                       64U, 1U, 255U, 256U, 257U, 2U, 3U
+                                      };
+    uint8_t stream[TEST_STREAM_SIZE];
+    uint32_t index, total = 0U;
+
+    for(index = 0U; index < TEST_STREAM_SIZE; index++) {
+        stream[index] = (uint8_t)(index * 13U + (index >> 8) + 1U);
+    }
+
+    test_start(usart_periph, latency);
+    for(index = 0U; index < sizeof(lengths) / sizeof(lengths[0]); index++) {
+        usart_rx_model_receive(&stream[total], lengths[index]);
+        total += lengths[index];
+        usart_rx_model_idle();
+        HOST_CHECK_EQ(frames, index + 1U);
+        HOST_CHECK_EQ(frame_ends[index], total);
+    }
+    HOST_CHECK_EQ(received_size, total);
+    HOST_CHECK(0 == memcmp(received, stream, total));
+    HOST_CHECK_EQ(outside, 0);
+    HOST_CHECK_EQ(empty_pieces, 0);
+    HOST_CHECK_EQ(usart_rx_model.missed_flags, 0);
+    HOST_CHECK_EQ(usart_rx_model.lost_bytes, 0);
+    HOST_CHECK_EQ(usart_dma_rx_overrun_get(), 0);
+}
+
+/* a frame ending on a half buffer boundary is delivered by the DMA interrupt, the idle line adds an empty end */
+static void test_boundary(void)
+{
+    uint8_t data[USART_DMA_RX_BUFFER_SIZE / 2U];
+
+    memset(data, 0x5A, sizeof(data));
+    test_start(USART0, 0U);
+    usart_rx_model_receive(data, sizeof(data));
+    HOST_CHECK_EQ(received_size, sizeof(data));
+    HOST_CHECK_EQ(frames, 0);
+    usart_rx_model_idle();
+    HOST_CHECK_EQ(frames, 1);
+    HOST_CHECK_EQ(frame_ends[0], sizeof(data));
+
+    /* an idle line without bytes ends an empty frame */
+    usart_rx_model_idle();
+    HOST_CHECK_EQ(frames, 2);
+    HOST_CHECK_EQ(frame_ends[1], sizeof(data));
+}
+
+/* overruns are counted, the frames go on */
+static void test_overrun(void)
+{
+    uint8_t data[3] = {1U, 2U, 3U};
+
+    test_start(USART0, 0U);
+    usart_rx_model_overrun();
+    usart_rx_model_overrun();
+    usart_rx_model_receive(data, sizeof(data));
+    usart_rx_model_idle();
+    HOST_CHECK_EQ(usart_dma_rx_overrun_get(), 2);
+    HOST_CHECK_EQ(frames, 1);
+    HOST_CHECK_EQ(received_size, sizeof(data));
+
+    /* nothing reaches the callback once stopped */
+    usart_dma_rx_deinit();
+    HOST_CHECK_EQ(usart_rx_model.rx_dma, 0);
+    HOST_CHECK_EQ(usart_rx_model.dma_enabled, 0);
+    usart_rx_model_receive(data, sizeof(data));
+    usart_rx_model_idle();
+    HOST_CHECK_EQ(frames, 1);
+    HOST_CHECK_EQ(usart_rx_model.lost_bytes, sizeof(data));
+}
+
+int main(void)
+{
+    test_config();
+    test_frames(USART0, 0U);
+    test_frames(USART0, 40U);
+    test_frames(USART1, 0U);
+    test_frames(USART1, 63U);
+    test_boundary();
+    test_overrun();
+
+    return host_test_result("usart_dma_rx");
+}
@@ -0,0 +1,370 @@
+/*!
+    \file    usart_rx_model.c
+    \brief   USART receiver and circular DMA channel model behind the functions used by usart_dma_rx.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "usart_rx_model.h"
+#include "usart_dma_rx.h"
+
+usart_rx_model_struct usart_rx_model;
+
+/* bytes left before the pending DMA interrupt is served */
+static uint32_t model_countdown = 0U;
+
+/*!
+    \brief      clear the model
+    \param[in]  latency: bytes received between a DMA flag and its interrupt
+    \param[out] none
+    \retval     none
+*/
+void usart_rx_model_init(uint32_t latency)
+{
+    memset(&usart_rx_model, 0, sizeof(usart_rx_model));
+    usart_rx_model.irq_latency = latency;
+    model_countdown = 0U;
+}
+
+/*!
+    \brief      raise a DMA interrupt flag
+    \param[in]  flag: DMA_INT_FLAG_HTF or DMA_INT_FLAG_FTF
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_flag(uint32_t flag)
+{
+    if(0U != (usart_rx_model.dma_flags & flag)) {
+        usart_rx_model.missed_flags++;
+    }
+    if(0U == usart_rx_model.dma_flags) {
+        model_countdown = usart_rx_model.irq_latency;
+    }
+    usart_rx_model.dma_flags |= flag;
+}
+
+/*!
+    \brief      interrupt requests of the DMA channel
+    \param[in]  none
+    \param[out] none
+    \retval     SET if an enabled flag is pending
+*/
+static FlagStatus model_dma_request(void)
+{
+    uint32_t flags = 0U;
+
+    if(0U != (usart_rx_model.dma_interrupts & DMA_INT_HTF)) {
+        flags |= DMA_INT_FLAG_HTF;
+    }
+    if(0U != (usart_rx_model.dma_interrupts & DMA_INT_FTF)) {
+        flags |= DMA_INT_FLAG_FTF;
+    }
+    return (0U != (usart_rx_model.dma_flags & flags)) ? SET : RESET;
+}
+
+/*!
+    \brief      run the DMA interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_irq(void)
+{
+    usart_rx_model.dma_irqs++;
+    usart_dma_rx_dma_irq_handler();
+}
+
+/*!
+    \brief      receive bytes, the DMA writes them and its interrupts run on the way
+    \param[in]  data: bytes received
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     none
+*/
+void usart_rx_model_receive(const uint8_t *data, uint32_t number)
+{
+    uint8_t *memory;
+
+    while(number--) {
+        if((0U != usart_rx_model.enabled) && (0U != usart_rx_model.rx_dma) && (0U != usart_rx_model.dma_enabled) &&
+                (0U != usart_rx_model.dma_remaining)) {
+            memory = (uint8_t *)(uintptr_t)usart_rx_model.dma_memory;
+            memory[usart_rx_model.dma_number - usart_rx_model.dma_remaining] = *data;
+            usart_rx_model.dma_remaining--;
+            if((usart_rx_model.dma_number / 2U) == usart_rx_model.dma_remaining) {
+                model_dma_flag(DMA_INT_FLAG_HTF);
+            }
+            if(0U == usart_rx_model.dma_remaining) {
+                model_dma_flag(DMA_INT_FLAG_FTF);
+                if(0U != usart_rx_model.dma_circular) {
+                    usart_rx_model.dma_remaining = usart_rx_model.dma_number;
+                } else {
+                    usart_rx_model.dma_enabled = 0U;
+                }
+            }
+        } else {
+            usart_rx_model.lost_bytes++;
+        }
+        data++;
+
+        /* DMA interrupt */
+        if(SET == model_dma_request()) {
+            if(0U != model_countdown) {
+                model_countdown--;
+            } else {
+                model_dma_irq();
+            }
+        }
+    }
+}
+
+/*!
+    \brief      the line stays idle: pending DMA interrupts run, then the receiver timeout or idle interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void usart_rx_model_idle(void)
+{
+    /* the DMA channel has the lower IRQ number, it is served first at the same priority */
+    if(SET == model_dma_request()) {
+        model_dma_irq();
+    }
+    if((USART0 == usart_rx_model.periph) && (0U != usart_rx_model.timeout_enabled)) {
+        usart_rx_model.rt_flag = 1U;
+    }
+    usart_rx_model.idle_flag = 1U;
+    if(((0U != usart_rx_model.rt_flag) && (0U != usart_rx_model.rt_interrupt)) ||
+            ((0U != usart_rx_model.idle_flag) && (0U != usart_rx_model.idle_interrupt))) {
+        usart_rx_model.usart_irqs++;
+        usart_dma_rx_irq_handler();
+    }
+}
+
+/*!
+    \brief      a byte arrives before the previous one is read
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void usart_rx_model_overrun(void)
+{
+    usart_rx_model.orerr_flag = 1U;
+    if(0U != usart_rx_model.err_interrupt) {
+        usart_rx_model.usart_irqs++;
+        usart_dma_rx_irq_handler();
+    }
+}
+
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq;
+    (void)nvic_irq_priority;
+}
+
+void usart_enable(uint32_t usart_periph)
+{
+    usart_rx_model.periph = usart_periph;
+    usart_rx_model.enabled = 1U;
+}
+
+void usart_disable(uint32_t usart_periph)
+{
+    usart_rx_model.periph = usart_periph;
+    usart_rx_model.enabled = 0U;
+}
+
+void usart_receiver_timeout_threshold_config(uint32_t usart_periph, uint32_t rtimeout)
+{
+    (void)usart_periph;
+    usart_rx_model.timeout = rtimeout;
+}
+
+void usart_receiver_timeout_enable(uint32_t usart_periph)
+{
+    (void)usart_periph;
+    usart_rx_model.timeout_enabled = 1U;
+}
+
+void usart_dma_receive_config(uint32_t usart_periph, uint32_t dmacmd)
+{
+    (void)usart_periph;
+    usart_rx_model.rx_dma = (USART_RECEIVE_DMA_ENABLE == dmacmd) ? 1U : 0U;
+}
+
+void usart_flag_clear(uint32_t usart_periph, usart_flag_enum flag)
+{
+    (void)usart_periph;
+    if(USART_FLAG_ORERR == flag) {
+        usart_rx_model.orerr_flag = 0U;
+    }
+}
+
+void usart_interrupt_enable(uint32_t usart_periph, usart_interrupt_enum interrupt)
+{
+    (void)usart_periph;
+    if(USART_INT_RT == interrupt) {
+        usart_rx_model.rt_interrupt = 1U;
+    } else if(USART_INT_IDLE == interrupt) {
+        usart_rx_model.idle_interrupt = 1U;
+    } else if(USART_INT_ERR == interrupt) {
+        usart_rx_model.err_interrupt = 1U;
+    }
+}
+
+void usart_interrupt_disable(uint32_t usart_periph, usart_interrupt_enum interrupt)
+{
+    (void)usart_periph;
+    if(USART_INT_RT == interrupt) {
+        usart_rx_model.rt_interrupt = 0U;
+    } else if(USART_INT_IDLE == interrupt) {
+        usart_rx_model.idle_interrupt = 0U;
+    } else if(USART_INT_ERR == interrupt) {
+        usart_rx_model.err_interrupt = 0U;
+    }
+}
+
+FlagStatus usart_interrupt_flag_get(uint32_t usart_periph, usart_interrupt_flag_enum int_flag)
+{
+    (void)usart_periph;
+    if(USART_INT_FLAG_RT == int_flag) {
+        return ((0U != usart_rx_model.rt_interrupt) && (0U != usart_rx_model.rt_flag)) ? SET : RESET;
+    }
+    if(USART_INT_FLAG_IDLE == int_flag) {
+        return ((0U != usart_rx_model.idle_interrupt) && (0U != usart_rx_model.idle_flag)) ? SET : RESET;
+    }
+    if(USART_INT_FLAG_ERR_ORERR == int_flag) {
+        return ((0U != usart_rx_model.err_interrupt) && (0U != usart_rx_model.orerr_flag)) ? SET : RESET;
+    }
+    return RESET;
+}
+
+void usart_interrupt_flag_clear(uint32_t usart_periph, usart_interrupt_flag_enum int_flag)
+{
+    (void)usart_periph;
+    if(USART_INT_FLAG_RT == int_flag) {
+        usart_rx_model.rt_flag = 0U;
+    } else if(USART_INT_FLAG_IDLE == int_flag) {
+        usart_rx_model.idle_flag = 0U;
+    } else if(USART_INT_FLAG_ERR_ORERR == int_flag) {
+        usart_rx_model.orerr_flag = 0U;
+    }
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    usart_rx_model.dma_channel = channelx;
+    usart_rx_model.dma_enabled = 0U;
+    usart_rx_model.dma_circular = 0U;
+    usart_rx_model.dma_interrupts = 0U;
+    usart_rx_model.dma_flags = 0U;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    usart_rx_model.dma_channel = channelx;
+    usart_rx_model.dma_memory = init_struct->memory_addr;
+    usart_rx_model.dma_number = init_struct->number;
+    usart_rx_model.dma_remaining = init_struct->number;
+    usart_rx_model.dma_request = init_struct->request;
+}
+
+void dma_circulation_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    usart_rx_model.dma_circular = 1U;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    usart_rx_model.dma_interrupts |= source;
+}
+
+void dma_interrupt_disable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    usart_rx_model.dma_interrupts &= ~source;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    return (0U != (usart_rx_model.dma_flags & int_flag)) ? SET : RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    if(DMA_INT_FLAG_G == int_flag) {
+        usart_rx_model.dma_flags = 0U;
+    } else {
+        usart_rx_model.dma_flags &= ~int_flag;
+    }
+}
+
+uint32_t dma_transfer_number_get(dma_channel_enum channelx)
+{
+    (void)channelx;
+    return usart_rx_model.dma_remaining;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    usart_rx_model.dma_enabled = 1U;
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    usart_rx_model.dma_enabled = 0U;
+}
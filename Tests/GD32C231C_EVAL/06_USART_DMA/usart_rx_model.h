@@ -0,0 +1,82 @@
+/*!
+    \file    usart_rx_model.h
+    \brief   USART receiver and circular DMA channel model behind the functions used by usart_dma_rx.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef USART_RX_MODEL_H
+#define USART_RX_MODEL_H
+
+#include "gd32c2x1.h"
+
+typedef struct {
+    /* USART */
+    uint32_t periph;                    /* USART of the last configuration */
+    uint8_t enabled;
+    uint8_t rx_dma;                     /* SET once the receive DMA request is enabled */
+    uint8_t timeout_enabled;            /* receiver timeout of USART0 */
+    uint32_t timeout;                   /* receiver timeout threshold, in bit times */
+    uint8_t rt_interrupt;
+    uint8_t idle_interrupt;
+    uint8_t err_interrupt;
+    uint8_t rt_flag;
+    uint8_t idle_flag;
+    uint8_t orerr_flag;
+    /* DMA channel */
+    uint32_t dma_channel;
+    uint32_t dma_memory;
+    uint32_t dma_number;
+    uint32_t dma_request;
+    uint32_t dma_remaining;             /* value of the transfer counter */
+    uint32_t dma_interrupts;            /* enabled DMA interrupts */
+    uint32_t dma_flags;                 /* pending DMA interrupt flags */
+    uint8_t dma_circular;
+    uint8_t dma_enabled;
+    /* interrupts */
+    uint32_t irq_latency;               /* bytes received between a DMA flag and its interrupt */
+    uint32_t dma_irqs;
+    uint32_t usart_irqs;
+    uint32_t missed_flags;              /* a DMA flag was raised again before it was cleared */
+    uint32_t lost_bytes;                /* bytes received while the DMA was stopped */
+} usart_rx_model_struct;
+
+extern usart_rx_model_struct usart_rx_model;
+
+/* clear the model, the DMA interrupts are served after latency bytes */
+void usart_rx_model_init(uint32_t latency);
+/* receive bytes, the DMA writes them and its interrupts run on the way */
+void usart_rx_model_receive(const uint8_t *data, uint32_t number);
+/* the line stays idle: pending DMA interrupts run, then the receiver timeout or idle interrupt */
+void usart_rx_model_idle(void);
+/* a byte arrives before the previous one is read */
+void usart_rx_model_overrun(void);
+
+#endif /* USART_RX_MODEL_H */
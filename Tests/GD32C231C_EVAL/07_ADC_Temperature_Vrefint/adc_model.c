@@ -0,0 +1,499 @@
+/*!
+    \file    adc_model.c
+    \brief   ADC routine sequence triggered by TIMER2, analog watchdogs and circular DMA channel
+             model behind the functions used by adc_scan.c and adc_monitor.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "adc_model.h"
+#include "adc_scan.h"
+
+adc_model_struct adc_model;
+uint32_t SystemCoreClock = 48000000U;
+
+/* scans left before the pending DMA interrupt is served */
+static uint32_t model_countdown = 0U;
+/* conversions of each channel */
+static uint32_t model_channel_conversions[ADC_MODEL_CHANNEL_NUM];
+
+static const uint32_t model_wd_flag[ADC_MODEL_WATCHDOG_NUM] = {ADC_INT_FLAG_WD0E, ADC_INT_FLAG_WD1E, ADC_INT_FLAG_WD2E};
+static const uint32_t model_wd_int[ADC_MODEL_WATCHDOG_NUM] = {ADC_INT_WD0E, ADC_INT_WD1E, ADC_INT_WD2E};
+
+/*!
+    \brief      clear the model
+    \param[in]  input: gives the conversions of the channels
+    \param[in]  latency: scans between a DMA flag and its interrupt
+    \param[out] none
+    \retval     none
+*/
+void adc_model_init(adc_model_input input, uint32_t latency)
+{
+    uint32_t i;
+
+    memset(&adc_model, 0, sizeof(adc_model));
+    memset(model_channel_conversions, 0, sizeof(model_channel_conversions));
+    adc_model.input = input;
+    adc_model.irq_latency = latency;
+    adc_model.oversample_ratio = 1U;
+    for(i = 0U; i < ADC_MODEL_WATCHDOG_NUM; i++) {
+        adc_model.wd_high[i] = 0x0FFFU;
+    }
+    model_countdown = 0U;
+}
+
+/*!
+    \brief      compare a result with the analog watchdogs, then run the ADC interrupt
+    \param[in]  channel: channel of the result
+    \param[in]  value: result
+    \param[out] none
+    \retval     none
+*/
+static void model_watchdog(uint8_t channel, uint16_t value)
+{
+    uint32_t pending = 0U;
+    uint32_t i;
+
+    for(i = 0U; i < ADC_MODEL_WATCHDOG_NUM; i++) {
+        if((0U != (adc_model.wd_channels[i] & (1UL << channel))) &&
+                ((value < adc_model.wd_low[i]) || (value > adc_model.wd_high[i]))) {
+            adc_model.flags |= model_wd_flag[i];
+        }
+        if((0U != (adc_model.flags & model_wd_flag[i])) && (0U != (adc_model.interrupts & model_wd_int[i]))) {
+            pending = 1U;
+        }
+    }
+    if((0U != pending) && (0U != adc_model.irq_enabled) && (NULL != adc_model.adc_irq)) {
+        adc_model.adc_irqs++;
+        adc_model.adc_irq();
+    }
+}
+
+/*!
+    \brief      raise a DMA interrupt flag
+    \param[in]  flag: DMA_INT_FLAG_HTF or DMA_INT_FLAG_FTF
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_flag(uint32_t flag)
+{
+    adc_model.halves++;
+    if(0U != (adc_model.dma_flags & flag)) {
+        adc_model.missed_flags++;
+    }
+    if(0U == adc_model.dma_flags) {
+        model_countdown = adc_model.irq_latency;
+    }
+    adc_model.dma_flags |= flag;
+}
+
+/*!
+    \brief      convert a rank of the sequence, with the oversampling
+    \param[in]  rank: rank in the sequence
+    \param[out] none
+    \retval     result of the rank
+*/
+static uint16_t model_convert(uint32_t rank)
+{
+    uint8_t channel = adc_model.channel[rank];
+    uint32_t ratio = (0U != adc_model.oversample_enabled) ? adc_model.oversample_ratio : 1U;
+    uint32_t shift = (0U != adc_model.oversample_enabled) ? adc_model.oversample_shift : 0U;
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    for(i = 0U; i < ratio; i++) {
+        sum += adc_model.input(channel, model_channel_conversions[channel]++) & 0x0FFFU;
+        adc_model.conversions++;
+    }
+    sum >>= shift;
+
+    /* the data register keeps 16 bits */
+    return (uint16_t)sum;
+}
+
+/*!
+    \brief      store a result by the DMA
+    \param[in]  value: result of a rank
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_store(uint16_t value)
+{
+    uint16_t *memory = (uint16_t *)(uintptr_t)adc_model.dma_memory;
+
+    if((0U == adc_model.dma_mode) || (0U == adc_model.dma_enabled) || (0U == adc_model.dma_routed) ||
+            (DMA_REQUEST_ADC != adc_model.dma_request) || (0U == adc_model.dma_number)) {
+        adc_model.lost++;
+        return;
+    }
+    memory[adc_model.dma_position++] = value;
+    if((adc_model.dma_number / 2U) == adc_model.dma_position) {
+        model_dma_flag(DMA_INT_FLAG_HTF);
+    }
+    if(adc_model.dma_number == adc_model.dma_position) {
+        model_dma_flag(DMA_INT_FLAG_FTF);
+        adc_model.dma_position = 0U;
+        if(0U == adc_model.dma_circular) {
+            adc_model.dma_enabled = 0U;
+        }
+    }
+}
+
+/*!
+    \brief      interrupt requests of the DMA channel
+    \param[in]  none
+    \param[out] none
+    \retval     SET if an enabled flag is pending
+*/
+static FlagStatus model_dma_request(void)
+{
+    uint32_t flags = 0U;
+
+    if(0U != (adc_model.dma_interrupts & DMA_INT_HTF)) {
+        flags |= DMA_INT_FLAG_HTF;
+    }
+    if(0U != (adc_model.dma_interrupts & DMA_INT_FTF)) {
+        flags |= DMA_INT_FLAG_FTF;
+    }
+    return (0U != (adc_model.dma_flags & flags)) ? SET : RESET;
+}
+
+/*!
+    \brief      run TIMER2 update events, each of them converts the sequence once
+    \param[in]  number: number of update events
+    \param[out] none
+    \retval     none
+*/
+void adc_model_run(uint32_t number)
+{
+    uint32_t rank;
+    uint16_t value;
+
+    while(number--) {
+        if((0U != adc_model.timer_enabled) && (TIMER_TRI_OUT_SRC_UPDATE == adc_model.timer_trgo) &&
+                (0U != adc_model.enabled) && (0U != adc_model.trigger_enabled) &&
+                (ADC_EXTTRIG_ROUTINE_T2_TRGO == adc_model.trigger_source)) {
+            adc_model.scans++;
+            for(rank = 0U; rank < ((0U != adc_model.scan_mode) ? adc_model.length : 1U); rank++) {
+                value = model_convert(rank);
+                model_dma_store(value);
+                model_watchdog(adc_model.channel[rank], value);
+            }
+        }
+
+        /* DMA interrupt */
+        if(SET == model_dma_request()) {
+            if(0U != model_countdown) {
+                model_countdown--;
+            } else {
+                adc_model.dma_irqs++;
+                if(((DMA_INT_FLAG_HTF | DMA_INT_FLAG_FTF) & adc_model.dma_flags) == (DMA_INT_FLAG_HTF | DMA_INT_FLAG_FTF)) {
+                    adc_model.both_flags++;
+                }
+                adc_scan_dma_irq_handler();
+            }
+        }
+    }
+}
+
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    if(RCU_DMAMUX == periph) {
+        adc_model.dmamux_clock = 1U;
+    }
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq_priority;
+    if(ADC_IRQn == nvic_irq) {
+        adc_model.irq_enabled = 1U;
+    }
+}
+
+void nvic_irq_disable(IRQn_Type nvic_irq)
+{
+    if(ADC_IRQn == nvic_irq) {
+        adc_model.irq_enabled = 0U;
+    }
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    (void)channelx;
+    adc_model.dma_enabled = 0U;
+    adc_model.dma_circular = 0U;
+    adc_model.dma_interrupts = 0U;
+    adc_model.dma_flags = 0U;
+    adc_model.dma_position = 0U;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    (void)channelx;
+    /* the request goes to a DMAMUX register, lost while the DMAMUX isn't clocked */
+    adc_model.dma_routed = adc_model.dmamux_clock;
+    adc_model.dma_request = init_struct->request;
+    adc_model.dma_memory = init_struct->memory_addr;
+    adc_model.dma_number = init_struct->number;
+    adc_model.dma_memory_width = init_struct->memory_width;
+    adc_model.dma_periph_width = init_struct->periph_width;
+    adc_model.dma_periph_addr = init_struct->periph_addr;
+}
+
+void dma_circulation_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    adc_model.dma_circular = 1U;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    adc_model.dma_interrupts |= source;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    return (0U != (adc_model.dma_flags & int_flag)) ? SET : RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    if(0U != (int_flag & DMA_INT_FLAG_G)) {
+        int_flag |= DMA_INT_FLAG_HTF | DMA_INT_FLAG_FTF;
+    }
+    adc_model.dma_flags &= ~int_flag;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    adc_model.dma_enabled = 1U;
+}
+
+uint32_t dma_transfer_number_get(dma_channel_enum channelx)
+{
+    (void)channelx;
+    return adc_model.dma_number - adc_model.dma_position;
+}
+
+void timer_deinit(uint32_t timer_periph)
+{
+    (void)timer_periph;
+    adc_model.timer_enabled = 0U;
+    adc_model.timer_trgo = 0U;
+}
+
+void timer_struct_para_init(timer_parameter_struct *initpara)
+{
+    memset(initpara, 0, sizeof(*initpara));
+}
+
+void timer_init(uint32_t timer_periph, timer_parameter_struct *initpara)
+{
+    (void)timer_periph;
+    adc_model.timer_prescaler = initpara->prescaler;
+    adc_model.timer_period = initpara->period;
+}
+
+void timer_master_output_trigger_source_select(uint32_t timer_periph, uint32_t outtrigger)
+{
+    (void)timer_periph;
+    adc_model.timer_trgo = outtrigger;
+}
+
+void timer_enable(uint32_t timer_periph)
+{
+    (void)timer_periph;
+    adc_model.timer_enabled = 1U;
+}
+
+void timer_disable(uint32_t timer_periph)
+{
+    (void)timer_periph;
+    adc_model.timer_enabled = 0U;
+}
+
+void adc_enable(void)
+{
+    adc_model.enabled = 1U;
+}
+
+void adc_disable(void)
+{
+    adc_model.enabled = 0U;
+}
+
+void adc_special_function_config(uint32_t function, ControlStatus newvalue)
+{
+    if(0U != adc_model.enabled) {
+        adc_model.enabled_configs++;
+    }
+    if(ADC_SCAN_MODE == function) {
+        adc_model.scan_mode = (ENABLE == newvalue) ? 1U : 0U;
+    } else if(ADC_CONTINUOUS_MODE == function) {
+        adc_model.continuous_mode = (ENABLE == newvalue) ? 1U : 0U;
+    }
+}
+
+void adc_data_alignment_config(uint32_t data_alignment)
+{
+    (void)data_alignment;
+}
+
+void adc_channel_length_config(uint8_t adc_sequence, uint32_t length)
+{
+    (void)adc_sequence;
+    if(0U != adc_model.enabled) {
+        adc_model.enabled_configs++;
+    }
+    adc_model.length = length;
+}
+
+void adc_routine_channel_config(uint8_t rank, uint8_t adc_channel, uint32_t sample_time)
+{
+    (void)sample_time;
+    if(0U != adc_model.enabled) {
+        adc_model.enabled_configs++;
+    }
+    if(rank < ADC_MODEL_RANK_NUM) {
+        adc_model.channel[rank] = adc_channel;
+    }
+}
+
+void adc_external_trigger_source_config(uint8_t adc_sequence, uint32_t external_trigger_source)
+{
+    (void)adc_sequence;
+    adc_model.trigger_source = external_trigger_source;
+}
+
+void adc_external_trigger_config(uint8_t adc_sequence, ControlStatus newvalue)
+{
+    (void)adc_sequence;
+    adc_model.trigger_enabled = (ENABLE == newvalue) ? 1U : 0U;
+}
+
+void adc_oversample_mode_config(uint32_t mode, uint16_t shift, uint8_t ratio)
+{
+    (void)mode;
+    if(0U != adc_model.enabled) {
+        adc_model.enabled_configs++;
+    }
+    adc_model.oversample_shift = ((uint32_t)shift & ADC_OVSAMPCTL_OVSS) >> 5;
+    adc_model.oversample_ratio = 2UL << (((uint32_t)ratio & ADC_OVSAMPCTL_OVSR) >> 2);
+}
+
+void adc_oversample_mode_enable(void)
+{
+    if(0U != adc_model.enabled) {
+        adc_model.enabled_configs++;
+    }
+    adc_model.oversample_enabled = 1U;
+}
+
+void adc_dma_mode_enable(void)
+{
+    adc_model.dma_mode = 1U;
+}
+
+void adc_watchdog0_single_channel_enable(uint8_t adc_channel)
+{
+    adc_model.wd_channels[0] = 1UL << adc_channel;
+}
+
+void adc_watchdog1_channel_config(uint32_t selection_channel, ControlStatus newvalue)
+{
+    if(ENABLE == newvalue) {
+        adc_model.wd_channels[1] |= selection_channel;
+    } else {
+        adc_model.wd_channels[1] &= ~selection_channel;
+    }
+}
+
+void adc_watchdog2_channel_config(uint32_t selection_channel, ControlStatus newvalue)
+{
+    if(ENABLE == newvalue) {
+        adc_model.wd_channels[2] |= selection_channel;
+    } else {
+        adc_model.wd_channels[2] &= ~selection_channel;
+    }
+}
+
+void adc_watchdog0_threshold_config(uint32_t low_threshold, uint32_t high_threshold)
+{
+    adc_model.wd_low[0] = low_threshold;
+    adc_model.wd_high[0] = high_threshold;
+}
+
+void adc_watchdog1_threshold_config(uint32_t low_threshold, uint32_t high_threshold)
+{
+    adc_model.wd_low[1] = low_threshold;
+    adc_model.wd_high[1] = high_threshold;
+}
+
+void adc_watchdog2_threshold_config(uint32_t low_threshold, uint32_t high_threshold)
+{
+    adc_model.wd_low[2] = low_threshold;
+    adc_model.wd_high[2] = high_threshold;
+}
+
+void adc_interrupt_enable(uint32_t interrupt)
+{
+    adc_model.interrupts |= interrupt;
+}
+
+FlagStatus adc_interrupt_flag_get(uint32_t int_flag)
+{
+    return (0U != (adc_model.flags & int_flag)) ? SET : RESET;
+}
+
+void adc_interrupt_flag_clear(uint32_t int_flag)
+{
+    adc_model.flags &= ~int_flag;
+}
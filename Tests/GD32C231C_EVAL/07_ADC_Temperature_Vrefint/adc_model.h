@@ -0,0 +1,109 @@
+/*!
+    \file    adc_model.h
+    \brief   ADC routine sequence triggered by TIMER2, analog watchdogs and circular DMA channel
+             model behind the functions used by adc_scan.c and adc_monitor.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef ADC_MODEL_H
+#define ADC_MODEL_H
+
+#include "gd32c2x1.h"
+
+#define ADC_MODEL_RANK_NUM          16U
+#define ADC_MODEL_CHANNEL_NUM       32U
+#define ADC_MODEL_WATCHDOG_NUM      3U
+
+/* a conversion of a channel, conversion counts the conversions of the channel */
+typedef uint16_t (*adc_model_input)(uint8_t channel, uint32_t conversion);
+
+typedef struct {
+    adc_model_input input;
+    /* ADC */
+    uint8_t enabled;
+    uint8_t scan_mode;
+    uint8_t continuous_mode;
+    uint8_t dma_mode;
+    uint8_t trigger_enabled;
+    uint32_t trigger_source;
+    uint32_t length;
+    uint8_t channel[ADC_MODEL_RANK_NUM];
+    uint8_t oversample_enabled;
+    uint32_t oversample_shift;          /* bits */
+    uint32_t oversample_ratio;          /* conversions */
+    uint32_t enabled_configs;           /* sequence or oversampling changed while the ADC is on */
+    uint32_t conversions;
+    /* analog watchdogs, a result of a watched channel outside [low, high] sets the flag */
+    uint32_t wd_low[ADC_MODEL_WATCHDOG_NUM];
+    uint32_t wd_high[ADC_MODEL_WATCHDOG_NUM];
+    uint32_t wd_channels[ADC_MODEL_WATCHDOG_NUM];   /* bit n watches channel n */
+    uint32_t interrupts;                /* enabled ADC interrupts */
+    uint32_t flags;                     /* ADC interrupt flags */
+    uint8_t irq_enabled;                /* ADC_IRQn enabled in the NVIC */
+    void (*adc_irq)(void);              /* ADC interrupt handler */
+    uint32_t adc_irqs;
+    /* TIMER2 */
+    uint8_t timer_enabled;
+    uint32_t timer_prescaler;
+    uint32_t timer_period;
+    uint32_t timer_trgo;
+    /* DMA channel */
+    uint8_t dmamux_clock;
+    uint8_t dma_routed;                 /* the DMAMUX got the request of dma_init() */
+    uint32_t dma_request;
+    uint32_t dma_memory;
+    uint32_t dma_number;
+    uint32_t dma_memory_width;
+    uint32_t dma_periph_width;
+    uint32_t dma_periph_addr;
+    uint32_t dma_position;              /* half words written of the current round */
+    uint32_t dma_interrupts;
+    uint32_t dma_flags;
+    uint8_t dma_circular;
+    uint8_t dma_enabled;
+    /* interrupts */
+    uint32_t irq_latency;               /* scans between a DMA flag and its interrupt */
+    uint32_t dma_irqs;
+    uint32_t both_flags;                /* interrupts which found both halves ended */
+    uint32_t missed_flags;              /* a DMA flag was raised again before it was cleared */
+    uint32_t halves;                    /* halves written by the DMA */
+    uint32_t scans;                     /* scans triggered */
+    uint32_t lost;                      /* results not moved by the DMA */
+} adc_model_struct;
+
+extern adc_model_struct adc_model;
+
+/* clear the model, the DMA interrupts are served after latency scans */
+void adc_model_init(adc_model_input input, uint32_t latency);
+/* run number TIMER2 update events, each of them converts the sequence once */
+void adc_model_run(uint32_t number);
+
+#endif /* ADC_MODEL_H */
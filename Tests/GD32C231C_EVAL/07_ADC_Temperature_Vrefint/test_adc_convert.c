@@ -0,0 +1,211 @@
+/*!
+    \file    test_adc_convert.c
+    \brief   error bounds of the fixed point conversions of adc_convert.c against a double reference
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "adc_convert.c"
+
+#define COUNTOF(a)          (sizeof(a) / sizeof(*(a)))
+
+static const uint32_t vdda[] = {1800U, 2500U, 3000U, 3300U, 3600U, 5000U};
+
+/* VDDA from VREFINT, rounded to the closest millivolt and limited to 5V */
+static void test_vdda(void)
+{
+    double reference, error, worst = 0.0;
+    uint32_t raw, value;
+
+    HOST_CHECK_EQ(adc_convert_vdda_mv(0U), ADC_CONVERT_VDDA_MV);
+    for(raw = 1U; raw <= ADC_CONVERT_FULL_SCALE; raw++) {
+        value = adc_convert_vdda_mv((uint16_t)raw);
+        reference = (double)ADC_CONVERT_VREFINT_MV * ADC_CONVERT_FULL_SCALE / raw;
+        if(reference > ADC_CONVERT_VDDA_MAX_MV) {
+            HOST_CHECK_EQ(value, ADC_CONVERT_VDDA_MAX_MV);
+            continue;
+        }
+        error = fabs((double)value - reference);
+        worst = (error > worst) ? error : worst;
+    }
+    HOST_CHECK(worst <= 0.5);
+    /* the typical VREFINT at 3.3V */
+    HOST_CHECK_EQ(adc_convert_vdda_mv(1489U), 3300U);
+}
+
+/* millivolts of every code at each VDDA */
+static void test_millivolt(void)
+{
+    double reference, error, worst = 0.0;
+    uint32_t raw, i;
+
+    for(i = 0U; i < COUNTOF(vdda); i++) {
+        HOST_CHECK_EQ(adc_convert_millivolt(0U, vdda[i]), 0U);
+        HOST_CHECK_EQ(adc_convert_millivolt(ADC_CONVERT_FULL_SCALE, vdda[i]), vdda[i]);
+        for(raw = 0U; raw <= ADC_CONVERT_FULL_SCALE; raw++) {
+            reference = (double)raw * vdda[i] / ADC_CONVERT_FULL_SCALE;
+            error = fabs((double)adc_convert_millivolt((uint16_t)raw, vdda[i]) - reference);
+            worst = (error > worst) ? error : worst;
+        }
+    }
+    HOST_CHECK(worst <= 0.5);
+}
+
+/* millidegrees of every code at each VDDA, the microvolt rounding adds 0.5uV / 2.52uV per mdeg */
+static void test_temperature(void)
+{
+    double reference, error, worst = 0.0, worst_float = 0.0;
+    uint32_t raw, i;
+    int32_t value;
+    float old;
+
+    for(i = 0U; i < COUNTOF(vdda); i++) {
+        for(raw = 0U; raw <= ADC_CONVERT_FULL_SCALE; raw++) {
+            value = adc_convert_temperature_mdeg((uint16_t)raw, vdda[i]);
+            reference = 25000.0 + ((0.924 - ((double)raw * vdda[i] / 1000.0 / ADC_CONVERT_FULL_SCALE)) * 1000000.0 / 2.52);
+            error = fabs((double)value - reference);
+            worst = (error > worst) ? error : worst;
+            if(3300U == vdda[i]) {
+                /* the float expression it replaced */
+                old = ((0.924f - ((float)raw * 3.3f / 4095.0f)) * 1000.0f / 2.52f) + 25.0f;
+                error = fabs((double)value - ((double)old * 1000.0));
+                worst_float = (error > worst_float) ? error : worst_float;
+            }
+        }
+    }
+    HOST_CHECK(worst <= 0.5 + (0.5 / 2.52));
+    HOST_CHECK(worst_float <= 1.0);
+    /* V25 is 25 degrees */
+    HOST_CHECK_EQ(adc_convert_temperature_mdeg(1260U, 3003U), 25000);
+}
+
+/* the watchdog thresholds of the temperature at the nominal VDDA, truncated */
+static void test_temperature_raw(void)
+{
+    double reference;
+    long t;
+    uint16_t raw;
+
+    for(t = -40L; t <= 125L; t++) {
+        raw = ADC_CONVERT_TEMPERATURE_RAW(t);
+        reference = (0.924 - ((t - 25L) * 0.00252)) * ADC_CONVERT_FULL_SCALE / 3.3;
+        HOST_CHECK(fabs((double)raw - reference) < 1.0);
+        /* the raw value converts back within a code */
+        HOST_CHECK(labs((long)adc_convert_temperature_mdeg(raw, ADC_CONVERT_VDDA_MV) - (t * 1000L)) <= 400L);
+    }
+}
+
+/* text of a value in thousandths, half away from zero */
+static void reference_format(char *buffer, size_t size, int32_t milli, uint8_t decimals)
+{
+    static const long long power[4] = {1, 10, 100, 1000};
+    long long value, scale;
+
+    if(decimals > 3U) {
+        decimals = 3U;
+    }
+    scale = power[3U - decimals];
+    /* halves of integer quotients are exact in double */
+    value = llround((double)milli / (double)scale);
+    if(0U == decimals) {
+        snprintf(buffer, size, "%s%lld", (value < 0) ? "-" : "", llabs(value));
+    } else {
+        snprintf(buffer, size, "%s%lld.%0*lld", (value < 0) ? "-" : "", llabs(value) / power[decimals],
+                 (int)decimals, llabs(value) % power[decimals]);
+    }
+}
+
+static void check_format(int32_t milli, uint8_t decimals)
+{
+    char text[ADC_CONVERT_FORMAT_SIZE + 4U];
+    char reference[32];
+    uint8_t length;
+
+    memset(text, 'x', sizeof(text));
+    length = adc_convert_format(text, milli, decimals);
+    reference_format(reference, sizeof(reference), milli, decimals);
+    HOST_CHECK(0 == strcmp(text, reference));
+    HOST_CHECK_EQ(length, strlen(reference));
+    HOST_CHECK(length < ADC_CONVERT_FORMAT_SIZE);
+    if(0 != strcmp(text, reference)) {
+        printf("%ld with %u decimals: %s, expected %s\n", (long)milli, decimals, text, reference);
+    }
+}
+
+static void test_format(void)
+{
+    static const int32_t edge[] = {0, 1, -1, 4, -4, 5, -5, 49, -49, 50, -50, 499, -499, 500, -500,
+                                   999, -999, 1000, -1000, 9995, -9995, 25000, -40000,
+                                   INT32_MAX, INT32_MIN, INT32_MIN + 1};
+    char text[ADC_CONVERT_FORMAT_SIZE];
+    uint32_t k;
+    uint8_t decimals;
+    int32_t milli;
+
+    for(k = 0U; k < COUNTOF(edge); k++) {
+        for(decimals = 0U; decimals <= 3U; decimals++) {
+            check_format(edge[k], decimals);
+        }
+    }
+    srand(22U);
+    for(k = 0U; k < 2000000U; k++) {
+        milli = (int32_t)(((uint32_t)rand() << 16) ^ (uint32_t)rand());
+        if(0U != (k & 1U)) {
+            milli %= 100000;
+        }
+        check_format(milli, (uint8_t)(k % 4U));
+    }
+
+    /* more decimals print 3 */
+    HOST_CHECK_EQ(adc_convert_format(text, -1234, 4U), 6U);
+    HOST_CHECK(0 == strcmp(text, "-1.234"));
+    HOST_CHECK_EQ(adc_convert_format(text, -1234, 7U), 6U);
+    HOST_CHECK(0 == strcmp(text, "-1.234"));
+    HOST_CHECK_EQ(adc_convert_format(text, 25499, 0U), 2U);
+    HOST_CHECK(0 == strcmp(text, "25"));
+}
+
+int main(void)
+{
+    test_vdda();
+    test_millivolt();
+    test_temperature();
+    test_temperature_raw();
+    test_format();
+
+    return host_test_result("adc_convert");
+}
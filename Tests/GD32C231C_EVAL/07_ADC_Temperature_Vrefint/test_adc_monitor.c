@@ -0,0 +1,357 @@
+/*!
+    \file    test_adc_monitor.c
+    \brief   host test of the ADC monitor: watchdog windows, hysteresis and interrupts on the
+             scanned signals
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "adc_model.h"
+#include "adc_scan.c"
+#include "adc_monitor.c"
+
+#define TEST_EVENT_NUM      4096U
+
+typedef struct {
+    uint8_t signal;
+    adc_monitor_state_enum state;
+    uint16_t value;
+} test_event_struct;
+
+static const uint8_t channel[ADC_SCAN_CHANNEL_NUM] = {ADC_CHANNEL_13, ADC_CHANNEL_14};
+/* signal 1 and 2 watch the same channel with other limits */
+static const adc_monitor_signal_struct signals[ADC_MONITOR_SIGNAL_NUM] = {
+    {"temperature", ADC_CHANNEL_13, {1000U, 3000U, 50U}},
+    {"vrefint",     ADC_CHANNEL_14, {1400U, 1600U, 20U}},
+    {"vrefint wide", ADC_CHANNEL_14, {100U, 4000U, 400U}}
+};
+/* the level of each scanned channel */
+static uint16_t level[ADC_SCAN_CHANNEL_NUM];
+static test_event_struct event[TEST_EVENT_NUM];
+static uint32_t events;
+static adc_monitor_state_enum ref_state[ADC_MONITOR_SIGNAL_NUM];
+static adc_monitor_limit_struct ref_limit[ADC_MONITOR_SIGNAL_NUM];
+static uint32_t ref_changes;
+/* conversions which changed a state, each one interrupts once */
+static uint32_t ref_irqs;
+
+static uint16_t input_level(uint8_t ch, uint32_t conversion)
+{
+    (void)conversion;
+    return level[(ADC_CHANNEL_13 == ch) ? 0U : 1U];
+}
+
+static uint16_t monitor_value(uint8_t ch)
+{
+    return adc_scan_latest_get((ADC_CHANNEL_13 == ch) ? 0U : 1U);
+}
+
+static void monitor_event(uint8_t signal, adc_monitor_state_enum state, uint16_t value)
+{
+    if(events < TEST_EVENT_NUM) {
+        event[events].signal = signal;
+        event[events].state = state;
+        event[events].value = value;
+    }
+    events++;
+}
+
+/* the states written from the limits and the hysteresis */
+static adc_monitor_state_enum reference_next(const adc_monitor_limit_struct *limit, adc_monitor_state_enum state, uint16_t value)
+{
+    switch(state) {
+    case ADC_MONITOR_LOW:
+        if(value <= (limit->low + limit->hysteresis)) {
+            return ADC_MONITOR_LOW;
+        }
+        break;
+    case ADC_MONITOR_HIGH:
+        if((int32_t)value >= ((int32_t)limit->high - (int32_t)limit->hysteresis)) {
+            return ADC_MONITOR_HIGH;
+        }
+        break;
+    default:
+        break;
+    }
+    if(value > limit->high) {
+        return ADC_MONITOR_HIGH;
+    } else if(value < limit->low) {
+        return ADC_MONITOR_LOW;
+    }
+    return ADC_MONITOR_NORMAL;
+}
+
+/* one scan at the given levels, the reference follows the signals */
+static void scan(uint16_t level0, uint16_t level1)
+{
+    uint16_t value;
+    adc_monitor_state_enum state;
+    uint8_t changed[ADC_SCAN_CHANNEL_NUM] = {0U, 0U};
+    uint8_t i;
+
+    level[0] = level0;
+    level[1] = level1;
+    adc_model_run(1U);
+    for(i = 0U; i < ADC_MONITOR_SIGNAL_NUM; i++) {
+        value = (0U == i) ? level0 : level1;
+        state = reference_next(&ref_limit[i], ref_state[i], value);
+        if(state != ref_state[i]) {
+            ref_state[i] = state;
+            ref_changes++;
+            changed[(0U == i) ? 0U : 1U] = 1U;
+        }
+        HOST_CHECK_EQ(adc_monitor_state_get(i), ref_state[i]);
+    }
+    ref_irqs += (uint32_t)changed[0] + changed[1];
+}
+
+static void monitor_setup(void)
+{
+    uint8_t i;
+
+    adc_model_init(input_level, 0U);
+    adc_model.adc_irq = adc_monitor_irq_handler;
+    adc_scan_init(channel, NULL);
+    HOST_CHECK_EQ(adc_monitor_init(signals, ADC_MONITOR_SIGNAL_NUM, monitor_value, monitor_event), SUCCESS);
+    adc_scan_start();
+    events = 0U;
+    ref_changes = 0U;
+    ref_irqs = 0U;
+    for(i = 0U; i < ADC_MONITOR_SIGNAL_NUM; i++) {
+        ref_state[i] = ADC_MONITOR_NORMAL;
+        ref_limit[i] = signals[i].limit;
+    }
+}
+
+/* the parameters are checked and each watchdog gets its channel and window */
+static void test_init(void)
+{
+    adc_monitor_signal_struct wrong[1] = {{"wrong", ADC_CHANNEL_13, {10U, 20U, 0U}}};
+    adc_monitor_limit_struct limit = {30U, 20U, 0U};
+
+    adc_model_init(input_level, 0U);
+    HOST_CHECK_EQ(adc_monitor_init(signals, 0U, monitor_value, NULL), ERROR);
+    HOST_CHECK_EQ(adc_monitor_init(signals, ADC_MONITOR_SIGNAL_NUM + 1U, monitor_value, NULL), ERROR);
+    HOST_CHECK_EQ(adc_monitor_init(signals, 1U, NULL, NULL), ERROR);
+    wrong[0].channel = ADC_CHANNEL_15 + 1U;
+    HOST_CHECK_EQ(adc_monitor_init(wrong, 1U, monitor_value, NULL), ERROR);
+    wrong[0].channel = ADC_CHANNEL_13;
+    wrong[0].limit.low = 21U;
+    HOST_CHECK_EQ(adc_monitor_init(wrong, 1U, monitor_value, NULL), ERROR);
+    wrong[0].limit.low = 10U;
+    wrong[0].limit.high = ADC_MONITOR_VALUE_MAX + 1U;
+    HOST_CHECK_EQ(adc_monitor_init(wrong, 1U, monitor_value, NULL), ERROR);
+    HOST_CHECK_EQ(adc_model.interrupts, 0);
+
+    monitor_setup();
+    HOST_CHECK_EQ(adc_model.wd_channels[0], 1UL << ADC_CHANNEL_13);
+    HOST_CHECK_EQ(adc_model.wd_channels[1], 1UL << ADC_CHANNEL_14);
+    HOST_CHECK_EQ(adc_model.wd_channels[2], 1UL << ADC_CHANNEL_14);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 1000U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], 3000U);
+    HOST_CHECK_EQ(adc_model.wd_low[1], 1400U);
+    HOST_CHECK_EQ(adc_model.wd_high[1], 1600U);
+    HOST_CHECK_EQ(adc_model.wd_low[2], 100U);
+    HOST_CHECK_EQ(adc_model.wd_high[2], 4000U);
+    HOST_CHECK_EQ(adc_model.interrupts, ADC_INT_WD0E | ADC_INT_WD1E | ADC_INT_WD2E);
+    HOST_CHECK_EQ(adc_model.irq_enabled, 1);
+    HOST_CHECK(0 == strcmp(adc_monitor_name_get(2U), "vrefint wide"));
+    HOST_CHECK(NULL == adc_monitor_name_get(ADC_MONITOR_SIGNAL_NUM));
+    HOST_CHECK_EQ(adc_monitor_limit_set(0U, &limit), ERROR);
+    HOST_CHECK_EQ(adc_monitor_limit_set(ADC_MONITOR_SIGNAL_NUM, &signals[0].limit), ERROR);
+}
+
+/* the states follow the limits with hysteresis, the interrupt only comes on a change */
+static void test_thresholds(void)
+{
+    uint32_t k;
+    uint16_t value;
+
+    monitor_setup();
+
+    /* inside the limits, no interrupt */
+    for(k = 0U; k < 100U; k++) {
+        scan((uint16_t)(1000U + (k * 20U)), 1500U);
+    }
+    HOST_CHECK_EQ(adc_model.adc_irqs, 0);
+
+    /* a crossing, then noise around the limit inside the hysteresis: one event */
+    scan(3001U, 1500U);
+    HOST_CHECK_EQ(events, 1);
+    HOST_CHECK_EQ(event[0].signal, 0);
+    HOST_CHECK_EQ(event[0].state, ADC_MONITOR_HIGH);
+    HOST_CHECK_EQ(event[0].value, 3001U);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 3000U - 50U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], ADC_MONITOR_VALUE_MAX);
+    for(k = 0U; k < 200U; k++) {
+        scan((uint16_t)(2950U + (k % 101U)), 1500U);
+    }
+    HOST_CHECK_EQ(events, 1);
+    /* back below the hysteresis */
+    scan(2949U, 1500U);
+    HOST_CHECK_EQ(events, 2);
+    HOST_CHECK_EQ(event[1].state, ADC_MONITOR_NORMAL);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 1000U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], 3000U);
+
+    /* a step from low to high without normal in between */
+    scan(999U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 0U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], 1050U);
+    scan(4095U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_HIGH);
+
+    /* the two watchdogs of the same channel */
+    scan(2000U, 50U);
+    HOST_CHECK_EQ(adc_monitor_state_get(1U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(adc_monitor_state_get(2U), ADC_MONITOR_LOW);
+    scan(2000U, 450U);
+    HOST_CHECK_EQ(adc_monitor_state_get(1U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(adc_monitor_state_get(2U), ADC_MONITOR_LOW);
+    scan(2000U, 501U);
+    HOST_CHECK_EQ(adc_monitor_state_get(1U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(adc_monitor_state_get(2U), ADC_MONITOR_NORMAL);
+    scan(2000U, 1421U);
+    HOST_CHECK_EQ(adc_monitor_state_get(1U), ADC_MONITOR_NORMAL);
+    HOST_CHECK_EQ(adc_monitor_state_get(2U), ADC_MONITOR_NORMAL);
+
+    /* random walks, one interrupt per state change */
+    srand(21U);
+    value = 2000U;
+    for(k = 0U; k < 20000U; k++) {
+        value = (uint16_t)((value + 4096U + ((uint32_t)rand() % 301U) - 150U) % 4096U);
+        scan(value, (uint16_t)(1500U + ((uint32_t)rand() % 261U) - 130U));
+    }
+    HOST_CHECK_EQ(events, ref_changes);
+    HOST_CHECK_EQ(adc_model.adc_irqs, ref_irqs);
+    HOST_CHECK_EQ(adc_model.flags, 0);
+}
+
+/* new limits apply to the current state, the interrupt is masked while they are written */
+static void test_limit_set(void)
+{
+    adc_monitor_limit_struct limit = {500U, 2500U, 100U};
+
+    monitor_setup();
+    scan(3500U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_HIGH);
+
+    HOST_CHECK_EQ(adc_monitor_limit_set(0U, &limit), SUCCESS);
+    ref_limit[0] = limit;
+    HOST_CHECK_EQ(adc_model.irq_enabled, 1);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 2400U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], ADC_MONITOR_VALUE_MAX);
+    scan(2450U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_HIGH);
+    scan(2399U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_NORMAL);
+
+    /* a hysteresis larger than the range is clamped to the scale */
+    limit.low = 10U;
+    limit.high = 4090U;
+    limit.hysteresis = 4095U;
+    HOST_CHECK_EQ(adc_monitor_limit_set(0U, &limit), SUCCESS);
+    ref_limit[0] = limit;
+    scan(5U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(adc_model.wd_low[0], 0U);
+    HOST_CHECK_EQ(adc_model.wd_high[0], ADC_MONITOR_VALUE_MAX);
+    scan(4095U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_LOW);
+    HOST_CHECK_EQ(events, ref_changes);
+    HOST_CHECK_EQ(adc_model.adc_irqs, ref_irqs);
+
+    /* a flag left from the old window interrupts once the new one is set, without a change */
+    limit.low = 1000U;
+    limit.high = 3000U;
+    limit.hysteresis = 50U;
+    HOST_CHECK_EQ(adc_monitor_limit_set(0U, &limit), SUCCESS);
+    ref_limit[0] = limit;
+    scan(2000U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_NORMAL);
+    nvic_irq_disable(ADC_IRQn);
+    level[0] = 3100U;
+    adc_model_run(1U);
+    HOST_CHECK_EQ(adc_model.flags, ADC_INT_FLAG_WD0E);
+    limit.high = 3500U;
+    HOST_CHECK_EQ(adc_monitor_limit_set(0U, &limit), SUCCESS);
+    ref_limit[0] = limit;
+    events = 0U;
+    scan(3100U, 1500U);
+    HOST_CHECK_EQ(adc_monitor_state_get(0U), ADC_MONITOR_NORMAL);
+    HOST_CHECK_EQ(events, 0);
+    HOST_CHECK_EQ(adc_model.flags, 0);
+}
+
+/* the windows at the edges of the scale and the states at the edges of the windows */
+static void test_window(void)
+{
+    adc_monitor_limit_struct limit = {100U, 200U, 300U};
+    uint16_t low, high;
+    uint32_t value;
+    uint8_t state;
+
+    adc_monitor_window_get(&limit, ADC_MONITOR_HIGH, &low, &high);
+    HOST_CHECK_EQ(low, 0U);
+    HOST_CHECK_EQ(high, ADC_MONITOR_VALUE_MAX);
+    limit.low = 3900U;
+    limit.high = 4000U;
+    adc_monitor_window_get(&limit, ADC_MONITOR_LOW, &low, &high);
+    HOST_CHECK_EQ(low, 0U);
+    HOST_CHECK_EQ(high, ADC_MONITOR_VALUE_MAX);
+    adc_monitor_window_get(&limit, ADC_MONITOR_NORMAL, &low, &high);
+    HOST_CHECK_EQ(low, 3900U);
+    HOST_CHECK_EQ(high, 4000U);
+
+    limit.low = 1000U;
+    limit.high = 3000U;
+    limit.hysteresis = 50U;
+    for(state = ADC_MONITOR_NORMAL; state <= ADC_MONITOR_HIGH; state++) {
+        for(value = 0U; value <= ADC_MONITOR_VALUE_MAX; value++) {
+            HOST_CHECK_EQ(adc_monitor_state_next(&limit, (adc_monitor_state_enum)state, (uint16_t)value),
+                          reference_next(&limit, (adc_monitor_state_enum)state, (uint16_t)value));
+        }
+    }
+}
+
+int main(void)
+{
+    test_init();
+    test_thresholds();
+    test_limit_set();
+    test_window();
+
+    return host_test_result("adc_monitor");
+}
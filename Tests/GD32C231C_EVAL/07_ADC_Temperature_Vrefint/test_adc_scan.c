@@ -0,0 +1,260 @@
+/*!
+    \file    test_adc_scan.c
+    \brief   host test of the ADC scan: configuration, double buffer hand over, overruns,
+             latest value and oversampling scale
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "adc_model.h"
+#include "adc_scan.c"
+
+#define TEST_HALF_FRAMES    ADC_SCAN_FRAME_NUM
+#define TEST_VALUE_MASK     0x0FFFU
+
+static const uint8_t channel[ADC_SCAN_CHANNEL_NUM] = {ADC_CHANNEL_13, ADC_CHANNEL_14};
+static uint16_t constant = 0U;
+static uint32_t callbacks;
+static uint32_t skipped;
+static uint32_t last_first;
+static uint32_t callback_errors;
+
+/* rank 0 gives the scan number, rank 1 a noisy signal */
+static uint16_t input_scan(uint8_t ch, uint32_t conversion)
+{
+    uint32_t scan = conversion >> ADC_SCAN_OVERSAMPLE_BITS;
+
+    if(ADC_CHANNEL_13 == ch) {
+        return (uint16_t)(scan & TEST_VALUE_MASK);
+    }
+    return (uint16_t)(2000U + ((conversion * 7U + scan) % 16U));
+}
+
+/* the result of rank 1 for a scan, the mean of its conversions rounded down */
+static uint16_t noisy_result(uint32_t scan)
+{
+    uint32_t sum = 0U;
+    uint32_t i;
+
+    for(i = 0U; i < (1UL << ADC_SCAN_OVERSAMPLE_BITS); i++) {
+        sum += input_scan(ADC_CHANNEL_14, (scan << ADC_SCAN_OVERSAMPLE_BITS) + i);
+    }
+    return (uint16_t)(sum >> ADC_SCAN_OVERSAMPLE_BITS);
+}
+
+static uint16_t input_constant(uint8_t ch, uint32_t conversion)
+{
+    (void)ch;
+    (void)conversion;
+    return constant;
+}
+
+/* a half holds consecutive scans and follows the previous half or the one after it */
+static void scan_callback_check(const uint16_t *data, uint32_t frame_number)
+{
+    uint32_t position = adc_model.dma_position;
+    uint32_t first = data[0];
+    uint32_t i, step;
+
+    callbacks++;
+    if(((data != &scan_buffer[0]) && (data != &scan_buffer[ADC_SCAN_HALF_SIZE])) || (TEST_HALF_FRAMES != frame_number)) {
+        callback_errors++;
+        return;
+    }
+    /* the DMA is not writing this half */
+    if((position >= (uint32_t)(data - scan_buffer)) && (position < ((uint32_t)(data - scan_buffer) + ADC_SCAN_HALF_SIZE))) {
+        callback_errors++;
+    }
+    for(i = 0U; i < frame_number; i++) {
+        if((data[i * ADC_SCAN_CHANNEL_NUM] != ((first + i) & TEST_VALUE_MASK)) ||
+                (data[i * ADC_SCAN_CHANNEL_NUM + 1U] != noisy_result(first + i))) {
+            callback_errors++;
+        }
+    }
+    step = (first - last_first) & TEST_VALUE_MASK;
+    if(step == (2U * TEST_HALF_FRAMES)) {
+        skipped++;
+    } else if(step != TEST_HALF_FRAMES) {
+        callback_errors++;
+    }
+    last_first = first;
+}
+
+static void scan_setup(adc_model_input input, uint32_t latency)
+{
+    adc_model_init(input, latency);
+    callbacks = 0U;
+    skipped = 0U;
+    callback_errors = 0U;
+    /* the half before the first one */
+    last_first = (0U - TEST_HALF_FRAMES) & TEST_VALUE_MASK;
+    adc_scan_init(channel, scan_callback_check);
+}
+
+/* the sequence, the trigger and the DMA set by adc_scan_init() */
+static void test_config(void)
+{
+    scan_setup(input_scan, 0U);
+
+    /* the DMAMUX gets the ADC request even if no other driver has clocked it */
+    HOST_CHECK_EQ(adc_model.dmamux_clock, 1);
+    HOST_CHECK_EQ(adc_model.dma_routed, 1);
+    HOST_CHECK_EQ(adc_model.dma_request, DMA_REQUEST_ADC);
+    HOST_CHECK_EQ(adc_model.dma_number, 2U * ADC_SCAN_HALF_SIZE);
+    HOST_CHECK_EQ(adc_model.dma_memory_width, DMA_MEMORY_WIDTH_16BIT);
+    HOST_CHECK_EQ(adc_model.dma_periph_width, DMA_PERIPHERAL_WIDTH_16BIT);
+    HOST_CHECK_EQ(adc_model.dma_periph_addr, (uint32_t)(uintptr_t)&ADC_RDATA);
+    HOST_CHECK_EQ(adc_model.dma_circular, 1);
+    HOST_CHECK_EQ(adc_model.dma_interrupts, DMA_INT_HTF | DMA_INT_FTF);
+
+    HOST_CHECK_EQ(adc_model.scan_mode, 1);
+    HOST_CHECK_EQ(adc_model.continuous_mode, 0);
+    HOST_CHECK_EQ(adc_model.length, ADC_SCAN_CHANNEL_NUM);
+    HOST_CHECK_EQ(adc_model.channel[0], ADC_CHANNEL_13);
+    HOST_CHECK_EQ(adc_model.channel[1], ADC_CHANNEL_14);
+    HOST_CHECK_EQ(adc_model.enabled_configs, 0);
+    HOST_CHECK_EQ(adc_model.enabled, 1);
+
+    /* TIMER2 ticks at 1MHz and triggers at ADC_SCAN_RATE_HZ */
+    HOST_CHECK_EQ((SystemCoreClock / (adc_model.timer_prescaler + 1U)), 1000000U);
+    HOST_CHECK_EQ((1000000U / (adc_model.timer_period + 1U)), ADC_SCAN_RATE_HZ);
+
+    /* the sum of the conversions shifted back to 12 bits */
+    HOST_CHECK_EQ(adc_model.oversample_enabled, 1);
+    HOST_CHECK_EQ(adc_model.oversample_ratio, 1UL << ADC_SCAN_OVERSAMPLE_BITS);
+    HOST_CHECK_EQ(adc_model.oversample_shift, ADC_SCAN_OVERSAMPLE_BITS);
+
+    /* nothing is converted before the start and after the stop */
+    adc_model_run(10U);
+    HOST_CHECK_EQ(adc_model.scans, 0);
+    adc_scan_start();
+    adc_model_run(10U);
+    adc_scan_stop();
+    adc_model_run(10U);
+    HOST_CHECK_EQ(adc_model.scans, 10);
+    HOST_CHECK_EQ(adc_model.lost, 0);
+}
+
+/* the halves reach the callback in order, late interrupts lose whole halves and count them */
+static void test_halves(void)
+{
+    static const uint32_t latency[] = {0U, 3U, TEST_HALF_FRAMES - 1U, TEST_HALF_FRAMES + 8U};
+    const uint32_t scans = 100U * TEST_HALF_FRAMES + 5U;
+    uint32_t k, pending;
+
+    for(k = 0U; k < sizeof(latency) / sizeof(latency[0]); k++) {
+        scan_setup(input_scan, latency[k]);
+        adc_scan_start();
+        adc_model_run(scans);
+
+        HOST_CHECK_EQ(callback_errors, 0);
+        HOST_CHECK_EQ(adc_model.lost, 0);
+        HOST_CHECK_EQ(adc_model.missed_flags, 0);
+        HOST_CHECK_EQ(adc_scan_overrun_get(), adc_model.both_flags);
+        HOST_CHECK_EQ(skipped, adc_scan_overrun_get());
+        /* every half ended is given to the callback, counted as an overrun or still pending */
+        pending = ((0U != (adc_model.dma_flags & DMA_INT_FLAG_HTF)) ? 1U : 0U) +
+                  ((0U != (adc_model.dma_flags & DMA_INT_FLAG_FTF)) ? 1U : 0U);
+        HOST_CHECK_EQ(callbacks + adc_scan_overrun_get() + pending, adc_model.halves);
+        if(latency[k] < TEST_HALF_FRAMES) {
+            HOST_CHECK_EQ(adc_scan_overrun_get(), 0);
+        } else {
+            HOST_CHECK(adc_scan_overrun_get() > 0U);
+        }
+    }
+}
+
+/* the last result of each rank behind the DMA position, also across the end of the buffer */
+static void test_latest(void)
+{
+    uint32_t scan;
+
+    scan_setup(input_scan, 0U);
+    adc_scan_start();
+    for(scan = 0U; scan < (3U * ADC_SCAN_FRAME_NUM * 2U); scan++) {
+        adc_model_run(1U);
+        HOST_CHECK_EQ(adc_scan_latest_get(0U), scan & TEST_VALUE_MASK);
+        HOST_CHECK_EQ(adc_scan_latest_get(1U), noisy_result(scan));
+    }
+
+    /* read between the ranks of a scan, rank 1 is still the one of the previous frame */
+    adc_scan_stop();
+    scan_buffer[0] = 0x0123U;
+    scan_buffer[(2U * ADC_SCAN_HALF_SIZE) - 1U] = 0x0456U;
+    adc_model.dma_position = 1U;
+    HOST_CHECK_EQ(adc_scan_latest_get(0U), 0x0123U);
+    HOST_CHECK_EQ(adc_scan_latest_get(1U), 0x0456U);
+    scan_buffer[ADC_SCAN_HALF_SIZE] = 0x0789U;
+    scan_buffer[ADC_SCAN_HALF_SIZE - 1U] = 0x0ABCU;
+    adc_model.dma_position = ADC_SCAN_HALF_SIZE + 1U;
+    HOST_CHECK_EQ(adc_scan_latest_get(0U), 0x0789U);
+    HOST_CHECK_EQ(adc_scan_latest_get(1U), 0x0ABCU);
+}
+
+/* the oversampled result keeps the 12-bit scale, and the mean of a half rounds to nearest */
+static void test_scale(void)
+{
+    static const uint16_t level[] = {0U, 1U, 2048U, 4094U, 4095U};
+    uint16_t data[TEST_HALF_FRAMES * ADC_SCAN_CHANNEL_NUM];
+    uint32_t k;
+
+    for(k = 0U; k < sizeof(level) / sizeof(level[0]); k++) {
+        constant = level[k];
+        scan_setup(input_constant, 0U);
+        adc_scan_start();
+        adc_model_run(1U);
+        HOST_CHECK_EQ(adc_scan_latest_get(0U), level[k]);
+        HOST_CHECK_EQ(adc_scan_latest_get(1U), level[k]);
+        HOST_CHECK_EQ(adc_model.conversions, ADC_SCAN_CHANNEL_NUM << ADC_SCAN_OVERSAMPLE_BITS);
+    }
+
+    for(k = 0U; k < TEST_HALF_FRAMES; k++) {
+        data[k * ADC_SCAN_CHANNEL_NUM] = (uint16_t)(4095U - k);
+        data[k * ADC_SCAN_CHANNEL_NUM + 1U] = (uint16_t)((k < (TEST_HALF_FRAMES / 2U)) ? 100U : 101U);
+    }
+    /* 4095 - 15.5 and 100.5 round up */
+    HOST_CHECK_EQ(adc_scan_mean(data, TEST_HALF_FRAMES, 0U), 4080U);
+    HOST_CHECK_EQ(adc_scan_mean(data, TEST_HALF_FRAMES, 1U), 101U);
+    HOST_CHECK_EQ(adc_scan_mean(data, 1U, 0U), 4095U);
+    HOST_CHECK_EQ(adc_scan_mean(data, 0U, 0U), 0U);
+}
+
+int main(void)
+{
+    test_config();
+    test_halves();
+    test_latest();
+    test_scale();
+
+    return host_test_result("adc_scan");
+}
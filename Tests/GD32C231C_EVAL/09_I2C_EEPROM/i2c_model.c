@@ -0,0 +1,889 @@
+/*!
+    \file    i2c_model.c
+    \brief   I2C1 master, AT24C02 and scripted slave model behind the I2C and DMA functions used by i2c_engine.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include "i2c_model.h"
+#include "i2c_engine.h"
+#include "host_cmsis.h"
+
+#define MODEL_DMA_CHANNELS  4U
+/* bus steps and interrupts at most in one host timer tick */
+#define MODEL_STEPS         256U
+
+#define MODEL_STATC_MASK    (I2C_STAT_ADDSEND | I2C_STAT_NACK | I2C_STAT_STPDET | I2C_STAT_BERR | \
+                             I2C_STAT_LOSTARB | I2C_STAT_OUERR | I2C_STAT_PECERR | I2C_STAT_TIMEOUT | \
+                             I2C_STAT_SMBALT)
+
+typedef enum {
+    BUS_IDLE = 0,           /* no transfer, waiting for START */
+    BUS_TX,                 /* sending BYTENUM bytes */
+    BUS_RX,                 /* receiving BYTENUM bytes */
+    BUS_TC,                 /* TC set, waiting for START or STOP */
+    BUS_TCR,                /* TCR set, waiting for BYTENUM */
+    BUS_NACK                /* NACK received, waiting for STOP */
+} model_bus_enum;
+
+typedef enum {
+    SLAVE_NONE = 0,
+    SLAVE_AT24,
+    SLAVE_SCRIPT
+} model_slave_enum;
+
+typedef struct {
+    uint32_t memory;
+    uint32_t number;
+    uint32_t request;
+    uint8_t enabled;
+} model_dma_struct;
+
+i2c_model_struct i2c_model;
+
+/* master state */
+static model_bus_enum model_bus = BUS_IDLE;
+static uint32_t model_count;                /* bytes left of the BYTENUM load */
+static uint8_t model_read;                  /* direction of the transfer */
+static uint8_t model_tdata;
+static uint8_t model_tdata_full = 0U;
+static uint8_t model_ev_enabled = 0U;
+static uint8_t model_er_enabled = 0U;
+static model_dma_struct model_dma[MODEL_DMA_CHANNELS];
+/* slave which acknowledged the address, bytes moved since */
+static model_slave_enum model_slave = SLAVE_NONE;
+static uint32_t model_bytes;
+
+/* AT24C02 state */
+static uint8_t at24_selected = 0U;
+static uint8_t at24_pointer = 0U;           /* internal address counter */
+static uint8_t at24_word_address = 0U;      /* SET once the word address of a write was received */
+static uint8_t at24_latch[AT24_MODEL_PAGE_SIZE];
+static uint8_t at24_latch_mask = 0U;
+static uint8_t at24_page;
+static uint32_t at24_data_bytes;
+static uint8_t at24_first_offset;
+static uint8_t at24_wait_access = 0U;
+
+/* scripted slave state */
+static uint8_t script_reg_bytes;            /* register address bytes received */
+
+/* time, the timer runs the bus until model_tick_end */
+static uint64_t model_time = 0U;
+static uint64_t model_tick_end = 0U;
+static uint64_t model_systick = I2C_MODEL_SYSTICK;
+/* SET while a stub changes the model, the timer leaves the driver alone then */
+static volatile uint32_t model_lock = 0U;
+static uint8_t model_timer_started = 0U;
+
+/*!
+    \brief      model time
+    \param[in]  none
+    \param[out] none
+    \retval     nanoseconds since the model was initialized
+*/
+uint64_t i2c_model_now(void)
+{
+    return model_time;
+}
+
+/*!
+    \brief      SET while the AT24C02 executes a write cycle
+    \param[in]  none
+    \param[out] none
+    \retval     FlagStatus: SET or RESET
+*/
+FlagStatus i2c_model_busy(void)
+{
+    return (model_time < i2c_model.busy_until) ? SET : RESET;
+}
+
+/*!
+    \brief      address phase seen by the AT24C02
+    \param[in]  address: address byte without the direction bit
+    \param[in]  read: 1 for a read transfer
+    \param[out] none
+    \retval     1 if the address is acknowledged
+*/
+static uint8_t at24_start(uint8_t address, uint8_t read)
+{
+    if(AT24_MODEL_ADDRESS != address) {
+        return 0U;
+    }
+    /* the inputs are disabled during the write cycle */
+    if(SET == i2c_model_busy()) {
+        i2c_model.busy_polls++;
+        return 0U;
+    }
+    if(0U != at24_wait_access) {
+        at24_wait_access = 0U;
+        i2c_model.first_access = model_time;
+    }
+    at24_selected = 1U;
+    if(0U == read) {
+        at24_word_address = 0U;
+        at24_latch_mask = 0U;
+        at24_data_bytes = 0U;
+    }
+    return 1U;
+}
+
+/*!
+    \brief      byte written to the AT24C02, the word address and then the page data
+    \param[in]  byte: byte on the bus
+    \param[out] none
+    \retval     1 if the byte is acknowledged
+*/
+static uint8_t at24_write(uint8_t byte)
+{
+    uint8_t offset;
+
+    if(0U == at24_selected) {
+        return 0U;
+    }
+    if(0U == at24_word_address) {
+        at24_word_address = 1U;
+        at24_pointer = byte;
+        at24_page = byte & (uint8_t)~(AT24_MODEL_PAGE_SIZE - 1U);
+        at24_first_offset = byte % AT24_MODEL_PAGE_SIZE;
+        return 1U;
+    }
+    /* the address counter rolls over inside the page */
+    offset = at24_pointer % AT24_MODEL_PAGE_SIZE;
+    at24_latch[offset] = byte;
+    at24_latch_mask |= (uint8_t)(1U << offset);
+    at24_data_bytes++;
+    at24_pointer = at24_page | ((offset + 1U) % AT24_MODEL_PAGE_SIZE);
+    return 1U;
+}
+
+/*!
+    \brief      byte read from the AT24C02 at the address counter
+    \param[in]  none
+    \param[out] none
+    \retval     byte on the bus
+*/
+static uint8_t at24_read(void)
+{
+    uint8_t byte = i2c_model.array[at24_pointer];
+
+    at24_pointer++;
+    i2c_model.byte_reads++;
+    return byte;
+}
+
+/*!
+    \brief      stop condition, the latched page data is programmed
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void at24_stop(void)
+{
+    uint8_t i;
+
+    if((0U != at24_selected) && (0U != at24_latch_mask)) {
+        for(i = 0U; i < AT24_MODEL_PAGE_SIZE; i++) {
+            if(0U != (at24_latch_mask & (1U << i))) {
+                i2c_model.array[at24_page + i] = at24_latch[i];
+                i2c_model.bytes_programmed++;
+            }
+        }
+        if((at24_first_offset + at24_data_bytes) > AT24_MODEL_PAGE_SIZE) {
+            i2c_model.page_rollovers++;
+        }
+        i2c_model.write_cycles++;
+        i2c_model.busy_until = model_time + i2c_model.write_cycle;
+        i2c_model.last_write_end = model_time;
+        at24_wait_access = 1U;
+    }
+    at24_selected = 0U;
+    at24_latch_mask = 0U;
+}
+
+/*!
+    \brief      address phase seen by the scripted slave
+    \param[in]  address: address byte without the direction bit
+    \param[in]  read: 1 for a read transfer
+    \param[out] none
+    \retval     1 if the address is acknowledged
+*/
+static uint8_t script_start(uint8_t address, uint8_t read)
+{
+    script_model_struct *script = &i2c_model.script;
+
+    if(SCRIPT_MODEL_ADDRESS != address) {
+        return 0U;
+    }
+    if(0U != script->nack_address) {
+        script->nack_address = 0U;
+        return 0U;
+    }
+    script->transfers++;
+    if(0U == read) {
+        script_reg_bytes = 0U;
+    }
+    return 1U;
+}
+
+/*!
+    \brief      byte written to the scripted slave, the register address and then the data
+    \param[in]  byte: byte on the bus
+    \param[out] none
+    \retval     1 if the byte is acknowledged
+*/
+static uint8_t script_write(uint8_t byte)
+{
+    script_model_struct *script = &i2c_model.script;
+
+    if(model_bytes == script->nack_byte) {
+        script->nack_byte = 0U;
+        return 0U;
+    }
+    if(script_reg_bytes < 2U) {
+        /* most significant byte first */
+        script->pointer = (uint16_t)((script->pointer << 8) | byte);
+        script_reg_bytes++;
+    } else {
+        script->memory[script->pointer % SCRIPT_MODEL_SIZE] = byte;
+        script->pointer++;
+        script->bytes_written++;
+    }
+    return 1U;
+}
+
+/*!
+    \brief      byte read from the scripted slave at the register address
+    \param[in]  none
+    \param[out] none
+    \retval     byte on the bus
+*/
+static uint8_t script_read(void)
+{
+    script_model_struct *script = &i2c_model.script;
+    uint8_t byte = script->memory[script->pointer % SCRIPT_MODEL_SIZE];
+
+    script->pointer++;
+    script->bytes_read++;
+    return byte;
+}
+
+/*!
+    \brief      address phase, the slaves compare the address
+    \param[in]  address: address byte without the direction bit
+    \param[in]  read: 1 for a read transfer
+    \param[out] none
+    \retval     1 if the address is acknowledged
+*/
+static uint8_t model_slave_start(uint8_t address, uint8_t read)
+{
+    model_bytes = 0U;
+    if(0U != at24_start(address, read)) {
+        model_slave = SLAVE_AT24;
+    } else if(0U != script_start(address, read)) {
+        model_slave = SLAVE_SCRIPT;
+    } else {
+        model_slave = SLAVE_NONE;
+    }
+    return (SLAVE_NONE != model_slave) ? 1U : 0U;
+}
+
+/*!
+    \brief      fault of the scripted slave before the next byte
+    \param[in]  none
+    \param[out] none
+    \retval     SET if the byte is not moved
+*/
+static FlagStatus model_fault(void)
+{
+    script_model_struct *script = &i2c_model.script;
+    uint32_t next = model_bytes + 1U;
+
+    if(SLAVE_SCRIPT != model_slave) {
+        return RESET;
+    }
+    if(next == script->hang_byte) {
+        return SET;
+    }
+    if(next == script->error_byte) {
+        /* the master leaves the bus */
+        script->error_byte = 0U;
+        I2C_STAT(I2C1) &= ~(I2C_STAT_I2CBSY | I2C_STAT_TI);
+        I2C_STAT(I2C1) |= script->error_flag;
+        model_bus = BUS_IDLE;
+        model_slave = SLAVE_NONE;
+        return SET;
+    }
+    return RESET;
+}
+
+/*!
+    \brief      the slaves see the clocks and the stop of a bus reset
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void i2c_model_bus_clear(void)
+{
+    i2c_model.bus_resets++;
+    i2c_model.script.hang_byte = 0U;
+    at24_stop();
+    model_slave = SLAVE_NONE;
+}
+
+/*!
+    \brief      stop condition on the bus
+    \param[in]  none
+    \param[out] none
+    \retval     SCL periods
+*/
+static uint32_t model_stop(void)
+{
+    I2C_CTL1(I2C1) &= ~(I2C_CTL1_START | I2C_CTL1_STOP);
+    I2C_STAT(I2C1) &= ~(I2C_STAT_I2CBSY | I2C_STAT_TI | I2C_STAT_TC | I2C_STAT_TCR);
+    I2C_STAT(I2C1) |= I2C_STAT_STPDET | I2C_STAT_TBE;
+    i2c_model.stops++;
+    at24_stop();
+    model_slave = SLAVE_NONE;
+    model_bus = BUS_IDLE;
+    model_tdata_full = 0U;
+    return 1U;
+}
+
+/*!
+    \brief      the address or a data byte was not acknowledged
+    \param[in]  none
+    \param[out] none
+    \retval     SCL periods of the automatic stop
+*/
+static uint32_t model_nack(void)
+{
+    i2c_model.nacks++;
+    I2C_STAT(I2C1) &= ~I2C_STAT_TI;
+    I2C_STAT(I2C1) |= I2C_STAT_NACK;
+    model_bus = BUS_NACK;
+    if(0U != (I2C_CTL1(I2C1) & I2C_CTL1_AUTOEND)) {
+        return model_stop();
+    }
+    return 0U;
+}
+
+/*!
+    \brief      the bytes of the BYTENUM load are transferred
+    \param[in]  none
+    \param[out] none
+    \retval     SCL periods of the automatic stop
+*/
+static uint32_t model_count_end(void)
+{
+    uint32_t ctl1 = I2C_CTL1(I2C1);
+
+    if(0U != (ctl1 & I2C_CTL1_RELOAD)) {
+        I2C_STAT(I2C1) |= I2C_STAT_TCR;
+        model_bus = BUS_TCR;
+        i2c_model.reloads++;
+    } else if(0U != (ctl1 & I2C_CTL1_AUTOEND)) {
+        return model_stop();
+    } else {
+        I2C_STAT(I2C1) |= I2C_STAT_TC;
+        model_bus = BUS_TC;
+    }
+    return 0U;
+}
+
+/*!
+    \brief      start or restart condition and address byte
+    \param[in]  none
+    \param[out] none
+    \retval     SCL periods
+*/
+static uint32_t model_start(void)
+{
+    uint32_t ctl1 = I2C_CTL1(I2C1);
+    uint32_t clocks = 10U;
+
+    I2C_CTL1(I2C1) &= ~I2C_CTL1_START;
+    I2C_STAT(I2C1) &= ~(I2C_STAT_TC | I2C_STAT_NACK);
+    I2C_STAT(I2C1) |= I2C_STAT_I2CBSY;
+    i2c_model.starts++;
+    /* writing TBE flushes I2C_TDATA */
+    if(0U != (I2C_STAT(I2C1) & I2C_STAT_TBE)) {
+        model_tdata_full = 0U;
+    }
+
+    model_read = (0U != (ctl1 & I2C_CTL1_TRDIR)) ? 1U : 0U;
+    model_count = (ctl1 & I2C_CTL1_BYTENUM) >> 16;
+    if(0U == model_slave_start((uint8_t)(ctl1 & 0xFEU), model_read)) {
+        return clocks + model_nack();
+    }
+    if(0U == model_count) {
+        /* a stray TI would ask the driver for a byte it doesn't have */
+        if((0U == model_read) && (0U != (I2C_CTL0(I2C1) & I2C_CTL0_TIE))) {
+            i2c_model.ti_errors++;
+        }
+        return clocks + model_count_end();
+    }
+    if(0U != model_read) {
+        model_bus = BUS_RX;
+    } else {
+        model_bus = BUS_TX;
+        if(0U == model_tdata_full) {
+            I2C_STAT(I2C1) |= I2C_STAT_TI | I2C_STAT_TBE;
+        }
+    }
+    return clocks;
+}
+
+/*!
+    \brief      DMA channel serving a request
+    \param[in]  request: DMAMUX request
+    \param[out] none
+    \retval     enabled channel with bytes left, NULL if none
+*/
+static model_dma_struct *model_dma_find(uint32_t request)
+{
+    uint32_t i;
+
+    for(i = 0U; i < MODEL_DMA_CHANNELS; i++) {
+        if((request == model_dma[i].request) && (0U != model_dma[i].enabled) && (0U != model_dma[i].number)) {
+            return &model_dma[i];
+        }
+    }
+    return NULL;
+}
+
+/*!
+    \brief      serve the DMA requests of I2C_TDATA and I2C_RDATA
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_serve(void)
+{
+    model_dma_struct *dma;
+
+    if((0U != (I2C_CTL0(I2C1) & I2C_CTL0_DENT)) && (BUS_TX == model_bus) && (0U == model_tdata_full)) {
+        dma = model_dma_find(DMA_REQUEST_I2C1_TX);
+        if(NULL != dma) {
+            model_tdata = *(uint8_t *)(uintptr_t)dma->memory;
+            model_tdata_full = 1U;
+            I2C_STAT(I2C1) &= ~(I2C_STAT_TI | I2C_STAT_TBE);
+            dma->memory++;
+            dma->number--;
+            i2c_model.dma_bytes++;
+        }
+    }
+    if((0U != (I2C_CTL0(I2C1) & I2C_CTL0_DENR)) && (0U != (I2C_STAT(I2C1) & I2C_STAT_RBNE))) {
+        dma = model_dma_find(DMA_REQUEST_I2C1_RX);
+        if(NULL != dma) {
+            *(uint8_t *)(uintptr_t)dma->memory = (uint8_t)I2C_RDATA(I2C1);
+            I2C_STAT(I2C1) &= ~I2C_STAT_RBNE;
+            dma->memory++;
+            dma->number--;
+            i2c_model.dma_bytes++;
+        }
+    }
+}
+
+/*!
+    \brief      move the bus by one condition or byte
+    \param[in]  none
+    \param[out] none
+    \retval     SCL periods, 0 while the bus waits for the software
+*/
+static uint32_t model_step(void)
+{
+    uint32_t ctl1 = I2C_CTL1(I2C1);
+    uint8_t ack;
+
+    if(0U == (I2C_CTL0(I2C1) & I2C_CTL0_I2CEN)) {
+        return 0U;
+    }
+    model_dma_serve();
+
+    switch(model_bus) {
+    case BUS_IDLE:
+        return (0U != (ctl1 & I2C_CTL1_START)) ? model_start() : 0U;
+    case BUS_TC:
+        if(0U != (ctl1 & I2C_CTL1_STOP)) {
+            return model_stop();
+        }
+        return (0U != (ctl1 & I2C_CTL1_START)) ? model_start() : 0U;
+    case BUS_NACK:
+        return (0U != (ctl1 & I2C_CTL1_STOP)) ? model_stop() : 0U;
+    case BUS_TX:
+        if((0U == model_tdata_full) || (SET == model_fault())) {
+            return 0U;
+        }
+        model_tdata_full = 0U;
+        model_count--;
+        model_bytes++;
+        ack = (SLAVE_AT24 == model_slave) ? at24_write(model_tdata) : script_write(model_tdata);
+        if(0U == ack) {
+            return 9U + model_nack();
+        }
+        if(0U == model_count) {
+            return 9U + model_count_end();
+        }
+        I2C_STAT(I2C1) |= I2C_STAT_TI | I2C_STAT_TBE;
+        return 9U;
+    case BUS_RX:
+        /* SCL is stretched until I2C_RDATA is read */
+        if((0U != (I2C_STAT(I2C1) & I2C_STAT_RBNE)) || (SET == model_fault())) {
+            return 0U;
+        }
+        model_bytes++;
+        I2C_RDATA(I2C1) = (SLAVE_AT24 == model_slave) ? at24_read() : script_read();
+        I2C_STAT(I2C1) |= I2C_STAT_RBNE;
+        /* the DMA takes the byte before the stop which may follow */
+        model_dma_serve();
+        model_count--;
+        if(0U == model_count) {
+            return 9U + model_count_end();
+        }
+        return 9U;
+    default:
+        return 0U;
+    }
+}
+
+/*!
+    \brief      run the I2C interrupt service which is pending
+    \param[in]  none
+    \param[out] none
+    \retval     1 if a service ran
+*/
+static uint8_t model_irq(void)
+{
+    uint32_t ctl0 = I2C_CTL0(I2C1);
+    uint32_t stat = I2C_STAT(I2C1);
+    uint32_t pending = 0U;
+
+    if((0U != model_er_enabled) && (0U != (ctl0 & I2C_CTL0_ERRIE)) &&
+            (0U != (stat & (I2C_STAT_BERR | I2C_STAT_LOSTARB | I2C_STAT_OUERR)))) {
+        i2c_model.er_irqs++;
+        i2c_engine_er_irq_handler();
+        return 1U;
+    }
+
+    if(0U != (ctl0 & I2C_CTL0_TIE)) {
+        pending |= stat & I2C_STAT_TI;
+    }
+    if(0U != (ctl0 & I2C_CTL0_RBNEIE)) {
+        pending |= stat & I2C_STAT_RBNE;
+    }
+    if(0U != (ctl0 & I2C_CTL0_NACKIE)) {
+        pending |= stat & I2C_STAT_NACK;
+    }
+    if(0U != (ctl0 & I2C_CTL0_STPDETIE)) {
+        pending |= stat & I2C_STAT_STPDET;
+    }
+    if(0U != (ctl0 & I2C_CTL0_TCIE)) {
+        pending |= stat & (I2C_STAT_TC | I2C_STAT_TCR);
+    }
+    if((0U != model_ev_enabled) && (0U != pending)) {
+        i2c_model.ev_irqs++;
+        i2c_engine_ev_irq_handler();
+        return 1U;
+    }
+    return 0U;
+}
+
+/*!
+    \brief      the host timer: the bus runs for a tick of model time, then SysTick
+    \param[in]  sig: signal number
+    \param[out] none
+    \retval     none
+*/
+static void model_timer(int sig)
+{
+    uint32_t steps, clocks;
+    uint8_t irq;
+
+    (void)sig;
+    model_tick_end += I2C_MODEL_TICK;
+    if((0U != model_lock) || (0U != host_primask)) {
+        return;
+    }
+
+    i2c_model.in_isr = 1U;
+    for(steps = 0U; (model_time < model_tick_end) && (steps < MODEL_STEPS); steps++) {
+        clocks = model_step();
+        irq = model_irq();
+        if((0U == clocks) && (0U == irq)) {
+            break;
+        }
+        i2c_model.bus_clocks += clocks;
+        model_time += (uint64_t)clocks * I2C_MODEL_CLOCK;
+    }
+    if(model_time < model_tick_end) {
+        model_time = model_tick_end;
+    }
+    while(model_time >= model_systick) {
+        model_systick += I2C_MODEL_SYSTICK;
+        if(NULL != i2c_model.tick_hook) {
+            i2c_model.tick_hook();
+        }
+    }
+    i2c_model.in_isr = 0U;
+}
+
+/*!
+    \brief      fill the AT24C02 array, clear the counters and start the timer which runs the interrupts
+    \param[in]  fill: value of every EEPROM byte
+    \param[out] none
+    \retval     none
+*/
+void i2c_model_init(uint8_t fill)
+{
+    struct itimerval tick = {{0, 100}, {0, 100}};
+
+    model_lock++;
+    memset(&i2c_model, 0, sizeof(i2c_model));
+    memset(i2c_model.array, fill, sizeof(i2c_model.array));
+    memset(model_dma, 0, sizeof(model_dma));
+    i2c_model.write_cycle = I2C_MODEL_US(5000U);
+    I2C_CTL0(I2C1) = 0U;
+    I2C_CTL1(I2C1) = 0U;
+    I2C_STAT(I2C1) = I2C_STAT_TBE;
+    model_bus = BUS_IDLE;
+    model_tdata_full = 0U;
+    model_slave = SLAVE_NONE;
+    at24_selected = 0U;
+    at24_pointer = 0U;
+    at24_wait_access = 0U;
+    model_time = 0U;
+    model_tick_end = 0U;
+    model_systick = I2C_MODEL_SYSTICK;
+    model_lock--;
+
+    if(0U == model_timer_started) {
+        model_timer_started = 1U;
+        signal(SIGALRM, model_timer);
+        setitimer(ITIMER_REAL, &tick, NULL);
+    }
+}
+
+/* standard peripheral library functions used by the engine */
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq_priority;
+    if(I2C_ENGINE_EV_IRQn == nvic_irq) {
+        model_ev_enabled = 1U;
+    } else if(I2C_ENGINE_ER_IRQn == nvic_irq) {
+        model_er_enabled = 1U;
+    }
+}
+
+void i2c_enable(uint32_t i2c_periph)
+{
+    I2C_CTL0(i2c_periph) |= I2C_CTL0_I2CEN;
+}
+
+void i2c_disable(uint32_t i2c_periph)
+{
+    /* the software reset releases the bus and clears the flags */
+    I2C_CTL0(i2c_periph) &= ~I2C_CTL0_I2CEN;
+    I2C_CTL1(i2c_periph) &= ~(I2C_CTL1_START | I2C_CTL1_STOP);
+    I2C_STAT(i2c_periph) = I2C_STAT_TBE;
+    model_bus = BUS_IDLE;
+    model_tdata_full = 0U;
+    model_slave = SLAVE_NONE;
+    at24_selected = 0U;
+}
+
+void i2c_start_on_bus(uint32_t i2c_periph)
+{
+    if((BUS_TX == model_bus) || (BUS_RX == model_bus) || (BUS_TCR == model_bus)) {
+        i2c_model.start_errors++;
+    }
+    I2C_CTL1(i2c_periph) |= I2C_CTL1_START;
+    I2C_STAT(i2c_periph) &= ~I2C_STAT_TC;
+}
+
+void i2c_stop_on_bus(uint32_t i2c_periph)
+{
+    I2C_CTL1(i2c_periph) |= I2C_CTL1_STOP;
+    I2C_STAT(i2c_periph) &= ~I2C_STAT_TC;
+}
+
+void i2c_master_addressing(uint32_t i2c_periph, uint32_t address, uint32_t trans_direction)
+{
+    I2C_CTL1(i2c_periph) &= ~I2C_CTL1_SADDRESS;
+    I2C_CTL1(i2c_periph) |= (uint32_t)(address & I2C_CTL1_SADDRESS);
+    I2C_CTL1(i2c_periph) &= ~I2C_CTL1_TRDIR;
+    I2C_CTL1(i2c_periph) |= (uint32_t)(trans_direction & I2C_CTL1_TRDIR);
+}
+
+void i2c_transfer_byte_number_config(uint32_t i2c_periph, uint8_t byte_number)
+{
+    I2C_CTL1(i2c_periph) &= ~I2C_CTL1_BYTENUM;
+    I2C_CTL1(i2c_periph) |= (uint32_t)byte_number << 16;
+    if(BUS_TCR == model_bus) {
+        /* the next load of the phase, this clears TCR */
+        I2C_STAT(i2c_periph) &= ~I2C_STAT_TCR;
+        model_count = byte_number;
+        if(0U != model_read) {
+            model_bus = BUS_RX;
+        } else {
+            model_bus = BUS_TX;
+            if(0U == model_tdata_full) {
+                I2C_STAT(i2c_periph) |= I2C_STAT_TI | I2C_STAT_TBE;
+            }
+        }
+    } else if((BUS_TX == model_bus) || (BUS_RX == model_bus)) {
+        i2c_model.reload_errors++;
+    }
+}
+
+void i2c_reload_enable(uint32_t i2c_periph)
+{
+    I2C_CTL1(i2c_periph) |= I2C_CTL1_RELOAD;
+}
+
+void i2c_reload_disable(uint32_t i2c_periph)
+{
+    I2C_CTL1(i2c_periph) &= ~I2C_CTL1_RELOAD;
+}
+
+void i2c_automatic_end_enable(uint32_t i2c_periph)
+{
+    I2C_CTL1(i2c_periph) |= I2C_CTL1_AUTOEND;
+}
+
+void i2c_automatic_end_disable(uint32_t i2c_periph)
+{
+    I2C_CTL1(i2c_periph) &= ~I2C_CTL1_AUTOEND;
+}
+
+void i2c_data_transmit(uint32_t i2c_periph, uint8_t data)
+{
+    if(0U != model_tdata_full) {
+        i2c_model.tdata_overruns++;
+    }
+    I2C_TDATA(i2c_periph) = data;
+    model_tdata = data;
+    model_tdata_full = 1U;
+    I2C_STAT(i2c_periph) &= ~(I2C_STAT_TI | I2C_STAT_TBE);
+}
+
+uint8_t i2c_data_receive(uint32_t i2c_periph)
+{
+    if(0U == (I2C_STAT(i2c_periph) & I2C_STAT_RBNE)) {
+        i2c_model.rdata_underruns++;
+    }
+    I2C_STAT(i2c_periph) &= ~I2C_STAT_RBNE;
+    return (uint8_t)I2C_RDATA(i2c_periph);
+}
+
+void i2c_dma_enable(uint32_t i2c_periph, uint8_t dma)
+{
+    I2C_CTL0(i2c_periph) |= (I2C_DMA_TRANSMIT == dma) ? I2C_CTL0_DENT : I2C_CTL0_DENR;
+}
+
+void i2c_dma_disable(uint32_t i2c_periph, uint8_t dma)
+{
+    I2C_CTL0(i2c_periph) &= ~((I2C_DMA_TRANSMIT == dma) ? I2C_CTL0_DENT : I2C_CTL0_DENR);
+}
+
+void i2c_flag_clear(uint32_t i2c_periph, uint32_t flag)
+{
+    I2C_STAT(i2c_periph) &= ~(flag & MODEL_STATC_MASK);
+}
+
+void i2c_interrupt_enable(uint32_t i2c_periph, uint32_t interrupt)
+{
+    I2C_CTL0(i2c_periph) |= interrupt;
+}
+
+void i2c_interrupt_disable(uint32_t i2c_periph, uint32_t interrupt)
+{
+    I2C_CTL0(i2c_periph) &= ~interrupt;
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    memset(&model_dma[channelx], 0, sizeof(model_dma[channelx]));
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    model_dma[channelx].memory = init_struct->memory_addr;
+    model_dma[channelx].number = init_struct->number;
+    model_dma[channelx].request = init_struct->request;
+}
+
+void dma_circulation_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_address_config(dma_channel_enum channelx, uint32_t address)
+{
+    model_dma[channelx].memory = address;
+}
+
+void dma_transfer_number_config(dma_channel_enum channelx, uint32_t number)
+{
+    model_dma[channelx].number = number;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    model_dma[channelx].enabled = 1U;
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    model_dma[channelx].enabled = 0U;
+}
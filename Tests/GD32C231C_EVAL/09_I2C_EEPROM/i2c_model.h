@@ -0,0 +1,117 @@
+/*!
+    \file    i2c_model.h
+    \brief   I2C1 master, AT24C02 and scripted slave model behind the I2C and DMA functions used by i2c_engine.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef I2C_MODEL_H
+#define I2C_MODEL_H
+
+#include "gd32c2x1.h"
+
+#define AT24_MODEL_ADDRESS          0xA0U
+#define AT24_MODEL_SIZE             256U
+#define AT24_MODEL_PAGE_SIZE        8U
+
+#define SCRIPT_MODEL_ADDRESS        0x90U
+#define SCRIPT_MODEL_SIZE           1024U
+
+/* model time in nanoseconds */
+#define I2C_MODEL_US(us)            ((uint64_t)(us) * 1000U)
+/* one SCL period at 400 kHz */
+#define I2C_MODEL_CLOCK             2500U
+/* model time which passes at each host timer tick */
+#define I2C_MODEL_TICK              I2C_MODEL_US(100U)
+/* SysTick period */
+#define I2C_MODEL_SYSTICK           I2C_MODEL_US(1000U)
+
+/* slave with a 2-byte register address into its memory, the faults are counted
+   in the bytes after the address of a transfer, 0 for none, and happen once */
+typedef struct {
+    uint8_t memory[SCRIPT_MODEL_SIZE];
+    uint16_t pointer;                /* register address */
+    uint8_t nack_address;            /* the address of the next transfer is not acknowledged */
+    uint32_t nack_byte;              /* the written byte is not acknowledged */
+    uint32_t hang_byte;              /* SCL is held low before the byte until the bus is reset */
+    uint32_t error_byte;             /* error_flag is raised during the byte */
+    uint32_t error_flag;             /* I2C_STAT_BERR or I2C_STAT_LOSTARB */
+    uint32_t transfers;              /* acknowledged addresses */
+    uint32_t bytes_written;
+    uint32_t bytes_read;
+} script_model_struct;
+
+typedef struct {
+    /* AT24C02 array and write cycle */
+    uint8_t array[AT24_MODEL_SIZE];
+    uint64_t write_cycle;            /* length of the write cycle, ns */
+    uint64_t busy_until;
+    uint64_t last_write_end;         /* stop of the last page write */
+    uint64_t first_access;           /* first acknowledged address after that stop */
+    uint32_t write_cycles;           /* page writes programmed */
+    uint32_t bytes_programmed;
+    uint32_t busy_polls;             /* addresses not acknowledged during a write cycle */
+    uint32_t page_rollovers;         /* page writes wrapped at the end of the page */
+    uint32_t byte_reads;
+    /* scripted slave */
+    script_model_struct script;
+    /* bus counters */
+    uint64_t bus_clocks;             /* SCL periods */
+    uint32_t starts;
+    uint32_t stops;
+    uint32_t nacks;
+    uint32_t reloads;                /* TCR, a BYTENUM load of 255 bytes was transferred */
+    uint32_t bus_resets;
+    uint32_t dma_bytes;
+    uint32_t ev_irqs;
+    uint32_t er_irqs;
+    /* sequencing errors, all of them must stay zero */
+    uint32_t tdata_overruns;         /* TDATA written while it was full */
+    uint32_t rdata_underruns;        /* RDATA read while it was empty */
+    uint32_t start_errors;           /* START set during a transfer */
+    uint32_t reload_errors;          /* BYTENUM written during a transfer, out of TCR */
+    uint32_t ti_errors;              /* TI enabled for a transmit of no bytes */
+    /* test controls */
+    void (*tick_hook)(void);         /* SysTick, called each model millisecond */
+    volatile uint8_t in_isr;         /* SET while the timer runs the driver */
+} i2c_model_struct;
+
+extern i2c_model_struct i2c_model;
+
+/* fill the AT24C02 array, clear the counters and start the timer which runs the interrupts */
+void i2c_model_init(uint8_t fill);
+/* model time in nanoseconds */
+uint64_t i2c_model_now(void);
+/* SET while the AT24C02 executes a write cycle */
+FlagStatus i2c_model_busy(void);
+/* the slaves see the clocks and the stop of a bus reset */
+void i2c_model_bus_clear(void);
+
+#endif /* I2C_MODEL_H */
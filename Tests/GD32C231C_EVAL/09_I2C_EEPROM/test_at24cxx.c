@@ -0,0 +1,414 @@
+/*!
+    \file    test_at24cxx.c
+    \brief   write-back cache and ACK polling of at24cxx.c on the AT24C02 model
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "host_cmsis.h"
+#include "i2c_model.h"
+#include "i2c_engine.c"
+#include "at24cxx.c"
+
+#define TEST_OPERATIONS     300U
+
+/* what the EEPROM must hold once the cache is flushed */
+static uint8_t reference[AT24_MODEL_SIZE];
+
+/* i2c.c, the model has no bus to release */
+void i2c_bus_reset(void)
+{
+}
+
+/*!
+    \brief      SysTick of the demo
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void systick(void)
+{
+    i2c_engine_tick();
+    eeprom_cache_tick();
+}
+
+/*!
+    \brief      restart the model and the driver with an empty cache
+    \param[in]  fill: value of every EEPROM byte
+    \param[out] none
+    \retval     none
+*/
+static void eeprom_start(uint8_t fill)
+{
+    i2c_model_init(fill);
+    memset(eeprom_cache, 0, sizeof(eeprom_cache));
+    eeprom_cache_timer = 0U;
+    eeprom_write_cycle = 0U;
+    memset(reference, fill, sizeof(reference));
+
+    i2c_model.tick_hook = systick;
+    i2c_enable(I2CX);
+    i2c_engine_init();
+    i2c_eeprom_init();
+}
+
+/*!
+    \brief      check the model counters which must stay zero
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void check_bus(void)
+{
+    HOST_CHECK_EQ(i2c_model.page_rollovers, 0U);
+    HOST_CHECK_EQ(i2c_model.tdata_overruns, 0U);
+    HOST_CHECK_EQ(i2c_model.rdata_underruns, 0U);
+    HOST_CHECK_EQ(i2c_model.start_errors, 0U);
+    HOST_CHECK_EQ(i2c_model.reload_errors, 0U);
+    HOST_CHECK_EQ(i2c_model.ti_errors, 0U);
+}
+
+/*!
+    \brief      the demo write, read and cached write of the 256 bytes
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_demo(void)
+{
+    uint32_t i;
+
+    eeprom_start(0xFFU);
+    HOST_CHECK_EQ(i2c_24c02_test(), I2C_OK);
+
+    for(i = 0U; i < AT24_MODEL_SIZE; i++) {
+        if(i < 2U * I2C_PAGE_SIZE) {
+            HOST_CHECK_EQ(i2c_model.array[i], 0xFFU - i);
+        } else {
+            HOST_CHECK_EQ(i2c_model.array[i], i);
+        }
+    }
+    /* 32 page writes, then the 16 cached byte writes in 2 page writes */
+    HOST_CHECK_EQ(i2c_model.write_cycles, AT24_MODEL_SIZE / AT24_MODEL_PAGE_SIZE + 2U);
+    HOST_CHECK(0U != i2c_model.dma_bytes);
+    check_bus();
+}
+
+/*!
+    \brief      the end of the write cycle is found by polling the device address
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_polling(void)
+{
+    uint8_t data[AT24_MODEL_PAGE_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8};
+    uint8_t read[AT24_MODEL_PAGE_SIZE];
+    uint64_t late;
+
+    eeprom_start(0xFFU);
+    eeprom_page_write(data, 0x40U, AT24_MODEL_PAGE_SIZE);
+    /* the write returns at the stop, the cycle goes on without the CPU */
+    HOST_CHECK(SET == i2c_model_busy());
+    HOST_CHECK_EQ(i2c_model.write_cycles, 1U);
+
+    eeprom_buffer_read(read, 0x40U, AT24_MODEL_PAGE_SIZE);
+    HOST_CHECK(0 == memcmp(read, data, sizeof(data)));
+    HOST_CHECK(0U != i2c_model.busy_polls);
+    /* the read starts within a poll of the end of the write cycle */
+    late = i2c_model.first_access - i2c_model.last_write_end;
+    HOST_CHECK(late >= i2c_model.write_cycle);
+    HOST_CHECK(late < i2c_model.write_cycle + I2C_MODEL_US(500U));
+    printf("read %u us after the page write, %u address polls\n",
+           (unsigned)(late / 1000U), (unsigned)i2c_model.busy_polls);
+
+    /* no write cycle pending, no poll */
+    i2c_model.busy_polls = 0U;
+    eeprom_buffer_read(read, 0x40U, AT24_MODEL_PAGE_SIZE);
+    HOST_CHECK_EQ(i2c_model.busy_polls, 0U);
+    check_bus();
+}
+
+/*!
+    \brief      byte writes through the cache are merged into page writes
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_coalesce(void)
+{
+    uint8_t data[2U * AT24_MODEL_PAGE_SIZE];
+    uint64_t cached_clocks, cached_time, direct_clocks, direct_time;
+    uint32_t i;
+
+    for(i = 0U; i < sizeof(data); i++) {
+        data[i] = (uint8_t)(0x5AU ^ i);
+    }
+
+    eeprom_start(0xFFU);
+    for(i = 0U; i < sizeof(data); i++) {
+        eeprom_cache_write(&data[i], 0x80U + i, 1U);
+    }
+    /* nothing is sent before the flush */
+    HOST_CHECK_EQ(i2c_model.write_cycles, 0U);
+    HOST_CHECK_EQ(i2c_model.starts, 0U);
+    eeprom_cache_flush();
+    eeprom_wait_standby_state();
+    HOST_CHECK_EQ(i2c_model.write_cycles, 2U);
+    HOST_CHECK_EQ(i2c_model.bytes_programmed, sizeof(data));
+    HOST_CHECK(0 == memcmp(&i2c_model.array[0x80], data, sizeof(data)));
+    cached_clocks = i2c_model.bus_clocks;
+    cached_time = i2c_model_now();
+
+    eeprom_start(0xFFU);
+    for(i = 0U; i < sizeof(data); i++) {
+        eeprom_buffer_write(&data[i], 0x80U + i, 1U);
+    }
+    eeprom_wait_standby_state();
+    HOST_CHECK_EQ(i2c_model.write_cycles, sizeof(data));
+    HOST_CHECK(0 == memcmp(&i2c_model.array[0x80], data, sizeof(data)));
+    direct_clocks = i2c_model.bus_clocks;
+    direct_time = i2c_model_now();
+
+    printf("16 byte writes: cached %u SCL in %u us, direct %u SCL in %u us\n",
+           (unsigned)cached_clocks, (unsigned)(cached_time / 1000U),
+           (unsigned)direct_clocks, (unsigned)(direct_time / 1000U));
+    HOST_CHECK(cached_clocks * 4U < direct_clocks);
+    HOST_CHECK(cached_time * 4U < direct_time);
+    check_bus();
+}
+
+/*!
+    \brief      the oldest line is flushed when a page misses, the clean bytes of a
+                partly written page are read before the page write
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_replacement(void)
+{
+    uint8_t byte, read[AT24_MODEL_PAGE_SIZE];
+    uint32_t i, reads;
+
+    eeprom_start(0x00U);
+    for(i = 0U; i < AT24_MODEL_SIZE; i++) {
+        i2c_model.array[i] = (uint8_t)i;
+    }
+
+    /* pages 0 to 3 fill the lines, page 0 is used again, page 4 replaces page 1 */
+    for(i = 0U; i < EEPROM_CACHE_LINE_NUM; i++) {
+        byte = (uint8_t)(0xA0U + i);
+        eeprom_cache_write(&byte, (uint8_t)(i * AT24_MODEL_PAGE_SIZE), 1U);
+    }
+    byte = 0xB0U;
+    eeprom_cache_write(&byte, 1U, 1U);
+    HOST_CHECK_EQ(i2c_model.write_cycles, 0U);
+    byte = 0xA4U;
+    eeprom_cache_write(&byte, (uint8_t)(EEPROM_CACHE_LINE_NUM * AT24_MODEL_PAGE_SIZE), 1U);
+    eeprom_wait_standby_state();
+    HOST_CHECK_EQ(i2c_model.write_cycles, 1U);
+    HOST_CHECK_EQ(i2c_model.array[0], 0x00U);
+    HOST_CHECK_EQ(i2c_model.array[AT24_MODEL_PAGE_SIZE], 0xA1U);
+
+    /* the cached bytes are read from the cache, the others from the EEPROM */
+    eeprom_cache_read(read, 0U, AT24_MODEL_PAGE_SIZE);
+    HOST_CHECK_EQ(read[0], 0xA0U);
+    HOST_CHECK_EQ(read[1], 0xB0U);
+    HOST_CHECK_EQ(read[2], 2U);
+
+    /* bytes 0 and 1 of page 0 are dirty, bytes 2 to 7 are valid, the page write
+       takes the two dirty bytes only */
+    eeprom_cache_flush();
+    eeprom_wait_standby_state();
+    HOST_CHECK_EQ(i2c_model.array[0], 0xA0U);
+    HOST_CHECK_EQ(i2c_model.array[1], 0xB0U);
+    HOST_CHECK_EQ(i2c_model.array[2], 2U);
+
+    /* a hole between the dirty bytes is read before the page write */
+    eeprom_start(0x00U);
+    for(i = 0U; i < AT24_MODEL_SIZE; i++) {
+        i2c_model.array[i] = (uint8_t)~i;
+    }
+    byte = 0x11U;
+    eeprom_cache_write(&byte, 0x30U, 1U);
+    byte = 0x77U;
+    eeprom_cache_write(&byte, 0x37U, 1U);
+    reads = i2c_model.byte_reads;
+    eeprom_cache_flush();
+    eeprom_wait_standby_state();
+    HOST_CHECK_EQ(i2c_model.byte_reads - reads, AT24_MODEL_PAGE_SIZE);
+    HOST_CHECK_EQ(i2c_model.write_cycles, 1U);
+    HOST_CHECK_EQ(i2c_model.bytes_programmed, AT24_MODEL_PAGE_SIZE);
+    HOST_CHECK_EQ(i2c_model.array[0x30], 0x11U);
+    HOST_CHECK_EQ(i2c_model.array[0x37], 0x77U);
+    for(i = 0x31U; i < 0x37U; i++) {
+        HOST_CHECK_EQ(i2c_model.array[i], (uint8_t)~i);
+    }
+    check_bus();
+}
+
+/*!
+    \brief      the dirty pages are written once no cached write happened for
+                EEPROM_CACHE_FLUSH_MS milliseconds
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_timer(void)
+{
+    uint8_t data[3] = {0x12U, 0x34U, 0x56U};
+    uint64_t written, flushed;
+
+    eeprom_start(0xFFU);
+    eeprom_cache_write(data, 0x21U, sizeof(data));
+    written = i2c_model_now();
+
+    while(i2c_model_now() < written + I2C_MODEL_US(EEPROM_CACHE_FLUSH_MS * 1000U / 2U)) {
+        eeprom_cache_poll();
+    }
+    HOST_CHECK_EQ(i2c_model.write_cycles, 0U);
+    /* a write restarts the timer */
+    eeprom_cache_write(data, 0x21U, sizeof(data));
+    written = i2c_model_now();
+
+    while((0U == i2c_model.write_cycles) && (i2c_model_now() < written + I2C_MODEL_US(1000000U))) {
+        eeprom_cache_poll();
+    }
+    HOST_CHECK_EQ(i2c_model.write_cycles, 1U);
+    flushed = i2c_model.last_write_end;
+    HOST_CHECK(flushed >= written + I2C_MODEL_US((EEPROM_CACHE_FLUSH_MS - 1U) * 1000U));
+    HOST_CHECK(flushed < written + I2C_MODEL_US((EEPROM_CACHE_FLUSH_MS + 3U) * 1000U));
+    HOST_CHECK(0 == memcmp(&i2c_model.array[0x21], data, sizeof(data)));
+
+    /* nothing dirty, nothing written */
+    written = i2c_model_now();
+    while(i2c_model_now() < written + I2C_MODEL_US(10000U)) {
+        eeprom_cache_poll();
+    }
+    HOST_CHECK_EQ(i2c_model.write_cycles, 1U);
+    check_bus();
+}
+
+/*!
+    \brief      random cached and direct writes and reads against a reference copy
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_coherency(void)
+{
+    uint8_t data[16], read[AT24_MODEL_SIZE];
+    uint32_t i, operation, address, number, mismatches = 0U, writes = 0U;
+
+    srand(7U);
+    eeprom_start(0x00U);
+    for(i = 0U; i < AT24_MODEL_SIZE; i++) {
+        i2c_model.array[i] = (uint8_t)rand();
+        reference[i] = i2c_model.array[i];
+    }
+
+    for(operation = 0U; operation < TEST_OPERATIONS; operation++) {
+        address = (uint32_t)rand() % AT24_MODEL_SIZE;
+        number = 1U + (uint32_t)rand() % sizeof(data);
+        if(address + number > AT24_MODEL_SIZE) {
+            number = AT24_MODEL_SIZE - address;
+        }
+        for(i = 0U; i < number; i++) {
+            data[i] = (uint8_t)rand();
+        }
+
+        switch(rand() % 8) {
+        case 0:
+        case 1:
+        case 2:
+            eeprom_cache_write(data, (uint8_t)address, (uint16_t)number);
+            memcpy(&reference[address], data, number);
+            writes++;
+            break;
+        case 3:
+            /* a write around the cache updates the cached copy */
+            eeprom_buffer_write(data, (uint8_t)address, (uint16_t)number);
+            memcpy(&reference[address], data, number);
+            writes++;
+            break;
+        case 4:
+        case 5:
+        case 6:
+            eeprom_cache_read(read, (uint8_t)address, (uint16_t)number);
+            if(0 != memcmp(read, &reference[address], number)) {
+                mismatches++;
+            }
+            break;
+        default:
+            eeprom_cache_flush();
+            eeprom_buffer_read(read, 0U, AT24_MODEL_SIZE);
+            if(0 != memcmp(read, reference, AT24_MODEL_SIZE)) {
+                mismatches++;
+            }
+            break;
+        }
+    }
+    eeprom_cache_flush();
+    eeprom_wait_standby_state();
+
+    printf("%u writes, %u page writes\n", (unsigned)writes, (unsigned)i2c_model.write_cycles);
+    HOST_CHECK_EQ(mismatches, 0U);
+    HOST_CHECK(0 == memcmp(i2c_model.array, reference, AT24_MODEL_SIZE));
+    check_bus();
+}
+
+/*!
+    \brief      the tests, the DMA reads into buffers on the stack
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_all(void)
+{
+    test_demo();
+    test_polling();
+    test_coalesce();
+    test_replacement();
+    test_timer();
+    test_coherency();
+}
+
+int main(void)
+{
+    host_low_stack_run(test_all);
+
+    return host_test_result("at24cxx");
+}
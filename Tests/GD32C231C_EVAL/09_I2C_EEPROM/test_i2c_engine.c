@@ -0,0 +1,431 @@
+/*!
+    \file    test_i2c_engine.c
+    \brief   transactions, reload, queue, timeouts and bus errors of i2c_engine.c on the scripted slave
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "host_cmsis.h"
+#include "i2c_model.h"
+#include "i2c_engine.c"
+
+#define TEST_LONG           600U
+#define TEST_QUEUE          4U
+#define TEST_ABSENT         0x10U
+
+static i2c_transaction_struct transaction[TEST_QUEUE + 1U];
+static uint8_t tx_buffer[TEST_LONG];
+static uint8_t rx_buffer[TEST_LONG];
+
+/* completions seen by the callback */
+static i2c_transaction_struct *done[TEST_QUEUE + 1U];
+static uint64_t done_time[TEST_QUEUE + 1U];
+static uint32_t done_count;
+static uint32_t done_outside_isr;
+static uint8_t chain = 0U;
+
+/* i2c.c, the slaves see the stop of the bus reset */
+void i2c_bus_reset(void)
+{
+    i2c_model_bus_clear();
+}
+
+/*!
+    \brief      SysTick of the demo
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void systick(void)
+{
+    i2c_engine_tick();
+}
+
+/*!
+    \brief      record the completion of a transaction
+    \param[in]  t: completed transaction
+    \param[out] none
+    \retval     none
+*/
+static void complete(i2c_transaction_struct *t)
+{
+    if(0U == i2c_model.in_isr) {
+        done_outside_isr++;
+    }
+    if(done_count < TEST_QUEUE + 1U) {
+        done[done_count] = t;
+        done_time[done_count] = i2c_model_now();
+    }
+    done_count++;
+
+    /* a transaction queued from the callback */
+    if((0U != chain) && (&transaction[0] == t)) {
+        chain = 0U;
+        i2c_engine_submit(&transaction[TEST_QUEUE]);
+    }
+}
+
+/*!
+    \brief      restart the model and the engine
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void engine_start(void)
+{
+    i2c_model_init(0xFFU);
+    i2c_model.tick_hook = systick;
+    i2c_enable(I2CX);
+    i2c_engine_init();
+
+    memset(transaction, 0, sizeof(transaction));
+    memset(done, 0, sizeof(done));
+    done_count = 0U;
+    done_outside_isr = 0U;
+}
+
+/*!
+    \brief      fill a transaction descriptor
+    \param[in]  t: transaction
+    \param[in]  address: device address
+    \param[in]  reg_number: 0 or 2 bytes of register address
+    \param[in]  reg: register address
+    \param[in]  write_number: bytes of tx_buffer to write
+    \param[in]  read_number: bytes to read into rx_buffer
+    \param[out] none
+    \retval     none
+*/
+static void transaction_set(i2c_transaction_struct *t, uint8_t address, uint8_t reg_number, uint16_t reg,
+                            uint16_t write_number, uint16_t read_number)
+{
+    memset(t, 0, sizeof(*t));
+    t->address = address;
+    t->reg[0] = (uint8_t)(reg >> 8);
+    t->reg[1] = (uint8_t)reg;
+    t->reg_number = reg_number;
+    t->write_buffer = tx_buffer;
+    t->write_number = write_number;
+    t->read_buffer = rx_buffer;
+    t->read_number = read_number;
+    t->timeout = 50U;
+    t->callback = complete;
+}
+
+/*!
+    \brief      run one transaction
+    \param[in]  t: transaction
+    \param[out] none
+    \retval     status of the transaction
+*/
+static i2c_transaction_status_enum transaction_run(i2c_transaction_struct *t)
+{
+    HOST_CHECK(SUCCESS == i2c_engine_submit(t));
+    return i2c_engine_wait(t);
+}
+
+/*!
+    \brief      check the master and the bus once the engine is idle
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void check_bus(void)
+{
+    HOST_CHECK(NULL == i2c_engine_active);
+    HOST_CHECK(NULL == i2c_engine_head);
+    HOST_CHECK_EQ(I2C_STAT(I2CX) & I2C_STAT_I2CBSY, 0U);
+    HOST_CHECK_EQ(I2C_CTL0(I2CX) & (I2C_CTL0_TIE | I2C_CTL0_RBNEIE | I2C_CTL0_DENT | I2C_CTL0_DENR), 0U);
+    HOST_CHECK_EQ(i2c_model.tdata_overruns, 0U);
+    HOST_CHECK_EQ(i2c_model.rdata_underruns, 0U);
+    HOST_CHECK_EQ(i2c_model.start_errors, 0U);
+    HOST_CHECK_EQ(i2c_model.reload_errors, 0U);
+    HOST_CHECK_EQ(i2c_model.ti_errors, 0U);
+    HOST_CHECK_EQ(done_outside_isr, 0U);
+}
+
+/*!
+    \brief      address only transactions probe the devices
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_probe(void)
+{
+    engine_start();
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 0U, 0U, 0U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    transaction_set(&transaction[0], TEST_ABSENT, 0U, 0U, 0U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_NACK);
+    HOST_CHECK_EQ(i2c_model.starts, 2U);
+    HOST_CHECK_EQ(i2c_model.stops, 2U);
+    HOST_CHECK_EQ(done_count, 2U);
+    check_bus();
+}
+
+/*!
+    \brief      phases longer than 255 bytes are reloaded at TCR, the data goes by DMA
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_long(void)
+{
+    uint32_t i, dma;
+
+    engine_start();
+    for(i = 0U; i < TEST_LONG; i++) {
+        tx_buffer[i] = (uint8_t)(i * 7U + 3U);
+    }
+
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0123U, TEST_LONG, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(i2c_model.script.bytes_written, TEST_LONG);
+    for(i = 0U; i < TEST_LONG; i++) {
+        HOST_CHECK_EQ(i2c_model.script.memory[(0x0123U + i) % SCRIPT_MODEL_SIZE], tx_buffer[i]);
+    }
+    /* 602 bytes are loaded as 255, 255 and 92 */
+    HOST_CHECK_EQ(i2c_model.reloads, 2U);
+    HOST_CHECK_EQ(i2c_model.dma_bytes, TEST_LONG);
+
+    /* register address, restart, 600 bytes read */
+    dma = i2c_model.dma_bytes;
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0123U, 0U, TEST_LONG);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    HOST_CHECK(0 == memcmp(rx_buffer, tx_buffer, TEST_LONG));
+    HOST_CHECK_EQ(i2c_model.reloads, 4U);
+    HOST_CHECK_EQ(i2c_model.dma_bytes - dma, TEST_LONG);
+    HOST_CHECK_EQ(i2c_model.starts, 3U);
+    HOST_CHECK_EQ(i2c_model.stops, 2U);
+    check_bus();
+}
+
+/*!
+    \brief      short phases are moved by the TI and RBNE interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_short(void)
+{
+    engine_start();
+    tx_buffer[0] = 0x5AU;
+    tx_buffer[1] = 0xA5U;
+    tx_buffer[2] = 0x3CU;
+
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0200U, 3U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(i2c_model.script.memory[0x200], 0x5AU);
+    HOST_CHECK_EQ(i2c_model.script.memory[0x202], 0x3CU);
+
+    /* a read without register address continues at the register pointer */
+    i2c_model.script.pointer = 0x201U;
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 0U, 0U, 0U, 2U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(rx_buffer[0], 0xA5U);
+    HOST_CHECK_EQ(rx_buffer[1], 0x3CU);
+    HOST_CHECK_EQ(i2c_model.dma_bytes, 0U);
+    HOST_CHECK_EQ(i2c_model.starts, 2U);
+    check_bus();
+}
+
+/*!
+    \brief      a byte not acknowledged ends the transaction with a stop
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_nack(void)
+{
+    engine_start();
+
+    /* the fourth byte after the address is the second data byte, DMA phase */
+    i2c_model.script.nack_byte = 4U;
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 16U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_NACK);
+    HOST_CHECK_EQ(i2c_model.script.bytes_written, 1U);
+    HOST_CHECK_EQ(i2c_model.stops, 1U);
+    check_bus();
+
+    /* the address of the write phase is not acknowledged, the read phase is not started */
+    i2c_model.script.nack_address = 1U;
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 0U, 8U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_NACK);
+    HOST_CHECK_EQ(i2c_model.starts, 2U);
+    HOST_CHECK_EQ(i2c_model.stops, 2U);
+
+    /* the bus works again */
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 8U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    check_bus();
+}
+
+/*!
+    \brief      a slave holding SCL is released by the SysTick timeout
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_timeout(void)
+{
+    uint64_t submitted, elapsed;
+
+    engine_start();
+    i2c_model.script.hang_byte = 3U;
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 8U, 0U);
+    transaction[0].timeout = 5U;
+    submitted = i2c_model_now();
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_TIMEOUT);
+    elapsed = done_time[0] - submitted;
+    printf("timeout of 5 ms after %u us\n", (unsigned)(elapsed / 1000U));
+    HOST_CHECK(elapsed >= I2C_MODEL_US(5000U));
+    HOST_CHECK(elapsed <= I2C_MODEL_US(7000U));
+    HOST_CHECK_EQ(i2c_model.bus_resets, 1U);
+    HOST_CHECK(0U != (I2C_CTL0(I2CX) & I2C_CTL0_I2CEN));
+
+    /* the default timeout of a transaction on a free bus never fires */
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 8U, 0U);
+    transaction[0].timeout = 0U;
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(i2c_model.bus_resets, 1U);
+    check_bus();
+}
+
+/*!
+    \brief      arbitration loss and bus error end the transaction from the error interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_error(void)
+{
+    engine_start();
+
+    i2c_model.script.error_byte = 2U;
+    i2c_model.script.error_flag = I2C_STAT_LOSTARB;
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 8U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_ERROR);
+    HOST_CHECK_EQ(i2c_model.er_irqs, 1U);
+
+    /* a bus error while the read phase is moved by DMA */
+    i2c_model.script.error_byte = 6U;
+    i2c_model.script.error_flag = I2C_STAT_BERR;
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 0U, 0x0000U, 0U, 8U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_ERROR);
+    HOST_CHECK_EQ(i2c_model.er_irqs, 2U);
+    HOST_CHECK_EQ(I2C_STAT(I2CX) & (I2C_STAT_BERR | I2C_STAT_LOSTARB), 0U);
+
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0000U, 8U, 0U);
+    HOST_CHECK_EQ(transaction_run(&transaction[0]), I2C_TRANSACTION_DONE);
+    check_bus();
+}
+
+/*!
+    \brief      transactions submitted together run in order, one submitted by a callback
+                runs before the queued ones
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_queue(void)
+{
+    uint32_t i;
+
+    engine_start();
+    for(i = 0U; i < 8U; i++) {
+        tx_buffer[i] = (uint8_t)(0xC0U + i);
+    }
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, 2U, 0x0300U, 8U, 0U);
+    transaction_set(&transaction[1], TEST_ABSENT, 0U, 0U, 0U, 0U);
+    transaction_set(&transaction[2], SCRIPT_MODEL_ADDRESS, 2U, 0x0300U, 0U, 8U);
+    transaction_set(&transaction[3], SCRIPT_MODEL_ADDRESS, 0U, 0U, 0U, 0U);
+    transaction_set(&transaction[TEST_QUEUE], SCRIPT_MODEL_ADDRESS, 2U, 0x0304U, 0U, 1U);
+    transaction[TEST_QUEUE].read_buffer = &rx_buffer[16];
+    chain = 1U;
+
+    /* the first one starts at once, the others wait in the queue */
+    for(i = 0U; i < TEST_QUEUE; i++) {
+        HOST_CHECK(SUCCESS == i2c_engine_submit(&transaction[i]));
+    }
+    HOST_CHECK_EQ(transaction[1].status, I2C_TRANSACTION_QUEUED);
+    HOST_CHECK_EQ(transaction[3].status, I2C_TRANSACTION_QUEUED);
+    i2c_engine_wait(&transaction[TEST_QUEUE - 1U]);
+
+    HOST_CHECK_EQ(done_count, TEST_QUEUE + 1U);
+    HOST_CHECK(&transaction[0] == done[0]);
+    HOST_CHECK(&transaction[TEST_QUEUE] == done[1]);
+    for(i = 1U; i < TEST_QUEUE; i++) {
+        HOST_CHECK(&transaction[i] == done[i + 1U]);
+    }
+    HOST_CHECK_EQ(transaction[0].status, I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(transaction[1].status, I2C_TRANSACTION_NACK);
+    HOST_CHECK_EQ(transaction[2].status, I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(transaction[3].status, I2C_TRANSACTION_DONE);
+    HOST_CHECK_EQ(transaction[TEST_QUEUE].status, I2C_TRANSACTION_DONE);
+    HOST_CHECK(0 == memcmp(rx_buffer, tx_buffer, 8U));
+    HOST_CHECK_EQ(rx_buffer[16], 0xC4U);
+    check_bus();
+}
+
+/*!
+    \brief      invalid descriptors are refused
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_invalid(void)
+{
+    engine_start();
+    HOST_CHECK(ERROR == i2c_engine_submit(NULL));
+    transaction_set(&transaction[0], SCRIPT_MODEL_ADDRESS, I2C_ENGINE_REG_SIZE + 1U, 0U, 0U, 0U);
+    HOST_CHECK(ERROR == i2c_engine_submit(&transaction[0]));
+    HOST_CHECK_EQ(i2c_model.starts, 0U);
+    check_bus();
+}
+
+int main(void)
+{
+    test_probe();
+    test_long();
+    test_short();
+    test_nack();
+    test_timeout();
+    test_error();
+    test_queue();
+    test_invalid();
+
+    return host_test_result("i2c_engine");
+}
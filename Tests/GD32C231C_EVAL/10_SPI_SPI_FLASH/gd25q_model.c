@@ -0,0 +1,740 @@
+/*!
+    \file    gd25q_model.c
+    \brief   GD25Q16 model behind the SPI1 and DMA functions used by gd25qxx.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include "gd25q_model.h"
+#include "gd25qxx.h"
+
+#define OP_WRSR             0x01U
+#define OP_PP               0x02U
+#define OP_READ             0x03U
+#define OP_RDSR             0x05U
+#define OP_WREN             0x06U
+#define OP_FAST_READ        0x0BU
+#define OP_SE               0x20U
+#define OP_QPP              0x32U
+#define OP_RDSR2            0x35U
+#define OP_QREAD            0x6BU
+#define OP_RDID             0x9FU
+#define OP_BE               0xC7U
+
+#define MODEL_DMA_CHANNELS  4U
+
+typedef struct {
+    uint32_t memory;
+    uint32_t number;
+    uint8_t memory_inc;
+    uint8_t direction;
+    uint32_t request;
+    uint8_t enabled;
+    FlagStatus ftf;
+    FlagStatus err;
+} model_dma_struct;
+
+gd25q_model_struct gd25q_model;
+
+/* bus state */
+static FlagStatus model_cs = SET;
+static uint8_t model_rx;
+static FlagStatus model_rbne = RESET;
+static uint8_t model_quad = 0U;
+/* bit n is SET while the SPI DMA request n is enabled */
+static uint8_t model_spi_dma = 0U;
+static model_dma_struct model_dma[MODEL_DMA_CHANNELS];
+static volatile uint8_t model_irq_pending = 0U;
+
+/* chip select period being decoded */
+static gd25q_model_transaction_struct model_tr;
+static uint32_t model_index;
+static uint32_t model_dummy_clocks;
+static uint8_t model_sr[2];
+static uint8_t model_latch[GD25Q_MODEL_PAGE_SIZE];
+static uint8_t model_latch_valid[GD25Q_MODEL_PAGE_SIZE];
+
+/* SET while a stub changes the model, the timer leaves the driver alone then */
+static volatile uint32_t model_lock = 0U;
+static volatile uint32_t model_ticks = 0U;
+static uint8_t model_timer_started = 0U;
+
+/*!
+    \brief      model time, bus cycles and timer ticks
+    \param[in]  none
+    \param[out] none
+    \retval     APB cycles since the model was initialized
+*/
+uint64_t gd25q_model_now(void)
+{
+    return gd25q_model.bus_cycles + (uint64_t)model_ticks * GD25Q_MODEL_TICK;
+}
+
+/*!
+    \brief      SET while the chip executes a program or erase
+    \param[in]  none
+    \param[out] none
+    \retval     FlagStatus: SET or RESET
+*/
+FlagStatus gd25q_model_busy(void)
+{
+    return (gd25q_model_now() < gd25q_model.busy_until) ? SET : RESET;
+}
+
+/*!
+    \brief      chip select level
+    \param[in]  none
+    \param[out] none
+    \retval     FlagStatus: SET when the chip is deselected
+*/
+FlagStatus gd25q_model_cs(void)
+{
+    return model_cs;
+}
+
+/*!
+    \brief      start a program or erase, the chip is busy for a latency
+    \param[in]  latency: APB cycles
+    \param[out] none
+    \retval     none
+*/
+static void model_busy_start(uint64_t latency)
+{
+    gd25q_model.busy_until = gd25q_model_now() + latency;
+    gd25q_model.wel = 0U;
+}
+
+/*!
+    \brief      execute the instruction of the chip select period which ends
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_execute(void)
+{
+    uint32_t i, addr;
+
+    if((0U == model_index) || (SET == model_tr.busy)) {
+        return;
+    }
+
+    switch(model_tr.opcode) {
+    case OP_PP:
+    case OP_QPP:
+        if(model_index < 4U) {
+            break;
+        }
+        if(0U == gd25q_model.wel) {
+            gd25q_model.wel_violations++;
+            break;
+        }
+        if((OP_QPP == model_tr.opcode) && (0U == gd25q_model.qe)) {
+            gd25q_model.qe_violations++;
+            break;
+        }
+        /* a program can only clear bits */
+        addr = model_tr.addr & ~(GD25Q_MODEL_PAGE_SIZE - 1U);
+        for(i = 0U; i < GD25Q_MODEL_PAGE_SIZE; i++) {
+            if(0U != model_latch_valid[i]) {
+                if(0U != (model_latch[i] & (uint8_t)~gd25q_model.array[addr + i])) {
+                    gd25q_model.program_ones++;
+                }
+                gd25q_model.array[addr + i] &= model_latch[i];
+            }
+        }
+        gd25q_model.programs++;
+        model_busy_start(gd25q_model.program_latency);
+        break;
+    case OP_SE:
+        if(model_index < 4U) {
+            break;
+        }
+        if(0U == gd25q_model.wel) {
+            gd25q_model.wel_violations++;
+            break;
+        }
+        addr = model_tr.addr & ~(GD25Q_MODEL_SECTOR_SIZE - 1U);
+        memset(&gd25q_model.array[addr], 0xFF, GD25Q_MODEL_SECTOR_SIZE);
+        gd25q_model.erases++;
+        gd25q_model.sector_erases[addr / GD25Q_MODEL_SECTOR_SIZE]++;
+        model_busy_start(gd25q_model.erase_latency);
+        break;
+    case OP_BE:
+        if(0U == gd25q_model.wel) {
+            gd25q_model.wel_violations++;
+            break;
+        }
+        memset(gd25q_model.array, 0xFF, GD25Q_MODEL_SIZE);
+        gd25q_model.erases++;
+        model_busy_start(gd25q_model.chip_erase_latency);
+        break;
+    case OP_WRSR:
+        if(model_index < 2U) {
+            break;
+        }
+        if(0U == gd25q_model.wel) {
+            gd25q_model.wel_violations++;
+            break;
+        }
+        if(model_index >= 3U) {
+            gd25q_model.qe = (model_sr[1] >> 1) & 1U;
+        }
+        model_busy_start(gd25q_model.status_latency);
+        break;
+    default:
+        break;
+    }
+}
+
+/*!
+    \brief      clock one byte between the SPI and the chip
+    \param[in]  mosi: byte sent by the SPI
+    \param[out] none
+    \retval     byte sent by the chip
+*/
+static uint8_t model_byte(uint8_t mosi)
+{
+    uint32_t psc = (SPI_CTL0(SPI1) & SPI_CTL0_PSC) >> 3;
+    uint32_t clocks = (0U != model_quad) ? 2U : 8U;
+    uint32_t cycles = clocks * (2U << psc);
+    uint32_t data_index;
+    uint8_t miso = 0xFFU;
+
+    gd25q_model.bus_cycles += cycles;
+    if(SET == model_cs) {
+        return miso;
+    }
+    model_tr.bytes++;
+    model_tr.cycles += cycles;
+    model_tr.psc = SPI_CTL0(SPI1) & SPI_CTL0_PSC;
+
+    if(0U == model_index) {
+        model_index = 1U;
+        model_tr.opcode = mosi;
+        if((SET == gd25q_model_busy()) && (OP_RDSR != mosi) && (OP_RDSR2 != mosi)) {
+            /* the chip ignores the instruction */
+            gd25q_model.busy_violations++;
+            model_tr.busy = SET;
+        } else if(OP_WREN == mosi) {
+            gd25q_model.wel = 1U;
+        }
+        return miso;
+    }
+    model_index++;
+    if(SET == model_tr.busy) {
+        return miso;
+    }
+
+    switch(model_tr.opcode) {
+    case OP_RDSR:
+        model_tr.data++;
+        miso = (uint8_t)(((SET == gd25q_model_busy()) ? 1U : 0U) | ((uint32_t)gd25q_model.wel << 1));
+        break;
+    case OP_RDSR2:
+        model_tr.data++;
+        miso = (uint8_t)(gd25q_model.qe << 1);
+        break;
+    case OP_RDID:
+        model_tr.data++;
+        if(model_index <= 4U) {
+            miso = (uint8_t)(GD25Q_MODEL_ID >> (8U * (4U - model_index)));
+        }
+        break;
+    case OP_WRSR:
+        if(model_index <= 3U) {
+            model_sr[model_index - 2U] = mosi;
+        }
+        break;
+    case OP_READ:
+    case OP_FAST_READ:
+    case OP_QREAD:
+    case OP_PP:
+    case OP_QPP:
+    case OP_SE:
+        if(model_index <= 4U) {
+            /* the 24-bit address, msb first */
+            model_tr.addr = ((model_tr.addr << 8) | mosi) & (GD25Q_MODEL_SIZE - 1U);
+            break;
+        }
+        data_index = model_index - 5U;
+        if(OP_FAST_READ == model_tr.opcode) {
+            /* one dummy byte */
+            if(0U == data_index) {
+                break;
+            }
+            data_index--;
+        } else if(OP_QREAD == model_tr.opcode) {
+            /* eight dummy clocks, the data comes on four lines */
+            if(model_dummy_clocks < 8U) {
+                model_dummy_clocks += clocks;
+                break;
+            }
+            if((0U == model_quad) || (0U == gd25q_model.qe)) {
+                gd25q_model.qe_violations++;
+            }
+            data_index = model_tr.data;
+        }
+        if((OP_PP == model_tr.opcode) || (OP_QPP == model_tr.opcode)) {
+            /* the page address wraps, the chip keeps the last bytes of the page */
+            uint32_t offset = (model_tr.addr + data_index) & (GD25Q_MODEL_PAGE_SIZE - 1U);
+            if((OP_QPP == model_tr.opcode) && (0U == model_quad)) {
+                gd25q_model.qe_violations++;
+            }
+            model_latch[offset] = mosi;
+            model_latch_valid[offset] = 1U;
+        } else if(OP_SE != model_tr.opcode) {
+            miso = gd25q_model.array[(model_tr.addr + data_index) & (GD25Q_MODEL_SIZE - 1U)];
+        }
+        model_tr.data++;
+        break;
+    default:
+        break;
+    }
+    return miso;
+}
+
+/*!
+    \brief      drive the chip select
+    \param[in]  level: SET to deselect the chip
+    \param[out] none
+    \retval     none
+*/
+static void model_cs_set(FlagStatus level)
+{
+    if(level == model_cs) {
+        return;
+    }
+    model_cs = level;
+    if(RESET == level) {
+        memset(&model_tr, 0, sizeof(model_tr));
+        memset(model_latch_valid, 0, sizeof(model_latch_valid));
+        model_index = 0U;
+        model_dummy_clocks = 0U;
+        return;
+    }
+
+    model_execute();
+    if(0U != model_index) {
+        gd25q_model.log[gd25q_model.log_count % GD25Q_MODEL_LOG_NUM] = model_tr;
+        gd25q_model.log_count++;
+    }
+}
+
+/*!
+    \brief      the host timer: a tick of model time, then the DMA interrupt and the tick hook
+    \param[in]  sig: signal number
+    \param[out] none
+    \retval     none
+*/
+static void model_timer(int sig)
+{
+    (void)sig;
+    model_ticks++;
+    if(0U != model_lock) {
+        return;
+    }
+    gd25q_model.in_isr = 1U;
+    if(0U != model_irq_pending) {
+        model_irq_pending = 0U;
+        gd25q_model.dma_irqs++;
+        spi_flash_dma_irq_handler();
+    }
+    if(NULL != gd25q_model.tick_hook) {
+        gd25q_model.tick_hook();
+    }
+    gd25q_model.in_isr = 0U;
+}
+
+/*!
+    \brief      erase the array, clear the counters and start the timer which raises the DMA interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gd25q_model_init(void)
+{
+    struct itimerval tick = {{0, 100}, {0, 100}};
+
+    model_lock++;
+    memset(&gd25q_model, 0, sizeof(gd25q_model));
+    memset(gd25q_model.array, 0xFF, sizeof(gd25q_model.array));
+    memset(model_dma, 0, sizeof(model_dma));
+    gd25q_model.program_latency = GD25Q_MODEL_US(600U);
+    gd25q_model.erase_latency = GD25Q_MODEL_US(50000U);
+    gd25q_model.chip_erase_latency = GD25Q_MODEL_US(1000000U);
+    gd25q_model.status_latency = GD25Q_MODEL_US(5000U);
+    model_cs = SET;
+    model_rbne = RESET;
+    model_quad = 0U;
+    model_spi_dma = 0U;
+    model_irq_pending = 0U;
+    model_ticks = 0U;
+    model_lock--;
+
+    if(0U == model_timer_started) {
+        model_timer_started = 1U;
+        signal(SIGALRM, model_timer);
+        setitimer(ITIMER_REAL, &tick, NULL);
+    }
+}
+
+/*!
+    \brief      forget the logged chip select periods
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void gd25q_model_log_clear(void)
+{
+    gd25q_model.log_count = 0U;
+}
+
+/*!
+    \brief      logged chip select period
+    \param[in]  index: 0 is the oldest period kept
+    \param[out] none
+    \retval     the period, NULL if there is none at the index
+*/
+const gd25q_model_transaction_struct *gd25q_model_log(uint32_t index)
+{
+    uint32_t first = 0U;
+
+    if(gd25q_model.log_count > GD25Q_MODEL_LOG_NUM) {
+        first = gd25q_model.log_count - GD25Q_MODEL_LOG_NUM;
+    }
+    if(first + index >= gd25q_model.log_count) {
+        return NULL;
+    }
+    return &gd25q_model.log[(first + index) % GD25Q_MODEL_LOG_NUM];
+}
+
+/*!
+    \brief      number of logged chip select periods with an opcode
+    \param[in]  opcode: the instruction
+    \param[out] none
+    \retval     number of periods
+*/
+uint32_t gd25q_model_log_opcodes(uint8_t opcode)
+{
+    const gd25q_model_transaction_struct *tr;
+    uint32_t i, count = 0U;
+
+    for(i = 0U; NULL != (tr = gd25q_model_log(i)); i++) {
+        if(opcode == tr->opcode) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/*!
+    \brief      move one DMA block between the memory and the chip
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_run(void)
+{
+    model_dma_struct *rx = &model_dma[SPI_FLASH_DMA_RX_CHANNEL];
+    model_dma_struct *tx = &model_dma[SPI_FLASH_DMA_TX_CHANNEL];
+    const uint8_t *src = (const uint8_t *)(uintptr_t)tx->memory;
+    uint8_t *dst = (uint8_t *)(uintptr_t)rx->memory;
+    uint32_t i, number = tx->number;
+
+    gd25q_model.dma_blocks++;
+    if(0U != gd25q_model.dma_inject_error) {
+        /* the block stops half way */
+        gd25q_model.dma_inject_error = 0U;
+        number /= 2U;
+        rx->err = SET;
+    }
+    for(i = 0U; i < number; i++) {
+        uint8_t miso = model_byte(*src);
+        if((0U != rx->enabled) && (0U != (model_spi_dma & (1U << SPI_DMA_RECEIVE)))) {
+            *dst = miso;
+        }
+        if(0U != tx->memory_inc) {
+            src++;
+        }
+        if(0U != rx->memory_inc) {
+            dst++;
+        }
+    }
+    if(RESET == rx->err) {
+        rx->ftf = SET;
+    }
+    model_irq_pending = 1U;
+}
+
+/* standard peripheral library functions used by the driver */
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void gpio_af_set(uint32_t gpio_periph, uint32_t alt_func_num, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)alt_func_num;
+    (void)pin;
+}
+
+void gpio_mode_set(uint32_t gpio_periph, uint32_t mode, uint32_t pull_up_down, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)mode;
+    (void)pull_up_down;
+    (void)pin;
+}
+
+void gpio_output_options_set(uint32_t gpio_periph, uint8_t otype, uint32_t speed, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)otype;
+    (void)speed;
+    (void)pin;
+}
+
+void gpio_bit_set(uint32_t gpio_periph, uint32_t pin)
+{
+    if((GPIOB == gpio_periph) && (0U != (pin & GPIO_PIN_11))) {
+        model_lock++;
+        model_cs_set(SET);
+        model_lock--;
+    }
+}
+
+void gpio_bit_reset(uint32_t gpio_periph, uint32_t pin)
+{
+    if((GPIOB == gpio_periph) && (0U != (pin & GPIO_PIN_11))) {
+        model_lock++;
+        model_cs_set(RESET);
+        model_lock--;
+    }
+}
+
+FlagStatus gpio_output_bit_get(uint32_t gpio_periph, uint32_t pin)
+{
+    if((GPIOB == gpio_periph) && (0U != (pin & GPIO_PIN_11))) {
+        return model_cs;
+    }
+    return RESET;
+}
+
+ErrStatus spi_init(uint32_t spi_periph, spi_parameter_struct *spi_struct)
+{
+    SPI_CTL0(spi_periph) = spi_struct->prescale;
+    return SUCCESS;
+}
+
+void spi_enable(uint32_t spi_periph)
+{
+    SPI_CTL0(spi_periph) |= SPI_CTL0_SPIEN;
+}
+
+void spi_disable(uint32_t spi_periph)
+{
+    SPI_CTL0(spi_periph) &= ~SPI_CTL0_SPIEN;
+}
+
+void spi_fifo_access_size_config(uint32_t spi_periph, uint16_t fifo_access_size)
+{
+    (void)spi_periph;
+    (void)fifo_access_size;
+}
+
+void spi_crc_polynomial_set(uint32_t spi_periph, uint16_t crc_poly)
+{
+    (void)spi_periph;
+    (void)crc_poly;
+}
+
+void spi_quad_enable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+    model_quad = 1U;
+}
+
+void spi_quad_disable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+    model_quad = 0U;
+}
+
+void spi_quad_write_enable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+}
+
+void spi_quad_read_enable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+}
+
+FlagStatus spi_i2s_flag_get(uint32_t spi_periph, uint32_t flag)
+{
+    (void)spi_periph;
+    if(SPI_FLAG_TBE == flag) {
+        return SET;
+    }
+    if(SPI_FLAG_RBNE == flag) {
+        return model_rbne;
+    }
+    return RESET;
+}
+
+void spi_i2s_data_transmit(uint32_t spi_periph, uint16_t data)
+{
+    (void)spi_periph;
+    model_lock++;
+    if(SET == model_rbne) {
+        gd25q_model.overruns++;
+    }
+    model_rx = model_byte((uint8_t)data);
+    model_rbne = SET;
+    model_lock--;
+}
+
+uint16_t spi_i2s_data_receive(uint32_t spi_periph)
+{
+    (void)spi_periph;
+    model_rbne = RESET;
+    return model_rx;
+}
+
+void spi_dma_enable(uint32_t spi_periph, uint8_t spi_dma)
+{
+    (void)spi_periph;
+    model_spi_dma |= (uint8_t)(1U << spi_dma);
+}
+
+void spi_dma_disable(uint32_t spi_periph, uint8_t spi_dma)
+{
+    (void)spi_periph;
+    model_spi_dma &= (uint8_t)~(1U << spi_dma);
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    memset(&model_dma[channelx], 0, sizeof(model_dma[channelx]));
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    model_dma[channelx].memory = init_struct->memory_addr;
+    model_dma[channelx].number = init_struct->number;
+    model_dma[channelx].memory_inc = (DMA_MEMORY_INCREASE_ENABLE == init_struct->memory_inc) ? 1U : 0U;
+    model_dma[channelx].direction = init_struct->direction;
+    model_dma[channelx].request = init_struct->request;
+}
+
+void dma_circulation_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    (void)source;
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq;
+    (void)nvic_irq_priority;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    if(DMA_INT_FLAG_ERR == int_flag) {
+        return model_dma[channelx].err;
+    }
+    if(DMA_INT_FLAG_FTF == int_flag) {
+        return model_dma[channelx].ftf;
+    }
+    return RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)int_flag;
+    model_dma[channelx].ftf = RESET;
+    model_dma[channelx].err = RESET;
+}
+
+void dma_memory_address_config(dma_channel_enum channelx, uint32_t address)
+{
+    model_dma[channelx].memory = address;
+}
+
+void dma_transfer_number_config(dma_channel_enum channelx, uint32_t number)
+{
+    model_dma[channelx].number = number;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    model_lock++;
+    model_dma[channelx].enabled = 1U;
+    if(DMA_REQUEST_SPI1_TX == model_dma[channelx].request) {
+        /* the transmit requests clock the bytes, a receive channel enabled later misses them */
+        if(0U == model_dma[SPI_FLASH_DMA_RX_CHANNEL].enabled) {
+            gd25q_model.dma_order_errors++;
+        }
+        if(0U != (model_spi_dma & (1U << SPI_DMA_TRANSMIT))) {
+            model_dma_run();
+        }
+    }
+    model_lock--;
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    model_dma[channelx].enabled = 0U;
+}
@@ -0,0 +1,114 @@
+/*!
+    \file    gd25q_model.h
+    \brief   GD25Q16 model behind the SPI1 and DMA functions used by gd25qxx.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef GD25Q_MODEL_H
+#define GD25Q_MODEL_H
+
+#include "gd32c2x1.h"
+
+#define GD25Q_MODEL_SIZE            0x200000U
+#define GD25Q_MODEL_SECTOR_SIZE     0x1000U
+#define GD25Q_MODEL_PAGE_SIZE       0x100U
+#define GD25Q_MODEL_ID              0xC84015U
+
+/* the model clock counts the cycles of the 48 MHz APB clock */
+#define GD25Q_MODEL_US(us)          ((uint64_t)(us) * 48U)
+/* model time which passes at each host timer tick, as a 1 ms SysTick */
+#define GD25Q_MODEL_TICK            GD25Q_MODEL_US(1000U)
+
+#define GD25Q_MODEL_LOG_NUM         512U
+
+/* one chip select low period */
+typedef struct {
+    uint8_t opcode;
+    uint32_t addr;           /* address of the instructions which carry one */
+    uint32_t data;           /* bytes after the instruction, address and dummy bytes */
+    uint32_t bytes;          /* every byte clocked */
+    uint32_t cycles;         /* APB cycles on the bus */
+    uint32_t psc;            /* prescaler of the last byte */
+    FlagStatus busy;         /* issued while a program or erase was running */
+} gd25q_model_transaction_struct;
+
+typedef struct {
+    /* memory array and status */
+    uint8_t array[GD25Q_MODEL_SIZE];
+    uint8_t wel;
+    uint8_t qe;
+    uint64_t busy_until;
+    /* latencies in APB cycles */
+    uint64_t program_latency;
+    uint64_t erase_latency;
+    uint64_t chip_erase_latency;
+    uint64_t status_latency;
+    /* time, bus and DMA counters */
+    uint64_t bus_cycles;
+    uint32_t programs;
+    uint32_t erases;
+    uint32_t sector_erases[GD25Q_MODEL_SIZE / GD25Q_MODEL_SECTOR_SIZE];
+    uint32_t dma_blocks;
+    uint32_t dma_irqs;
+    /* sequencing errors, all of them must stay zero */
+    uint32_t busy_violations;    /* instruction other than RDSR while WIP is set */
+    uint32_t wel_violations;     /* program or erase without WREN */
+    uint32_t qe_violations;      /* quad instruction without the QE bit */
+    uint32_t overruns;           /* byte sent before the previous one was read */
+    uint32_t dma_order_errors;   /* transmit channel enabled before the receive one */
+    uint32_t program_ones;       /* program which would have to set cleared bits */
+    /* chip select periods, the latest GD25Q_MODEL_LOG_NUM of them */
+    gd25q_model_transaction_struct log[GD25Q_MODEL_LOG_NUM];
+    uint32_t log_count;
+    /* test controls */
+    uint8_t dma_inject_error;
+    void (*tick_hook)(void);     /* called at each host timer tick, after the DMA interrupt */
+    volatile uint8_t in_isr;     /* SET while the timer runs the driver */
+} gd25q_model_struct;
+
+extern gd25q_model_struct gd25q_model;
+
+/* erase the array, clear the counters and start the timer which raises the DMA interrupt */
+void gd25q_model_init(void);
+/* forget the logged chip select periods */
+void gd25q_model_log_clear(void);
+/* logged chip select period, 0 is the oldest kept */
+const gd25q_model_transaction_struct *gd25q_model_log(uint32_t index);
+/* number of logged chip select periods with an opcode */
+uint32_t gd25q_model_log_opcodes(uint8_t opcode);
+/* model time in APB cycles */
+uint64_t gd25q_model_now(void);
+/* SET while the chip executes a program or erase */
+FlagStatus gd25q_model_busy(void);
+/* chip select level */
+FlagStatus gd25q_model_cs(void);
+
+#endif /* GD25Q_MODEL_H */
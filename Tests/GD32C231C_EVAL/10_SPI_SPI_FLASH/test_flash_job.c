@@ -0,0 +1,347 @@
+/*!
+    \file    test_flash_job.c
+    \brief   queued program/erase jobs of gd25qxx.c against the GD25Q16 model with latencies
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "gd25q_model.h"
+#include "gd25qxx.c"
+
+#define TEST_JOB_LOG_NUM    16U
+
+typedef struct {
+    uint64_t program;
+    uint64_t erase;
+} latency_struct;
+
+static const latency_struct latency[] = {
+    {GD25Q_MODEL_US(600U), GD25Q_MODEL_US(45000U)},
+    {GD25Q_MODEL_US(2500U), GD25Q_MODEL_US(150000U)},
+};
+
+/* buffers read by the jobs, static so that they stay valid until the jobs are done */
+static uint8_t pattern[0x1000];
+static uint8_t rx_buffer[0x400];
+
+/* completed jobs, in the order of their callbacks */
+static volatile uint32_t done_count = 0U;
+static uint32_t done_id[TEST_JOB_LOG_NUM];
+static uint64_t done_time[TEST_JOB_LOG_NUM];
+static uint32_t done_outside_isr = 0U;
+static uint32_t done_early = 0U;
+
+/*!
+    \brief      record a completed job, check that the chip holds its result
+    \param[in]  id: job number
+    \param[in]  addr: address of the job
+    \param[in]  length: bytes written, 0 for an erase
+    \param[out] none
+    \retval     none
+*/
+static void job_done(uint32_t id, uint32_t addr, uint32_t length)
+{
+    uint32_t i;
+
+    if(0U == gd25q_model.in_isr) {
+        done_outside_isr++;
+    }
+    if(SET == gd25q_model_busy()) {
+        done_early++;
+    }
+    if(0U == length) {
+        for(i = 0U; i < GD25Q_MODEL_SECTOR_SIZE; i++) {
+            if(0xFFU != gd25q_model.array[addr + i]) {
+                done_early++;
+                break;
+            }
+        }
+    } else if(0 != memcmp(&gd25q_model.array[addr], pattern, length)) {
+        done_early++;
+    }
+    if(done_count < TEST_JOB_LOG_NUM) {
+        done_id[done_count] = id;
+        done_time[done_count] = gd25q_model_now();
+    }
+    done_count++;
+}
+
+static void done_erase_4000(void)
+{
+    job_done(0U, 0x4000U, 0U);
+}
+
+static void done_write_4010(void)
+{
+    job_done(1U, 0x4010U, 600U);
+}
+
+static void done_erase_5000(void)
+{
+    job_done(2U, 0x5000U, 0U);
+}
+
+static void done_write_5000(void)
+{
+    job_done(3U, 0x5000U, 0x1000U);
+}
+
+/*!
+    \brief      block or unblock the host timer, the SysTick and DMA interrupts wait meanwhile
+    \param[in]  block: 1 to block
+    \param[out] none
+    \retval     none
+*/
+static void irq_block(int block)
+{
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGALRM);
+    sigprocmask(block ? SIG_BLOCK : SIG_UNBLOCK, &set, NULL);
+}
+
+/*!
+    \brief      start the model with latencies, the host timer polls the queue as the SysTick does
+    \param[in]  l: program and erase latencies
+    \param[out] none
+    \retval     none
+*/
+static void model_start(const latency_struct *l)
+{
+    irq_block(1);
+    gd25q_model_init();
+    gd25q_model.program_latency = l->program;
+    gd25q_model.erase_latency = l->erase;
+    gd25q_model.tick_hook = spi_flash_job_poll;
+    spi_flash_init();
+    done_count = 0U;
+    done_outside_isr = 0U;
+    done_early = 0U;
+    irq_block(0);
+}
+
+/*!
+    \brief      check that the chip never saw an instruction out of sequence
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void check_sequence(void)
+{
+    HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.wel_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.overruns, 0U);
+    HOST_CHECK_EQ(gd25q_model.program_ones, 0U);
+    HOST_CHECK_EQ(done_outside_isr, 0U);
+    HOST_CHECK_EQ(done_early, 0U);
+}
+
+/*!
+    \brief      queue erases and writes, the foreground keeps running until they are done
+    \param[in]  l: program and erase latencies
+    \param[out] none
+    \retval     none
+*/
+static void test_order(const latency_struct *l)
+{
+    uint64_t start, bus, page_cycles;
+    uint32_t foreground = 0U, pages, i;
+
+    model_start(l);
+    memset(&gd25q_model.array[0x4000], 0x00, 2U * GD25Q_MODEL_SECTOR_SIZE);
+
+    /* submitting touches neither the bus nor the chip */
+    irq_block(1);
+    bus = gd25q_model.bus_cycles;
+    start = gd25q_model_now();
+    HOST_CHECK_EQ(spi_flash_submit_erase(0x4000U, done_erase_4000), SUCCESS);
+    HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x4010U, 600U, done_write_4010), SUCCESS);
+    HOST_CHECK_EQ(spi_flash_submit_erase(0x5000U, done_erase_5000), SUCCESS);
+    HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x5000U, 0x1000U, done_write_5000), SUCCESS);
+    HOST_CHECK_EQ(spi_flash_job_count(), 4U);
+    HOST_CHECK_EQ(gd25q_model.bus_cycles, bus);
+    HOST_CHECK_EQ(gd25q_model.log_count, 0U);
+    irq_block(0);
+
+    while(0U != spi_flash_job_count()) {
+        foreground++;
+    }
+    HOST_CHECK(foreground > 0U);
+    HOST_CHECK_EQ(gd25q_model_cs(), SET);
+
+    /* the jobs complete in order, each after its latency */
+    HOST_CHECK_EQ(done_count, 4U);
+    for(i = 0U; i < 4U; i++) {
+        HOST_CHECK_EQ(done_id[i], i);
+    }
+    HOST_CHECK(done_time[0] >= start + l->erase);
+    HOST_CHECK(done_time[1] >= done_time[0] + 3U * l->program);
+    HOST_CHECK(done_time[2] >= done_time[1] + l->erase);
+    HOST_CHECK(done_time[3] >= done_time[2] + 16U * l->program);
+    HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x4010], pattern, 600U), 0);
+    HOST_CHECK_EQ(gd25q_model.array[0x400F], 0xFFU);
+    HOST_CHECK_EQ(gd25q_model.array[0x4010 + 600], 0xFFU);
+    HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x5000], pattern, 0x1000U), 0);
+    HOST_CHECK_EQ(gd25q_model.programs, 3U + 16U);
+    HOST_CHECK_EQ(gd25q_model.erases, 2U);
+
+    /* the pages are pipelined: the next one is sent in the tick which sees the previous one done */
+    pages = 16U;
+    page_cycles = 8U * 260U * 32U;
+    HOST_CHECK(done_time[3] - done_time[2] <= pages * (l->program + page_cycles + GD25Q_MODEL_TICK) + GD25Q_MODEL_TICK);
+    printf("program %5u us, erase %6u us: 16 pages in %6u us, %u foreground loops\n",
+           (unsigned)(l->program / 48U), (unsigned)(l->erase / 48U),
+           (unsigned)((done_time[3] - done_time[2]) / 48U), (unsigned)foreground);
+
+    check_sequence();
+}
+
+/*!
+    \brief      a full queue refuses a job, the queued ones still complete
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_full(void)
+{
+    uint32_t i;
+
+    model_start(&latency[0]);
+    irq_block(1);
+    for(i = 0U; i < SPI_FLASH_JOB_NUM; i++) {
+        HOST_CHECK_EQ(spi_flash_submit_erase(0x10000U + i * GD25Q_MODEL_SECTOR_SIZE, NULL), SUCCESS);
+    }
+    HOST_CHECK_EQ(spi_flash_submit_erase(0x20000U, NULL), ERROR);
+    HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x20000U, 16U, NULL), ERROR);
+    HOST_CHECK_EQ(spi_flash_job_count(), SPI_FLASH_JOB_NUM);
+    irq_block(0);
+    spi_flash_job_wait();
+    HOST_CHECK_EQ(gd25q_model.erases, SPI_FLASH_JOB_NUM);
+    check_sequence();
+}
+
+/*!
+    \brief      a DMA read waits for the running job, the queue waits for the read
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_read_between(void)
+{
+    model_start(&latency[0]);
+    memcpy(&gd25q_model.array[0x8000], pattern, sizeof(rx_buffer));
+    HOST_CHECK_EQ(spi_flash_submit_erase(0x6000U, NULL), SUCCESS);
+    HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x6000U, 0x800U, NULL), SUCCESS);
+
+    /* wait until the queue runs, then read */
+    while(RESET == gd25q_model_busy()) {
+    }
+    spi_flash_buffer_read(rx_buffer, 0x8000U, sizeof(rx_buffer));
+    HOST_CHECK_EQ(memcmp(rx_buffer, pattern, sizeof(rx_buffer)), 0);
+    spi_flash_job_wait();
+    HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x6000], pattern, 0x800U), 0);
+    HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.wel_violations, 0U);
+}
+
+/*!
+    \brief      the blocking functions let the queued jobs complete before they use the bus
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_blocking(void)
+{
+    uint32_t step;
+
+    for(step = 0U; step < 6U; step++) {
+        model_start(&latency[0]);
+        memset(&gd25q_model.array[0x7000], 0x00, GD25Q_MODEL_SECTOR_SIZE);
+        HOST_CHECK_EQ(spi_flash_submit_erase(0x7000U, NULL), SUCCESS);
+        HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x7000U, 0x200U, NULL), SUCCESS);
+
+        switch(step) {
+        case 0:
+            spi_flash_write_enable();
+            break;
+        case 1:
+            spi_flash_wait_for_write_end();
+            break;
+        case 2:
+            spi_quad_flash_quad_enable();
+            break;
+        case 3:
+            spi_quad_flash_page_write(pattern, 0x7200U, 0x100U);
+            HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x7200], pattern, 0x100U), 0);
+            break;
+        case 4:
+            memset(rx_buffer, 0, sizeof(rx_buffer));
+            spi_quad_flash_quad_enable();
+            /* the quad enable is done, queue a job again before the quad read */
+            HOST_CHECK_EQ(spi_flash_submit_write(pattern, 0x7200U, 0x100U, NULL), SUCCESS);
+            spi_quad_flash_buffer_read(rx_buffer, 0x7000U, 0x300U);
+            HOST_CHECK_EQ(memcmp(rx_buffer, pattern, 0x200U), 0);
+            HOST_CHECK_EQ(memcmp(&rx_buffer[0x200], pattern, 0x100U), 0);
+            break;
+        default:
+            spi_flash_sector_erase(0x9000U);
+            break;
+        }
+        HOST_CHECK_EQ(spi_flash_job_count(), 0U);
+        HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x7000], pattern, 0x200U), 0);
+        HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+        HOST_CHECK_EQ(gd25q_model.wel_violations, 0U);
+        HOST_CHECK_EQ(gd25q_model.qe_violations, 0U);
+    }
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for(i = 0U; i < sizeof(pattern); i++) {
+        pattern[i] = (uint8_t)(i * 13U + (i >> 8));
+    }
+
+    for(i = 0U; i < sizeof(latency) / sizeof(latency[0]); i++) {
+        test_order(&latency[i]);
+    }
+    test_full();
+    test_read_between();
+    test_blocking();
+
+    return host_test_result("flash_job");
+}
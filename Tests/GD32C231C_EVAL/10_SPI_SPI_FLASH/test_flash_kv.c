@@ -0,0 +1,336 @@
+/*!
+    \file    test_flash_kv.c
+    \brief   garbage collection and wear of flash_kv.c on the GD25Q16 model
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "gd25q_model.h"
+#include "gd25qxx.c"
+#include "flash_kv.c"
+
+#define TEST_KEY_END        48U
+#define TEST_STATIC_KEYS    4U
+#define TEST_HOT_FIRST      10U
+#define TEST_HOT_KEYS       16U
+#define TEST_OPERATIONS     20000U
+
+/* what the store must hold */
+static uint8_t reference_value[TEST_KEY_END][FLASH_KV_VALUE_MAX];
+static uint16_t reference_length[TEST_KEY_END];
+
+/* CRC unit, word input, polynomial 0x04C11DB7 */
+static uint32_t crc_value = 0xFFFFFFFFU;
+
+void crc_deinit(void)
+{
+    crc_value = 0xFFFFFFFFU;
+}
+
+void crc_data_register_reset(void)
+{
+    crc_value = 0xFFFFFFFFU;
+}
+
+uint32_t crc_block_data_calculate(void *array, uint32_t size, uint8_t data_format)
+{
+    const uint32_t *word = (const uint32_t *)array;
+    uint32_t i, bit;
+
+    (void)data_format;
+    for(i = 0U; i < size; i++) {
+        crc_value ^= word[i];
+        for(bit = 0U; bit < 32U; bit++) {
+            crc_value = (crc_value & 0x80000000U) ? ((crc_value << 1) ^ 0x04C11DB7U) : (crc_value << 1);
+        }
+    }
+    return crc_value;
+}
+
+/*!
+    \brief      store a value in the store and in the reference
+    \param[in]  key: key of the value
+    \param[in]  length: value length
+    \param[in]  seed: first byte of the value
+    \param[out] none
+    \retval     ErrStatus of flash_kv_set()
+*/
+static ErrStatus reference_set(uint16_t key, uint16_t length, uint8_t seed)
+{
+    uint8_t value[FLASH_KV_VALUE_MAX];
+    uint16_t i;
+
+    for(i = 0U; i < length; i++) {
+        value[i] = (uint8_t)(seed + i * 31U);
+    }
+    if(ERROR == flash_kv_set(key, value, length)) {
+        return ERROR;
+    }
+    memcpy(reference_value[key], value, length);
+    reference_length[key] = length;
+    return SUCCESS;
+}
+
+/*!
+    \brief      compare every key of the store with the reference
+    \param[in]  none
+    \param[out] none
+    \retval     number of keys which differ
+*/
+static uint32_t reference_mismatch(void)
+{
+    uint8_t value[FLASH_KV_VALUE_MAX];
+    uint16_t key, length;
+    uint32_t bad = 0U;
+
+    for(key = 0U; key < TEST_KEY_END; key++) {
+        length = sizeof(value);
+        if(ERROR == flash_kv_get(key, value, &length)) {
+            if(0U != reference_length[key]) {
+                bad++;
+            }
+        } else if((length != reference_length[key]) || (0 != memcmp(value, reference_value[key], length))) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+/*!
+    \brief      start from an erased chip and an empty store
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void store_start(void)
+{
+    gd25q_model_init();
+    gd25q_model.tick_hook = spi_flash_job_poll;
+    spi_flash_init();
+    flash_kv_format();
+    HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+    memset(reference_length, 0, sizeof(reference_length));
+}
+
+/*!
+    \brief      single keys: set, overwrite, delete, limits and remount
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_basic(void)
+{
+    uint8_t value[FLASH_KV_VALUE_MAX + 1U];
+    uint16_t length = sizeof(value);
+
+    store_start();
+    HOST_CHECK_EQ(flash_kv_get(1U, value, &length), ERROR);
+    HOST_CHECK_EQ(reference_set(1U, 4U, 0x10U), SUCCESS);
+    HOST_CHECK_EQ(reference_set(2U, FLASH_KV_VALUE_MAX, 0x20U), SUCCESS);
+    HOST_CHECK_EQ(reference_set(1U, 9U, 0x30U), SUCCESS);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+
+    /* the buffer is too small for the value */
+    length = 8U;
+    HOST_CHECK_EQ(flash_kv_get(1U, value, &length), ERROR);
+
+    HOST_CHECK_EQ(flash_kv_set(FLASH_KV_KEY_INVALID, value, 4U), ERROR);
+    HOST_CHECK_EQ(flash_kv_set(3U, value, 0U), ERROR);
+    HOST_CHECK_EQ(flash_kv_set(3U, value, FLASH_KV_VALUE_MAX + 1U), ERROR);
+
+    HOST_CHECK_EQ(flash_kv_delete(2U), SUCCESS);
+    reference_length[2] = 0U;
+    HOST_CHECK_EQ(flash_kv_delete(2U), ERROR);
+    HOST_CHECK_EQ(flash_kv_delete(7U), ERROR);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+
+    /* the RAM index is rebuilt from the log */
+    HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+}
+
+/*!
+    \brief      a record torn by a power loss is dropped, the previous value stays
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_torn(void)
+{
+    uint32_t addr;
+
+    store_start();
+    HOST_CHECK_EQ(reference_set(5U, 16U, 0x40U), SUCCESS);
+    HOST_CHECK_EQ(reference_set(6U, 16U, 0x50U), SUCCESS);
+    addr = kv_index[kv_index_find(5U)].addr;
+    HOST_CHECK_EQ(flash_kv_set(5U, reference_value[6], 16U), SUCCESS);
+
+    /* the program of the last record stopped half way */
+    gd25q_model.array[kv_index[kv_index_find(5U)].addr + KV_RECORD_HEADER_SIZE + 12U] = 0xFFU;
+    HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+    HOST_CHECK_EQ(kv_index[kv_index_find(5U)].addr, addr);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+
+    /* the damaged sector is closed, the next record goes to a new one */
+    HOST_CHECK_EQ(reference_set(7U, 8U, 0x60U), SUCCESS);
+    HOST_CHECK(KV_SECTOR_OF(kv_index[kv_index_find(7U)].addr) != KV_SECTOR_OF(addr));
+    HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+}
+
+/*!
+    \brief      the RAM index limits the number of keys
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_index_full(void)
+{
+    uint16_t key;
+
+    store_start();
+    for(key = 0U; key < FLASH_KV_KEY_NUM; key++) {
+        HOST_CHECK_EQ(reference_set(key, 4U, (uint8_t)key), SUCCESS);
+    }
+    HOST_CHECK_EQ(reference_set(FLASH_KV_KEY_NUM, 4U, 0U), ERROR);
+    /* a stored key can still be updated */
+    HOST_CHECK_EQ(reference_set(3U, 8U, 0x70U), SUCCESS);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+}
+
+/*!
+    \brief      static keys and hot keys, the idle loop collects the sectors
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_wear(void)
+{
+    uint32_t op, sets = 0U, programs, spread, bad = 0U, failed = 0U;
+    uint32_t low = 0xFFFFFFFFU, high = 0U, count, first[FLASH_KV_SECTOR_NUM];
+    kv_header_struct header;
+    uint16_t key;
+    uint8_t sector, static_sector;
+
+    store_start();
+    srand(7);
+    for(key = 1U; key <= TEST_STATIC_KEYS; key++) {
+        HOST_CHECK_EQ(reference_set(key, FLASH_KV_VALUE_MAX, (uint8_t)(key * 3U)), SUCCESS);
+    }
+    static_sector = KV_SECTOR_OF(kv_index[kv_index_find(1U)].addr);
+    programs = gd25q_model.programs;
+    /* the RAM erase counts go on from the earlier tests, the chip starts at one erase */
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        first[sector] = kv_sector_erase[sector] - 1U;
+    }
+
+    for(op = 0U; op < TEST_OPERATIONS; op++) {
+        key = (uint16_t)(TEST_HOT_FIRST + (uint32_t)rand() % TEST_HOT_KEYS);
+        if((0 == rand() % 20) && (0U != reference_length[key])) {
+            if(ERROR == flash_kv_delete(key)) {
+                failed++;
+            }
+            reference_length[key] = 0U;
+        } else {
+            if(ERROR == reference_set(key, (uint16_t)(1U + (uint32_t)rand() % FLASH_KV_VALUE_MAX), (uint8_t)rand())) {
+                failed++;
+            }
+            sets++;
+        }
+
+        /* idle time of the application */
+        flash_kv_gc();
+
+        if(0U == (op % 500U)) {
+            bad += reference_mismatch();
+        }
+        if(0U == (op % 4000U)) {
+            spi_flash_job_wait();
+            HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+            bad += reference_mismatch();
+        }
+    }
+    HOST_CHECK_EQ(failed, 0U);
+    HOST_CHECK_EQ(bad, 0U);
+    spi_flash_job_wait();
+    HOST_CHECK_EQ(flash_kv_init(), SUCCESS);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+
+    /* the erase counts of the headers follow the chip */
+    for(sector = 0U; sector < FLASH_KV_SECTOR_NUM; sector++) {
+        count = gd25q_model.sector_erases[KV_SECTOR_ADDRESS(sector) / GD25Q_MODEL_SECTOR_SIZE];
+        memcpy(&header, &gd25q_model.array[KV_SECTOR_ADDRESS(sector)], sizeof(header));
+        HOST_CHECK_EQ(header.erase_count, kv_sector_erase[sector]);
+        HOST_CHECK_EQ(kv_sector_erase[sector] - first[sector], count);
+        if(count < low) {
+            low = count;
+        }
+        if(count > high) {
+            high = count;
+        }
+    }
+    spread = high - low;
+    printf("%u sets, %u page programs, erases per sector %u to %u\n", (unsigned)sets,
+           (unsigned)(gd25q_model.programs - programs), (unsigned)low, (unsigned)high);
+    /* the static keys were moved out of their sector, which then took its share of erases */
+    HOST_CHECK(gd25q_model.sector_erases[KV_SECTOR_ADDRESS(static_sector) / GD25Q_MODEL_SECTOR_SIZE] > 1U);
+    HOST_CHECK(spread <= FLASH_KV_WEAR_DELTA + 2U);
+
+    HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.wel_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.program_ones, 0U);
+}
+
+/*!
+    \brief      the tests, flash_kv.c reads the flash into buffers on its stack
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_all(void)
+{
+    test_basic();
+    test_torn();
+    test_index_full();
+    test_wear();
+}
+
+int main(void)
+{
+    host_low_stack_run(test_all);
+
+    return host_test_result("flash_kv");
+}
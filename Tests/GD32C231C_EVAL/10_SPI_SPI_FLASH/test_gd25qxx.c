@@ -0,0 +1,271 @@
+/*!
+    \file    test_gd25qxx.c
+    \brief   instruction sequences and read paths of gd25qxx.c against the GD25Q16 model
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "gd25q_model.h"
+#include "gd25qxx.c"
+
+#define TEST_LONG_READ      70000U
+
+/* buffers seen by the DMA, static so that their address fits the DMA registers */
+static uint8_t tx_buffer[0x600];
+static uint8_t rx_buffer[TEST_LONG_READ + 16U];
+static volatile uint32_t callback_count = 0U;
+static volatile uint32_t callback_in_isr = 0U;
+
+static void read_done(void)
+{
+    callback_count++;
+    if(0U != gd25q_model.in_isr) {
+        callback_in_isr++;
+    }
+}
+
+/*!
+    \brief      block or unblock the host timer, the DMA interrupt waits meanwhile
+    \param[in]  block: 1 to block
+    \param[out] none
+    \retval     none
+*/
+static void irq_block(int block)
+{
+    sigset_t set;
+
+    sigemptyset(&set);
+    sigaddset(&set, SIGALRM);
+    sigprocmask(block ? SIG_BLOCK : SIG_UNBLOCK, &set, NULL);
+}
+
+/*!
+    \brief      print the cost of a logged chip select period
+    \param[in]  name: what the period did
+    \param[in]  back: 1 for the latest period, 2 for the one before it
+    \param[out] none
+    \retval     none
+*/
+static void report(const char *name, uint32_t back)
+{
+    const gd25q_model_transaction_struct *tr = gd25q_model_log(gd25q_model.log_count - back);
+
+    printf("%-22s opcode 0x%02X %6u bytes %8u APB cycles\n", name, tr->opcode, (unsigned)tr->bytes,
+           (unsigned)tr->cycles);
+}
+
+/*!
+    \brief      check that every page program of the log is framed by WREN and RDSR
+                and that the pages follow the expected addresses and lengths
+    \param[in]  opcode: the page program instruction
+    \param[in]  addr: address of the first byte written
+    \param[in]  length: number of bytes written
+    \param[out] none
+    \retval     number of mismatches
+*/
+static uint32_t check_page_programs(uint8_t opcode, uint32_t addr, uint32_t length)
+{
+    const gd25q_model_transaction_struct *tr, *prev, *next;
+    uint32_t i, bad = 0U, number;
+
+    for(i = 1U; NULL != (tr = gd25q_model_log(i)); i++) {
+        if(opcode != tr->opcode) {
+            continue;
+        }
+        prev = gd25q_model_log(i - 1U);
+        next = gd25q_model_log(i + 1U);
+        number = GD25Q_MODEL_PAGE_SIZE - (addr % GD25Q_MODEL_PAGE_SIZE);
+        if(number > length) {
+            number = length;
+        }
+        if((WREN != prev->opcode) || (NULL == next) || (RDSR != next->opcode) ||
+                (addr != tr->addr) || (number != tr->data)) {
+            bad++;
+        }
+        addr += number;
+        length -= number;
+    }
+    return bad + length;
+}
+
+int main(void)
+{
+    const gd25q_model_transaction_struct *tr;
+    uint32_t i, fast_cycles, read_cycles;
+
+    gd25q_model_init();
+    spi_flash_init();
+    HOST_CHECK_EQ(SPI_CTL0(SPI1) & SPI_CTL0_PSC, SPI_FLASH_PSC_COMMAND);
+
+    /* identification */
+    gd25q_model_log_clear();
+    HOST_CHECK_EQ(spi_flash_read_id(), GD25Q_MODEL_ID);
+    HOST_CHECK_EQ(gd25q_model.log_count, 1U);
+    HOST_CHECK_EQ(gd25q_model_log(0U)->bytes, 4U);
+    report("read id", 1U);
+
+    /* erase, then a write which starts in the middle of a page and spans four of them */
+    for(i = 0U; i < sizeof(tx_buffer); i++) {
+        tx_buffer[i] = (uint8_t)(i * 7U + 3U);
+    }
+    memset(&gd25q_model.array[0x1000], 0x00, GD25Q_MODEL_SECTOR_SIZE);
+    gd25q_model_log_clear();
+    spi_flash_sector_erase(0x1000U);
+    HOST_CHECK_EQ(gd25q_model.erases, 1U);
+    HOST_CHECK_EQ(gd25q_model.array[0x1FFF], 0xFFU);
+    HOST_CHECK_EQ(gd25q_model_log(0U)->opcode, WREN);
+    HOST_CHECK_EQ(gd25q_model_log(1U)->opcode, SE);
+    HOST_CHECK_EQ(gd25q_model_log(1U)->addr, 0x1000U);
+    report("sector erase wait", 1U);
+    HOST_CHECK_EQ(gd25q_model_busy(), RESET);
+
+    gd25q_model_log_clear();
+    spi_flash_buffer_write(tx_buffer, 0x10F0U, 600U);
+    HOST_CHECK_EQ(gd25q_model.programs, 4U);
+    HOST_CHECK_EQ(check_page_programs(WRITE, 0x10F0U, 600U), 0U);
+    HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x10F0], tx_buffer, 600U), 0);
+    HOST_CHECK_EQ(gd25q_model.array[0x10EF], 0xFFU);
+    HOST_CHECK_EQ(gd25q_model.array[0x10F0 + 600], 0xFFU);
+    report("page program", 2U);
+
+    /* fast read: one chip select period, five header bytes, the data at the read prescaler */
+    gd25q_model_log_clear();
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    spi_flash_buffer_read(rx_buffer, 0x10F0U, 600U);
+    HOST_CHECK_EQ(memcmp(rx_buffer, tx_buffer, 600U), 0);
+    HOST_CHECK_EQ(rx_buffer[600], 0U);
+    HOST_CHECK_EQ(gd25q_model.log_count, 1U);
+    tr = gd25q_model_log(0U);
+    HOST_CHECK_EQ(tr->opcode, FAST_READ);
+    HOST_CHECK_EQ(tr->addr, 0x10F0U);
+    HOST_CHECK_EQ(tr->data, 600U);
+    HOST_CHECK_EQ(tr->bytes, 605U);
+    HOST_CHECK_EQ(tr->psc, SPI_FLASH_PSC_READ);
+    HOST_CHECK_EQ(SPI_CTL0(SPI1) & SPI_CTL0_PSC, SPI_FLASH_PSC_COMMAND);
+    HOST_CHECK_EQ(gd25q_model_cs(), SET);
+    fast_cycles = tr->cycles;
+    report("fast read DMA 600", 1U);
+
+    /* the byte by byte read sequence of the original driver */
+    gd25q_model_log_clear();
+    spi_flash_start_read_sequence(0x10F0U);
+    for(i = 0U; i < 600U; i++) {
+        rx_buffer[i] = spi_flash_read_byte();
+    }
+    SPI_FLASH_CS_HIGH();
+    HOST_CHECK_EQ(memcmp(rx_buffer, tx_buffer, 600U), 0);
+    tr = gd25q_model_log(0U);
+    HOST_CHECK_EQ(tr->opcode, READ);
+    HOST_CHECK_EQ(tr->bytes, 604U);
+    read_cycles = tr->cycles;
+    report("read per byte 600", 1U);
+    HOST_CHECK(fast_cycles * 8U < read_cycles);
+
+    /* a read longer than one DMA block stays in one chip select period */
+    for(i = 0U; i < TEST_LONG_READ; i++) {
+        gd25q_model.array[0x20000U + i] = (uint8_t)(i ^ (i >> 8));
+    }
+    gd25q_model_log_clear();
+    gd25q_model.dma_blocks = 0U;
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    spi_flash_dma_read(rx_buffer, 0x20000U, TEST_LONG_READ, NULL);
+    spi_flash_dma_wait();
+    HOST_CHECK_EQ(memcmp(rx_buffer, &gd25q_model.array[0x20000], TEST_LONG_READ), 0);
+    HOST_CHECK_EQ(rx_buffer[TEST_LONG_READ], 0U);
+    HOST_CHECK_EQ(gd25q_model.log_count, 1U);
+    HOST_CHECK_EQ(gd25q_model_log(0U)->data, TEST_LONG_READ);
+    HOST_CHECK_EQ(gd25q_model.dma_blocks, 2U);
+
+    /* asynchronous read, the callback runs in the DMA interrupt */
+    callback_count = 0U;
+    callback_in_isr = 0U;
+    irq_block(1);
+    spi_flash_dma_read(rx_buffer, 0x20000U, 4096U, read_done);
+    HOST_CHECK_EQ(spi_flash_dma_busy(), SET);
+    HOST_CHECK_EQ(gd25q_model_cs(), RESET);
+    HOST_CHECK_EQ(callback_count, 0U);
+    irq_block(0);
+    spi_flash_dma_wait();
+    HOST_CHECK_EQ(callback_count, 1U);
+    HOST_CHECK_EQ(callback_in_isr, 1U);
+    HOST_CHECK_EQ(gd25q_model_cs(), SET);
+
+    /* an empty read calls back at once and leaves the bus alone */
+    gd25q_model_log_clear();
+    spi_flash_dma_read(rx_buffer, 0x20000U, 0U, read_done);
+    HOST_CHECK_EQ(callback_count, 2U);
+    HOST_CHECK_EQ(gd25q_model.log_count, 0U);
+
+    /* read prescaler selected at run time */
+    spi_flash_read_prescale_config(SPI_PSC_8);
+    gd25q_model_log_clear();
+    spi_flash_buffer_read(rx_buffer, 0x10F0U, 256U);
+    HOST_CHECK_EQ(gd25q_model_log(0U)->psc, SPI_PSC_8);
+    HOST_CHECK_EQ(memcmp(rx_buffer, tx_buffer, 256U), 0);
+    spi_flash_read_prescale_config(SPI_FLASH_PSC_READ);
+
+    /* a DMA error ends the read, the bus is released and the next read works */
+    gd25q_model.dma_inject_error = 1U;
+    spi_flash_dma_read(rx_buffer, 0x20000U, 1000U, read_done);
+    spi_flash_dma_wait();
+    HOST_CHECK_EQ(callback_count, 3U);
+    HOST_CHECK_EQ(gd25q_model_cs(), SET);
+    HOST_CHECK_EQ(SPI_CTL0(SPI1) & SPI_CTL0_PSC, SPI_FLASH_PSC_COMMAND);
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    spi_flash_buffer_read(rx_buffer, 0x10F0U, 600U);
+    HOST_CHECK_EQ(memcmp(rx_buffer, tx_buffer, 600U), 0);
+
+    /* quad program and read */
+    spi_flash_sector_erase(0x3000U);
+    gd25q_model_log_clear();
+    spi_quad_flash_buffer_write(tx_buffer, 0x3080U, 300U);
+    HOST_CHECK_EQ(gd25q_model.qe, 1U);
+    HOST_CHECK_EQ(check_page_programs(QUADWRITE, 0x3080U, 300U), 0U);
+    HOST_CHECK_EQ(memcmp(&gd25q_model.array[0x3080], tx_buffer, 300U), 0);
+    memset(rx_buffer, 0, sizeof(rx_buffer));
+    spi_quad_flash_buffer_read(rx_buffer, 0x3080U, 300U);
+    HOST_CHECK_EQ(memcmp(rx_buffer, tx_buffer, 300U), 0);
+    report("quad read 300", 2U);
+
+    /* the chip never saw an instruction out of sequence */
+    HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.wel_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.qe_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.overruns, 0U);
+    HOST_CHECK_EQ(gd25q_model.dma_order_errors, 0U);
+    HOST_CHECK_EQ(gd25q_model.program_ones, 0U);
+
+    return host_test_result("gd25qxx");
+}
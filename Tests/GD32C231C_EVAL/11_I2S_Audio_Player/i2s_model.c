@@ -0,0 +1,358 @@
+/*!
+    \file    i2s_model.c
+    \brief   I2S0 transmitter and circular DMA channel model behind the functions used by i2s_codec.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "i2s_model.h"
+#include "i2s_codec.h"
+
+i2s_model_struct i2s_model;
+
+/* transmit buffer written by the TBE interrupt */
+static uint16_t model_tdata;
+static uint8_t model_tdata_full = 0U;
+/* half words left before the pending DMA interrupt is served */
+static uint32_t model_countdown = 0U;
+
+/*!
+    \brief      clear the model
+    \param[in]  latency: half words sent between a DMA flag and its interrupt
+    \param[out] none
+    \retval     none
+*/
+void i2s_model_init(uint32_t latency)
+{
+    memset(&i2s_model, 0, sizeof(i2s_model));
+    i2s_model.irq_latency = latency;
+    model_tdata_full = 0U;
+    model_countdown = 0U;
+}
+
+/*!
+    \brief      raise a DMA interrupt flag
+    \param[in]  flag: DMA_INT_FLAG_HTF or DMA_INT_FLAG_FTF
+    \param[out] none
+    \retval     none
+*/
+static void model_dma_flag(uint32_t flag)
+{
+    if(0U != (i2s_model.dma_flags & flag)) {
+        i2s_model.missed_flags++;
+    }
+    if(0U == i2s_model.dma_flags) {
+        model_countdown = i2s_model.irq_latency;
+    }
+    i2s_model.dma_flags |= flag;
+}
+
+/*!
+    \brief      interrupt requests of the DMA channel
+    \param[in]  none
+    \param[out] none
+    \retval     SET if an enabled flag is pending
+*/
+static FlagStatus model_dma_request(void)
+{
+    uint32_t flags = 0U;
+
+    if(0U != (i2s_model.dma_interrupts & DMA_INT_HTF)) {
+        flags |= DMA_INT_FLAG_HTF;
+    }
+    if(0U != (i2s_model.dma_interrupts & DMA_INT_FTF)) {
+        flags |= DMA_INT_FLAG_FTF;
+    }
+    return (0U != (i2s_model.dma_flags & flags)) ? SET : RESET;
+}
+
+/*!
+    \brief      shift half words out of I2S0, the DMA or the TBE interrupt give the data
+    \param[in]  number: number of half words
+    \param[out] none
+    \retval     none
+*/
+void i2s_model_run(uint32_t number)
+{
+    const uint16_t *memory;
+    uint16_t data = 0U;
+
+    while(number--) {
+        if((0U != i2s_model.enabled) && (0U != i2s_model.tx_dma) && (0U != i2s_model.dma_enabled)) {
+            memory = (const uint16_t *)(uintptr_t)i2s_model.dma_memory;
+            data = memory[i2s_model.dma_position++];
+            if((i2s_model.dma_number / 2U) == i2s_model.dma_position) {
+                model_dma_flag(DMA_INT_FLAG_HTF);
+            }
+            if(i2s_model.dma_number == i2s_model.dma_position) {
+                model_dma_flag(DMA_INT_FLAG_FTF);
+                i2s_model.dma_position = 0U;
+                if(0U == i2s_model.dma_circular) {
+                    i2s_model.dma_enabled = 0U;
+                }
+            }
+        } else if((0U != i2s_model.enabled) && (0U != i2s_model.tbe_interrupt)) {
+            /* SPI0 interrupt of the TBE build */
+            i2s_model.tbe_irqs++;
+            i2s_audio_data_send();
+            if(0U != model_tdata_full) {
+                data = model_tdata;
+                model_tdata_full = 0U;
+            } else {
+                i2s_model.underruns++;
+                data = 0U;
+            }
+        } else {
+            i2s_model.underruns++;
+            data = 0U;
+        }
+
+        if(i2s_model.sent < I2S_MODEL_OUTPUT_SIZE) {
+            i2s_model.output[i2s_model.sent] = data;
+        }
+        i2s_model.sent++;
+
+        /* DMA interrupt */
+        if(SET == model_dma_request()) {
+            if(0U != model_countdown) {
+                model_countdown--;
+            } else {
+                i2s_model.dma_irqs++;
+                i2s_audio_dma_irq_handler();
+            }
+        }
+    }
+}
+
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    if(RCU_DMAMUX == periph) {
+        i2s_model.dmamux_clock = 1U;
+    }
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq;
+    (void)nvic_irq_priority;
+}
+
+void gpio_af_set(uint32_t gpio_periph, uint32_t alt_func_num, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)alt_func_num;
+    (void)pin;
+}
+
+void gpio_mode_set(uint32_t gpio_periph, uint32_t mode, uint32_t pull_up_down, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)mode;
+    (void)pull_up_down;
+    (void)pin;
+}
+
+void gpio_output_options_set(uint32_t gpio_periph, uint8_t otype, uint32_t speed, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)otype;
+    (void)speed;
+    (void)pin;
+}
+
+void i2s_psc_config(uint32_t spi_periph, uint32_t i2s_audiosample, uint32_t i2s_frameformat, uint32_t i2s_mckout)
+{
+    (void)spi_periph;
+    (void)i2s_mckout;
+    i2s_model.audiosample = i2s_audiosample;
+    i2s_model.frameformat = i2s_frameformat;
+}
+
+void i2s_init(uint32_t spi_periph, uint32_t i2s_mode, uint32_t i2s_standard, uint32_t i2s_ckpl)
+{
+    (void)spi_periph;
+    (void)i2s_mode;
+    (void)i2s_standard;
+    (void)i2s_ckpl;
+}
+
+void i2s_enable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+    i2s_model.enabled = 1U;
+}
+
+void spi_i2s_interrupt_enable(uint32_t spi_periph, uint8_t interrupt)
+{
+    (void)spi_periph;
+    if(SPI_I2S_INT_TBE == interrupt) {
+        i2s_model.tbe_interrupt = 1U;
+    }
+}
+
+void spi_i2s_data_transmit(uint32_t spi_periph, uint16_t data)
+{
+    (void)spi_periph;
+    model_tdata = data;
+    model_tdata_full = 1U;
+}
+
+void spi_dma_enable(uint32_t spi_periph, uint8_t dma)
+{
+    (void)spi_periph;
+    if(SPI_DMA_TRANSMIT == dma) {
+        i2s_model.tx_dma = 1U;
+    }
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    i2s_model.dma_channel = channelx;
+    i2s_model.dma_enabled = 0U;
+    i2s_model.dma_circular = 0U;
+    i2s_model.dma_interrupts = 0U;
+    i2s_model.dma_flags = 0U;
+    i2s_model.dma_position = 0U;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    i2s_model.dma_channel = channelx;
+    i2s_model.dma_memory = init_struct->memory_addr;
+    i2s_model.dma_number = init_struct->number;
+    i2s_model.dma_request = init_struct->request;
+    i2s_model.dma_memory_width = init_struct->memory_width;
+    i2s_model.dma_periph_addr = init_struct->periph_addr;
+}
+
+void dma_circulation_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    i2s_model.dma_circular = 1U;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    i2s_model.dma_interrupts |= source;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    return (0U != (i2s_model.dma_flags & int_flag)) ? SET : RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    i2s_model.dma_flags &= ~int_flag;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    i2s_model.dma_enabled = 1U;
+}
+
+/* TIMER15 of timer_config(), not used by the tests */
+void timer_deinit(uint32_t timer_periph)
+{
+    (void)timer_periph;
+}
+
+void timer_struct_para_init(timer_parameter_struct *initpara)
+{
+    memset(initpara, 0, sizeof(*initpara));
+}
+
+void timer_init(uint32_t timer_periph, timer_parameter_struct *initpara)
+{
+    (void)timer_periph;
+    (void)initpara;
+}
+
+void timer_channel_output_struct_para_init(timer_oc_parameter_struct *ocpara)
+{
+    memset(ocpara, 0, sizeof(*ocpara));
+}
+
+void timer_channel_output_config(uint32_t timer_periph, uint16_t channel, timer_oc_parameter_struct *ocpara)
+{
+    (void)timer_periph;
+    (void)channel;
+    (void)ocpara;
+}
+
+void timer_channel_output_pulse_value_config(uint32_t timer_periph, uint16_t channel, uint32_t pulse)
+{
+    (void)timer_periph;
+    (void)channel;
+    (void)pulse;
+}
+
+void timer_channel_output_mode_config(uint32_t timer_periph, uint16_t channel, uint32_t ocmode)
+{
+    (void)timer_periph;
+    (void)channel;
+    (void)ocmode;
+}
+
+void timer_primary_output_config(uint32_t timer_periph, ControlStatus newvalue)
+{
+    (void)timer_periph;
+    (void)newvalue;
+}
+
+void timer_auto_reload_shadow_enable(uint32_t timer_periph)
+{
+    (void)timer_periph;
+}
+
+void timer_enable(uint32_t timer_periph)
+{
+    (void)timer_periph;
+}
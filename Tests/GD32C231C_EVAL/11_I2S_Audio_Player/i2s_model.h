@@ -0,0 +1,80 @@
+/*!
+    \file    i2s_model.h
+    \brief   I2S0 transmitter and circular DMA channel model behind the functions used by i2s_codec.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef I2S_MODEL_H
+#define I2S_MODEL_H
+
+#include "gd32c2x1.h"
+
+/* half words the model keeps of the I2S output */
+#define I2S_MODEL_OUTPUT_SIZE       16384U
+
+typedef struct {
+    /* I2S output */
+    uint16_t output[I2S_MODEL_OUTPUT_SIZE];
+    uint32_t sent;                      /* half words shifted out */
+    uint32_t audiosample;               /* sample rate of i2s_psc_config() */
+    uint32_t frameformat;
+    uint8_t enabled;
+    uint8_t tbe_interrupt;              /* SET once the TBE interrupt is enabled */
+    uint8_t tx_dma;                     /* SET once the transmit DMA request is enabled */
+    uint8_t dmamux_clock;               /* SET once the DMAMUX clock is enabled */
+    /* DMA channel */
+    uint32_t dma_channel;
+    uint32_t dma_memory;
+    uint32_t dma_number;
+    uint32_t dma_request;
+    uint32_t dma_memory_width;
+    uint32_t dma_periph_addr;
+    uint32_t dma_position;              /* half words sent of the current round */
+    uint32_t dma_interrupts;            /* enabled DMA interrupts */
+    uint32_t dma_flags;                 /* pending DMA interrupt flags */
+    uint8_t dma_circular;
+    uint8_t dma_enabled;
+    /* interrupts */
+    uint32_t irq_latency;               /* half words sent between a DMA flag and its interrupt */
+    uint32_t dma_irqs;
+    uint32_t tbe_irqs;
+    uint32_t missed_flags;              /* a DMA flag was raised again before it was cleared */
+    uint32_t underruns;                 /* no data for the transmitter */
+} i2s_model_struct;
+
+extern i2s_model_struct i2s_model;
+
+/* clear the model, the DMA interrupts are served after latency half words */
+void i2s_model_init(uint32_t latency);
+/* shift number half words out of I2S0, running the interrupts on the way */
+void i2s_model_run(uint32_t number);
+
+#endif /* I2S_MODEL_H */
@@ -0,0 +1,371 @@
+/*!
+    \file    test_audio_convert.c
+    \brief   golden vectors of the sample widening, gain and resampling of audio_convert.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "audio_convert.c"
+
+#define TEST_FRAMES         4096U
+#define TEST_PI             3.14159265358979323846
+
+#define COUNTOF(a)          (sizeof(a) / sizeof(*(a)))
+
+static audio_convert_struct convert;
+/* 16-bit input frames, interleaved when stereo */
+static int16_t input[TEST_FRAMES * 2U];
+static uint16_t output[TEST_FRAMES * 2U];
+static uint16_t output_chunked[TEST_FRAMES * 2U];
+
+/*!
+    \brief      load raw frames to the block and convert them
+    \param[in]  raw: frames in the input format
+    \param[in]  frames: number of frames, up to AUDIO_CONVERT_FRAME_NUM
+    \param[out] none
+    \retval     none
+*/
+static void block_load(const uint8_t *raw, uint32_t frames)
+{
+    memcpy(audio_convert_block_get(&convert), raw, frames * convert.channels * convert.bytes);
+    audio_convert_block_load(&convert, frames);
+}
+
+/*!
+    \brief      resample 16-bit input frames as i2s_codec.c does, reading a block each time
+                the conversion runs out of frames
+    \param[in]  frames: input frames of input[]
+    \param[in]  number: output frames wanted
+    \param[in]  chunk: output frames asked for at once, 0 for random sizes
+    \param[out] buffer: output frames
+    \retval     output frames produced before the input ran out
+*/
+static uint32_t resample(uint32_t frames, uint16_t *buffer, uint32_t number, uint32_t chunk)
+{
+    uint32_t done = 0U;
+    uint32_t used = 0U;
+    uint32_t count, wanted;
+
+    while(done < number) {
+        wanted = (0U != chunk) ? chunk : (1U + (uint32_t)rand() % 50U);
+        if(wanted > (number - done)) {
+            wanted = number - done;
+        }
+        count = audio_convert_run(&convert, &buffer[2U * done], wanted);
+        done += count;
+        if(count == wanted) {
+            continue;
+        }
+        if(used == frames) {
+            break;
+        }
+        count = frames - used;
+        if(count > AUDIO_CONVERT_FRAME_NUM) {
+            count = AUDIO_CONVERT_FRAME_NUM;
+        }
+        block_load((const uint8_t *)&input[used * convert.channels], count);
+        used += count;
+    }
+    return done;
+}
+
+/*!
+    \brief      8-bit unsigned samples are centred and widened, wider ones keep their upper
+                16 bits without rounding
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_widening(void)
+{
+    static const uint8_t in8[] = {0x00, 0x01, 0x7F, 0x80, 0x81, 0xFF};
+    static const int16_t out8[] = {-32768, -32512, -256, 0, 256, 32512};
+    static const uint8_t in24[] = {0x56, 0x34, 0x12,  0xFF, 0xFF, 0x7F,  0x00, 0x00, 0x80,
+                                   0xFF, 0xFF, 0xFF,  0x80, 0x00, 0x00,  0xFF, 0x00, 0x00};
+    static const int16_t out24[] = {0x1234, 32767, -32768, -1, 0, 0};
+    static const uint8_t in32[] = {0x78, 0x56, 0x34, 0x12,  0xFF, 0xFF, 0xFF, 0x7F,
+                                   0x00, 0x00, 0x00, 0x80,  0xFF, 0xFF, 0xFF, 0xFF,
+                                   0xFF, 0xFF, 0x00, 0x00,  0x00, 0x00, 0x01, 0x00};
+    static const int16_t out32[] = {0x1234, 32767, -32768, -1, 0, 1};
+    static const int16_t in16[] = {0, 1, -1, 32767, -32768, 0x1234};
+    uint8_t raw[AUDIO_CONVERT_FRAME_NUM * 2U];
+    const int16_t *pcm = (const int16_t *)convert.block;
+    uint32_t i;
+
+    audio_convert_init(&convert, 1U, 8U, 8000U, 8000U);
+    block_load(in8, COUNTOF(in8));
+    for(i = 0U; i < COUNTOF(out8); i++) {
+        HOST_CHECK_EQ(pcm[i], out8[i]);
+    }
+
+    audio_convert_init(&convert, 1U, 24U, 8000U, 8000U);
+    block_load(in24, COUNTOF(out24));
+    for(i = 0U; i < COUNTOF(out24); i++) {
+        HOST_CHECK_EQ(pcm[i], out24[i]);
+    }
+
+    audio_convert_init(&convert, 1U, 32U, 8000U, 8000U);
+    block_load(in32, COUNTOF(out32));
+    for(i = 0U; i < COUNTOF(out32); i++) {
+        HOST_CHECK_EQ(pcm[i], out32[i]);
+    }
+
+    audio_convert_init(&convert, 1U, 16U, 8000U, 8000U);
+    block_load((const uint8_t *)in16, COUNTOF(in16));
+    for(i = 0U; i < COUNTOF(in16); i++) {
+        HOST_CHECK_EQ(pcm[i], in16[i]);
+    }
+
+    /* a full block of 8-bit stereo frames grows in place */
+    audio_convert_init(&convert, 2U, 8U, 8000U, 8000U);
+    for(i = 0U; i < sizeof(raw); i++) {
+        raw[i] = (uint8_t)(i * 37U);
+    }
+    block_load(raw, AUDIO_CONVERT_FRAME_NUM);
+    for(i = 0U; i < sizeof(raw); i++) {
+        HOST_CHECK_EQ(pcm[i], (int16_t)(((int32_t)(uint8_t)(i * 37U) - 128) * 256));
+    }
+}
+
+/*!
+    \brief      Q12 gain, truncated towards minus infinity and saturated
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_gain(void)
+{
+    static const struct {
+        uint16_t gain;
+        int16_t in;
+        int16_t out;
+    } golden[] = {
+        {AUDIO_GAIN_UNITY, -32768, -32768},
+        {AUDIO_GAIN_UNITY, 32767, 32767},
+        {2048U, 1000, 500},
+        {2048U, -1001, -501},
+        {6144U, 333, 499},
+        {4095U, -1, -1},
+        {4095U, 32767, 32759},
+        {0U, 12345, 0},
+        {8192U, 16383, 32766},
+        {8192U, 20000, 32767},
+        {8192U, -20000, -32768},
+        {65535U, 1, 15},
+        {65535U, -32768, -32768},
+    };
+    int16_t in[2];
+    uint32_t i;
+
+    for(i = 0U; i < COUNTOF(golden); i++) {
+        audio_convert_init(&convert, 1U, 16U, 8000U, 8000U);
+        audio_convert_gain_set(&convert, golden[i].gain);
+        in[0] = golden[i].in;
+        in[1] = golden[i].in;
+        block_load((const uint8_t *)in, 2U);
+        HOST_CHECK_EQ(audio_convert_run(&convert, output, 2U), 1U);
+        if((int16_t)output[0] != golden[i].out) {
+            printf("gain %u\n", (unsigned)golden[i].gain);
+        }
+        HOST_CHECK_EQ((int16_t)output[0], golden[i].out);
+        HOST_CHECK_EQ((int16_t)output[1], golden[i].out);
+    }
+}
+
+/*!
+    \brief      steps of the phase accumulator and exact outputs of the linear interpolation
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_resample_golden(void)
+{
+    static const int16_t in[] = {0, 1000, -1000, 32767, -32768, -1, 1};
+    /* 8 kHz to 16 kHz, every other output halfway between two inputs */
+    static const int16_t up2[] = {0, 500, 1000, 0, -1000, 15883, 32767, -1, -32768, -16385, -1, 0};
+    /* 8 kHz to 12 kHz, outputs at 0, 2/3, 4/3, ... input frames */
+    static const int16_t up15[] = {0, 666, 333, -1000, 21509, 10925, -32765, -10926, -1, 0};
+    /* 16 kHz to 8 kHz, every other input */
+    static const int16_t down2[] = {0, -1000, -32768};
+    uint32_t i, count;
+
+    audio_convert_init(&convert, 1U, 16U, 44100U, 48000U);
+    HOST_CHECK_EQ(convert.step, 60211U);
+    audio_convert_init(&convert, 1U, 16U, 48000U, 44100U);
+    HOST_CHECK_EQ(convert.step, 71331U);
+    audio_convert_init(&convert, 1U, 16U, 11025U, 8000U);
+    HOST_CHECK_EQ(convert.step, 90316U);
+    audio_convert_init(&convert, 1U, 16U, 22050U, 22050U);
+    HOST_CHECK_EQ(convert.step, AUDIO_STEP_UNITY);
+
+    memcpy(input, in, sizeof(in));
+
+    audio_convert_init(&convert, 1U, 16U, 8000U, 16000U);
+    count = resample(COUNTOF(in), output, TEST_FRAMES, 0U);
+    HOST_CHECK_EQ(count, COUNTOF(up2));
+    for(i = 0U; i < COUNTOF(up2); i++) {
+        HOST_CHECK_EQ((int16_t)output[2U * i], up2[i]);
+        HOST_CHECK_EQ((int16_t)output[2U * i + 1U], up2[i]);
+    }
+
+    audio_convert_init(&convert, 1U, 16U, 8000U, 12000U);
+    HOST_CHECK_EQ(convert.step, 43690U);
+    count = resample(COUNTOF(in), output, TEST_FRAMES, 0U);
+    HOST_CHECK_EQ(count, COUNTOF(up15));
+    for(i = 0U; i < COUNTOF(up15); i++) {
+        HOST_CHECK_EQ((int16_t)output[2U * i], up15[i]);
+    }
+
+    audio_convert_init(&convert, 1U, 16U, 16000U, 8000U);
+    count = resample(COUNTOF(in), output, TEST_FRAMES, 0U);
+    HOST_CHECK_EQ(count, COUNTOF(down2));
+    for(i = 0U; i < COUNTOF(down2); i++) {
+        HOST_CHECK_EQ((int16_t)output[2U * i], down2[i]);
+    }
+
+    /* the same rate passes the frames through, the last one waits for the next frame */
+    audio_convert_init(&convert, 1U, 16U, 8000U, 8000U);
+    count = resample(COUNTOF(in), output, TEST_FRAMES, 0U);
+    HOST_CHECK_EQ(count, COUNTOF(in) - 1U);
+    for(i = 0U; i < count; i++) {
+        HOST_CHECK_EQ((int16_t)output[2U * i], in[i]);
+    }
+}
+
+/*!
+    \brief      a 1 kHz left and 440 Hz right sine resampled between common rates, compared
+                with a float linear interpolation at the positions of the phase accumulator,
+                and the same output whatever the block and request sizes
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_resample_sine(void)
+{
+    static const uint32_t rates[][2] = {
+        {44100U, 48000U}, {48000U, 44100U}, {8000U, 48000U}, {11025U, 8000U}, {22050U, 16000U}
+    };
+    double position, fraction, reference, error, worst = 0.0;
+    uint32_t r, n, c, frame, count, number;
+    uint32_t errors = 0U;
+    int32_t previous, next;
+
+    for(r = 0U; r < COUNTOF(rates); r++) {
+        for(n = 0U; n < TEST_FRAMES; n++) {
+            input[2U * n] = (int16_t)lround(32767.0 * sin(2.0 * TEST_PI * 1000.0 * n / rates[r][0]));
+            input[2U * n + 1U] = (int16_t)lround(32767.0 * sin(2.0 * TEST_PI * 440.0 * n / rates[r][0]));
+        }
+        number = (uint32_t)(((uint64_t)(TEST_FRAMES - 1U) * rates[r][1]) / rates[r][0]);
+        if(number > TEST_FRAMES) {
+            number = TEST_FRAMES;
+        }
+
+        audio_convert_init(&convert, 2U, 16U, rates[r][0], rates[r][1]);
+        count = resample(TEST_FRAMES, output, number, 64U);
+        HOST_CHECK_EQ(count, number);
+        audio_convert_init(&convert, 2U, 16U, rates[r][0], rates[r][1]);
+        HOST_CHECK_EQ(resample(TEST_FRAMES, output_chunked, number, 0U), number);
+        HOST_CHECK(0 == memcmp(output, output_chunked, number * 4U));
+
+        for(n = 0U; n < count; n++) {
+            /* output n is at n * step of the input, the step rounded down to Q16 */
+            position = (double)n * convert.step / AUDIO_STEP_UNITY;
+            frame = (uint32_t)position;
+            fraction = position - frame;
+            for(c = 0U; c < 2U; c++) {
+                previous = input[2U * frame + c];
+                next = (frame + 1U < TEST_FRAMES) ? input[2U * (frame + 1U) + c] : previous;
+                reference = previous + (next - previous) * fraction;
+                error = fabs((int16_t)output[2U * n + c] - reference);
+                if(error > worst) {
+                    worst = error;
+                }
+                /* the Q15 fraction and the truncation lose less than 2 LSB */
+                if(error >= 2.0) {
+                    errors++;
+                }
+            }
+        }
+    }
+    printf("worst interpolation error %.2f LSB\n", worst);
+    HOST_CHECK_EQ(errors, 0U);
+}
+
+/*!
+    \brief      the phase accumulator keeps the rate over a second of output
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_rate(void)
+{
+    uint32_t used = 0U;
+    uint32_t done = 0U;
+    uint32_t count;
+
+    memset(input, 0, sizeof(input));
+    audio_convert_init(&convert, 1U, 16U, 44100U, 48000U);
+    while(done < 48000U) {
+        count = 48000U - done;
+        if(count > TEST_FRAMES) {
+            count = TEST_FRAMES;
+        }
+        count = audio_convert_run(&convert, output, count);
+        done += count;
+        if(done < 48000U) {
+            block_load((const uint8_t *)input, AUDIO_CONVERT_FRAME_NUM);
+            used += AUDIO_CONVERT_FRAME_NUM;
+        }
+    }
+    /* input frames taken, less the ones left in the block */
+    used -= convert.number - convert.index;
+    /* 44100 frames, less the 3.3 ppm of the step rounded down, two taken ahead */
+    HOST_CHECK(used >= 44100U);
+    HOST_CHECK(used <= 44102U);
+}
+
+int main(void)
+{
+    srand(12U);
+
+    test_widening();
+    test_gain();
+    test_resample_golden();
+    test_resample_sine();
+    test_rate();
+
+    return host_test_result("audio_convert");
+}
@@ -0,0 +1,370 @@
+/*!
+    \file    test_i2s_codec.c
+    \brief   sample exact I2S output of i2s_codec.c, refilled by the DMA interrupts or
+             sent by the TBE interrupt when TEST_I2S_TBE is defined
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "i2s_model.h"
+#include "i2s_codec.h"
+#ifdef TEST_I2S_TBE
+/* the demo built to send the samples by the SPI0 TBE interrupt */
+#undef I2S_AUDIO_DMA
+#endif /* TEST_I2S_TBE */
+#include "i2s_codec.c"
+#include "wave_source.c"
+#include "audio_convert.c"
+
+#define TEST_FILE_SIZE      12288U
+#define TEST_RING_SIZE      1024U
+
+/* the audio file played */
+static uint8_t file[TEST_FILE_SIZE];
+static uint32_t file_size;
+static uint32_t file_frames;
+static uint8_t file_channels;
+static uint8_t file_bits;
+static wave_source_struct source;
+
+/* every sample of the audio file is different and none of them is 0 */
+static int16_t sample_value(uint32_t index)
+{
+    return (int16_t)(index * 517U - 3000U);
+}
+
+static void put_bytes(const void *data, uint32_t number)
+{
+    memcpy(&file[file_size], data, number);
+    file_size += number;
+}
+
+static void put32(uint32_t value)
+{
+    put_bytes(&value, 4U);
+}
+
+static void put16(uint16_t value)
+{
+    put_bytes(&value, 2U);
+}
+
+/*!
+    \brief      build a PCM audio file
+    \param[in]  channels: 1 or 2
+    \param[in]  bits: 8, 16 or 24
+    \param[in]  rate: sample rate
+    \param[in]  frames: number of frames
+    \param[in]  extra: 1 to add a 'LIST' chunk of odd size, a 'fact' chunk and extra format bytes
+    \param[out] none
+    \retval     none
+*/
+static void file_build(uint8_t channels, uint8_t bits, uint32_t rate, uint32_t frames, uint8_t extra)
+{
+    uint32_t bytes = bits / 8U;
+    uint32_t i, k;
+    int16_t value;
+    uint8_t byte;
+
+    file_size = 0U;
+    file_frames = frames;
+    file_channels = channels;
+    file_bits = bits;
+
+    put_bytes("RIFF", 4U);
+    put32(0U);
+    put_bytes("WAVE", 4U);
+    if(0U != extra) {
+        put_bytes("LIST", 4U);
+        put32(5U);
+        put_bytes("INFO\0\0", 6U);
+    }
+    put_bytes("fmt ", 4U);
+    put32((0U != extra) ? 18U : 16U);
+    put16(WAVE_FORMAT_PCM);
+    put16(channels);
+    put32(rate);
+    put32(rate * channels * bytes);
+    put16((uint16_t)(channels * bytes));
+    put16(bits);
+    if(0U != extra) {
+        put16(0U);
+        put_bytes("fact", 4U);
+        put32(4U);
+        put32(frames);
+    }
+    put_bytes("data", 4U);
+    put32(frames * channels * bytes);
+    for(i = 0U; i < frames * channels; i++) {
+        value = sample_value(i);
+        if(1U == bytes) {
+            byte = (uint8_t)((value >> 8) + 128);
+            put_bytes(&byte, 1U);
+        } else {
+            /* the bytes below the upper 16 bits are dropped by the conversion */
+            byte = 0x5AU;
+            for(k = 2U; k < bytes; k++) {
+                put_bytes(&byte, 1U);
+            }
+            put_bytes(&value, 2U);
+        }
+    }
+    file[4] = (uint8_t)(file_size - 8U);
+    file[5] = (uint8_t)((file_size - 8U) >> 8);
+}
+
+/*!
+    \brief      half word the I2S must send at a position of a looped audio file
+    \param[in]  index: half words sent before
+    \param[out] none
+    \retval     left or right sample
+*/
+static uint16_t expected(uint32_t index)
+{
+    uint32_t frame = (index / 2U) % file_frames;
+    int16_t value;
+
+    if(1U == file_channels) {
+        value = sample_value(frame);
+    } else {
+        value = sample_value(2U * frame + (index & 1U));
+    }
+    if(BITS_PER_SAMPLE_8 == file_bits) {
+        value = (int16_t)(value & 0xFF00);
+    }
+    return (uint16_t)value;
+}
+
+/*!
+    \brief      play the audio file of the internal flash from the start
+    \param[in]  latency: half words sent between a DMA flag and its interrupt
+    \param[out] none
+    \retval     none
+*/
+static void play(uint32_t latency)
+{
+    i2s_model_init(latency);
+    wave_source_flash_init(&source, file, file_size);
+    HOST_CHECK_EQ(i2s_audio_play(&source), VALID_WAVE_FILE);
+}
+
+/*!
+    \brief      count the output half words which differ from the looped audio file
+    \param[in]  none
+    \param[out] none
+    \retval     number of wrong half words
+*/
+static uint32_t output_errors(void)
+{
+    uint32_t errors = 0U;
+    uint32_t i;
+
+    for(i = 0U; (i < i2s_model.sent) && (i < I2S_MODEL_OUTPUT_SIZE); i++) {
+        if(expected(i) != i2s_model.output[i]) {
+            if(0U == errors) {
+                printf("half word %u: 0x%04x, expected 0x%04x\n", (unsigned)i,
+                       (unsigned)i2s_model.output[i], (unsigned)expected(i));
+            }
+            errors++;
+        }
+    }
+    return errors;
+}
+
+/*!
+    \brief      the I2S and the transfer of the samples are configured from the audio file
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_config(void)
+{
+    file_build(CHANNEL_STEREO, BITS_PER_SAMPLE_16, 22050U, 100U, 0U);
+    play(0U);
+
+    HOST_CHECK_EQ(i2s_model.audiosample, 22050U);
+    HOST_CHECK_EQ(i2s_model.frameformat, I2S_FRAMEFORMAT_DT16B_CH16B);
+    HOST_CHECK_EQ(i2s_model.enabled, 1U);
+#ifdef I2S_AUDIO_DMA
+    HOST_CHECK_EQ(i2s_model.tbe_interrupt, 0U);
+    HOST_CHECK_EQ(i2s_model.dmamux_clock, 1U);
+    HOST_CHECK_EQ(i2s_model.dma_channel, I2S_DMA_CHANNEL);
+    HOST_CHECK_EQ(i2s_model.dma_request, DMA_REQUEST_SPI0_TX);
+    HOST_CHECK_EQ(i2s_model.dma_number, I2S_BUFFER_SIZE);
+    HOST_CHECK_EQ(i2s_model.dma_memory_width, DMA_MEMORY_WIDTH_16BIT);
+    HOST_CHECK_EQ(i2s_model.dma_periph_addr, (uint32_t)(uintptr_t)&SPI_DATA(SPI0));
+    HOST_CHECK_EQ(i2s_model.dma_circular, 1U);
+    HOST_CHECK_EQ(i2s_model.dma_interrupts, DMA_INT_HTF | DMA_INT_FTF);
+    HOST_CHECK_EQ(i2s_model.dma_enabled, 1U);
+    HOST_CHECK_EQ(i2s_model.tx_dma, 1U);
+#else
+    HOST_CHECK_EQ(i2s_model.tbe_interrupt, 1U);
+    HOST_CHECK_EQ(i2s_model.tx_dma, 0U);
+#endif /* I2S_AUDIO_DMA */
+}
+
+/*!
+    \brief      mono and stereo files looped many times, the DMA interrupts served late up to
+                just before the DMA reaches the half being refilled
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_loop(void)
+{
+    const uint32_t latency[] = {0U, 1U, 100U, I2S_BUFFER_SIZE / 2U - 1U};
+    uint8_t channels, extra;
+    uint32_t i;
+
+    for(channels = CHANNEL_MONO; channels <= CHANNEL_STEREO; channels++) {
+        for(extra = 0U; extra < 2U; extra++) {
+            for(i = 0U; i < COUNTOF(latency); i++) {
+                /* the loop of 301 frames never lines up with a buffer half */
+                file_build(channels, BITS_PER_SAMPLE_16, 8000U, 301U, extra);
+                play(latency[i]);
+                i2s_model_run(I2S_MODEL_OUTPUT_SIZE);
+
+                HOST_CHECK_EQ(output_errors(), 0U);
+                HOST_CHECK_EQ(i2s_model.underruns, 0U);
+                HOST_CHECK_EQ(i2s_model.missed_flags, 0U);
+#ifdef I2S_AUDIO_DMA
+                /* one interrupt per buffer half, the last one may still be pending */
+                HOST_CHECK_EQ(i2s_model.dma_irqs + ((0U != i2s_model.dma_flags) ? 1U : 0U),
+                              I2S_MODEL_OUTPUT_SIZE / (I2S_BUFFER_SIZE / 2U));
+#else
+                HOST_CHECK_EQ(i2s_model.tbe_irqs, I2S_MODEL_OUTPUT_SIZE);
+#endif /* I2S_AUDIO_DMA */
+            }
+        }
+    }
+
+#ifdef I2S_AUDIO_DMA
+    /* a refill later than a buffer half sends old samples, the model must see it */
+    file_build(CHANNEL_STEREO, BITS_PER_SAMPLE_16, 8000U, 301U, 0U);
+    play(I2S_BUFFER_SIZE / 2U + 16U);
+    i2s_model_run(I2S_MODEL_OUTPUT_SIZE);
+    HOST_CHECK(0U != output_errors());
+#endif /* I2S_AUDIO_DMA */
+}
+
+/*!
+    \brief      8-bit mono and 24-bit stereo files go through the conversion on the same refills
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_convert(void)
+{
+    file_build(CHANNEL_MONO, BITS_PER_SAMPLE_8, 8000U, 301U, 1U);
+    play(I2S_BUFFER_SIZE / 4U);
+    i2s_model_run(I2S_MODEL_OUTPUT_SIZE);
+    HOST_CHECK_EQ(audio_convert_enable, 1U);
+    HOST_CHECK_EQ(output_errors(), 0U);
+    HOST_CHECK_EQ(i2s_model.underruns, 0U);
+
+    file_build(CHANNEL_STEREO, BITS_PER_SAMPLE_24, 8000U, 301U, 0U);
+    play(I2S_BUFFER_SIZE / 4U);
+    i2s_model_run(I2S_MODEL_OUTPUT_SIZE);
+    HOST_CHECK_EQ(audio_convert_enable, 1U);
+    HOST_CHECK_EQ(output_errors(), 0U);
+    HOST_CHECK_EQ(i2s_model.underruns, 0U);
+}
+
+/*!
+    \brief      a stream written to a RAM ring in pieces, faster and slower than it is sent,
+                the output without the silence is the stream, and silence follows its end
+    \param[in]  channels: 1 or 2
+    \param[out] none
+    \retval     none
+*/
+static void test_ring(uint8_t channels)
+{
+    static uint8_t ring[TEST_RING_SIZE];
+    uint32_t fed, number, round, i, k;
+    uint32_t silent = 0U;
+    uint32_t errors = 0U;
+
+    file_build(channels, BITS_PER_SAMPLE_16, 8000U, 1500U, 1U);
+    i2s_model_init(I2S_BUFFER_SIZE / 8U);
+    wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+    fed = wave_source_ring_write(&source, file, 300U);
+    HOST_CHECK_EQ(i2s_audio_play(&source), VALID_WAVE_FILE);
+
+    for(round = 0U; fed < file_size; round++) {
+        i2s_model_run(64U);
+        number = 37U + (round * 53U) % 400U;
+        if(number > (file_size - fed)) {
+            number = file_size - fed;
+        }
+        fed += wave_source_ring_write(&source, &file[fed], number);
+    }
+    /* send what is left in the ring, then silence */
+    i2s_model_run(I2S_MODEL_OUTPUT_SIZE - i2s_model.sent);
+    HOST_CHECK_EQ(i2s_model.sent, I2S_MODEL_OUTPUT_SIZE);
+
+    /* a stereo frame is all silence or all samples */
+    k = 0U;
+    for(i = 0U; i < I2S_MODEL_OUTPUT_SIZE; i += 2U) {
+        if((0U == i2s_model.output[i]) && (0U == i2s_model.output[i + 1U])) {
+            silent++;
+            continue;
+        }
+        if((k >= 2U * file_frames) || (expected(k) != i2s_model.output[i]) ||
+                (expected(k + 1U) != i2s_model.output[i + 1U])) {
+            errors++;
+        }
+        k += 2U;
+    }
+    HOST_CHECK_EQ(errors, 0U);
+    HOST_CHECK_EQ(k, 2U * file_frames);
+    HOST_CHECK(0U != silent);
+    /* the end of the stream is silence */
+    HOST_CHECK_EQ(i2s_model.output[I2S_MODEL_OUTPUT_SIZE - 1U], 0U);
+    HOST_CHECK_EQ(i2s_model.missed_flags, 0U);
+}
+
+int main(void)
+{
+    test_config();
+    test_loop();
+    test_convert();
+    test_ring(CHANNEL_MONO);
+    test_ring(CHANNEL_STEREO);
+
+#ifdef I2S_AUDIO_DMA
+    return host_test_result("i2s_codec_dma");
+#else
+    return host_test_result("i2s_codec_tbe");
+#endif /* I2S_AUDIO_DMA */
+}
@@ -0,0 +1,341 @@
+/*!
+    \file    test_wave_parse.c
+    \brief   RIFF chunk walk of codec_wave_parsing() on a corpus of audio file headers
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "i2s_model.h"
+#include "i2s_codec.c"
+#include "wave_source.c"
+#include "audio_convert.c"
+
+/* bytes of sample data after each header */
+#define TEST_DATA_SIZE      64U
+#define TEST_FILE_SIZE      1024U
+#define TEST_RING_SIZE      1024U
+
+#define CORPUS(h)           (const uint8_t *)(h), (sizeof(h) - 1U)
+
+typedef struct {
+    const char *name;
+    const uint8_t *header;
+    uint32_t size;
+    errorcode_enum error;
+    /* for a valid file */
+    uint32_t datastart;
+    uint32_t datasize;
+    uint16_t channels;
+    uint32_t rate;
+    uint16_t bits;
+} corpus_struct;
+
+/* headers as written by common tools, and broken ones */
+static const corpus_struct corpus[] = {
+    {"sox 44.1k stereo", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00\x10\x00"
+         "data" "\x40\x00\x00\x00"),
+     VALID_WAVE_FILE, 44U, 64U, 2U, 44100U, 16U},
+    {"ffmpeg LIST INFO", CORPUS(
+         "RIFF" "\x86\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x01\x00\x40\x1f\x00\x00\x80\x3e\x00\x00\x02\x00\x10\x00"
+         "LIST" "\x1a\x00\x00\x00" "INFO" "ISFT" "\x0e\x00\x00\x00" "Lavf58.76.100" "\x00"
+         "data" "\x40\x00\x00\x00"),
+     VALID_WAVE_FILE, 78U, 64U, 1U, 8000U, 16U},
+    {"18-byte fmt and fact", CORPUS(
+         "RIFF" "\x72\x00\x00\x00" "WAVE" "fmt " "\x12\x00\x00\x00"
+         "\x01\x00\x01\x00\x11\x2b\x00\x00\x11\x2b\x00\x00\x01\x00\x08\x00\x00\x00"
+         "fact" "\x04\x00\x00\x00" "\x40\x00\x00\x00"
+         "data" "\x40\x00\x00\x00"),
+     VALID_WAVE_FILE, 58U, 64U, 1U, 11025U, 8U},
+    {"odd LIST before fmt", CORPUS(
+         "RIFF" "\x72\x00\x00\x00" "WAVE" "LIST" "\x05\x00\x00\x00" "INFOx" "\x00"
+         "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x80\xbb\x00\x00\x00\x65\x04\x00\x06\x00\x18\x00"
+         "data" "\x40\x00\x00\x00"),
+     VALID_WAVE_FILE, 58U, 64U, 2U, 48000U, 24U},
+    {"streamed, unknown sizes", CORPUS(
+         "RIFF" "\xff\xff\xff\xff" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x00\x77\x01\x00\x00\xb8\x0b\x00\x08\x00\x20\x00"
+         "data" "\xff\xff\xff\xff"),
+     VALID_WAVE_FILE, 44U, 0xFFFFFFFFU, 2U, 96000U, 32U},
+    {"extensible fmt", CORPUS(
+         "RIFF" "\x7c\x00\x00\x00" "WAVE" "fmt " "\x28\x00\x00\x00"
+         "\xfe\xff\x02\x00\x80\xbb\x00\x00\x00\xee\x02\x00\x04\x00\x10\x00\x16\x00\x10\x00"
+         "\x03\x00\x00\x00\x01\x00\x00\x00\x00\x00\x10\x00\x80\x00\x00\xaa\x00\x38\x9b\x71"
+         "data" "\x40\x00\x00\x00"),
+     UNSUPPORETD_FORMATTAG},
+    {"RIFX", CORPUS(
+         "RIFX" "\x64\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00\x10\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNVALID_RIFF_ID},
+    {"AVI form", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "AVI " "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00\x10\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNVALID_WAVE_FORMAT},
+    {"data before fmt", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "WAVE" "data" "\x40\x00\x00\x00" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00\x10\x00"),
+     UNVALID_FORMATCHUNK_ID},
+    {"no data in the RIFF", CORPUS(
+         "RIFF" "\x28\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00\x10\x00"
+         "LIST" "\x04\x00\x00\x00" "INFO"),
+     UNVALID_DATACHUNK_ID},
+    {"no fmt in the RIFF", CORPUS(
+         "RIFF" "\x10\x00\x00\x00" "WAVE" "LIST" "\x04\x00\x00\x00" "INFO"),
+     UNVALID_FORMATCHUNK_ID},
+    {"14-byte fmt", CORPUS(
+         "RIFF" "\x62\x00\x00\x00" "WAVE" "fmt " "\x0e\x00\x00\x00"
+         "\x01\x00\x02\x00\x44\xac\x00\x00\x10\xb1\x02\x00\x04\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNVALID_FORMATCHUNK_ID},
+    {"3 channels", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x03\x00\x44\xac\x00\x00\x98\x09\x04\x00\x06\x00\x10\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNSUPPORETD_NUMBER_OF_CHANNEL},
+    {"4 kHz", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x01\x00\xa0\x0f\x00\x00\x40\x1f\x00\x00\x02\x00\x10\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNSUPPORETD_SAMPLE_RATE},
+    {"12 bits", CORPUS(
+         "RIFF" "\x64\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x01\x00\x40\x1f\x00\x00\x40\x1f\x00\x00\x01\x00\x0c\x00"
+         "data" "\x40\x00\x00\x00"),
+     UNSUPPORETD_BITS_PER_SAMPLE},
+    {"chunk size overflow", CORPUS(
+         "RIFF" "\x6c\x00\x00\x00" "WAVE" "fmt " "\x10\x00\x00\x00"
+         "\x01\x00\x01\x00\x40\x1f\x00\x00\x80\x3e\x00\x00\x02\x00\x10\x00"
+         "LIST" "\xf0\xff\xff\xff" "data" "\x40\x00\x00\x00"),
+     UNVALID_DATACHUNK_ID},
+};
+
+static uint8_t file[TEST_FILE_SIZE];
+static uint32_t file_size;
+static uint8_t ring[TEST_RING_SIZE];
+static wave_source_struct source;
+
+static void put32(uint8_t *buffer, uint32_t value)
+{
+    memcpy(buffer, &value, 4U);
+}
+
+/*!
+    \brief      a header of the corpus followed by the sample data
+    \param[in]  header: audio file header
+    \param[in]  size: size of the header
+    \param[out] none
+    \retval     none
+*/
+static void file_load(const uint8_t *header, uint32_t size)
+{
+    uint32_t i;
+
+    memcpy(file, header, size);
+    for(i = 0U; i < TEST_DATA_SIZE; i++) {
+        file[size + i] = (uint8_t)(0x80U + i);
+    }
+    file_size = size + TEST_DATA_SIZE;
+}
+
+/*!
+    \brief      parse the loaded file from a source and check the result
+    \param[in]  entry: expected result
+    \param[in]  kind: name of the source
+    \param[out] none
+    \retval     none
+*/
+static void parse_check(const corpus_struct *entry, const char *kind)
+{
+    errorcode_enum error;
+    uint8_t first[2];
+
+    wave_source = &source;
+    memset(&wave_struct, 0, sizeof(wave_struct));
+    datastartaddr = 0U;
+    error = codec_wave_parsing();
+    if(error != entry->error) {
+        printf("%s, %s source\n", entry->name, kind);
+    }
+    HOST_CHECK_EQ(error, entry->error);
+    if((VALID_WAVE_FILE != entry->error) || (VALID_WAVE_FILE != error)) {
+        return;
+    }
+
+    HOST_CHECK_EQ(datastartaddr, entry->datastart);
+    HOST_CHECK_EQ(wave_struct.datasize, entry->datasize);
+    HOST_CHECK_EQ(wave_struct.numchannels, entry->channels);
+    HOST_CHECK_EQ(wave_struct.samplerate, entry->rate);
+    HOST_CHECK_EQ(wave_struct.bitspersample, entry->bits);
+    HOST_CHECK_EQ(wave_struct.formattag, WAVE_FORMAT_PCM);
+    /* the source is left on the first sample */
+    HOST_CHECK_EQ(source.position, entry->datastart);
+    HOST_CHECK_EQ(wave_source_read(&source, first, 2U), 2U);
+    HOST_CHECK_EQ(first[0], 0x80U);
+    HOST_CHECK_EQ(first[1], 0x81U);
+}
+
+/*!
+    \brief      every header of the corpus, read from the internal flash and from a RAM ring
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_corpus(void)
+{
+    uint32_t i;
+
+    for(i = 0U; i < COUNTOF(corpus); i++) {
+        file_load(corpus[i].header, corpus[i].size);
+
+        wave_source_flash_init(&source, file, file_size);
+        parse_check(&corpus[i], "flash");
+
+        wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+        HOST_CHECK_EQ(wave_source_ring_write(&source, file, file_size), file_size);
+        parse_check(&corpus[i], "ring");
+    }
+}
+
+/*!
+    \brief      a broadcast wave file, whose 'bext' and 'JUNK' chunks put the samples
+                beyond 255 bytes from the start
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_long_header(void)
+{
+    static const corpus_struct bwf = {"broadcast wave", NULL, 0U, VALID_WAVE_FILE,
+                                      690U, 64U, 2U, 44100U, 16U};
+    const corpus_struct *sox = &corpus[0];
+    uint8_t header[700];
+    uint32_t size = 12U;
+
+    memset(header, 0, sizeof(header));
+    memcpy(header, sox->header, 12U);
+    /* bext: description, originator and the rest of its 602 bytes */
+    memcpy(&header[size], "bext", 4U);
+    put32(&header[size + 4U], 602U);
+    memcpy(&header[size + 8U], "GD32C231C host test", 19U);
+    size += 8U + 602U;
+    memcpy(&header[size], "JUNK", 4U);
+    put32(&header[size + 4U], 28U);
+    size += 8U + 28U;
+    /* fmt and data of the sox header */
+    memcpy(&header[size], sox->header + 12U, sox->size - 12U);
+    size += sox->size - 12U;
+    put32(&header[4], size - 8U + TEST_DATA_SIZE);
+    HOST_CHECK_EQ(size, bwf.datastart);
+
+    file_load(header, size);
+    wave_source_flash_init(&source, file, file_size);
+    parse_check(&bwf, "flash");
+    wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+    HOST_CHECK_EQ(wave_source_ring_write(&source, file, file_size), file_size);
+    parse_check(&bwf, "ring");
+}
+
+/*!
+    \brief      a file cut at every byte of its header, read from the internal flash and
+                from a RAM ring which has not received the rest yet
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_truncated(void)
+{
+    const corpus_struct *sox = &corpus[0];
+    errorcode_enum expected;
+    uint32_t size;
+
+    for(size = 0U; size < sox->size; size++) {
+        if(size < 12U) {
+            expected = UNVALID_RIFF_ID;
+        } else if(size < 36U) {
+            expected = UNVALID_FORMATCHUNK_ID;
+        } else {
+            expected = UNVALID_DATACHUNK_ID;
+        }
+
+        wave_source = &source;
+        wave_source_flash_init(&source, sox->header, size);
+        HOST_CHECK_EQ(codec_wave_parsing(), expected);
+
+        wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+        wave_source_ring_write(&source, sox->header, size);
+        HOST_CHECK_EQ(codec_wave_parsing(), expected);
+    }
+}
+
+/*!
+    \brief      i2s_audio_play() keeps the played data in the file and frames the ring reads
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_play(void)
+{
+    /* streamed file: the data size is unknown and limited to the file */
+    file_load(corpus[4].header, corpus[4].size);
+    i2s_model_init(0U);
+    wave_source_flash_init(&source, file, file_size);
+    HOST_CHECK_EQ(i2s_audio_play(&source), VALID_WAVE_FILE);
+    HOST_CHECK_EQ(dataendaddr, file_size);
+    HOST_CHECK_EQ(source.frame_size, 8U);
+    HOST_CHECK_EQ(i2s_model.audiosample, 96000U);
+
+    /* a data chunk longer than the file */
+    file_load(corpus[1].header, corpus[1].size);
+    put32(&file[74], 0x1000U);
+    wave_source_flash_init(&source, file, file_size);
+    HOST_CHECK_EQ(i2s_audio_play(&source), VALID_WAVE_FILE);
+    HOST_CHECK_EQ(dataendaddr, file_size);
+    HOST_CHECK_EQ(source.frame_size, 2U);
+}
+
+int main(void)
+{
+    test_corpus();
+    test_long_header();
+    test_truncated();
+    test_play();
+
+    return host_test_result("wave_parse");
+}
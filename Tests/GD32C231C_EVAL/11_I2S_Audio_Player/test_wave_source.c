@@ -0,0 +1,326 @@
+/*!
+    \file    test_wave_source.c
+    \brief   internal flash, GD25Q16 SPI flash and RAM ring backends of wave_source.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "gd25q_model.h"
+#include "gd25qxx.c"
+#include "wave_source.c"
+
+/* longer than one spi_flash_buffer_read() */
+#define TEST_FILE_SIZE      70000U
+#define TEST_SPI_ADDRESS    0x12345U
+#define TEST_RING_SIZE      64U
+#define TEST_STREAM_SIZE    20000U
+
+#define OP_FAST_READ        0x0BU
+
+static uint8_t file[TEST_FILE_SIZE];
+/* written by the DMA, static so that its address fits the DMA registers */
+static uint8_t buffer[TEST_FILE_SIZE];
+static uint8_t ring[TEST_RING_SIZE];
+static wave_source_struct source;
+/* the receive started by wave_source_usart_init() */
+static uint32_t usart_rx_periph;
+static usart_dma_rx_callback usart_rx_callback = NULL;
+
+/*!
+    \brief      start the receive of the USART source, the test delivers the bytes
+    \param[in]  usart_periph: USART
+    \param[in]  callback: receive callback
+    \param[out] none
+    \retval     none
+*/
+void usart_dma_rx_init(uint32_t usart_periph, usart_dma_rx_callback callback)
+{
+    usart_rx_periph = usart_periph;
+    usart_rx_callback = callback;
+}
+
+/*!
+    \brief      byte of the test stream
+    \param[in]  offset: offset from the start of the stream
+    \param[out] none
+    \retval     byte
+*/
+static uint8_t stream_byte(uint32_t offset)
+{
+    return (uint8_t)((offset * 7U) ^ (offset >> 8));
+}
+
+/*!
+    \brief      check read bytes against the stream
+    \param[in]  data: bytes read
+    \param[in]  offset: stream offset of the first byte
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     number of wrong bytes
+*/
+static uint32_t stream_errors(const uint8_t *data, uint32_t offset, uint32_t number)
+{
+    uint32_t errors = 0U;
+    uint32_t i;
+
+    for(i = 0U; i < number; i++) {
+        if(stream_byte(offset + i) != data[i]) {
+            errors++;
+        }
+    }
+    return errors;
+}
+
+/*!
+    \brief      the audio file of the internal flash is read and sought up to its size
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_flash(void)
+{
+    wave_source_flash_init(&source, file, 1000U);
+    HOST_CHECK_EQ(source.size, 1000U);
+
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 300U), 300U);
+    HOST_CHECK_EQ(stream_errors(buffer, 0U, 300U), 0U);
+    HOST_CHECK_EQ(source.position, 300U);
+
+    /* backwards and forwards */
+    HOST_CHECK_EQ(wave_source_seek(&source, 10U), SUCCESS);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 5U), 5U);
+    HOST_CHECK_EQ(stream_errors(buffer, 10U, 5U), 0U);
+    HOST_CHECK_EQ(wave_source_seek(&source, 900U), SUCCESS);
+
+    /* the reads stop at the end of the file */
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 300U), 100U);
+    HOST_CHECK_EQ(stream_errors(buffer, 900U, 100U), 0U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 1U), 0U);
+    HOST_CHECK_EQ(wave_source_seek(&source, 1000U), SUCCESS);
+    HOST_CHECK_EQ(wave_source_seek(&source, 1001U), ERROR);
+    HOST_CHECK_EQ(source.position, 1000U);
+}
+
+/*!
+    \brief      the audio file of the SPI flash is read in pieces of at most 0xFFFF bytes
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_spi_flash(void)
+{
+    gd25q_model_init();
+    spi_flash_init();
+    memcpy(&gd25q_model.array[TEST_SPI_ADDRESS], file, TEST_FILE_SIZE);
+
+    wave_source_spi_flash_init(&source, TEST_SPI_ADDRESS, TEST_FILE_SIZE);
+    gd25q_model_log_clear();
+    memset(buffer, 0, sizeof(buffer));
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, TEST_FILE_SIZE), TEST_FILE_SIZE);
+    HOST_CHECK_EQ(stream_errors(buffer, 0U, TEST_FILE_SIZE), 0U);
+    HOST_CHECK_EQ(gd25q_model_log_opcodes(OP_FAST_READ), 2U);
+    HOST_CHECK_EQ(source.position, TEST_FILE_SIZE);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 1U), 0U);
+
+    /* a header read after a seek */
+    HOST_CHECK_EQ(wave_source_seek(&source, 44U), SUCCESS);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 16U), 16U);
+    HOST_CHECK_EQ(stream_errors(buffer, 44U, 16U), 0U);
+    HOST_CHECK_EQ(wave_source_seek(&source, TEST_FILE_SIZE - 3U), SUCCESS);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 16U), 3U);
+    HOST_CHECK_EQ(stream_errors(buffer, TEST_FILE_SIZE - 3U, 3U), 0U);
+
+    HOST_CHECK_EQ(gd25q_model.busy_violations, 0U);
+    HOST_CHECK_EQ(gd25q_model.overruns, 0U);
+    HOST_CHECK_EQ(gd25q_model.dma_order_errors, 0U);
+}
+
+/*!
+    \brief      wraparound, full ring, whole frames and seeks of the RAM ring
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_ring(void)
+{
+    wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+    HOST_CHECK_EQ(source.size, 0xFFFFFFFFU);
+    HOST_CHECK_EQ(source.frame_size, 2U);
+
+    /* nothing to read yet */
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 4U), 0U);
+
+    /* the second write and read wrap at the end of the ring */
+    HOST_CHECK_EQ(wave_source_ring_write(&source, file, 40U), 40U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 40U), 40U);
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[40], 50U), 50U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 50U), 50U);
+    HOST_CHECK_EQ(stream_errors(buffer, 40U, 50U), 0U);
+
+    /* a full ring takes what fits */
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[90], 100U), TEST_RING_SIZE);
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[90 + TEST_RING_SIZE], 1U), 0U);
+    HOST_CHECK_EQ(source.ring_dropped, 100U - TEST_RING_SIZE + 1U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 100U), TEST_RING_SIZE);
+    HOST_CHECK_EQ(stream_errors(buffer, 90U, TEST_RING_SIZE), 0U);
+    HOST_CHECK_EQ(source.position, 90U + TEST_RING_SIZE);
+
+    /* whole frames only */
+    source.frame_size = 6U;
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[154], 10U), 10U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 10U), 6U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 10U), 0U);
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[164], 2U), 2U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 10U), 6U);
+    HOST_CHECK_EQ(stream_errors(buffer, 160U, 6U), 0U);
+    source.frame_size = 2U;
+
+    /* a seek forward beyond the bytes written drops the next ones when they arrive */
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[166], 10U), 10U);
+    HOST_CHECK_EQ(wave_source_seek(&source, 200U), SUCCESS);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 10U), 0U);
+    HOST_CHECK_EQ(wave_source_ring_write(&source, &file[176], 30U), 30U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, 10U), 6U);
+    HOST_CHECK_EQ(stream_errors(buffer, 200U, 6U), 0U);
+
+    /* a stream can't go back */
+    HOST_CHECK_EQ(wave_source_seek(&source, 100U), ERROR);
+    HOST_CHECK_EQ(source.position, 206U);
+}
+
+/*!
+    \brief      a stream written and read in random pieces with random seeks forward
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_ring_random(void)
+{
+    uint32_t written = 0U;
+    uint32_t errors = 0U;
+    uint32_t number, count, offset;
+
+    srand(11U);
+    wave_source_ring_init(&source, ring, TEST_RING_SIZE);
+    source.frame_size = 4U;
+
+    while(source.position < TEST_STREAM_SIZE) {
+        /* producer, e.g. a USART interrupt */
+        number = (uint32_t)rand() % 48U;
+        if(number > (TEST_STREAM_SIZE - written)) {
+            number = TEST_STREAM_SIZE - written;
+        }
+        written += wave_source_ring_write(&source, &file[written], number);
+        HOST_CHECK(source.ring_head - source.ring_tail <= TEST_RING_SIZE);
+
+        /* consumer */
+        if(0U == ((uint32_t)rand() % 16U)) {
+            offset = source.position + 4U * ((uint32_t)rand() % 20U);
+            HOST_CHECK_EQ(wave_source_seek(&source, offset), SUCCESS);
+        }
+        offset = source.position;
+        count = wave_source_read(&source, buffer, 4U * ((uint32_t)rand() % 12U));
+        HOST_CHECK_EQ(count % 4U, 0U);
+        errors += stream_errors(buffer, offset, count);
+        if(written == TEST_STREAM_SIZE) {
+            /* the last seek may go beyond the stream */
+            if(0U != source.ring_skip) {
+                break;
+            }
+        }
+    }
+    HOST_CHECK_EQ(errors, 0U);
+}
+
+/*!
+    \brief      the USART receive fills the ring, in pieces and across frame ends
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void test_usart(void)
+{
+    uint32_t received = 0U, read = 0U, errors = 0U;
+    uint32_t number;
+
+    srand(12U);
+    wave_source_usart_init(&source, ring, TEST_RING_SIZE, USART0);
+    HOST_CHECK_EQ(usart_rx_periph, USART0);
+    HOST_CHECK(NULL != usart_rx_callback);
+    HOST_CHECK_EQ(source.ring_size, TEST_RING_SIZE);
+
+    /* pieces no larger than the room left, as a paced sender gives them */
+    while(read < TEST_STREAM_SIZE) {
+        number = (uint32_t)rand() % (TEST_RING_SIZE - (source.ring_head - source.ring_tail) + 1U);
+        if(number > (TEST_STREAM_SIZE - received)) {
+            number = TEST_STREAM_SIZE - received;
+        }
+        usart_rx_callback(&file[received], number, (0 == (rand() % 4)) ? SET : RESET);
+        received += number;
+
+        number = wave_source_read(&source, buffer, ((uint32_t)rand() % 24U) * source.frame_size);
+        errors += stream_errors(buffer, read, number);
+        read += number;
+        if((received == TEST_STREAM_SIZE) && (0U == number) && (received != read)) {
+            break;
+        }
+    }
+    HOST_CHECK_EQ(read, TEST_STREAM_SIZE);
+    HOST_CHECK_EQ(errors, 0U);
+    HOST_CHECK_EQ(source.ring_dropped, 0U);
+
+    /* a sender too fast for the playback loses the bytes beyond the ring */
+    usart_rx_callback(file, TEST_RING_SIZE + 10U, RESET);
+    HOST_CHECK_EQ(source.ring_dropped, 10U);
+    HOST_CHECK_EQ(wave_source_read(&source, buffer, TEST_RING_SIZE + 10U), TEST_RING_SIZE);
+    HOST_CHECK_EQ(stream_errors(buffer, 0U, TEST_RING_SIZE), 0U);
+}
+
+int main(void)
+{
+    uint32_t i;
+
+    for(i = 0U; i < TEST_FILE_SIZE; i++) {
+        file[i] = stream_byte(i);
+    }
+
+    test_flash();
+    test_spi_flash();
+    test_ring();
+    test_ring_random();
+    test_usart();
+
+    return host_test_result("wave_source");
+}
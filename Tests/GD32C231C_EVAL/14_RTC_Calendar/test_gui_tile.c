@@ -0,0 +1,308 @@
+/*!
+    \file    test_gui_tile.c
+    \brief   tile layer of gui_tile.c against direct drawing, with the SPI bytes per frame
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "lcd_model.h"
+#include "gui.c"
+#include "gui_tile.c"
+
+#define FRAME_ITEM_NUM          12U
+#define RANDOM_FRAME_NUM        400U
+
+typedef struct {
+    gui_tile_item_struct item[FRAME_ITEM_NUM];
+    char text[FRAME_ITEM_NUM][16];
+    uint8_t count;
+} frame_struct;
+
+static uint16_t panel_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+static uint16_t reference_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+
+/*!
+    \brief      draw a frame directly on a cleared panel, keep the result as reference
+    \param[in]  frame: the frame
+    \param[out] none
+    \retval     none
+*/
+static void frame_reference(const frame_struct *frame)
+{
+    const gui_tile_item_struct *item;
+    lcd_model_stat_struct stat = lcd_model_stat;
+    uint8_t i;
+
+    memcpy(panel_fb, lcd_model_fb, sizeof(panel_fb));
+    lcd_model_reset(BLUE);
+    for(i = 0U; i < frame->count; i++) {
+        item = &frame->item[i];
+        if(GUI_TILE_FILL == item->type) {
+            gui_fill_box(item->x, item->y, item->w, item->h, item->fc);
+        } else if(GUI_TILE_FONT == item->type) {
+            gui_draw_font_gbk16(item->x, item->y, item->fc, item->bc, (char *)frame->text[i]);
+        } else {
+            gui_draw_font_num32(item->x, item->y, item->fc, item->bc, item->num);
+        }
+    }
+    memcpy(reference_fb, lcd_model_fb, sizeof(reference_fb));
+    memcpy(lcd_model_fb, panel_fb, sizeof(panel_fb));
+    lcd_model_stat = stat;
+}
+
+/*!
+    \brief      send a frame through the tile layer
+    \param[in]  frame: the frame
+    \param[out] bytes: SPI bytes of the flush
+    \retval     number of tiles sent
+*/
+static uint16_t frame_tiled(const frame_struct *frame, uint32_t *bytes)
+{
+    const gui_tile_item_struct *item;
+    uint32_t start = lcd_model_stat.bytes;
+    uint16_t sent;
+    uint8_t i;
+
+    gui_tile_begin();
+    for(i = 0U; i < frame->count; i++) {
+        item = &frame->item[i];
+        if(GUI_TILE_FILL == item->type) {
+            HOST_CHECK_EQ(gui_tile_fill_rect(item->x, item->y, item->w, item->h, item->fc), SUCCESS);
+        } else if(GUI_TILE_FONT == item->type) {
+            HOST_CHECK_EQ(gui_tile_draw_font(item->x, item->y, item->fc, item->bc, frame->text[i]), SUCCESS);
+        } else {
+            HOST_CHECK_EQ(gui_tile_draw_font_num32(item->x, item->y, item->fc, item->bc, item->num), SUCCESS);
+        }
+    }
+    sent = gui_tile_flush();
+    *bytes = lcd_model_stat.bytes - start;
+
+    return sent;
+}
+
+/*!
+    \brief      check that the panel shows the frame drawn directly
+    \param[in]  frame: the frame
+    \param[out] none
+    \retval     number of pixels which differ
+*/
+static uint32_t frame_mismatch(const frame_struct *frame)
+{
+    uint32_t x, y, bad = 0U;
+
+    frame_reference(frame);
+    for(y = 0U; y < Y_MAX_PIXEL; y++) {
+        for(x = 0U; x < X_MAX_PIXEL; x++) {
+            if(reference_fb[y][x] != lcd_model_fb[y][x]) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+static void frame_add_font(frame_struct *frame, uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s)
+{
+    gui_tile_item_struct *item = &frame->item[frame->count];
+
+    strcpy(frame->text[frame->count], s);
+    item->type = GUI_TILE_FONT;
+    item->x = x;
+    item->y = y;
+    item->w = (uint16_t)(strlen(s) * 8U);
+    item->h = 16U;
+    item->fc = fc;
+    item->bc = bc;
+    item->num = 0U;
+    frame->count++;
+}
+
+static void frame_add_num32(frame_struct *frame, uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num)
+{
+    gui_tile_item_struct *item = &frame->item[frame->count];
+
+    item->type = GUI_TILE_NUM32;
+    item->x = x;
+    item->y = y;
+    item->w = 32U;
+    item->h = 32U;
+    item->fc = fc;
+    item->bc = bc;
+    item->num = num;
+    frame->count++;
+}
+
+/*!
+    \brief      build the clock screen of the 14_RTC_Calendar demo
+    \param[in]  hour, minute, second: the time, BCD
+    \param[out] frame: the frame
+    \retval     none
+*/
+static void frame_clock(frame_struct *frame, uint8_t hour, uint8_t minute, uint8_t second)
+{
+    frame->count = 0U;
+    frame_add_font(frame, 10U, 208U, YELLOW, BLUE, "  Now Time is ");
+    frame_add_font(frame, 20U, 244U, YELLOW, BLUE, "  AM ");
+    frame_add_num32(frame, 60U, 236U, YELLOW, BLUE, hour >> 4);
+    frame_add_num32(frame, 84U, 236U, YELLOW, BLUE, hour & 0x0FU);
+    frame_add_font(frame, 112U, 244U, YELLOW, BLUE, ":");
+    frame_add_num32(frame, 116U, 236U, YELLOW, BLUE, minute >> 4);
+    frame_add_num32(frame, 140U, 236U, YELLOW, BLUE, minute & 0x0FU);
+    frame_add_font(frame, 164U, 244U, YELLOW, BLUE, ":");
+    frame_add_num32(frame, 168U, 236U, YELLOW, BLUE, second >> 4);
+    frame_add_num32(frame, 192U, 236U, YELLOW, BLUE, second & 0x0FU);
+}
+
+/*!
+    \brief      change one primitive of a frame at random
+    \param[in]  frame: the frame
+    \param[out] frame: the frame
+    \retval     none
+*/
+static void frame_mutate(frame_struct *frame)
+{
+    static const uint16_t color[] = {BLUE, WHITE, RED, YELLOW, GRAY1};
+    gui_tile_item_struct *item;
+    uint8_t i, n;
+
+    if((frame->count < FRAME_ITEM_NUM) && (0 == (rand() % 3))) {
+        i = frame->count++;
+    } else if(0U == frame->count) {
+        return;
+    } else {
+        i = (uint8_t)(rand() % frame->count);
+    }
+    item = &frame->item[i];
+
+    item->type = (uint8_t)(rand() % 3);
+    item->x = (uint16_t)(rand() % X_MAX_PIXEL);
+    item->y = (uint16_t)(rand() % Y_MAX_PIXEL);
+    item->fc = color[rand() % 5];
+    item->bc = (0 == (rand() % 4)) ? item->fc : color[rand() % 5];
+    item->num = (uint16_t)(rand() % 10);
+    if(GUI_TILE_FILL == item->type) {
+        item->w = (uint16_t)(1 + rand() % 40);
+        item->h = (uint16_t)(1 + rand() % 40);
+        item->bc = item->fc;
+        item->num = 0U;
+    } else if(GUI_TILE_FONT == item->type) {
+        n = (uint8_t)(1 + rand() % 8);
+        item->w = (uint16_t)(n * 8U);
+        item->h = 16U;
+        item->num = 0U;
+        frame->text[i][n] = 0;
+        while(0U != n--) {
+            frame->text[i][n] = (char)(' ' + rand() % 95);
+        }
+    } else {
+        item->w = 32U;
+        item->h = 32U;
+    }
+}
+
+int main(void)
+{
+    static frame_struct frame;
+    uint32_t i, bytes, total = 0U, peak = 0U;
+    uint16_t sent;
+
+    srand(7);
+    lcd_model_reset(BLUE);
+    gui_tile_init(BLUE);
+
+    /* clock screen: the first frame sends its tiles, the same time sends nothing */
+    frame_clock(&frame, 0x12U, 0x00U, 0x00U);
+    sent = frame_tiled(&frame, &bytes);
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+    printf("clock first frame: %u tiles, %u bytes\n", (unsigned)sent, (unsigned)bytes);
+    sent = frame_tiled(&frame, &bytes);
+    HOST_CHECK_EQ(sent, 0U);
+    HOST_CHECK_EQ(bytes, 0U);
+
+    /* one second later only the 2 x 3 tiles of the last digit are sent */
+    frame_clock(&frame, 0x12U, 0x00U, 0x01U);
+    sent = frame_tiled(&frame, &bytes);
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+    HOST_CHECK_EQ(sent, 6U);
+    HOST_CHECK_EQ(bytes, 6U * (LCD_MODEL_REGION_BYTES + GUI_TILE_PIXELS * 2U));
+    printf("clock next second: %u tiles, %u bytes\n", (unsigned)sent, (unsigned)bytes);
+
+    /* a string changed in place by the caller is seen, the frame keeps its own copy */
+    frame.text[1][3] = 'P';
+    frame_tiled(&frame, &bytes);
+    HOST_CHECK(0U != bytes);
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+
+    /* a color change alone is seen, for every kind of primitive */
+    frame.item[0].fc = WHITE;
+    HOST_CHECK(0U != frame_tiled(&frame, &bytes));
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+    frame.item[2].bc = RED;
+    HOST_CHECK(0U != frame_tiled(&frame, &bytes));
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+
+    /* random frames: every flush leaves the panel equal to the frame drawn directly */
+    for(i = 0U; i < RANDOM_FRAME_NUM; i++) {
+        if(0U != (i % 5U)) {
+            frame_mutate(&frame);
+        }
+        sent = frame_tiled(&frame, &bytes);
+        HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+        if(0U == (i % 5U)) {
+            HOST_CHECK_EQ(sent, 0U);
+        }
+        total += bytes;
+        if(bytes > peak) {
+            peak = bytes;
+        }
+    }
+    printf("random frames: %u bytes per frame on average, %u at most, %u for the whole panel\n",
+           (unsigned)(total / RANDOM_FRAME_NUM), (unsigned)peak,
+           (unsigned)(GUI_TILE_NUM * (LCD_MODEL_REGION_BYTES + GUI_TILE_PIXELS * 2U)));
+
+    /* an invalidated panel is sent again as a whole */
+    gui_tile_invalidate();
+    sent = frame_tiled(&frame, &bytes);
+    HOST_CHECK_EQ(sent, GUI_TILE_NUM);
+    HOST_CHECK_EQ(frame_mismatch(&frame), 0U);
+
+    /* the strings of a frame are limited to GUI_TILE_TEXT_SIZE chars */
+    gui_tile_begin();
+    for(i = 0U; i < GUI_TILE_TEXT_SIZE / 8U; i++) {
+        HOST_CHECK_EQ(gui_tile_draw_font(0U, 0U, WHITE, BLUE, "12345678"), SUCCESS);
+    }
+    HOST_CHECK_EQ(gui_tile_draw_font(0U, 0U, WHITE, BLUE, "9"), ERROR);
+
+    return host_test_result("gui_tile");
+}
@@ -0,0 +1,294 @@
+/*!
+    \file    systick_model.c
+    \brief   SysTick model behind the register accesses of the tickless idle of sched.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stddef.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_cmsis.h"
+#include "systick_model.h"
+
+systick_model_struct systick_model;
+systick_model_reg_struct systick_model_reg;
+systick_model_scb_struct systick_model_scb;
+
+/* the registers as the model left them, a difference is a write of the code */
+static systick_model_reg_struct model_view;
+/* COUNTFLAG was shown by the last access */
+static uint8_t model_flag_shown = 0U;
+static uint8_t model_in_irq = 0U;
+static uint32_t model_seed = 1U;
+static uint32_t model_ext_max = 0U;
+
+static void model_sync(void);
+static void model_show(void);
+
+/*!
+    \brief      pseudo random number
+    \param[in]  none
+    \param[out] none
+    \retval     31-bit random number
+*/
+static uint32_t model_random(void)
+{
+    model_seed = (model_seed * 1103515245U) + 12345U;
+    return (model_seed >> 1) & 0x7FFFFFFFU;
+}
+
+/*!
+    \brief      clear the model
+    \param[in]  cycles: SysTick clocks of 1ms
+    \param[in]  ext_max: longest gap in clocks between the external interrupts, 0 for none
+    \param[in]  seed: seed of the access costs and the interrupt times
+    \param[out] none
+    \retval     none
+*/
+void systick_model_init(uint32_t cycles, uint32_t ext_max, uint32_t seed)
+{
+    memset(&systick_model, 0, sizeof(systick_model));
+    model_seed = seed;
+    model_ext_max = ext_max;
+    model_flag_shown = 0U;
+    model_in_irq = 0U;
+    systick_model.load = cycles - 1U;
+    systick_model.enabled = 1U;
+    systick_model.end = UINT64_MAX;
+    systick_model.ext_next = (0U != ext_max) ? (1U + (model_random() % ext_max)) : UINT64_MAX;
+    systick_model.ext_max = ext_max;
+    systick_model_reg.CTRL = SysTick_CTRL_ENABLE_Msk | SysTick_CTRL_TICKINT_Msk | SysTick_CTRL_CLKSOURCE_Msk;
+    systick_model_reg.LOAD = systick_model.load;
+    systick_model_reg.VAL = 0U;
+    model_view = systick_model_reg;
+}
+
+/*!
+    \brief      run the counter for a number of clocks
+    \param[in]  clocks: number of clocks
+    \param[out] none
+    \retval     none
+*/
+static void model_advance(uint64_t clocks)
+{
+    uint64_t step;
+
+    while(0U != clocks) {
+        step = clocks;
+        if((0U == systick_model.ext_pending) && (systick_model.ext_next > systick_model.clock) &&
+                ((systick_model.ext_next - systick_model.clock) < step)) {
+            step = systick_model.ext_next - systick_model.clock;
+        }
+        if(0U == systick_model.enabled) {
+            /* stopped */
+        } else if(0U == systick_model.val) {
+            /* reloaded on the next clock */
+            systick_model.val = systick_model.load;
+            step = 1U;
+        } else {
+            if(step > systick_model.val) {
+                step = systick_model.val;
+            }
+            systick_model.val -= (uint32_t)step;
+            if(0U == systick_model.val) {
+                systick_model.countflag = 1U;
+                systick_model.tick_pending = 1U;
+            }
+        }
+        systick_model.clock += step;
+        clocks -= step;
+        if(systick_model.clock >= systick_model.ext_next) {
+            systick_model.ext_pending = 1U;
+            systick_model.ext_next = UINT64_MAX;
+        }
+    }
+}
+
+/*!
+    \brief      take the pending interrupts if they are unmasked
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void systick_model_irq(void)
+{
+    if((0U != host_primask) || (0U != model_in_irq)) {
+        return;
+    }
+    model_in_irq = 1U;
+    if(0U != systick_model.tick_pending) {
+        systick_model.tick_pending = 0U;
+        systick_model.ticks++;
+        if(NULL != systick_model.tick_irq) {
+            systick_model.tick_irq();
+        }
+    }
+    if(0U != systick_model.ext_pending) {
+        systick_model.ext_pending = 0U;
+        systick_model.ext_irqs++;
+        systick_model.ext_next = systick_model.clock + 1U + (model_random() % model_ext_max);
+        if(NULL != systick_model.ext_irq) {
+            systick_model.ext_irq();
+        }
+    }
+    model_in_irq = 0U;
+}
+
+/*!
+    \brief      run the core for a number of clocks, the interrupts are taken when unmasked
+    \param[in]  clocks: number of clocks
+    \param[out] none
+    \retval     none
+*/
+void systick_model_run(uint32_t clocks)
+{
+    uint32_t step;
+
+    /* the last register writes take effect before the time goes on */
+    model_sync();
+    /* one step is shorter than a tick, so no tick is lost while the interrupts are unmasked */
+    while(0U != clocks) {
+        step = (clocks > 1000U) ? 1000U : clocks;
+        model_advance(step);
+        clocks -= step;
+        systick_model_irq();
+    }
+    model_show();
+}
+
+/*!
+    \brief      account the writes of the last register access
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_sync(void)
+{
+    uint8_t ctrl_written = 0U;
+
+    if(systick_model_reg.CTRL != model_view.CTRL) {
+        systick_model.enabled = (uint8_t)(systick_model_reg.CTRL & SysTick_CTRL_ENABLE_Msk);
+        ctrl_written = 1U;
+    }
+    if(systick_model_reg.LOAD != model_view.LOAD) {
+        if(systick_model_reg.LOAD > SysTick_LOAD_RELOAD_Msk) {
+            systick_model.load_errors++;
+        }
+        systick_model.load = systick_model_reg.LOAD & SysTick_LOAD_RELOAD_Msk;
+    }
+    if(systick_model_reg.VAL != model_view.VAL) {
+        systick_model.val = 0U;
+        systick_model.countflag = 0U;
+    }
+    /* a read of CTRL clears COUNTFLAG, the other accesses are taken as such a read too */
+    if((0U != model_flag_shown) && (0U == ctrl_written)) {
+        systick_model.countflag = 0U;
+    }
+    model_flag_shown = 0U;
+    model_view = systick_model_reg;
+}
+
+/*!
+    \brief      show the counter in the registers
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void model_show(void)
+{
+    systick_model_reg.CTRL = (systick_model.enabled ? SysTick_CTRL_ENABLE_Msk : 0U) | SysTick_CTRL_TICKINT_Msk |
+                             SysTick_CTRL_CLKSOURCE_Msk | (systick_model.countflag ? SysTick_CTRL_COUNTFLAG_Msk : 0U);
+    systick_model_reg.LOAD = systick_model.load;
+    systick_model_reg.VAL = systick_model.val;
+    model_view = systick_model_reg;
+}
+
+/*!
+    \brief      account the last register access and the clocks of the next one
+    \param[in]  none
+    \param[out] none
+    \retval     the registers
+*/
+systick_model_reg_struct *systick_model_access(void)
+{
+    model_sync();
+    /* the next access takes 1 to 3 clocks */
+    model_advance(1U + (model_random() % 3U));
+    systick_model_irq();
+    model_show();
+    model_flag_shown = systick_model.countflag;
+
+    return &systick_model_reg;
+}
+
+/*!
+    \brief      the ICSR of the pending SysTick interrupt
+    \param[in]  none
+    \param[out] none
+    \retval     the SCB registers
+*/
+systick_model_scb_struct *systick_model_scb_access(void)
+{
+    model_sync();
+    model_advance(1U + (model_random() % 3U));
+    systick_model_irq();
+    model_show();
+    systick_model_scb.ICSR = systick_model.tick_pending ? SCB_ICSR_PENDSTSET_Msk : 0U;
+
+    return &systick_model_scb;
+}
+
+/*!
+    \brief      sleep until an interrupt is pending, it is taken once the interrupts are unmasked
+    \param[in]  sleepmodecmd: WFI_CMD
+    \param[out] none
+    \retval     none
+*/
+void pmu_to_sleepmode(uint8_t sleepmodecmd)
+{
+    uint64_t start = systick_model.clock;
+
+    (void)sleepmodecmd;
+    model_sync();
+    if(0U == host_primask) {
+        systick_model.unmasked_sleeps++;
+    }
+    if((systick_model.clock >= systick_model.end) && (NULL != systick_model.end_hook)) {
+        systick_model.end_hook();
+    }
+    while((0U == systick_model.tick_pending) && (0U == systick_model.ext_pending)) {
+        model_advance(1000U);
+    }
+    systick_model.sleep_clocks += systick_model.clock - start;
+    systick_model.sleeps++;
+    systick_model_irq();
+    model_show();
+}
@@ -0,0 +1,91 @@
+/*!
+    \file    systick_model.h
+    \brief   SysTick model behind the register accesses of the tickless idle of sched.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef SYSTICK_MODEL_H
+#define SYSTICK_MODEL_H
+
+#include <stdint.h>
+
+/* the registers seen by the code, SysTick and SCB point here through systick_model_access() */
+typedef struct {
+    volatile uint32_t CTRL;
+    volatile uint32_t LOAD;
+    volatile uint32_t VAL;
+    volatile uint32_t CALIB;
+} systick_model_reg_struct;
+
+typedef struct {
+    volatile uint32_t ICSR;
+} systick_model_scb_struct;
+
+typedef struct {
+    uint64_t clock;                     /* core clocks since systick_model_init() */
+    uint64_t sleep_clocks;              /* clocks spent in pmu_to_sleepmode() */
+    uint64_t end;                       /* pmu_to_sleepmode() calls the end hook from this clock on */
+    uint64_t ext_next;                  /* clock of the next external interrupt */
+    uint32_t ext_max;                   /* longest gap between the external interrupts, 0 for none */
+    uint32_t sleeps;
+    uint32_t unmasked_sleeps;           /* pmu_to_sleepmode() called with the interrupts unmasked */
+    uint32_t ticks;                     /* SysTick interrupts */
+    uint32_t ext_irqs;
+    uint32_t load_errors;               /* LOAD written above 24 bits */
+    /* counter */
+    uint32_t load;
+    uint32_t val;
+    uint8_t enabled;
+    uint8_t countflag;
+    uint8_t tick_pending;
+    uint8_t ext_pending;
+    /* interrupt handlers and the end of the run */
+    void (*tick_irq)(void);
+    void (*ext_irq)(void);
+    void (*end_hook)(void);
+} systick_model_struct;
+
+extern systick_model_struct systick_model;
+extern systick_model_reg_struct systick_model_reg;
+extern systick_model_scb_struct systick_model_scb;
+
+/* clear the model, the counter runs with the 1ms reload of systick_config() */
+void systick_model_init(uint32_t cycles, uint32_t ext_max, uint32_t seed);
+/* account the last register access and the clocks of the next one, for the SysTick macro */
+systick_model_reg_struct *systick_model_access(void);
+/* the ICSR of the pending SysTick interrupt, for the SCB macro */
+systick_model_scb_struct *systick_model_scb_access(void);
+/* run the core for a number of clocks, the interrupts are taken when unmasked */
+void systick_model_run(uint32_t clocks);
+/* take the pending interrupts if they are unmasked */
+void systick_model_irq(void);
+
+#endif /* SYSTICK_MODEL_H */
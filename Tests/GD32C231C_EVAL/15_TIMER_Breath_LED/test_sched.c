@@ -0,0 +1,409 @@
+/*!
+    \file    test_sched.c
+    \brief   host test of the scheduler: periods, delays and events on a simulated tick, and the
+             tickless idle of sched_run() on a SysTick model
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <setjmp.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_cmsis.h"
+#include "systick_model.h"
+
+/* the SysTick accesses of the idle path go to the model, unmasking takes the pending interrupts */
+#undef SysTick
+#undef SCB
+#undef __enable_irq
+#undef __set_PRIMASK
+#define SysTick             (systick_model_access())
+#define SCB                 (systick_model_scb_access())
+#define __enable_irq        test_enable_irq
+#define __set_PRIMASK       test_set_primask
+
+static void test_enable_irq(void);
+static void test_set_primask(uint32_t primask);
+
+#include "sched.c"
+
+#define TEST_CYCLES         48000U
+/* simulated time of each sched_run() */
+#define TEST_RUN_MS         600000U
+
+uint32_t SystemCoreClock = 48000000U;
+
+static void test_enable_irq(void)
+{
+    host_enable_irq();
+    systick_model_irq();
+}
+
+static void test_set_primask(uint32_t primask)
+{
+    host_set_primask(primask);
+    systick_model_irq();
+}
+
+/* runs and events seen by the core test tasks */
+static uint32_t runs[SCHED_TASK_NUM];
+static uint32_t last[SCHED_TASK_NUM];
+static uint32_t seen[SCHED_TASK_NUM];
+static uint32_t errors;
+static uint32_t advance_in_task;
+static uint8_t oneshot;
+static uint32_t oneshot_due;
+
+static void task_count0(uint32_t events) { runs[0]++; last[0] = sched_tick_get(); seen[0] |= events; }
+static void task_count1(uint32_t events) { runs[1]++; last[1] = sched_tick_get(); seen[1] |= events; }
+static void task_count2(uint32_t events) { runs[2]++; last[2] = sched_tick_get(); seen[2] |= events; }
+
+/* 10ms period without jitter */
+static void task_period(uint32_t events)
+{
+    if((0U != events) || ((0U != runs[0]) && (10U != (sched_tick_get() - last[0])))) {
+        errors++;
+    }
+    last[0] = sched_tick_get();
+    runs[0]++;
+    sched_tick_advance(advance_in_task);
+}
+
+/* event 5 arms a 7ms one-shot */
+static void task_oneshot(uint32_t events)
+{
+    if(0U != (events & SCHED_EVENT(5))) {
+        oneshot_due = sched_tick_get() + 7U;
+        sched_task_delay(oneshot, 7U);
+    } else {
+        if(sched_tick_get() != oneshot_due) {
+            errors++;
+        }
+        runs[3]++;
+    }
+}
+
+static void core_setup(void)
+{
+    systick_model_init(TEST_CYCLES, 0U, 1U);
+    host_primask = 0U;
+    sched_init();
+    memset(runs, 0, sizeof(runs));
+    memset(last, 0, sizeof(last));
+    memset(seen, 0, sizeof(seen));
+    errors = 0U;
+    advance_in_task = 0U;
+}
+
+/* the table size and the parameters */
+static void test_create(void)
+{
+    uint8_t i;
+
+    core_setup();
+    HOST_CHECK_EQ(sched_wait_get(), SCHED_WAIT_FOREVER);
+    HOST_CHECK_EQ(sched_task_create(NULL, 10U, 0U), SCHED_TASK_INVALID);
+    for(i = 0U; i < SCHED_TASK_NUM; i++) {
+        HOST_CHECK_EQ(sched_task_create(task_count0, 0U, SCHED_EVENT(i)), i);
+    }
+    HOST_CHECK_EQ(sched_task_create(task_count0, 10U, 0U), SCHED_TASK_INVALID);
+    /* only events run the tasks */
+    HOST_CHECK_EQ(sched_wait_get(), SCHED_WAIT_FOREVER);
+    /* out of range tasks are ignored */
+    sched_task_delay(SCHED_TASK_NUM, 0U);
+    sched_task_stop(SCHED_TASK_NUM);
+    HOST_CHECK_EQ(sched_wait_get(), SCHED_WAIT_FOREVER);
+}
+
+/* events run every task waiting for them with its own flags only */
+static void test_events(void)
+{
+    core_setup();
+    sched_task_create(task_count0, 0U, SCHED_EVENT(1));
+    sched_task_create(task_count1, 0U, SCHED_EVENT(1) | SCHED_EVENT(2));
+    sched_task_create(task_count2, 50U, SCHED_EVENT(3));
+
+    /* nobody waits for event 9 */
+    sched_event_set(SCHED_EVENT(9));
+    HOST_CHECK_EQ(sched_wait_get(), 50U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0] + runs[1] + runs[2], 0U);
+
+    sched_event_set(SCHED_EVENT(1) | SCHED_EVENT(2));
+    HOST_CHECK_EQ(sched_wait_get(), 0U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 1U);
+    HOST_CHECK_EQ(runs[1], 1U);
+    HOST_CHECK_EQ(runs[2], 0U);
+    HOST_CHECK_EQ(seen[0], SCHED_EVENT(1));
+    HOST_CHECK_EQ(seen[1], SCHED_EVENT(1) | SCHED_EVENT(2));
+    /* taken once */
+    HOST_CHECK_EQ(sched_wait_get(), 50U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 1U);
+
+    /* an event runs a timed task early, its period stays */
+    sched_tick_advance(20U);
+    sched_event_set(SCHED_EVENT(3));
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[2], 1U);
+    HOST_CHECK_EQ(seen[2], SCHED_EVENT(3));
+    HOST_CHECK_EQ(sched_wait_get(), 30U);
+    sched_tick_advance(30U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[2], 2U);
+    HOST_CHECK_EQ(last[2], 50U);
+
+    /* stopped, only events run it */
+    sched_task_stop(2U);
+    HOST_CHECK_EQ(sched_wait_get(), SCHED_WAIT_FOREVER);
+    sched_tick_advance(500U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[2], 2U);
+    sched_event_set(SCHED_EVENT(3));
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[2], 3U);
+}
+
+/* delays restart the period, a long run skips the missed periods */
+static void test_delay(void)
+{
+    core_setup();
+    sched_task_create(task_count0, 100U, 0U);
+    sched_task_create(task_count1, 0U, 0U);
+
+    sched_task_delay(1U, 0U);
+    HOST_CHECK_EQ(sched_wait_get(), 0U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[1], 1U);
+    HOST_CHECK_EQ(sched_wait_get(), 100U);
+
+    sched_tick_advance(40U);
+    sched_task_delay(0U, 3U);
+    HOST_CHECK_EQ(sched_wait_get(), 3U);
+    sched_tick_advance(2U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 0U);
+    sched_tick_advance(1U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 1U);
+    HOST_CHECK_EQ(sched_wait_get(), 100U);
+
+    /* 350ms late: one run, then the period from now */
+    sched_tick_advance(450U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 2U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 2U);
+    HOST_CHECK_EQ(sched_wait_get(), 100U);
+    /* less than a period late: the phase is kept */
+    sched_tick_advance(130U);
+    sched_dispatch();
+    HOST_CHECK_EQ(runs[0], 3U);
+    HOST_CHECK_EQ(sched_wait_get(), 70U);
+    HOST_CHECK_EQ(runs[1], 1U);
+}
+
+/* a million milliseconds across the tick wrap, woken early by random events */
+static void test_wrap(void)
+{
+    uint32_t start, elapsed, wait, step, total = 0U, set = 0U;
+
+    core_setup();
+    srand(23U);
+    sched_tick_advance(0xFFFFFFFFU - 5000U);
+    sched_task_create(task_period, 10U, 0U);
+    sched_task_create(task_count1, 333U, 0U);
+    sched_task_create(task_count2, 0U, SCHED_EVENT(3));
+    oneshot = sched_task_create(task_oneshot, 0U, SCHED_EVENT(5));
+    HOST_CHECK_EQ(sched_wait_get(), 10U);
+    start = sched_tick_get();
+
+    while(total < 1000000U) {
+        sched_dispatch();
+        wait = sched_wait_get();
+        if(0U == wait) {
+            continue;
+        }
+        HOST_CHECK(SCHED_WAIT_FOREVER != wait);
+        HOST_CHECK(wait <= 10U);
+        step = wait;
+        if(0 == (rand() % 4)) {
+            step = (uint32_t)rand() % wait;
+            if(0 != (rand() % 2)) {
+                sched_event_set(SCHED_EVENT(3));
+                set++;
+            } else {
+                sched_event_set(SCHED_EVENT(5));
+            }
+        }
+        sched_tick_advance(step);
+        total += step;
+    }
+    sched_dispatch();
+    elapsed = sched_tick_get() - start;
+    HOST_CHECK_EQ(errors, 0U);
+    HOST_CHECK_EQ(runs[0], elapsed / 10U);
+    HOST_CHECK_EQ(runs[1], elapsed / 333U);
+    HOST_CHECK_EQ(runs[2], set);
+    HOST_CHECK(runs[3] > 1000U);
+}
+
+/* sched_run() against the SysTick model */
+static jmp_buf run_end;
+static uint32_t run_period[2];
+static uint32_t run_count[2];
+static uint32_t run_late, run_drift, run_event_late, run_events;
+static uint64_t run_event_clock;
+
+static void run_end_hook(void)
+{
+    longjmp(run_end, 1);
+}
+
+static void run_ext_irq(void)
+{
+    if(0U == run_event_clock) {
+        run_event_clock = systick_model.clock;
+    }
+    sched_event_set(SCHED_EVENT(1));
+}
+
+/* a task runs within a few milliseconds of its deadline in the model time */
+static void run_check(uint8_t task)
+{
+    uint64_t due = ((uint64_t)run_count[task] + 1U) * run_period[task];
+    uint64_t now = systick_model.clock / TEST_CYCLES;
+    int64_t drift = (int64_t)now - (int64_t)sched_tick_get();
+
+    if(((now + 1U) < due) || (now > (due + 2U))) {
+        run_late++;
+    }
+    if((drift < -1) || (drift > 1)) {
+        run_drift++;
+    }
+    run_count[task]++;
+}
+
+static void run_task_fast(uint32_t events)
+{
+    (void)events;
+    run_check(0U);
+    systick_model_run((uint32_t)rand() % 20000U);
+}
+
+static void run_task_slow(uint32_t events)
+{
+    (void)events;
+    run_check(1U);
+}
+
+/* an event is served before the next tick */
+static void run_task_event(uint32_t events)
+{
+    if(0U == (events & SCHED_EVENT(1))) {
+        run_event_late++;
+    }
+    if((systick_model.clock - run_event_clock) > TEST_CYCLES) {
+        run_event_late++;
+    }
+    run_event_clock = 0U;
+    run_events++;
+    systick_model_run((uint32_t)rand() % 3000U);
+}
+
+/*!
+    \brief      run sched_run() with a fast and a slow task and random events
+    \param[in]  fast: period of the fast task, above the 349ms SysTick range it sleeps in several parts
+    \param[in]  event_gap: longest gap between the events in milliseconds
+    \param[in]  seed: seed of the model
+    \param[out] none
+    \retval     none
+*/
+static void test_tickless(uint32_t fast, uint32_t event_gap, uint32_t seed)
+{
+    uint64_t elapsed;
+
+    run_period[0] = fast;
+    run_period[1] = 1000U;
+    memset(run_count, 0, sizeof(run_count));
+    run_late = 0U;
+    run_drift = 0U;
+    run_event_late = 0U;
+    run_events = 0U;
+    run_event_clock = 0U;
+    systick_model_init(TEST_CYCLES, event_gap * TEST_CYCLES, seed);
+    systick_model.tick_irq = sched_tick_handler;
+    systick_model.ext_irq = run_ext_irq;
+    systick_model.end_hook = run_end_hook;
+    systick_model.end = (uint64_t)TEST_RUN_MS * TEST_CYCLES;
+    host_primask = 0U;
+    srand(seed);
+
+    sched_init();
+    sched_task_create(run_task_fast, run_period[0], 0U);
+    sched_task_create(run_task_slow, run_period[1], 0U);
+    sched_task_create(run_task_event, 0U, SCHED_EVENT(1));
+    if(0 == setjmp(run_end)) {
+        sched_run();
+    }
+    host_primask = 0U;
+
+    elapsed = systick_model.clock / TEST_CYCLES;
+    HOST_CHECK_EQ(systick_model.load_errors, 0U);
+    HOST_CHECK_EQ(systick_model.unmasked_sleeps, 0U);
+    HOST_CHECK_EQ(run_late, 0U);
+    HOST_CHECK_EQ(run_drift, 0U);
+    HOST_CHECK_EQ(run_event_late, 0U);
+    HOST_CHECK(elapsed >= TEST_RUN_MS);
+    /* the time is kept across the long sleeps */
+    HOST_CHECK(llabs((long long)elapsed - (long long)sched_tick_get()) <= 1);
+    HOST_CHECK(run_count[0] >= ((TEST_RUN_MS / run_period[0]) - 1U));
+    HOST_CHECK(run_count[1] >= ((TEST_RUN_MS / run_period[1]) - 1U));
+    HOST_CHECK(run_events > (TEST_RUN_MS / event_gap / 4U));
+    HOST_CHECK(run_events <= systick_model.ext_irqs);
+    /* tickless: far fewer interrupts than milliseconds, asleep most of the time */
+    HOST_CHECK(systick_model.ticks < (uint32_t)(elapsed / 5U));
+    HOST_CHECK((systick_model.sleep_clocks * 100U) > (systick_model.clock * 95U));
+}
+
+int main(void)
+{
+    test_create();
+    test_events();
+    test_delay();
+    test_wrap();
+    test_tickless(40U, 4000U, 24U);
+    test_tickless(700U, 20000U, 25U);
+
+    return host_test_result("sched");
+}
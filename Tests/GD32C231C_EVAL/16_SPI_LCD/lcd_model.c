@@ -0,0 +1,277 @@
+/*!
+    \file    lcd_model.c
+    \brief   frame buffer model of the lcd driver interface for the gui tests
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "lcd_model.h"
+
+/* the pin of LCD_CS_SET and LCD_CS_CLR */
+#define MODEL_CS_PIN            GPIO_PIN_8
+
+uint16_t lcd_model_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+lcd_model_stat_struct lcd_model_stat;
+
+/* write window and position of the panel */
+static uint16_t model_xs, model_xe, model_ye, model_x, model_y;
+
+/* the DMA transfer not yet sent to the panel */
+static uint32_t model_pending;
+static const uint16_t *model_pending_pixels;
+static uint16_t model_pending_color;
+static lcd_dma_callback model_pending_callback;
+
+/*!
+    \brief      write one pixel at the panel position and move to the next one
+    \param[in]  color: the pixel
+    \param[out] none
+    \retval     none
+*/
+static void lcd_model_put(uint16_t color)
+{
+    if((model_x < X_MAX_PIXEL) && (model_y < Y_MAX_PIXEL) && (model_y <= model_ye)) {
+        lcd_model_fb[model_y][model_x] = color;
+    }
+    lcd_model_stat.bytes += 2U;
+    if(model_x >= model_xe) {
+        model_x = model_xs;
+        model_y++;
+    } else {
+        model_x++;
+    }
+}
+
+/*!
+    \brief      check the chip select writes since the last driver call, then finish
+                the pending DMA transfer like the driver does before its next access
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void lcd_model_sync(void)
+{
+    lcd_dma_callback callback;
+
+    if(0U != (GPIO_BOP(GPIOA) & MODEL_CS_PIN)) {
+        lcd_model_stat.cs_writes++;
+        if(0U != model_pending) {
+            lcd_model_stat.cs_breaks++;
+        }
+    }
+    if(0U != (GPIO_BC(GPIOA) & MODEL_CS_PIN)) {
+        lcd_model_stat.cs_writes++;
+    }
+    GPIO_BOP(GPIOA) = 0U;
+    GPIO_BC(GPIOA) = 0U;
+
+    while(0U != model_pending) {
+        model_pending--;
+        if(NULL != model_pending_pixels) {
+            lcd_model_put(*model_pending_pixels++);
+        } else {
+            lcd_model_put(model_pending_color);
+        }
+    }
+    callback = model_pending_callback;
+    model_pending_callback = NULL;
+    if(NULL != callback) {
+        callback();
+    }
+}
+
+/*!
+    \brief      drop the pending DMA transfer and clear the counters
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void lcd_model_clear(void)
+{
+    model_pending = 0U;
+    model_pending_callback = NULL;
+    GPIO_BOP(GPIOA) = 0U;
+    GPIO_BC(GPIOA) = 0U;
+    memset(&lcd_model_stat, 0, sizeof(lcd_model_stat));
+}
+
+/*!
+    \brief      fill the panel with a color and clear the counters
+    \param[in]  color: the pixel
+    \param[out] none
+    \retval     none
+*/
+void lcd_model_reset(uint16_t color)
+{
+    uint32_t x, y;
+
+    for(y = 0U; y < Y_MAX_PIXEL; y++) {
+        for(x = 0U; x < X_MAX_PIXEL; x++) {
+            lcd_model_fb[y][x] = color;
+        }
+    }
+    lcd_model_clear();
+}
+
+/*!
+    \brief      fill the panel with a pattern and clear the counters
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void lcd_model_reset_pattern(void)
+{
+    uint32_t x, y;
+
+    for(y = 0U; y < Y_MAX_PIXEL; y++) {
+        for(x = 0U; x < X_MAX_PIXEL; x++) {
+            lcd_model_fb[y][x] = (uint16_t)(x * 0x0841U + y * 0x1003U);
+        }
+    }
+    lcd_model_clear();
+}
+
+/* lcd driver interface */
+void delay_ms(uint32_t count)
+{
+    (void)count;
+}
+
+void lcd_init(void)
+{
+}
+
+void lcd_set_region(uint16_t x_start, uint16_t y_start, uint16_t x_end, uint16_t y_end)
+{
+    lcd_model_sync();
+    model_xs = x_start;
+    model_xe = x_end;
+    model_ye = y_end;
+    model_x = x_start;
+    model_y = y_start;
+    lcd_model_stat.windows++;
+    lcd_model_stat.bytes += LCD_MODEL_REGION_BYTES;
+}
+
+void lcd_set_xy(uint16_t x, uint16_t y)
+{
+    lcd_model_sync();
+    model_xs = x;
+    model_xe = X_MAX_PIXEL - 1U;
+    model_ye = Y_MAX_PIXEL - 1U;
+    model_x = x;
+    model_y = y;
+    lcd_model_stat.windows++;
+    lcd_model_stat.bytes += LCD_MODEL_XY_BYTES;
+}
+
+void gui_draw_point(uint16_t x, uint16_t y, uint16_t data)
+{
+    lcd_set_xy(x, y);
+    lcd_model_put(data);
+    lcd_model_stat.points++;
+}
+
+void lcd_clear(uint16_t color)
+{
+    lcd_fill_rect(0U, 0U, X_MAX_PIXEL, Y_MAX_PIXEL, color, NULL);
+    lcd_dma_wait();
+}
+
+void lcd_fill_rect(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color, lcd_dma_callback callback)
+{
+    uint32_t number;
+
+    if((0U == w) || (0U == h)) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+    lcd_set_region(x, y, x + w - 1U, y + h - 1U);
+    number = (uint32_t)w * h;
+    if(number < LCD_DMA_MIN_PIXELS) {
+        lcd_model_stat.cpu_fills++;
+        while(0U != number--) {
+            lcd_model_put(color);
+        }
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+    lcd_model_stat.transfers++;
+    model_pending = number;
+    model_pending_pixels = NULL;
+    model_pending_color = color;
+    model_pending_callback = callback;
+}
+
+void lcd_write_pixels(const uint16_t *pixels, uint32_t number, lcd_dma_callback callback)
+{
+    lcd_model_sync();
+    if(0U == number) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+    lcd_model_stat.transfers++;
+    model_pending = number;
+    model_pending_pixels = pixels;
+    model_pending_callback = callback;
+}
+
+void lcd_blit(uint16_t x, uint16_t y, uint16_t w, uint16_t h, const uint16_t *pixels, lcd_dma_callback callback)
+{
+    if((0U == w) || (0U == h)) {
+        if(NULL != callback) {
+            callback();
+        }
+        return;
+    }
+    lcd_set_region(x, y, x + w - 1U, y + h - 1U);
+    lcd_write_pixels(pixels, (uint32_t)w * h, callback);
+}
+
+FlagStatus lcd_dma_busy(void)
+{
+    return (0U != model_pending) ? SET : RESET;
+}
+
+void lcd_dma_wait(void)
+{
+    lcd_model_sync();
+}
+
+void lcd_dma_irq_handler(void)
+{
+}
@@ -0,0 +1,66 @@
+/*!
+    \file    lcd_model.h
+    \brief   frame buffer model of the lcd driver interface for the gui tests
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef LCD_MODEL_H
+#define LCD_MODEL_H
+
+#include "lcd_driver.h"
+
+/* bytes the real driver sends on the SPI for each call */
+#define LCD_MODEL_REGION_BYTES      11U
+#define LCD_MODEL_XY_BYTES          7U
+
+typedef struct {
+    uint32_t bytes;          /* bytes on the SPI, commands and pixels */
+    uint32_t windows;        /* lcd_set_region and lcd_set_xy calls */
+    uint32_t points;         /* gui_draw_point calls */
+    uint32_t transfers;      /* DMA transfers started */
+    uint32_t cpu_fills;      /* short fills sent by the CPU */
+    uint32_t cs_writes;      /* chip select driven outside the driver */
+    uint32_t cs_breaks;      /* chip select raised while a DMA transfer is pending */
+} lcd_model_stat_struct;
+
+/* DMA transfers only reach the panel in lcd_dma_wait or the next driver call,
+   the driver owns the chip select, the gui must not drive it */
+
+/* the panel, row by row */
+extern uint16_t lcd_model_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+extern lcd_model_stat_struct lcd_model_stat;
+
+/* fill the panel with a color and clear the counters */
+void lcd_model_reset(uint16_t color);
+/* fill the panel with a pattern and clear the counters */
+void lcd_model_reset_pattern(void);
+
+#endif /* LCD_MODEL_H */
@@ -0,0 +1,363 @@
+/*!
+    \file    test_gui_shapes.c
+    \brief   span drawing of the gui.c shapes against the per-point rendering, with
+             the SPI bytes of each primitive
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "lcd_model.h"
+#include "gui.c"
+
+#define RANDOM_LINE_NUM         2000U
+
+static uint16_t reference_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+
+/* per-point rendering of the original gui.c */
+static void reference_circle(uint16_t x, uint16_t y, uint16_t r, uint16_t fc)
+{
+    int a = 0, b = r, c = 3 - 2 * r;
+
+    while(a <= b) {
+        gui_draw_point(x + a, y + b, fc);
+        gui_draw_point(x - a, y + b, fc);
+        gui_draw_point(x + a, y - b, fc);
+        gui_draw_point(x - a, y - b, fc);
+        gui_draw_point(x + b, y + a, fc);
+        gui_draw_point(x - b, y + a, fc);
+        gui_draw_point(x + b, y - a, fc);
+        gui_draw_point(x - b, y - a, fc);
+        if(a == b) {
+            break;
+        }
+        if(c < 0) {
+            c = c + 4 * a + 6;
+        } else {
+            c = c + 4 * (a - b) + 10;
+            b -= 1;
+        }
+        a += 1;
+    }
+}
+
+static void reference_line(uint16_t x0, uint16_t y0, uint16_t x1, uint16_t y1, uint16_t color)
+{
+    int dx = x1 - x0, dy = y1 - y0, x_inc = 1, y_inc = 1, error, index;
+    int x = x0, y = y0;
+
+    if(dx < 0) {
+        x_inc = -1;
+        dx = -dx;
+    }
+    if(dy < 0) {
+        y_inc = -1;
+        dy = -dy;
+    }
+
+    if(dx > dy) {
+        error = 2 * dy - dx;
+        for(index = 0; index <= dx; index++) {
+            gui_draw_point(x, y, color);
+            if(0 <= error) {
+                error -= 2 * dx;
+                y += y_inc;
+            }
+            error += 2 * dy;
+            x += x_inc;
+        }
+    } else {
+        error = 2 * dx - dy;
+        for(index = 0; index <= dy; index++) {
+            gui_draw_point(x, y, color);
+            if(0 <= error) {
+                error -= 2 * dy;
+                x += x_inc;
+            }
+            error += 2 * dx;
+            y += y_inc;
+        }
+    }
+}
+
+static void reference_rect(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2, uint16_t fc)
+{
+    int ix, iy;
+
+    for(ix = x1; ix < x2; ix++) {
+        for(iy = y1; iy < y2; iy++) {
+            gui_draw_point(ix, iy, fc);
+        }
+    }
+}
+
+static void reference_box(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t bc)
+{
+    reference_line(x, y, x + w, y, 0xEF7D);
+    reference_line(x + w - 1, y + 1, x + w - 1, y + 1 + h, 0x2965);
+    reference_line(x, y + h, x + w, y + h, 0x2965);
+    reference_line(x, y, x, y + h, 0xEF7D);
+    reference_line(x + 1, y + 1, x + 1 + w - 2, y + 1 + h - 2, bc);
+}
+
+static void reference_button_down(uint16_t x1, uint16_t y1, uint16_t x2, uint16_t y2)
+{
+    reference_line(x1, y1, x2, y1, GRAY2);
+    reference_line(x1 + 1, y1 + 1, x2, y1 + 1, GRAY1);
+    reference_line(x1, y1, x1, y2, GRAY2);
+    reference_line(x1 + 1, y1 + 1, x1 + 1, y2, GRAY1);
+    reference_line(x1, y2, x2, y2, WHITE);
+    reference_line(x2, y1, x2, y2, WHITE);
+}
+
+/*!
+    \brief      keep the panel drawn by the reference and start again from the pattern
+    \param[in]  none
+    \param[out] none
+    \retval     SPI bytes of the reference
+*/
+static uint32_t reference_done(void)
+{
+    uint32_t bytes = lcd_model_stat.bytes;
+
+    memcpy(reference_fb, lcd_model_fb, sizeof(reference_fb));
+    lcd_model_reset_pattern();
+    return bytes;
+}
+
+/*!
+    \brief      compare the panel with the one drawn by the reference
+    \param[in]  none
+    \param[out] none
+    \retval     number of pixels which differ
+*/
+static uint32_t reference_mismatch(void)
+{
+    uint32_t x, y, bad = 0U;
+
+    for(y = 0U; y < Y_MAX_PIXEL; y++) {
+        for(x = 0U; x < X_MAX_PIXEL; x++) {
+            if(reference_fb[y][x] != lcd_model_fb[y][x]) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+/*!
+    \brief      check that a primitive is on the panel on return and left the chip select to the driver
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void shape_check_cs(void)
+{
+    HOST_CHECK_EQ(lcd_dma_busy(), RESET);
+    lcd_dma_wait();
+    HOST_CHECK_EQ(lcd_model_stat.cs_writes, 0U);
+    HOST_CHECK_EQ(lcd_model_stat.cs_breaks, 0U);
+}
+
+/*!
+    \brief      report the SPI bytes of a primitive drawn both ways
+    \param[in]  name: the primitive
+    \param[in]  reference_bytes: bytes of the per-point rendering
+    \param[out] none
+    \retval     none
+*/
+static void shape_report(const char *name, uint32_t reference_bytes)
+{
+    shape_check_cs();
+    printf("%-24s per-point %7u bytes, spans %6u bytes, %3u windows\n", name, (unsigned)reference_bytes,
+           (unsigned)lcd_model_stat.bytes, (unsigned)lcd_model_stat.windows);
+    HOST_CHECK_EQ(reference_mismatch(), 0U);
+    HOST_CHECK(lcd_model_stat.bytes < reference_bytes);
+}
+
+/*!
+    \brief      check that every row of the filled circle spans the outline of the circle
+    \param[in]  x, y, r: the circle
+    \param[out] none
+    \retval     number of rows which differ
+*/
+static uint32_t fill_circle_mismatch(uint16_t x, uint16_t y, uint16_t r)
+{
+    int row, col, first, last, count, bad = 0;
+
+    lcd_model_reset(BLACK);
+    reference_circle(x, y, r, WHITE);
+    memcpy(reference_fb, lcd_model_fb, sizeof(reference_fb));
+    lcd_model_reset(BLACK);
+    gui_fill_circle(x, y, r, RED);
+
+    for(row = 0; row < Y_MAX_PIXEL; row++) {
+        int outline_first = X_MAX_PIXEL, outline_last = -1;
+        for(col = 0; col < X_MAX_PIXEL; col++) {
+            if(WHITE == reference_fb[row][col]) {
+                if(col < outline_first) {
+                    outline_first = col;
+                }
+                outline_last = col;
+            }
+        }
+        first = X_MAX_PIXEL;
+        last = -1;
+        count = 0;
+        for(col = 0; col < X_MAX_PIXEL; col++) {
+            if(RED == lcd_model_fb[row][col]) {
+                if(col < first) {
+                    first = col;
+                }
+                last = col;
+                count++;
+            }
+        }
+        if((first != outline_first) || (last != outline_last) || ((last >= 0) && (count != last - first + 1))) {
+            bad++;
+        }
+    }
+    return (uint32_t)bad;
+}
+
+int main(void)
+{
+    uint32_t bytes, i, bad = 0U;
+    uint16_t r, x0, y0, x1, y1;
+
+    srand(11);
+
+    lcd_model_reset_pattern();
+    reference_circle(120U, 160U, 60U, RED);
+    bytes = reference_done();
+    gui_circle(120U, 160U, 60U, RED);
+    shape_report("circle r=60", bytes);
+
+    lcd_model_reset_pattern();
+    reference_circle(10U, 300U, 40U, RED);
+    bytes = reference_done();
+    gui_circle(10U, 300U, 40U, RED);
+    shape_report("circle r=40 clipped", bytes);
+
+    lcd_model_reset_pattern();
+    reference_line(10U, 20U, 230U, 90U, WHITE);
+    bytes = reference_done();
+    gui_draw_line(10U, 20U, 230U, 90U, WHITE);
+    shape_report("line shallow", bytes);
+
+    lcd_model_reset_pattern();
+    reference_line(200U, 300U, 150U, 10U, WHITE);
+    bytes = reference_done();
+    gui_draw_line(200U, 300U, 150U, 10U, WHITE);
+    shape_report("line steep", bytes);
+
+    lcd_model_reset_pattern();
+    reference_line(0U, 100U, 239U, 100U, WHITE);
+    bytes = reference_done();
+    gui_draw_line(0U, 100U, 239U, 100U, WHITE);
+    shape_report("line horizontal", bytes);
+    HOST_CHECK_EQ(lcd_model_stat.windows, 1U);
+
+    lcd_model_reset_pattern();
+    reference_rect(20U, 30U, 120U, 90U, GREEN);
+    bytes = reference_done();
+    gui_rect(20U, 30U, 120U, 90U, GREEN);
+    shape_report("rect 100x60", bytes);
+    HOST_CHECK_EQ(lcd_model_stat.bytes, LCD_MODEL_REGION_BYTES + 100U * 60U * 2U);
+
+    lcd_model_reset_pattern();
+    reference_box(30U, 40U, 80U, 50U, GRAY0);
+    bytes = reference_done();
+    gui_box(30U, 40U, 80U, 50U, GRAY0);
+    shape_report("box 80x50", bytes);
+
+    lcd_model_reset_pattern();
+    reference_button_down(60U, 200U, 180U, 240U);
+    bytes = reference_done();
+    display_button_down(60U, 200U, 180U, 240U);
+    shape_report("button down", bytes);
+
+    /* the other framed shapes have no reference, only the chip select is checked */
+    for(i = 0U; i < 3U; i++) {
+        lcd_model_reset_pattern();
+        gui_box2(20U, 20U + i * 40U, 100U, 30U, (uint8_t)i);
+        shape_check_cs();
+    }
+    lcd_model_reset_pattern();
+    display_button_up(60U, 200U, 180U, 240U);
+    shape_check_cs();
+
+    /* random lines, also beyond the panel */
+    for(i = 0U; i < RANDOM_LINE_NUM; i++) {
+        x0 = (uint16_t)(rand() % (X_MAX_PIXEL + 40U));
+        y0 = (uint16_t)(rand() % (Y_MAX_PIXEL + 40U));
+        x1 = (uint16_t)(rand() % (X_MAX_PIXEL + 40U));
+        y1 = (uint16_t)(rand() % (Y_MAX_PIXEL + 40U));
+        lcd_model_reset_pattern();
+        reference_line(x0, y0, x1, y1, YELLOW);
+        reference_done();
+        gui_draw_line(x0, y0, x1, y1, YELLOW);
+        if(0U != reference_mismatch()) {
+            bad++;
+        }
+    }
+    HOST_CHECK_EQ(bad, 0U);
+
+    /* random circles, also beyond the panel */
+    bad = 0U;
+    for(r = 0U; r < 130U; r++) {
+        x0 = (uint16_t)(rand() % X_MAX_PIXEL);
+        y0 = (uint16_t)(rand() % Y_MAX_PIXEL);
+        lcd_model_reset_pattern();
+        reference_circle(x0, y0, r, YELLOW);
+        reference_done();
+        gui_circle(x0, y0, r, YELLOW);
+        if(0U != reference_mismatch()) {
+            bad++;
+        }
+        /* the fill spans end on the outline where the whole circle is visible */
+        if((x0 >= r) && (y0 >= r) && (x0 + r < X_MAX_PIXEL) && (y0 + r < Y_MAX_PIXEL)) {
+            bad += fill_circle_mismatch(x0, y0, r);
+        }
+    }
+    HOST_CHECK_EQ(bad, 0U);
+
+    /* the filled circle has no per-point counterpart, only its cost is reported */
+    HOST_CHECK_EQ(fill_circle_mismatch(120U, 160U, 60U), 0U);
+    lcd_model_reset(BLACK);
+    gui_fill_circle(120U, 160U, 60U, RED);
+    printf("%-24s spans %6u bytes, %3u windows\n", "fill circle r=60", (unsigned)lcd_model_stat.bytes,
+           (unsigned)lcd_model_stat.windows);
+
+    return host_test_result("gui_shapes");
+}
@@ -0,0 +1,251 @@
+/*!
+    \file    test_gui_text.c
+    \brief   glyph runs of gui.c against the per-point rendering of the fonts
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "lcd_model.h"
+#include "gui.c"
+
+static uint16_t reference_fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+
+/*!
+    \brief      draw one glyph row byte point by point, as the original gui.c did
+    \param[in]  x: the x position of the leftmost pixel
+    \param[in]  y: the y position of the row
+    \param[in]  bits: font bits, msb is the leftmost pixel
+    \param[in]  fc: color of the set bits
+    \param[in]  bc: color of the cleared bits, not drawn if it equals fc
+    \param[out] none
+    \retval     none
+*/
+static void reference_bits(uint16_t x, uint16_t y, uint8_t bits, uint16_t fc, uint16_t bc)
+{
+    uint8_t j;
+
+    for(j = 0U; j < 8U; j++) {
+        if(bits & (0x80U >> j)) {
+            gui_draw_point(x + j, y, fc);
+        } else if(fc != bc) {
+            gui_draw_point(x + j, y, bc);
+        }
+    }
+}
+
+static void reference_font_gbk16(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s)
+{
+    uint16_t i, k, x0 = x;
+
+    for(; 0 != *s; s++) {
+        k = (uint8_t)*s;
+        if(13U == k) {
+            x = x0;
+            y += 16U;
+            continue;
+        }
+        if(k >= 128U) {
+            continue;
+        }
+        k = (k > 32U) ? (k - 32U) : 0U;
+        for(i = 0U; i < 16U; i++) {
+            reference_bits(x, y + i, asc16[k * 16U + i], fc, bc);
+        }
+        x += 8U;
+    }
+}
+
+static void reference_characters(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, const char *s, uint16_t size)
+{
+    uint16_t i, j, k, stride = size / 8U;
+    const char *msk;
+
+    for(; 0 != *s; s += 3, x += size) {
+        msk = NULL;
+        for(k = 0U; k < ((16U == size) ? hz16_num : hz24_num); k++) {
+            const unsigned char *index = (16U == size) ? hz16[k].Index : hz24[k].Index;
+            if((index[0] == (uint8_t)s[0]) && (index[1] == (uint8_t)s[1])) {
+                msk = (16U == size) ? hz16[k].Msk : hz24[k].Msk;
+                break;
+            }
+        }
+        if(NULL == msk) {
+            continue;
+        }
+        for(i = 0U; i < size; i++) {
+            for(j = 0U; j < stride; j++) {
+                reference_bits(x + j * 8U, y + i, (uint8_t)msk[i * stride + j], fc, bc);
+            }
+        }
+    }
+}
+
+static void reference_font_num32(uint16_t x, uint16_t y, uint16_t fc, uint16_t bc, uint16_t num)
+{
+    uint16_t i, j;
+
+    for(i = 0U; i < 32U; i++) {
+        for(j = 0U; j < 4U; j++) {
+            reference_bits(x + j * 8U, y + i, sz32[num * 32U * 4U + i * 4U + j], fc, bc);
+        }
+    }
+}
+
+typedef enum {
+    TEXT_GBK16 = 0,
+    TEXT_GBK24,
+    TEXT_HZ16,
+    TEXT_HZ24,
+    TEXT_NUM32
+} text_kind_enum;
+
+typedef struct {
+    text_kind_enum kind;
+    uint16_t x, y, fc, bc;
+    const char *s;
+    uint16_t num;
+} text_case_struct;
+
+/*!
+    \brief      render a case with gui.c and with the reference, compare the panels
+    \param[in]  c: the case
+    \param[out] gui_bytes: SPI bytes of gui.c
+    \param[out] reference_bytes: SPI bytes of the per-point rendering
+    \retval     number of pixels which differ
+*/
+static uint32_t text_compare(const text_case_struct *c, uint32_t *gui_bytes, uint32_t *reference_bytes)
+{
+    uint32_t x, y, bad = 0U;
+
+    lcd_model_reset_pattern();
+    switch(c->kind) {
+    case TEXT_GBK16:
+    case TEXT_GBK24:
+        reference_font_gbk16(c->x, c->y, c->fc, c->bc, c->s);
+        break;
+    case TEXT_HZ16:
+        reference_characters(c->x, c->y, c->fc, c->bc, c->s, 16U);
+        break;
+    case TEXT_HZ24:
+        reference_characters(c->x, c->y, c->fc, c->bc, c->s, 24U);
+        break;
+    default:
+        reference_font_num32(c->x, c->y, c->fc, c->bc, c->num);
+        break;
+    }
+    memcpy(reference_fb, lcd_model_fb, sizeof(reference_fb));
+    *reference_bytes = lcd_model_stat.bytes;
+
+    lcd_model_reset_pattern();
+    switch(c->kind) {
+    case TEXT_GBK16:
+        gui_draw_font_gbk16(c->x, c->y, c->fc, c->bc, (char *)c->s);
+        break;
+    case TEXT_GBK24:
+        gui_draw_font_gbk24(c->x, c->y, c->fc, c->bc, (char *)c->s);
+        break;
+    case TEXT_HZ16:
+        gui_draw_characters_gbk16(c->x, c->y, c->fc, c->bc, (char *)c->s);
+        break;
+    case TEXT_HZ24:
+        gui_draw_characters_gbk24(c->x, c->y, c->fc, c->bc, (char *)c->s);
+        break;
+    default:
+        gui_draw_font_num32(c->x, c->y, c->fc, c->bc, c->num);
+        break;
+    }
+    /* the text is on the panel on return and the chip select is left to the driver */
+    HOST_CHECK_EQ(lcd_dma_busy(), RESET);
+    lcd_dma_wait();
+    HOST_CHECK_EQ(lcd_model_stat.cs_writes, 0U);
+    *gui_bytes = lcd_model_stat.bytes;
+
+    for(y = 0U; y < Y_MAX_PIXEL; y++) {
+        for(x = 0U; x < X_MAX_PIXEL; x++) {
+            if(reference_fb[y][x] != lcd_model_fb[y][x]) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+static const text_case_struct text_case[] = {
+    {TEXT_GBK16, 2U, 10U, WHITE, BLUE, " GigaDevice Semiconductor Inc.", 0U},
+    {TEXT_GBK16, 0U, 60U, WHITE, BLUE, "  line1\rline2 ~!", 0U},
+    {TEXT_GBK16, 0U, 100U, RED, RED, "transparent", 0U},
+    {TEXT_GBK16, 200U, 120U, YELLOW, BLACK, "clipped right", 0U},
+    {TEXT_GBK16, 10U, 310U, YELLOW, BLACK, "clipped bottom", 0U},
+    {TEXT_GBK16, 0U, 140U, BLACK, GRAY0, " !\"#$%&'()*+,-./0123456789:;<=>?@ABCDEFGHIJ", 0U},
+    {TEXT_GBK16, 0U, 160U, BLACK, GRAY0, "KLMNOPQRSTUVWXYZ[\\]^_`abcdefghijklmnopqrstu", 0U},
+    {TEXT_GBK16, 0U, 180U, BLACK, GRAY0, "vwxyz{|}~\x7f", 0U},
+    {TEXT_GBK24, 10U, 132U, RED, BLUE, "  Today is ", 0U},
+    {TEXT_HZ16, 16U, 200U, WHITE, BLUE, "\xe6\x98\xbe\xe7\xa4\xba\xe6\xb5\x8b\xe8\xaf\x95", 0U},
+    {TEXT_HZ16, 16U, 240U, GREEN, GREEN, "\xe6\x98\xbe\xe7\xa4\xba", 0U},
+    {TEXT_HZ24, 16U, 220U, WHITE, BLUE, "\xe6\x98\xbe\xe7\xa4\xba\xe6\xb5\x8b\xe8\xaf\x95", 0U},
+    {TEXT_HZ24, 220U, 300U, WHITE, BLUE, "\xe6\x98\xbe\xe7\xa4\xba", 0U},
+};
+
+int main(void)
+{
+    uint32_t i, gui_bytes, reference_bytes, total_gui = 0U, total_reference = 0U;
+    text_case_struct num = {TEXT_NUM32, 0U, 160U, RED, BLUE, NULL, 0U};
+
+    for(i = 0U; i < sizeof(text_case) / sizeof(text_case[0]); i++) {
+        HOST_CHECK_EQ(text_compare(&text_case[i], &gui_bytes, &reference_bytes), 0U);
+        total_gui += gui_bytes;
+        total_reference += reference_bytes;
+    }
+
+    for(i = 0U; i < 10U; i++) {
+        num.x = (uint16_t)(5U + i * 24U);
+        num.num = (uint16_t)i;
+        HOST_CHECK_EQ(text_compare(&num, &gui_bytes, &reference_bytes), 0U);
+        total_gui += gui_bytes;
+        total_reference += reference_bytes;
+    }
+    /* a number cut by the right edge */
+    num.x = 220U;
+    num.y = 300U;
+    HOST_CHECK_EQ(text_compare(&num, &gui_bytes, &reference_bytes), 0U);
+
+    /* an opaque string is one window and two bytes per visible pixel, the last
+       two columns of this one are beyond the panel */
+    text_compare(&text_case[0], &gui_bytes, &reference_bytes);
+    HOST_CHECK_EQ(gui_bytes, LCD_MODEL_REGION_BYTES + (X_MAX_PIXEL - 2U) * 16U * 2U);
+    HOST_CHECK_EQ(reference_bytes, 30U * 8U * 16U * (LCD_MODEL_XY_BYTES + 2U));
+
+    printf("SPI bytes: per-point %u, glyph runs %u\n", (unsigned)total_reference, (unsigned)total_gui);
+    HOST_CHECK(total_gui * 3U < total_reference);
+    return host_test_result("gui_text");
+}
@@ -0,0 +1,608 @@
+/*!
+    \file    test_lcd_driver.c
+    \brief   lcd driver against a model of the SPI1, the DMA channel and the ILI9341 panel
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "lcd_driver.h"
+
+/* the data register keeps this marker in its upper half until the driver writes it */
+#define PANEL_DATA_IDLE         0xDEAD00FFU
+/* polls of SPI_STAT which still see pixels in the TX FIFO and on the wire after the DMA */
+#define PANEL_TXLVL_POLLS       3U
+#define PANEL_TRANS_POLLS       2U
+
+static void panel_cs(FlagStatus level);
+static void panel_rs(FlagStatus level);
+static volatile uint32_t *panel_spi_data(uint32_t spi_periph);
+static uint32_t panel_spi_stat(uint32_t spi_periph);
+
+/* the control lines and the SPI1 data path go through the panel model */
+#undef LCD_CS_SET
+#undef LCD_CS_CLR
+#undef LCD_RS_SET
+#undef LCD_RS_CLR
+#undef LCD_RST_SET
+#undef LCD_RST_CLR
+#define LCD_CS_SET              panel_cs(SET)
+#define LCD_CS_CLR              panel_cs(RESET)
+#define LCD_RS_SET              panel_rs(SET)
+#define LCD_RS_CLR              panel_rs(RESET)
+#define LCD_RST_SET
+#define LCD_RST_CLR
+#undef SPI_DATA
+#undef SPI_STAT
+#define SPI_DATA(spix)          (*panel_spi_data(spix))
+#define SPI_STAT(spix)          panel_spi_stat(spix)
+
+#include "lcd_driver.c"
+
+typedef struct {
+    /* control lines and SPI state */
+    FlagStatus cs;
+    FlagStatus rs;
+    uint16_t frame_size;
+    uint8_t spi_dma;
+    uint32_t data;
+    uint8_t rx_pending;
+    uint32_t txlvl_polls;
+    uint32_t trans_polls;
+    /* ILI9341 command decoder */
+    uint8_t command;
+    uint32_t param;
+    uint16_t xs, xe, ys, ye;
+    uint16_t x, y;
+    uint8_t pixel_high;
+    uint16_t pixel;
+    /* what the test looks at */
+    uint16_t fb[Y_MAX_PIXEL][X_MAX_PIXEL];
+    uint32_t bytes;
+    uint32_t pixel_bytes;
+    uint32_t transactions;
+    uint32_t stray_bytes;
+    uint32_t wide_bytes;
+    uint32_t early_release;
+    uint32_t isr_polls;
+    uint8_t madctl;
+    uint8_t pixel_format;
+} panel_struct;
+
+typedef struct {
+    uint32_t memory;
+    uint32_t number;
+    uint8_t memory_inc;
+    uint8_t enabled;
+    volatile uint8_t irq_pending;
+    uint8_t inject_error;
+    FlagStatus ftf;
+    FlagStatus err;
+    uint32_t blocks;
+} dma_model_struct;
+
+static panel_struct panel;
+static dma_model_struct dma;
+static volatile uint8_t in_isr = 0U;
+static volatile uint32_t callback_count = 0U;
+static volatile uint32_t callback_in_isr = 0U;
+
+/* pixel buffers read by the DMA, static so that their address fits the DMA registers */
+static uint16_t blit_pixels[16U * 16U];
+static uint16_t stream_pixels[40U];
+
+/*!
+    \brief      feed one byte to the ILI9341 command decoder
+    \param[in]  byte: byte shifted out by the SPI
+    \param[out] none
+    \retval     none
+*/
+static void panel_byte(uint8_t byte)
+{
+    panel.bytes++;
+    if(SET == panel.cs) {
+        panel.stray_bytes++;
+        return;
+    }
+
+    if(RESET == panel.rs) {
+        panel.command = byte;
+        panel.param = 0U;
+        if(0x2CU == byte) {
+            panel.x = panel.xs;
+            panel.y = panel.ys;
+            panel.pixel_high = 1U;
+        }
+        return;
+    }
+
+    switch(panel.command) {
+    case 0x2AU:
+    case 0x2BU: {
+        uint16_t *start = (0x2AU == panel.command) ? &panel.xs : &panel.ys;
+        uint16_t *end = (0x2AU == panel.command) ? &panel.xe : &panel.ye;
+        uint16_t *word = (panel.param < 2U) ? start : end;
+        if(0U == (panel.param & 1U)) {
+            *word = (uint16_t)((*word & 0x00FFU) | ((uint16_t)byte << 8));
+        } else {
+            *word = (uint16_t)((*word & 0xFF00U) | byte);
+        }
+        panel.param++;
+        break;
+    }
+    case 0x2CU:
+        panel.pixel_bytes++;
+        if(0U != panel.pixel_high) {
+            panel.pixel = (uint16_t)byte << 8;
+            panel.pixel_high = 0U;
+            break;
+        }
+        panel.pixel |= byte;
+        panel.pixel_high = 1U;
+        if((panel.x < X_MAX_PIXEL) && (panel.y < Y_MAX_PIXEL)) {
+            panel.fb[panel.y][panel.x] = panel.pixel;
+        }
+        if(panel.x >= panel.xe) {
+            panel.x = panel.xs;
+            panel.y++;
+        } else {
+            panel.x++;
+        }
+        break;
+    case 0x36U:
+        panel.madctl = byte;
+        break;
+    case 0x3AU:
+        panel.pixel_format = byte;
+        break;
+    default:
+        break;
+    }
+}
+
+static void panel_cs(FlagStatus level)
+{
+    if((SET == level) && ((0U != panel.txlvl_polls) || (0U != panel.trans_polls))) {
+        panel.early_release++;
+    }
+    if((RESET == level) && (SET == panel.cs)) {
+        panel.transactions++;
+    }
+    panel.cs = level;
+}
+
+static void panel_rs(FlagStatus level)
+{
+    panel.rs = level;
+}
+
+static volatile uint32_t *panel_spi_data(uint32_t spi_periph)
+{
+    (void)spi_periph;
+    return &panel.data;
+}
+
+static uint32_t panel_spi_stat(uint32_t spi_periph)
+{
+    uint32_t stat = SPI_STAT_TBE;
+
+    (void)spi_periph;
+    if(0U != in_isr) {
+        panel.isr_polls++;
+    }
+
+    /* a byte written by the CPU since the last poll is shifted out and one is received */
+    if(PANEL_DATA_IDLE != panel.data) {
+        if(SPI_FRAMESIZE_8BIT != panel.frame_size) {
+            panel.wide_bytes++;
+        }
+        panel_byte((uint8_t)panel.data);
+        panel.data = PANEL_DATA_IDLE;
+        panel.rx_pending = 1U;
+    }
+
+    if(0U != panel.txlvl_polls) {
+        panel.txlvl_polls--;
+        stat |= SPI_STAT_TXLVL | SPI_FLAG_TRANS;
+    } else if(0U != panel.trans_polls) {
+        panel.trans_polls--;
+        stat |= SPI_FLAG_TRANS;
+    } else if(0U != panel.rx_pending) {
+        panel.rx_pending = 0U;
+        stat |= SPI_FLAG_RBNE;
+    }
+    return stat;
+}
+
+/*!
+    \brief      run the enabled DMA block: the pixels go out as 16-bit frames, then the interrupt is pending
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+static void dma_model_run(void)
+{
+    const uint16_t *pixel = (const uint16_t *)(uintptr_t)dma.memory;
+    uint32_t i;
+
+    dma.blocks++;
+    if(0U != dma.inject_error) {
+        dma.inject_error = 0U;
+        dma.err = SET;
+        dma.irq_pending = 1U;
+        return;
+    }
+
+    for(i = 0U; i < dma.number; i++) {
+        if((SPI_FRAMESIZE_16BIT != panel.frame_size) || (0U == panel.spi_dma)) {
+            panel.wide_bytes++;
+        }
+        panel_byte((uint8_t)(*pixel >> 8));
+        panel_byte((uint8_t)*pixel);
+        if(0U != dma.memory_inc) {
+            pixel++;
+        }
+    }
+    panel.txlvl_polls = PANEL_TXLVL_POLLS;
+    panel.trans_polls = PANEL_TRANS_POLLS;
+    panel.rx_pending = 1U;
+    dma.ftf = SET;
+    dma.irq_pending = 1U;
+}
+
+/*!
+    \brief      the DMA interrupt, raised by a host timer while the foreground waits
+    \param[in]  sig: signal number
+    \param[out] none
+    \retval     none
+*/
+static void dma_model_irq(int sig)
+{
+    (void)sig;
+    if(0U == dma.irq_pending) {
+        return;
+    }
+    dma.irq_pending = 0U;
+    in_isr = 1U;
+    lcd_dma_irq_handler();
+    in_isr = 0U;
+}
+
+static void transfer_done(void)
+{
+    callback_count++;
+    if(0U != in_isr) {
+        callback_in_isr++;
+    }
+}
+
+/* standard peripheral library functions used by the driver */
+void delay_ms(uint32_t count)
+{
+    (void)count;
+}
+
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void gpio_af_set(uint32_t gpio_periph, uint32_t alt_func_num, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)alt_func_num;
+    (void)pin;
+}
+
+void gpio_mode_set(uint32_t gpio_periph, uint32_t mode, uint32_t pull_up_down, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)mode;
+    (void)pull_up_down;
+    (void)pin;
+}
+
+void gpio_output_options_set(uint32_t gpio_periph, uint8_t otype, uint32_t speed, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)otype;
+    (void)speed;
+    (void)pin;
+}
+
+ErrStatus spi_init(uint32_t spi_periph, spi_parameter_struct *spi_struct)
+{
+    (void)spi_periph;
+    panel.frame_size = (uint16_t)spi_struct->frame_size;
+    return SUCCESS;
+}
+
+void spi_enable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+}
+
+void spi_disable(uint32_t spi_periph)
+{
+    (void)spi_periph;
+}
+
+ErrStatus spi_i2s_data_frame_format_config(uint32_t spi_periph, uint16_t frame_format)
+{
+    (void)spi_periph;
+    panel.frame_size = frame_format;
+    return SUCCESS;
+}
+
+void spi_fifo_access_size_config(uint32_t spi_periph, uint16_t fifo_access_size)
+{
+    (void)spi_periph;
+    (void)fifo_access_size;
+}
+
+void spi_dma_enable(uint32_t spi_periph, uint8_t spi_dma)
+{
+    (void)spi_periph;
+    (void)spi_dma;
+    panel.spi_dma = 1U;
+}
+
+void spi_dma_disable(uint32_t spi_periph, uint8_t spi_dma)
+{
+    (void)spi_periph;
+    (void)spi_dma;
+    panel.spi_dma = 0U;
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    (void)channelx;
+    dma.memory = init_struct->memory_addr;
+    dma.memory_inc = (DMA_MEMORY_INCREASE_ENABLE == init_struct->memory_inc) ? 1U : 0U;
+}
+
+void dma_circulation_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    (void)source;
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq;
+    (void)nvic_irq_priority;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    if(DMA_INT_FLAG_ERR == int_flag) {
+        return dma.err;
+    }
+    if(DMA_INT_FLAG_FTF == int_flag) {
+        return dma.ftf;
+    }
+    return RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    (void)int_flag;
+    dma.ftf = RESET;
+    dma.err = RESET;
+}
+
+void dma_memory_increase_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    dma.memory_inc = 1U;
+}
+
+void dma_memory_increase_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    dma.memory_inc = 0U;
+}
+
+void dma_memory_address_config(dma_channel_enum channelx, uint32_t address)
+{
+    (void)channelx;
+    dma.memory = address;
+}
+
+void dma_transfer_number_config(dma_channel_enum channelx, uint32_t number)
+{
+    (void)channelx;
+    dma.number = number;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    dma.enabled = 1U;
+    dma_model_run();
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    dma.enabled = 0U;
+}
+
+/*!
+    \brief      check that a rectangle of the panel holds one color
+    \param[in]  x, y, w, h: the rectangle
+    \param[in]  color: expected color
+    \param[out] none
+    \retval     number of pixels of another color
+*/
+static uint32_t panel_rect_mismatch(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    uint32_t bad = 0U;
+    uint16_t i, j;
+
+    for(j = y; j < y + h; j++) {
+        for(i = x; i < x + w; i++) {
+            if(color != panel.fb[j][i]) {
+                bad++;
+            }
+        }
+    }
+    return bad;
+}
+
+int main(void)
+{
+    struct itimerval tick = {{0, 100}, {0, 100}};
+    uint32_t bytes, transactions, i;
+
+    panel.cs = SET;
+    panel.data = PANEL_DATA_IDLE;
+    signal(SIGALRM, dma_model_irq);
+    setitimer(ITIMER_REAL, &tick, NULL);
+
+    /* init: the whole sequence is sent in 8-bit frames with CS low */
+    lcd_init();
+    HOST_CHECK_EQ(panel.madctl, 0x48);
+    HOST_CHECK_EQ(panel.pixel_format, 0x55);
+    HOST_CHECK_EQ(panel.cs, SET);
+
+    /* clear: one region command and two DMA blocks of 16-bit frames */
+    bytes = panel.bytes;
+    transactions = panel.transactions;
+    dma.blocks = 0U;
+    lcd_clear(BLUE);
+    HOST_CHECK_EQ(panel.bytes - bytes, 11U + 2U * X_MAX_PIXEL * Y_MAX_PIXEL);
+    HOST_CHECK_EQ(panel.transactions - transactions, 2U);
+    HOST_CHECK_EQ(dma.blocks, 2U);
+    HOST_CHECK_EQ(panel_rect_mismatch(0U, 0U, X_MAX_PIXEL, Y_MAX_PIXEL, BLUE), 0U);
+    HOST_CHECK_EQ(panel.cs, SET);
+    HOST_CHECK_EQ(panel.frame_size, SPI_FRAMESIZE_8BIT);
+
+    /* short fills are sent by the CPU, the callback runs at once */
+    callback_count = 0U;
+    dma.blocks = 0U;
+    lcd_fill_rect(10U, 20U, 3U, 4U, RED, transfer_done);
+    HOST_CHECK_EQ(dma.blocks, 0U);
+    HOST_CHECK_EQ(callback_count, 1U);
+    HOST_CHECK_EQ(panel_rect_mismatch(10U, 20U, 3U, 4U, RED), 0U);
+    HOST_CHECK_EQ(panel.fb[19][10], BLUE);
+    HOST_CHECK_EQ(panel.fb[20][13], BLUE);
+
+    /* DMA fill: the callback runs in the interrupt, the SPI is released by the foreground */
+    callback_count = 0U;
+    callback_in_isr = 0U;
+    lcd_fill_rect(30U, 40U, 50U, 60U, GREEN, transfer_done);
+    while(0U == callback_count) {
+    }
+    HOST_CHECK_EQ(callback_in_isr, 1U);
+    HOST_CHECK_EQ(panel.cs, RESET);
+    lcd_dma_wait();
+    HOST_CHECK_EQ(panel.cs, SET);
+    HOST_CHECK_EQ(panel.frame_size, SPI_FRAMESIZE_8BIT);
+    HOST_CHECK_EQ(panel.spi_dma, 0U);
+    HOST_CHECK_EQ(panel_rect_mismatch(30U, 40U, 50U, 60U, GREEN), 0U);
+    HOST_CHECK_EQ(panel_rect_mismatch(29U, 40U, 1U, 60U, BLUE), 0U);
+    HOST_CHECK_EQ(panel_rect_mismatch(30U, 100U, 50U, 1U, BLUE), 0U);
+
+    /* blit then draw a point at once: set_xy waits, restores 8-bit frames and selects the panel */
+    for(i = 0U; i < 16U * 16U; i++) {
+        blit_pixels[i] = (uint16_t)(i * 0x0101U + 1U);
+    }
+    lcd_blit(100U, 200U, 16U, 16U, blit_pixels, NULL);
+    gui_draw_point(5U, 6U, YELLOW);
+    HOST_CHECK_EQ(panel.fb[6][5], YELLOW);
+    for(i = 0U; i < 16U * 16U; i++) {
+        HOST_CHECK_EQ(panel.fb[200U + i / 16U][100U + i % 16U], blit_pixels[i]);
+    }
+
+    /* consecutive writes continue where the previous one stopped */
+    for(i = 0U; i < 40U; i++) {
+        stream_pixels[i] = (uint16_t)(0x8000U | i);
+    }
+    lcd_set_region(0U, 300U, 9U, 303U);
+    lcd_write_pixels(stream_pixels, 25U, NULL);
+    lcd_write_pixels(&stream_pixels[25], 15U, NULL);
+    lcd_dma_wait();
+    for(i = 0U; i < 40U; i++) {
+        HOST_CHECK_EQ(panel.fb[300U + i / 10U][i % 10U], stream_pixels[i]);
+    }
+
+    /* a DMA error ends the transfer, the next drawing works */
+    dma.inject_error = 1U;
+    lcd_fill_rect(0U, 0U, 100U, 100U, RED, NULL);
+    lcd_dma_wait();
+    HOST_CHECK_EQ(lcd_dma_busy(), RESET);
+    HOST_CHECK_EQ(panel.cs, SET);
+    lcd_fill_rect(200U, 0U, 40U, 40U, WHITE, NULL);
+    lcd_dma_wait();
+    HOST_CHECK_EQ(panel_rect_mismatch(200U, 0U, 40U, 40U, WHITE), 0U);
+
+    /* the interrupt never polls the SPI, no byte is lost or sent in the wrong frame size */
+    HOST_CHECK_EQ(panel.isr_polls, 0U);
+    HOST_CHECK_EQ(panel.stray_bytes, 0U);
+    HOST_CHECK_EQ(panel.wide_bytes, 0U);
+    HOST_CHECK_EQ(panel.early_release, 0U);
+
+    tick.it_value.tv_usec = 0;
+    tick.it_interval.tv_usec = 0;
+    setitimer(ITIMER_REAL, &tick, NULL);
+    return host_test_result("lcd_driver");
+}
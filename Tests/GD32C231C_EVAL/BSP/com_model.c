@@ -0,0 +1,350 @@
+/*!
+    \file    com_model.c
+    \brief   USART0 transmitter and DMA channel model behind the COM functions of gd32c231c_eval.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <signal.h>
+#include <string.h>
+#include <sys/time.h>
+#include "com_model.h"
+#include "gd32c231c_eval.h"
+#include "host_cmsis.h"
+
+typedef struct {
+    uint32_t base;                      /* memory address of dma_init(), the ring buffer */
+    uint32_t memory;
+    uint32_t number;
+    uint32_t done;
+    uint32_t interrupts;
+    uint32_t flags;
+    uint8_t enabled;
+} model_dma_struct;
+
+com_model_struct com_model;
+
+static model_dma_struct model_dma;
+static uint8_t model_usart_dma = 0U;
+/* SET while a stub changes the model, the timer leaves the driver alone then */
+static volatile uint32_t model_lock = 0U;
+static uint8_t model_timer_started = 0U;
+
+/*!
+    \brief      keep a byte of the USART output
+    \param[in]  byte: byte shifted out
+    \param[out] none
+    \retval     none
+*/
+static void model_output(uint8_t byte)
+{
+    if(com_model.sent < COM_MODEL_OUTPUT_SIZE) {
+        com_model.output[com_model.sent] = byte;
+    }
+    com_model.sent++;
+}
+
+/*!
+    \brief      SET while the DMA channel has bytes left to send
+    \param[in]  none
+    \param[out] none
+    \retval     FlagStatus: SET or RESET
+*/
+static FlagStatus model_dma_busy(void)
+{
+    return ((0U != model_dma.enabled) && (model_dma.done < model_dma.number)) ? SET : RESET;
+}
+
+/*!
+    \brief      the host timer: the DMA sends bytes, then its interrupt runs
+    \param[in]  sig: signal number
+    \param[out] none
+    \retval     none
+*/
+static void model_timer(int sig)
+{
+    const uint8_t *memory;
+    uint32_t count;
+
+    (void)sig;
+    if((0U != model_lock) || (0U != host_primask)) {
+        return;
+    }
+    if(0U != com_model.pause_ticks) {
+        com_model.pause_ticks--;
+        return;
+    }
+
+    if(SET == model_dma_busy()) {
+        memory = (const uint8_t *)(uintptr_t)model_dma.memory;
+        for(count = 0U; (count < com_model.bytes_per_tick) && (model_dma.done < model_dma.number); count++) {
+            model_output(memory[model_dma.done++]);
+        }
+        if(model_dma.done == model_dma.number) {
+            model_dma.flags |= DMA_INT_FLAG_FTF;
+        }
+    }
+
+    if((0U != (model_dma.flags & DMA_INT_FLAG_FTF)) && (0U != (model_dma.interrupts & DMA_INT_FTF))) {
+        com_model.dma_irqs++;
+        host_ipsr = 16U + (uint32_t)EVAL_COM_TX_DMA_IRQn;
+        gd_eval_com_tx_dma_irq_handler();
+        host_ipsr = 0U;
+    }
+}
+
+/*!
+    \brief      clear the model and start the timer which runs the DMA interrupt
+    \param[in]  bytes_per_tick: bytes shifted out at each host timer tick
+    \param[out] none
+    \retval     none
+*/
+void com_model_init(uint32_t bytes_per_tick)
+{
+    struct itimerval tick = {{0, 100}, {0, 100}};
+
+    model_lock++;
+    memset(&com_model, 0, sizeof(com_model));
+    memset(&model_dma, 0, sizeof(model_dma));
+    com_model.bytes_per_tick = bytes_per_tick;
+    model_usart_dma = 0U;
+    model_lock--;
+
+    if(0U == model_timer_started) {
+        model_timer_started = 1U;
+        signal(SIGALRM, model_timer);
+        setitimer(ITIMER_REAL, &tick, NULL);
+    }
+}
+
+/* standard peripheral library functions used by the BSP */
+void rcu_periph_clock_enable(rcu_periph_enum periph)
+{
+    (void)periph;
+}
+
+void nvic_irq_enable(IRQn_Type nvic_irq, uint8_t nvic_irq_priority)
+{
+    (void)nvic_irq;
+    (void)nvic_irq_priority;
+}
+
+void gpio_af_set(uint32_t gpio_periph, uint32_t alt_func_num, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)alt_func_num;
+    (void)pin;
+}
+
+void gpio_mode_set(uint32_t gpio_periph, uint32_t mode, uint32_t pull_up_down, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)mode;
+    (void)pull_up_down;
+    (void)pin;
+}
+
+void gpio_output_options_set(uint32_t gpio_periph, uint8_t otype, uint32_t speed, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)otype;
+    (void)speed;
+    (void)pin;
+}
+
+FlagStatus gpio_input_bit_get(uint32_t gpio_periph, uint32_t pin)
+{
+    (void)gpio_periph;
+    (void)pin;
+    return RESET;
+}
+
+void syscfg_exti_line_config(uint8_t exti_port, uint8_t exti_pin)
+{
+    (void)exti_port;
+    (void)exti_pin;
+}
+
+void exti_init(exti_line_enum linex, exti_mode_enum mode, exti_trig_type_enum trig_type)
+{
+    (void)linex;
+    (void)mode;
+    (void)trig_type;
+}
+
+void exti_interrupt_flag_clear(exti_line_enum linex)
+{
+    (void)linex;
+}
+
+void usart_deinit(uint32_t usart_periph)
+{
+    (void)usart_periph;
+    model_usart_dma = 0U;
+}
+
+void usart_baudrate_set(uint32_t usart_periph, uint32_t baudval)
+{
+    (void)usart_periph;
+    (void)baudval;
+}
+
+void usart_receive_config(uint32_t usart_periph, uint32_t rxconfig)
+{
+    (void)usart_periph;
+    (void)rxconfig;
+}
+
+void usart_transmit_config(uint32_t usart_periph, uint32_t txconfig)
+{
+    (void)usart_periph;
+    (void)txconfig;
+}
+
+void usart_enable(uint32_t usart_periph)
+{
+    (void)usart_periph;
+}
+
+void usart_dma_transmit_config(uint32_t usart_periph, uint32_t dmaconfig)
+{
+    (void)usart_periph;
+    model_usart_dma = (USART_TRANSMIT_DMA_ENABLE == dmaconfig) ? 1U : 0U;
+}
+
+void usart_data_transmit(uint32_t usart_periph, uint16_t data)
+{
+    (void)usart_periph;
+    com_model.polled_bytes++;
+    model_output((uint8_t)data);
+}
+
+FlagStatus usart_flag_get(uint32_t usart_periph, usart_flag_enum flag)
+{
+    (void)usart_periph;
+    if(USART_FLAG_TC == flag) {
+        return (SET == model_dma_busy()) ? RESET : SET;
+    }
+    /* TBE: a byte written by the CPU is shifted out at once */
+    return SET;
+}
+
+void dma_deinit(dma_channel_enum channelx)
+{
+    (void)channelx;
+    model_lock++;
+    memset(&model_dma, 0, sizeof(model_dma));
+    model_lock--;
+}
+
+void dma_struct_para_init(dma_parameter_struct *init_struct)
+{
+    memset(init_struct, 0, sizeof(*init_struct));
+}
+
+void dma_init(dma_channel_enum channelx, dma_parameter_struct *init_struct)
+{
+    (void)channelx;
+    model_dma.base = init_struct->memory_addr;
+    model_dma.memory = init_struct->memory_addr;
+    model_dma.number = init_struct->number;
+}
+
+void dma_circulation_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_memory_to_memory_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dmamux_synchronization_disable(dmamux_multiplexer_channel_enum channelx)
+{
+    (void)channelx;
+}
+
+void dma_interrupt_enable(dma_channel_enum channelx, uint32_t source)
+{
+    (void)channelx;
+    model_dma.interrupts |= source;
+}
+
+FlagStatus dma_interrupt_flag_get(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    return (0U != (model_dma.flags & int_flag)) ? SET : RESET;
+}
+
+void dma_interrupt_flag_clear(dma_channel_enum channelx, uint32_t int_flag)
+{
+    (void)channelx;
+    model_dma.flags &= ~int_flag;
+}
+
+void dma_memory_address_config(dma_channel_enum channelx, uint32_t address)
+{
+    (void)channelx;
+    model_dma.memory = address;
+}
+
+void dma_transfer_number_config(dma_channel_enum channelx, uint32_t number)
+{
+    (void)channelx;
+    model_dma.number = number;
+}
+
+void dma_channel_enable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    if((model_dma.memory < model_dma.base) ||
+            ((model_dma.memory + model_dma.number) > (model_dma.base + EVAL_COM_TX_BUFFER_SIZE))) {
+        com_model.dma_outside++;
+    }
+    if(0U == model_usart_dma) {
+        com_model.dma_request_off++;
+    }
+    if(model_dma.number > com_model.dma_largest) {
+        com_model.dma_largest = model_dma.number;
+    }
+    com_model.dma_transfers++;
+    model_dma.done = 0U;
+    model_dma.enabled = 1U;
+}
+
+void dma_channel_disable(dma_channel_enum channelx)
+{
+    (void)channelx;
+    if(SET == model_dma_busy()) {
+        com_model.dma_restarts++;
+    }
+    model_dma.enabled = 0U;
+}
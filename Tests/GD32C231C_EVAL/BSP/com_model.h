@@ -0,0 +1,65 @@
+/*!
+    \file    com_model.h
+    \brief   USART0 transmitter and DMA channel model behind the COM functions of gd32c231c_eval.c
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef COM_MODEL_H
+#define COM_MODEL_H
+
+#include "gd32c2x1.h"
+
+/* bytes the model keeps of the USART output */
+#define COM_MODEL_OUTPUT_SIZE       65536U
+
+typedef struct {
+    /* USART output */
+    uint8_t output[COM_MODEL_OUTPUT_SIZE];
+    volatile uint32_t sent;             /* bytes shifted out */
+    uint32_t polled_bytes;              /* bytes written to TDATA by the CPU */
+    uint32_t bytes_per_tick;            /* bytes shifted out at each host timer tick */
+    volatile uint32_t pause_ticks;      /* host timer ticks before the DMA runs again */
+    /* DMA channel */
+    uint32_t dma_transfers;             /* transfers started */
+    uint32_t dma_irqs;
+    uint32_t dma_largest;               /* bytes of the longest transfer */
+    /* sequencing errors, all of them must stay zero */
+    uint32_t dma_outside;               /* transfer reaching beyond the ring buffer */
+    uint32_t dma_restarts;              /* transfer reconfigured before its end */
+    uint32_t dma_request_off;           /* transfer started without the USART DMA request */
+} com_model_struct;
+
+extern com_model_struct com_model;
+
+/* clear the model and start the timer which runs the DMA interrupt */
+void com_model_init(uint32_t bytes_per_tick);
+
+#endif /* COM_MODEL_H */
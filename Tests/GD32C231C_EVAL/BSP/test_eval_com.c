@@ -0,0 +1,242 @@
+/*!
+    \file    test_eval_com.c
+    \brief   COM ring buffer of gd32c231c_eval.c: __io_write, the wraparound of the DMA
+             transfers and the overflow policy
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_cmsis.h"
+#include "com_model.h"
+#include "gd32c231c_eval.c"
+
+#define TEST_STREAM_SIZE    20000U
+
+/* the bytes written to the COM, every byte differs from its neighbours */
+static uint8_t stream[TEST_STREAM_SIZE];
+
+static void stream_fill(uint32_t seed)
+{
+    uint32_t index;
+
+    for(index = 0U; index < TEST_STREAM_SIZE; index++) {
+        stream[index] = (uint8_t)(index * 7U + seed + (index >> 8));
+    }
+}
+
+/* bring the ring buffer back to its reset state, DMA not enabled */
+static void com_reset(uint32_t bytes_per_tick)
+{
+    com_model_init(bytes_per_tick);
+    com_tx_head = 0U;
+    com_tx_tail = 0U;
+    com_tx_dma_number = 0U;
+    com_tx_overflow = 0U;
+    com_tx_periph = 0U;
+}
+
+/* the sequencing errors of the model */
+static void check_dma(void)
+{
+    HOST_CHECK_EQ(com_model.dma_outside, 0);
+    HOST_CHECK_EQ(com_model.dma_restarts, 0);
+    HOST_CHECK_EQ(com_model.dma_request_off, 0);
+    HOST_CHECK(com_model.dma_largest <= EVAL_COM_TX_BUFFER_SIZE);
+}
+
+/* C library output before the DMA is enabled, then through the ring buffer */
+static void test_io_write(void)
+{
+    char text[] = "temperature: 25 C\r\n";
+    uint32_t length = (uint32_t)strlen(text);
+
+    com_reset(4U);
+    gd_eval_com_init(EVAL_COM);
+    HOST_CHECK_EQ(__io_write(text, (int)length), length);
+    HOST_CHECK_EQ(com_model.polled_bytes, length);
+    HOST_CHECK_EQ(com_model.sent, length);
+    HOST_CHECK(0 == memcmp(com_model.output, text, length));
+    HOST_CHECK_EQ(com_model.dma_transfers, 0);
+
+    gd_eval_com_tx_dma_init(EVAL_COM);
+    HOST_CHECK_EQ(__io_write(text, (int)length), length);
+    HOST_CHECK_EQ(__io_write(text, (int)length), length);
+    gd_eval_com_tx_flush();
+    HOST_CHECK_EQ(com_model.polled_bytes, length);
+    HOST_CHECK_EQ(com_model.sent, 3U * length);
+    HOST_CHECK(0 == memcmp(&com_model.output[length], text, length));
+    HOST_CHECK(0 == memcmp(&com_model.output[2U * length], text, length));
+    HOST_CHECK(com_model.dma_transfers >= 1U);
+    HOST_CHECK_EQ(gd_eval_com_tx_overflow_get(), 0);
+    HOST_CHECK_EQ(com_tx_dma_number, 0);
+    check_dma();
+}
+
+/* writes of every length up to more than the ring buffer, from thread mode */
+static void test_wrap(void)
+{
+    uint32_t done = 0U, number, seed = 1U;
+
+    com_reset(4U);
+    gd_eval_com_init(EVAL_COM);
+    gd_eval_com_tx_dma_init(EVAL_COM);
+    stream_fill(3U);
+    while(done < TEST_STREAM_SIZE) {
+        seed = seed * 1103515245U + 12345U;
+        number = (seed >> 16) % (EVAL_COM_TX_BUFFER_SIZE + 100U) + 1U;
+        if(number > (TEST_STREAM_SIZE - done)) {
+            number = TEST_STREAM_SIZE - done;
+        }
+        HOST_CHECK_EQ(gd_eval_com_tx_write(&stream[done], number), number);
+        done += number;
+    }
+    gd_eval_com_tx_flush();
+
+    HOST_CHECK_EQ(com_model.sent, TEST_STREAM_SIZE);
+    HOST_CHECK(0 == memcmp(com_model.output, stream, TEST_STREAM_SIZE));
+    HOST_CHECK_EQ(gd_eval_com_tx_overflow_get(), 0);
+    HOST_CHECK_EQ(com_tx_head, TEST_STREAM_SIZE);
+    HOST_CHECK_EQ(com_tx_tail, TEST_STREAM_SIZE);
+    /* the ring buffer went round, each round ends a transfer at its last byte */
+    HOST_CHECK(com_model.dma_transfers >= (TEST_STREAM_SIZE / EVAL_COM_TX_BUFFER_SIZE));
+    HOST_CHECK_EQ(com_model.dma_irqs, com_model.dma_transfers);
+    check_dma();
+}
+
+/* a transfer split at the end of the ring buffer */
+static void test_split(void)
+{
+    com_reset(4U);
+    gd_eval_com_init(EVAL_COM);
+    gd_eval_com_tx_dma_init(EVAL_COM);
+    stream_fill(5U);
+
+    HOST_CHECK_EQ(gd_eval_com_tx_write(stream, 200U), 200U);
+    gd_eval_com_tx_flush();
+    HOST_CHECK_EQ(com_model.dma_transfers, 1);
+
+    /* 100 bytes from index 200: 56 bytes up to the end, then 44 from the start */
+    com_model.pause_ticks = 1000000U;
+    HOST_CHECK_EQ(gd_eval_com_tx_write(&stream[200], 100U), 100U);
+    HOST_CHECK_EQ(com_tx_dma_number, EVAL_COM_TX_BUFFER_SIZE - 200U);
+    com_model.pause_ticks = 0U;
+    gd_eval_com_tx_flush();
+    HOST_CHECK_EQ(com_model.dma_transfers, 3);
+    HOST_CHECK_EQ(com_model.sent, 300U);
+    HOST_CHECK(0 == memcmp(com_model.output, stream, 300U));
+    check_dma();
+}
+
+/* a full ring buffer: thread mode waits, an interrupt or a masked writer drops */
+static void test_overflow(void)
+{
+    uint32_t written;
+
+    com_reset(4U);
+    gd_eval_com_init(EVAL_COM);
+    gd_eval_com_tx_dma_init(EVAL_COM);
+    stream_fill(9U);
+
+    /* interrupt context, the DMA does not run until the end of the writes */
+    com_model.pause_ticks = 1000000U;
+    host_ipsr = 16U + (uint32_t)USART0_IRQn;
+    written = gd_eval_com_tx_write(stream, 300U);
+    host_ipsr = 0U;
+    HOST_CHECK_EQ(written, EVAL_COM_TX_BUFFER_SIZE);
+    HOST_CHECK_EQ(gd_eval_com_tx_overflow_get(), 300U - EVAL_COM_TX_BUFFER_SIZE);
+
+    /* interrupts disabled in thread mode */
+    __disable_irq();
+    written = gd_eval_com_tx_write(&stream[EVAL_COM_TX_BUFFER_SIZE], 10U);
+    __enable_irq();
+    HOST_CHECK_EQ(written, 0);
+    HOST_CHECK_EQ(gd_eval_com_tx_overflow_get(), 300U - EVAL_COM_TX_BUFFER_SIZE + 10U);
+
+    /* thread mode waits until the DMA makes room, nothing is dropped */
+    com_model.pause_ticks = 200U;
+    written = gd_eval_com_tx_write(&stream[EVAL_COM_TX_BUFFER_SIZE], 300U);
+    HOST_CHECK_EQ(written, 300U);
+    HOST_CHECK_EQ(gd_eval_com_tx_overflow_get(), 300U - EVAL_COM_TX_BUFFER_SIZE + 10U);
+    gd_eval_com_tx_flush();
+
+    /* what was accepted went out in order, the dropped bytes are missing */
+    HOST_CHECK_EQ(com_model.sent, EVAL_COM_TX_BUFFER_SIZE + 300U);
+    HOST_CHECK(0 == memcmp(com_model.output, stream, EVAL_COM_TX_BUFFER_SIZE + 300U));
+    check_dma();
+}
+
+/* short writes racing the DMA interrupt which starts the next transfer */
+static void test_mixed(void)
+{
+    uint32_t index, accepted = 0U;
+
+    com_reset(8U);
+    gd_eval_com_init(EVAL_COM);
+    gd_eval_com_tx_dma_init(EVAL_COM);
+    stream_fill(11U);
+
+    for(index = 0U; index < 4000U; index += 40U) {
+        accepted += gd_eval_com_tx_write(&stream[index], 40U);
+    }
+    gd_eval_com_tx_flush();
+    HOST_CHECK_EQ(accepted, 4000U);
+    HOST_CHECK_EQ(com_model.sent, 4000U);
+    HOST_CHECK(0 == memcmp(com_model.output, stream, 4000U));
+    check_dma();
+}
+
+/* RAM the ring buffer adds to the BSP */
+static void test_ram(void)
+{
+    uint32_t ram = sizeof(com_tx_buffer) + sizeof(com_tx_head) + sizeof(com_tx_tail) +
+                   sizeof(com_tx_dma_number) + sizeof(com_tx_overflow) + sizeof(com_tx_periph);
+
+    printf("COM ring buffer RAM: %u bytes\n", (unsigned int)ram);
+    HOST_CHECK_EQ(ram, EVAL_COM_TX_BUFFER_SIZE + 20U);
+    /* the index wraps with a mask */
+    HOST_CHECK_EQ(EVAL_COM_TX_BUFFER_SIZE & (EVAL_COM_TX_BUFFER_SIZE - 1U), 0);
+}
+
+int main(void)
+{
+    test_io_write();
+    test_wrap();
+    test_split();
+    test_overflow();
+    test_mixed();
+    test_ram();
+
+    return host_test_result("eval_com");
+}
@@ -0,0 +1,309 @@
+/*!
+    \file    test_eeprom_emul.c
+    \brief   host test of the EEPROM emulation on the main flash model, with a power cut at
+             every erase and program of a workload and of the recovery after it
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include "gd32c2x1.h"
+#include "host_test.h"
+#include "host_periph.h"
+#include "fmc_model.h"
+#include "eeprom_emul.c"
+
+#define TEST_AREA_SIZE      (EEPROM_EMUL_PAGE_NUM * MAIN_FLASH_PAGE_SIZE)
+/* writes of the power cut workload, the ring is turned three times */
+#define TEST_STEP_NUM       1200U
+#define TEST_REUSE_NUM      150U
+#define TEST_WEAR_NUM       20000U
+/* a step of this virtual address formats the variables */
+#define TEST_FORMAT         EEPROM_EMUL_VAR_NUM
+#define TEST_NO_STEP        0xFFFFFFFFU
+
+typedef struct {
+    uint16_t virt_address;
+    uint32_t value;
+} test_step_struct;
+
+static test_step_struct workload[TEST_STEP_NUM];
+static test_step_struct reuse[TEST_REUSE_NUM];
+/* the values acknowledged by eeprom_emul_write() */
+static uint32_t ref_value[EEPROM_EMUL_VAR_NUM];
+static uint8_t ref_valid[EEPROM_EMUL_VAR_NUM];
+static uint32_t saved_value[EEPROM_EMUL_VAR_NUM];
+static uint8_t saved_valid[EEPROM_EMUL_VAR_NUM];
+static uint8_t saved_area[TEST_AREA_SIZE];
+static uint8_t cut_area[TEST_AREA_SIZE];
+/* the step in progress, kept across the jump of the power cut */
+static const test_step_struct *current = NULL;
+/* bits a cut program leaves erased: the second word, a bit of the value of a record, a bit of
+   the crc of its tag, the crc, all of them as if the power was lost just before the operation */
+static const uint64_t cut_bits[] = {0U, 0x0000000000000100U, 0x0100000000000000U, 0xFFFF000000000000U,
+                                    0xFFFFFFFFFFFFFFFFU};
+
+/* random writes, most of them to a few variables, some of them of the same value */
+static void steps_make(test_step_struct *steps, uint32_t number)
+{
+    uint32_t i;
+
+    for(i = 0U; i < number; i++) {
+        if(0U == ((uint32_t)rand() % 200U)) {
+            steps[i].virt_address = TEST_FORMAT;
+        } else {
+            steps[i].virt_address = (uint16_t)(((uint32_t)rand() % 10U < 7U) ? ((uint32_t)rand() % 3U) :
+                                                                            ((uint32_t)rand() % EEPROM_EMUL_VAR_NUM));
+        }
+        steps[i].value = (0U == ((uint32_t)rand() % 4U)) ? 0x12345678U : (uint32_t)rand();
+    }
+}
+
+/* run the steps, the reference follows the acknowledged writes */
+static void steps_run(const test_step_struct *steps, uint32_t number)
+{
+    uint32_t i;
+
+    for(i = 0U; i < number; i++) {
+        current = &steps[i];
+        if(TEST_FORMAT == steps[i].virt_address) {
+            HOST_CHECK_EQ(eeprom_emul_format(), FMC_READY);
+            memset(ref_valid, 0, sizeof(ref_valid));
+        } else {
+            HOST_CHECK_EQ(eeprom_emul_write(steps[i].virt_address, steps[i].value), FMC_READY);
+            ref_value[steps[i].virt_address] = steps[i].value;
+            ref_valid[steps[i].virt_address] = 1U;
+        }
+        current = NULL;
+    }
+}
+
+/* the variables read back match the reference, a step cut by the power is either done or not */
+static void values_check(const test_step_struct *pending)
+{
+    uint32_t value;
+    uint32_t valid = 0U;
+    uint16_t i;
+
+    for(i = 0U; i < EEPROM_EMUL_VAR_NUM; i++) {
+        if(SUCCESS == eeprom_emul_read(i, &value)) {
+            valid++;
+        }
+    }
+    if((NULL != pending) && (TEST_FORMAT == pending->virt_address) && (0U == valid)) {
+        memset(ref_valid, 0, sizeof(ref_valid));
+    }
+
+    for(i = 0U; i < EEPROM_EMUL_VAR_NUM; i++) {
+        if(SUCCESS == eeprom_emul_read(i, &value)) {
+            if((NULL != pending) && (i == pending->virt_address) && (value == pending->value)) {
+                ref_value[i] = value;
+                ref_valid[i] = 1U;
+            }
+            HOST_CHECK_EQ(ref_valid[i], 1);
+            HOST_CHECK_EQ(value, ref_value[i]);
+        } else {
+            HOST_CHECK_EQ(ref_valid[i], 0);
+        }
+    }
+}
+
+/* power up: the active page is found again and its variables are loaded */
+static void recover(const test_step_struct *pending)
+{
+    fmc_model_init();
+    HOST_CHECK_EQ(eeprom_emul_init(), FMC_READY);
+    values_check(pending);
+    HOST_CHECK_EQ(fmc_model.errors, 0);
+}
+
+/* reads, writes and the values kept over a reset */
+static void test_basic(void)
+{
+    uint32_t value = 0U;
+    uint32_t operations;
+    uint16_t i;
+
+    host_periph_reset();
+    fmc_model_init();
+    memset(ref_valid, 0, sizeof(ref_valid));
+
+    /* blank pages are formatted */
+    HOST_CHECK_EQ(eeprom_emul_init(), FMC_READY);
+    HOST_CHECK_EQ(eeprom_emul_read(0U, &value), ERROR);
+    HOST_CHECK_EQ(eeprom_emul_read(EEPROM_EMUL_VAR_NUM, &value), ERROR);
+    HOST_CHECK_EQ(eeprom_emul_write(EEPROM_EMUL_VAR_NUM, 1U), FMC_UNDEFINEDERR);
+
+    for(i = 0U; i < EEPROM_EMUL_VAR_NUM; i++) {
+        HOST_CHECK_EQ(eeprom_emul_write(i, 0xA5000000U + i), FMC_READY);
+        ref_value[i] = 0xA5000000U + i;
+        ref_valid[i] = 1U;
+    }
+    values_check(NULL);
+
+    /* the same value again costs no flash */
+    operations = fmc_model.operations;
+    HOST_CHECK_EQ(eeprom_emul_write(7U, 0xA5000007U), FMC_READY);
+    HOST_CHECK_EQ(fmc_model.operations, operations);
+    HOST_CHECK_EQ(fmc_model.locked, 1);
+
+    recover(NULL);
+    HOST_CHECK_EQ(eeprom_emul_format(), FMC_READY);
+    memset(ref_valid, 0, sizeof(ref_valid));
+    recover(NULL);
+}
+
+/* a power cut at every erase and program of the workload, then at every one of the recovery */
+static void test_power_cut(void)
+{
+    const test_step_struct *pending;
+    uint32_t total, cut, recovery_cut;
+
+    host_periph_reset();
+    fmc_model_init();
+    memset(ref_valid, 0, sizeof(ref_valid));
+    srand(19U);
+    steps_make(workload, TEST_STEP_NUM);
+    steps_make(reuse, TEST_REUSE_NUM);
+
+    /* some history, then the state every cut starts from */
+    HOST_CHECK_EQ(eeprom_emul_init(), FMC_READY);
+    steps_run(reuse, TEST_REUSE_NUM);
+    memcpy(saved_area, (const void *)(uintptr_t)EEPROM_EMUL_START_ADDRESS, TEST_AREA_SIZE);
+    memcpy(saved_value, ref_value, sizeof(ref_value));
+    memcpy(saved_valid, ref_valid, sizeof(ref_valid));
+
+    recover(NULL);
+    steps_run(workload, TEST_STEP_NUM);
+    total = fmc_model.operations;
+    HOST_CHECK(total > TEST_STEP_NUM);
+
+    for(cut = 1U; cut <= total; cut++) {
+        memcpy((void *)(uintptr_t)EEPROM_EMUL_START_ADDRESS, saved_area, TEST_AREA_SIZE);
+        memcpy(ref_value, saved_value, sizeof(ref_value));
+        memcpy(ref_valid, saved_valid, sizeof(ref_valid));
+        recover(NULL);
+        fmc_model.cut_at = cut;
+        fmc_model.cut_bits = cut_bits[cut % 5U];
+        if(0 == setjmp(fmc_model_cut)) {
+            steps_run(workload, TEST_STEP_NUM);
+            HOST_CHECK(0);
+            continue;
+        }
+        pending = current;
+        current = NULL;
+        memcpy(cut_area, (const void *)(uintptr_t)EEPROM_EMUL_START_ADDRESS, TEST_AREA_SIZE);
+
+        /* the recovery may program OBSOLETE headers or format, it is cut as well */
+        for(recovery_cut = 1U; ; recovery_cut++) {
+            memcpy((void *)(uintptr_t)EEPROM_EMUL_START_ADDRESS, cut_area, TEST_AREA_SIZE);
+            fmc_model_init();
+            fmc_model.cut_at = recovery_cut;
+            fmc_model.cut_bits = cut_bits[recovery_cut % 5U];
+            if(0 == setjmp(fmc_model_cut)) {
+                (void)eeprom_emul_init();
+                break;
+            }
+            recover(pending);
+        }
+        recover(pending);
+
+        /* the pages are still usable */
+        steps_run(reuse, TEST_REUSE_NUM);
+        recover(NULL);
+    }
+}
+
+/* a failed record program returns an error, the records written after it are still loaded */
+static void test_program_error(void)
+{
+    test_step_struct step;
+    uint32_t i, operations;
+
+    host_periph_reset();
+    fmc_model_init();
+    memset(ref_valid, 0, sizeof(ref_valid));
+    HOST_CHECK_EQ(eeprom_emul_init(), FMC_READY);
+
+    /* the record is left erased, partly programmed or complete with a wrong bit */
+    for(i = 0U; i < 5U; i++) {
+        step.virt_address = 1U;
+        step.value = 0x100U + i;
+        steps_run(&step, 1U);
+
+        operations = fmc_model.operations;
+        fmc_model.fail_at = operations + 1U;
+        fmc_model.cut_bits = cut_bits[i];
+        HOST_CHECK(FMC_READY != eeprom_emul_write(2U, 0x200U + i));
+        HOST_CHECK_EQ(fmc_model.operations, operations + 1U);
+        fmc_model.fail_at = 0U;
+        values_check(NULL);
+
+        step.virt_address = 3U;
+        step.value = 0x300U + i;
+        steps_run(&step, 1U);
+        recover(NULL);
+    }
+}
+
+/* a long run turns the ring, a page is moved only when it is full */
+static void test_wear(void)
+{
+    test_step_struct step;
+    uint32_t i;
+
+    host_periph_reset();
+    fmc_model_init();
+    memset(ref_valid, 0, sizeof(ref_valid));
+    HOST_CHECK_EQ(eeprom_emul_init(), FMC_READY);
+    for(i = 0U; i < TEST_WEAR_NUM; i++) {
+        step.virt_address = (uint16_t)(i % EEPROM_EMUL_VAR_NUM);
+        step.value = i;
+        steps_run(&step, 1U);
+    }
+
+    /* all the variables are valid, a page takes the copies and then the new records */
+    HOST_CHECK(fmc_model.erases <= ((TEST_WEAR_NUM / ((MAIN_FLASH_PAGE_SIZE - EEPROM_EMUL_RECORD_OFFSET) /
+                                                      EEPROM_EMUL_RECORD_SIZE - EEPROM_EMUL_VAR_NUM)) + 1U));
+    HOST_CHECK(fmc_model.erases >= (TEST_WEAR_NUM / ((MAIN_FLASH_PAGE_SIZE - EEPROM_EMUL_RECORD_OFFSET) /
+                                                     EEPROM_EMUL_RECORD_SIZE)));
+    recover(NULL);
+}
+
+int main(void)
+{
+    test_basic();
+    test_power_cut();
+    test_program_error();
+    test_wear();
+
+    return host_test_result("eeprom_emul");
+}
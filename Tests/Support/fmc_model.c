@@ -0,0 +1,190 @@
+/*!
+    \file    fmc_model.c
+    \brief   main flash programming model behind the FMC functions, with power cuts
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <string.h>
+#include "fmc_model.h"
+#include "host_periph.h"
+
+fmc_model_struct fmc_model;
+jmp_buf fmc_model_cut;
+
+/*!
+    \brief      clear the counters and lock the FMC, the flash content is kept
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void fmc_model_init(void)
+{
+    memset(&fmc_model, 0, sizeof(fmc_model));
+    fmc_model.locked = 1U;
+}
+
+/*!
+    \brief      start an operation, a power cut or a failure leaves it partly done
+    \param[in]  address: flash address of the operation
+    \param[in]  number: number of bytes written by the operation
+    \param[in]  data: bytes written, NULL to erase
+    \param[out] none
+    \retval     SET if the operation failed
+*/
+static FlagStatus model_operation(uint32_t address, uint32_t number, const uint8_t *data)
+{
+    uint8_t *flash = (uint8_t *)(uintptr_t)address;
+    uint8_t keep;
+    uint32_t i;
+
+    fmc_model.operations++;
+    if((fmc_model.operations != fmc_model.cut_at) && (fmc_model.operations != fmc_model.fail_at)) {
+        return RESET;
+    }
+    for(i = 0U; i < number; i++) {
+        if(0U != fmc_model.cut_bits) {
+            keep = (uint8_t)(fmc_model.cut_bits >> (8U * (i & 7U)));
+        } else {
+            keep = (i < (number / 2U)) ? 0x00U : 0xFFU;
+        }
+        if(NULL == data) {
+            flash[i] |= (uint8_t)~keep;
+        } else {
+            flash[i] &= (uint8_t)(data[i] | keep);
+        }
+    }
+    if(fmc_model.operations == fmc_model.cut_at) {
+        longjmp(fmc_model_cut, 1);
+    }
+    return SET;
+}
+
+/*!
+    \brief      check that an area is inside the main flash, aligned and unlocked
+    \param[in]  address: flash address
+    \param[in]  number: number of bytes, a power of 2
+    \param[out] none
+    \retval     SET if the operation may run
+*/
+static FlagStatus model_check(uint32_t address, uint32_t number)
+{
+    if((0U != fmc_model.locked) || (0U != (address & (number - 1U))) || (address < MAIN_FLASH_BASE_ADDRESS) ||
+            ((address + number) > (MAIN_FLASH_BASE_ADDRESS + MAIN_FLASH_SIZE))) {
+        fmc_model.errors++;
+        return RESET;
+    }
+    return SET;
+}
+
+/*!
+    \brief      check that an area is erased, a doubleword is programmed once after its erase
+    \param[in]  address: flash address
+    \param[in]  number: number of bytes
+    \param[out] none
+    \retval     SET if every byte is 0xFF
+*/
+static FlagStatus model_blank(uint32_t address, uint32_t number)
+{
+    const uint8_t *flash = (const uint8_t *)(uintptr_t)address;
+    uint32_t i;
+
+    for(i = 0U; i < number; i++) {
+        if(0xFFU != flash[i]) {
+            fmc_model.errors++;
+            return RESET;
+        }
+    }
+    return SET;
+}
+
+void fmc_unlock(void)
+{
+    fmc_model.locked = 0U;
+}
+
+void fmc_lock(void)
+{
+    fmc_model.locked = 1U;
+}
+
+void fmc_flag_clear(uint32_t flag)
+{
+    (void)flag;
+}
+
+fmc_state_enum fmc_page_erase(uint32_t page_number)
+{
+    uint32_t address = MAIN_FLASH_BASE_ADDRESS + (page_number * MAIN_FLASH_PAGE_SIZE);
+
+    if(SET != model_check(address, MAIN_FLASH_PAGE_SIZE)) {
+        return FMC_PGSERR;
+    }
+    if(SET == model_operation(address, MAIN_FLASH_PAGE_SIZE, NULL)) {
+        return FMC_PGSERR;
+    }
+    memset((void *)(uintptr_t)address, 0xFF, MAIN_FLASH_PAGE_SIZE);
+    fmc_model.erases++;
+    return FMC_READY;
+}
+
+fmc_state_enum fmc_doubleword_program(uint32_t address, uint64_t data)
+{
+    if(SET != model_check(address, 8U)) {
+        return FMC_PGAERR;
+    }
+    if(SET != model_blank(address, 8U)) {
+        return FMC_PGERR;
+    }
+    if(SET == model_operation(address, 8U, (const uint8_t *)&data)) {
+        return FMC_PGERR;
+    }
+    memcpy((void *)(uintptr_t)address, &data, 8U);
+    fmc_model.doublewords++;
+    return FMC_READY;
+}
+
+fmc_state_enum fmc_fast_program(uint32_t address, uint32_t data_buf)
+{
+    const uint32_t number = DOUBLEWORD_CNT_IN_ROW * 8U;
+
+    if(SET != model_check(address, number)) {
+        return FMC_PGAERR;
+    }
+    if(SET != model_blank(address, number)) {
+        return FMC_FSTPERR;
+    }
+    if(SET == model_operation(address, number, (const uint8_t *)(uintptr_t)data_buf)) {
+        return FMC_FSTPERR;
+    }
+    memcpy((void *)(uintptr_t)address, (const void *)(uintptr_t)data_buf, number);
+    fmc_model.rows++;
+    return FMC_READY;
+}
@@ -0,0 +1,66 @@
+/*!
+    \file    fmc_model.h
+    \brief   main flash programming model behind the FMC functions, with power cuts
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef FMC_MODEL_H
+#define FMC_MODEL_H
+
+#include <setjmp.h>
+#include "gd32c2x1.h"
+
+typedef struct {
+    uint8_t locked;
+    uint32_t operations;                /* erase and program operations started */
+    uint32_t erases;                    /* pages erased */
+    uint32_t doublewords;               /* doublewords programmed by fmc_doubleword_program() */
+    uint32_t rows;                      /* rows programmed by fmc_fast_program() */
+    /* misuse, must stay zero: locked FMC, misaligned or outside the flash, target not erased */
+    uint32_t errors;
+    /* the power is cut during this operation, 0 never: the operation is left half done
+       and the model jumps to fmc_model_cut */
+    uint32_t cut_at;
+    /* this operation fails: it is left half done like a cut one and returns an error, 0 never */
+    uint32_t fail_at;
+    /* bits of each doubleword the cut or failed operation leaves as they were, 0 for the first
+       half of the bytes done and the rest left */
+    uint64_t cut_bits;
+} fmc_model_struct;
+
+extern fmc_model_struct fmc_model;
+/* set by the test with setjmp() before it arms fmc_model.cut_at */
+extern jmp_buf fmc_model_cut;
+
+/* clear the counters and lock the FMC, the flash content is kept */
+void fmc_model_init(void);
+
+#endif /* FMC_MODEL_H */
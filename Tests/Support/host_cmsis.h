@@ -0,0 +1,78 @@
+/*!
+    \file    host_cmsis.h
+    \brief   host replacements of the CMSIS core intrinsics
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+
+    include it after gd32c2x1.h and before the module under test, the module
+    then masks a simulated PRIMASK instead of executing Cortex-M instructions
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef HOST_CMSIS_H
+#define HOST_CMSIS_H
+
+#include <stdint.h>
+
+/* simulated PRIMASK, 1 when the interrupts are masked */
+extern uint32_t host_primask;
+/* simulated IPSR, the exception number of the running handler, 0 in thread mode */
+extern uint32_t host_ipsr;
+/* called by __WFI, NULL returns at once */
+extern void (*host_wfi_hook)(void);
+
+void host_disable_irq(void);
+void host_enable_irq(void);
+uint32_t host_get_primask(void);
+void host_set_primask(uint32_t primask);
+uint32_t host_get_ipsr(void);
+void host_wfi(void);
+void host_barrier(void);
+
+#undef __disable_irq
+#undef __enable_irq
+#undef __get_PRIMASK
+#undef __set_PRIMASK
+#undef __get_IPSR
+#undef __WFI
+#undef __DSB
+#undef __ISB
+#undef __NOP
+
+#define __disable_irq       host_disable_irq
+#define __enable_irq        host_enable_irq
+#define __get_PRIMASK       host_get_primask
+#define __set_PRIMASK       host_set_primask
+#define __get_IPSR          host_get_ipsr
+#define __WFI               host_wfi
+#define __DSB               host_barrier
+#define __ISB               host_barrier
+#define __NOP               host_barrier
+
+#endif /* HOST_CMSIS_H */
@@ -0,0 +1,216 @@
+/*!
+    \file    host_periph.c
+    \brief   memory backing of the gd32c2x1 address map for the host tests
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include "host_periph.h"
+#include "host_cmsis.h"
+#include "host_test.h"
+
+typedef struct {
+    uintptr_t base;
+    size_t size;
+    uint8_t erased;
+} host_region_struct;
+
+/* device regions, page aligned */
+static const host_region_struct host_region[] = {
+    {0x08000000U, HOST_FLASH_SIZE, 0xFFU},    /* main flash */
+    {0x1FFFF000U, 0x00001000U, 0xFFU},        /* option bytes */
+    {0x20000000U, 0x00003000U, 0x00U},        /* SRAM */
+    {0x40000000U, 0x00018000U, 0x00U},        /* APB peripherals */
+    {0x40020000U, 0x00004000U, 0x00U},        /* DMA, DMAMUX, RCU, FMC, CRC */
+    {0x48000000U, 0x00002000U, 0x00U},        /* GPIO */
+    {0xE000E000U, 0x00001000U, 0x00U},        /* SysTick, NVIC, SCB */
+};
+
+/* stack of host_low_stack_run(), in the data segment which stays below 4 GiB */
+static uint8_t host_low_stack[0x40000] __attribute__((aligned(16)));
+
+uint32_t host_test_failures = 0U;
+uint32_t host_primask = 0U;
+uint32_t host_ipsr = 0U;
+void (*host_wfi_hook)(void) = NULL;
+
+/*!
+    \brief      map the device regions at their addresses, runs before main()
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+__attribute__((constructor)) static void host_periph_map(void)
+{
+    size_t i;
+
+    for(i = 0U; i < sizeof(host_region) / sizeof(host_region[0]); i++) {
+        void *p = mmap((void *)host_region[i].base, host_region[i].size, PROT_READ | PROT_WRITE,
+                       MAP_FIXED_NOREPLACE | MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if((void *)host_region[i].base != p) {
+            fprintf(stderr, "cannot map the device region at 0x%08lx\n", (unsigned long)host_region[i].base);
+            exit(2);
+        }
+    }
+    host_periph_reset();
+}
+
+/*!
+    \brief      clear every peripheral register, fill the flash and option bytes with the erased value
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void host_periph_reset(void)
+{
+    size_t i;
+
+    for(i = 0U; i < sizeof(host_region) / sizeof(host_region[0]); i++) {
+        memset((void *)host_region[i].base, host_region[i].erased, host_region[i].size);
+    }
+}
+
+/*!
+    \brief      run a function on a stack below 4 GiB, for the modules which give
+                stack buffers to the DMA, whose address registers are 32 bits wide
+    \param[in]  function: function to run
+    \param[out] none
+    \retval     none
+*/
+void host_low_stack_run(void (*function)(void))
+{
+    static ucontext_t caller, callee;
+
+    getcontext(&callee);
+    callee.uc_stack.ss_sp = host_low_stack;
+    callee.uc_stack.ss_size = sizeof(host_low_stack);
+    callee.uc_link = &caller;
+    makecontext(&callee, function, 0);
+    swapcontext(&caller, &callee);
+}
+
+/*!
+    \brief      print the result of the test
+    \param[in]  name: name of the test
+    \param[out] none
+    \retval     0 when every check held, 1 otherwise
+*/
+int host_test_result(const char *name)
+{
+    if(0U != host_test_failures) {
+        printf("%s: FAIL, %u failed checks\n", name, (unsigned)host_test_failures);
+        return 1;
+    }
+    printf("%s: PASS\n", name);
+    return 0;
+}
+
+/*!
+    \brief      mask the simulated interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void host_disable_irq(void)
+{
+    host_primask = 1U;
+}
+
+/*!
+    \brief      unmask the simulated interrupts
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void host_enable_irq(void)
+{
+    host_primask = 0U;
+}
+
+/*!
+    \brief      get the simulated IPSR
+    \param[in]  none
+    \param[out] none
+    \retval     the exception number of the running handler, 0 in thread mode
+*/
+uint32_t host_get_ipsr(void)
+{
+    return host_ipsr;
+}
+
+/*!
+    \brief      get the simulated PRIMASK
+    \param[in]  none
+    \param[out] none
+    \retval     the simulated PRIMASK
+*/
+uint32_t host_get_primask(void)
+{
+    return host_primask;
+}
+
+/*!
+    \brief      set the simulated PRIMASK
+    \param[in]  primask: value to be restored
+    \param[out] none
+    \retval     none
+*/
+void host_set_primask(uint32_t primask)
+{
+    host_primask = primask & 1U;
+}
+
+/*!
+    \brief      wait for interrupt, calls the hook of the test
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void host_wfi(void)
+{
+    if(NULL != host_wfi_hook) {
+        host_wfi_hook();
+    }
+}
+
+/*!
+    \brief      memory barrier and no-operation, nothing to do on the host
+    \param[in]  none
+    \param[out] none
+    \retval     none
+*/
+void host_barrier(void)
+{
+}
@@ -0,0 +1,54 @@
+/*!
+    \file    host_periph.h
+    \brief   memory backing of the gd32c2x1 address map for the host tests
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+
+    the flash, SRAM, option bytes, peripheral and system control regions are
+    mapped at their device addresses before main(), so the register macros of
+    the standard peripheral library read and write plain memory
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef HOST_PERIPH_H
+#define HOST_PERIPH_H
+
+#include <stdint.h>
+
+#define HOST_FLASH_SIZE     0x00010000U
+
+/* address of a device word as a host pointer */
+#define HOST_REG32(addr)    ((volatile uint32_t *)(uintptr_t)(addr))
+
+/* clear every peripheral register, fill the flash with the erased value */
+void host_periph_reset(void);
+/* run a function on a stack below 4 GiB */
+void host_low_stack_run(void (*function)(void));
+
+#endif /* HOST_PERIPH_H */
@@ -0,0 +1,68 @@
+/*!
+    \file    host_test.h
+    \brief   check macros of the host tests
+
+    \version 2025-06-03, V1.0.0, host tests for gd32c2x1
+*/
+
+/*
+    Copyright (c) 2025, GigaDevice Semiconductor Inc.
+
+    Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+    1. Redistributions of source code must retain the above copyright notice, this
+       list of conditions and the following disclaimer.
+    2. Redistributions in binary form must reproduce the above copyright notice,
+       this list of conditions and the following disclaimer in the documentation
+       and/or other materials provided with the distribution.
+    3. Neither the name of the copyright holder nor the names of its contributors
+       may be used to endorse or promote products derived from this software without
+       specific prior written permission.
+
+    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT,
+INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY
+OF SUCH DAMAGE.
+*/
+
+#ifndef HOST_TEST_H
+#define HOST_TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/* number of failed checks of the running test */
+extern uint32_t host_test_failures;
+
+/* check a condition, report the line and continue when it does not hold */
+#define HOST_CHECK(cond)                                                        \
+    do {                                                                        \
+        if(!(cond)) {                                                           \
+            host_test_failures++;                                               \
+            printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond);     \
+        }                                                                       \
+    } while(0)
+
+/* check that two integer values are equal and print both when they are not */
+#define HOST_CHECK_EQ(actual, expected)                                         \
+    do {                                                                        \
+        long long host_actual_ = (long long)(actual);                           \
+        long long host_expected_ = (long long)(expected);                       \
+        if(host_actual_ != host_expected_) {                                    \
+            host_test_failures++;                                               \
+            printf("%s:%d: check failed: %s == %lld, expected %s == %lld\n",    \
+                   __FILE__, __LINE__, #actual, host_actual_, #expected, host_expected_); \
+        }                                                                       \
+    } while(0)
+
+/* print the result of the test, return the process exit code */
+int host_test_result(const char *name);
+
+#endif /* HOST_TEST_H */